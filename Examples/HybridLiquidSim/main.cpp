@@ -23,6 +23,7 @@
 #include <Solver/PIC/PICSolver3.h>
 #include <Surface/Implicit/ImplicitSurfaceSet3.h>
 #include <Utils/Logger.h>
+#include <Utils/ParticleCache.h>
 
 #include <pystring/pystring.h>
 
@@ -85,6 +86,15 @@ void SaveParticleAsXYZ(
 	}
 }
 
+void SaveParticleAsCache(
+	const ParticleSystemData3Ptr& particles,
+	ParticleCacheWriter* cache,
+	int frameCnt)
+{
+	printf("Writing frame %d to the particle cache...\n", frameCnt);
+	cache->WriteFrame(ConstArrayAccessor1<Vector3D>(particles->NumberOfParticles(), particles->GetPositions().data()));
+}
+
 void PrintUsage()
 {
 	printf(
@@ -97,7 +107,8 @@ void PrintUsage()
 		"   -o, --output: output directory name "
 		"(default is " APP_NAME "_output)\n"
 		"   -e, --example: example number (between 1 and 6, default is 1)\n"
-		"   -m, --format: particle output format (xyz or pos. default is xyz)\n"
+		"   -m, --format: particle output format (xyz, pos, or pcache. "
+		"default is xyz)\n"
 		"   -h, --help: print this message\n");
 }
 
@@ -129,6 +140,15 @@ void RunSimulation(
 {
 	auto particles = solver->GetParticleSystemData();
 
+	// All frames go to a single cache file quantized within the domain
+	std::unique_ptr<ParticleCacheWriter> cache;
+	if (format == "pcache")
+	{
+		cache = std::make_unique<ParticleCacheWriter>(
+			pystring::os::path::join(rootDir, "particles.pcache"),
+			solver->GetGridSystemData()->GetBoundingBox());
+	}
+
 	for (Frame frame(0, 1.0 / fps); frame.index < numberOfFrames; ++frame)
 	{
 		solver->Update(frame);
@@ -140,6 +160,10 @@ void RunSimulation(
 		{
 			SaveParticleAsPos(particles, rootDir, frame.index);
 		}
+		else if (format == "pcache")
+		{
+			SaveParticleAsCache(particles, cache.get(), frame.index);
+		}
 	}
 }
 
@@ -617,7 +641,7 @@ int main(int argc, char* argv[])
 			break;
 		case 'm':
 			format = optarg;
-			if (format != "pos" && format != "xyz")
+			if (format != "pos" && format != "xyz" && format != "pcache")
 			{
 				PrintUsage();
 				exit(EXIT_FAILURE);
@@ -12,8 +12,11 @@
 #include <Grid/ScalarGrid3.h>
 #include <Grid/VertexCenteredScalarGrid3.h>
 #include <MarchingCubes/MarchingCubes.h>
+#include <PointsToImplicit/AnisotropicPointsToImplicit3.h>
+#include <PointsToImplicit/SPHPointsToImplicit3.h>
+#include <PointsToImplicit/ZhuBridsonPointsToImplicit3.h>
 #include <Size/Size3.h>
-#include <SPH/SPHSystemData3.h>
+#include <Utils/ParticleCache.h>
 #include <Utils/Serialization.h>
 
 #include <pystring/pystring.h>
@@ -35,15 +38,22 @@ void PrintUsage()
         "-r resx, resy, resz "
         "-g dx, dy, dz "
         "-n ox, oy, oz "
-        "-k kernel_radius\n"
-        "   -i, --input: input particle position file name\n"
-        "   -o, --output: output obj file name\n"
+        "-k kernel_radius "
+        "-m method "
+        "-f frame\n"
+        "   -i, --input: input particle position file name "
+            "(particle cache if the name ends with .pcache)\n"
+        "   -o, --output: output obj file name "
+            "(binary ply if the name ends with .ply)\n"
         "   -r, --resolution: grid resolution in CSV format "
             "(default: 100, 100, 100)\n"
 		"   -g, --grid_spacing: grid spacing in CSV format "
             "(default: 0.01, 0.01, 0.01)\n"
         "   -n, --origin: domain origin in CSV format (default: 0, 0, 0)\n"
         "   -k, --kernel: interpolation kernel radius (default: 0.2)\n"
+        "   -m, --method: reconstruction method, one of sph, zhu_bridson, "
+            "and anisotropic (default: sph)\n"
+        "   -f, --frame: frame to convert from a particle cache (default: 0)\n"
         "   -h, --help: print this message\n");
 }
 
@@ -73,11 +83,21 @@ void TriangulateAndSave(const ScalarGrid3& sdf, const std::string& objFileName)
         0.0,
 		DIRECTION_ALL);
 
-    std::ofstream file(objFileName.c_str());
+    const bool isPly = pystring::endswith(pystring::lower(objFileName), ".ply");
+    std::ofstream file(objFileName.c_str(), isPly ? std::ofstream::binary : std::ofstream::out);
     if (file)
 	{
         printf("Writing %s...\n", objFileName.c_str());
-        mesh.WriteObj(&file);
+
+        if (isPly)
+        {
+            mesh.WritePly(&file);
+        }
+        else
+        {
+            mesh.WriteObj(&file);
+        }
+
         file.close();
     }
 	else
@@ -93,24 +113,34 @@ void ParticlesToObj(
     const Vector3D& gridSpacing,
     const Vector3D& origin,
     double kernelRadius,
+    const std::string& method,
     const std::string& objFileName)
 {
-    SPHSystemData3 sphParticles;
-    sphParticles.AddParticles(positions);
-    sphParticles.SetRelativeKernelRadius(2.0);
-    sphParticles.SetTargetSpacing(kernelRadius / 2.0);
-    sphParticles.BuildNeighborSearcher();
-    sphParticles.UpdateDensities();
+    PointsToImplicit3Ptr converter;
+
+    if (method == "sph")
+    {
+        converter = std::make_shared<SPHPointsToImplicit3>(kernelRadius, 0.5);
+    }
+    else if (method == "zhu_bridson")
+    {
+        converter = std::make_shared<ZhuBridsonPointsToImplicit3>(kernelRadius, 0.25);
+    }
+    else if (method == "anisotropic")
+    {
+        converter = std::make_shared<AnisotropicPointsToImplicit3>(kernelRadius, 0.5);
+    }
+    else
+    {
+        printf("Unknown reconstruction method %s.\n", method.c_str());
+        PrintUsage();
+        exit(EXIT_FAILURE);
+    }
 
     VertexCenteredScalarGrid3 sdf(resolution, gridSpacing, origin);
-    PrintInfo(resolution, sdf.BoundingBox(), gridSpacing, sphParticles.NumberOfParticles());
+    PrintInfo(resolution, sdf.BoundingBox(), gridSpacing, positions.size());
 
-    Array1<double> constData(sphParticles.NumberOfParticles(), 1.0);
-    sdf.Fill([&](const Vector3D& pt)
-	{
-        double d = sphParticles.Interpolate(pt, constData);
-        return 0.5 - d;
-    });
+    converter->Convert(positions.ConstAccessor(), &sdf);
 
     TriangulateAndSave(sdf, objFileName);
 }
@@ -123,6 +153,8 @@ int main(int argc, char* argv[])
     Vector3D gridSpacing(0.01, 0.01, 0.01);
     Vector3D origin;
     double kernelRadius = 0.2;
+    std::string method = "sph";
+    size_t frame = 0;
 
     // Parse options
     static struct option longOptions[] =
@@ -133,13 +165,15 @@ int main(int argc, char* argv[])
 		{"gridspacing", optional_argument,  nullptr,  'g' },
 		{"origin",      optional_argument,  nullptr,  'n' },
 		{"kernel",      optional_argument,  nullptr,  'k' },
+		{"method",      optional_argument,  nullptr,  'm' },
+		{"frame",       optional_argument,  nullptr,  'f' },
 		{"help",        optional_argument,  nullptr,  'h' },
 		{nullptr,       0,                  nullptr,   0  }
     };
 
     int opt;
     int long_index = 0;
-    while ((opt = getopt_long(argc, argv, "i:o:r:g:n:k:h", longOptions, &long_index)) != -1)
+    while ((opt = getopt_long(argc, argv, "i:o:r:g:n:k:m:f:h", longOptions, &long_index)) != -1)
 	{
         switch (opt)
 		{
@@ -203,6 +237,12 @@ int main(int argc, char* argv[])
             case 'k':
                 kernelRadius = atof(optarg);
                 break;
+            case 'm':
+                method = optarg;
+                break;
+            case 'f':
+                frame = static_cast<size_t>(atoi(optarg));
+                break;
             case 'h':
                 PrintUsage();
                 exit(EXIT_SUCCESS);
@@ -220,21 +260,35 @@ int main(int argc, char* argv[])
 
     // Read particle positions
     Array1<Vector3D> positions;
-    std::ifstream positionFile(inputFileName.c_str(), std::ifstream::binary);
-    if (positionFile)
-	{
-        std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(positionFile)), (std::istreambuf_iterator<char>()));
-        Deserialize(buffer, &positions);
-        positionFile.close();
+    if (pystring::endswith(pystring::lower(inputFileName), ".pcache"))
+    {
+        ParticleCacheReader cache(inputFileName);
+        if (!cache.IsOpen() || frame >= cache.NumberOfFrames())
+        {
+            printf("Cannot read frame %zu from file %s.\n", frame, inputFileName.c_str());
+            exit(EXIT_FAILURE);
+        }
+
+        cache.ReadFrame(frame, &positions);
     }
-	else
-	{
-        printf("Cannot read file %s.\n", inputFileName.c_str());
-        exit(EXIT_FAILURE);
+    else
+    {
+        std::ifstream positionFile(inputFileName.c_str(), std::ifstream::binary);
+        if (positionFile)
+        {
+            std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(positionFile)), (std::istreambuf_iterator<char>()));
+            Deserialize(buffer, &positions);
+            positionFile.close();
+        }
+        else
+        {
+            printf("Cannot read file %s.\n", inputFileName.c_str());
+            exit(EXIT_FAILURE);
+        }
     }
 
     // Run marching cube and save it to the disk
-    ParticlesToObj(positions, resolution, gridSpacing, origin, kernelRadius, outputFileName);
+    ParticlesToObj(positions, resolution, gridSpacing, origin, kernelRadius, method, outputFileName);
 
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 *************************************************************************/
 #include <Array/Array1.h>
 #include <Vector/Vector3.h>
+#include <Utils/ParticleCache.h>
 #include <Utils/Serialization.h>
 
 #include <getopt.h>
@@ -22,9 +23,11 @@ void PrintUsage()
 {
 	printf(
 		"Usage: Particles2Xml "
-		"-i input_pos -o output_xml \n"
-		"   -i, --input: input particle position file name\n"
+		"-i input_pos -o output_xml -f frame\n"
+		"   -i, --input: input particle position file name "
+			"(particle cache if the name ends with .pcache)\n"
 		"   -o, --output: output obj file name\n"
+		"   -f, --frame: frame to convert from a particle cache (default: 0)\n"
 		"   -h, --help: print this message\n");
 }
 
@@ -81,19 +84,21 @@ int main(int argc, char* argv[])
 {
 	std::string inputFileName;
 	std::string outputFileName;
+	size_t frame = 0;
 
 	// Parse options
 	static struct option longOptions[] =
 	{
 		{ "input",       required_argument,  nullptr,  'i' },
 		{ "output",      required_argument,  nullptr,  'o' },
+		{ "frame",       optional_argument,  nullptr,  'f' },
 		{ "help",        optional_argument,  nullptr,  'h' },
 		{ nullptr,       0,                  nullptr,   0 }
 	};
 
 	int opt;
 	int long_index = 0;
-	while ((opt = getopt_long(argc, argv, "i:o:h", longOptions, &long_index)) != -1)
+	while ((opt = getopt_long(argc, argv, "i:o:f:h", longOptions, &long_index)) != -1)
 	{
 		switch (opt)
 		{
@@ -103,6 +108,9 @@ int main(int argc, char* argv[])
 		case 'o':
 			outputFileName = optarg;
 			break;
+		case 'f':
+			frame = static_cast<size_t>(atoi(optarg));
+			break;
 		case 'h':
 			PrintUsage();
 			exit(EXIT_SUCCESS);
@@ -120,19 +128,35 @@ int main(int argc, char* argv[])
 
 	// Read particle positions
 	Array1<Vector3D> positions;
-	std::ifstream positionFile(inputFileName.c_str(), std::ifstream::binary);
-	if (positionFile)
+	const std::string cacheExtension = ".pcache";
+	if (inputFileName.size() > cacheExtension.size() &&
+		inputFileName.compare(inputFileName.size() - cacheExtension.size(), cacheExtension.size(), cacheExtension) == 0)
 	{
-		std::vector<uint8_t> buffer(
-			(std::istreambuf_iterator<char>(positionFile)),
-			(std::istreambuf_iterator<char>()));
-		Deserialize(buffer, &positions);
-		positionFile.close();
+		ParticleCacheReader cache(inputFileName);
+		if (!cache.IsOpen() || frame >= cache.NumberOfFrames())
+		{
+			printf("Cannot read frame %zu from file %s.\n", frame, inputFileName.c_str());
+			exit(EXIT_FAILURE);
+		}
+
+		cache.ReadFrame(frame, &positions);
 	}
 	else
 	{
-		printf("Cannot read file %s.\n", inputFileName.c_str());
-		exit(EXIT_FAILURE);
+		std::ifstream positionFile(inputFileName.c_str(), std::ifstream::binary);
+		if (positionFile)
+		{
+			std::vector<uint8_t> buffer(
+				(std::istreambuf_iterator<char>(positionFile)),
+				(std::istreambuf_iterator<char>()));
+			Deserialize(buffer, &positions);
+			positionFile.close();
+		}
+		else
+		{
+			printf("Cannot read file %s.\n", inputFileName.c_str());
+			exit(EXIT_FAILURE);
+		}
 	}
 
 	// Run marching cube and save it to the disk
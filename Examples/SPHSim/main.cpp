@@ -18,6 +18,7 @@
 #include <SPH/SPHSolver3.h>
 #include <Surface/Implicit/ImplicitSurfaceSet3.h>
 #include <Utils/Logger.h>
+#include <Utils/ParticleCache.h>
 
 #include <pystring/pystring.h>
 
@@ -74,6 +75,12 @@ void SaveParticleAsXYZ(const ParticleSystemData3Ptr& particles, const std::strin
     }
 }
 
+void SaveParticleAsCache(const ParticleSystemData3Ptr& particles, ParticleCacheWriter* cache, int frameCnt)
+{
+    printf("Writing frame %d to the particle cache...\n", frameCnt);
+    cache->WriteFrame(ConstArrayAccessor1<Vector3D>(particles->NumberOfParticles(), particles->GetPositions().data()));
+}
+
 void PrintUsage()
 {
     printf(
@@ -85,7 +92,8 @@ void PrintUsage()
         "   -l, --log: log filename (default is " APP_NAME ".log)\n"
         "   -o, --output: output directory name "
         "(default is " APP_NAME "_output)\n"
-        "   -m, --format: particle output format (xyz or pos. default is xyz)\n"
+        "   -m, --format: particle output format (xyz, pos, or pcache. "
+        "default is xyz)\n"
         "   -e, --example: example number (between 1 and 3, default is 1)\n"
         "   -h, --help: print this message\n");
 }
@@ -96,10 +104,17 @@ void PrintInfo(const SPHSolver3Ptr& solver)
     printf("Number of particles: %zu\n", particles->NumberOfParticles());
 }
 
-void RunSimulation(const std::string& rootDir, const SPHSolver3Ptr& solver, int numberOfFrames, const std::string& format, double fps)
+void RunSimulation(const std::string& rootDir, const SPHSolver3Ptr& solver, const BoundingBox3D& domain, int numberOfFrames, const std::string& format, double fps)
 {
     auto particles = solver->GetSPHSystemData();
 
+    // All frames go to a single cache file quantized within the domain
+    std::unique_ptr<ParticleCacheWriter> cache;
+    if (format == "pcache")
+    {
+        cache = std::make_unique<ParticleCacheWriter>(pystring::os::path::join(rootDir, "particles.pcache"), domain);
+    }
+
     for (Frame frame(0, 1.0 / fps); frame.index < numberOfFrames; ++frame)
 	{
         solver->Update(frame);
@@ -112,6 +127,10 @@ void RunSimulation(const std::string& rootDir, const SPHSolver3Ptr& solver, int
 		{
             SaveParticleAsPos(particles, rootDir, frame.index);
         }
+        else if (format == "pcache")
+        {
+            SaveParticleAsCache(particles, cache.get(), frame.index);
+        }
     }
 }
 
@@ -172,7 +191,7 @@ void RunExample1(const std::string& rootDir, double targetSpacing, int numberOfF
     PrintInfo(solver);
 
     // Run simulation
-    RunSimulation(rootDir, solver, numberOfFrames, format, fps);
+    RunSimulation(rootDir, solver, domain, numberOfFrames, format, fps);
 }
 
 // Water-drop example (SPH)
@@ -231,7 +250,7 @@ void RunExample2(const std::string& rootDir, double targetSpacing, int numberOfF
     PrintInfo(solver);
 
     // Run simulation
-    RunSimulation(rootDir, solver, numberOfFrames, format, fps);
+    RunSimulation(rootDir, solver, domain, numberOfFrames, format, fps);
 }
 
 // Dam-breaking example
@@ -314,7 +333,7 @@ void RunExample3(const std::string& rootDir, double targetSpacing, int numberOfF
     PrintInfo(solver);
 
     // Run simulation
-    RunSimulation(rootDir, solver, numberOfFrames, format, fps);
+    RunSimulation(rootDir, solver, domain, numberOfFrames, format, fps);
 }
 
 int main(int argc, char* argv[])
@@ -367,7 +386,7 @@ int main(int argc, char* argv[])
                 break;
             case 'm':
                 format = optarg;
-                if (format != "pos" && format != "xyz")
+                if (format != "pos" && format != "xyz" && format != "pcache")
 				{
                     PrintUsage();
                     exit(EXIT_FAILURE);
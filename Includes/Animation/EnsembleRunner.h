@@ -0,0 +1,120 @@
+/*************************************************************************
+> File Name: EnsembleRunner.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Advances many animations side by side on a shared set of cores.
+> Created Time: 2017/10/29
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_ENSEMBLE_RUNNER_H
+#define CUBBYFLOW_ENSEMBLE_RUNNER_H
+
+#include <Animation/Animation.h>
+#include <Utils/SharedAssetCache.h>
+
+#include <functional>
+#include <vector>
+
+namespace CubbyFlow
+{
+	//! Statistics of a EnsembleRunner::Run call.
+	struct EnsembleReport
+	{
+		//! Number of cores shared by the members.
+		unsigned int numberOfThreads = 0;
+
+		//! Number of frames advanced by all the members.
+		size_t numberOfFrames = 0;
+
+		//! Elapsed time of the run.
+		double wallTimeInSeconds = 0.0;
+
+		//! Wall time multiplied by the number of cores, in hours.
+		double coreHours = 0.0;
+
+		//! Aggregate throughput of the ensemble.
+		double framesPerCoreHour = 0.0;
+
+		//! Time spent on advancing each member, excluding the waiting.
+		std::vector<double> memberTimesInSeconds;
+	};
+
+	//!
+	//! \brief Advances many animations side by side on a shared set of cores.
+	//!
+	//! This class runs the variations of a simulation (e.g., a parameter
+	//! sweep) in a single process instead of one process per variation. A
+	//! fixed set of worker threads advances the members one frame at a time
+	//! in round-robin order, so every member makes progress. The cores are
+	//! split evenly among the members being advanced by limiting the parallel
+	//! functions of each worker (see SetMaxNumberOfThreadsForCurrentThread),
+	//! and the unused share goes to the remaining members as others finish.
+	//!
+	//! Immutable setup data common to the members, such as the signed-distance
+	//! fields of colliders, can be baked once through GetAssets().
+	//!
+	class EnsembleRunner final
+	{
+	public:
+		//! Callback invoked with the member index after each frame.
+		using FrameCallback = std::function<void(size_t, const Frame&)>;
+
+		//! Constructs the runner using \p numberOfThreads cores, or
+		//! GetMaxNumberOfThreads() cores if zero.
+		explicit EnsembleRunner(unsigned int numberOfThreads = 0);
+
+		//! Returns the number of cores shared by the members.
+		unsigned int NumberOfThreads() const;
+
+		//! Returns the cache of the assets shared by the members.
+		const SharedAssetCachePtr& GetAssets() const;
+
+		//!
+		//! \brief Adds a member and returns its index.
+		//!
+		//! \param animation Animation of the member, not shared with others.
+		//! \param firstFrame Frame to start from.
+		//! \param numberOfFrames Number of frames to advance per Run call.
+		//! \param callback Invoked after each frame from a worker thread. The
+		//!                 callbacks of different members may run concurrently.
+		//!
+		size_t AddMember(
+			const AnimationPtr& animation,
+			const Frame& firstFrame,
+			unsigned int numberOfFrames,
+			const FrameCallback& callback = nullptr);
+
+		//! Returns the number of members.
+		size_t NumberOfMembers() const;
+
+		//! Returns the animation of the member.
+		const AnimationPtr& MemberAt(size_t i) const;
+
+		//! Returns the next frame of the member to be advanced.
+		Frame NextFrameOf(size_t i) const;
+
+		//!
+		//! \brief Advances every member by its number of frames.
+		//!
+		//! Calling this function again continues from where the members
+		//! stopped. If a member throws, the others stop after their current
+		//! frame and the first exception is rethrown.
+		//!
+		EnsembleReport Run();
+
+	private:
+		struct Member
+		{
+			AnimationPtr animation;
+			Frame nextFrame;
+			unsigned int numberOfFrames;
+			FrameCallback callback;
+		};
+
+		unsigned int m_numberOfThreads;
+		SharedAssetCachePtr m_assets;
+		std::vector<Member> m_members;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -10,6 +10,7 @@
 #define CUBBYFLOW_PHYSICS_ANIMATION_H
 
 #include <Animation/Animation.h>
+#include <Utils/Checkpoint.h>
 
 namespace CubbyFlow
 {
@@ -97,6 +98,34 @@ namespace CubbyFlow
 		//!
 		double CurrentTimeInSeconds() const;
 
+		//!
+		//! \brief Writes the whole simulation state to a checkpoint file.
+		//!
+		//! The checkpoint contains the current frame and time as well as the
+		//! state of the subclass, such as particles, grids, emitters and
+		//! colliders. Large arrays are streamed directly to the file.
+		//!
+		//! \param[in] fileName The checkpoint file name.
+		//!
+		//! \return True if the checkpoint is written successfully.
+		//!
+		bool SaveCheckpoint(const std::string& fileName) const;
+
+		//!
+		//! \brief Restores the simulation state from a checkpoint file.
+		//!
+		//! The animation should be set up in the same way as the one that wrote
+		//! the checkpoint (same solver type, emitters and colliders). The file is
+		//! memory-mapped and the arrays are copied straight into the simulation
+		//! state. Once restored, the simulation continues from the saved frame
+		//! without calling PhysicsAnimation::OnInitialize again.
+		//!
+		//! \param[in] fileName The checkpoint file name.
+		//!
+		//! \return True if the checkpoint is read successfully.
+		//!
+		bool LoadCheckpoint(const std::string& fileName);
+
 	protected:
 		//!
 		//! \brief Called when a single time-step should be advanced.
@@ -133,6 +162,26 @@ namespace CubbyFlow
 		//!
 		virtual void OnInitialize();
 
+		//!
+		//! \brief Called to write the physics state to the checkpoint.
+		//!
+		//! Inheriting classes should call the base class function first and then
+		//! write their own state.
+		//!
+		//! \param[in] writer The checkpoint writer.
+		//!
+		virtual void OnSaveCheckpoint(CheckpointWriter* writer) const;
+
+		//!
+		//! \brief Called to restore the physics state from the checkpoint.
+		//!
+		//! Inheriting classes should call the base class function first and then
+		//! read their own state.
+		//!
+		//! \param[in] reader The checkpoint reader.
+		//!
+		virtual void OnLoadCheckpoint(const CheckpointReader& reader);
+
 	private:
 		Frame m_currentFrame;
 		bool m_isUsingFixedSubTimeSteps = true;
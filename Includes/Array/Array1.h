@@ -11,6 +11,7 @@
 
 #include <Array/Array.h>
 #include <Array/ArrayAccessor1.h>
+#include <Utils/AlignedAllocator.h>
 
 #include <vector>
 
@@ -21,7 +22,7 @@ namespace CubbyFlow
 	//!
 	//! This class represents 1-D array data structure. This class is a simple
 	//! wrapper around std::vector with some additional features such as the array
-	//! accessor object and parallel for-loop.
+	//! accessor object and parallel for-loop. The elements are 64-byte aligned.
 	//!
 	//! \tparam T - Type to store in the array.
 	//!
@@ -29,7 +30,7 @@ namespace CubbyFlow
 	class Array<T, 1> final
 	{
 	public:
-		using ContainerType = std::vector<T>;
+		using ContainerType = std::vector<T, AlignedAllocator<T>>;
 		using Iterator = typename ContainerType::iterator;
 		using ConstIterator = typename ContainerType::const_iterator;
 
@@ -108,6 +108,13 @@ namespace CubbyFlow
 	template <typename T>
 	void Array<T, 3>::Resize(const Size3& size, const T& initVal)
 	{
+		// Keeps the storage when the size is unchanged, as the contents would be
+		// copied over as they are anyway
+		if (size == m_size)
+		{
+			return;
+		}
+
 		Array grid;
 		grid.m_data.resize(size.x * size.y * size.z, initVal);
 		grid.m_size = size;
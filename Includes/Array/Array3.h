@@ -11,6 +11,7 @@
 
 #include <Array/Array.h>
 #include <Array/ArrayAccessor3.h>
+#include <Utils/AlignedAllocator.h>
 
 #include <Size/Size3.h>
 
@@ -40,13 +41,15 @@ namespace CubbyFlow
 	//! }
 	//! \endcode
 	//!
+	//! The linear array is 64-byte aligned.
+	//!
 	//! \tparam T - Type to store in the array.
 	//!
 	template <typename T>
 	class Array<T, 3> final
 	{
 	public:
-		using ContainerType = std::vector<T>;
+		using ContainerType = std::vector<T, AlignedAllocator<T>>;
 		using Iterator = typename ContainerType::iterator;
 		using ConstIterator = typename ContainerType::const_iterator;
 
@@ -413,7 +416,7 @@ namespace CubbyFlow
 
 	private:
 		Size3 m_size;
-		std::vector<T> m_data;
+		ContainerType m_data;
 	};
 
 	//! Type alias for 3-D array.
@@ -14,6 +14,8 @@
 #include <Utils/Parallel.h>
 #include <Utils/TypeHelpers.h>
 
+#include <vector>
+
 namespace CubbyFlow
 {
 	template <typename ArrayType, typename T>
@@ -76,147 +78,231 @@ namespace CubbyFlow
 		});
 	}
 
-	template <typename T>
-	void ExtrapolateToRegion(const ConstArrayAccessor2<T>& input, const ConstArrayAccessor2<char>& valid, unsigned int numberOfIterations, ArrayAccessor2<T> output)
+	namespace Internal
 	{
-		const Size2 size = input.size();
+		// Invokes func(neighborIndex) for each face neighbor of the cell in the
+		// order of +x, -x, +y, -y, +z, and -z until func returns false.
+		template <typename Callback>
+		void ForEachFaceNeighbor(const Size3& size, size_t idx, const Callback& func)
+		{
+			const size_t strideY = size.x;
+			const size_t strideZ = size.x * size.y;
+			const size_t i = idx % size.x;
+			const size_t j = (idx / strideY) % size.y;
+			const size_t k = idx / strideZ;
 
-		assert(size == valid.size());
-		assert(size == output.size());
+			if (i + 1 < size.x && !func(idx + 1))
+			{
+				return;
+			}
 
-		Array2<char> valid0(size);
-		Array2<char> valid1(size);
+			if (i > 0 && !func(idx - 1))
+			{
+				return;
+			}
 
-		valid0.ParallelForEachIndex([&](size_t i, size_t j)
-		{
-			valid0(i, j) = valid(i, j);
-			output(i, j) = input(i, j);
-		});
+			if (j + 1 < size.y && !func(idx + strideY))
+			{
+				return;
+			}
+
+			if (j > 0 && !func(idx - strideY))
+			{
+				return;
+			}
+
+			if (k + 1 < size.z && !func(idx + strideZ))
+			{
+				return;
+			}
 
-		for (unsigned int iter = 0; iter < numberOfIterations; ++iter)
+			if (k > 0)
+			{
+				func(idx - strideZ);
+			}
+		}
+
+		//
+		// Extrapolates layer by layer, visiting only the invalid cells next to
+		// the valid region (the frontier) instead of the whole grid. 2-D grids
+		// are handled as 3-D grids with a single layer along the z-axis.
+		//
+		// Since a frontier cell only reads the valid neighbors, which are not
+		// written in the same layer, the cells of a layer are independent and
+		// are processed in parallel. The neighbors are summed in the order of
+		// +x, -x, +y, -y, +z, and -z, so the result does not depend on the
+		// order of the cells.
+		//
+		template <typename T>
+		void ExtrapolateToRegion(const Size3& size, const T* input, const char* valid, unsigned int numberOfIterations, T* output)
 		{
-			valid0.ForEachIndex([&](size_t i, size_t j)
+			// Cell states; the frontier is being extrapolated in this layer
+			static constexpr char INVALID = 0;
+			static constexpr char VALID = 1;
+			static constexpr char FRONTIER = 2;
+
+			// Number of cells or frontier cells per parallel task
+			static constexpr size_t CHUNK_SIZE = 4096;
+
+			const size_t n = size.x * size.y * size.z;
+
+			std::vector<char> marker(n);
+			std::vector<size_t> frontier;
+			std::vector<size_t> nextFrontier;
+			std::vector<std::vector<size_t>> chunkResults;
+
+			ParallelFor(ZERO_SIZE, n, [&](size_t idx)
 			{
-				T sum = Zero<T>();
-				unsigned int count = 0;
+				marker[idx] = valid[idx] ? VALID : INVALID;
+				output[idx] = input[idx];
+			});
 
-				if (!valid0(i, j))
+			// Collects the cells picked by func(i, chunkResult) for i in
+			// [0, count) into result in parallel, keeping the order of i
+			const auto collect = [&](size_t count, const auto& func, std::vector<size_t>* result)
+			{
+				const size_t numberOfChunks = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+				if (chunkResults.size() < numberOfChunks)
 				{
-					if (i + 1 < size.x && valid0(i + 1, j))
-					{
-						sum += output(i + 1, j);
-						++count;
-					}
-
-					if (i > 0 && valid0(i - 1, j))
-					{
-						sum += output(i - 1, j);
-						++count;
-					}
+					chunkResults.resize(numberOfChunks);
+				}
 
-					if (j + 1 < size.y && valid0(i, j + 1))
-					{
-						sum += output(i, j + 1);
-						++count;
-					}
+				ParallelFor(ZERO_SIZE, numberOfChunks, [&](size_t chunk)
+				{
+					std::vector<size_t>& chunkResult = chunkResults[chunk];
+					chunkResult.clear();
 
-					if (j > 0 && valid0(i, j - 1))
+					const size_t end = std::min((chunk + 1) * CHUNK_SIZE, count);
+					for (size_t i = chunk * CHUNK_SIZE; i < end; ++i)
 					{
-						sum += output(i, j - 1);
-						++count;
+						func(i, &chunkResult);
 					}
+				});
 
-					if (count > 0)
-					{
-						output(i, j) = sum / static_cast<typename ScalarType<T>::value>(count);
-						valid1(i, j) = 1;
-					}
+				result->clear();
+				for (size_t chunk = 0; chunk < numberOfChunks; ++chunk)
+				{
+					result->insert(result->end(), chunkResults[chunk].begin(), chunkResults[chunk].end());
 				}
-				else
+			};
+
+			// The first frontier is the invalid cells next to the valid cells
+			collect(n, [&](size_t idx, std::vector<size_t>* chunkResult)
+			{
+				if (marker[idx] != INVALID)
 				{
-					valid1(i, j) = 1;
+					return;
 				}
-			});
 
-			valid0.Swap(valid1);
-		}
-	}
+				ForEachFaceNeighbor(size, idx, [&](size_t neighbor)
+				{
+					if (marker[neighbor] == VALID)
+					{
+						chunkResult->push_back(idx);
+						return false;
+					}
 
-	template <typename T>
-	void ExtrapolateToRegion(const ConstArrayAccessor3<T>& input, const ConstArrayAccessor3<char>& valid, unsigned int numberOfIterations, ArrayAccessor3<T> output)
-	{
-		const Size3 size = input.size();
+					return true;
+				});
+			}, &frontier);
 
-		assert(size == valid.size());
-		assert(size == output.size());
+			for (unsigned int iter = 0; iter < numberOfIterations && !frontier.empty(); ++iter)
+			{
+				ParallelFor(ZERO_SIZE, frontier.size(), [&](size_t f)
+				{
+					const size_t idx = frontier[f];
+					T sum = Zero<T>();
+					unsigned int count = 0;
 
-		Array3<char> valid0(size);
-		Array3<char> valid1(size);
+					ForEachFaceNeighbor(size, idx, [&](size_t neighbor)
+					{
+						if (marker[neighbor] == VALID)
+						{
+							sum += output[neighbor];
+							++count;
+						}
 
-		valid0.ParallelForEachIndex([&](size_t i, size_t j, size_t k)
-		{
-			valid0(i, j, k) = valid(i, j, k);
-			output(i, j, k) = input(i, j, k);
-		});
+						return true;
+					});
 
-		for (unsigned int iter = 0; iter < numberOfIterations; ++iter)
-		{
-			valid0.ForEachIndex([&](size_t i, size_t j, size_t k)
-			{
-				T sum = Zero<T>();
-				unsigned int count = 0;
+					output[idx] = sum / static_cast<typename ScalarType<T>::value>(count);
+				});
 
-				if (!valid0(i, j, k))
+				if (iter + 1 == numberOfIterations)
 				{
-					if (i + 1 < size.x && valid0(i + 1, j, k))
-					{
-						sum += output(i + 1, j, k);
-						++count;
-					}
+					break;
+				}
 
-					if (i > 0 && valid0(i - 1, j, k))
-					{
-						sum += output(i - 1, j, k);
-						++count;
-					}
+				ParallelFor(ZERO_SIZE, frontier.size(), [&](size_t f)
+				{
+					marker[frontier[f]] = FRONTIER;
+				});
 
-					if (j + 1 < size.y && valid0(i, j + 1, k))
-					{
-						sum += output(i, j + 1, k);
-						++count;
-					}
+				// The next frontier is the invalid neighbors of this frontier.
+				// Each of them is added by its first neighbor on this frontier
+				// only, so no cell is added twice.
+				collect(frontier.size(), [&](size_t f, std::vector<size_t>* chunkResult)
+				{
+					const size_t idx = frontier[f];
 
-					if (j > 0 && valid0(i, j - 1, k))
+					ForEachFaceNeighbor(size, idx, [&](size_t neighbor)
 					{
-						sum += output(i, j - 1, k);
-						++count;
-					}
+						if (marker[neighbor] != INVALID)
+						{
+							return true;
+						}
+
+						size_t owner = neighbor;
+						ForEachFaceNeighbor(size, neighbor, [&](size_t candidate)
+						{
+							if (marker[candidate] == FRONTIER)
+							{
+								owner = candidate;
+								return false;
+							}
+
+							return true;
+						});
+
+						if (owner == idx)
+						{
+							chunkResult->push_back(neighbor);
+						}
+
+						return true;
+					});
+				}, &nextFrontier);
+
+				ParallelFor(ZERO_SIZE, frontier.size(), [&](size_t f)
+				{
+					marker[frontier[f]] = VALID;
+				});
 
-					if (k + 1 < size.z && valid0(i, j, k + 1))
-					{
-						sum += output(i, j, k + 1);
-						++count;
-					}
+				frontier.swap(nextFrontier);
+			}
+		}
+	}
 
-					if (k > 0 && valid0(i, j, k - 1))
-					{
-						sum += output(i, j, k - 1);
-						++count;
-					}
+	template <typename T>
+	void ExtrapolateToRegion(const ConstArrayAccessor2<T>& input, const ConstArrayAccessor2<char>& valid, unsigned int numberOfIterations, ArrayAccessor2<T> output)
+	{
+		const Size2 size = input.size();
 
-					if (count > 0)
-					{
-						output(i, j, k) = sum / static_cast<typename ScalarType<T>::value>(count);
-						valid1(i, j, k) = 1;
-					}
-				}
-				else {
-					valid1(i, j, k) = 1;
-				}
-			});
+		assert(size == valid.size());
+		assert(size == output.size());
 
-			valid0.Swap(valid1);
-		}
+		Internal::ExtrapolateToRegion(Size3(size.x, size.y, 1), input.data(), valid.data(), numberOfIterations, output.data());
+	}
+
+	template <typename T>
+	void ExtrapolateToRegion(const ConstArrayAccessor3<T>& input, const ConstArrayAccessor3<char>& valid, unsigned int numberOfIterations, ArrayAccessor3<T> output)
+	{
+		const Size3 size = input.size();
+
+		assert(size == valid.size());
+		assert(size == output.size());
+
+		Internal::ExtrapolateToRegion(size, input.data(), valid.data(), numberOfIterations, output.data());
 	}
 
 	template <typename ArrayType>
@@ -0,0 +1,223 @@
+/*************************************************************************
+> File Name: BrickedArray3-Impl.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: 3-D array stored in 8x8x8 bricks.
+> Created Time: 2017/10/31
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_BRICKED_ARRAY3_IMPL_H
+#define CUBBYFLOW_BRICKED_ARRAY3_IMPL_H
+
+#include <Utils/Parallel.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace CubbyFlow
+{
+	template <typename T>
+	constexpr size_t BrickedArray3<T>::BRICK_SHIFT;
+
+	template <typename T>
+	constexpr size_t BrickedArray3<T>::BRICK_SIZE;
+
+	template <typename T>
+	BrickedArray3<T>::BrickedArray3()
+	{
+		// Do nothing
+	}
+
+	template <typename T>
+	BrickedArray3<T>::BrickedArray3(const Size3& size, const T& initVal)
+	{
+		Resize(size, initVal);
+	}
+
+	template <typename T>
+	BrickedArray3<T>::BrickedArray3(const ConstArrayAccessor3<T>& values)
+	{
+		CopyFrom(values);
+	}
+
+	template <typename T>
+	const Size3& BrickedArray3<T>::size() const
+	{
+		return m_size;
+	}
+
+	template <typename T>
+	size_t BrickedArray3<T>::Width() const
+	{
+		return m_size.x;
+	}
+
+	template <typename T>
+	size_t BrickedArray3<T>::Height() const
+	{
+		return m_size.y;
+	}
+
+	template <typename T>
+	size_t BrickedArray3<T>::Depth() const
+	{
+		return m_size.z;
+	}
+
+	template <typename T>
+	const Size3& BrickedArray3<T>::NumberOfBricks() const
+	{
+		return m_numberOfBricks;
+	}
+
+	template <typename T>
+	size_t BrickedArray3<T>::IndexOf(size_t i, size_t j, size_t k) const
+	{
+		const size_t mask = BRICK_SIZE - 1;
+		const size_t brick = ((k >> BRICK_SHIFT) * m_numberOfBricks.y + (j >> BRICK_SHIFT)) * m_numberOfBricks.x + (i >> BRICK_SHIFT);
+
+		return (brick << (3 * BRICK_SHIFT)) | ((k & mask) << (2 * BRICK_SHIFT)) | ((j & mask) << BRICK_SHIFT) | (i & mask);
+	}
+
+	template <typename T>
+	T* BrickedArray3<T>::data()
+	{
+		return m_data.data();
+	}
+
+	template <typename T>
+	const T* BrickedArray3<T>::data() const
+	{
+		return m_data.data();
+	}
+
+	template <typename T>
+	T& BrickedArray3<T>::operator()(size_t i, size_t j, size_t k)
+	{
+		assert(i < m_size.x && j < m_size.y && k < m_size.z);
+
+		return m_data[IndexOf(i, j, k)];
+	}
+
+	template <typename T>
+	const T& BrickedArray3<T>::operator()(size_t i, size_t j, size_t k) const
+	{
+		assert(i < m_size.x && j < m_size.y && k < m_size.z);
+
+		return m_data[IndexOf(i, j, k)];
+	}
+
+	template <typename T>
+	void BrickedArray3<T>::Resize(const Size3& size, const T& initVal)
+	{
+		if (size == m_size)
+		{
+			return;
+		}
+
+		BrickedArray3 grid;
+		grid.m_size = size;
+		grid.m_numberOfBricks = Size3(
+			(size.x + BRICK_SIZE - 1) >> BRICK_SHIFT,
+			(size.y + BRICK_SIZE - 1) >> BRICK_SHIFT,
+			(size.z + BRICK_SIZE - 1) >> BRICK_SHIFT);
+		grid.m_data.resize(
+			(grid.m_numberOfBricks.x * grid.m_numberOfBricks.y * grid.m_numberOfBricks.z) << (3 * BRICK_SHIFT), initVal);
+
+		const size_t iMin = std::min(size.x, m_size.x);
+		const size_t jMin = std::min(size.y, m_size.y);
+		const size_t kMin = std::min(size.z, m_size.z);
+
+		for (size_t k = 0; k < kMin; ++k)
+		{
+			for (size_t j = 0; j < jMin; ++j)
+			{
+				for (size_t i = 0; i < iMin; ++i)
+				{
+					grid(i, j, k) = (*this)(i, j, k);
+				}
+			}
+		}
+
+		m_size = grid.m_size;
+		m_numberOfBricks = grid.m_numberOfBricks;
+		m_data.swap(grid.m_data);
+	}
+
+	template <typename T>
+	void BrickedArray3<T>::Set(const T& value)
+	{
+		std::fill(m_data.begin(), m_data.end(), value);
+	}
+
+	template <typename T>
+	void BrickedArray3<T>::CopyFrom(const ConstArrayAccessor3<T>& values)
+	{
+		Resize(values.size());
+
+		ParallelForEachIndex([&](size_t i, size_t j, size_t k)
+		{
+			m_data[IndexOf(i, j, k)] = values(i, j, k);
+		});
+	}
+
+	template <typename T>
+	void BrickedArray3<T>::CopyTo(ArrayAccessor3<T> values) const
+	{
+		assert(values.size() == m_size);
+
+		ParallelForEachIndex([&](size_t i, size_t j, size_t k)
+		{
+			values(i, j, k) = m_data[IndexOf(i, j, k)];
+		});
+	}
+
+	template <typename T>
+	template <typename Callback>
+	void BrickedArray3<T>::ForEachIndex(const Callback& func) const
+	{
+		const size_t numberOfBricks = m_numberOfBricks.x * m_numberOfBricks.y * m_numberOfBricks.z;
+
+		for (size_t brick = 0; brick < numberOfBricks; ++brick)
+		{
+			ForEachIndexInBrick(brick, func);
+		}
+	}
+
+	template <typename T>
+	template <typename Callback>
+	void BrickedArray3<T>::ParallelForEachIndex(const Callback& func) const
+	{
+		const size_t numberOfBricks = m_numberOfBricks.x * m_numberOfBricks.y * m_numberOfBricks.z;
+
+		ParallelFor(ZERO_SIZE, numberOfBricks, [&](size_t brick)
+		{
+			ForEachIndexInBrick(brick, func);
+		});
+	}
+
+	template <typename T>
+	template <typename Callback>
+	void BrickedArray3<T>::ForEachIndexInBrick(size_t brick, const Callback& func) const
+	{
+		const size_t iBegin = (brick % m_numberOfBricks.x) << BRICK_SHIFT;
+		const size_t jBegin = ((brick / m_numberOfBricks.x) % m_numberOfBricks.y) << BRICK_SHIFT;
+		const size_t kBegin = (brick / (m_numberOfBricks.x * m_numberOfBricks.y)) << BRICK_SHIFT;
+		const size_t iEnd = std::min(iBegin + BRICK_SIZE, m_size.x);
+		const size_t jEnd = std::min(jBegin + BRICK_SIZE, m_size.y);
+		const size_t kEnd = std::min(kBegin + BRICK_SIZE, m_size.z);
+
+		for (size_t k = kBegin; k < kEnd; ++k)
+		{
+			for (size_t j = jBegin; j < jEnd; ++j)
+			{
+				for (size_t i = iBegin; i < iEnd; ++i)
+				{
+					func(i, j, k);
+				}
+			}
+		}
+	}
+}
+
+#endif
\ No newline at end of file
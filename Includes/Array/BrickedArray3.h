@@ -0,0 +1,123 @@
+/*************************************************************************
+> File Name: BrickedArray3.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: 3-D array stored in 8x8x8 bricks.
+> Created Time: 2017/10/31
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_BRICKED_ARRAY3_H
+#define CUBBYFLOW_BRICKED_ARRAY3_H
+
+#include <Array/ArrayAccessor3.h>
+#include <Size/Size3.h>
+
+#include <vector>
+
+namespace CubbyFlow
+{
+	//!
+	//! \brief 3-D array stored in 8x8x8 bricks.
+	//!
+	//! Unlike Array3, which stores the elements in a single row-major block,
+	//! this array stores each 8x8x8 brick of elements contiguously, with the
+	//! bricks and the elements within a brick in i-first order. The (i, j, k)
+	//! element and its neighbors within the same brick then share a single
+	//! 4 KB page for double, whereas k +/- 1 is a whole slab away with the
+	//! row-major layout. This favors the lookups which jump in j and k, such
+	//! as the trilinear sampling of back-traced points, once the array is much
+	//! larger than the last-level cache.
+	//!
+	//! The storage is padded to whole bricks. The loops over all the elements
+	//! should iterate brick by brick (see ForEachIndex) so that each brick is
+	//! visited once.
+	//!
+	//! \tparam T - Type to store in the array.
+	//!
+	template <typename T>
+	class BrickedArray3 final
+	{
+	public:
+		//! Number of bits for the index within a brick along each axis.
+		static constexpr size_t BRICK_SHIFT = 3;
+
+		//! Number of elements of a brick along each axis.
+		static constexpr size_t BRICK_SIZE = static_cast<size_t>(1) << BRICK_SHIFT;
+
+		//! Constructs zero-sized 3-D bricked array.
+		BrickedArray3();
+
+		//! Constructs 3-D bricked array with given \p size and fill it with \p initVal.
+		explicit BrickedArray3(const Size3& size, const T& initVal = T());
+
+		//! Constructs 3-D bricked array with the elements of \p values.
+		explicit BrickedArray3(const ConstArrayAccessor3<T>& values);
+
+		//! Returns the size of the array.
+		const Size3& size() const;
+
+		//! Returns the width of the array.
+		size_t Width() const;
+
+		//! Returns the height of the array.
+		size_t Height() const;
+
+		//! Returns the depth of the array.
+		size_t Depth() const;
+
+		//! Returns the number of bricks along each axis.
+		const Size3& NumberOfBricks() const;
+
+		//! Returns the index of (i, j, k) element in the brick storage.
+		size_t IndexOf(size_t i, size_t j, size_t k) const;
+
+		//! Returns the pointer to the brick storage.
+		T* data();
+
+		//! Returns the const pointer to the brick storage.
+		const T* data() const;
+
+		//! Returns the reference to (i, j, k) element.
+		T& operator()(size_t i, size_t j, size_t k);
+
+		//! Returns the const reference to (i, j, k) element.
+		const T& operator()(size_t i, size_t j, size_t k) const;
+
+		//!
+		//! \brief Resizes the array.
+		//!
+		//! The elements within both the old and the new size are kept, and
+		//! the new elements are filled with \p initVal.
+		//!
+		void Resize(const Size3& size, const T& initVal = T());
+
+		//! Sets all the elements to \p value.
+		void Set(const T& value);
+
+		//! Resizes the array to the size of \p values and copies them.
+		void CopyFrom(const ConstArrayAccessor3<T>& values);
+
+		//! Copies the elements to \p values with the same size.
+		void CopyTo(ArrayAccessor3<T> values) const;
+
+		//! Invokes \p func(i, j, k) for every element serially, brick by brick.
+		template <typename Callback>
+		void ForEachIndex(const Callback& func) const;
+
+		//! Invokes \p func(i, j, k) for every element in parallel, brick by brick.
+		template <typename Callback>
+		void ParallelForEachIndex(const Callback& func) const;
+
+	private:
+		Size3 m_size;
+		Size3 m_numberOfBricks;
+		std::vector<T> m_data;
+
+		template <typename Callback>
+		void ForEachIndexInBrick(size_t brick, const Callback& func) const;
+	};
+}
+
+#include <Array/BrickedArray3-Impl.h>
+
+#endif
\ No newline at end of file
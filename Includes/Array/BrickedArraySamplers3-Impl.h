@@ -0,0 +1,89 @@
+/*************************************************************************
+> File Name: BrickedArraySamplers3-Impl.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: 3-D array samplers for the bricked array.
+> Created Time: 2017/10/31
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_BRICKED_ARRAY_SAMPLERS3_IMPL_H
+#define CUBBYFLOW_BRICKED_ARRAY_SAMPLERS3_IMPL_H
+
+#include <Math/MathUtils.h>
+
+#include <algorithm>
+
+namespace CubbyFlow
+{
+	template <typename T, typename R>
+	LinearBrickedArraySampler3<T, R>::LinearBrickedArraySampler3(
+		const BrickedArray3<T>& array,
+		const Vector3<R>& gridSpacing,
+		const Vector3<R>& gridOrigin) :
+		m_gridSpacing(gridSpacing), m_origin(gridOrigin), m_data(array.data()),
+		m_size(static_cast<ssize_t>(array.Width()), static_cast<ssize_t>(array.Height()), static_cast<ssize_t>(array.Depth())),
+		m_brickStrideY(array.NumberOfBricks().x << (3 * BrickedArray3<T>::BRICK_SHIFT)),
+		m_brickStrideZ(m_brickStrideY * array.NumberOfBricks().y)
+	{
+		// Do nothing
+	}
+
+	template <typename T, typename R>
+	T LinearBrickedArraySampler3<T, R>::operator()(const Vector3<R>& pt) const
+	{
+		ssize_t i, j, k;
+		R fx, fy, fz;
+
+		const Vector3<R> normalizedX = (pt - m_origin) / m_gridSpacing;
+
+		const ssize_t iSize = m_size.x;
+		const ssize_t jSize = m_size.y;
+		const ssize_t kSize = m_size.z;
+
+		GetBarycentric(normalizedX.x, 0, iSize - 1, &i, &fx);
+		GetBarycentric(normalizedX.y, 0, jSize - 1, &j, &fy);
+		GetBarycentric(normalizedX.z, 0, kSize - 1, &k, &fz);
+
+		const ssize_t ip1 = std::min(i + 1, iSize - 1);
+		const ssize_t jp1 = std::min(j + 1, jSize - 1);
+		const ssize_t kp1 = std::min(k + 1, kSize - 1);
+
+		// The storage index is the sum of independent offsets along each axis,
+		// so the eight points need only two offsets per axis
+		const size_t shift = BrickedArray3<T>::BRICK_SHIFT;
+		const size_t mask = BrickedArray3<T>::BRICK_SIZE - 1;
+
+		const auto offsetX = [&](size_t x)
+		{
+			return ((x >> shift) << (3 * shift)) + (x & mask);
+		};
+		const auto offsetY = [&](size_t y)
+		{
+			return (y >> shift) * m_brickStrideY + ((y & mask) << shift);
+		};
+		const auto offsetZ = [&](size_t z)
+		{
+			return (z >> shift) * m_brickStrideZ + ((z & mask) << (2 * shift));
+		};
+
+		const size_t x0 = offsetX(i), x1 = offsetX(ip1);
+		const size_t y0 = offsetY(j), y1 = offsetY(jp1);
+		const size_t z0 = offsetZ(k), z1 = offsetZ(kp1);
+
+		return TriLerp(
+			m_data[x0 + y0 + z0], m_data[x1 + y0 + z0],
+			m_data[x0 + y1 + z0], m_data[x1 + y1 + z0],
+			m_data[x0 + y0 + z1], m_data[x1 + y0 + z1],
+			m_data[x0 + y1 + z1], m_data[x1 + y1 + z1],
+			fx, fy, fz);
+	}
+
+	template <typename T, typename R>
+	std::function<T(const Vector3<R>&)> LinearBrickedArraySampler3<T, R>::Functor() const
+	{
+		LinearBrickedArraySampler3 sampler(*this);
+		return std::bind(&LinearBrickedArraySampler3::operator(), sampler, std::placeholders::_1);
+	}
+}
+
+#endif
\ No newline at end of file
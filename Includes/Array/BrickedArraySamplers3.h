@@ -0,0 +1,67 @@
+/*************************************************************************
+> File Name: BrickedArraySamplers3.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: 3-D array samplers for the bricked array.
+> Created Time: 2017/10/31
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_BRICKED_ARRAY_SAMPLERS3_H
+#define CUBBYFLOW_BRICKED_ARRAY_SAMPLERS3_H
+
+#include <Array/BrickedArray3.h>
+#include <Vector/Vector3.h>
+
+#include <functional>
+
+namespace CubbyFlow
+{
+	//!
+	//! \brief 3-D linear sampler class for the bricked array.
+	//!
+	//! This class provides the same sampling as LinearArraySampler3 for a given
+	//! BrickedArray3. The eight points around the sample are addressed by
+	//! summing two offsets per axis, so no branch is taken at brick borders.
+	//!
+	//! \tparam T - The value type to sample.
+	//! \tparam R - The real number type.
+	//!
+	template <typename T, typename R>
+	class LinearBrickedArraySampler3 final
+	{
+	public:
+		static_assert(std::is_floating_point<R>::value, "Samplers only can be instantiated with floating point types");
+
+		//!
+		//! \brief      Constructs a sampler using bricked array, spacing between
+		//!     the elements, and the position of the first array element.
+		//!
+		//! \param[in]  array       The bricked array, which must outlive the sampler
+		//!                         and keep its size.
+		//! \param[in]  gridSpacing The grid spacing.
+		//! \param[in]  gridOrigin  The grid origin.
+		//!
+		explicit LinearBrickedArraySampler3(
+			const BrickedArray3<T>& array,
+			const Vector3<R>& gridSpacing,
+			const Vector3<R>& gridOrigin);
+
+		//! Returns sampled value at point \p pt.
+		T operator()(const Vector3<R>& pt) const;
+
+		//! Returns a function object that wraps this instance.
+		std::function<T(const Vector3<R>&)> Functor() const;
+
+	private:
+		Vector3<R> m_gridSpacing;
+		Vector3<R> m_origin;
+		const T* m_data;
+		Point3I m_size;
+		size_t m_brickStrideY;
+		size_t m_brickStrideZ;
+	};
+}
+
+#include <Array/BrickedArraySamplers3-Impl.h>
+
+#endif
\ No newline at end of file
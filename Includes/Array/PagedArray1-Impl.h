@@ -0,0 +1,363 @@
+/*************************************************************************
+> File Name: PagedArray1-Impl.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: 1-D array stored in fixed-size chunks with stable addresses.
+> Created Time: 2017/10/27
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_PAGED_ARRAY1_IMPL_H
+#define CUBBYFLOW_PAGED_ARRAY1_IMPL_H
+
+#include <Utils/Parallel.h>
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+namespace CubbyFlow
+{
+	template <typename T>
+	constexpr size_t PagedArray1<T>::DEFAULT_CHUNK_SIZE;
+
+	template <typename T>
+	constexpr size_t PagedArray1<T>::DEFAULT_RESERVED_SIZE_IN_BYTES;
+
+	template <typename T>
+	PagedArray1<T>::PagedArray1(size_t chunkSize, const std::string& backingDirectory, size_t reservedSize) :
+		m_chunkShift(0), m_backingDirectory(backingDirectory)
+	{
+		while ((static_cast<size_t>(1) << m_chunkShift) < chunkSize)
+		{
+			++m_chunkShift;
+		}
+
+		if (reservedSize == 0)
+		{
+			reservedSize = DEFAULT_RESERVED_SIZE_IN_BYTES / sizeof(T);
+		}
+
+		m_reservedSize = std::max((reservedSize + ChunkSize() - 1) >> m_chunkShift, static_cast<size_t>(1)) << m_chunkShift;
+	}
+
+	template <typename T>
+	PagedArray1<T>::PagedArray1(const PagedArray1& other) :
+		PagedArray1(other.ChunkSize(), other.BackingDirectory(), other.ReservedSize())
+	{
+		Set(other);
+	}
+
+	template <typename T>
+	PagedArray1<T>::PagedArray1(PagedArray1&& other) :
+		m_chunkShift(other.m_chunkShift), m_backingDirectory(other.m_backingDirectory),
+		m_reservedSize(other.m_reservedSize), m_size(other.m_size), m_data(other.m_data),
+		m_storage(std::move(other.m_storage))
+	{
+		other.m_size = 0;
+		other.m_data = nullptr;
+	}
+
+	template <typename T>
+	PagedArray1<T>& PagedArray1<T>::operator=(const PagedArray1& other)
+	{
+		Set(other);
+		return *this;
+	}
+
+	template <typename T>
+	PagedArray1<T>& PagedArray1<T>::operator=(PagedArray1&& other)
+	{
+		if (&other != this)
+		{
+			m_chunkShift = other.m_chunkShift;
+			m_backingDirectory = other.m_backingDirectory;
+			m_reservedSize = other.m_reservedSize;
+			m_size = other.m_size;
+			m_data = other.m_data;
+			m_storage = std::move(other.m_storage);
+
+			other.m_size = 0;
+			other.m_data = nullptr;
+		}
+
+		return *this;
+	}
+
+	template <typename T>
+	size_t PagedArray1<T>::size() const
+	{
+		return m_size;
+	}
+
+	template <typename T>
+	size_t PagedArray1<T>::ChunkSize() const
+	{
+		return static_cast<size_t>(1) << m_chunkShift;
+	}
+
+	template <typename T>
+	size_t PagedArray1<T>::NumberOfChunks() const
+	{
+		return (m_size + ChunkSize() - 1) >> m_chunkShift;
+	}
+
+	template <typename T>
+	size_t PagedArray1<T>::ReservedSize() const
+	{
+		return m_reservedSize;
+	}
+
+	template <typename T>
+	bool PagedArray1<T>::IsBackedByFile() const
+	{
+		return !m_backingDirectory.empty();
+	}
+
+	template <typename T>
+	const std::string& PagedArray1<T>::BackingDirectory() const
+	{
+		return m_backingDirectory;
+	}
+
+	template <typename T>
+	T* PagedArray1<T>::data()
+	{
+		return m_data;
+	}
+
+	template <typename T>
+	const T* PagedArray1<T>::data() const
+	{
+		return m_data;
+	}
+
+	template <typename T>
+	ArrayAccessor1<T> PagedArray1<T>::Accessor()
+	{
+		return ArrayAccessor1<T>(m_size, m_data);
+	}
+
+	template <typename T>
+	ConstArrayAccessor1<T> PagedArray1<T>::ConstAccessor() const
+	{
+		return ConstArrayAccessor1<T>(m_size, m_data);
+	}
+
+	template <typename T>
+	T& PagedArray1<T>::At(size_t i)
+	{
+		assert(i < m_size);
+		return m_data[i];
+	}
+
+	template <typename T>
+	const T& PagedArray1<T>::At(size_t i) const
+	{
+		assert(i < m_size);
+		return m_data[i];
+	}
+
+	template <typename T>
+	T& PagedArray1<T>::operator[](size_t i)
+	{
+		return m_data[i];
+	}
+
+	template <typename T>
+	const T& PagedArray1<T>::operator[](size_t i) const
+	{
+		return m_data[i];
+	}
+
+	template <typename T>
+	void PagedArray1<T>::Resize(size_t size, const T& initVal)
+	{
+		const size_t oldSize = m_size;
+
+		if (size > m_reservedSize)
+		{
+			Reserve(std::max(size, 2 * m_reservedSize));
+		}
+
+		Commit(size);
+		m_size = size;
+
+		if (size > oldSize)
+		{
+			const size_t firstChunk = oldSize >> m_chunkShift;
+			const size_t numberOfChunks = NumberOfChunks();
+
+			ParallelFor(firstChunk, numberOfChunks, [&](size_t chunk)
+			{
+				const size_t begin = std::max(chunk << m_chunkShift, oldSize);
+				const size_t end = std::min((chunk + 1) << m_chunkShift, size);
+
+				for (size_t i = begin; i < end; ++i)
+				{
+					new (m_data + i) T(initVal);
+				}
+			});
+		}
+	}
+
+	template <typename T>
+	void PagedArray1<T>::Reserve(size_t reservedSize)
+	{
+		reservedSize = ((reservedSize + ChunkSize() - 1) >> m_chunkShift) << m_chunkShift;
+		if (reservedSize <= m_reservedSize)
+		{
+			return;
+		}
+
+		m_reservedSize = reservedSize;
+
+		if (m_storage != nullptr)
+		{
+			std::unique_ptr<PageStorage> oldStorage = std::move(m_storage);
+			const T* oldData = m_data;
+
+			m_data = nullptr;
+			Commit(m_size);
+			std::copy(oldData, oldData + m_size, m_data);
+		}
+	}
+
+	template <typename T>
+	void PagedArray1<T>::Commit(size_t size)
+	{
+		if (size == 0)
+		{
+			return;
+		}
+
+		if (m_storage == nullptr)
+		{
+			m_storage = std::make_unique<PageStorage>(m_reservedSize * sizeof(T), m_backingDirectory);
+			m_data = static_cast<T*>(m_storage->Data());
+		}
+
+		// Commits whole chunks, so a chunk never straddles committed and
+		// uncommitted pages
+		const size_t committedSize = std::min(((size + ChunkSize() - 1) >> m_chunkShift) << m_chunkShift, m_reservedSize);
+		m_storage->Commit(committedSize * sizeof(T));
+	}
+
+	template <typename T>
+	void PagedArray1<T>::Append(const T& value)
+	{
+		if (m_size == m_reservedSize)
+		{
+			Reserve(2 * m_reservedSize);
+		}
+
+		Commit(m_size + 1);
+		new (m_data + m_size) T(value);
+		++m_size;
+	}
+
+	template <typename T>
+	void PagedArray1<T>::Clear()
+	{
+		m_size = 0;
+	}
+
+	template <typename T>
+	void PagedArray1<T>::Set(const T& value)
+	{
+		ParallelForEachChunk([&](size_t, ArrayAccessor1<T> chunk)
+		{
+			std::fill(chunk.data(), chunk.data() + chunk.size(), value);
+		});
+	}
+
+	template <typename T>
+	void PagedArray1<T>::Set(const PagedArray1& other)
+	{
+		if (&other == this)
+		{
+			return;
+		}
+
+		CopyFrom(other.ConstAccessor());
+	}
+
+	template <typename T>
+	void PagedArray1<T>::CopyFrom(const ConstArrayAccessor1<T>& values)
+	{
+		Resize(values.size());
+
+		ParallelForEachChunk([&](size_t firstIndex, ArrayAccessor1<T> chunk)
+		{
+			std::copy(values.data() + firstIndex, values.data() + firstIndex + chunk.size(), chunk.data());
+		});
+	}
+
+	template <typename T>
+	void PagedArray1<T>::CopyTo(ArrayAccessor1<T> values) const
+	{
+		assert(values.size() == m_size);
+
+		ParallelForEachChunk([&](size_t firstIndex, ConstArrayAccessor1<T> chunk)
+		{
+			std::copy(chunk.data(), chunk.data() + chunk.size(), values.data() + firstIndex);
+		});
+	}
+
+	template <typename T>
+	ArrayAccessor1<T> PagedArray1<T>::ChunkAt(size_t chunk)
+	{
+		assert(chunk < NumberOfChunks());
+
+		return ArrayAccessor1<T>(std::min(ChunkSize(), m_size - (chunk << m_chunkShift)), m_data + (chunk << m_chunkShift));
+	}
+
+	template <typename T>
+	ConstArrayAccessor1<T> PagedArray1<T>::ChunkAt(size_t chunk) const
+	{
+		assert(chunk < NumberOfChunks());
+
+		return ConstArrayAccessor1<T>(std::min(ChunkSize(), m_size - (chunk << m_chunkShift)), m_data + (chunk << m_chunkShift));
+	}
+
+	template <typename T>
+	template <typename Callback>
+	void PagedArray1<T>::ForEachChunk(const Callback& func)
+	{
+		for (size_t chunk = 0; chunk < NumberOfChunks(); ++chunk)
+		{
+			func(chunk << m_chunkShift, ChunkAt(chunk));
+		}
+	}
+
+	template <typename T>
+	template <typename Callback>
+	void PagedArray1<T>::ForEachChunk(const Callback& func) const
+	{
+		for (size_t chunk = 0; chunk < NumberOfChunks(); ++chunk)
+		{
+			func(chunk << m_chunkShift, ChunkAt(chunk));
+		}
+	}
+
+	template <typename T>
+	template <typename Callback>
+	void PagedArray1<T>::ParallelForEachChunk(const Callback& func)
+	{
+		ParallelFor(ZERO_SIZE, NumberOfChunks(), [&](size_t chunk)
+		{
+			func(chunk << m_chunkShift, ChunkAt(chunk));
+		});
+	}
+
+	template <typename T>
+	template <typename Callback>
+	void PagedArray1<T>::ParallelForEachChunk(const Callback& func) const
+	{
+		ParallelFor(ZERO_SIZE, NumberOfChunks(), [&](size_t chunk)
+		{
+			func(chunk << m_chunkShift, ChunkAt(chunk));
+		});
+	}
+}
+
+#endif
\ No newline at end of file
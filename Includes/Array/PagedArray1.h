@@ -0,0 +1,193 @@
+/*************************************************************************
+> File Name: PagedArray1.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: 1-D array stored in fixed-size chunks with stable addresses.
+> Created Time: 2017/10/27
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_PAGED_ARRAY1_H
+#define CUBBYFLOW_PAGED_ARRAY1_H
+
+#include <Array/ArrayAccessor1.h>
+#include <Utils/PageStorage.h>
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace CubbyFlow
+{
+	//!
+	//! \brief 1-D array committed chunk by chunk within a reserved address
+	//!        range.
+	//!
+	//! Unlike Array1, growing this array within its reserved size only commits
+	//! the missing chunks, so the existing elements are never copied and the
+	//! pointers to them stay valid. The elements are contiguous, so the array
+	//! can be handed to the loops through Accessor(), while the loops that
+	//! only touch part of a large array can iterate per chunk (see
+	//! ForEachChunk). Growing beyond the reserved size moves the elements to a
+	//! reserved range twice as large.
+	//!
+	//! The chunks come from a PageStorage, so they can optionally live in a
+	//! memory-mapped scratch file that the operating system pages in and out
+	//! on demand. This lets cold data exceed the physical memory.
+	//!
+	//! \tparam     T     Element type. Must be trivially destructible since the
+	//!                   elements may live in a mapped file.
+	//!
+	template <typename T>
+	class PagedArray1 final
+	{
+		static_assert(std::is_trivially_destructible<T>::value, "PagedArray1 requires trivially destructible elements.");
+
+	public:
+		//! Default number of elements in a chunk.
+		static constexpr size_t DEFAULT_CHUNK_SIZE = 16384;
+
+		//! Default size of the reserved address range in bytes. Reserving does
+		//! not take memory, only address space.
+		static constexpr size_t DEFAULT_RESERVED_SIZE_IN_BYTES = (sizeof(void*) >= 8) ? (static_cast<size_t>(1) << 32) : (static_cast<size_t>(1) << 26);
+
+		//!
+		//! Constructs an empty array.
+		//!
+		//! \param chunkSize Number of elements in a chunk, rounded up to the
+		//!                  power of two.
+		//! \param backingDirectory Directory of the scratch file backing the
+		//!                         chunks. Empty string keeps them on the heap.
+		//! \param reservedSize Number of elements the array can hold without
+		//!                     moving, rounded up to the chunk size. Zero
+		//!                     reserves DEFAULT_RESERVED_SIZE_IN_BYTES.
+		//!
+		explicit PagedArray1(size_t chunkSize = DEFAULT_CHUNK_SIZE, const std::string& backingDirectory = "", size_t reservedSize = 0);
+
+		//! Copy constructor. The copy uses the same chunk size, backing
+		//! directory, and reserved size but its own storage.
+		PagedArray1(const PagedArray1& other);
+
+		//! Move constructor. The moved-from array is left empty.
+		PagedArray1(PagedArray1&& other);
+
+		//! Copies the elements of the other array.
+		PagedArray1& operator=(const PagedArray1& other);
+
+		//! Move assignment operator. The moved-from array is left empty.
+		PagedArray1& operator=(PagedArray1&& other);
+
+		//! Returns the number of elements.
+		size_t size() const;
+
+		//! Returns the number of elements in a chunk.
+		size_t ChunkSize() const;
+
+		//! Returns the number of chunks holding the elements.
+		size_t NumberOfChunks() const;
+
+		//! Returns the number of elements the array can hold without moving.
+		size_t ReservedSize() const;
+
+		//! Returns true if the chunks are mapped from a scratch file.
+		bool IsBackedByFile() const;
+
+		//! Returns the directory of the scratch file, or empty string.
+		const std::string& BackingDirectory() const;
+
+		//! Returns the pointer to the first element.
+		T* data();
+
+		//! Returns the const pointer to the first element.
+		const T* data() const;
+
+		//! Returns the array accessor.
+		ArrayAccessor1<T> Accessor();
+
+		//! Returns the const array accessor.
+		ConstArrayAccessor1<T> ConstAccessor() const;
+
+		//! Returns the reference to i-th element.
+		T& At(size_t i);
+
+		//! Returns the const reference to i-th element.
+		const T& At(size_t i) const;
+
+		//! Returns the reference to i-th element.
+		T& operator[](size_t i);
+
+		//! Returns the const reference to i-th element.
+		const T& operator[](size_t i) const;
+
+		//!
+		//! \brief Resizes the array.
+		//!
+		//! Growing fills the new elements with \p initVal and commits the
+		//! missing chunks only. Shrinking keeps the chunks for later growth.
+		//!
+		void Resize(size_t size, const T& initVal = T());
+
+		//!
+		//! \brief Reserves the address range for \p reservedSize elements.
+		//!
+		//! The elements move to the new range if it is larger than the current
+		//! one. Smaller sizes are ignored.
+		//!
+		void Reserve(size_t reservedSize);
+
+		//! Appends a single element.
+		void Append(const T& value);
+
+		//! Removes all the elements while keeping the chunks.
+		void Clear();
+
+		//! Sets all the elements to \p value.
+		void Set(const T& value);
+
+		//! Copies the elements of the other array.
+		void Set(const PagedArray1& other);
+
+		//! Resizes the array to the size of \p values and copies them.
+		void CopyFrom(const ConstArrayAccessor1<T>& values);
+
+		//! Copies the elements to \p values with the same size.
+		void CopyTo(ArrayAccessor1<T> values) const;
+
+		//! Returns the accessor to the elements of the chunk.
+		ArrayAccessor1<T> ChunkAt(size_t chunk);
+
+		//! Returns the const accessor to the elements of the chunk.
+		ConstArrayAccessor1<T> ChunkAt(size_t chunk) const;
+
+		//! Invokes \p func(firstIndex, chunkAccessor) for every chunk serially.
+		template <typename Callback>
+		void ForEachChunk(const Callback& func);
+
+		//! Invokes \p func(firstIndex, chunkAccessor) for every chunk serially.
+		template <typename Callback>
+		void ForEachChunk(const Callback& func) const;
+
+		//! Invokes \p func(firstIndex, chunkAccessor) for every chunk in parallel.
+		template <typename Callback>
+		void ParallelForEachChunk(const Callback& func);
+
+		//! Invokes \p func(firstIndex, chunkAccessor) for every chunk in parallel.
+		template <typename Callback>
+		void ParallelForEachChunk(const Callback& func) const;
+
+	private:
+		size_t m_chunkShift;
+		std::string m_backingDirectory;
+		size_t m_reservedSize;
+		size_t m_size = 0;
+		T* m_data = nullptr;
+
+		// Created on the first growth, so empty arrays take no address space
+		std::unique_ptr<PageStorage> m_storage;
+
+		void Commit(size_t size);
+	};
+}
+
+#include <Array/PagedArray1-Impl.h>
+
+#endif
\ No newline at end of file
@@ -10,6 +10,7 @@
 #define CUBBYFLOW_COLLIDER3_H
 
 #include <Surface/Surface3.h>
+#include <Utils/Checkpoint.h>
 
 #include <functional>
 
@@ -83,6 +84,20 @@ namespace CubbyFlow
 		//!
 		void SetOnBeginUpdateCallback(const OnBeginUpdateCallback& callback);
 
+		//!
+		//! \brief      Writes the collider state to the checkpoint.
+		//!
+		//! The friction coefficient and the transform of the surface are saved
+		//! so that animated colliders can be restored exactly.
+		//!
+		//! \param[in]  writer  The checkpoint writer.
+		//! \param[in]  prefix  The prefix of the chunk names.
+		//!
+		virtual void SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const;
+
+		//! Restores the collider state from the checkpoint.
+		virtual void LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix);
+
 	protected:
 		//! Internal query result structure.
 		struct ColliderQueryResult final
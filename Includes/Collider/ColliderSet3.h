@@ -10,6 +10,7 @@
 #define CUBBYFLOW_COLLIDER_SET3_H
 
 #include <Collider/Collider3.h>
+#include <Surface/SurfaceSet3.h>
 
 #include <vector>
 
@@ -39,11 +40,19 @@ namespace CubbyFlow
 		//! Returns collider at index \p i.
 		Collider3Ptr Collider(size_t i) const;
 
+		//! Writes the collider state to the checkpoint.
+		void SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const override;
+
+		//! Restores the collider state from the checkpoint.
+		void LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix) override;
+
 		//! Returns builder fox ColliderSet3.
 		static Builder GetBuilder();
 
 	private:
 		std::vector<Collider3Ptr> m_colliders;
+		SurfaceSet3Ptr m_surfaceSet;
+		std::vector<size_t> m_colliderIndices;
 	};
 
 	//! Shared pointer for the ColliderSet3 type.
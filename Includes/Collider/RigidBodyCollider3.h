@@ -40,6 +40,12 @@ namespace CubbyFlow
 		//! Returns the velocity of the collider at given \p point.
 		Vector3D VelocityAt(const Vector3D& point) const override;
 
+		//! Writes the collider state to the checkpoint.
+		void SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const override;
+
+		//! Restores the collider state from the checkpoint.
+		void LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix) override;
+
 		//! Returns builder fox RigidBodyCollider3.
 		static Builder GetBuilder();
 	};
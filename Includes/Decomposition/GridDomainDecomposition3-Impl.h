@@ -0,0 +1,64 @@
+/*************************************************************************
+> File Name: GridDomainDecomposition3-Impl.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: 3-D decomposition of a grid into subdomains with ghost-cell halos.
+> Created Time: 2017/10/26
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_GRID_DOMAIN_DECOMPOSITION3_IMPL_H
+#define CUBBYFLOW_GRID_DOMAIN_DECOMPOSITION3_IMPL_H
+
+#include <Utils/Parallel.h>
+
+#include <cassert>
+
+namespace CubbyFlow
+{
+	template <typename T>
+	void GridDomainDecomposition3::Scatter(size_t rank, const ConstArrayAccessor3<T>& global, Array3<T>* local) const
+	{
+		assert(global.size() == m_resolution);
+
+		const Size3 origin = SubdomainOrigin(rank);
+		const Size3 localSize = LocalSize(rank);
+
+		local->Resize(localSize);
+
+		ParallelFor(ZERO_SIZE, localSize.x, ZERO_SIZE, localSize.y, ZERO_SIZE, localSize.z,
+			[&](size_t i, size_t j, size_t k)
+		{
+			// Wraps around below zero, so one comparison covers both sides
+			const size_t gi = origin.x + i - m_ghostWidth;
+			const size_t gj = origin.y + j - m_ghostWidth;
+			const size_t gk = origin.z + k - m_ghostWidth;
+
+			if (gi < m_resolution.x && gj < m_resolution.y && gk < m_resolution.z)
+			{
+				(*local)(i, j, k) = global(gi, gj, gk);
+			}
+			else
+			{
+				(*local)(i, j, k) = T();
+			}
+		});
+	}
+
+	template <typename T>
+	void GridDomainDecomposition3::Gather(size_t rank, const ConstArrayAccessor3<T>& local, ArrayAccessor3<T> global) const
+	{
+		assert(global.size() == m_resolution);
+		assert(local.size() == LocalSize(rank));
+
+		const Size3 origin = SubdomainOrigin(rank);
+		const Size3 resolution = SubdomainResolution(rank);
+
+		ParallelFor(ZERO_SIZE, resolution.x, ZERO_SIZE, resolution.y, ZERO_SIZE, resolution.z,
+			[&](size_t i, size_t j, size_t k)
+		{
+			global(origin.x + i, origin.y + j, origin.z + k) = local(i + m_ghostWidth, j + m_ghostWidth, k + m_ghostWidth);
+		});
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,112 @@
+/*************************************************************************
+> File Name: GridDomainDecomposition3.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: 3-D decomposition of a grid into subdomains with ghost-cell halos.
+> Created Time: 2017/10/26
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_GRID_DOMAIN_DECOMPOSITION3_H
+#define CUBBYFLOW_GRID_DOMAIN_DECOMPOSITION3_H
+
+#include <Array/Array3.h>
+#include <Decomposition/SubdomainTransport.h>
+#include <Size/Size3.h>
+
+#include <limits>
+
+namespace CubbyFlow
+{
+	//!
+	//! \brief 3-D decomposition of a grid into subdomains with ghost-cell halos.
+	//!
+	//! The grid is split into layout.x * layout.y * layout.z boxes of nearly
+	//! equal size, and the box at (a, b, c) of the layout is owned by rank
+	//! a + layout.x * (b + layout.y * c). The local array of a rank holds its
+	//! interior cells surrounded by ghostWidth layers of ghost cells on every
+	//! side, so the local index (i, j, k) maps to the global index
+	//! origin + (i, j, k) - ghostWidth.
+	//!
+	//! The ghost cells are filled from the neighboring subdomains through a
+	//! SubdomainTransport, so the same code runs whether the ranks are threads
+	//! or processes. The ghost cells outside of the grid are left untouched.
+	//!
+	class GridDomainDecomposition3
+	{
+	public:
+		//! Rank returned for the neighbors outside of the grid.
+		static constexpr size_t NO_NEIGHBOR = std::numeric_limits<size_t>::max();
+
+		//! Constructs the decomposition of a grid with given resolution.
+		GridDomainDecomposition3(const Size3& resolution, const Size3& layout, size_t ghostWidth = 1);
+
+		//! Returns the resolution of the whole grid.
+		const Size3& Resolution() const;
+
+		//! Returns the number of subdomains along each axis.
+		const Size3& Layout() const;
+
+		//! Returns the number of ghost layers.
+		size_t GhostWidth() const;
+
+		//! Returns the number of subdomains.
+		size_t NumberOfSubdomains() const;
+
+		//! Returns the position of the subdomain in the layout.
+		Size3 SubdomainCoordinate(size_t rank) const;
+
+		//! Returns the global index of the first interior cell of the subdomain.
+		Size3 SubdomainOrigin(size_t rank) const;
+
+		//! Returns the number of interior cells of the subdomain.
+		Size3 SubdomainResolution(size_t rank) const;
+
+		//! Returns the size of the local array including the ghost cells.
+		Size3 LocalSize(size_t rank) const;
+
+		//! Returns the neighbor of the subdomain along the axis toward the
+		//! negative (\p direction < 0) or positive side, or NO_NEIGHBOR.
+		size_t Neighbor(size_t rank, size_t axis, int direction) const;
+
+		//! Returns the rank owning the cell with given global index.
+		size_t RankAt(const Size3& index) const;
+
+		//!
+		//! \brief Copies the subdomain and its halo from the global array.
+		//!
+		//! The local array is resized to LocalSize(rank), and the ghost cells
+		//! outside of the grid are set to T().
+		//!
+		template <typename T>
+		void Scatter(size_t rank, const ConstArrayAccessor3<T>& global, Array3<T>* local) const;
+
+		//! Copies the interior cells of the local array to the global array.
+		template <typename T>
+		void Gather(size_t rank, const ConstArrayAccessor3<T>& local, ArrayAccessor3<T> global) const;
+
+		//!
+		//! \brief Fills the ghost cells of the local array from the neighbors.
+		//!
+		//! Every rank must call this function. The halos are exchanged one
+		//! axis after another over the full local extent of the other axes,
+		//! so the edge and corner ghost cells are filled as well.
+		//!
+		void ExchangeHalos(size_t rank, SubdomainTransport* transport, Array3<double>* local) const;
+
+	private:
+		Size3 m_resolution;
+		Size3 m_layout;
+		size_t m_ghostWidth;
+
+		// First global index of each subdomain along each axis, followed by
+		// the resolution of the axis.
+		std::vector<size_t> m_splits[3];
+	};
+
+	//! Shared pointer type for the GridDomainDecomposition3.
+	using GridDomainDecomposition3Ptr = std::shared_ptr<GridDomainDecomposition3>;
+}
+
+#include <Decomposition/GridDomainDecomposition3-Impl.h>
+
+#endif
\ No newline at end of file
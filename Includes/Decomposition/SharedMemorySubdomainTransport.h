@@ -0,0 +1,116 @@
+/*************************************************************************
+> File Name: SharedMemorySubdomainTransport.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Subdomain transport running the ranks as threads of one process.
+> Created Time: 2017/10/26
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_SHARED_MEMORY_SUBDOMAIN_TRANSPORT_H
+#define CUBBYFLOW_SHARED_MEMORY_SUBDOMAIN_TRANSPORT_H
+
+#include <Decomposition/SubdomainTransport.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+
+namespace CubbyFlow
+{
+	//!
+	//! \brief Subdomain transport running the ranks as threads of one process.
+	//!
+	//! Each rank runs on its own thread. Rank 0 runs on the calling thread,
+	//! and the other ranks run on worker threads that are started by the
+	//! first Run and reused by the later ones. Messages are copied into
+	//! per-channel mailboxes, so a send never blocks. The reductions collect
+	//! one value per rank and the last arriving rank combines them in the
+	//! rank order.
+	//!
+	class SharedMemorySubdomainTransport final : public SubdomainTransport
+	{
+	public:
+		//! Constructs the transport with given number of ranks.
+		explicit SharedMemorySubdomainTransport(size_t numberOfSubdomains);
+
+		//! Stops and joins the worker threads.
+		~SharedMemorySubdomainTransport();
+
+		//! Returns the number of ranks.
+		size_t NumberOfSubdomains() const override;
+
+		//!
+		//! \brief Runs \p func(rank) on its own thread for every rank.
+		//!
+		//! If any rank throws, the transport is aborted: the ranks waiting in
+		//! Receive, the reductions, or Barrier, and the ranks calling them
+		//! later, throw std::runtime_error instead of waiting for the throwing
+		//! rank. The first exception is rethrown once every rank has returned,
+		//! and the pending messages are dropped so the next Run starts clean.
+		//!
+		//! Must not be called from a rank or from several threads at once.
+		//!
+		void Run(const std::function<void(size_t)>& func) override;
+
+		//! Sends the data from rank \p from to rank \p to.
+		void Send(size_t from, size_t to, int tag, const std::vector<double>& data) override;
+
+		//! Waits for the message with the tag from rank \p from to rank \p to.
+		void Receive(size_t to, size_t from, int tag, std::vector<double>* data) override;
+
+		//! Returns the sum of the values from all ranks.
+		double AllReduceSum(size_t rank, double value) override;
+
+		//! Returns the max of the values from all ranks.
+		double AllReduceMax(size_t rank, double value) override;
+
+		//! Waits until all ranks reach the barrier.
+		void Barrier(size_t rank) override;
+
+	private:
+		using ChannelKey = std::tuple<size_t, size_t, int>;
+
+		size_t m_numberOfSubdomains;
+
+		std::mutex m_messageMutex;
+		std::condition_variable m_messageCondition;
+		std::map<ChannelKey, std::deque<std::vector<double>>> m_mailboxes;
+
+		std::mutex m_reduceMutex;
+		std::condition_variable m_reduceCondition;
+		std::vector<double> m_reduceValues;
+		size_t m_reduceArrived;
+		size_t m_reduceGeneration;
+		double m_reduceResult;
+
+		std::atomic<bool> m_isAborted;
+
+		std::mutex m_runMutex;
+		std::condition_variable m_runCondition;
+		std::condition_variable m_doneCondition;
+		std::vector<std::thread> m_workers;
+		const std::function<void(size_t)>* m_job;
+		size_t m_jobGeneration;
+		size_t m_numberOfRunningWorkers;
+		bool m_isStopping;
+		std::exception_ptr m_firstException;
+
+		double AllReduce(size_t rank, double value, const std::function<double(double, double)>& op);
+
+		void RunWorker(size_t rank, size_t jobGeneration);
+
+		void RunRank(size_t rank, const std::function<void(size_t)>& func);
+
+		void Abort();
+	};
+
+	//! Shared pointer type for the SharedMemorySubdomainTransport.
+	using SharedMemorySubdomainTransportPtr = std::shared_ptr<SharedMemorySubdomainTransport>;
+}
+
+#endif
\ No newline at end of file
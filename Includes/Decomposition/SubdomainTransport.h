@@ -0,0 +1,78 @@
+/*************************************************************************
+> File Name: SubdomainTransport.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Abstract base class for the communication between subdomains.
+> Created Time: 2017/10/26
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_SUBDOMAIN_TRANSPORT_H
+#define CUBBYFLOW_SUBDOMAIN_TRANSPORT_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace CubbyFlow
+{
+	//!
+	//! \brief Abstract base class for the communication between subdomains.
+	//!
+	//! A decomposed simulation runs the same function on every subdomain (or
+	//! rank), and the ranks exchange the data only through this interface.
+	//! Thus, the code written against this class does not depend on whether
+	//! the ranks are threads in one process or separate processes.
+	//!
+	class SubdomainTransport
+	{
+	public:
+		//! Default constructor.
+		SubdomainTransport() = default;
+
+		//! Deleted copy constructor.
+		SubdomainTransport(const SubdomainTransport&) = delete;
+
+		//! Default virtual destructor.
+		virtual ~SubdomainTransport() = default;
+
+		//! Deleted copy assignment operator.
+		SubdomainTransport& operator=(const SubdomainTransport&) = delete;
+
+		//! Returns the number of ranks.
+		virtual size_t NumberOfSubdomains() const = 0;
+
+		//!
+		//! \brief Runs \p func(rank) on every rank and waits for all of them.
+		//!
+		//! Backends running one rank per process invoke the function only with
+		//! the rank of the calling process.
+		//!
+		virtual void Run(const std::function<void(size_t)>& func) = 0;
+
+		//!
+		//! \brief Sends the data from rank \p from to rank \p to.
+		//!
+		//! The call does not wait for the matching receive. Messages with the
+		//! same source, destination, and tag are received in the sent order.
+		//!
+		virtual void Send(size_t from, size_t to, int tag, const std::vector<double>& data) = 0;
+
+		//! Waits for the message with the tag from rank \p from to rank \p to.
+		virtual void Receive(size_t to, size_t from, int tag, std::vector<double>* data) = 0;
+
+		//! Returns the sum of the values from all ranks.
+		//! The sum is accumulated in the rank order, so it is deterministic.
+		virtual double AllReduceSum(size_t rank, double value) = 0;
+
+		//! Returns the max of the values from all ranks.
+		virtual double AllReduceMax(size_t rank, double value) = 0;
+
+		//! Waits until all ranks reach the barrier.
+		virtual void Barrier(size_t rank) = 0;
+	};
+
+	//! Shared pointer type for the SubdomainTransport.
+	using SubdomainTransportPtr = std::shared_ptr<SubdomainTransport>;
+}
+
+#endif
\ No newline at end of file
@@ -9,6 +9,8 @@
 #ifndef CUBBYFLOW_GRID_EMITTER3_H
 #define CUBBYFLOW_GRID_EMITTER3_H
 
+#include <Utils/Checkpoint.h>
+
 #include <functional>
 #include <memory>
 
@@ -50,6 +52,12 @@ namespace CubbyFlow
 		//!
 		void SetOnBeginUpdateCallback(const OnBeginUpdateCallback& callback);
 
+		//! Writes the emitter state to the checkpoint.
+		virtual void SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const;
+
+		//! Restores the emitter state from the checkpoint.
+		virtual void LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix);
+
 	protected:
 		virtual void OnUpdate(double currentTimeInSeconds, double timeIntervalInSeconds) = 0;
 
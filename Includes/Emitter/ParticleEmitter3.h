@@ -55,6 +55,12 @@ namespace CubbyFlow
 		//!
 		void SetOnBeginUpdateCallback(const OnBeginUpdateCallback& callback);
 
+		//! Writes the emitter state to the checkpoint.
+		virtual void SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const;
+
+		//! Restores the emitter state from the checkpoint.
+		virtual void LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix);
+
 	protected:
 		//! Called when ParticleEmitter3::SetTarget is executed.
 		virtual void OnSetTarget(const ParticleSystemData3Ptr& particles);
@@ -33,6 +33,12 @@ namespace CubbyFlow
 		//! Adds sub-emitter.
 		void AddEmitter(const ParticleEmitter3Ptr& emitter);
 
+		//! Writes the emitter state to the checkpoint.
+		void SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const override;
+
+		//! Restores the emitter state from the checkpoint.
+		void LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix) override;
+
 		//! Returns builder fox ParticleEmitterSet3.
 		static Builder GetBuilder();
 
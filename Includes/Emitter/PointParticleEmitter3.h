@@ -62,6 +62,12 @@ namespace CubbyFlow
 		//! Sets max number of particles to be emitted.
 		void SetMaxNumberOfParticles(size_t maxNumberOfParticles);
 
+		//! Writes the emitter state to the checkpoint.
+		void SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const override;
+
+		//! Restores the emitter state from the checkpoint.
+		void LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix) override;
+
 		//! Returns builder fox PointParticleEmitter3.
 		static Builder GetBuilder();
 
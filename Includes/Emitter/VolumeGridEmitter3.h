@@ -89,6 +89,12 @@ namespace CubbyFlow
 		//! Returns true if this emits only once.
 		bool GetIsOneShot() const;
 
+		//! Writes the emitter state to the checkpoint.
+		void SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const override;
+
+		//! Restores the emitter state from the checkpoint.
+		void LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix) override;
+
 		//! Returns builder fox VolumeGridEmitter3.
 		static Builder GetBuilder();
 
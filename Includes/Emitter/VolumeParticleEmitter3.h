@@ -13,14 +13,16 @@
 #include <PointGenerator/PointGenerator3.h>
 #include <Surface/Implicit/ImplicitSurface3.h>
 
-#include <random>
-
 namespace CubbyFlow
 {
 	//!
 	//! \brief 3-D volumetric particle emitter.
 	//!
-	//! This class emits particles from volumetric geometry.
+	//! This class emits particles from volumetric geometry. The candidate points
+	//! are jittered, classified against the geometry and tested for overlap in
+	//! parallel. The jitter is drawn from a counter-based random number
+	//! generator keyed by the seed, the emission count and the point index, so
+	//! the result does not depend on the number of threads.
 	//!
 	class VolumeParticleEmitter3 final : public ParticleEmitter3
 	{
@@ -117,11 +119,18 @@ namespace CubbyFlow
 		//! Returns the initial velocity of the particles.
 		void SetInitialVelocity(const Vector3D& newInitialVel);
 
+		//! Writes the emitter state to the checkpoint.
+		void SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const override;
+
+		//! Restores the emitter state from the checkpoint.
+		void LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix) override;
+
 		//! Returns builder fox VolumeParticleEmitter3.
 		static Builder GetBuilder();
 
 	private:
-		std::mt19937 m_rng;
+		uint32_t m_seed;
+		uint64_t m_numberOfEmissions = 0;
 
 		ImplicitSurface3Ptr m_implicitSurface;
 		BoundingBox3D m_bounds;
@@ -146,8 +155,6 @@ namespace CubbyFlow
 
 		void Emit(const ParticleSystemData3Ptr& particles,
 			Array1<Vector3D>* newPositions, Array1<Vector3D>* newVelocities);
-
-		double Random();
 	};
 
 	//! Shared pointer for the VolumeParticleEmitter3 type.
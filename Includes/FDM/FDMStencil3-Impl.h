@@ -0,0 +1,155 @@
+/*************************************************************************
+> File Name: FDMStencil3-Impl.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Temporally blocked executor of 3-D 7-point stencils.
+> Created Time: 2017/10/30
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_FDM_STENCIL3_IMPL_H
+#define CUBBYFLOW_FDM_STENCIL3_IMPL_H
+
+#include <Utils/Parallel.h>
+
+#include <vector>
+
+namespace CubbyFlow
+{
+	template <typename T, typename Kernel>
+	void FDMStencil3::Apply(
+		const Kernel& kernel,
+		unsigned int numberOfIterations,
+		ArrayAccessor3<T> x,
+		ArrayAccessor3<T> buffer) const
+	{
+		const Size3 size = x.size();
+		const bool isBlocked = size.x * size.y * size.z * sizeof(T) >= m_minGridSizeInBytes;
+		const unsigned int temporalBlockSize = isBlocked ? m_temporalBlockSize : 1;
+		bool isInBuffer = false;
+
+		while (numberOfIterations > 0)
+		{
+			const unsigned int numberOfSteps = std::min(numberOfIterations, temporalBlockSize);
+
+			if (isInBuffer)
+			{
+				ApplyPass(kernel, numberOfSteps, ConstArrayAccessor3<T>(buffer), x);
+			}
+			else
+			{
+				ApplyPass(kernel, numberOfSteps, ConstArrayAccessor3<T>(x), buffer);
+			}
+
+			isInBuffer = !isInBuffer;
+			numberOfIterations -= numberOfSteps;
+		}
+
+		if (isInBuffer)
+		{
+			buffer.ParallelForEachIndex([&](size_t i, size_t j, size_t k)
+			{
+				x(i, j, k) = buffer(i, j, k);
+			});
+		}
+	}
+
+	template <typename T, typename Kernel>
+	void FDMStencil3::ApplyPass(
+		const Kernel& kernel,
+		unsigned int numberOfSteps,
+		ConstArrayAccessor3<T> input,
+		ArrayAccessor3<T> output) const
+	{
+		const Size3 size = input.size();
+
+		if (size.x == 0 || size.y == 0 || size.z == 0)
+		{
+			return;
+		}
+
+		// Each intermediate step keeps three planes of its extended rows
+		const size_t halo = numberOfSteps - 1;
+		const size_t rowSizeInBytes = size.x * sizeof(T);
+		size_t blockSize = size.y;
+
+		if (halo > 0)
+		{
+			const size_t maxNumberOfRows = m_cacheSizeInBytes / (3 * halo * rowSizeInBytes);
+			blockSize = (maxNumberOfRows > 3 * halo) ? maxNumberOfRows - 2 * halo : halo;
+		}
+
+		// Keep every thread busy
+		const size_t numberOfThreads = GetMaxNumberOfThreads();
+		blockSize = std::max<size_t>(std::min(blockSize, (size.y + numberOfThreads - 1) / numberOfThreads), 1);
+
+		const size_t numberOfBlocks = (size.y + blockSize - 1) / blockSize;
+
+		ParallelFor(ZERO_SIZE, numberOfBlocks, [&](size_t block)
+		{
+			const size_t j0 = block * blockSize;
+			const size_t j1 = std::min(j0 + blockSize, size.y);
+			const size_t jBegin = (j0 > halo) ? j0 - halo : 0;
+			const size_t jEnd = std::min(j1 + halo, size.y);
+			const size_t planeSize = size.x * (jEnd - jBegin);
+
+			std::vector<T> planes(3 * halo * planeSize);
+
+			const auto getRow = [&](size_t step, size_t j, size_t k) -> T*
+			{
+				return planes.data() + ((step - 1) * 3 + k % 3) * planeSize + (j - jBegin) * size.x;
+			};
+
+			// Step t computes plane s - t + 1 at s, after step t - 1 has
+			// computed the plane next to it
+			for (size_t s = 0; s + 1 < size.z + numberOfSteps; ++s)
+			{
+				for (size_t t = 1; t <= numberOfSteps && t <= s + 1; ++t)
+				{
+					const size_t k = s + 1 - t;
+
+					if (k >= size.z)
+					{
+						continue;
+					}
+
+					const size_t remainingSteps = numberOfSteps - t;
+					const size_t ja = (j0 > remainingSteps) ? j0 - remainingSteps : 0;
+					const size_t jb = std::min(j1 + remainingSteps, size.y);
+
+					const auto getSource = [&](size_t j, size_t kk) -> const T*
+					{
+						return (t == 1) ? input.data() + (kk * size.y + j) * size.x : getRow(t - 1, j, kk);
+					};
+
+					for (size_t j = ja; j < jb; ++j)
+					{
+						const T* center = getSource(j, k);
+						const T* down = (j > 0) ? getSource(j - 1, k) : center;
+						const T* up = (j + 1 < size.y) ? getSource(j + 1, k) : center;
+						const T* back = (k > 0) ? getSource(j, k - 1) : center;
+						const T* front = (k + 1 < size.z) ? getSource(j, k + 1) : center;
+						T* dest = (t == numberOfSteps) ? output.data() + (k * size.y + j) * size.x : getRow(t, j, k);
+
+						for (size_t i = 0; i < size.x; ++i)
+						{
+							const FDMStencilValues3<T> values
+							{
+								center[i],
+								(i > 0) ? center[i - 1] : center[i],
+								(i + 1 < size.x) ? center[i + 1] : center[i],
+								down[i],
+								up[i],
+								back[i],
+								front[i]
+							};
+
+							dest[i] = kernel(i, j, k, values);
+						}
+					}
+				}
+			}
+		});
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,114 @@
+/*************************************************************************
+> File Name: FDMStencil3.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Temporally blocked executor of 3-D 7-point stencils.
+> Created Time: 2017/10/30
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_FDM_STENCIL3_H
+#define CUBBYFLOW_FDM_STENCIL3_H
+
+#include <Array/ArrayAccessor3.h>
+
+namespace CubbyFlow
+{
+	//!
+	//! \brief Values of a cell and its six face neighbors.
+	//!
+	//! A neighbor outside of the array holds the value of the cell itself, so
+	//! that a difference toward the outside vanishes.
+	//!
+	template <typename T>
+	struct FDMStencilValues3
+	{
+		T center;
+		T left;
+		T right;
+		T down;
+		T up;
+		T back;
+		T front;
+	};
+
+	//!
+	//! \brief Temporally blocked executor of 3-D 7-point stencils.
+	//!
+	//! Iterative stencil updates such as Jacobi relaxation or explicit
+	//! diffusion read and write the entire grid once per iteration, so they
+	//! are bound by the memory bandwidth. This class applies several
+	//! iterations per pass over the grid instead. The rows are split into
+	//! blocks whose intermediate iterations fit in the cache, and each block
+	//! advances a wavefront along the k-axis, keeping only three planes of
+	//! each intermediate iteration. The blocks recompute the overlapping rows
+	//! near their borders, so that they are updated in parallel without any
+	//! synchronization within a pass.
+	//!
+	//! The result is identical to applying the kernel iteration by iteration.
+	//!
+	//! On grids smaller than the given minimum size, the overlapping rows cost
+	//! more than the saved memory traffic, so such grids are updated one
+	//! iteration per pass.
+	//!
+	class FDMStencil3 final
+	{
+	public:
+		//!
+		//! \brief Constructs the executor.
+		//!
+		//! \param temporalBlockSize  Number of iterations applied per pass.
+		//! \param cacheSizeInBytes   Budget for the intermediate iterations of
+		//!                           a block, which should fit in the L2 cache.
+		//! \param minGridSizeInBytes Minimum size of the array for applying
+		//!                           more than one iteration per pass.
+		//!
+		explicit FDMStencil3(
+			unsigned int temporalBlockSize = 4,
+			size_t cacheSizeInBytes = 256 * 1024,
+			size_t minGridSizeInBytes = 16 * 1024 * 1024);
+
+		//! Returns the number of iterations applied per pass.
+		unsigned int GetTemporalBlockSize() const;
+
+		//! Returns the cache budget of a block in bytes.
+		size_t GetCacheSizeInBytes() const;
+
+		//! Returns the minimum array size in bytes for the temporal blocking.
+		size_t GetMinGridSizeInBytes() const;
+
+		//!
+		//! \brief Applies \p kernel to \p x for \p numberOfIterations times.
+		//!
+		//! \p kernel is invoked as kernel(i, j, k, values) with
+		//! FDMStencilValues3<T> of the previous iteration and returns the new
+		//! value of the cell. It is invoked concurrently, possibly more than
+		//! once for the same cell and iteration, so it must not have side
+		//! effects.
+		//!
+		//! \param x      Input, and the output after the iterations.
+		//! \param buffer Scratch array of the same size as \p x.
+		//!
+		template <typename T, typename Kernel>
+		void Apply(
+			const Kernel& kernel,
+			unsigned int numberOfIterations,
+			ArrayAccessor3<T> x,
+			ArrayAccessor3<T> buffer) const;
+
+	private:
+		unsigned int m_temporalBlockSize;
+		size_t m_cacheSizeInBytes;
+		size_t m_minGridSizeInBytes;
+
+		template <typename T, typename Kernel>
+		void ApplyPass(
+			const Kernel& kernel,
+			unsigned int numberOfSteps,
+			ConstArrayAccessor3<T> input,
+			ArrayAccessor3<T> output) const;
+	};
+}
+
+#include <FDM/FDMStencil3-Impl.h>
+
+#endif
\ No newline at end of file
@@ -0,0 +1,108 @@
+/*************************************************************************
+> File Name: AdaptiveDistanceField3.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: 3-D adaptively sampled distance field.
+> Created Time: 2017/10/25
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_ADAPTIVE_DISTANCE_FIELD3_H
+#define CUBBYFLOW_ADAPTIVE_DISTANCE_FIELD3_H
+
+#include <BoundingBox/BoundingBox3.h>
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace CubbyFlow
+{
+	//!
+	//! \brief 3-D adaptively sampled distance field.
+	//!
+	//! This class bakes a signed-distance function into an octree whose leaves
+	//! store the distances and the gradients at their eight corners. A cell is
+	//! subdivided while the trilinear reconstruction deviates from the function
+	//! by more than the tolerance at the cell center, face centers, or edge
+	//! midpoints, and the maximum depth is not reached yet. Thus, the cells are
+	//! fine where the field is curved (near the surface features) and coarse
+	//! elsewhere. Queries descend the tree once and interpolate, so their cost
+	//! only depends on the depth, not on the cost of the baked function.
+	//!
+	//! The octree is built level by level, evaluating the cells of each level
+	//! in parallel. The corners shared by adjacent leaves are stored once, and
+	//! their gradients are computed once.
+	//!
+	//! \see Frisken et al., Adaptively sampled distance fields: A general
+	//!      representation of shape for computer graphics, SIGGRAPH 2000.
+	//!
+	class AdaptiveDistanceField3 final
+	{
+	public:
+		//!
+		//! Bakes the given signed-distance function within the domain.
+		//!
+		//! \param func Signed-distance function to bake.
+		//! \param domain Bounding box of the baked region.
+		//! \param maxDepth Max depth of the octree, up to 20. The finest cell
+		//!                 size is domain size / 2^maxDepth.
+		//! \param tolerance Max allowed interpolation error before subdividing.
+		//! \param resolution Finite differencing resolution for the gradients.
+		//!
+		//! \warning The function is evaluated from multiple threads.
+		//!
+		AdaptiveDistanceField3(
+			const std::function<double(const Vector3D&)>& func,
+			const BoundingBox3D& domain,
+			unsigned int maxDepth = 8,
+			double tolerance = 1e-3,
+			double resolution = 1e-3);
+
+		//! Returns the interpolated signed distance at given point.
+		double Sample(const Vector3D& pt) const;
+
+		//! Returns the interpolated gradient at given point.
+		Vector3D Gradient(const Vector3D& pt) const;
+
+		//! Returns the interpolated signed distance and gradient at given point.
+		void Sample(const Vector3D& pt, double* distance, Vector3D* gradient) const;
+
+		//! Returns the baked domain.
+		const BoundingBox3D& Domain() const;
+
+		//! Returns the max depth of the octree.
+		unsigned int MaxDepth() const;
+
+		//! Returns the number of leaf cells.
+		size_t NumberOfLeaves() const;
+
+		//! Returns the memory footprint of the octree in bytes.
+		size_t MemoryUsage() const;
+
+	private:
+		struct Corner
+		{
+			double distance;
+			Vector3D gradient;
+		};
+
+		BoundingBox3D m_domain;
+		unsigned int m_maxDepth;
+
+		// First child node index of the internal nodes, or LEAF_FLAG | leaf
+		// index for the leaves.
+		std::vector<size_t> m_nodes;
+
+		// Corners are shared by the adjacent leaves.
+		std::vector<std::array<size_t, 8>> m_leaves;
+		std::vector<Corner> m_corners;
+
+		const std::array<size_t, 8>& FindLeaf(const Vector3D& pt, BoundingBox3D* cell) const;
+	};
+
+	//! Shared pointer type for the AdaptiveDistanceField3.
+	using AdaptiveDistanceField3Ptr = std::shared_ptr<AdaptiveDistanceField3>;
+}
+
+#endif
\ No newline at end of file
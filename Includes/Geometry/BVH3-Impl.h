@@ -53,14 +53,14 @@ namespace CubbyFlow
 	{
 		m_items = items;
 		m_itemBounds = itemsBounds;
+		m_bound = BoundingBox3D();
+		m_nodes.clear();
 
 		if (m_items.empty())
 		{
 			return;
 		}
 
-		m_nodes.clear();
-
 		for (size_t i = 0; i < m_items.size(); ++i)
 		{
 			m_bound.Merge(m_itemBounds[i]);
@@ -90,6 +90,11 @@ namespace CubbyFlow
 		best.distance = std::numeric_limits<double>::max();
 		best.item = nullptr;
 
+		if (m_nodes.empty())
+		{
+			return best;
+		}
+
 		// Prepare to traverse BVH
 		static const int maxTreeDepth = 8 * sizeof(size_t);
 		const Node* todo[maxTreeDepth];
@@ -188,6 +193,106 @@ namespace CubbyFlow
 		return best;
 	}
 
+	template <typename T>
+	template <typename SignedDistanceFunc>
+	NearestNeighborQueryResult3<T> BVH3<T>::GetMinimumSignedDistance(
+		const Vector3D& pt,
+		const SignedDistanceFunc& signedDistanceFunc) const
+	{
+		NearestNeighborQueryResult3<T> best;
+		best.distance = std::numeric_limits<double>::max();
+		best.item = nullptr;
+
+		if (m_nodes.empty())
+		{
+			return best;
+		}
+
+		// Prepare to traverse BVH
+		static const int maxTreeDepth = 8 * sizeof(size_t);
+		const Node* todo[maxTreeDepth];
+		size_t todoPos = 0;
+
+		// Traverse BVH nodes
+		const Node* node = m_nodes.data();
+		while (node != nullptr)
+		{
+			if (node->IsLeaf())
+			{
+				double dist = signedDistanceFunc(m_items[node->item], pt);
+				if (dist < best.distance)
+				{
+					best.distance = dist;
+					best.item = &m_items[node->item];
+				}
+
+				// Grab next node to process from todo stack
+				if (todoPos > 0)
+				{
+					// Dequeue
+					--todoPos;
+					node = todo[todoPos];
+				}
+				else
+				{
+					break;
+				}
+			}
+			else
+			{
+				const Node* left = node + 1;
+				const Node* right = &m_nodes[node->child];
+
+				double distMinLeftSqr = left->bound.Clamp(pt).DistanceSquaredTo(pt);
+				double distMinRightSqr = right->bound.Clamp(pt).DistanceSquaredTo(pt);
+
+				// Points inside of a box can have any signed distance, so the box
+				// can only be skipped if the point is outside of it.
+				const auto shouldVisit = [&best](double distMinSqr)
+				{
+					return distMinSqr <= 0.0 || (best.distance > 0.0 && distMinSqr < best.distance * best.distance);
+				};
+
+				bool shouldVisitLeft = shouldVisit(distMinLeftSqr);
+				bool shouldVisitRight = shouldVisit(distMinRightSqr);
+
+				if (shouldVisitLeft && shouldVisitRight)
+				{
+					const Node* firstChild = (distMinLeftSqr < distMinRightSqr) ? left : right;
+					const Node* secondChild = (distMinLeftSqr < distMinRightSqr) ? right : left;
+
+					// Enqueue secondChild in todo stack
+					todo[todoPos] = secondChild;
+					++todoPos;
+					node = firstChild;
+				}
+				else if (shouldVisitLeft)
+				{
+					node = left;
+				}
+				else if (shouldVisitRight)
+				{
+					node = right;
+				}
+				else
+				{
+					if (todoPos > 0)
+					{
+						// Dequeue
+						--todoPos;
+						node = todo[todoPos];
+					}
+					else
+					{
+						break;
+					}
+				}
+			}
+		}
+
+		return best;
+	}
+
 	template <typename T>
 	inline bool BVH3<T>::IsIntersects(const BoundingBox3D& box,
 		const BoxIntersectionTestFunc3<T>& testFunc) const
@@ -46,6 +46,21 @@ namespace CubbyFlow
 			const Vector3D& pt,
 			const NearestNeighborDistanceFunc3<T>& distanceFunc) const override;
 
+		//!
+		//! \brief Returns the item with the minimum signed distance to \p pt.
+		//!
+		//! Unlike BVH3::GetNearestNeighbor, \p signedDistanceFunc may return
+		//! negative values. A subtree is skipped when \p pt lies outside of its
+		//! bounding box by at least the current minimum, so the signed distance
+		//! of each item must not be less than the distance from \p pt to its
+		//! bounding box whenever \p pt is outside of the box. Items can be
+		//! excluded from the query by returning std::numeric_limits<double>::max().
+		//!
+		template <typename SignedDistanceFunc>
+		NearestNeighborQueryResult3<T> GetMinimumSignedDistance(
+			const Vector3D& pt,
+			const SignedDistanceFunc& signedDistanceFunc) const;
+
 		//! Returns true if given \p box intersects with any of the stored items.
 		bool IsIntersects(const BoundingBox3D& box,
 			const BoxIntersectionTestFunc3<T>& testFunc) const override;
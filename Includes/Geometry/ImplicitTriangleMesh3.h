@@ -37,8 +37,27 @@ namespace CubbyFlow
 			const Transform3& transform = Transform3(),
 			bool isNormalFlipped = false);
 
+		//! Constructs the surface from the signed-distance field of the mesh
+		//! baked in advance. The grid is shared, not copied, and must not be
+		//! modified afterward.
+		ImplicitTriangleMesh3(
+			const TriangleMesh3Ptr& mesh,
+			const VertexCenteredScalarGrid3Ptr& grid,
+			const Transform3& transform = Transform3(),
+			bool isNormalFlipped = false);
+
 		virtual ~ImplicitTriangleMesh3();
 
+		//!
+		//! \brief Bakes the signed-distance field of the mesh.
+		//!
+		//! The grid covers the bounding box of the mesh enlarged by \p margin
+		//! times its size with \p resolutionX points along the x-axis. The
+		//! result can be shared by many ImplicitTriangleMesh3 instances.
+		//!
+		static VertexCenteredScalarGrid3Ptr BakeSignedDistanceField(
+			const TriangleMesh3& mesh, size_t resolutionX, double margin);
+
 		//! Returns builder fox ImplicitTriangleMesh3.
 		static Builder GetBuilder();
 
@@ -50,6 +69,8 @@ namespace CubbyFlow
 		VertexCenteredScalarGrid3Ptr m_grid;
 		CustomImplicitSurface3Ptr m_customImplicitSurface;
 
+		void BuildCustomImplicitSurface();
+
 		Vector3D ClosestPointLocal(const Vector3D& otherPoint) const override;
 
 		double ClosestDistanceLocal(const Vector3D& otherPoint) const override;
@@ -83,6 +104,10 @@ namespace CubbyFlow
 		//! Returns builder with margin around the mesh.
 		Builder& WithMargin(double margin);
 
+		//! Returns builder with the signed-distance field baked in advance,
+		//! which skips the baking and ignores the resolution and the margin.
+		Builder& WithSignedDistanceField(const VertexCenteredScalarGrid3Ptr& grid);
+
 		//! Builds ImplicitTriangleMesh3.
 		ImplicitTriangleMesh3 Build() const;
 
@@ -93,6 +118,7 @@ namespace CubbyFlow
 		TriangleMesh3Ptr m_mesh;
 		size_t m_resolutionX = 32;
 		double m_margin = 0.2;
+		VertexCenteredScalarGrid3Ptr m_grid;
 	};
 }
 
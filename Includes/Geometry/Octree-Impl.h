@@ -9,8 +9,11 @@
 #ifndef CUBBYFLOW_OCTREE_IMPL_H
 #define CUBBYFLOW_OCTREE_IMPL_H
 
+#include <Geometry/TraversalStack.h>
+#include <Utils/Logger.h>
+#include <Utils/Parallel.h>
+
 #include <numeric>
-#include <stack>
 
 namespace CubbyFlow
 {
@@ -20,6 +23,24 @@ namespace CubbyFlow
 		return firstChild == std::numeric_limits<size_t>::max();
 	}
 
+	template <typename T>
+	typename Octree<T>::Cell Octree<T>::Cell::Child(size_t childIdx) const
+	{
+		const double half = 0.5 * size;
+
+		return Cell{
+			(childIdx & 1) ? x + half : x,
+			(childIdx & 2) ? y + half : y,
+			(childIdx & 4) ? z + half : z,
+			half };
+	}
+
+	template <typename T>
+	BoundingBox3D Octree<T>::Cell::Bound() const
+	{
+		return BoundingBox3D(Vector3D(x, y, z), Vector3D(x + size, y + size, z + size));
+	}
+
 	template <typename T>
 	Octree<T>::Octree()
 	{
@@ -30,22 +51,135 @@ namespace CubbyFlow
 	void Octree<T>::Build(const std::vector<T>& items, const BoundingBox3D& bound,
 		const BoxIntersectionTestFunc3<T>& testFunc, size_t maxDepth)
 	{
+		if (maxDepth > MAX_TREE_DEPTH)
+		{
+			CUBBYFLOW_WARN << "Max depth " << maxDepth << " of the octree is clamped to " << MAX_TREE_DEPTH;
+		}
+
 		// Reset items
-		m_maxDepth = maxDepth;
+		m_maxDepth = (maxDepth < MAX_TREE_DEPTH) ? maxDepth : MAX_TREE_DEPTH;
 		m_items = items;
-		m_nodes.clear();
+		m_nodes.assign(1, Node());
+		m_itemIndices.clear();
 
 		// Normalize bounding box
 		m_bbox = bound;
 		double maxEdgeLen = std::max({ m_bbox.Width(), m_bbox.Height(), m_bbox.Depth() });
 		m_bbox.upperCorner = m_bbox.lowerCorner + Vector3D(maxEdgeLen, maxEdgeLen, maxEdgeLen);
 
-		// Build
-		m_nodes.resize(1);
-		m_nodes[0].items.resize(m_items.size());
-		std::iota(m_nodes[0].items.begin(), m_nodes[0].items.end(), ZERO_SIZE);
+		// Nodes of the current level and their items. The items of n-th node
+		// are levelItems[levelItemStarts[n]] ... levelItems[levelItemStarts[n + 1] - 1].
+		std::vector<size_t> levelNodes(1, 0);
+		std::vector<Cell> levelCells(1, GetRootCell());
+		std::vector<size_t> levelItems(m_items.size());
+		std::vector<size_t> levelItemStarts = { 0, m_items.size() };
+		std::iota(levelItems.begin(), levelItems.end(), ZERO_SIZE);
+
+		for (size_t depth = 1; !levelNodes.empty(); ++depth)
+		{
+			const size_t numberOfLevelNodes = levelNodes.size();
+			const bool canSubdivide = depth < m_maxDepth;
+
+			// Classify the items of all the nodes in the level. Bit i of the
+			// mask is set if the item overlaps i-th child.
+			std::vector<unsigned char> childMasks(canSubdivide ? levelItems.size() : 0);
+			std::vector<size_t> childItemCounts(canSubdivide ? 8 * numberOfLevelNodes : 0, 0);
+
+			if (canSubdivide)
+			{
+				ParallelFor(ZERO_SIZE, numberOfLevelNodes, [&](size_t n)
+				{
+					BoundingBox3D childBounds[8];
+					for (size_t i = 0; i < 8; ++i)
+					{
+						childBounds[i] = levelCells[n].Child(i).Bound();
+					}
+
+					for (size_t m = levelItemStarts[n]; m < levelItemStarts[n + 1]; ++m)
+					{
+						unsigned char mask = 0;
+
+						for (size_t i = 0; i < 8; ++i)
+						{
+							if (testFunc(m_items[levelItems[m]], childBounds[i]))
+							{
+								mask |= static_cast<unsigned char>(1 << i);
+								++childItemCounts[8 * n + i];
+							}
+						}
+
+						childMasks[m] = mask;
+					}
+				});
+			}
+
+			// Allocate the children of the non-empty nodes, and store the items
+			// of the leaves
+			std::vector<size_t> nextLevelNodes;
+			std::vector<Cell> nextLevelCells;
+			std::vector<size_t> nextLevelItemStarts(1, 0);
+			std::vector<size_t> firstNextLevelNode(numberOfLevelNodes, std::numeric_limits<size_t>::max());
+
+			for (size_t n = 0; n < numberOfLevelNodes; ++n)
+			{
+				const size_t nodeIdx = levelNodes[n];
+				const size_t itemBegin = levelItemStarts[n];
+				const size_t itemEnd = levelItemStarts[n + 1];
+
+				if (canSubdivide && itemBegin < itemEnd)
+				{
+					const size_t firstChild = m_nodes.size();
+					m_nodes[nodeIdx].firstChild = firstChild;
+					m_nodes.resize(firstChild + 8);
+					firstNextLevelNode[n] = nextLevelNodes.size();
 
-		Build(0, 1, m_bbox, testFunc);
+					for (size_t i = 0; i < 8; ++i)
+					{
+						nextLevelNodes.push_back(firstChild + i);
+						nextLevelCells.push_back(levelCells[n].Child(i));
+						nextLevelItemStarts.push_back(nextLevelItemStarts.back() + childItemCounts[8 * n + i]);
+					}
+				}
+				else
+				{
+					m_nodes[nodeIdx].itemBegin = m_itemIndices.size();
+					m_itemIndices.insert(m_itemIndices.end(), levelItems.begin() + itemBegin, levelItems.begin() + itemEnd);
+					m_nodes[nodeIdx].itemEnd = m_itemIndices.size();
+				}
+			}
+
+			// Distribute the items to the children, keeping their order
+			std::vector<size_t> nextLevelItems(nextLevelItemStarts.back());
+			ParallelFor(ZERO_SIZE, numberOfLevelNodes, [&](size_t n)
+			{
+				if (firstNextLevelNode[n] == std::numeric_limits<size_t>::max())
+				{
+					return;
+				}
+
+				size_t cursors[8];
+				for (size_t i = 0; i < 8; ++i)
+				{
+					cursors[i] = nextLevelItemStarts[firstNextLevelNode[n] + i];
+				}
+
+				for (size_t m = levelItemStarts[n]; m < levelItemStarts[n + 1]; ++m)
+				{
+					for (size_t i = 0; i < 8; ++i)
+					{
+						if (childMasks[m] & (1 << i))
+						{
+							nextLevelItems[cursors[i]++] = levelItems[m];
+						}
+					}
+				}
+			});
+
+			levelNodes.swap(nextLevelNodes);
+			levelCells.swap(nextLevelCells);
+			levelItems.swap(nextLevelItems);
+			levelItemStarts.swap(nextLevelItemStarts);
+		}
 	}
 
 	template <typename T>
@@ -53,7 +187,8 @@ namespace CubbyFlow
 	{
 		m_maxDepth = 1;
 		m_items.clear();
-		m_nodes.cloear();
+		m_nodes.clear();
+		m_itemIndices.clear();
 		m_bbox = BoundingBox3D();
 	}
 
@@ -66,19 +201,42 @@ namespace CubbyFlow
 		best.distance = std::numeric_limits<double>::max();
 		best.item = nullptr;
 
-		// Prepare to traverse octree
-		std::stack<std::pair<const Node*, BoundingBox3D>> todo;
+		if (m_nodes.empty())
+		{
+			return best;
+		}
 
-		// Traverse octree nodes
-		const Node* node = m_nodes.data();
-		BoundingBox3D bound = m_bbox;
+		// Prepare to traverse octree. Each level leaves at most seven
+		// siblings on the stack.
+		struct NodeCellDist
+		{
+			size_t node;
+			Cell cell;
+			double distMinSqr;
+		};
+
+		TraversalStack<NodeCellDist, 7 * INLINE_STACK_DEPTH + 1> todo(7 * m_maxDepth + 1);
+
+		todo.Push(NodeCellDist{ 0, GetRootCell(), 0.0 });
 
-		while (node != nullptr)
+		// Traverse octree nodes
+		while (!todo.IsEmpty())
 		{
-			if (node->IsLeaf())
+			const NodeCellDist current = todo.Pop();
+			const double bestDistSqr = best.distance * best.distance;
+
+			if (current.distMinSqr >= bestDistSqr)
 			{
-				for (size_t itemIdx : node->items)
+				continue;
+			}
+
+			const Node& node = m_nodes[current.node];
+
+			if (node.IsLeaf())
+			{
+				for (size_t i = node.itemBegin; i < node.itemEnd; ++i)
 				{
+					const size_t itemIdx = m_itemIndices[i];
 					double d = distanceFunc(m_items[itemIdx], pt);
 					if (d < best.distance)
 					{
@@ -86,59 +244,32 @@ namespace CubbyFlow
 						best.item = &m_items[itemIdx];
 					}
 				}
-
-				// Grab next node to process from todo stack
-				if (todo.empty())
-				{
-					break;
-				}
-				
-				node = todo.top().first;
-				bound = todo.top().second;
-				todo.pop();
 			}
 			else
 			{
-				using NodeDistBox = std::tuple<const Node*, double, BoundingBox3D>;
+				NodeCellDist children[8];
 
-				const double bestDistSqr = best.distance * best.distance;
-				std::array<NodeDistBox, 8> childDistSqrPairs;
-				const auto midPoint = bound.MidPoint();
-				
-				for (int i = 0; i < 8; ++i)
+				for (size_t i = 0; i < 8; ++i)
 				{
-					const Node* child = &m_nodes[node->firstChild + i];
-					const auto childBound = BoundingBox3D(bound.Corner(i), midPoint);
-					Vector3D cp = childBound.Clamp(pt);
-					double distMinSqr = cp.DistanceSquaredTo(pt);
+					const Cell childCell = current.cell.Child(i);
+					Vector3D cp = childCell.Bound().Clamp(pt);
 
-					childDistSqrPairs[i] = std::make_tuple(child, distMinSqr, childBound);
+					children[i] = NodeCellDist{ node.firstChild + i, childCell, cp.DistanceSquaredTo(pt) };
 				}
 
-				std::sort(childDistSqrPairs.begin(), childDistSqrPairs.end(),
-					[](const NodeDistBox& a, const NodeDistBox& b)
+				// Push the farthest first so that the nearest is visited next
+				std::sort(children, children + 8, [](const NodeCellDist& a, const NodeCellDist& b)
 				{
-					return std::get<1>(a) > std::get<1>(b);
+					return a.distMinSqr > b.distMinSqr;
 				});
 
-				for (int i = 0; i < 8; ++i)
+				for (size_t i = 0; i < 8; ++i)
 				{
-					const auto& childPair = childDistSqrPairs[i];
-					
-					if (std::get<1>(childPair) < bestDistSqr)
+					if (children[i].distMinSqr < bestDistSqr)
 					{
-						todo.emplace(std::get<0>(childPair), std::get<2>(childPair));
+						todo.Push(children[i]);
 					}
 				}
-
-				if (todo.empty())
-				{
-					break;
-				}
-
-				node = todo.top().first;
-				bound = todo.top().second;
-				todo.pop();
 			}
 		}
 
@@ -149,14 +280,36 @@ namespace CubbyFlow
 	bool Octree<T>::IsIntersects(const BoundingBox3D& box,
 		const BoxIntersectionTestFunc3<T>& testFunc) const
 	{
-		return IsIntersects(box, testFunc, 0, m_bbox);
+		bool result = false;
+
+		ForEachOverlappingNode([&](const BoundingBox3D& bound)
+		{
+			return box.Overlaps(bound);
+		}, [&](size_t itemIdx)
+		{
+			result = testFunc(m_items[itemIdx], box);
+			return !result;
+		});
+
+		return result;
 	}
 
 	template <typename T>
 	bool Octree<T>::IsIntersects(const Ray3D& ray,
 		const RayIntersectionTestFunc3<T>& testFunc) const
 	{
-		return IsIntersects(ray, testFunc, 0, m_bbox);
+		bool result = false;
+
+		ForEachOverlappingNode([&](const BoundingBox3D& bound)
+		{
+			return bound.Intersects(ray);
+		}, [&](size_t itemIdx)
+		{
+			result = testFunc(m_items[itemIdx], ray);
+			return !result;
+		});
+
+		return result;
 	}
 
 	template <typename T>
@@ -164,7 +317,18 @@ namespace CubbyFlow
 		const BoundingBox3D& box, const BoxIntersectionTestFunc3<T>& testFunc,
 		const IntersectionVisitorFunc3<T>& visitorFunc) const
 	{
-		ForEachIntersectingItem(box, testFunc, visitorFunc, 0, m_bbox);
+		ForEachOverlappingNode([&](const BoundingBox3D& bound)
+		{
+			return box.Overlaps(bound);
+		}, [&](size_t itemIdx)
+		{
+			if (testFunc(m_items[itemIdx], box))
+			{
+				visitorFunc(m_items[itemIdx]);
+			}
+
+			return true;
+		});
 	}
 
 	template <typename T>
@@ -172,7 +336,18 @@ namespace CubbyFlow
 		const Ray3D& ray, const RayIntersectionTestFunc3<T>& testFunc,
 		const IntersectionVisitorFunc3<T>& visitorFunc) const
 	{
-		ForEachIntersectingItem(ray, testFunc, visitorFunc, 0, m_bbox);
+		ForEachOverlappingNode([&](const BoundingBox3D& bound)
+		{
+			return bound.Intersects(ray);
+		}, [&](size_t itemIdx)
+		{
+			if (testFunc(m_items[itemIdx], ray))
+			{
+				visitorFunc(m_items[itemIdx]);
+			}
+
+			return true;
+		});
 	}
 
 	template <typename T>
@@ -183,7 +358,94 @@ namespace CubbyFlow
 		best.distance = std::numeric_limits<double>::max();
 		best.item = nullptr;
 
-		return GetClosestIntersection(ray, testFunc, 0, m_bbox, best);
+		if (m_nodes.empty())
+		{
+			return best;
+		}
+
+		// Distance along the ray where it enters the cell, or -1 if it misses.
+		const auto entryDistance = [&ray](const Cell& cell)
+		{
+			const BoundingBoxRayIntersection3D intersection = cell.Bound().ClosestIntersection(ray);
+
+			if (!intersection.isIntersecting)
+			{
+				return -1.0;
+			}
+
+			return (intersection.far == std::numeric_limits<double>::max()) ? 0.0 : intersection.near;
+		};
+
+		struct NodeCellDist
+		{
+			size_t node;
+			Cell cell;
+			double entry;
+		};
+
+		TraversalStack<NodeCellDist, 7 * INLINE_STACK_DEPTH + 1> todo(7 * m_maxDepth + 1);
+
+		const Cell root{ m_bbox.lowerCorner.x, m_bbox.lowerCorner.y, m_bbox.lowerCorner.z, m_bbox.Width() };
+		const double rootEntry = entryDistance(root);
+		if (rootEntry >= 0.0)
+		{
+			todo.Push(NodeCellDist{ 0, root, rootEntry });
+		}
+
+		// Visit the cells front to back and skip the ones behind the best hit
+		while (!todo.IsEmpty())
+		{
+			const NodeCellDist current = todo.Pop();
+
+			if (current.entry > best.distance)
+			{
+				continue;
+			}
+
+			const Node& node = m_nodes[current.node];
+
+			if (node.IsLeaf())
+			{
+				for (size_t i = node.itemBegin; i < node.itemEnd; ++i)
+				{
+					const size_t itemIdx = m_itemIndices[i];
+					double dist = testFunc(m_items[itemIdx], ray);
+					if (dist < best.distance)
+					{
+						best.distance = dist;
+						best.item = &m_items[itemIdx];
+					}
+				}
+			}
+			else
+			{
+				NodeCellDist children[8];
+				size_t numberOfChildren = 0;
+
+				for (size_t i = 0; i < 8; ++i)
+				{
+					const Cell childCell = current.cell.Child(i);
+					const double entry = entryDistance(childCell);
+
+					if (entry >= 0.0 && entry <= best.distance)
+					{
+						children[numberOfChildren++] = NodeCellDist{ node.firstChild + i, childCell, entry };
+					}
+				}
+
+				std::sort(children, children + numberOfChildren, [](const NodeCellDist& a, const NodeCellDist& b)
+				{
+					return a.entry > b.entry;
+				});
+
+				for (size_t i = 0; i < numberOfChildren; ++i)
+				{
+					todo.Push(children[i]);
+				}
+			}
+		}
+
+		return best;
 	}
 
 	template <typename T>
@@ -229,9 +491,11 @@ namespace CubbyFlow
 	}
 
 	template <typename T>
-	const std::vector<size_t>& Octree<T>::GetItemsAtNode(size_t nodeIdx) const
+	ConstArrayAccessor1<size_t> Octree<T>::GetItemsAtNode(size_t nodeIdx) const
 	{
-		return m_nodes[nodeIdx].items;
+		const Node& node = m_nodes[nodeIdx];
+
+		return ConstArrayAccessor1<size_t>(node.itemEnd - node.itemBegin, m_itemIndices.data() + node.itemBegin);
 	}
 
 	template <typename T>
@@ -253,226 +517,59 @@ namespace CubbyFlow
 	}
 
 	template <typename T>
-	void Octree<T>::Build(size_t nodeIdx, size_t depth, const BoundingBox3D& bound,
-		const BoxIntersectionTestFunc3<T>& testFunc)
-	{
-		if (depth < m_maxDepth && !m_nodes[nodeIdx].items.empty())
-		{
-			size_t firstChild = m_nodes[nodeIdx].firstChild = m_nodes.size();
-			m_nodes.resize(m_nodes[nodeIdx].firstChild + 8);
-
-			BoundingBox3D bboxPerNode[8];
-
-			for (int i = 0; i < 8; ++i)
-			{
-				bboxPerNode[i] = BoundingBox3D(bound.Corner(i), bound.MidPoint());
-			}
-
-			auto& currentItems = m_nodes[nodeIdx].items;
-			for (size_t i = 0; i < currentItems.size(); ++i)
-			{
-				size_t currentItem = currentItems[i];
-				for (int j = 0; j < 8; ++j)
-				{
-					if (testFunc(m_items[currentItem], bboxPerNode[j]))
-					{
-						m_nodes[firstChild + j].items.push_back(currentItem);
-					}
-				}
-			}
-
-			// Remove non-leaf data
-			currentItems.clear();
-
-			// Refine
-			for (int i = 0; i < 8; ++i)
-			{
-				Build(firstChild + i, depth + 1, bboxPerNode[i], testFunc);
-			}
-		}
-	}
-
-	template <typename T>
-	bool Octree<T>::IsIntersects(const BoundingBox3D& box,
-		const BoxIntersectionTestFunc3<T>& testFunc,
-		size_t nodeIdx, const BoundingBox3D& bound) const
+	typename Octree<T>::Cell Octree<T>::GetRootCell() const
 	{
-		if (!box.Overlaps(bound))
-		{
-			return false;
-		}
-
-		const Node& node = m_nodes[nodeIdx];
-
-		if (node.items.size() > 0)
-		{
-			for (size_t itemIdx : node.items)
-			{
-				if (testFunc(m_items[itemIdx], box))
-				{
-					return true;
-				}
-			}
-		}
-
-		if (node.firstChild != std::numeric_limits<size_t>::max())
-		{
-			for (int i = 0; i < 8; ++i)
-			{
-				if (IsIntersects(box, testFunc, node.firstChild + i, BoundingBox3D(bound.Corner(i), bound.MidPoint())))
-				{
-					return true;
-				}
-			}
-		}
-
-		return false;
+		return Cell{ m_bbox.lowerCorner.x, m_bbox.lowerCorner.y, m_bbox.lowerCorner.z, m_bbox.Width() };
 	}
 
 	template <typename T>
-	bool Octree<T>::IsIntersects(const Ray3D& ray,
-		const RayIntersectionTestFunc3<T>& testFunc,
-		size_t nodeIdx, const BoundingBox3D& bound) const
+	template <typename BoundTestFunc, typename ItemVisitorFunc>
+	void Octree<T>::ForEachOverlappingNode(
+		const BoundTestFunc& boundTestFunc, const ItemVisitorFunc& itemVisitorFunc) const
 	{
-		if (!bound.Intersects(ray))
-		{
-			return false;
-		}
-
-		const Node& node = m_nodes[nodeIdx];
-
-		if (node.items.size() > 0)
+		if (m_nodes.empty())
 		{
-			for (size_t itemIdx : node.items)
-			{
-				if (testFunc(m_items[itemIdx], ray))
-				{
-					return true;
-				}
-			}
+			return;
 		}
 
-		if (node.firstChild != std::numeric_limits<size_t>::max())
+		struct NodeCell
 		{
-			for (int i = 0; i < 8; ++i)
-			{
-				if (IsIntersects(ray, testFunc, node.firstChild + i, BoundingBox3D(bound.Corner(i), bound.MidPoint())))
-				{
-					return true;
-				}
-			}
-		}
+			size_t node;
+			Cell cell;
+		};
 
-		return false;
-	}
+		TraversalStack<NodeCell, 7 * INLINE_STACK_DEPTH + 1> todo(7 * m_maxDepth + 1);
 
-	template <typename T>
-	void Octree<T>::ForEachIntersectingItem(
-		const BoundingBox3D& box, const BoxIntersectionTestFunc3<T>& testFunc,
-		const IntersectionVisitorFunc3<T>& visitorFunc, size_t nodeIdx,
-		const BoundingBox3D& bound) const
-	{
-		if (!box.Overlaps(bound))
-		{
-			return;
-		}
-
-		const Node& node = m_nodes[nodeIdx];
+		todo.Push(NodeCell{ 0, GetRootCell() });
 
-		if (node.items.size() > 0)
+		while (!todo.IsEmpty())
 		{
-			for (size_t itemIdx : node.items)
-			{
-				if (testFunc(m_items[itemIdx], box))
-				{
-					visitorFunc(m_items[itemIdx]);
-				}
-			}
-		}
+			const NodeCell current = todo.Pop();
 
-		if (node.firstChild != std::numeric_limits<size_t>::max())
-		{
-			for (int i = 0; i < 8; ++i)
+			if (!boundTestFunc(current.cell.Bound()))
 			{
-				ForEachIntersectingItem(
-					box, testFunc, visitorFunc, node.firstChild + i,
-					BoundingBox3D(bound.Corner(i), bound.MidPoint()));
+				continue;
 			}
-		}
-	}
-
-	template <typename T>
-	void Octree<T>::ForEachIntersectingItem(
-		const Ray3D& ray, const RayIntersectionTestFunc3<T>& testFunc,
-		const IntersectionVisitorFunc3<T>& visitorFunc, size_t nodeIdx,
-		const BoundingBox3D& bound) const
-	{
-		if (!bound.Intersects(ray))
-		{
-			return;
-		}
 
-		const Node& node = m_nodes[nodeIdx];
+			const Node& node = m_nodes[current.node];
 
-		if (node.items.size() > 0)
-		{
-			for (size_t itemIdx : node.items)
+			for (size_t i = node.itemBegin; i < node.itemEnd; ++i)
 			{
-				if (testFunc(m_items[itemIdx], ray))
+				if (!itemVisitorFunc(m_itemIndices[i]))
 				{
-					visitorFunc(m_items[itemIdx]);
+					return;
 				}
 			}
-		}
 
-		if (node.firstChild != std::numeric_limits<size_t>::max())
-		{
-			for (int i = 0; i < 8; ++i)
+			if (!node.IsLeaf())
 			{
-				ForEachIntersectingItem(
-					ray, testFunc, visitorFunc, node.firstChild + i,
-					BoundingBox3D(bound.Corner(i), bound.MidPoint()));
-			}
-		}
-	}
-
-	template <typename T>
-	ClosestIntersectionQueryResult3<T> Octree<T>::GetClosestIntersection(
-		const Ray3D& ray, const GetRayIntersectionFunc3<T>& testFunc,
-		size_t nodeIdx, const BoundingBox3D& bound,
-		ClosestIntersectionQueryResult3<T> best) const
-	{
-		if (!bound.Intersects(ray))
-		{
-			return best;
-		}
-
-		const Node& node = m_nodes[nodeIdx];
-
-		if (node.items.size() > 0)
-		{
-			for (size_t itemIdx : node.items)
-			{
-				double dist = testFunc(m_items[itemIdx], ray);
-				if (dist < best.distance)
+				// Push in reverse order to visit the children in octant order
+				for (size_t i = 8; i > 0; --i)
 				{
-					best.distance = dist;
-					best.item = &m_items[itemIdx];
+					todo.Push(NodeCell{ node.firstChild + i - 1, current.cell.Child(i - 1) });
 				}
 			}
 		}
-
-		if (node.firstChild != std::numeric_limits<size_t>::max())
-		{
-			for (int i = 0; i < 8; ++i)
-			{
-				best = GetClosestIntersection(
-					ray, testFunc, node.firstChild + i,
-					BoundingBox3D(bound.Corner(i), bound.MidPoint()), best);
-			}
-		}
-
-		return best;
 	}
 }
 
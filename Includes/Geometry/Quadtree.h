@@ -9,6 +9,7 @@
 #ifndef CUBBYFLOW_QUADTREE_H
 #define CUBBYFLOW_QUADTREE_H
 
+#include <Array/ArrayAccessor1.h>
 #include <QueryEngine/IntersectionQueryEngine2.h>
 #include <QueryEngine/NearestNeighborQueryEngine2.h>
 
@@ -21,6 +22,14 @@ namespace CubbyFlow
 	//! data. The quadtree supports closest neighbor search, overlapping test, and
 	//! ray intersection test.
 	//!
+	//! The tree is stored linearly. The nodes are laid out level by level, with
+	//! the four children of a node stored contiguously, so the nodes of each
+	//! level are in Morton order. The leaves refer to contiguous ranges of a
+	//! single item index array instead of owning their own lists. The tree is
+	//! built one level at a time, classifying the items of all the nodes of a
+	//! level in parallel. Queries traverse the tree with a stack sized by the
+	//! max depth, which is kept in place (not allocated) up to depth 8.
+	//!
 	//! \tparam     T     Value type.
 	//!
 	template <typename T>
@@ -35,7 +44,9 @@ namespace CubbyFlow
 		Quadtree();
 
 		//! Builds an quadtree with given list of items, bounding box of the items,
-		//! overlapping test function, and max depth of the tree.
+		//! overlapping test function, and max depth of the tree. The max depth
+		//! is clamped to 8 * sizeof(size_t), i.e., 64 on 64-bit platforms,
+		//! with a warning.
 		void Build(const std::vector<T>& items, const BoundingBox2D& bound,
 			const BoxIntersectionTestFunc2<T>& testFunc, size_t maxDepth);
 
@@ -92,8 +103,8 @@ namespace CubbyFlow
 		//! Returns the number of quadtree nodes.
 		size_t GetNumberOfNodes() const;
 
-		//! Returns the list of the items for given noide index.
-		const std::vector<size_t>& GetItemsAtNode(size_t nodeIdx) const;
+		//! Returns the list of the items for given node index.
+		ConstArrayAccessor1<size_t> GetItemsAtNode(size_t nodeIdx) const;
 
 		//!
 		//! \brief      Returns a child's index for given node.
@@ -112,51 +123,49 @@ namespace CubbyFlow
 		//! Returns the bounding box of this quadtree.
 		const BoundingBox2D& GetBoundingBox() const;
 
-		//! Returns the maximum depth of the tree.
+		//! Returns the maximum depth of the tree, after clamping.
 		size_t GetMaxDepth() const;
 
 	private:
+		//! Max depth of the tree.
+		static constexpr size_t MAX_TREE_DEPTH = 8 * sizeof(size_t);
+
+		//! Max depth of the trees whose traversal stack is kept in place.
+		static constexpr size_t INLINE_STACK_DEPTH = 8;
+
 		struct Node
 		{
 			size_t firstChild = std::numeric_limits<size_t>::max();
-			std::vector<size_t> items;
+			size_t itemBegin = 0;
+			size_t itemEnd = 0;
 
 			bool IsLeaf() const;
 		};
 
+		// Square cell of a node, given by its lower corner and edge length.
+		// Trivially constructible, so the traversal stacks cost nothing to set up.
+		struct Cell
+		{
+			double x, y;
+			double size;
+
+			Cell Child(size_t childIdx) const;
+
+			BoundingBox2D Bound() const;
+		};
+
 		size_t m_maxDepth = 1;
 		BoundingBox2D m_bbox;
 		std::vector<T> m_items;
 		std::vector<Node> m_nodes;
+		std::vector<size_t> m_itemIndices;
 
-		void Build(size_t nodeIdx, size_t currentDepth,
-			const BoundingBox2D& currentBound,
-			const BoxIntersectionTestFunc2<T>& overlapsFunc);
+		Cell GetRootCell() const;
 
-		bool IsIntersects(const BoundingBox2D& box,
-			const BoxIntersectionTestFunc2<T>& testFunc, size_t nodeIdx,
-			const BoundingBox2D& currentBound) const;
-
-		bool IsIntersects(const Ray2D& ray,
-			const RayIntersectionTestFunc2<T>& testFunc, size_t nodeIdx,
-			const BoundingBox2D& currentBound) const;
-
-		void ForEachIntersectingItem(const BoundingBox2D& box,
-			const BoxIntersectionTestFunc2<T>& testFunc,
-			const IntersectionVisitorFunc2<T>& visitorFunc,
-			size_t nodeIdx,
-			const BoundingBox2D& currentBound) const;
-
-		void ForEachIntersectingItem(const Ray2D& ray,
-			const RayIntersectionTestFunc2<T>& testFunc,
-			const IntersectionVisitorFunc2<T>& visitorFunc,
-			size_t nodeIdx,
-			const BoundingBox2D& currentBound) const;
-
-		ClosestIntersectionQueryResult2<T> GetClosestIntersection(
-			const Ray2D& ray, const GetRayIntersectionFunc2<T>& testFunc,
-			size_t nodeIdx, const BoundingBox2D& currentBound,
-			ClosestIntersectionQueryResult2<T> best) const;
+		//! Visits the items of the nodes whose bound passes \p boundTestFunc in
+		//! depth-first, quadrant order until \p itemVisitorFunc returns false.
+		template <typename BoundTestFunc, typename ItemVisitorFunc>
+		void ForEachOverlappingNode(const BoundTestFunc& boundTestFunc, const ItemVisitorFunc& itemVisitorFunc) const;
 	};
 }
 
@@ -0,0 +1,51 @@
+/*************************************************************************
+> File Name: TraversalStack-Impl.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Stack of the nodes to visit during a tree traversal.
+> Created Time: 2017/10/31
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_TRAVERSAL_STACK_IMPL_H
+#define CUBBYFLOW_TRAVERSAL_STACK_IMPL_H
+
+#include <algorithm>
+#include <cassert>
+
+namespace CubbyFlow
+{
+	template <typename T, size_t InlineCapacity>
+	TraversalStack<T, InlineCapacity>::TraversalStack(size_t capacity) :
+		m_data(m_inline)
+	{
+		if (capacity > InlineCapacity)
+		{
+			m_heap.resize(capacity);
+			m_data = m_heap.data();
+		}
+	}
+
+	template <typename T, size_t InlineCapacity>
+	void TraversalStack<T, InlineCapacity>::Push(const T& value)
+	{
+		assert(m_size < std::max(InlineCapacity, m_heap.size()));
+
+		m_data[m_size++] = value;
+	}
+
+	template <typename T, size_t InlineCapacity>
+	T TraversalStack<T, InlineCapacity>::Pop()
+	{
+		assert(m_size > 0);
+
+		return m_data[--m_size];
+	}
+
+	template <typename T, size_t InlineCapacity>
+	bool TraversalStack<T, InlineCapacity>::IsEmpty() const
+	{
+		return m_size == 0;
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,58 @@
+/*************************************************************************
+> File Name: TraversalStack.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Stack of the nodes to visit during a tree traversal.
+> Created Time: 2017/10/31
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_TRAVERSAL_STACK_H
+#define CUBBYFLOW_TRAVERSAL_STACK_H
+
+#include <vector>
+
+namespace CubbyFlow
+{
+	//!
+	//! \brief Stack of the nodes to visit during a tree traversal.
+	//!
+	//! The stack holds up to \p InlineCapacity elements in place, so the
+	//! traversals of shallow trees do not allocate. Larger capacities, needed
+	//! by deep trees only, are allocated on the heap.
+	//!
+	//! \tparam T              Element type.
+	//! \tparam InlineCapacity Number of elements stored in place.
+	//!
+	template <typename T, size_t InlineCapacity>
+	class TraversalStack final
+	{
+	public:
+		//! Constructs an empty stack which can hold \p capacity elements.
+		explicit TraversalStack(size_t capacity);
+
+		//! Deleted copy constructor.
+		TraversalStack(const TraversalStack&) = delete;
+
+		//! Deleted copy assignment operator.
+		TraversalStack& operator=(const TraversalStack&) = delete;
+
+		//! Pushes \p value on top of the stack.
+		void Push(const T& value);
+
+		//! Removes and returns the top element.
+		T Pop();
+
+		//! Returns true if the stack is empty.
+		bool IsEmpty() const;
+
+	private:
+		T m_inline[InlineCapacity];
+		std::vector<T> m_heap;
+		T* m_data;
+		size_t m_size = 0;
+	};
+}
+
+#include <Geometry/TraversalStack-Impl.h>
+
+#endif
\ No newline at end of file
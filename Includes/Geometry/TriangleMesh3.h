@@ -177,6 +177,17 @@ namespace CubbyFlow
 		//! Writes the mesh in obj format to the output stream.
 		void WriteObj(std::ostream* strm) const;
 
+		//!
+		//! \brief Writes the mesh in binary little-endian ply format to the
+		//! output stream.
+		//!
+		//! The positions are written as floats. The vertex normals are written
+		//! as well if each triangle uses the same indices for its points and
+		//! normals, which is the case for the meshes from MarchingCubes. The
+		//! stream should be opened in binary mode.
+		//!
+		void WritePly(std::ostream* strm) const;
+
 		//! Reads the mesh in obj format from the input stream.
 		bool ReadObj(std::istream* strm);
 
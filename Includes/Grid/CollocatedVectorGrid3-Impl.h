@@ -0,0 +1,27 @@
+/*************************************************************************
+> File Name: CollocatedVectorGrid3-Impl.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Abstract base class for 3-D collocated vector grid structure.
+> Created Time: 2017/10/31
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_COLLOCATED_VECTOR_GRID3_IMPL_H
+#define CUBBYFLOW_COLLOCATED_VECTOR_GRID3_IMPL_H
+
+namespace CubbyFlow
+{
+	template <typename Callback>
+	void CollocatedVectorGrid3::ForEachDataPointIndex(Callback func) const
+	{
+		m_data.ForEachIndex(func);
+	}
+
+	template <typename Callback>
+	void CollocatedVectorGrid3::ParallelForEachDataPointIndex(Callback func) const
+	{
+		m_data.ParallelForEachIndex(func);
+	}
+}
+
+#endif
\ No newline at end of file
@@ -64,7 +64,8 @@ namespace CubbyFlow
 		//! point in serial manner. The input parameters are i and j indices of a
 		//! data point. The order of execution is i-first, j-last.
 		//!
-		void ForEachDataPointIndex(const std::function<void(size_t, size_t, size_t)>& func) const;
+		template <typename Callback>
+		void ForEachDataPointIndex(Callback func) const;
 
 		//!
 		//! \brief Invokes the given function \p func for each data point in parallel.
@@ -74,7 +75,8 @@ namespace CubbyFlow
 		//! data point. The order of execution can be arbitrary since it's
 		//! multi-threaded.
 		//!
-		void ParallelForEachDataPointIndex(const std::function<void(size_t, size_t, size_t)>& func) const;
+		template <typename Callback>
+		void ParallelForEachDataPointIndex(Callback func) const;
 
 		// VectorField3 implementations
 		//! Returns sampled value at given position \p x.
@@ -125,4 +127,6 @@ namespace CubbyFlow
 	using CollocatedVectorGrid3Ptr = std::shared_ptr<CollocatedVectorGrid3>;
 }
 
+#include <Grid/CollocatedVectorGrid3-Impl.h>
+
 #endif
\ No newline at end of file
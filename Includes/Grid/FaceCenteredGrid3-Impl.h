@@ -0,0 +1,51 @@
+/*************************************************************************
+> File Name: FaceCenteredGrid3-Impl.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: 3-D face-centered (a.k.a MAC or staggered) grid.
+> Created Time: 2017/10/31
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_FACE_CENTERED_GRID3_IMPL_H
+#define CUBBYFLOW_FACE_CENTERED_GRID3_IMPL_H
+
+namespace CubbyFlow
+{
+	template <typename Callback>
+	void FaceCenteredGrid3::ForEachUIndex(Callback func) const
+	{
+		m_dataU.ForEachIndex(func);
+	}
+
+	template <typename Callback>
+	void FaceCenteredGrid3::ParallelForEachUIndex(Callback func) const
+	{
+		m_dataU.ParallelForEachIndex(func);
+	}
+
+	template <typename Callback>
+	void FaceCenteredGrid3::ForEachVIndex(Callback func) const
+	{
+		m_dataV.ForEachIndex(func);
+	}
+
+	template <typename Callback>
+	void FaceCenteredGrid3::ParallelForEachVIndex(Callback func) const
+	{
+		m_dataV.ParallelForEachIndex(func);
+	}
+
+	template <typename Callback>
+	void FaceCenteredGrid3::ForEachWIndex(Callback func) const
+	{
+		m_dataW.ForEachIndex(func);
+	}
+
+	template <typename Callback>
+	void FaceCenteredGrid3::ParallelForEachWIndex(Callback func) const
+	{
+		m_dataW.ParallelForEachIndex(func);
+	}
+}
+
+#endif
\ No newline at end of file
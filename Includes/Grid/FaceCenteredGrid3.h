@@ -172,7 +172,8 @@ namespace CubbyFlow
 		//! point in serial manner. The input parameters are i and j indices of a
 		//! u-data point. The order of execution is i-first, j-last.
 		//!
-		void ForEachUIndex(const std::function<void(size_t, size_t, size_t)>& func) const;
+		template <typename Callback>
+		void ForEachUIndex(Callback func) const;
 
 		//!
 		//! \brief Invokes the given function \p func for each u-data point in parallel.
@@ -182,7 +183,8 @@ namespace CubbyFlow
 		//! u-data point. The order of execution can be arbitrary since it's
 		//! multi-threaded.
 		//!
-		void ParallelForEachUIndex(const std::function<void(size_t, size_t, size_t)>& func) const;
+		template <typename Callback>
+		void ParallelForEachUIndex(Callback func) const;
 
 		//!
 		//! \brief Invokes the given function \p func for each v-data point.
@@ -191,7 +193,8 @@ namespace CubbyFlow
 		//! point in serial manner. The input parameters are i and j indices of a
 		//! v-data point. The order of execution is i-first, j-last.
 		//!
-		void ForEachVIndex(const std::function<void(size_t, size_t, size_t)>& func) const;
+		template <typename Callback>
+		void ForEachVIndex(Callback func) const;
 
 		//!
 		//! \brief Invokes the given function \p func for each v-data point in parallel.
@@ -201,7 +204,8 @@ namespace CubbyFlow
 		//! v-data point. The order of execution can be arbitrary since it's
 		//! multi-threaded.
 		//!
-		void ParallelForEachVIndex(const std::function<void(size_t, size_t, size_t)>& func) const;
+		template <typename Callback>
+		void ParallelForEachVIndex(Callback func) const;
 
 		//!
 		//! \brief Invokes the given function \p func for each w-data point.
@@ -210,7 +214,8 @@ namespace CubbyFlow
 		//! point in serial manner. The input parameters are i and j indices of a
 		//! w-data point. The order of execution is i-first, j-last.
 		//!
-		void ForEachWIndex(const std::function<void(size_t, size_t, size_t)>& func) const;
+		template <typename Callback>
+		void ForEachWIndex(Callback func) const;
 
 		//!
 		//! \brief Invokes the given function \p func for each w-data point in parallel.
@@ -220,7 +225,8 @@ namespace CubbyFlow
 		//! w-data point. The order of execution can be arbitrary since it's
 		//! multi-threaded.
 		//!
-		void ParallelForEachWIndex(const std::function<void(size_t, size_t, size_t)>& func) const;
+		template <typename Callback>
+		void ParallelForEachWIndex(Callback func) const;
 
 		// VectorField3 implementations
 		//! Returns sampled value at given position \p x.
@@ -330,4 +336,6 @@ namespace CubbyFlow
 	};
 }
 
+#include <Grid/FaceCenteredGrid3-Impl.h>
+
 #endif
\ No newline at end of file
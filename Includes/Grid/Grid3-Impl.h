@@ -0,0 +1,45 @@
+/*************************************************************************
+> File Name: Grid3-Impl.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Abstract base class for 3-D cartesian grid structure.
+> Created Time: 2017/10/31
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_GRID3_IMPL_H
+#define CUBBYFLOW_GRID3_IMPL_H
+
+#include <Utils/Constants.h>
+#include <Utils/Parallel.h>
+#include <Utils/Serial.h>
+
+namespace CubbyFlow
+{
+	template <typename Callback>
+	void Grid3::ForEachCellIndex(Callback func) const
+	{
+		SerialFor(
+			ZERO_SIZE, m_resolution.x,
+			ZERO_SIZE, m_resolution.y,
+			ZERO_SIZE, m_resolution.z,
+			[&func](size_t i, size_t j, size_t k)
+		{
+			func(i, j, k);
+		});
+	}
+
+	template <typename Callback>
+	void Grid3::ParallelForEachCellIndex(Callback func) const
+	{
+		ParallelFor(
+			ZERO_SIZE, m_resolution.x,
+			ZERO_SIZE, m_resolution.y,
+			ZERO_SIZE, m_resolution.z,
+			[&func](size_t i, size_t j, size_t k)
+		{
+			func(i, j, k);
+		});
+	}
+}
+
+#endif
\ No newline at end of file
@@ -61,7 +61,8 @@ namespace CubbyFlow
 		//! cell in serial manner. The input parameters are i and j indices of a
 		//! grid cell. The order of execution is i-first, j-next, k-last.
 		//!
-		void ForEachCellIndex(const std::function<void(size_t, size_t, size_t)>& func) const;
+		template <typename Callback>
+		void ForEachCellIndex(Callback func) const;
 
 		//!
 		//! \brief Invokes the given function \p func for each grid cell in parallel.
@@ -71,7 +72,8 @@ namespace CubbyFlow
 		//! grid cell. The order of execution can be arbitrary since it's
 		//! multi-threaded.
 		//!
-		void ParallelForEachCellIndex(const std::function<void(size_t, size_t, size_t)>& func) const;
+		template <typename Callback>
+		void ParallelForEachCellIndex(Callback func) const;
 
 		//! Serializes the grid instance to the output buffer.
 		virtual void Serialize(std::vector<uint8_t>* buffer) const = 0;
@@ -116,4 +118,6 @@ namespace CubbyFlow
 
 }
 
+#include <Grid/Grid3-Impl.h>
+
 #endif
\ No newline at end of file
@@ -11,6 +11,7 @@
 
 #include <Grid/FaceCenteredGrid3.h>
 #include <Grid/ScalarGrid3.h>
+#include <Utils/Checkpoint.h>
 #include <Utils/Serialization.h>
 
 namespace CubbyFlow
@@ -207,6 +208,29 @@ namespace CubbyFlow
 		//! Serialize the data from the given buffer.
 		void Deserialize(const std::vector<uint8_t>& buffer) override;
 
+		//!
+		//! \brief      Writes the grids to the checkpoint.
+		//!
+		//! The grid data is streamed directly from the grid storage to the file
+		//! without any intermediate copy.
+		//!
+		//! \param[in]  writer  The checkpoint writer.
+		//! \param[in]  prefix  The prefix of the chunk names.
+		//!
+		void SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const;
+
+		//!
+		//! \brief      Restores the grids from the checkpoint.
+		//!
+		//! Existing grids with the same type are reused so that the pointers held
+		//! by emitters or solvers stay valid. Other grids are created with
+		//! Factory.
+		//!
+		//! \param[in]  reader  The checkpoint reader.
+		//! \param[in]  prefix  The prefix of the chunk names.
+		//!
+		void LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix);
+
 	private:
 		Size3 m_resolution;
 		Vector3D m_gridSpacing;
@@ -0,0 +1,27 @@
+/*************************************************************************
+> File Name: ScalarGrid3-Impl.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Abstract base class for 3-D scalar grid structure.
+> Created Time: 2017/10/31
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_SCALAR_GRID3_IMPL_H
+#define CUBBYFLOW_SCALAR_GRID3_IMPL_H
+
+namespace CubbyFlow
+{
+	template <typename Callback>
+	void ScalarGrid3::ForEachDataPointIndex(Callback func) const
+	{
+		m_data.ForEachIndex(func);
+	}
+
+	template <typename Callback>
+	void ScalarGrid3::ParallelForEachDataPointIndex(Callback func) const
+	{
+		m_data.ParallelForEachIndex(func);
+	}
+}
+
+#endif
\ No newline at end of file
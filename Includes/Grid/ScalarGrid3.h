@@ -112,7 +112,8 @@ namespace CubbyFlow
 		//! point in serial manner. The input parameters are i and j indices of a
 		//! data point. The order of execution is i-first, j-last.
 		//!
-		void ForEachDataPointIndex(const std::function<void(size_t, size_t, size_t)>& func) const;
+		template <typename Callback>
+		void ForEachDataPointIndex(Callback func) const;
 
 		//!
 		//! \brief Invokes the given function \p func for each data point in parallel.
@@ -122,7 +123,8 @@ namespace CubbyFlow
 		//! data point. The order of execution can be arbitrary since it's
 		//! multi-threaded.
 		//!
-		void ParallelForEachDataPointIndex(const std::function<void(size_t, size_t, size_t)>& func) const;
+		template <typename Callback>
+		void ParallelForEachDataPointIndex(Callback func) const;
 
 		// ScalarField3 implementations
 
@@ -200,4 +202,6 @@ namespace CubbyFlow
 	using ScalarGridBuilder3Ptr = std::shared_ptr<ScalarGridBuilder3>;
 }
 
+#include <Grid/ScalarGrid3-Impl.h>
+
 #endif
\ No newline at end of file
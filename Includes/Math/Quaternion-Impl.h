@@ -53,12 +53,6 @@ namespace CubbyFlow
 		Set(m33);
 	}
 
-	template <typename T>
-	Quaternion<T>::Quaternion(const Quaternion& other)
-	{
-		Set(other);
-	}
-
 	template <typename T>
 	void Quaternion<T>::Set(const Quaternion& other)
 	{
@@ -390,13 +384,6 @@ namespace CubbyFlow
 		return std::sqrt(w * w + x * x + y * y + z * z);
 	}
 
-	template <typename T>
-	Quaternion<T>& Quaternion<T>::operator=(const Quaternion& other)
-	{
-		Set(other);
-		return *this;
-	}
-
 	template <typename T>
 	Quaternion<T>& Quaternion<T>::operator*=(const Quaternion& other)
 	{
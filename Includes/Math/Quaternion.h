@@ -57,7 +57,7 @@ namespace CubbyFlow
 		explicit Quaternion(const Matrix3x3<T>& m33);
 
 		//! Copy constructor.
-		Quaternion(const Quaternion& other);
+		Quaternion(const Quaternion& other) = default;
 
 		// MARK: Basic setters
 		//! Sets the quaternion with other quaternion.
@@ -141,7 +141,7 @@ namespace CubbyFlow
 
 		// MARK: Setter operators
 		//! Assigns other quaternion.
-		Quaternion& operator=(const Quaternion& other);
+		Quaternion& operator=(const Quaternion& other) = default;
 
 		//! Returns this quaternion *= other quaternion.
 		Quaternion& operator*=(const Quaternion& other);
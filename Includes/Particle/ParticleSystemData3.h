@@ -10,10 +10,13 @@
 #define CUBBYFLOW_PARTICLE_SYSTEM_DATA3_H
 
 #include <Array/Array1.h>
+#include <Array/PagedArray1.h>
 #include <Searcher/PointNeighborSearcher3.h>
+#include <Utils/Checkpoint.h>
 #include <Utils/Serialization.h>
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #ifndef CUBBYFLOW_DOXYGEN
@@ -43,6 +46,12 @@ namespace CubbyFlow
 	//! single particle has position, velocity, and force attributes by default. But
 	//! it can also have additional custom scalar or vector attributes.
 	//!
+	//! Every attribute, including the positions, velocities, and forces, is
+	//! stored in a PagedArray1. Adding particles only commits the missing chunks, so the
+	//! existing particles are not copied, and the layers can be mapped from
+	//! scratch files (see SetBackingDirectory) to hold more particles than
+	//! the physical memory.
+	//!
 	class ParticleSystemData3 : public Serializable
 	{
 	public:
@@ -52,6 +61,12 @@ namespace CubbyFlow
 		//! Vector data chunk.
 		using VectorData = Array1<Vector3D>;
 
+		//! Paged scalar data chunk storing a scalar data layer.
+		using PagedScalarData = PagedArray1<double>;
+
+		//! Paged vector data chunk storing a vector data layer.
+		using PagedVectorData = PagedArray1<Vector3D>;
+
 		//! Default constructor.
 		ParticleSystemData3();
 
@@ -80,6 +95,13 @@ namespace CubbyFlow
 		//! Returns the number of particles.
 		size_t NumberOfParticles() const;
 
+		//! Returns the number of scalar data layers.
+		size_t NumberOfScalarData() const;
+
+		//! Returns the number of vector data layers, including the positions,
+		//! velocities, and forces.
+		size_t NumberOfVectorData() const;
+
 		//!
 		//! \brief      Adds a scalar data layer and returns its index.
 		//!
@@ -100,6 +122,25 @@ namespace CubbyFlow
 		//!
 		size_t AddVectorData(const Vector3D& initialVal = Vector3D());
 
+		//! Returns the directory of the scratch files backing the data layers,
+		//! or empty string if they are on the heap.
+		const std::string& GetBackingDirectory() const;
+
+		//!
+		//! \brief      Sets the directory of the scratch files backing the data
+		//!             layers.
+		//!
+		//! The existing layers, including the positions, velocities, and
+		//! forces, are moved to the scratch files once, and the layers added
+		//! later are created there. The operating system can then page the
+		//! cold chunks out of RAM. Empty string moves the layers back to the
+		//! heap.
+		//!
+		//! \param[in] backingDirectory  Directory of the scratch files, or
+		//!                              empty string.
+		//!
+		void SetBackingDirectory(const std::string& backingDirectory);
+
 		//! Returns the radius of the particles.
 		double GetRadius() const;
 
@@ -215,6 +256,29 @@ namespace CubbyFlow
 		//! Deserializes this particle system data from the buffer.
 		void Deserialize(const std::vector<uint8_t>& buffer) override;
 
+		//!
+		//! \brief      Writes the particle attributes to the checkpoint.
+		//!
+		//! The attribute arrays are streamed directly to the file without any
+		//! intermediate copy. Neighbor searcher and neighbor lists are not saved
+		//! since they are rebuilt from the positions.
+		//!
+		//! \param[in]  writer  The checkpoint writer.
+		//! \param[in]  prefix  The prefix of the chunk names.
+		//!
+		virtual void SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const;
+
+		//!
+		//! \brief      Restores the particle attributes from the checkpoint.
+		//!
+		//! The neighbor lists are cleared and the neighbor searcher, if any, is
+		//! rebuilt with the restored positions.
+		//!
+		//! \param[in]  reader  The checkpoint reader.
+		//! \param[in]  prefix  The prefix of the chunk names.
+		//!
+		virtual void LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix);
+
 		//! Copies from other particle system data.
 		void Set(const ParticleSystemData3& other);
 
@@ -238,8 +302,10 @@ namespace CubbyFlow
 		size_t m_velocityIdx;
 		size_t m_forceIdx;
 
-		std::vector<ScalarData> m_scalarDataList;
-		std::vector<VectorData> m_vectorDataList;
+		std::string m_backingDirectory;
+
+		std::vector<PagedScalarData> m_scalarDataList;
+		std::vector<PagedVectorData> m_vectorDataList;
 
 		PointNeighborSearcher3Ptr m_neighborSearcher;
 		std::vector<std::vector<size_t>> m_neighborLists;
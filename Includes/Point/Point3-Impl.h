@@ -332,13 +332,6 @@ namespace CubbyFlow
 		return (*this);
 	}
 
-	template <typename T>
-	Point<T, 3>& Point<T, 3>::operator=(const Point& v)
-	{
-		Set(v);
-		return (*this);
-	}
-
 	template <typename T>
 	Point<T, 3>& Point<T, 3>::operator+=(T v)
 	{
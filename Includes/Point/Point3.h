@@ -62,10 +62,7 @@ namespace CubbyFlow
 		Point(const std::initializer_list<U>& list);
 
 		//! Copy constructor.
-		constexpr Point(const Point& pt) : x(pt.x), y(pt.y), z(pt.z)
-		{
-			// Do nothing
-		}
+		constexpr Point(const Point& pt) = default;
 
 		// MARK: Basic setters
 		//! Set all x, y, and z components to \p s.
@@ -208,7 +205,7 @@ namespace CubbyFlow
 		Point& operator=(const std::initializer_list<T>& list);
 
 		//! Set x, y, and z with other point \p pt.
-		Point& operator=(const Point& v);
+		Point& operator=(const Point& v) = default;
 
 		//! Computes this += (v, v, v)
 		Point& operator+=(T v);
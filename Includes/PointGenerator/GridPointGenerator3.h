@@ -29,7 +29,19 @@ namespace CubbyFlow
 		void ForEachPoint(
 			const BoundingBox3D& boundingBox,
 			double spacing,
-			const std::function<bool(const Vector3D&)>& callback) const;
+			const std::function<bool(const Vector3D&)>& callback) const override;
+
+		//! Returns the number of regular grid points inside \p boundingBox.
+		size_t NumberOfPoints(const BoundingBox3D& boundingBox, double spacing) const override;
+
+		//!
+		//! \brief Invokes \p func for each regular grid points inside
+		//! \p boundingBox in parallel.
+		//!
+		//! The index passed to \p func is the order of the point in ForEachPoint.
+		//!
+		void ParallelForEachPoint(const BoundingBox3D& boundingBox, double spacing,
+			const std::function<void(size_t, const Vector3D&)>& func) const override;
 	};
 
 	//! Shared pointer type for the GridPointGenerator3.
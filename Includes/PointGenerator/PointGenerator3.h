@@ -47,6 +47,28 @@ namespace CubbyFlow
 		//!
 		virtual void ForEachPoint(const BoundingBox3D& boundingBox, double spacing,
 			const std::function<bool(const Vector3D&)>& callback) const = 0;
+
+		//!
+		//! \brief Returns the number of points ForEachPoint would visit within
+		//! the bounding box.
+		//!
+		//! The default implementation counts the points by iterating them. The
+		//! inherited classes with a closed-form count should override this.
+		//!
+		virtual size_t NumberOfPoints(const BoundingBox3D& boundingBox, double spacing) const;
+
+		//!
+		//! \brief Invokes \p func for every point within the bounding box in
+		//! parallel.
+		//!
+		//! This function visits the same points as ForEachPoint, but in no
+		//! specific order and possibly from multiple threads. The first parameter
+		//! of \p func is the sequential index of the point, i.e. the order in
+		//! which ForEachPoint would visit it, which lies in [0, NumberOfPoints()).
+		//! The default implementation invokes \p func serially.
+		//!
+		virtual void ParallelForEachPoint(const BoundingBox3D& boundingBox, double spacing,
+			const std::function<void(size_t, const Vector3D&)>& func) const;
 	};
 
 	//! Shared pointer for the PointGenerator3 type.
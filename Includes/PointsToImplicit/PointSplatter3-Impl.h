@@ -0,0 +1,295 @@
+/*************************************************************************
+> File Name: PointSplatter3-Impl.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Parallel, block-sparse scatter of point contributions to a grid.
+> Created Time: 2017/10/24
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_POINT_SPLATTER3_IMPL_H
+#define CUBBYFLOW_POINT_SPLATTER3_IMPL_H
+
+#include <Math/MathUtils.h>
+#include <Utils/Parallel.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace CubbyFlow
+{
+	template <typename T>
+	PointSplatter3<T>::PointSplatter3(const Size3& dataSize, const Vector3D& gridSpacing, const Vector3D& dataOrigin) :
+		m_dataSize(dataSize), m_gridSpacing(gridSpacing), m_dataOrigin(dataOrigin)
+	{
+		m_numberOfBlocks = Size3(
+			(dataSize.x + BLOCK_SIZE - 1) / BLOCK_SIZE,
+			(dataSize.y + BLOCK_SIZE - 1) / BLOCK_SIZE,
+			(dataSize.z + BLOCK_SIZE - 1) / BLOCK_SIZE);
+	}
+
+	template <typename T>
+	template <typename Callback>
+	void PointSplatter3<T>::Splat(const ConstArrayAccessor1<Vector3D>& points, double supportRadius, const Callback& func)
+	{
+		SplatImpl(points, supportRadius, [supportRadius](size_t)
+		{
+			return supportRadius;
+		}, func);
+	}
+
+	template <typename T>
+	template <typename Callback>
+	void PointSplatter3<T>::Splat(const ConstArrayAccessor1<Vector3D>& points,
+		const ConstArrayAccessor1<double>& supportRadii, const Callback& func)
+	{
+		const double maxSupportRadius = ParallelReduce(ZERO_SIZE, supportRadii.size(), 0.0,
+			[&](size_t start, size_t end, double init)
+		{
+			double result = init;
+
+			for (size_t i = start; i < end; ++i)
+			{
+				result = std::max(result, supportRadii[i]);
+			}
+
+			return result;
+		}, [](double a, double b) { return std::max(a, b); });
+
+		SplatImpl(points, maxSupportRadius, [&supportRadii](size_t i)
+		{
+			return supportRadii[i];
+		}, func);
+	}
+
+	template <typename T>
+	template <typename Callback>
+	void PointSplatter3<T>::ForEachActiveDataPoint(const Callback& func) const
+	{
+		ParallelFor(ZERO_SIZE, m_activeBlocks.size(), [&](size_t n)
+		{
+			const size_t block = m_activeBlocks[n];
+			const size_t iBegin = (block % m_numberOfBlocks.x) * BLOCK_SIZE;
+			const size_t jBegin = ((block / m_numberOfBlocks.x) % m_numberOfBlocks.y) * BLOCK_SIZE;
+			const size_t kBegin = (block / (m_numberOfBlocks.x * m_numberOfBlocks.y)) * BLOCK_SIZE;
+			const size_t iEnd = std::min(iBegin + BLOCK_SIZE, m_dataSize.x);
+			const size_t jEnd = std::min(jBegin + BLOCK_SIZE, m_dataSize.y);
+			const size_t kEnd = std::min(kBegin + BLOCK_SIZE, m_dataSize.z);
+			const T* values = m_values.data() + n * BLOCK_SIZE * BLOCK_SIZE * BLOCK_SIZE;
+
+			for (size_t k = kBegin; k < kEnd; ++k)
+			{
+				for (size_t j = jBegin; j < jEnd; ++j)
+				{
+					for (size_t i = iBegin; i < iEnd; ++i)
+					{
+						func(i, j, k, values[((k - kBegin) * BLOCK_SIZE + (j - jBegin)) * BLOCK_SIZE + (i - iBegin)]);
+					}
+				}
+			}
+		});
+	}
+
+	template <typename T>
+	size_t PointSplatter3<T>::NumberOfActiveBlocks() const
+	{
+		return m_activeBlocks.size();
+	}
+
+	template <typename T>
+	template <typename RadiusFunc, typename Callback>
+	void PointSplatter3<T>::SplatImpl(const ConstArrayAccessor1<Vector3D>& points,
+		double maxSupportRadius, const RadiusFunc& radius, const Callback& func)
+	{
+		const size_t numberOfPoints = points.size();
+		const size_t totalNumberOfBlocks = m_numberOfBlocks.x * m_numberOfBlocks.y * m_numberOfBlocks.z;
+		const size_t noSlab = std::numeric_limits<size_t>::max();
+
+		m_blockIndices.assign(totalNumberOfBlocks, 0);
+		m_activeBlocks.clear();
+		m_values.clear();
+
+		if (totalNumberOfBlocks == 0)
+		{
+			return;
+		}
+
+		// Range of data point indices within [x - r, x + r] along an axis.
+		// Returns false if the range does not overlap the grid.
+		const auto indexRange = [](double x, double r, double origin, double spacing, size_t size,
+			size_t* begin, size_t* end)
+		{
+			const double lower = std::ceil((x - r - origin) / spacing);
+			const double upper = std::floor((x + r - origin) / spacing);
+
+			if (!(upper >= 0.0 && lower <= static_cast<double>(size) - 1.0 && lower <= upper))
+			{
+				return false;
+			}
+
+			*begin = static_cast<size_t>(std::max(lower, 0.0));
+			*end = static_cast<size_t>(std::min(upper, static_cast<double>(size) - 1.0)) + 1;
+
+			return true;
+		};
+
+		const auto pointRange = [&](size_t n, size_t begin[3], size_t end[3])
+		{
+			const Vector3D& x = points[n];
+			const double r = radius(n);
+
+			return indexRange(x.x, r, m_dataOrigin.x, m_gridSpacing.x, m_dataSize.x, &begin[0], &end[0]) &&
+				indexRange(x.y, r, m_dataOrigin.y, m_gridSpacing.y, m_dataSize.y, &begin[1], &end[1]) &&
+				indexRange(x.z, r, m_dataOrigin.z, m_gridSpacing.z, m_dataSize.z, &begin[2], &end[2]);
+		};
+
+		// Slabs thicker than the support plus a block guarantee that slab s and
+		// s + 2 never touch the same block.
+		const size_t supportInCells = static_cast<size_t>(std::ceil(maxSupportRadius / m_gridSpacing.z));
+		const size_t slabThickness = ((2 * supportInCells + BLOCK_SIZE) / BLOCK_SIZE + 1) * BLOCK_SIZE;
+		const size_t numberOfSlabs = (m_dataSize.z + slabThickness - 1) / slabThickness;
+
+		// Bucket the points into the slabs while keeping the index order
+		std::vector<size_t> slabOfPoint(numberOfPoints);
+		ParallelFor(ZERO_SIZE, numberOfPoints, [&](size_t n)
+		{
+			size_t begin[3], end[3];
+
+			if (pointRange(n, begin, end))
+			{
+				const double z = std::floor((points[n].z - m_dataOrigin.z) / m_gridSpacing.z);
+				const double k = Clamp(z, 0.0, static_cast<double>(m_dataSize.z - 1));
+				slabOfPoint[n] = static_cast<size_t>(k) / slabThickness;
+			}
+			else
+			{
+				slabOfPoint[n] = noSlab;
+			}
+		});
+
+		std::vector<size_t> slabStart(numberOfSlabs + 1, 0);
+		for (size_t n = 0; n < numberOfPoints; ++n)
+		{
+			if (slabOfPoint[n] != noSlab)
+			{
+				++slabStart[slabOfPoint[n] + 1];
+			}
+		}
+
+		for (size_t s = 0; s < numberOfSlabs; ++s)
+		{
+			slabStart[s + 1] += slabStart[s];
+		}
+
+		std::vector<size_t> sortedPoints(slabStart[numberOfSlabs]);
+		{
+			std::vector<size_t> cursor(slabStart.begin(), slabStart.end() - 1);
+			for (size_t n = 0; n < numberOfPoints; ++n)
+			{
+				if (slabOfPoint[n] != noSlab)
+				{
+					sortedPoints[cursor[slabOfPoint[n]]++] = n;
+				}
+			}
+		}
+
+		// Visits the slabs of the same parity in parallel
+		const auto forEachSlab = [&](const auto& slabFunc)
+		{
+			for (size_t parity = 0; parity < 2; ++parity)
+			{
+				ParallelFor(ZERO_SIZE, (numberOfSlabs + 1 - parity) / 2, [&](size_t s)
+				{
+					const size_t slab = 2 * s + parity;
+
+					for (size_t m = slabStart[slab]; m < slabStart[slab + 1]; ++m)
+					{
+						slabFunc(sortedPoints[m]);
+					}
+				});
+			}
+		};
+
+		// Mark the blocks within the support of the points
+		forEachSlab([&](size_t n)
+		{
+			// The points outside of the grid are not bucketed, but the range is
+			// checked so that begin and end are never read uninitialized
+			size_t begin[3], end[3];
+			if (!pointRange(n, begin, end))
+			{
+				return;
+			}
+
+			for (size_t bk = begin[2] / BLOCK_SIZE; bk <= (end[2] - 1) / BLOCK_SIZE; ++bk)
+			{
+				for (size_t bj = begin[1] / BLOCK_SIZE; bj <= (end[1] - 1) / BLOCK_SIZE; ++bj)
+				{
+					for (size_t bi = begin[0] / BLOCK_SIZE; bi <= (end[0] - 1) / BLOCK_SIZE; ++bi)
+					{
+						m_blockIndices[(bk * m_numberOfBlocks.y + bj) * m_numberOfBlocks.x + bi] = 1;
+					}
+				}
+			}
+		});
+
+		for (size_t block = 0; block < totalNumberOfBlocks; ++block)
+		{
+			if (m_blockIndices[block] != 0)
+			{
+				m_blockIndices[block] = m_activeBlocks.size();
+				m_activeBlocks.push_back(block);
+			}
+			else
+			{
+				m_blockIndices[block] = std::numeric_limits<size_t>::max();
+			}
+		}
+
+		m_values.assign(m_activeBlocks.size() * BLOCK_SIZE * BLOCK_SIZE * BLOCK_SIZE, T());
+
+		// Accumulate
+		forEachSlab([&](size_t n)
+		{
+			size_t begin[3], end[3];
+			if (!pointRange(n, begin, end))
+			{
+				return;
+			}
+
+			const Vector3D& x = points[n];
+			const double r = radius(n);
+
+			for (size_t k = begin[2]; k < end[2]; ++k)
+			{
+				const double dz = m_dataOrigin.z + m_gridSpacing.z * static_cast<double>(k) - x.z;
+
+				for (size_t j = begin[1]; j < end[1]; ++j)
+				{
+					const double dy = m_dataOrigin.y + m_gridSpacing.y * static_cast<double>(j) - x.y;
+					const double rowRadiusSquared = r * r - dy * dy - dz * dz;
+
+					// Clip the row to the ball of the support
+					size_t iBegin, iEnd;
+					if (rowRadiusSquared < 0.0 ||
+						!indexRange(x.x, std::sqrt(rowRadiusSquared), m_dataOrigin.x, m_gridSpacing.x, m_dataSize.x, &iBegin, &iEnd))
+					{
+						continue;
+					}
+
+					for (size_t i = iBegin; i < iEnd; ++i)
+					{
+						const size_t block = ((k / BLOCK_SIZE) * m_numberOfBlocks.y + j / BLOCK_SIZE) * m_numberOfBlocks.x + i / BLOCK_SIZE;
+						const size_t local = ((k % BLOCK_SIZE) * BLOCK_SIZE + j % BLOCK_SIZE) * BLOCK_SIZE + i % BLOCK_SIZE;
+						const Vector3D position = m_dataOrigin + m_gridSpacing * Vector3D(
+							static_cast<double>(i), static_cast<double>(j), static_cast<double>(k));
+
+						func(n, i, j, k, position, &m_values[m_blockIndices[block] * BLOCK_SIZE * BLOCK_SIZE * BLOCK_SIZE + local]);
+					}
+				}
+			}
+		});
+	}
+}
+
+#endif
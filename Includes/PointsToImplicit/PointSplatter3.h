@@ -0,0 +1,100 @@
+/*************************************************************************
+> File Name: PointSplatter3.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Parallel, block-sparse scatter of point contributions to a grid.
+> Created Time: 2017/10/24
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_POINT_SPLATTER3_H
+#define CUBBYFLOW_POINT_SPLATTER3_H
+
+#include <Array/ArrayAccessor1.h>
+#include <Size/Size3.h>
+#include <Vector/Vector3.h>
+
+#include <vector>
+
+namespace CubbyFlow
+{
+	//!
+	//! \brief Parallel, block-sparse scatter of point contributions to a grid.
+	//!
+	//! This class accumulates per-point contributions into the data points of a
+	//! regular grid. Instead of querying the neighbors of every data point, each
+	//! point visits the data points within its support, so the cost scales with
+	//! the number of points rather than the grid size. The accumulators are
+	//! allocated in blocks of BLOCK_SIZE^3 data points only where some point
+	//! reaches.
+	//!
+	//! The points are bucketed into z-slabs that are at least twice as thick as
+	//! the support. Even and odd slabs are processed in two parallel passes, so
+	//! no two threads write the same accumulator. Within a slab the points are
+	//! visited in index order, which makes the result independent of the number
+	//! of threads.
+	//!
+	//! \tparam     T     Accumulator type. Must be default-constructible.
+	//!
+	template <typename T>
+	class PointSplatter3
+	{
+	public:
+		//! Number of data points per axis in a block.
+		static const size_t BLOCK_SIZE = 8;
+
+		//! Constructs a splatter for data points origin + spacing * (i, j, k)
+		//! where (i, j, k) < \p dataSize.
+		PointSplatter3(const Size3& dataSize, const Vector3D& gridSpacing, const Vector3D& dataOrigin);
+
+		//!
+		//! \brief Splats the points with a uniform support radius.
+		//!
+		//! Invokes \p func(pointIndex, i, j, k, dataPosition, value) for every
+		//! data point whose position lies within \p supportRadius from the
+		//! point. \p value points to the accumulator of that data point.
+		//!
+		template <typename Callback>
+		void Splat(const ConstArrayAccessor1<Vector3D>& points, double supportRadius, const Callback& func);
+
+		//!
+		//! \brief Splats the points with per-point support radii.
+		//!
+		//! Same as above, except that the support of i-th point has radius
+		//! \p supportRadii[i].
+		//!
+		template <typename Callback>
+		void Splat(const ConstArrayAccessor1<Vector3D>& points,
+			const ConstArrayAccessor1<double>& supportRadii, const Callback& func);
+
+		//!
+		//! \brief Invokes \p func(i, j, k, value) for every data point of the
+		//! active blocks in parallel.
+		//!
+		//! Data points that no point has reached are not visited. Their value
+		//! is the default-constructed T.
+		//!
+		template <typename Callback>
+		void ForEachActiveDataPoint(const Callback& func) const;
+
+		//! Returns the number of allocated blocks.
+		size_t NumberOfActiveBlocks() const;
+
+	private:
+		Size3 m_dataSize;
+		Vector3D m_gridSpacing;
+		Vector3D m_dataOrigin;
+		Size3 m_numberOfBlocks;
+
+		std::vector<size_t> m_blockIndices;
+		std::vector<size_t> m_activeBlocks;
+		std::vector<T> m_values;
+
+		template <typename RadiusFunc, typename Callback>
+		void SplatImpl(const ConstArrayAccessor1<Vector3D>& points,
+			double maxSupportRadius, const RadiusFunc& radius, const Callback& func);
+	};
+}
+
+#include <PointsToImplicit/PointSplatter3-Impl.h>
+
+#endif
@@ -0,0 +1,44 @@
+/*************************************************************************
+> File Name: PointsToImplicit3.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Abstract base class for 3-D points-to-implicit converters.
+> Created Time: 2017/10/24
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_POINTS_TO_IMPLICIT3_H
+#define CUBBYFLOW_POINTS_TO_IMPLICIT3_H
+
+#include <Array/ArrayAccessor1.h>
+#include <Grid/ScalarGrid3.h>
+
+#include <memory>
+
+namespace CubbyFlow
+{
+	//!
+	//! \brief Abstract base class for 3-D points-to-implicit converters.
+	//!
+	//! This class provides interface for the converters that reconstruct an
+	//! implicit surface from a point cloud such as fluid particles. The output
+	//! is a scalar field sampled on the data points of a grid, whose zero level
+	//! is the reconstructed surface (negative inside).
+	//!
+	class PointsToImplicit3
+	{
+	public:
+		//! Default constructor.
+		PointsToImplicit3();
+
+		//! Default destructor.
+		virtual ~PointsToImplicit3();
+
+		//! Converts the given points to implicit surface scalar field.
+		virtual void Convert(const ConstArrayAccessor1<Vector3D>& points, ScalarGrid3* output) const = 0;
+	};
+
+	//! Shared pointer for the PointsToImplicit3 type.
+	using PointsToImplicit3Ptr = std::shared_ptr<PointsToImplicit3>;
+}
+
+#endif
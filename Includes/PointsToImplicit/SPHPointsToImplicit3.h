@@ -0,0 +1,47 @@
+/*************************************************************************
+> File Name: SPHPointsToImplicit3.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: 3-D points-to-implicit converter based on standard SPH kernel.
+> Created Time: 2017/10/24
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_SPH_POINTS_TO_IMPLICIT3_H
+#define CUBBYFLOW_SPH_POINTS_TO_IMPLICIT3_H
+
+#include <PointsToImplicit/PointsToImplicit3.h>
+
+namespace CubbyFlow
+{
+	//!
+	//! \brief 3-D points-to-implicit converter based on standard SPH kernel.
+	//!
+	//! The output is cutOffDensity - sum_j (m / rho_j) W(x - x_j), i.e. the
+	//! normalized SPH density field shifted by the cut-off density. The kernel
+	//! contributions are splatted from the points with PointSplatter3, so only
+	//! the data points within the kernel radius of some point are evaluated.
+	//!
+	//! \see Müller, Matthias, David Charypar, and Markus Gross.
+	//!      "Particle-based fluid simulation for interactive applications."
+	//!      Proceedings of the 2003 ACM SIGGRAPH/Eurographics symposium on
+	//!      Computer animation. Eurographics Association, 2003.
+	//!
+	class SPHPointsToImplicit3 final : public PointsToImplicit3
+	{
+	public:
+		//! Constructs the converter with given kernel radius and cut-off density.
+		SPHPointsToImplicit3(double kernelRadius = 1.0, double cutOffDensity = 0.5);
+
+		//! Converts the given points to implicit surface scalar field.
+		void Convert(const ConstArrayAccessor1<Vector3D>& points, ScalarGrid3* output) const override;
+
+	private:
+		double m_kernelRadius = 1.0;
+		double m_cutOffDensity = 0.5;
+	};
+
+	//! Shared pointer type for SPHPointsToImplicit3.
+	using SPHPointsToImplicit3Ptr = std::shared_ptr<SPHPointsToImplicit3>;
+}
+
+#endif
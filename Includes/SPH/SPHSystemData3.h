@@ -159,6 +159,12 @@ namespace CubbyFlow
 		//! Deserializes this SPH system data from the buffer.
 		void Deserialize(const std::vector<uint8_t>& buffer) override;
 
+		//! Writes the SPH particle attributes and parameters to the checkpoint.
+		void SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const override;
+
+		//! Restores the SPH particle attributes and parameters from the checkpoint.
+		void LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix) override;
+
 		//! Copies from other SPH system data.
 		void Set(const SPHSystemData3& other);
 
@@ -24,6 +24,13 @@ namespace CubbyFlow
 	//! classes can override SemiLagrangian2::getScalarSamplerFunc and
 	//! SemiLagrangian2::getVectorSamplerFunc. See CubicSemiLagrangian2 for example.
 	//!
+	//! The common cases are statically dispatched: face-centered flows, constant
+	//! or grid boundaries, and sampler functions which hold a built-in linear or
+	//! cubic array sampler are sampled by inlined array samplers instead of
+	//! virtual calls or std::function. Any other function returned by an
+	//! overridden sampler function is called as it is. The output grid is
+	//! traversed in tiles of rows to improve cache reuse.
+	//!
 	class SemiLagrangian3 : public AdvectionSolver3
 	{
 	public:
@@ -108,6 +115,26 @@ namespace CubbyFlow
 			const ScalarField3& boundarySDF = ConstantScalarField3(std::numeric_limits<double>::max())) final;
 
 	protected:
+		//!
+		//! \brief Samples a face-centered grid with one sampler per component.
+		//!
+		//! GetVectorSamplerFunc for face-centered grids returns this function
+		//! object, so that SemiLagrangian3::Advect can sample each component
+		//! with its own inlined sampler.
+		//!
+		template <typename ComponentSampler>
+		struct FaceCenteredSamplerFunc
+		{
+			ComponentSampler uSampler;
+			ComponentSampler vSampler;
+			ComponentSampler wSampler;
+
+			Vector3D operator()(const Vector3D& x) const
+			{
+				return Vector3D(uSampler(x), vSampler(x), wSampler(x));
+			}
+		};
+
 		//!
 		//! \brief Returns spatial interpolation function object for given scalar grid.
 		//!
@@ -139,14 +166,6 @@ namespace CubbyFlow
 		//! interpolation for semi-Lagrangian process.
 		//!
 		virtual std::function<Vector3D(const Vector3D&)> GetVectorSamplerFunc(const FaceCenteredGrid3& input) const;
-
-	private:
-		Vector3D BackTrace(
-			const VectorField3& flow,
-			double dt,
-			double h,
-			const Vector3D& pt0,
-			const ScalarField3& boundarySDF) const;
 	};
 }
 
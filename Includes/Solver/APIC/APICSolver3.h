@@ -49,6 +49,12 @@ namespace CubbyFlow
 		//! Transfers velocity field from grids to particles.
 		void TransferFromGridsToParticles() override;
 
+		//! Writes the solver state to the checkpoint.
+		void OnSaveCheckpoint(CheckpointWriter* writer) const override;
+
+		//! Restores the solver state from the checkpoint.
+		void OnLoadCheckpoint(const CheckpointReader& reader) override;
+
 	private:
 		Array1<Vector3D> m_cX;
 		Array1<Vector3D> m_cY;
@@ -13,12 +13,24 @@
 
 namespace CubbyFlow
 {
+	//!
 	//! \brief 3-D finite difference-type linear system solver using conjugate gradient.
+	//!
+	//! When warm-started, the solver starts from the solution vector of the
+	//! given system instead of zero. With a positive relative tolerance, the
+	//! iterations stop once the residual norm drops below the relative
+	//! tolerance times the norm of the right-hand side, if that is larger than
+	//! the absolute tolerance.
+	//!
 	class FDMCGSolver3 final : public FDMLinearSystemSolver3
 	{
 	public:
 		//! Constructs the solver with given parameters.
-		FDMCGSolver3(unsigned int maxNumberOfIterations, double tolerance);
+		FDMCGSolver3(
+			unsigned int maxNumberOfIterations,
+			double tolerance,
+			double relativeTolerance = 0.0,
+			bool isWarmStarted = false);
 
 		//! Solves the given linear system.
 		bool Solve(FDMLinearSystem3* system) override;
@@ -35,11 +47,19 @@ namespace CubbyFlow
 		//! Returns the last residual after the Jacobi iterations.
 		double GetLastResidual() const;
 
+		//! Returns the residual tolerance relative to the right-hand side.
+		double GetRelativeTolerance() const;
+
+		//! Returns true if the solver starts from the given solution vector.
+		bool IsWarmStarted() const;
+
 	private:
 		unsigned int m_maxNumberOfIterations;
 		unsigned int m_lastNumberOfIterations;
 		double m_tolerance;
 		double m_lastResidual;
+		double m_relativeTolerance;
+		bool m_isWarmStarted;
 
 		FDMVector3 m_r;
 		FDMVector3 m_d;
@@ -0,0 +1,101 @@
+/*************************************************************************
+> File Name: FDMDistributedCGSolver3.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: 3-D finite difference-type linear system solver using distributed conjugate gradient.
+> Created Time: 2017/10/26
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_FDM_DISTRIBUTED_CG_SOLVER3_H
+#define CUBBYFLOW_FDM_DISTRIBUTED_CG_SOLVER3_H
+
+#include <Decomposition/GridDomainDecomposition3.h>
+#include <Decomposition/SubdomainTransport.h>
+#include <Size/Size3.h>
+#include <Solver/FDM/FDMLinearSystemSolver3.h>
+
+namespace CubbyFlow
+{
+	//!
+	//! \brief 3-D finite difference-type linear system solver using conjugate
+	//!        gradient over decomposed subdomains.
+	//!
+	//! The system is split by GridDomainDecomposition3 into subdomains with
+	//! one layer of ghost cells, and each rank of the transport iterates the
+	//! Jacobi-preconditioned conjugate gradient on its own subdomain. The
+	//! search direction halos are exchanged before every matrix-vector
+	//! product, and the dot products are reduced over all ranks. Since the
+	//! reductions are deterministic, the result does not depend on the timing
+	//! of the ranks.
+	//!
+	//! The ranks read their rows of the matrix and the right-hand side from
+	//! the given system instead of copying them, so the solver only adds the
+	//! solution and the four work vectors of each subdomain, which are kept
+	//! across the solves.
+	//!
+	//! The solver can replace FDMCGSolver3 wherever FDMLinearSystemSolver3 is
+	//! accepted, such as GridSinglePhasePressureSolver3::SetLinearSystemSolver.
+	//!
+	class FDMDistributedCGSolver3 final : public FDMLinearSystemSolver3
+	{
+	public:
+		//!
+		//! Constructs the solver with given parameters.
+		//!
+		//! \param layout Number of subdomains along each axis.
+		//! \param maxNumberOfIterations Max number of CG iterations.
+		//! \param tolerance Max residual tolerance.
+		//! \param transport Transport with layout.x * layout.y * layout.z
+		//!                  ranks. If null, SharedMemorySubdomainTransport is
+		//!                  used.
+		//!
+		FDMDistributedCGSolver3(
+			const Size3& layout,
+			unsigned int maxNumberOfIterations,
+			double tolerance,
+			const SubdomainTransportPtr& transport = nullptr);
+
+		//! Solves the given linear system.
+		bool Solve(FDMLinearSystem3* system) override;
+
+		//! Returns the number of subdomains along each axis.
+		const Size3& GetLayout() const;
+
+		//! Returns the max number of CG iterations.
+		unsigned int GetMaxNumberOfIterations() const;
+
+		//! Returns the last number of CG iterations the solver made.
+		unsigned int GetLastNumberOfIterations() const;
+
+		//! Returns the max residual tolerance for the CG method.
+		double GetTolerance() const;
+
+		//! Returns the last residual after the CG iterations.
+		double GetLastResidual() const;
+
+	private:
+		//! Local solution and work vectors of a rank.
+		struct Subdomain
+		{
+			FDMVector3 x;
+			FDMVector3 r;
+			FDMVector3 d;
+			FDMVector3 q;
+			FDMVector3 s;
+		};
+
+		Size3 m_layout;
+		unsigned int m_maxNumberOfIterations;
+		unsigned int m_lastNumberOfIterations;
+		double m_tolerance;
+		double m_lastResidual;
+		SubdomainTransportPtr m_transport;
+		GridDomainDecomposition3Ptr m_decomposition;
+		std::vector<Subdomain> m_subdomains;
+	};
+
+	//! Shared pointer type for the FDMDistributedCGSolver3.
+	using FDMDistributedCGSolver3Ptr = std::shared_ptr<FDMDistributedCGSolver3>;
+}
+
+#endif
\ No newline at end of file
@@ -10,18 +10,41 @@
 #define CUBBYFLOW_FDM_GAUSS_SEIDEL_SOLVER2_H
 
 #include <Solver/FDM/FDMLinearSystemSolver2.h>
+#include <Utils/MultiGrid.h>
 
 namespace CubbyFlow
 {
+	//!
 	//! \brief 2-D finite difference-type linear system solver using Gauss-Seidel method.
+	//!
+	//! The solver performs successive over-relaxation (SOR) when the SOR factor
+	//! is not one. The lexicographic sweep is serial, while the red-black and
+	//! the multicolor sweeps update the cells of each color in parallel since
+	//! the cells of the same color do not depend on each other.
+	//!
 	class FDMGaussSeidelSolver2 final : public FDMLinearSystemSolver2
 	{
 	public:
+		//! Order of the cells in a Gauss-Seidel sweep.
+		enum class Ordering
+		{
+			//! Serial sweep in the index order.
+			Lexicographic,
+
+			//! Two colors by the parity of i + j.
+			RedBlack,
+
+			//! 4 colors by the parities of i and j.
+			Multicolor
+		};
+
 		//! Constructs the solver with given parameters.
 		FDMGaussSeidelSolver2(
 			unsigned int maxNumberOfIterations,
 			unsigned int residualCheckInterval,
-			double tolerance);
+			double tolerance,
+			double sorFactor = 1.0,
+			Ordering ordering = Ordering::Lexicographic);
 
 		//! Solves the given linear system.
 		bool Solve(FDMLinearSystem2* system) override;
@@ -38,16 +61,36 @@ namespace CubbyFlow
 		//! Returns the last residual after the Gauss-Seidel iterations.
 		double GetLastResidual() const;
 
+		//! Returns the SOR factor.
+		double GetSORFactor() const;
+
+		//! Returns the order of the cells in a sweep.
+		Ordering GetOrdering() const;
+
+		//! Performs a single Gauss-Seidel sweep with given SOR factor and ordering.
+		static void Relax(
+			const FDMMatrix2& A,
+			const FDMVector2& b,
+			double sorFactor,
+			Ordering ordering,
+			FDMVector2* x);
+
+		//! Returns the relax function for MultiGridParameters performing the
+		//! sweeps with given SOR factor and ordering.
+		static MultiGridRelaxFunc<FDMBlas2> GetMultiGridRelaxFunc(
+			double sorFactor = 1.0,
+			Ordering ordering = Ordering::RedBlack);
+
 	private:
 		unsigned int m_maxNumberOfIterations;
 		unsigned int m_lastNumberOfIterations;
 		unsigned int m_residualCheckInterval;
 		double m_tolerance;
 		double m_lastResidual;
+		double m_sorFactor;
+		Ordering m_ordering;
 
 		FDMVector2 m_residual;
-
-		void Relax(FDMLinearSystem2* system);
 	};
 
 	//! Shared pointer type for the FDMGaussSeidelSolver2.
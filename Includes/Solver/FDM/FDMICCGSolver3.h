@@ -18,11 +18,28 @@ namespace CubbyFlow
 	//! \brief 3-D finite difference-type linear system solver using incomplete
 	//!        Cholesky conjugate gradient (ICCG).
 	//!
+	//! The work vectors and the preconditioner are kept across the Solve calls.
+	//! The solver keeps a copy of the last factorized matrix, and only the
+	//! part of the factorization that follows the first changed row is built
+	//! again, so solving a system whose matrix is unchanged (e.g., the pressure
+	//! of a fluid with static boundaries) skips the factorization altogether.
+	//!
+	//! When warm-started, the solver starts from the solution vector of the
+	//! given system instead of zero, so that the solution of the last step can
+	//! be used as the initial guess. With a positive relative tolerance, the
+	//! iterations stop once the residual drops below the relative tolerance
+	//! times the right-hand side measured in the same norm, if that is larger
+	//! than the absolute tolerance.
+	//!
 	class FDMICCGSolver3 final : public FDMLinearSystemSolver3
 	{
 	public:
 		//! Constructs the solver with given parameters.
-		FDMICCGSolver3(unsigned int maxNumberOfIterations, double tolerance);
+		FDMICCGSolver3(
+			unsigned int maxNumberOfIterations,
+			double tolerance,
+			double relativeTolerance = 0.0,
+			bool isWarmStarted = false);
 
 		//! Solves the given linear system.
 		bool Solve(FDMLinearSystem3* system) override;
@@ -39,13 +56,26 @@ namespace CubbyFlow
 		//! Returns the last residual after the Jacobi iterations.
 		double GetLastResidual() const;
 
+		//! Returns the residual tolerance relative to the right-hand side.
+		double GetRelativeTolerance() const;
+
+		//! Returns true if the solver starts from the given solution vector.
+		bool IsWarmStarted() const;
+
 	private:
 		struct Preconditioner final
 		{
 			ConstArrayAccessor3<FDMMatrixRow3> A;
+			FDMMatrix3 factored;
 			FDMVector3 d;
 			FDMVector3 y;
 
+			//! Factorizes the rows from the first one different from the last
+			//! factorized matrix.
+			void Factorize(const FDMMatrix3& matrix);
+
+			//! Does nothing, since FDMICCGSolver3::Solve factorizes the matrix
+			//! before running PCG.
 			void Build(const FDMMatrix3& matrix);
 
 			void Solve(const FDMVector3& b, FDMVector3* x);
@@ -55,6 +85,8 @@ namespace CubbyFlow
 		unsigned int m_lastNumberOfIterations;
 		double m_tolerance;
 		double m_lastResidualNorm;
+		double m_relativeTolerance;
+		bool m_isWarmStarted;
 
 		FDMVector3 m_r;
 		FDMVector3 m_d;
@@ -9,11 +9,18 @@
 #ifndef CUBBYFLOW_FDM_JACOBI_SOLVER3_H
 #define CUBBYFLOW_FDM_JACOBI_SOLVER3_H
 
+#include <FDM/FDMStencil3.h>
 #include <Solver/FDM/FDMLinearSystemSolver3.h>
 
 namespace CubbyFlow
 {
+	//!
 	//! \brief 3-D finite difference-type linear system solver using Jacobi method.
+	//!
+	//! The iterations between two residual checks are applied through
+	//! FDMStencil3, so that a temporal block size greater than one reads the
+	//! system from memory once per several iterations.
+	//!
 	class FDMJacobiSolver3 final : public FDMLinearSystemSolver3
 	{
 	public:
@@ -21,7 +28,8 @@ namespace CubbyFlow
 		FDMJacobiSolver3(
 			unsigned int maxNumberOfIterations,
 			unsigned int residualCheckInterval,
-			double tolerance);
+			double tolerance,
+			unsigned int temporalBlockSize = 1);
 
 		//! Solves the given linear system.
 		bool Solve(FDMLinearSystem3* system) override;
@@ -38,6 +46,9 @@ namespace CubbyFlow
 		//! Returns the last residual after the Jacobi iterations.
 		double GetLastResidual() const;
 
+		//! Returns the number of Jacobi iterations applied per pass over the system.
+		unsigned int GetTemporalBlockSize() const;
+
 	private:
 		unsigned int m_maxNumberOfIterations;
 		unsigned int m_lastNumberOfIterations;
@@ -45,10 +56,11 @@ namespace CubbyFlow
 		double m_tolerance;
 		double m_lastResidual;
 
+		FDMStencil3 m_stencil;
 		FDMVector3 m_xTemp;
 		FDMVector3 m_residual;
 
-		void Relax(FDMLinearSystem3* system, FDMVector3* xTemp);
+		void Relax(FDMLinearSystem3* system, unsigned int numberOfIterations);
 	};
 
 	//! Shared pointer type for the FDMJacobiSolver3.
@@ -200,6 +200,12 @@ namespace CubbyFlow
 		//!
 		unsigned int NumberOfSubTimeSteps(double timeIntervalInSeconds) const override;
 
+		//! Writes the solver state to the checkpoint.
+		void OnSaveCheckpoint(CheckpointWriter* writer) const override;
+
+		//! Restores the solver state from the checkpoint.
+		void OnLoadCheckpoint(const CheckpointReader& reader) override;
+
 		//! Called at the beginning of a time-step.
 		virtual void OnBeginAdvanceTimeStep(double timeIntervalInSeconds);
 
@@ -9,6 +9,7 @@
 #ifndef CUBBYFLOW_GRID_FORWARD_EULER_DIFFUSION_SOLVER3_H
 #define CUBBYFLOW_GRID_FORWARD_EULER_DIFFUSION_SOLVER3_H
 
+#include <FDM/FDMStencil3.h>
 #include <Solver/Grid/GridDiffusionSolver3.h>
 
 namespace CubbyFlow
@@ -27,8 +28,9 @@ namespace CubbyFlow
 	class GridForwardEulerDiffusionSolver3 final : public GridDiffusionSolver3
 	{
 	public:
-		//! Default constructor.
-		GridForwardEulerDiffusionSolver3();
+		//! Constructs the solver splitting the time interval into
+		//! \p numberOfSubSteps sub-steps.
+		explicit GridForwardEulerDiffusionSolver3(unsigned int numberOfSubSteps = 1);
 
 		//!
 		//! Solves diffusion equation for a scalar field.
@@ -84,8 +86,15 @@ namespace CubbyFlow
 			const ScalarField3& boundarySDF = ConstantScalarField3(std::numeric_limits<double>::max()),
 			const ScalarField3& fluidSDF = ConstantScalarField3(-std::numeric_limits<double>::max())) override;
 
+		//! Returns the number of sub-steps per time interval.
+		unsigned int GetNumberOfSubSteps() const;
+
 	private:
+		unsigned int m_numberOfSubSteps;
+		FDMStencil3 m_stencil;
 		Array3<char> m_markers;
+		Array3<double> m_buffer;
+		Array3<Vector3D> m_vectorBuffer;
 
 		void BuildMarkers(
 			const Size3& size,
@@ -11,6 +11,10 @@
 
 #include <Field/CustomVectorField3.h>
 #include <Grid/CellCenteredScalarGrid3.h>
+#include <Grid/VertexCenteredScalarGrid3.h>
+#include <Surface/Implicit/ImplicitSurface3.h>
+#include <Surface/Implicit/ImplicitSurfaceSet3.h>
+#include <Surface/SurfaceSet3.h>
 #include <Solver/Grid/GridBoundaryConditionSolver3.h>
 
 namespace CubbyFlow
@@ -23,6 +27,20 @@ namespace CubbyFlow
 	//! should pair up with GridFractionalSinglePhasePressureSolver3 to provide
 	//! sub-grid resolution velocity projection.
 	//!
+	//! For RigidBodyCollider3 with a bounded surface, the signed-distance field
+	//! is baked once in the local frame of the surface and resampled through the
+	//! surface transform whenever the collider moves. The field is re-baked only
+	//! when the collider surface instance or the grid spacing changes, or when
+	//! GridFractionalBoundaryConditionSolver3::InvalidateColliderSDFCache is
+	//! called after modifying the geometry in place.
+	//!
+	//! For a collider whose surface is a SurfaceSet3 (e.g., ColliderSet3), the
+	//! SDF is the union of the member SDFs, i.e. their minimum, evaluated by an
+	//! ImplicitSurfaceSet3. Unlike the signed distance to the closest member
+	//! surface, this stays negative where the members overlap. The implicit set
+	//! is kept across updates, and its hierarchy is only rebuilt when the
+	//! members change or move.
+	//!
 	class GridFractionalBoundaryConditionSolver3 : public GridBoundaryConditionSolver3
 	{
 	public:
@@ -49,6 +67,22 @@ namespace CubbyFlow
 		//! Returns the velocity field of the collider.
 		VectorField3Ptr ColliderVelocityField() const override;
 
+		//! Returns true if the SDF of rigid body colliders is cached in local frame.
+		bool IsUsingColliderSDFCache() const;
+
+		//!
+		//! \brief Enables or disables caching the SDF of rigid body colliders.
+		//!
+		//! When enabled (default), the SDF of a RigidBodyCollider3 is baked in the
+		//! local frame of its surface and trilinearly resampled through the
+		//! surface transform. When disabled, the SDF is evaluated from the
+		//! surface for every grid point whenever the collider is updated.
+		//!
+		void SetIsUsingColliderSDFCache(bool isUsing);
+
+		//! Discards the cached local-frame SDF so that it gets re-baked.
+		void InvalidateColliderSDFCache();
+
 	protected:
 		//! Invoked when a new collider is set.
 		void OnColliderUpdated(
@@ -57,8 +91,25 @@ namespace CubbyFlow
 			const Vector3D& gridOrigin) override;
 
 	private:
+		void BakeLocalColliderSDF(const ImplicitSurface3& implicitSurface, const Transform3& transform, const Vector3D& gridSpacing);
+
+		void ResampleLocalColliderSDF(const Transform3& transform);
+
+		ImplicitSurfaceSet3Ptr UpdateColliderSurfaceSet(const SurfaceSet3Ptr& surfaceSet);
+
 		CellCenteredScalarGrid3Ptr m_colliderSDF;
 		CustomVectorField3Ptr m_colliderVel;
+
+		bool m_isUsingColliderSDFCache = true;
+		Surface3Ptr m_localColliderSurface;
+		VertexCenteredScalarGrid3Ptr m_localColliderSDF;
+		double m_localColliderSDFFarSign = 1.0;
+		Transform3 m_localColliderSDFTransform;
+
+		SurfaceSet3Ptr m_colliderSurfaceSet;
+		std::vector<Surface3Ptr> m_colliderSurfaceSetMembers;
+		std::vector<BoundingBox3D> m_colliderSurfaceSetBounds;
+		ImplicitSurfaceSet3Ptr m_implicitColliderSurfaceSet;
 	};
 
 	//! Shared pointer type for the GridFractionalBoundaryConditionSolver3.
@@ -30,6 +30,12 @@ namespace CubbyFlow
 	//! boundary in fractional manner, meaning that the solver tries to capture the
 	//! sub-grid structures. This class uses ghost fluid method for such calculation.
 	//!
+	//! The weights and the fluid SDF of the last solve are kept, and only the
+	//! matrix rows whose weights or fluid SDF values changed are assembled
+	//! again. The right-hand side is rebuilt every time. The pressure of the
+	//! last solve is the initial guess of the next one, which the default ICCG
+	//! solver is warm-started from.
+	//!
 	//! \see Batty, Christopher, Florence Bertails, and Robert Bridson.
 	//!     "A fast variational framework for accurate solid-fluid coupling."
 	//!     ACM Transactions on Graphics (TOG). Vol. 26. No. 3. ACM, 2007.
@@ -98,6 +104,11 @@ namespace CubbyFlow
 		Array3<float> m_vWeights;
 		Array3<float> m_wWeights;
 		Array3<float> m_fluidSDF;
+		Array3<float> m_lastUWeights;
+		Array3<float> m_lastVWeights;
+		Array3<float> m_lastWWeights;
+		Array3<float> m_lastFluidSDF;
+		Vector3D m_lastGridSpacing;
 		std::function<Vector3D(const Vector3D&)> m_boundaryVel;
 
 		void BuildWeights(
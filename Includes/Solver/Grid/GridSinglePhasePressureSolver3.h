@@ -28,6 +28,12 @@ namespace CubbyFlow
 	//! fluid, it is marked as either fluid or atmosphere. Thus, this solver in
 	//! general, does not compute sub-grid structure.
 	//!
+	//! The markers of the last solve are kept, and only the matrix rows whose
+	//! cell or neighbors changed their markers are assembled again. The
+	//! right-hand side is rebuilt every time. The pressure of the last solve
+	//! is the initial guess of the next one, which the default ICCG solver is
+	//! warm-started from.
+	//!
 	class GridSinglePhasePressureSolver3 : public GridPressureSolver3
 	{
 	public:
@@ -88,6 +94,8 @@ namespace CubbyFlow
 		FDMLinearSystem3 m_system;
 		FDMLinearSystemSolver3Ptr m_systemSolver;
 		Array3<char> m_markers;
+		Array3<char> m_lastMarkers;
+		Vector3D m_lastGridSpacing;
 
 		void BuildMarkers(
 			const Size3& size,
@@ -0,0 +1,158 @@
+/*************************************************************************
+> File Name: IISPHSolver3.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: 3-D implicit incompressible SPH solver.
+> Created Time: 2017/10/23
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_IISPH_SOLVER3_H
+#define CUBBYFLOW_IISPH_SOLVER3_H
+
+#include <SPH/SPHSolver3.h>
+
+namespace CubbyFlow
+{
+	//!
+	//! \brief 3-D implicit incompressible SPH (IISPH) solver.
+	//!
+	//! This class implements 3-D implicit incompressible SPH solver. Instead of
+	//! the equation-of-state or the predictor-corrector loop, the pressure is
+	//! obtained by solving the discretized pressure Poisson equation with the
+	//! relaxed Jacobi method. The residual of each iteration is the density at
+	//! the positions predicted with the current pressure, including the
+	//! collider response, so the iteration converges on the same density error
+	//! that SPHSystemData3::UpdateDensities measures after the time-step. Since
+	//! the pressure is not driven by the speed of sound, the time-step is
+	//! bounded by the CFL condition and the force limit only, which allows
+	//! larger time-steps than SPHSolver3 or PCISPHSolver3.
+	//!
+	//! \see Ihmsen et al., Implicit incompressible SPH, IEEE transactions on
+	//!      visualization and computer graphics 20.3 (2014): 426-435.
+	//!
+	class IISPHSolver3 : public SPHSolver3
+	{
+	public:
+		class Builder;
+
+		//! Constructs a solver with empty particle set.
+		IISPHSolver3();
+
+		//! Constructs a solver with target density, spacing, and relative kernel radius.
+		IISPHSolver3(double targetDensity, double targetSpacing, double relativeKernelRadius);
+
+		virtual ~IISPHSolver3();
+
+		//! Returns max allowed average density error ratio.
+		double GetMaxDensityErrorRatio() const;
+
+		//!
+		//! \brief Sets max allowed average density error ratio.
+		//!
+		//! This function sets the max allowed average compression of the fluid
+		//! relative to the target density. The Jacobi iteration stops once the
+		//! average density error ratio falls below this value. Default is 0.001
+		//! (0.1%). The input value should be positive.
+		//!
+		void SetMaxDensityErrorRatio(double ratio);
+
+		//! Returns the minimum number of iterations.
+		unsigned int GetMinNumberOfIterations() const;
+
+		//!
+		//! \brief Sets the minimum number of Jacobi iterations.
+		//!
+		//! This function sets the minimum number of Jacobi iterations performed
+		//! before checking the convergence. Default is 2.
+		//!
+		void SetMinNumberOfIterations(unsigned int n);
+
+		//! Returns max number of iterations.
+		unsigned int GetMaxNumberOfIterations() const;
+
+		//!
+		//! \brief Sets max number of Jacobi iterations.
+		//!
+		//! This function sets the max number of Jacobi iterations. Default is 100.
+		//!
+		void SetMaxNumberOfIterations(unsigned int n);
+
+		//! Returns the relaxation factor of the Jacobi iteration.
+		double GetRelaxationFactor() const;
+
+		//!
+		//! \brief Sets the relaxation factor of the Jacobi iteration.
+		//!
+		//! This function sets the relaxation factor of the relaxed Jacobi
+		//! iteration. The input will be clamped within (0, 1]. Default is 0.5.
+		//!
+		void SetRelaxationFactor(double factor);
+
+		//! Returns max allowed CFL number.
+		double GetMaxCFL() const;
+
+		//!
+		//! \brief Sets max allowed CFL number.
+		//!
+		//! This function sets the max allowed CFL number which limits the
+		//! time-step so that the fastest particle does not travel more than the
+		//! given fraction of the particle spacing. Default is 0.4.
+		//!
+		void SetMaxCFL(double newCFL);
+
+		//! Returns the number of iterations taken at the last time-step.
+		unsigned int GetLastNumberOfIterations() const;
+
+		//! Returns the average density error ratio at the last time-step.
+		double GetLastDensityErrorRatio() const;
+
+		//! Returns builder fox IISPHSolver3.
+		static Builder GetBuilder();
+
+	protected:
+		//! Returns the number of sub-time-steps based on the CFL condition.
+		unsigned int NumberOfSubTimeSteps(double timeIntervalInSeconds) const override;
+
+		//! Accumulates the pressure force to the forces array in the particle system.
+		void AccumulatePressureForce(double timeIntervalInSeconds) override;
+
+		//! Performs pre-processing step before the simulation.
+		void OnBeginAdvanceTimeStep(double timeStepInSeconds) override;
+
+	private:
+		double m_maxDensityErrorRatio = 0.001;
+		unsigned int m_minNumberOfIterations = 2;
+		unsigned int m_maxNumberOfIterations = 100;
+		double m_relaxationFactor = 0.5;
+		double m_maxCFL = 0.4;
+
+		unsigned int m_lastNumberOfIterations = 0;
+		double m_lastDensityErrorRatio = 0.0;
+
+		ParticleSystemData3::VectorData m_advectedVelocities;
+		ParticleSystemData3::VectorData m_dii;
+		ParticleSystemData3::VectorData m_sumDijPj;
+		ParticleSystemData3::VectorData m_predictedVelocities;
+		ParticleSystemData3::VectorData m_predictedPositions;
+		ParticleSystemData3::ScalarData m_aii;
+		ParticleSystemData3::ScalarData m_newPressures;
+	};
+
+	//! Shared pointer type for the IISPHSolver3.
+	using IISPHSolver3Ptr = std::shared_ptr<IISPHSolver3>;
+
+	//!
+	//! \brief Front-end to create IISPHSolver3 objects step by step.
+	//!
+	class IISPHSolver3::Builder final : public SPHSolverBuilderBase3<IISPHSolver3::Builder>
+	{
+	public:
+		//! Builds IISPHSolver3.
+		IISPHSolver3 Build() const;
+
+		//! Builds shared pointer of IISPHSolver3 instance.
+		IISPHSolver3Ptr MakeShared() const;
+	};
+}
+
+#endif
@@ -27,6 +27,13 @@ namespace CubbyFlow
 			const Vector3D& gridSpacing,
 			size_t i, size_t j, size_t k,
 			std::array<double, 2>* dx, std::array<double, 2>* dy, std::array<double, 2>* dz) const override;
+
+		//! Computes the derivatives for a row of grid points.
+		void GetDerivativesOfRow(
+			ConstArrayAccessor3<double> grid,
+			const Vector3D& gridSpacing,
+			size_t iBegin, size_t iEnd, size_t j, size_t k,
+			std::array<double, 2>* dx, std::array<double, 2>* dy, std::array<double, 2>* dz) const override;
 	};
 }
 
@@ -0,0 +1,80 @@
+/*************************************************************************
+> File Name: IterativeLevelSetSolver3-Impl.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Abstract base class for 3-D PDE-based iterative level set solver.
+> Created Time: 2017/10/30
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_ITERATIVE_LEVEL_SET_SOLVER3_IMPL_H
+#define CUBBYFLOW_ITERATIVE_LEVEL_SET_SOLVER3_IMPL_H
+
+namespace CubbyFlow
+{
+	template <size_t Radius, typename Scheme>
+	void IterativeLevelSetSolver3::GetDerivativesOfRowWithScheme(
+		const ConstArrayAccessor3<double>& grid,
+		const Vector3D& gridSpacing,
+		size_t iBegin, size_t iEnd, size_t j, size_t k,
+		const Scheme& scheme,
+		std::array<double, 2>* dx, std::array<double, 2>* dy, std::array<double, 2>* dz)
+	{
+		constexpr size_t width = 2 * Radius + 1;
+
+		const Size3 size = grid.size();
+		const double* data = grid.data();
+		const size_t sliceSize = size.x * size.y;
+
+		// Offsets of the clamped neighbors along y and z are shared by the row
+		size_t offsetsJ[width];
+		size_t offsetsK[width];
+
+		for (size_t s = 0; s < width; ++s)
+		{
+			const size_t jj = (j + s < Radius) ? 0 : std::min(j + s - Radius, size.y - 1);
+			const size_t kk = (k + s < Radius) ? 0 : std::min(k + s - Radius, size.z - 1);
+
+			offsetsJ[s] = k * sliceSize + jj * size.x;
+			offsetsK[s] = kk * sliceSize + j * size.x;
+		}
+
+		const double* row = data + k * sliceSize + j * size.x;
+		double d0[width];
+
+		for (size_t i = iBegin; i < iEnd; ++i)
+		{
+			if (i >= Radius && i + Radius < size.x)
+			{
+				for (size_t s = 0; s < width; ++s)
+				{
+					d0[s] = row[i + s - Radius];
+				}
+			}
+			else
+			{
+				for (size_t s = 0; s < width; ++s)
+				{
+					d0[s] = row[(i + s < Radius) ? 0 : std::min(i + s - Radius, size.x - 1)];
+				}
+			}
+
+			dx[i - iBegin] = scheme(d0, gridSpacing.x);
+
+			for (size_t s = 0; s < width; ++s)
+			{
+				d0[s] = data[offsetsJ[s] + i];
+			}
+
+			dy[i - iBegin] = scheme(d0, gridSpacing.y);
+
+			for (size_t s = 0; s < width; ++s)
+			{
+				d0[s] = data[offsetsK[s] + i];
+			}
+
+			dz[i - iBegin] = scheme(d0, gridSpacing.z);
+		}
+	}
+}
+
+#endif
\ No newline at end of file
@@ -21,6 +21,11 @@ namespace CubbyFlow
 	//! the inheriting classes must provide a way to compute the derivatives for
 	//! given grid points.
 	//!
+	//! Reinitialization works on tiles of 8x8x8 cells. Only the tiles within
+	//! the max distance from the interface are updated, and a tile is skipped
+	//! once its values change less than the convergence tolerance per unit
+	//! pseudo-time, until one of its neighbors changes again.
+	//!
 	//! \see Osher, Stanley, and Ronald Fedkiw. Level set methods and dynamic
 	//!     implicit surfaces. Vol. 153. Springer Science & Business Media, 2006.
 	//!
@@ -100,6 +105,19 @@ namespace CubbyFlow
 		//!
 		void SetMaxCFL(double newMaxCFL);
 
+		//! Returns the convergence tolerance of a tile during reinitialization.
+		double GetConvergenceTolerance() const;
+
+		//!
+		//! \brief Sets the convergence tolerance of a tile during reinitialization.
+		//!
+		//! A tile stops being updated once the max change of its values per
+		//! unit pseudo-time falls below this tolerance. Zero keeps updating the
+		//! tiles near the interface until the values stop changing at all. The
+		//! negative input will be clamped to 0.
+		//!
+		void SetConvergenceTolerance(double newTolerance);
+
 	protected:
 		//! Computes the derivatives for given grid point.
 		virtual void GetDerivatives(
@@ -108,8 +126,43 @@ namespace CubbyFlow
 			size_t i, size_t j, size_t k,
 			std::array<double, 2>* dx, std::array<double, 2>* dy, std::array<double, 2>* dz) const = 0;
 
+		//!
+		//! \brief Computes the derivatives for the grid points from (\p iBegin,
+		//!        \p j, \p k) to (\p iEnd - 1, \p j, \p k).
+		//!
+		//! The derivatives of the i-th point are stored in dx[i - iBegin],
+		//! dy[i - iBegin], and dz[i - iBegin]. The default implementation calls
+		//! GetDerivatives for each point. The inheriting classes can override
+		//! this function to evaluate the whole row without a virtual call per
+		//! point, for example using GetDerivativesOfRowWithScheme.
+		//!
+		virtual void GetDerivativesOfRow(
+			ConstArrayAccessor3<double> grid,
+			const Vector3D& gridSpacing,
+			size_t iBegin, size_t iEnd, size_t j, size_t k,
+			std::array<double, 2>* dx, std::array<double, 2>* dy, std::array<double, 2>* dz) const;
+
+		//!
+		//! \brief Computes the derivatives for a row of grid points using a
+		//!        one-dimensional scheme of given radius.
+		//!
+		//! \p scheme is invoked as scheme(d0, h) with 2 * Radius + 1 values
+		//! along an axis centered at the grid point, clamped at the boundary,
+		//! and returns the backward and forward derivatives such as Upwind1 or
+		//! ENO3.
+		//!
+		template <size_t Radius, typename Scheme>
+		static void GetDerivativesOfRowWithScheme(
+			const ConstArrayAccessor3<double>& grid,
+			const Vector3D& gridSpacing,
+			size_t iBegin, size_t iEnd, size_t j, size_t k,
+			const Scheme& scheme,
+			std::array<double, 2>* dx, std::array<double, 2>* dy, std::array<double, 2>* dz);
+
 	private:
 		double m_maxCFL = 0.5;
+		double m_convergenceTolerance = 1e-6;
+		Array3<double> m_temp;
 
 		void Extrapolate(
 			const ConstArrayAccessor3<double>& input,
@@ -131,4 +184,6 @@ namespace CubbyFlow
 	};
 }
 
+#include <Solver/LevelSet/IterativeLevelSetSolver3-Impl.h>
+
 #endif
\ No newline at end of file
@@ -11,6 +11,8 @@
 
 #include <SPH/SPHSolver3.h>
 
+#include <vector>
+
 namespace CubbyFlow
 {
 	//!
@@ -56,6 +58,31 @@ namespace CubbyFlow
 		//!
 		void SetMaxNumberOfIterations(unsigned int n);
 
+		//! Returns the interval of the convergence check.
+		unsigned int GetConvergenceCheckInterval() const;
+
+		//!
+		//! \brief Sets the interval of the convergence check.
+		//!
+		//! This function sets how often the density error is compared against
+		//! the threshold. With the value n, the iteration stops early only at
+		//! every n-th iteration. Default is 1. The input will be clamped to 1 or
+		//! larger.
+		//!
+		void SetConvergenceCheckInterval(unsigned int n);
+
+		//! Returns the number of iterations taken at the last time-step.
+		unsigned int GetLastNumberOfIterations() const;
+
+		//! Returns the max density error ratio at the last time-step.
+		double GetLastDensityErrorRatio() const;
+
+		//! Returns the max density error ratio of each iteration at the last time-step.
+		const std::vector<double>& GetLastDensityErrorRatios() const;
+
+		//! Returns the elapsed time in seconds of each iteration at the last time-step.
+		const std::vector<double>& GetLastIterationTimes() const;
+
 		//! Returns builder fox PCISPHSolver3.
 		static Builder GetBuilder();
 
@@ -69,11 +96,17 @@ namespace CubbyFlow
 	private:
 		double m_maxDensityErrorRatio = 0.01;
 		unsigned int m_maxNumberOfIterations = 5;
+		unsigned int m_convergenceCheckInterval = 1;
+
+		unsigned int m_lastNumberOfIterations = 0;
+		double m_lastDensityErrorRatio = 0.0;
+		std::vector<double> m_lastDensityErrorRatios;
+		std::vector<double> m_lastIterationTimes;
 
 		ParticleSystemData3::VectorData m_tempPositions;
 		ParticleSystemData3::VectorData m_tempVelocities;
 		ParticleSystemData3::VectorData m_pressureForces;
-		ParticleSystemData3::ScalarData m_densityErrors;
+		ParticleSystemData3::ScalarData m_predictedDensities;
 
 		double ComputeDelta(double timeStepInSeconds) const;
 		double ComputeBeta(double timeStepInSeconds) const;
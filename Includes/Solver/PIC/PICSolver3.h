@@ -74,6 +74,12 @@ namespace CubbyFlow
 		//! Returns the signed-distance field of the fluid.
 		ScalarField3Ptr GetFluidSDF() const override;
 
+		//! Writes the solver state to the checkpoint.
+		void OnSaveCheckpoint(CheckpointWriter* writer) const override;
+
+		//! Restores the solver state from the checkpoint.
+		void OnLoadCheckpoint(const CheckpointReader& reader) override;
+
 		//! Transfers velocity field from particles to grids.
 		virtual void TransferFromParticlesToGrids();
 
@@ -123,6 +123,12 @@ namespace CubbyFlow
 		//! Called to advance a single time-step.
 		void OnAdvanceTimeStep(double timeStepInSeconds) override;
 
+		//! Writes the solver state to the checkpoint.
+		void OnSaveCheckpoint(CheckpointWriter* writer) const override;
+
+		//! Restores the solver state from the checkpoint.
+		void OnLoadCheckpoint(const CheckpointReader& reader) override;
+
 		//! Accumulates forces applied to the particles.
 		virtual void AccumulateForces(double timeStepInSeconds);
 
@@ -9,6 +9,7 @@
 #ifndef CUBBYFLOW_GRID_SMOKE_SOLVER3_H
 #define CUBBYFLOW_GRID_SMOKE_SOLVER3_H
 
+#include <Grid/CellCenteredScalarGrid3.h>
 #include <Solver/Grid/GridFluidSolver3.h>
 
 namespace CubbyFlow
@@ -176,6 +177,7 @@ namespace CubbyFlow
 		double m_buoyancyTemperatureFactor = 5.0;
 		double m_smokeDecayFactor = 0.001;
 		double m_temperatureDecayFactor = 0.001;
+		CellCenteredScalarGrid3 m_scratch;
 
 		void ComputeDiffusion(double timeIntervalInSeconds);
 
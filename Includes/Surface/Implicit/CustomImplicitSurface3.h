@@ -9,6 +9,7 @@
 #ifndef CUBBYFLOW_CUSTOM_IMPLICIT_SURFACE3_H
 #define CUBBYFLOW_CUSTOM_IMPLICIT_SURFACE3_H
 
+#include <Geometry/AdaptiveDistanceField3.h>
 #include <Surface/Implicit/ImplicitSurface3.h>
 
 #include <functional>
@@ -44,6 +45,28 @@ namespace CubbyFlow
 		//! Destructor.
 		virtual ~CustomImplicitSurface3();
 
+		//!
+		//! \brief Bakes the SDF into an adaptive distance field.
+		//!
+		//! Once baked, the distance, gradient, closest point, normal, and ray
+		//! queries within the domain are answered from an octree that stores
+		//! the distances and gradients at the corners of its cells, instead of
+		//! evaluating the function. This is beneficial when the function is
+		//! expensive (e.g., a mesh distance) and queried many times, such as
+		//! for colliders. The domain must be bounded.
+		//!
+		//! \param maxDepth Max depth of the octree which bounds the memory and
+		//!                 the build cost.
+		//! \param tolerance Max allowed interpolation error of the distance.
+		//!
+		void BakeDistanceField(unsigned int maxDepth = 8, double tolerance = 1e-3);
+
+		//! Returns true if the SDF is baked.
+		bool IsDistanceFieldBaked() const;
+
+		//! Returns the baked SDF, or nullptr if the SDF is not baked.
+		const AdaptiveDistanceField3Ptr& GetBakedDistanceField() const;
+
 		//! Returns builder for CustomImplicitSurface3.
 		static Builder GetBuilder();
 
@@ -53,6 +76,7 @@ namespace CubbyFlow
 		double m_resolution = 1e-3;
 		double m_rayMarchingResolution = 1e-6;
 		unsigned int m_maxNumberOfIterations = 5;
+		AdaptiveDistanceField3Ptr m_bakedField;
 
 		Vector3D ClosestPointLocal(const Vector3D& otherPoint) const override;
 
@@ -94,6 +118,9 @@ namespace CubbyFlow
 		//! Returns builder with number of iterations for closest point/normal searches.
 		Builder& WithMaxNumberOfIterations(unsigned int numIter);
 
+		//! Returns builder with the SDF baked into an adaptive distance field.
+		Builder& WithBakedDistanceField(unsigned int maxDepth = 8, double tolerance = 1e-3);
+
 		//! Builds CustomImplicitSurface3.
 		CustomImplicitSurface3 Build() const;
 
@@ -106,6 +133,9 @@ namespace CubbyFlow
 		double m_resolution = 1e-3;
 		double m_rayMarchingResolution = 1e-6;
 		unsigned int m_maxNumberOfIterations = 5;
+		bool m_isDistanceFieldBaked = false;
+		unsigned int m_bakingMaxDepth = 8;
+		double m_bakingTolerance = 1e-3;
 	};
 }
 
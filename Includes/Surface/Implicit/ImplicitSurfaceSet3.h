@@ -10,6 +10,7 @@
 #define CUBBYFLOW_IMPLICIT_SURFACE_SET3_H
 
 #include <Geometry/BVH3.h>
+#include <Grid/ScalarGrid3.h>
 #include <Surface/Implicit/ImplicitSurface3.h>
 
 #include <vector>
@@ -23,6 +24,17 @@ namespace CubbyFlow
 	//! ImplicitSurface3 by overriding implicit surface-related queries. This is
 	//! class can hold a collection of other implicit surface instances.
 	//!
+	//! The signed distance is the minimum of the child signed distances. Child
+	//! surfaces are pruned using the bounding volume hierarchy, so only the
+	//! surfaces whose bounding boxes are closer than the current minimum are
+	//! evaluated. This requires the signed distance of a child to be positive
+	//! and not less than the distance to its bounding box outside of the box,
+	//! which holds for closed surfaces. Only spheres, boxes, cylinders, triangle
+	//! meshes (assumed to be closed) and sets of them are pruned; the other
+	//! children, including unbounded or inverted (normal-flipped) ones, are
+	//! always evaluated. Call
+	//! ImplicitSurfaceSet3::UpdateQueryEngine after moving the child surfaces.
+	//!
 	class ImplicitSurfaceSet3 final : public ImplicitSurface3
 	{
 	public:
@@ -58,6 +70,19 @@ namespace CubbyFlow
 		//! Adds an implicit surface instance.
 		void AddSurface(const ImplicitSurface3Ptr& surface);
 
+		//!
+		//! \brief Evaluates the signed distance for every data point of \p grid.
+		//!
+		//! This function processes the data points in tiles. For each tile, the
+		//! child surfaces which cannot contain the minimum for any point in the
+		//! tile are culled once, and the remaining surfaces are evaluated for
+		//! every point of the tile.
+		//!
+		void FillSignedDistance(ScalarGrid3* grid) const;
+
+		//! Updates the child surfaces and rebuilds the bounding volume hierarchy.
+		void UpdateQueryEngine() override;
+
 		//! Returns builder for ImplicitSurfaceSet3.
 		static Builder GetBuilder();
 
@@ -65,6 +90,9 @@ namespace CubbyFlow
 		std::vector<ImplicitSurface3Ptr> m_surfaces;
 		mutable BVH3<ImplicitSurface3Ptr> m_bvh;
 		mutable bool m_bvhInvalidated = true;
+		mutable std::vector<BoundingBox3D> m_surfaceBounds;
+		mutable std::vector<char> m_isBoundedSurface;
+		mutable std::vector<size_t> m_unboundedSurfaces;
 
 		// Surface3 implementations.
 		Vector3D ClosestPointLocal(const Vector3D& otherPoint) const override;
@@ -82,6 +110,8 @@ namespace CubbyFlow
 		// ImplicitSurface3 implementations.
 		double SignedDistanceLocal(const Vector3D& otherPoint) const override;
 
+		double BoundedSignedDistanceLocal(const Vector3D& otherPoint) const;
+
 		void InvalidateBVH() const;
 
 		void BuildBVH() const;
@@ -41,6 +41,9 @@ namespace CubbyFlow
 		//! Returns the raw surface instance.
 		Surface3Ptr GetSurface() const;
 
+		//! Updates the query engine of the raw surface.
+		void UpdateQueryEngine() override;
+
 		//! Returns builder for SurfaceToImplicit3.
 		static Builder GetBuilder();
 
@@ -79,7 +82,7 @@ namespace CubbyFlow
 		SurfaceToImplicit3 Build() const;
 
 		//! Builds shared pointer of SurfaceToImplicit3 instance.
-		SurfaceToImplicit3 MakeShared() const;
+		SurfaceToImplicit3Ptr MakeShared() const;
 	private:
 		Surface3Ptr m_surface;
 	};
@@ -69,6 +69,15 @@ namespace CubbyFlow
 		//! point \p otherPoint.
 		Vector3D ClosestNormal(const Vector3D& otherPoint) const;
 
+		//!
+		//! \brief Updates internal spatial query engine.
+		//!
+		//! Surfaces which accelerate the queries with a spatial data structure
+		//! (such as SurfaceSet3) rebuild the structure when this function is
+		//! called. Call this function after moving the child surfaces.
+		//!
+		virtual void UpdateQueryEngine();
+
 	protected:
 		//! Returns the closest point from the given point \p otherPoint to the
 		//! surface in local frame.
@@ -49,6 +49,16 @@ namespace CubbyFlow
 		//! Adds a surface instance.
 		void AddSurface(const Surface3Ptr& surface);
 
+		//!
+		//! \brief Returns the index of the surface closest to \p otherPoint.
+		//!
+		//! Returns std::numeric_limits<size_t>::max() if the set is empty.
+		//!
+		size_t ClosestSurfaceIndex(const Vector3D& otherPoint) const;
+
+		//! Updates the child surfaces and rebuilds the bounding volume hierarchy.
+		void UpdateQueryEngine() override;
+
 		//! Returns builder for SurfaceSet3.
 		static Builder GetBuilder();
 
@@ -9,6 +9,7 @@
 #ifndef CUBBYFLOW_TRANSFORM3_H
 #define CUBBYFLOW_TRANSFORM3_H
 
+#include <Array/ArrayAccessor1.h>
 #include <BoundingBox/BoundingBox3.h>
 #include <Math/Quaternion.h>
 #include <Ray/Ray3.h>
@@ -52,6 +53,8 @@ namespace CubbyFlow
 		//! Transforms a bounding box in world coordinate to the local frame.
 		BoundingBox3D ToLocal(const BoundingBox3D& bboxInWorld) const;
 
+		void ToLocal(const ConstArrayAccessor1<Vector3D>& pointsInWorld, ArrayAccessor1<Vector3D>* pointsInLocal) const;
+
 		//! Transforms a point in local space to the world coordinate.
 		Vector3D ToWorld(const Vector3D& pointInLocal) const;
 
@@ -64,6 +67,8 @@ namespace CubbyFlow
 		//! Transforms a bounding box in local space to the world coordinate.
 		BoundingBox3D ToWorld(const BoundingBox3D& bboxInLocal) const;
 
+		void ToWorld(const ConstArrayAccessor1<Vector3D>& pointsInLocal, ArrayAccessor1<Vector3D>* pointsInWorld) const;
+
 	private:
 		Vector3D m_translation;
 		QuaternionD m_orientation;
@@ -0,0 +1,95 @@
+/*************************************************************************
+> File Name: AlignedAllocator.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Standard allocator returning cache-line aligned storage.
+> Created Time: 2017/10/31
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_ALIGNED_ALLOCATOR_H
+#define CUBBYFLOW_ALIGNED_ALLOCATOR_H
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+namespace CubbyFlow
+{
+	//! Default alignment of AlignedAllocator, which is the cache line size.
+	constexpr size_t DEFAULT_ALIGNMENT = 64;
+
+	//!
+	//! \brief Allocates \p size bytes aligned to \p alignment.
+	//!
+	//! \p alignment must be a power of two multiple of sizeof(void*). Throws
+	//! std::bad_alloc if the allocation fails.
+	//!
+	void* AlignedMalloc(size_t size, size_t alignment);
+
+	//! Frees the memory allocated by AlignedMalloc.
+	void AlignedFree(void* ptr);
+
+	//!
+	//! \brief Standard allocator returning cache-line aligned storage.
+	//!
+	//! The containers using this allocator start on a cache line, so the
+	//! SIMD loops over them (see Vector3Kernels) need no peeling and a chunk
+	//! of elements never shares its first line with another allocation.
+	//!
+	//! \tparam T         Value type.
+	//! \tparam Alignment Alignment in bytes.
+	//!
+	template <typename T, size_t Alignment = DEFAULT_ALIGNMENT>
+	class AlignedAllocator
+	{
+	public:
+		static_assert(Alignment >= alignof(T), "Alignment must not be smaller than the alignment of the value type.");
+
+		using value_type = T;
+
+		template <typename U>
+		struct rebind
+		{
+			using other = AlignedAllocator<U, Alignment>;
+		};
+
+		AlignedAllocator() = default;
+
+		template <typename U>
+		AlignedAllocator(const AlignedAllocator<U, Alignment>&)
+		{
+			// Do nothing
+		}
+
+		//! Allocates storage for \p n values.
+		T* allocate(size_t n)
+		{
+			if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+			{
+				throw std::bad_alloc();
+			}
+
+			return static_cast<T*>(AlignedMalloc(n * sizeof(T), Alignment));
+		}
+
+		//! Frees the storage allocated by allocate.
+		void deallocate(T* ptr, size_t)
+		{
+			AlignedFree(ptr);
+		}
+
+		template <typename U>
+		bool operator==(const AlignedAllocator<U, Alignment>&) const
+		{
+			return true;
+		}
+
+		template <typename U>
+		bool operator!=(const AlignedAllocator<U, Alignment>&) const
+		{
+			return false;
+		}
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,98 @@
+/*************************************************************************
+> File Name: Checkpoint-Impl.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Streaming checkpoint writer and memory-mapped checkpoint reader.
+> Created Time: 2017/10/21
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_CHECKPOINT_IMPL_H
+#define CUBBYFLOW_CHECKPOINT_IMPL_H
+
+#include <cstring>
+#include <type_traits>
+
+namespace CubbyFlow
+{
+	template <typename T>
+	void CheckpointWriter::WriteValue(const std::string& name, const T& value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Checkpoint values must be trivially copyable.");
+
+		WriteChunk(name, &value, sizeof(T));
+	}
+
+	template <typename T>
+	void CheckpointWriter::WriteArray(const std::string& name, const ConstArrayAccessor1<T>& array)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Checkpoint arrays must be trivially copyable.");
+
+		WriteChunk(name, array.data(), sizeof(T) * array.size());
+	}
+
+	template <typename T>
+	void CheckpointWriter::WriteArray(const std::string& name, const ConstArrayAccessor3<T>& array)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Checkpoint arrays must be trivially copyable.");
+
+		const Size3 size = array.size();
+		WriteChunk(name, array.data(), sizeof(T) * size.x * size.y * size.z);
+	}
+
+	template <typename T>
+	void CheckpointReader::ReadValue(const std::string& name, T* value) const
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Checkpoint values must be trivially copyable.");
+
+		CheckChunkSize(name, sizeof(T));
+		memcpy(static_cast<void*>(value), m_data + FindChunk(name).offset, sizeof(T));
+	}
+
+	template <typename T>
+	ConstArrayAccessor1<T> CheckpointReader::ViewArray(const std::string& name) const
+	{
+		const Chunk& chunk = FindChunk(name);
+		return ConstArrayAccessor1<T>(
+			static_cast<size_t>(chunk.size / sizeof(T)),
+			reinterpret_cast<const T*>(m_data + chunk.offset));
+	}
+
+	template <typename T>
+	void CheckpointReader::ReadArray(const std::string& name, Array1<T>* array) const
+	{
+		const Chunk& chunk = FindChunk(name);
+		array->Resize(static_cast<size_t>(chunk.size / sizeof(T)));
+		ReadArray(name, array->Accessor());
+	}
+
+	template <typename T>
+	void CheckpointReader::ReadArray(const std::string& name, ArrayAccessor1<T> array) const
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Checkpoint arrays must be trivially copyable.");
+
+		CheckChunkSize(name, sizeof(T) * array.size());
+
+		if (array.size() > 0)
+		{
+			memcpy(static_cast<void*>(array.data()), m_data + FindChunk(name).offset, sizeof(T) * array.size());
+		}
+	}
+
+	template <typename T>
+	void CheckpointReader::ReadArray(const std::string& name, ArrayAccessor3<T> array) const
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Checkpoint arrays must be trivially copyable.");
+
+		const Size3 size = array.size();
+		const size_t sizeInBytes = sizeof(T) * size.x * size.y * size.z;
+
+		CheckChunkSize(name, sizeInBytes);
+
+		if (sizeInBytes > 0)
+		{
+			memcpy(static_cast<void*>(array.data()), m_data + FindChunk(name).offset, sizeInBytes);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,183 @@
+/*************************************************************************
+> File Name: Checkpoint.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Streaming checkpoint writer and memory-mapped checkpoint reader.
+> Created Time: 2017/10/21
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_CHECKPOINT_H
+#define CUBBYFLOW_CHECKPOINT_H
+
+#include <Array/Array1.h>
+#include <Array/ArrayAccessor1.h>
+#include <Array/ArrayAccessor3.h>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CubbyFlow
+{
+	//!
+	//! \brief Writes named binary chunks to a checkpoint file.
+	//!
+	//! Unlike Serializable::Serialize, this class does not build an in-memory
+	//! buffer. Every chunk is streamed from the caller's memory straight to the
+	//! file, so checkpointing large particle or grid states does not increase
+	//! the peak memory usage. Each chunk is aligned to
+	//! CheckpointWriter::ChunkAlignment bytes so that CheckpointReader can expose
+	//! it as a typed array without copying. The table of chunks is written when
+	//! the writer is closed.
+	//!
+	//! The data is stored in the native byte order of the machine.
+	//!
+	class CheckpointWriter final
+	{
+	public:
+		//! Alignment of the chunk data in bytes.
+		static constexpr size_t ChunkAlignment = 64;
+
+		//! Opens (and truncates) the checkpoint file with given \p fileName.
+		explicit CheckpointWriter(const std::string& fileName);
+
+		//! Deleted copy constructor.
+		CheckpointWriter(const CheckpointWriter&) = delete;
+
+		//! Closes the file if not closed yet.
+		~CheckpointWriter();
+
+		//! Deleted copy assignment operator.
+		CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+		//! Returns true if the file is successfully opened.
+		bool IsOpen() const;
+
+		//! Writes \p sizeInBytes bytes of \p data as a chunk named \p name.
+		void WriteChunk(const std::string& name, const void* data, size_t sizeInBytes);
+
+		//! Writes a single trivially copyable value.
+		template <typename T>
+		void WriteValue(const std::string& name, const T& value);
+
+		//! Writes 1-D array data without copying.
+		template <typename T>
+		void WriteArray(const std::string& name, const ConstArrayAccessor1<T>& array);
+
+		//! Writes 3-D array data without copying.
+		template <typename T>
+		void WriteArray(const std::string& name, const ConstArrayAccessor3<T>& array);
+
+		//! Writes a string.
+		void WriteString(const std::string& name, const std::string& str);
+
+		//! Writes the chunk table and closes the file.
+		void Close();
+
+	private:
+		struct Entry
+		{
+			std::string name;
+			uint64_t offset;
+			uint64_t size;
+		};
+
+		std::ofstream m_file;
+		uint64_t m_offset = 0;
+		std::vector<Entry> m_entries;
+	};
+
+	//!
+	//! \brief Reads a checkpoint file written by CheckpointWriter.
+	//!
+	//! The whole file is memory-mapped, and the chunks are accessed directly from
+	//! the mapped pages. CheckpointReader::ViewArray returns a zero-copy view,
+	//! and CheckpointReader::ReadArray copies the chunk straight into the
+	//! destination array. The views are valid while the reader is alive.
+	//!
+	//! Missing chunks or chunks with mismatching sizes throw
+	//! std::runtime_error.
+	//!
+	class CheckpointReader final
+	{
+	public:
+		//! Memory-maps the checkpoint file with given \p fileName.
+		explicit CheckpointReader(const std::string& fileName);
+
+		//! Deleted copy constructor.
+		CheckpointReader(const CheckpointReader&) = delete;
+
+		//! Unmaps the file.
+		~CheckpointReader();
+
+		//! Deleted copy assignment operator.
+		CheckpointReader& operator=(const CheckpointReader&) = delete;
+
+		//! Returns true if the file is successfully mapped and has a valid chunk table.
+		bool IsOpen() const;
+
+		//! Returns true if the checkpoint contains a chunk named \p name.
+		bool HasChunk(const std::string& name) const;
+
+		//! Returns the size of the chunk in bytes.
+		size_t ChunkSize(const std::string& name) const;
+
+		//! Returns the pointer to the mapped chunk data.
+		const uint8_t* ChunkData(const std::string& name) const;
+
+		//! Reads a single trivially copyable value.
+		template <typename T>
+		void ReadValue(const std::string& name, T* value) const;
+
+		//! Returns a zero-copy view of 1-D array data.
+		template <typename T>
+		ConstArrayAccessor1<T> ViewArray(const std::string& name) const;
+
+		//! Resizes \p array and copies the chunk into it.
+		template <typename T>
+		void ReadArray(const std::string& name, Array1<T>* array) const;
+
+		//! Copies the chunk into the array with the same size.
+		template <typename T>
+		void ReadArray(const std::string& name, ArrayAccessor1<T> array) const;
+
+		//! Copies the chunk into the 3-D array with the same size.
+		template <typename T>
+		void ReadArray(const std::string& name, ArrayAccessor3<T> array) const;
+
+		//! Reads a string.
+		std::string ReadString(const std::string& name) const;
+
+	private:
+		struct Chunk
+		{
+			uint64_t offset;
+			uint64_t size;
+		};
+
+		const uint8_t* m_data = nullptr;
+		size_t m_size = 0;
+		std::unordered_map<std::string, Chunk> m_chunks;
+
+#ifdef _WIN32
+		void* m_fileHandle = nullptr;
+		void* m_mappingHandle = nullptr;
+#else
+		int m_fileDescriptor = -1;
+#endif
+
+		const Chunk& FindChunk(const std::string& name) const;
+
+		void CheckChunkSize(const std::string& name, size_t expectedSize) const;
+
+		void ParseChunkTable();
+
+		void Unmap();
+	};
+}
+
+#include <Utils/Checkpoint-Impl.h>
+
+#endif
@@ -0,0 +1,90 @@
+/*************************************************************************
+> File Name: PageStorage.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Fixed-size memory pages on the heap or in a memory-mapped file.
+> Created Time: 2017/10/27
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_PAGE_STORAGE_H
+#define CUBBYFLOW_PAGE_STORAGE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace CubbyFlow
+{
+	//!
+	//! \brief Memory pages committed on demand within a reserved address range.
+	//!
+	//! The storage reserves a contiguous range of address space up front and
+	//! commits it page by page as it grows, so the committed memory is always
+	//! contiguous and never moves. When a backing directory is given, the
+	//! pages are shared mappings of a scratch file created in that directory.
+	//! The operating system can then write cold pages back to the file and
+	//! drop them from RAM instead of swapping. The scratch file is removed
+	//! when the storage is destroyed (or when the process exits).
+	//!
+	class PageStorage final
+	{
+	public:
+		//! Reserves at least \p reservedSizeInBytes bytes of address space for
+		//! the pages on the heap, or in a scratch file within
+		//! \p backingDirectory. Throws std::runtime_error on failure.
+		explicit PageStorage(size_t reservedSizeInBytes, const std::string& backingDirectory = "");
+
+		//! Deleted copy constructor.
+		PageStorage(const PageStorage&) = delete;
+
+		//! Releases all pages and the reserved address range.
+		~PageStorage();
+
+		//! Deleted copy assignment operator.
+		PageStorage& operator=(const PageStorage&) = delete;
+
+		//! Returns the size of a page in bytes.
+		size_t PageSize() const;
+
+		//! Returns the number of committed pages.
+		size_t NumberOfPages() const;
+
+		//! Returns the size of the reserved address range in bytes.
+		size_t ReservedSize() const;
+
+		//! Returns the size of the committed pages in bytes.
+		size_t CommittedSize() const;
+
+		//! Returns true if the pages are mapped from a scratch file.
+		bool IsFileBacked() const;
+
+		//! Returns the directory of the scratch file, or empty string.
+		const std::string& BackingDirectory() const;
+
+		//! Returns the beginning of the reserved address range.
+		void* Data() const;
+
+		//!
+		//! Commits the pages covering the first \p sizeInBytes bytes. Throws
+		//! std::length_error if they exceed the reserved range, and
+		//! std::runtime_error if the pages cannot be committed.
+		//!
+		void Commit(size_t sizeInBytes);
+
+	private:
+		std::string m_backingDirectory;
+		size_t m_reservedSize = 0;
+		size_t m_committedSize = 0;
+		char* m_data = nullptr;
+
+#ifdef _WIN32
+		void* m_fileHandle = nullptr;
+#else
+		int m_fileDescriptor = -1;
+#endif
+
+		void Release();
+	};
+}
+
+#endif
\ No newline at end of file
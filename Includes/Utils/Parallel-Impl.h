@@ -81,8 +81,14 @@ namespace CubbyFlow
 				std::vector<std::thread> pool;
 				pool.reserve(2);
 
-				auto launchRange = [compareFunction](RandomIterator begin, size_t k2, RandomIterator2 temp, unsigned int numThreads)
+				const bool isLimited = GetMaxNumberOfThreadsForCurrentThread() != 0u;
+				auto launchRange = [compareFunction, isLimited](RandomIterator begin, size_t k2, RandomIterator2 temp, unsigned int numThreads)
 				{
+					if (isLimited)
+					{
+						SetMaxNumberOfThreadsForCurrentThread(1u);
+					}
+
 					ParallelMergeSort(begin, k2, temp, numThreads, compareFunction);
 				};
 
@@ -129,17 +135,24 @@ namespace CubbyFlow
 		}
 
 		// Estimate number of threads in the pool
-		static const unsigned int numThreadsHint = std::thread::hardware_concurrency();
-		static const unsigned int numThreads = (numThreadsHint == 0u ? 8u : numThreadsHint);
+		const unsigned int numThreads = GetMaxNumberOfThreads();
 
 		// Size of a slice for the range functions
 		IndexType n = endIndex - beginIndex + 1;
 		IndexType slice = static_cast<IndexType>(std::round(n / static_cast<double>(numThreads)));
 		slice = std::max(slice, IndexType(1));
 
+		// Nested loops of the workers must stay within the limit of this thread
+		const bool isLimited = GetMaxNumberOfThreadsForCurrentThread() != 0u;
+
 		// [Helper] Inner loop
-		auto launchRange = [&function](IndexType k1, IndexType k2)
+		auto launchRange = [&function, isLimited](IndexType k1, IndexType k2)
 		{
+			if (isLimited)
+			{
+				SetMaxNumberOfThreadsForCurrentThread(1u);
+			}
+
 			for (IndexType k = k1; k < k2; ++k)
 			{
 				function(k);
@@ -217,8 +230,7 @@ namespace CubbyFlow
 		}
 		
 		// Estimate number of threads in the pool
-		static const unsigned int numThreadsHint = std::thread::hardware_concurrency();
-		static const unsigned int numThreads = (numThreadsHint == 0u ? 8u : numThreadsHint);
+		const unsigned int numThreads = GetMaxNumberOfThreads();
 		
 		// Size of a slice for the range functions
 		IndexType n = end - start + 1;
@@ -228,9 +240,17 @@ namespace CubbyFlow
 		// Results
 		std::vector<Value> results(numThreads, identity);
 		
+		// Nested loops of the workers must stay within the limit of this thread
+		const bool isLimited = GetMaxNumberOfThreadsForCurrentThread() != 0u;
+
 		// [Helper] Inner loop
 		auto launchRange = [&](IndexType k1, IndexType k2, unsigned int tid)
 		{
+			if (isLimited)
+			{
+				SetMaxNumberOfThreadsForCurrentThread(1u);
+			}
+
 			results[tid] = func(k1, k2, identity);
 		};
 		
@@ -293,8 +313,7 @@ namespace CubbyFlow
 		std::vector<value_type> temp(size);
 
 		// Estimate number of threads in the pool
-		static const unsigned int numThreadsHint = std::thread::hardware_concurrency();
-		static const unsigned int numThreads = (numThreadsHint == 0u ? 8u : numThreadsHint);
+		const unsigned int numThreads = GetMaxNumberOfThreads();
 
 		Internal::ParallelMergeSort(begin, size, temp.begin(), numThreads, compareFunction);
 	}
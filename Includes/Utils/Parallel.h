@@ -142,6 +142,38 @@ namespace CubbyFlow
 	//!
 	template<typename RandomIterator, typename CompareFunction>
 	void ParallelSort(RandomIterator begin, RandomIterator end, CompareFunction compare);
+
+	//!
+	//! \brief      Sets maximum number of threads to use.
+	//!
+	//! This function sets the upper bound of the number of threads used by the
+	//! parallel functions above. Passing zero restores the default, which is
+	//! the number of hardware threads.
+	//!
+	//! \param[in]  numThreads The maximum number of threads.
+	//!
+	void SetMaxNumberOfThreads(unsigned int numThreads);
+
+	//! Returns maximum number of threads to use. The limit of the calling
+	//! thread takes precedence over the global one if set.
+	unsigned int GetMaxNumberOfThreads();
+
+	//!
+	//! \brief      Sets maximum number of threads to use from the calling thread.
+	//!
+	//! This function limits the parallel functions called from the current
+	//! thread only, so that several simulations advanced side by side can
+	//! share the cores without oversubscribing them. While the limit is set,
+	//! the worker threads of those parallel functions run their nested
+	//! parallel loops serially. Passing zero falls back to the global limit.
+	//!
+	//! \param[in]  numThreads The maximum number of threads of this thread.
+	//!
+	void SetMaxNumberOfThreadsForCurrentThread(unsigned int numThreads);
+
+	//! Returns maximum number of threads set for the calling thread, or zero
+	//! if the global limit applies.
+	unsigned int GetMaxNumberOfThreadsForCurrentThread();
 }
 
 #include <Utils/Parallel-Impl.h>
@@ -0,0 +1,194 @@
+/*************************************************************************
+> File Name: ParticleCache.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Compressed multi-frame particle position cache.
+> Created Time: 2017/10/28
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_PARTICLE_CACHE_H
+#define CUBBYFLOW_PARTICLE_CACHE_H
+
+#include <Array/Array1.h>
+#include <Array/ArrayAccessor1.h>
+#include <BoundingBox/BoundingBox3.h>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace CubbyFlow
+{
+	//!
+	//! \brief Writes particle positions of consecutive frames to a compressed
+	//!        cache file.
+	//!
+	//! The positions are quantized to \p bitsPerComponent bits per axis within
+	//! the bounding box of the cache, so the error is at most half of the
+	//! quantization step. Positions outside of the box are clamped to it.
+	//!
+	//! Every keyFrameInterval-th frame is a key frame that is decoded on its
+	//! own. The other frames are predicted from the previous one or two frames
+	//! of the same particle index. The particles are split into blocks, and
+	//! each axis of each block is an independent channel. A channel picks the
+	//! cheapest of the spatial delta, temporal delta, and linear extrapolation
+	//! predictors, and stores the residuals as zigzag variable-length integers.
+	//! The blocks are encoded in parallel.
+	//!
+	//! The frame table is written when the writer is closed.
+	//!
+	class ParticleCacheWriter final
+	{
+	public:
+		//! Number of particles in an independently encoded block.
+		static constexpr size_t BLOCK_SIZE = 65536;
+
+		//!
+		//! Opens (and truncates) the cache file.
+		//!
+		//! \param fileName Name of the cache file.
+		//! \param bounds Bounding box of the quantization.
+		//! \param bitsPerComponent Number of bits per axis, between 1 and 31.
+		//! \param keyFrameInterval Number of frames between the key frames.
+		//!
+		ParticleCacheWriter(
+			const std::string& fileName,
+			const BoundingBox3D& bounds,
+			unsigned int bitsPerComponent = 16,
+			unsigned int keyFrameInterval = 30);
+
+		//! Deleted copy constructor.
+		ParticleCacheWriter(const ParticleCacheWriter&) = delete;
+
+		//! Closes the file if not closed yet.
+		~ParticleCacheWriter();
+
+		//! Deleted copy assignment operator.
+		ParticleCacheWriter& operator=(const ParticleCacheWriter&) = delete;
+
+		//! Returns true if the file is successfully opened.
+		bool IsOpen() const;
+
+		//! Returns the number of written frames.
+		size_t NumberOfFrames() const;
+
+		//! Appends a frame with given particle positions.
+		void WriteFrame(const ConstArrayAccessor1<Vector3D>& positions);
+
+		//! Writes the frame table and closes the file.
+		void Close();
+
+	private:
+		struct FrameEntry
+		{
+			uint64_t offset;
+			uint64_t size;
+			uint64_t numberOfParticles;
+		};
+
+		std::ofstream m_file;
+		uint64_t m_offset = 0;
+		BoundingBox3D m_bounds;
+		unsigned int m_bitsPerComponent;
+		unsigned int m_keyFrameInterval;
+		std::vector<FrameEntry> m_frames;
+
+		// Quantized positions of the last two frames, x, y, z interleaved
+		std::vector<uint32_t> m_previous;
+		std::vector<uint32_t> m_previous2;
+	};
+
+	//!
+	//! \brief Reads a particle cache file written by ParticleCacheWriter.
+	//!
+	//! Only the header and the frame table are read when the file is opened.
+	//! The frames are read from the file on demand. The reader keeps the last
+	//! \p maxNumberOfCachedFrames decoded frames, so reading the frames in
+	//! order decodes each frame once, and going back within the cached frames
+	//! decodes nothing. Other frames are decoded from the closest cached frame
+	//! or key frame before them.
+	//!
+	class ParticleCacheReader final
+	{
+	public:
+		//! Opens the cache file with given \p fileName, keeping up to
+		//! \p maxNumberOfCachedFrames decoded frames in memory.
+		explicit ParticleCacheReader(const std::string& fileName, size_t maxNumberOfCachedFrames = 8);
+
+		//! Deleted copy constructor.
+		ParticleCacheReader(const ParticleCacheReader&) = delete;
+
+		//! Deleted copy assignment operator.
+		ParticleCacheReader& operator=(const ParticleCacheReader&) = delete;
+
+		//! Returns true if the file is successfully opened and has a valid
+		//! frame table.
+		bool IsOpen() const;
+
+		//! Returns the number of frames.
+		size_t NumberOfFrames() const;
+
+		//! Returns the number of particles of the frame.
+		size_t NumberOfParticles(size_t frame) const;
+
+		//! Returns the bounding box of the quantization.
+		const BoundingBox3D& GetBounds() const;
+
+		//! Returns the number of bits per axis.
+		unsigned int GetBitsPerComponent() const;
+
+		//! Returns the number of frames between the key frames.
+		unsigned int GetKeyFrameInterval() const;
+
+		//! Returns the quantization step along each axis.
+		Vector3D QuantizationStep() const;
+
+		//! Returns the maximum number of decoded frames kept in memory.
+		size_t GetMaxNumberOfCachedFrames() const;
+
+		//! Decodes the positions of the frame. Throws std::runtime_error if the
+		//! frame data is corrupted.
+		void ReadFrame(size_t frame, Array1<Vector3D>* positions);
+
+	private:
+		struct FrameEntry
+		{
+			uint64_t offset;
+			uint64_t size;
+			uint64_t numberOfParticles;
+		};
+
+		struct CachedFrame
+		{
+			size_t frame;
+			uint64_t lastUse;
+			std::vector<uint32_t> positions;
+		};
+
+		std::ifstream m_file;
+		BoundingBox3D m_bounds;
+		unsigned int m_bitsPerComponent = 0;
+		unsigned int m_keyFrameInterval = 1;
+		std::vector<FrameEntry> m_frames;
+
+		size_t m_decodedFrame;
+		std::vector<uint32_t> m_current;
+		std::vector<uint32_t> m_previous;
+		std::vector<uint8_t> m_buffer;
+
+		size_t m_maxNumberOfCachedFrames;
+		uint64_t m_numberOfUses = 0;
+		std::vector<CachedFrame> m_cachedFrames;
+
+		void DecodeFrame(size_t frame);
+
+		CachedFrame* FindCachedFrame(size_t frame);
+
+		void CacheDecodedFrame();
+
+		void Dequantize(const std::vector<uint32_t>& quantized, size_t numberOfParticles, Array1<Vector3D>* positions) const;
+	};
+}
+
+#endif
\ No newline at end of file
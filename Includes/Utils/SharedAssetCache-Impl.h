@@ -0,0 +1,62 @@
+/*************************************************************************
+> File Name: SharedAssetCache-Impl.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Thread-safe cache of immutable assets built once and shared.
+> Created Time: 2017/10/29
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_SHARED_ASSET_CACHE_IMPL_H
+#define CUBBYFLOW_SHARED_ASSET_CACHE_IMPL_H
+
+#include <stdexcept>
+
+namespace CubbyFlow
+{
+	template <typename T, typename Factory>
+	std::shared_ptr<T> SharedAssetCache::GetOrCreate(const std::string& key, const Factory& factory)
+	{
+		std::promise<std::shared_ptr<void>> promise;
+		std::shared_future<std::shared_ptr<void>> asset;
+		bool isBuilder = false;
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			auto iter = m_assets.find(key);
+			if (iter == m_assets.end())
+			{
+				asset = promise.get_future().share();
+				m_assets.emplace(key, Entry{ std::type_index(typeid(T)), asset });
+				isBuilder = true;
+			}
+			else if (iter->second.type != std::type_index(typeid(T)))
+			{
+				throw std::invalid_argument("Asset " + key + " has a different type.");
+			}
+			else
+			{
+				asset = iter->second.asset;
+			}
+		}
+
+		// Build outside of the lock so that the other assets are not blocked
+		if (isBuilder)
+		{
+			try
+			{
+				std::shared_ptr<T> built = factory();
+				promise.set_value(built);
+			}
+			catch (...)
+			{
+				Remove(key);
+				promise.set_exception(std::current_exception());
+			}
+		}
+
+		return std::static_pointer_cast<T>(asset.get());
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,86 @@
+/*************************************************************************
+> File Name: SharedAssetCache.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Thread-safe cache of immutable assets built once and shared.
+> Created Time: 2017/10/29
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_SHARED_ASSET_CACHE_H
+#define CUBBYFLOW_SHARED_ASSET_CACHE_H
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace CubbyFlow
+{
+	//!
+	//! \brief Thread-safe cache of immutable assets built once and shared.
+	//!
+	//! Expensive setup data such as the signed-distance fields of colliders
+	//! can be baked once under a key and shared by every simulation that
+	//! needs it. When several threads request a missing asset at the same
+	//! time, only one of them runs the factory and the others wait for it.
+	//!
+	//! The assets are shared as they are, so they must be treated as
+	//! immutable once built. Any lazily built acceleration structure of an
+	//! asset (e.g., the BVH of TriangleMesh3) should be built by the factory,
+	//! so that the shared asset is never written afterward.
+	//!
+	class SharedAssetCache final
+	{
+	public:
+		//! Constructs an empty cache.
+		SharedAssetCache() = default;
+
+		//! Deleted copy constructor.
+		SharedAssetCache(const SharedAssetCache&) = delete;
+
+		//! Deleted copy assignment operator.
+		SharedAssetCache& operator=(const SharedAssetCache&) = delete;
+
+		//!
+		//! \brief Returns the asset with given key, building it if missing.
+		//!
+		//! \p factory takes no argument and returns std::shared_ptr<T>. If the
+		//! factory throws, the exception is rethrown to every waiting caller
+		//! and the key stays missing. Throws std::invalid_argument if the key
+		//! holds an asset of another type.
+		//!
+		template <typename T, typename Factory>
+		std::shared_ptr<T> GetOrCreate(const std::string& key, const Factory& factory);
+
+		//! Returns true if the asset with given key is built or being built.
+		bool Contains(const std::string& key) const;
+
+		//! Returns the number of assets.
+		size_t NumberOfAssets() const;
+
+		//! Removes all the assets. The pointers handed out stay valid.
+		void Clear();
+
+	private:
+		struct Entry
+		{
+			std::type_index type;
+			std::shared_future<std::shared_ptr<void>> asset;
+		};
+
+		mutable std::mutex m_mutex;
+		std::unordered_map<std::string, Entry> m_assets;
+
+		void Remove(const std::string& key);
+	};
+
+	//! Shared pointer type for the SharedAssetCache.
+	using SharedAssetCachePtr = std::shared_ptr<SharedAssetCache>;
+}
+
+#include <Utils/SharedAssetCache-Impl.h>
+
+#endif
\ No newline at end of file
@@ -400,13 +400,6 @@ namespace CubbyFlow
 		return (*this);
 	}
 
-	template <typename T>
-	Vector<T, 3>& Vector<T, 3>::operator=(const Vector& v)
-	{
-		Set(v);
-		return (*this);
-	}
-
 	template <typename T>
 	Vector<T, 3>& Vector<T, 3>::operator+=(T v)
 	{
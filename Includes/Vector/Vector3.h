@@ -61,10 +61,7 @@ namespace CubbyFlow
 		Vector(const std::initializer_list<U>& list);
 
 		//! Copy constructor.
-		constexpr Vector(const Vector& v) : x(v.x), y(v.y), z(v.z)
-		{
-			// Do nothing
-		}
+		constexpr Vector(const Vector& v) = default;
 
 		// MARK: Basic setters
 		//! Set all x, y, and z components to \p s.
@@ -238,7 +235,7 @@ namespace CubbyFlow
 		Vector& operator=(const std::initializer_list<U>& list);
 
 		//! Set x and y with other vector \p pt.
-		Vector& operator=(const Vector& v);
+		Vector& operator=(const Vector& v) = default;
 
 		//! Computes this += (v, v)
 		Vector& operator+=(T v);
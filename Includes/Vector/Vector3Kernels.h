@@ -0,0 +1,63 @@
+/*************************************************************************
+> File Name: Vector3Kernels.h
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Bulk operations on arrays of 3-D vectors.
+> Created Time: 2017/10/31
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#ifndef CUBBYFLOW_VECTOR3_KERNELS_H
+#define CUBBYFLOW_VECTOR3_KERNELS_H
+
+#include <Array/ArrayAccessor1.h>
+#include <Matrix/Matrix3x3.h>
+#include <Vector/Vector3.h>
+
+namespace CubbyFlow
+{
+	//!
+	//! \brief Bulk operations on arrays of 3-D vectors.
+	//!
+	//! The operations process two vectors per SSE2 instruction by unpacking
+	//! the x, y and z components of each pair, and fall back to scalar code on
+	//! the other targets. The results are identical to those of the Vector3D
+	//! and Matrix3x3D operators. The operations run serially, so the parallel
+	//! loops should call them per chunk of elements. The output may alias the
+	//! input.
+	//!
+	struct Vector3Kernels
+	{
+		//! Performs ax + y operation where \p a is a scalar and \p x and \p y are
+		//! arrays of vectors.
+		static void AXPlusY(
+			double a,
+			const ConstArrayAccessor1<Vector3D>& x,
+			const ConstArrayAccessor1<Vector3D>& y,
+			ArrayAccessor1<Vector3D>* result);
+
+		//! Performs ax / b + y operation where \p a and \p b are scalars and
+		//! \p x and \p y are arrays of vectors.
+		static void AXOverBPlusY(
+			double a,
+			double b,
+			const ConstArrayAccessor1<Vector3D>& x,
+			const ConstArrayAccessor1<Vector3D>& y,
+			ArrayAccessor1<Vector3D>* result);
+
+		//! Transforms the points by m * (p + preOffset) + postOffset.
+		static void Transform(
+			const Matrix3x3D& m,
+			const Vector3D& preOffset,
+			const Vector3D& postOffset,
+			const ConstArrayAccessor1<Vector3D>& points,
+			ArrayAccessor1<Vector3D>* result);
+
+		//! Computes the lengths of the vectors.
+		static void Length(const ConstArrayAccessor1<Vector3D>& v, ArrayAccessor1<double>* result);
+
+		//! Normalizes the vectors in place.
+		static void Normalize(ArrayAccessor1<Vector3D>* v);
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,208 @@
+/*************************************************************************
+> File Name: EnsembleRunner.cpp
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Advances many animations side by side on a shared set of cores.
+> Created Time: 2017/10/29
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#include <Animation/EnsembleRunner.h>
+#include <Utils/Logger.h>
+#include <Utils/Parallel.h>
+#include <Utils/Timer.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace CubbyFlow
+{
+	EnsembleRunner::EnsembleRunner(unsigned int numberOfThreads) :
+		m_numberOfThreads(numberOfThreads == 0 ? GetMaxNumberOfThreads() : numberOfThreads),
+		m_assets(std::make_shared<SharedAssetCache>())
+	{
+		// Do nothing
+	}
+
+	unsigned int EnsembleRunner::NumberOfThreads() const
+	{
+		return m_numberOfThreads;
+	}
+
+	const SharedAssetCachePtr& EnsembleRunner::GetAssets() const
+	{
+		return m_assets;
+	}
+
+	size_t EnsembleRunner::AddMember(
+		const AnimationPtr& animation,
+		const Frame& firstFrame,
+		unsigned int numberOfFrames,
+		const FrameCallback& callback)
+	{
+		m_members.push_back(Member{ animation, firstFrame, numberOfFrames, callback });
+		return m_members.size() - 1;
+	}
+
+	size_t EnsembleRunner::NumberOfMembers() const
+	{
+		return m_members.size();
+	}
+
+	const AnimationPtr& EnsembleRunner::MemberAt(size_t i) const
+	{
+		return m_members[i].animation;
+	}
+
+	Frame EnsembleRunner::NextFrameOf(size_t i) const
+	{
+		return m_members[i].nextFrame;
+	}
+
+	EnsembleReport EnsembleRunner::Run()
+	{
+		EnsembleReport report;
+		report.numberOfThreads = m_numberOfThreads;
+		report.memberTimesInSeconds.assign(m_members.size(), 0.0);
+
+		std::vector<unsigned int> remainingFrames(m_members.size());
+		std::deque<size_t> queue;
+		size_t numberOfUnfinished = 0;
+
+		for (size_t i = 0; i < m_members.size(); ++i)
+		{
+			remainingFrames[i] = m_members[i].numberOfFrames;
+			if (remainingFrames[i] > 0)
+			{
+				queue.push_back(i);
+				++numberOfUnfinished;
+			}
+		}
+
+		const unsigned int numberOfWorkers = static_cast<unsigned int>(std::min<size_t>(m_numberOfThreads, numberOfUnfinished));
+
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::exception_ptr firstException;
+
+		const auto runWorker = [&](unsigned int worker)
+		{
+			const unsigned int previousLimit = GetMaxNumberOfThreadsForCurrentThread();
+			std::unique_lock<std::mutex> lock(mutex);
+
+			while (true)
+			{
+				condition.wait(lock, [&]
+				{
+					return !queue.empty() || numberOfUnfinished == 0 || firstException;
+				});
+
+				if (numberOfUnfinished == 0 || firstException)
+				{
+					break;
+				}
+
+				const size_t i = queue.front();
+				queue.pop_front();
+
+				// Split the cores among the members in flight, giving the
+				// remainder to the lower workers
+				const unsigned int numberOfActive = static_cast<unsigned int>(std::min<size_t>(numberOfWorkers, numberOfUnfinished));
+				const unsigned int budget = std::max(1u,
+					m_numberOfThreads / numberOfActive + (worker % numberOfActive < m_numberOfThreads % numberOfActive ? 1u : 0u));
+
+				Member& member = m_members[i];
+				const Frame frame = member.nextFrame;
+
+				lock.unlock();
+
+				SetMaxNumberOfThreadsForCurrentThread(budget);
+
+				Timer timer;
+				std::exception_ptr exception;
+
+				try
+				{
+					member.animation->Update(frame);
+
+					if (member.callback)
+					{
+						member.callback(i, frame);
+					}
+				}
+				catch (...)
+				{
+					exception = std::current_exception();
+				}
+
+				const double duration = timer.DurationInSeconds();
+				SetMaxNumberOfThreadsForCurrentThread(previousLimit);
+
+				lock.lock();
+
+				report.memberTimesInSeconds[i] += duration;
+
+				if (exception)
+				{
+					if (!firstException)
+					{
+						firstException = exception;
+					}
+
+					condition.notify_all();
+					break;
+				}
+
+				++member.nextFrame.index;
+				++report.numberOfFrames;
+
+				if (--remainingFrames[i] > 0)
+				{
+					queue.push_back(i);
+				}
+				else
+				{
+					--numberOfUnfinished;
+				}
+
+				condition.notify_all();
+			}
+		};
+
+		Timer timer;
+
+		std::vector<std::thread> workers;
+		for (unsigned int worker = 1; worker < numberOfWorkers; ++worker)
+		{
+			workers.emplace_back(runWorker, worker);
+		}
+
+		if (numberOfWorkers > 0)
+		{
+			runWorker(0);
+		}
+
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+
+		report.wallTimeInSeconds = timer.DurationInSeconds();
+		report.coreHours = report.wallTimeInSeconds * m_numberOfThreads / 3600.0;
+		report.framesPerCoreHour = report.coreHours > 0.0 ? report.numberOfFrames / report.coreHours : 0.0;
+
+		if (firstException)
+		{
+			std::rethrow_exception(firstException);
+		}
+
+		CUBBYFLOW_INFO << "Ensemble of " << m_members.size() << " members advanced "
+			<< report.numberOfFrames << " frames on " << m_numberOfThreads << " cores in "
+			<< report.wallTimeInSeconds << " seconds (" << report.framesPerCoreHour << " frames per core-hour)";
+
+		return report;
+	}
+}
\ No newline at end of file
@@ -64,6 +64,41 @@ namespace CubbyFlow
 		return m_currentTime;
 	}
 
+	bool PhysicsAnimation::SaveCheckpoint(const std::string& fileName) const
+	{
+		Timer timer;
+
+		CheckpointWriter writer(fileName);
+		if (!writer.IsOpen())
+		{
+			return false;
+		}
+
+		OnSaveCheckpoint(&writer);
+		writer.Close();
+
+		CUBBYFLOW_INFO << "Writing checkpoint took " << timer.DurationInSeconds() << " seconds";
+
+		return true;
+	}
+
+	bool PhysicsAnimation::LoadCheckpoint(const std::string& fileName)
+	{
+		Timer timer;
+
+		CheckpointReader reader(fileName);
+		if (!reader.IsOpen())
+		{
+			return false;
+		}
+
+		OnLoadCheckpoint(reader);
+
+		CUBBYFLOW_INFO << "Reading checkpoint took " << timer.DurationInSeconds() << " seconds";
+
+		return true;
+	}
+
 	unsigned int PhysicsAnimation::NumberOfSubTimeSteps(double timeIntervalInSeconds) const
 	{
 		// Returns number of fixed sub-timesteps by default
@@ -152,4 +187,26 @@ namespace CubbyFlow
 	{
 		// Do nothing
 	}
+
+	void PhysicsAnimation::OnSaveCheckpoint(CheckpointWriter* writer) const
+	{
+		writer->WriteValue("animation.frameIndex", m_currentFrame.index);
+		writer->WriteValue("animation.frameTimeIntervalInSeconds", m_currentFrame.timeIntervalInSeconds);
+		writer->WriteValue("animation.currentTime", m_currentTime);
+		writer->WriteValue<uint8_t>("animation.isUsingFixedSubTimeSteps", m_isUsingFixedSubTimeSteps ? 1 : 0);
+		writer->WriteValue("animation.numberOfFixedSubTimeSteps", m_numberOfFixedSubTimeSteps);
+	}
+
+	void PhysicsAnimation::OnLoadCheckpoint(const CheckpointReader& reader)
+	{
+		uint8_t isUsingFixedSubTimeSteps;
+
+		reader.ReadValue("animation.frameIndex", &m_currentFrame.index);
+		reader.ReadValue("animation.frameTimeIntervalInSeconds", &m_currentFrame.timeIntervalInSeconds);
+		reader.ReadValue("animation.currentTime", &m_currentTime);
+		reader.ReadValue("animation.isUsingFixedSubTimeSteps", &isUsingFixedSubTimeSteps);
+		reader.ReadValue("animation.numberOfFixedSubTimeSteps", &m_numberOfFixedSubTimeSteps);
+
+		m_isUsingFixedSubTimeSteps = (isUsingFixedSubTimeSteps != 0);
+	}
 }
\ No newline at end of file
@@ -108,10 +108,36 @@ namespace CubbyFlow
 		{
 			m_onUpdateCallback(this, currentTimeInSeconds, timeIntervalInSeconds);
 		}
+
+		// The callback may have moved the surface (or its children).
+		if (m_surface != nullptr)
+		{
+			m_surface->UpdateQueryEngine();
+		}
 	}
 
 	void Collider3::SetOnBeginUpdateCallback(const OnBeginUpdateCallback& callback)
 	{
 		m_onUpdateCallback = callback;
 	}
+
+	void Collider3::SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const
+	{
+		writer->WriteValue(prefix + "frictionCoefficient", m_frictionCoeffient);
+		writer->WriteValue(prefix + "translation", m_surface->transform.GetTranslation());
+		writer->WriteValue(prefix + "orientation", m_surface->transform.GetOrientation());
+	}
+
+	void Collider3::LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix)
+	{
+		Vector3D translation;
+		QuaternionD orientation;
+
+		reader.ReadValue(prefix + "frictionCoefficient", &m_frictionCoeffient);
+		reader.ReadValue(prefix + "translation", &translation);
+		reader.ReadValue(prefix + "orientation", &orientation);
+
+		m_surface->transform.SetTranslation(translation);
+		m_surface->transform.SetOrientation(orientation);
+	}
 }
\ No newline at end of file
@@ -17,9 +17,10 @@ namespace CubbyFlow
 		// Do nothing
 	}
 
-	ColliderSet3::ColliderSet3(const std::vector<Collider3Ptr>& others)
+	ColliderSet3::ColliderSet3(const std::vector<Collider3Ptr>& others) :
+		m_surfaceSet(std::make_shared<SurfaceSet3>())
 	{
-		SetSurface(std::make_shared<SurfaceSet3>());
+		SetSurface(m_surfaceSet);
 		for (const auto& collider : others)
 		{
 			AddCollider(collider);
@@ -28,33 +29,27 @@ namespace CubbyFlow
 
 	Vector3D ColliderSet3::VelocityAt(const Vector3D& point) const
 	{
-		size_t closestCollider = std::numeric_limits<size_t>::max();
-		double closestDist = std::numeric_limits<double>::max();
-
-		for (size_t i = 0; i < m_colliders.size(); ++i)
+		if (m_colliders.empty())
 		{
-			double dist = m_colliders[i]->Surface()->ClosestDistance(point);
-			
-			if (dist < closestDist)
-			{
-				closestDist = dist;
-				closestCollider = i;
-			}
+			return Vector3D();
 		}
 
-		if (closestCollider != std::numeric_limits<size_t>::max())
+		// The bounding volume hierarchy of the surface set finds the closest
+		// member, which is mapped back to the collider it was added with.
+		const size_t closestSurface = m_surfaceSet->ClosestSurfaceIndex(point);
+		if (closestSurface >= m_colliderIndices.size())
 		{
-			return m_colliders[closestCollider]->VelocityAt(point);
+			return Vector3D();
 		}
-		
-		return Vector3D();
+
+		return m_colliders[m_colliderIndices[closestSurface]]->VelocityAt(point);
 	}
 
 	void ColliderSet3::AddCollider(const Collider3Ptr& collider)
 	{
-		auto surfaceSet = std::dynamic_pointer_cast<SurfaceSet3>(Surface());
+		m_colliderIndices.push_back(m_colliders.size());
 		m_colliders.push_back(collider);
-		surfaceSet->AddSurface(collider->Surface());
+		m_surfaceSet->AddSurface(collider->Surface());
 	}
 
 	size_t ColliderSet3::NumberOfColliders() const
@@ -67,6 +62,26 @@ namespace CubbyFlow
 		return m_colliders[i];
 	}
 
+	void ColliderSet3::SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const
+	{
+		Collider3::SaveCheckpoint(writer, prefix);
+
+		for (size_t i = 0; i < m_colliders.size(); ++i)
+		{
+			m_colliders[i]->SaveCheckpoint(writer, prefix + std::to_string(i) + ".");
+		}
+	}
+
+	void ColliderSet3::LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix)
+	{
+		Collider3::LoadCheckpoint(reader, prefix);
+
+		for (size_t i = 0; i < m_colliders.size(); ++i)
+		{
+			m_colliders[i]->LoadCheckpoint(reader, prefix + std::to_string(i) + ".");
+		}
+	}
+
 	ColliderSet3::Builder ColliderSet3::GetBuilder()
 	{
 		return Builder();
@@ -28,6 +28,22 @@ namespace CubbyFlow
 		return linearVelocity + angularVelocity.Cross(r);
 	}
 
+	void RigidBodyCollider3::SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const
+	{
+		Collider3::SaveCheckpoint(writer, prefix);
+
+		writer->WriteValue(prefix + "linearVelocity", linearVelocity);
+		writer->WriteValue(prefix + "angularVelocity", angularVelocity);
+	}
+
+	void RigidBodyCollider3::LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix)
+	{
+		Collider3::LoadCheckpoint(reader, prefix);
+
+		reader.ReadValue(prefix + "linearVelocity", &linearVelocity);
+		reader.ReadValue(prefix + "angularVelocity", &angularVelocity);
+	}
+
 	RigidBodyCollider3::Builder RigidBodyCollider3::GetBuilder()
 	{
 		return Builder();
@@ -0,0 +1,203 @@
+/*************************************************************************
+> File Name: GridDomainDecomposition3.cpp
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: 3-D decomposition of a grid into subdomains with ghost-cell halos.
+> Created Time: 2017/10/26
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#include <Decomposition/GridDomainDecomposition3.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace CubbyFlow
+{
+	// Halos sent toward the negative side of axis a use tag 2 * a, and the
+	// ones sent toward the positive side use 2 * a + 1.
+	static const int HALO_TAG = 0;
+
+	constexpr size_t GridDomainDecomposition3::NO_NEIGHBOR;
+
+	GridDomainDecomposition3::GridDomainDecomposition3(const Size3& resolution, const Size3& layout, size_t ghostWidth) :
+		m_resolution(resolution), m_layout(layout), m_ghostWidth(ghostWidth)
+	{
+		for (size_t axis = 0; axis < 3; ++axis)
+		{
+			if (layout[axis] == 0 || layout[axis] > resolution[axis])
+			{
+				throw std::invalid_argument("Each subdomain must own at least one cell.");
+			}
+
+			m_splits[axis].resize(layout[axis] + 1);
+			for (size_t c = 0; c <= layout[axis]; ++c)
+			{
+				m_splits[axis][c] = c * resolution[axis] / layout[axis];
+			}
+		}
+	}
+
+	const Size3& GridDomainDecomposition3::Resolution() const
+	{
+		return m_resolution;
+	}
+
+	const Size3& GridDomainDecomposition3::Layout() const
+	{
+		return m_layout;
+	}
+
+	size_t GridDomainDecomposition3::GhostWidth() const
+	{
+		return m_ghostWidth;
+	}
+
+	size_t GridDomainDecomposition3::NumberOfSubdomains() const
+	{
+		return m_layout.x * m_layout.y * m_layout.z;
+	}
+
+	Size3 GridDomainDecomposition3::SubdomainCoordinate(size_t rank) const
+	{
+		assert(rank < NumberOfSubdomains());
+
+		return Size3(rank % m_layout.x, (rank / m_layout.x) % m_layout.y, rank / (m_layout.x * m_layout.y));
+	}
+
+	Size3 GridDomainDecomposition3::SubdomainOrigin(size_t rank) const
+	{
+		const Size3 c = SubdomainCoordinate(rank);
+
+		return Size3(m_splits[0][c.x], m_splits[1][c.y], m_splits[2][c.z]);
+	}
+
+	Size3 GridDomainDecomposition3::SubdomainResolution(size_t rank) const
+	{
+		const Size3 c = SubdomainCoordinate(rank);
+
+		return Size3(
+			m_splits[0][c.x + 1] - m_splits[0][c.x],
+			m_splits[1][c.y + 1] - m_splits[1][c.y],
+			m_splits[2][c.z + 1] - m_splits[2][c.z]);
+	}
+
+	Size3 GridDomainDecomposition3::LocalSize(size_t rank) const
+	{
+		const Size3 resolution = SubdomainResolution(rank);
+
+		return Size3(
+			resolution.x + 2 * m_ghostWidth,
+			resolution.y + 2 * m_ghostWidth,
+			resolution.z + 2 * m_ghostWidth);
+	}
+
+	size_t GridDomainDecomposition3::Neighbor(size_t rank, size_t axis, int direction) const
+	{
+		Size3 c = SubdomainCoordinate(rank);
+
+		if (direction < 0)
+		{
+			if (c[axis] == 0)
+			{
+				return NO_NEIGHBOR;
+			}
+
+			--c[axis];
+		}
+		else
+		{
+			if (c[axis] + 1 == m_layout[axis])
+			{
+				return NO_NEIGHBOR;
+			}
+
+			++c[axis];
+		}
+
+		return c.x + m_layout.x * (c.y + m_layout.y * c.z);
+	}
+
+	size_t GridDomainDecomposition3::RankAt(const Size3& index) const
+	{
+		Size3 c;
+
+		for (size_t axis = 0; axis < 3; ++axis)
+		{
+			const auto& splits = m_splits[axis];
+			const size_t i = std::min(index[axis], m_resolution[axis] - 1);
+
+			c[axis] = static_cast<size_t>(std::upper_bound(splits.begin(), splits.end(), i) - splits.begin()) - 1;
+		}
+
+		return c.x + m_layout.x * (c.y + m_layout.y * c.z);
+	}
+
+	void GridDomainDecomposition3::ExchangeHalos(size_t rank, SubdomainTransport* transport, Array3<double>* local) const
+	{
+		assert(local->size() == LocalSize(rank));
+
+		const Size3 localSize = LocalSize(rank);
+		const size_t g = m_ghostWidth;
+		std::vector<double> buffer;
+
+		// Visits the cells of the local array in [begin, end) along the axis
+		// and the full extent along the other axes.
+		const auto forEachInSlab = [&](size_t axis, size_t begin, size_t end, const auto& func)
+		{
+			Size3 lower(0, 0, 0);
+			Size3 upper = localSize;
+			lower[axis] = begin;
+			upper[axis] = end;
+
+			for (size_t k = lower.z; k < upper.z; ++k)
+			{
+				for (size_t j = lower.y; j < upper.y; ++j)
+				{
+					for (size_t i = lower.x; i < upper.x; ++i)
+					{
+						func((*local)(i, j, k));
+					}
+				}
+			}
+		};
+
+		for (size_t axis = 0; axis < 3; ++axis)
+		{
+			const size_t n = localSize[axis] - 2 * g;
+			const size_t lowerNeighbor = Neighbor(rank, axis, -1);
+			const size_t upperNeighbor = Neighbor(rank, axis, +1);
+
+			assert(g <= n);
+
+			if (lowerNeighbor != NO_NEIGHBOR)
+			{
+				buffer.clear();
+				forEachInSlab(axis, g, 2 * g, [&](double v) { buffer.push_back(v); });
+				transport->Send(rank, lowerNeighbor, HALO_TAG + static_cast<int>(2 * axis), buffer);
+			}
+
+			if (upperNeighbor != NO_NEIGHBOR)
+			{
+				buffer.clear();
+				forEachInSlab(axis, n, n + g, [&](double v) { buffer.push_back(v); });
+				transport->Send(rank, upperNeighbor, HALO_TAG + static_cast<int>(2 * axis + 1), buffer);
+			}
+
+			if (lowerNeighbor != NO_NEIGHBOR)
+			{
+				transport->Receive(rank, lowerNeighbor, HALO_TAG + static_cast<int>(2 * axis + 1), &buffer);
+
+				size_t idx = 0;
+				forEachInSlab(axis, 0, g, [&](double& v) { v = buffer[idx++]; });
+			}
+
+			if (upperNeighbor != NO_NEIGHBOR)
+			{
+				transport->Receive(rank, upperNeighbor, HALO_TAG + static_cast<int>(2 * axis), &buffer);
+
+				size_t idx = 0;
+				forEachInSlab(axis, n + g, n + 2 * g, [&](double& v) { v = buffer[idx++]; });
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,266 @@
+/*************************************************************************
+> File Name: SharedMemorySubdomainTransport.cpp
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Subdomain transport running the ranks as threads of one process.
+> Created Time: 2017/10/26
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#include <Decomposition/SharedMemorySubdomainTransport.h>
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace CubbyFlow
+{
+	SharedMemorySubdomainTransport::SharedMemorySubdomainTransport(size_t numberOfSubdomains) :
+		m_numberOfSubdomains(numberOfSubdomains),
+		m_reduceValues(numberOfSubdomains, 0.0),
+		m_reduceArrived(0),
+		m_reduceGeneration(0),
+		m_reduceResult(0.0),
+		m_isAborted(false),
+		m_job(nullptr),
+		m_jobGeneration(0),
+		m_numberOfRunningWorkers(0),
+		m_isStopping(false)
+	{
+		// Do nothing
+	}
+
+	SharedMemorySubdomainTransport::~SharedMemorySubdomainTransport()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_runMutex);
+			m_isStopping = true;
+		}
+
+		m_runCondition.notify_all();
+
+		for (std::thread& worker : m_workers)
+		{
+			worker.join();
+		}
+	}
+
+	size_t SharedMemorySubdomainTransport::NumberOfSubdomains() const
+	{
+		return m_numberOfSubdomains;
+	}
+
+	void SharedMemorySubdomainTransport::Run(const std::function<void(size_t)>& func)
+	{
+		if (m_numberOfSubdomains == 0)
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_runMutex);
+
+			while (m_workers.size() + 1 < m_numberOfSubdomains)
+			{
+				m_workers.emplace_back(&SharedMemorySubdomainTransport::RunWorker, this, m_workers.size() + 1, m_jobGeneration);
+			}
+
+			m_job = &func;
+			m_numberOfRunningWorkers = m_workers.size();
+			m_firstException = nullptr;
+			++m_jobGeneration;
+		}
+
+		m_runCondition.notify_all();
+
+		RunRank(0, func);
+
+		std::exception_ptr firstException;
+		{
+			std::unique_lock<std::mutex> lock(m_runMutex);
+			m_doneCondition.wait(lock, [&]()
+			{
+				return m_numberOfRunningWorkers == 0;
+			});
+
+			m_job = nullptr;
+			firstException = m_firstException;
+			m_firstException = nullptr;
+		}
+
+		if (m_isAborted)
+		{
+			// Every rank has returned, so nobody holds the other locks
+			m_mailboxes.clear();
+			m_reduceArrived = 0;
+			m_isAborted = false;
+		}
+
+		if (firstException)
+		{
+			std::rethrow_exception(firstException);
+		}
+	}
+
+	void SharedMemorySubdomainTransport::RunWorker(size_t rank, size_t jobGeneration)
+	{
+		while (true)
+		{
+			const std::function<void(size_t)>* job;
+			{
+				std::unique_lock<std::mutex> lock(m_runMutex);
+				m_runCondition.wait(lock, [&]()
+				{
+					return m_isStopping || m_jobGeneration != jobGeneration;
+				});
+
+				if (m_isStopping)
+				{
+					return;
+				}
+
+				jobGeneration = m_jobGeneration;
+				job = m_job;
+			}
+
+			RunRank(rank, *job);
+
+			{
+				std::lock_guard<std::mutex> lock(m_runMutex);
+				--m_numberOfRunningWorkers;
+			}
+
+			m_doneCondition.notify_all();
+		}
+	}
+
+	void SharedMemorySubdomainTransport::RunRank(size_t rank, const std::function<void(size_t)>& func)
+	{
+		try
+		{
+			func(rank);
+		}
+		catch (...)
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_runMutex);
+				if (!m_firstException)
+				{
+					m_firstException = std::current_exception();
+				}
+			}
+
+			Abort();
+		}
+	}
+
+	void SharedMemorySubdomainTransport::Abort()
+	{
+		m_isAborted = true;
+
+		// Locking makes sure that no rank is between checking the flag and
+		// starting to wait, so none of them misses the notification
+		{
+			std::lock_guard<std::mutex> lock(m_messageMutex);
+		}
+		m_messageCondition.notify_all();
+
+		{
+			std::lock_guard<std::mutex> lock(m_reduceMutex);
+		}
+		m_reduceCondition.notify_all();
+	}
+
+	void SharedMemorySubdomainTransport::Send(size_t from, size_t to, int tag, const std::vector<double>& data)
+	{
+		assert(from < m_numberOfSubdomains && to < m_numberOfSubdomains);
+
+		{
+			std::lock_guard<std::mutex> lock(m_messageMutex);
+			m_mailboxes[ChannelKey(from, to, tag)].push_back(data);
+		}
+
+		m_messageCondition.notify_all();
+	}
+
+	void SharedMemorySubdomainTransport::Receive(size_t to, size_t from, int tag, std::vector<double>* data)
+	{
+		assert(from < m_numberOfSubdomains && to < m_numberOfSubdomains);
+
+		std::unique_lock<std::mutex> lock(m_messageMutex);
+		auto& mailbox = m_mailboxes[ChannelKey(from, to, tag)];
+
+		m_messageCondition.wait(lock, [&]()
+		{
+			return !mailbox.empty() || m_isAborted;
+		});
+
+		if (mailbox.empty())
+		{
+			throw std::runtime_error("The subdomain transport is aborted by another rank.");
+		}
+
+		*data = std::move(mailbox.front());
+		mailbox.pop_front();
+	}
+
+	double SharedMemorySubdomainTransport::AllReduceSum(size_t rank, double value)
+	{
+		return AllReduce(rank, value, [](double a, double b)
+		{
+			return a + b;
+		});
+	}
+
+	double SharedMemorySubdomainTransport::AllReduceMax(size_t rank, double value)
+	{
+		return AllReduce(rank, value, [](double a, double b)
+		{
+			return std::max(a, b);
+		});
+	}
+
+	void SharedMemorySubdomainTransport::Barrier(size_t rank)
+	{
+		AllReduceSum(rank, 0.0);
+	}
+
+	double SharedMemorySubdomainTransport::AllReduce(size_t rank, double value, const std::function<double(double, double)>& op)
+	{
+		assert(rank < m_numberOfSubdomains);
+
+		std::unique_lock<std::mutex> lock(m_reduceMutex);
+		const size_t generation = m_reduceGeneration;
+
+		m_reduceValues[rank] = value;
+
+		if (++m_reduceArrived == m_numberOfSubdomains)
+		{
+			double result = m_reduceValues[0];
+			for (size_t i = 1; i < m_numberOfSubdomains; ++i)
+			{
+				result = op(result, m_reduceValues[i]);
+			}
+
+			// No rank can arrive at the next reduction before all the waiting
+			// ranks have read this result, so a single slot is enough.
+			m_reduceResult = result;
+			m_reduceArrived = 0;
+			++m_reduceGeneration;
+			m_reduceCondition.notify_all();
+
+			return result;
+		}
+
+		m_reduceCondition.wait(lock, [&]()
+		{
+			return m_reduceGeneration != generation || m_isAborted;
+		});
+
+		if (m_reduceGeneration == generation)
+		{
+			throw std::runtime_error("The subdomain transport is aborted by another rank.");
+		}
+
+		return m_reduceResult;
+	}
+}
\ No newline at end of file
@@ -35,6 +35,16 @@ namespace CubbyFlow
 		m_onBeginUpdateCallback = callback;
 	}
 
+	void GridEmitter3::SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const
+	{
+		// Do nothing
+	}
+
+	void GridEmitter3::LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix)
+	{
+		// Do nothing
+	}
+
 	void GridEmitter3::CallOnBeginUpdateCallback(double currentTimeInSeconds, double timeIntervalInSeconds)
 	{
 		m_onBeginUpdateCallback(this, currentTimeInSeconds, timeIntervalInSeconds);
@@ -41,6 +41,22 @@ namespace CubbyFlow
 		}
 	}
 
+	void GridEmitterSet3::SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const
+	{
+		for (size_t i = 0; i < m_emitters.size(); ++i)
+		{
+			m_emitters[i]->SaveCheckpoint(writer, prefix + std::to_string(i) + ".");
+		}
+	}
+
+	void GridEmitterSet3::LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix)
+	{
+		for (size_t i = 0; i < m_emitters.size(); ++i)
+		{
+			m_emitters[i]->LoadCheckpoint(reader, prefix + std::to_string(i) + ".");
+		}
+	}
+
 	GridEmitterSet3::Builder GridEmitterSet3::GetBuilder()
 	{
 		return Builder();
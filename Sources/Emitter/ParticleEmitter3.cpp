@@ -52,4 +52,14 @@ namespace CubbyFlow
 	{
 		m_onBeginUpdateCallback = callback;
 	}
+
+	void ParticleEmitter3::SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const
+	{
+		// Do nothing
+	}
+
+	void ParticleEmitter3::LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix)
+	{
+		// Do nothing
+	}
 }
\ No newline at end of file
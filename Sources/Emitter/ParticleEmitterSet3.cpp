@@ -47,6 +47,22 @@ namespace CubbyFlow
 		}
 	}
 
+	void ParticleEmitterSet3::SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const
+	{
+		for (size_t i = 0; i < m_emitters.size(); ++i)
+		{
+			m_emitters[i]->SaveCheckpoint(writer, prefix + std::to_string(i) + ".");
+		}
+	}
+
+	void ParticleEmitterSet3::LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix)
+	{
+		for (size_t i = 0; i < m_emitters.size(); ++i)
+		{
+			m_emitters[i]->LoadCheckpoint(reader, prefix + std::to_string(i) + ".");
+		}
+	}
+
 	ParticleEmitterSet3::Builder ParticleEmitterSet3::GetBuilder()
 	{
 		return Builder();
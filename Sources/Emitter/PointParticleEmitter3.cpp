@@ -10,6 +10,8 @@
 #include <Matrix/Matrix3x3.h>
 #include <Utils/Samplers.h>
 
+#include <sstream>
+
 namespace CubbyFlow
 {
 	PointParticleEmitter3::PointParticleEmitter3(
@@ -111,6 +113,27 @@ namespace CubbyFlow
 		return d(m_rng);
 	}
 
+	void PointParticleEmitter3::SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const
+	{
+		writer->WriteValue(prefix + "firstFrameTimeInSeconds", m_firstFrameTimeInSeconds);
+		writer->WriteValue<uint64_t>(prefix + "numberOfEmittedParticles", m_numberOfEmittedParticles);
+
+		std::ostringstream rngState;
+		rngState << m_rng;
+		writer->WriteString(prefix + "rng", rngState.str());
+	}
+
+	void PointParticleEmitter3::LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix)
+	{
+		uint64_t numberOfEmittedParticles;
+		reader.ReadValue(prefix + "firstFrameTimeInSeconds", &m_firstFrameTimeInSeconds);
+		reader.ReadValue(prefix + "numberOfEmittedParticles", &numberOfEmittedParticles);
+		m_numberOfEmittedParticles = static_cast<size_t>(numberOfEmittedParticles);
+
+		std::istringstream rngState(reader.ReadString(prefix + "rng"));
+		rngState >> m_rng;
+	}
+
 	PointParticleEmitter3::Builder PointParticleEmitter3::GetBuilder() 
 	{
 		return Builder();
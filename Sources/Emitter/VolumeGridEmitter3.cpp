@@ -159,6 +159,18 @@ namespace CubbyFlow
 		}
 	}
 
+	void VolumeGridEmitter3::SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const
+	{
+		writer->WriteValue<uint8_t>(prefix + "hasEmitted", m_hasEmitted ? 1 : 0);
+	}
+
+	void VolumeGridEmitter3::LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix)
+	{
+		uint8_t hasEmitted;
+		reader.ReadValue(prefix + "hasEmitted", &hasEmitted);
+		m_hasEmitted = (hasEmitted != 0);
+	}
+
 	VolumeGridEmitter3::Builder VolumeGridEmitter3::GetBuilder()
 	{
 		return Builder();
@@ -9,13 +9,30 @@
 #include <Emitter/VolumeParticleEmitter3.h>
 #include <PointGenerator/BccLatticePointGenerator.h>
 #include <Searcher/PointHashGridSearcher3.h>
+#include <Searcher/PointParallelHashGridSearcher3.h>
 #include <Surface/Implicit/SurfaceToImplicit3.h>
+#include <Utils/Parallel.h>
 #include <Utils/Samplers.h>
 
 namespace CubbyFlow
 {
 	static const size_t DEFAULT_HASH_GRID_RESOLUTION = 64;
 
+	// SplitMix64 finalizer. Used as a counter-based random number generator,
+	// i.e. the n-th random number of a stream is a function of (key, n) only.
+	static uint64_t MixBits(uint64_t x)
+	{
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+		return x ^ (x >> 31);
+	}
+
+	// Returns the random number in [0, 1) at \p counter of the stream \p key.
+	static double RandomAt(uint64_t key, uint64_t counter)
+	{
+		return (MixBits(key ^ MixBits(counter)) >> 11) * (1.0 / 9007199254740992.0);
+	}
+
 	VolumeParticleEmitter3::VolumeParticleEmitter3(
 		const ImplicitSurface3Ptr& implicitSurface,
 		const BoundingBox3D& bounds,
@@ -26,7 +43,7 @@ namespace CubbyFlow
 		bool isOneShot,
 		bool allowOverlapping,
 		uint32_t seed) :
-		m_rng(seed),
+		m_seed(seed),
 		m_implicitSurface(implicitSurface),
 		m_bounds(bounds),
 		m_spacing(spacing),
@@ -67,66 +84,60 @@ namespace CubbyFlow
 		// Reserving more space for jittering
 		const double j = GetJitter();
 		const double maxJitterDist = 0.5 * j * m_spacing;
+		const bool checkOverlapping = !m_allowOverlapping && !m_isOneShot;
+		const uint64_t key = MixBits(m_seed + MixBits(m_numberOfEmissions++));
 
-		if (m_allowOverlapping || m_isOneShot)
-		{
-			m_pointsGen->ForEachPoint(m_bounds, m_spacing, [&](const Vector3D& point)
-			{
-				Vector3D randomDir = UniformSampleSphere(Random(), Random());
-				Vector3D offset = maxJitterDist * randomDir;
-				Vector3D candidate = point + offset;
-		
-				if (m_implicitSurface->SignedDistance(candidate) <= 0.0)
-				{
-					if (m_numberOfEmittedParticles < m_maxNumberOfParticles)
-					{
-						newPositions->Append(candidate);
-						++m_numberOfEmittedParticles;
-					}
-					else
-					{
-						return false;
-					}
-				}
+		const size_t numberOfPoints = m_pointsGen->NumberOfPoints(m_bounds, m_spacing);
+		Array1<Vector3D> candidates(numberOfPoints);
+		std::vector<char> isInside(numberOfPoints);
+
+		// Use parallel hash grid searcher for the existing particles.
+		PointParallelHashGridSearcher3 neighborSearcher(
+			Size3(DEFAULT_HASH_GRID_RESOLUTION, DEFAULT_HASH_GRID_RESOLUTION, DEFAULT_HASH_GRID_RESOLUTION),
+			2.0 * m_spacing);
 
-				return true;
-			});
+		if (checkOverlapping)
+		{
+			neighborSearcher.Build(particles->GetPositions());
 		}
-		else
+
+		m_pointsGen->ParallelForEachPoint(m_bounds, m_spacing, [&](size_t index, const Vector3D& point)
+		{
+			Vector3D randomDir = UniformSampleSphere(RandomAt(key, 2 * index), RandomAt(key, 2 * index + 1));
+			Vector3D offset = maxJitterDist * randomDir;
+			Vector3D candidate = point + offset;
+
+			candidates[index] = candidate;
+			isInside[index] = (m_implicitSurface->SignedDistance(candidate) <= 0.0 &&
+				(!checkOverlapping || !neighborSearcher.HasNearbyPoint(candidate, m_spacing)));
+		});
+
+		// New particles should not overlap each other either, which depends on
+		// the emission order. Accept the candidates in the generator's order
+		// using serial hash grid searcher.
+		PointHashGridSearcher3 newParticleSearcher(
+			Size3(DEFAULT_HASH_GRID_RESOLUTION, DEFAULT_HASH_GRID_RESOLUTION, DEFAULT_HASH_GRID_RESOLUTION),
+			2.0 * m_spacing);
+
+		for (size_t i = 0; i < numberOfPoints && m_numberOfEmittedParticles < m_maxNumberOfParticles; ++i)
 		{
-			// Use serial hash grid searcher for continuous update.
-			PointHashGridSearcher3 neighborSearcher(
-				Size3(DEFAULT_HASH_GRID_RESOLUTION, DEFAULT_HASH_GRID_RESOLUTION, DEFAULT_HASH_GRID_RESOLUTION),
-				2.0 * m_spacing);
-			
-			if (!m_allowOverlapping)
+			if (!isInside[i])
 			{
-				neighborSearcher.Build(particles->GetPositions());
+				continue;
 			}
 
-			m_pointsGen->ForEachPoint(m_bounds, m_spacing, [&](const Vector3D& point)
+			if (checkOverlapping)
 			{
-				Vector3D randomDir = UniformSampleSphere(Random(), Random());
-				Vector3D offset = maxJitterDist * randomDir;
-				Vector3D candidate = point + offset;
-
-				if (m_implicitSurface->SignedDistance(candidate) <= 0.0 &&
-					(!m_allowOverlapping && !neighborSearcher.HasNearbyPoint(candidate, m_spacing)))
+				if (newParticleSearcher.HasNearbyPoint(candidates[i], m_spacing))
 				{
-					if (m_numberOfEmittedParticles < m_maxNumberOfParticles)
-					{
-						newPositions->Append(candidate);
-						neighborSearcher.Add(candidate);
-						++m_numberOfEmittedParticles;
-					}
-					else
-					{
-						return false;
-					}
+					continue;
 				}
 
-				return true;
-			});
+				newParticleSearcher.Add(candidates[i]);
+			}
+
+			newPositions->Append(candidates[i]);
+			++m_numberOfEmittedParticles;
 		}
 
 		newVelocities->Resize(newPositions->size());
@@ -198,10 +209,18 @@ namespace CubbyFlow
 		m_initialVel = newInitialVel;
 	}
 
-	double VolumeParticleEmitter3::Random()
+	void VolumeParticleEmitter3::SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const
+	{
+		writer->WriteValue<uint64_t>(prefix + "numberOfEmittedParticles", m_numberOfEmittedParticles);
+		writer->WriteValue<uint64_t>(prefix + "numberOfEmissions", m_numberOfEmissions);
+	}
+
+	void VolumeParticleEmitter3::LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix)
 	{
-		std::uniform_real_distribution<> d(0.0, 1.0);
-		return d(m_rng);
+		uint64_t numberOfEmittedParticles;
+		reader.ReadValue(prefix + "numberOfEmittedParticles", &numberOfEmittedParticles);
+		m_numberOfEmittedParticles = static_cast<size_t>(numberOfEmittedParticles);
+		reader.ReadValue(prefix + "numberOfEmissions", &m_numberOfEmissions);
 	}
 
 	VolumeParticleEmitter3::Builder VolumeParticleEmitter3::GetBuilder()
@@ -306,7 +325,8 @@ namespace CubbyFlow
 				m_maxNumberOfParticles,
 				m_jitter,
 				m_isOneShot,
-				m_allowOverlapping),
+				m_allowOverlapping,
+				m_seed),
 			[](VolumeParticleEmitter3* obj)
 		{
 			delete obj;
@@ -0,0 +1,35 @@
+/*************************************************************************
+> File Name: FDMStencil3.cpp
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Temporally blocked executor of 3-D 7-point stencils.
+> Created Time: 2017/10/30
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#include <FDM/FDMStencil3.h>
+
+namespace CubbyFlow
+{
+	FDMStencil3::FDMStencil3(unsigned int temporalBlockSize, size_t cacheSizeInBytes, size_t minGridSizeInBytes) :
+		m_temporalBlockSize(std::max(temporalBlockSize, 1u)),
+		m_cacheSizeInBytes(cacheSizeInBytes),
+		m_minGridSizeInBytes(minGridSizeInBytes)
+	{
+		// Do nothing
+	}
+
+	unsigned int FDMStencil3::GetTemporalBlockSize() const
+	{
+		return m_temporalBlockSize;
+	}
+
+	size_t FDMStencil3::GetCacheSizeInBytes() const
+	{
+		return m_cacheSizeInBytes;
+	}
+
+	size_t FDMStencil3::GetMinGridSizeInBytes() const
+	{
+		return m_minGridSizeInBytes;
+	}
+}
\ No newline at end of file
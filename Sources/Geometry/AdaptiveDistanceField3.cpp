@@ -0,0 +1,336 @@
+/*************************************************************************
+> File Name: AdaptiveDistanceField3.cpp
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: 3-D adaptively sampled distance field.
+> Created Time: 2017/10/25
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#include <Geometry/AdaptiveDistanceField3.h>
+#include <Utils/Parallel.h>
+
+#include <algorithm>
+
+namespace CubbyFlow
+{
+	// Cells shallower than this depth are always subdivided so that features
+	// smaller than the domain are not missed by the error test.
+	static const unsigned int MIN_DEPTH = 3;
+
+	// Corner coordinates at the finest level are packed into 63 bits.
+	static const unsigned int MAX_DEPTH = 20;
+
+	static const size_t LEAF_FLAG = static_cast<size_t>(1) << (8 * sizeof(size_t) - 1);
+
+	// Returns the trilinear weight of the corner at fraction f within a cell.
+	// The corner index has x, y, and z offset at bit 0, 1, and 2 respectively.
+	static double TrilinearWeight(size_t corner, const Vector3D& f)
+	{
+		return ((corner & 1) ? f.x : 1.0 - f.x) *
+			((corner & 2) ? f.y : 1.0 - f.y) *
+			((corner & 4) ? f.z : 1.0 - f.z);
+	}
+
+	AdaptiveDistanceField3::AdaptiveDistanceField3(
+		const std::function<double(const Vector3D&)>& func, const BoundingBox3D& domain,
+		unsigned int maxDepth, double tolerance, double resolution) :
+		m_domain(domain), m_maxDepth(std::min(maxDepth, MAX_DEPTH))
+	{
+		struct BuildCell
+		{
+			size_t node;
+			BoundingBox3D box;
+			std::array<double, 8> corners;
+
+			// Lower corner in the units of the finest cell size
+			size_t i, j, k;
+		};
+
+		// Index of the (a, b, c)-th point of the 3x3x3 lattice spanning a cell.
+		// The lattice of a cell holds the corners of its eight children.
+		const auto latticeIndex = [](size_t a, size_t b, size_t c)
+		{
+			return a + 3 * (b + 3 * c);
+		};
+
+		BuildCell root;
+		root.node = 0;
+		root.box = domain;
+		root.i = root.j = root.k = 0;
+		for (size_t o = 0; o < 8; ++o)
+		{
+			root.corners[o] = func(domain.Corner(o));
+		}
+
+		m_nodes.push_back(0);
+
+		std::vector<BuildCell> level(1, root);
+
+		// (corner key, leaf * 8 + corner) pairs
+		std::vector<std::pair<size_t, size_t>> leafCorners;
+		std::vector<double> leafDistances;
+		const size_t finestSize = static_cast<size_t>(1) << m_maxDepth;
+		const auto cornerKey = [finestSize](size_t i, size_t j, size_t k)
+		{
+			return i + (finestSize + 1) * (j + (finestSize + 1) * k);
+		};
+
+		for (unsigned int depth = 0; !level.empty(); ++depth)
+		{
+			const size_t cellSize = finestSize >> depth;
+
+			std::vector<std::array<double, 27>> lattices;
+			std::vector<char> subdivide(level.size(), 0);
+
+			if (depth < m_maxDepth)
+			{
+				lattices.resize(level.size());
+
+				ParallelFor(ZERO_SIZE, level.size(), [&](size_t n)
+				{
+					const BuildCell& cell = level[n];
+					const Vector3D halfSize = 0.5 * (cell.box.upperCorner - cell.box.lowerCorner);
+					std::array<double, 27>& lattice = lattices[n];
+					double maxError = 0.0;
+
+					for (size_t c = 0; c < 3; ++c)
+					{
+						for (size_t b = 0; b < 3; ++b)
+						{
+							for (size_t a = 0; a < 3; ++a)
+							{
+								if (a != 1 && b != 1 && c != 1)
+								{
+									lattice[latticeIndex(a, b, c)] = cell.corners[a / 2 + 2 * (b / 2) + 4 * (c / 2)];
+									continue;
+								}
+
+								const double value = func(cell.box.lowerCorner + halfSize * Vector3D(
+									static_cast<double>(a), static_cast<double>(b), static_cast<double>(c)));
+								double approx = 0.0;
+								for (size_t o = 0; o < 8; ++o)
+								{
+									approx += TrilinearWeight(o, 0.5 * Vector3D(
+										static_cast<double>(a), static_cast<double>(b), static_cast<double>(c))) * cell.corners[o];
+								}
+
+								lattice[latticeIndex(a, b, c)] = value;
+								maxError = std::max(maxError, std::fabs(value - approx));
+							}
+						}
+					}
+
+					subdivide[n] = (depth < MIN_DEPTH || maxError > tolerance) ? 1 : 0;
+				});
+			}
+
+			std::vector<BuildCell> nextLevel;
+
+			for (size_t n = 0; n < level.size(); ++n)
+			{
+				const BuildCell& cell = level[n];
+
+				if (!subdivide[n])
+				{
+					const size_t leaf = m_leaves.size();
+					m_nodes[cell.node] = LEAF_FLAG | leaf;
+					m_leaves.emplace_back();
+
+					for (size_t o = 0; o < 8; ++o)
+					{
+						leafCorners.emplace_back(cornerKey(
+							cell.i + (o & 1) * cellSize,
+							cell.j + ((o >> 1) & 1) * cellSize,
+							cell.k + ((o >> 2) & 1) * cellSize), 8 * leaf + o);
+						leafDistances.push_back(cell.corners[o]);
+					}
+					continue;
+				}
+
+				const size_t firstChild = m_nodes.size();
+				const Vector3D midPoint = cell.box.MidPoint();
+				m_nodes[cell.node] = firstChild;
+				m_nodes.resize(firstChild + 8, 0);
+
+				for (size_t o = 0; o < 8; ++o)
+				{
+					BuildCell child;
+					child.node = firstChild + o;
+					child.box = cell.box;
+					(o & 1 ? child.box.lowerCorner.x : child.box.upperCorner.x) = midPoint.x;
+					(o & 2 ? child.box.lowerCorner.y : child.box.upperCorner.y) = midPoint.y;
+					(o & 4 ? child.box.lowerCorner.z : child.box.upperCorner.z) = midPoint.z;
+					child.i = cell.i + (o & 1) * cellSize / 2;
+					child.j = cell.j + ((o >> 1) & 1) * cellSize / 2;
+					child.k = cell.k + ((o >> 2) & 1) * cellSize / 2;
+
+					for (size_t q = 0; q < 8; ++q)
+					{
+						child.corners[q] = lattices[n][latticeIndex(
+							(o & 1) + (q & 1), ((o >> 1) & 1) + ((q >> 1) & 1), ((o >> 2) & 1) + ((q >> 2) & 1))];
+					}
+
+					nextLevel.push_back(child);
+				}
+			}
+
+			level.swap(nextLevel);
+		}
+
+		m_nodes.shrink_to_fit();
+		m_leaves.shrink_to_fit();
+
+		// Merge the corners shared by the adjacent leaves
+		std::sort(leafCorners.begin(), leafCorners.end());
+
+		std::vector<size_t> cornerKeys;
+		for (const auto& leafCorner : leafCorners)
+		{
+			if (cornerKeys.empty() || cornerKeys.back() != leafCorner.first)
+			{
+				cornerKeys.push_back(leafCorner.first);
+				m_corners.push_back(Corner{ leafDistances[leafCorner.second], Vector3D() });
+			}
+
+			m_leaves[leafCorner.second / 8][leafCorner.second % 8] = m_corners.size() - 1;
+		}
+
+		// Cache the gradients at the corners
+		const Vector3D finestCellSize = (domain.upperCorner - domain.lowerCorner) / static_cast<double>(finestSize);
+		const double h = 0.5 * resolution;
+		ParallelFor(ZERO_SIZE, m_corners.size(), [&](size_t n)
+		{
+			const size_t key = cornerKeys[n];
+			const Vector3D x = domain.lowerCorner + finestCellSize * Vector3D(
+				static_cast<double>(key % (finestSize + 1)),
+				static_cast<double>((key / (finestSize + 1)) % (finestSize + 1)),
+				static_cast<double>(key / ((finestSize + 1) * (finestSize + 1))));
+
+			m_corners[n].gradient = Vector3D(
+				func(x + Vector3D(h, 0.0, 0.0)) - func(x - Vector3D(h, 0.0, 0.0)),
+				func(x + Vector3D(0.0, h, 0.0)) - func(x - Vector3D(0.0, h, 0.0)),
+				func(x + Vector3D(0.0, 0.0, h)) - func(x - Vector3D(0.0, 0.0, h))) / resolution;
+		});
+	}
+
+	double AdaptiveDistanceField3::Sample(const Vector3D& pt) const
+	{
+		BoundingBox3D cell;
+		const Vector3D x = Clamp(pt, m_domain.lowerCorner, m_domain.upperCorner);
+		const std::array<size_t, 8>& leaf = FindLeaf(x, &cell);
+		const Vector3D f = (x - cell.lowerCorner) / (cell.upperCorner - cell.lowerCorner);
+
+		double result = 0.0;
+
+		for (size_t o = 0; o < 8; ++o)
+		{
+			result += TrilinearWeight(o, f) * m_corners[leaf[o]].distance;
+		}
+
+		return result;
+	}
+
+	Vector3D AdaptiveDistanceField3::Gradient(const Vector3D& pt) const
+	{
+		BoundingBox3D cell;
+		const Vector3D x = Clamp(pt, m_domain.lowerCorner, m_domain.upperCorner);
+		const std::array<size_t, 8>& leaf = FindLeaf(x, &cell);
+		const Vector3D f = (x - cell.lowerCorner) / (cell.upperCorner - cell.lowerCorner);
+
+		Vector3D result;
+
+		for (size_t o = 0; o < 8; ++o)
+		{
+			result += TrilinearWeight(o, f) * m_corners[leaf[o]].gradient;
+		}
+
+		return result;
+	}
+
+	void AdaptiveDistanceField3::Sample(const Vector3D& pt, double* distance, Vector3D* gradient) const
+	{
+		BoundingBox3D cell;
+		const Vector3D x = Clamp(pt, m_domain.lowerCorner, m_domain.upperCorner);
+		const std::array<size_t, 8>& leaf = FindLeaf(x, &cell);
+		const Vector3D f = (x - cell.lowerCorner) / (cell.upperCorner - cell.lowerCorner);
+
+		*distance = 0.0;
+		*gradient = Vector3D();
+
+		for (size_t o = 0; o < 8; ++o)
+		{
+			const double weight = TrilinearWeight(o, f);
+			const Corner& corner = m_corners[leaf[o]];
+
+			*distance += weight * corner.distance;
+			*gradient += weight * corner.gradient;
+		}
+	}
+
+	const BoundingBox3D& AdaptiveDistanceField3::Domain() const
+	{
+		return m_domain;
+	}
+
+	unsigned int AdaptiveDistanceField3::MaxDepth() const
+	{
+		return m_maxDepth;
+	}
+
+	size_t AdaptiveDistanceField3::NumberOfLeaves() const
+	{
+		return m_leaves.size();
+	}
+
+	size_t AdaptiveDistanceField3::MemoryUsage() const
+	{
+		return m_nodes.size() * sizeof(size_t) + m_leaves.size() * sizeof(std::array<size_t, 8>) + m_corners.size() * sizeof(Corner);
+	}
+
+	const std::array<size_t, 8>& AdaptiveDistanceField3::FindLeaf(const Vector3D& pt, BoundingBox3D* cell) const
+	{
+		BoundingBox3D box = m_domain;
+		size_t node = 0;
+
+		while (!(m_nodes[node] & LEAF_FLAG))
+		{
+			const Vector3D midPoint = box.MidPoint();
+			size_t octant = 0;
+
+			if (pt.x >= midPoint.x)
+			{
+				octant |= 1;
+				box.lowerCorner.x = midPoint.x;
+			}
+			else
+			{
+				box.upperCorner.x = midPoint.x;
+			}
+
+			if (pt.y >= midPoint.y)
+			{
+				octant |= 2;
+				box.lowerCorner.y = midPoint.y;
+			}
+			else
+			{
+				box.upperCorner.y = midPoint.y;
+			}
+
+			if (pt.z >= midPoint.z)
+			{
+				octant |= 4;
+				box.lowerCorner.z = midPoint.z;
+			}
+			else
+			{
+				box.upperCorner.z = midPoint.z;
+			}
+
+			node = m_nodes[node] + octant;
+		}
+
+		*cell = box;
+		return m_leaves[m_nodes[node] & ~LEAF_FLAG];
+	}
+}
\ No newline at end of file
@@ -18,26 +18,19 @@ namespace CubbyFlow
 		bool isNormalFlipped) :
 		ImplicitSurface3(transform, isNormalFlipped), m_mesh(mesh)
 	{
-		BoundingBox3D box = m_mesh->BoundingBox();
-		Vector3D scale(box.Width(), box.Height(), box.Depth());
-		box.lowerCorner -= margin * scale;
-		box.upperCorner += margin * scale;
-
-		size_t resolutionY = static_cast<size_t>(std::ceil(resolutionX * box.Height() / box.Width()));
-		size_t resolutionZ = static_cast<size_t>(std::ceil(resolutionX * box.Depth() / box.Width()));
+		m_grid = BakeSignedDistanceField(*m_mesh, resolutionX, margin);
 
-		double dx = box.Width() / resolutionX;
-
-		m_grid = std::make_shared<VertexCenteredScalarGrid3>();
-		m_grid->Resize(resolutionX, resolutionY, resolutionZ, dx, dx, dx, box.lowerCorner.x, box.lowerCorner.y, box.lowerCorner.z);
-
-		TriangleMeshToSDF(*m_mesh, m_grid.get());
+		BuildCustomImplicitSurface();
+	}
 
-		m_customImplicitSurface = CustomImplicitSurface3::Builder()
-			.WithSignedDistanceFunction([&](const Vector3D& pt) -> double { return m_grid->Sample(pt); })
-			.WithDomain(m_grid->BoundingBox())
-			.WithResolution(dx)
-			.MakeShared();
+	ImplicitTriangleMesh3::ImplicitTriangleMesh3(
+		const TriangleMesh3Ptr& mesh,
+		const VertexCenteredScalarGrid3Ptr& grid,
+		const Transform3& transform,
+		bool isNormalFlipped) :
+		ImplicitSurface3(transform, isNormalFlipped), m_mesh(mesh), m_grid(grid)
+	{
+		BuildCustomImplicitSurface();
 	}
 
 	ImplicitTriangleMesh3::~ImplicitTriangleMesh3()
@@ -80,6 +73,40 @@ namespace CubbyFlow
 		return m_customImplicitSurface->ClosestIntersection(ray);
 	}
 
+	VertexCenteredScalarGrid3Ptr ImplicitTriangleMesh3::BakeSignedDistanceField(
+		const TriangleMesh3& mesh, size_t resolutionX, double margin)
+	{
+		BoundingBox3D box = mesh.BoundingBox();
+		Vector3D scale(box.Width(), box.Height(), box.Depth());
+		box.lowerCorner -= margin * scale;
+		box.upperCorner += margin * scale;
+
+		size_t resolutionY = static_cast<size_t>(std::ceil(resolutionX * box.Height() / box.Width()));
+		size_t resolutionZ = static_cast<size_t>(std::ceil(resolutionX * box.Depth() / box.Width()));
+
+		double dx = box.Width() / resolutionX;
+
+		auto grid = std::make_shared<VertexCenteredScalarGrid3>();
+		grid->Resize(resolutionX, resolutionY, resolutionZ, dx, dx, dx, box.lowerCorner.x, box.lowerCorner.y, box.lowerCorner.z);
+
+		TriangleMeshToSDF(mesh, grid.get());
+
+		return grid;
+	}
+
+	void ImplicitTriangleMesh3::BuildCustomImplicitSurface()
+	{
+		// Capture the grid by value so that the samples do not depend on this
+		// instance staying at the same address
+		VertexCenteredScalarGrid3Ptr grid = m_grid;
+
+		m_customImplicitSurface = CustomImplicitSurface3::Builder()
+			.WithSignedDistanceFunction([grid](const Vector3D& pt) -> double { return grid->Sample(pt); })
+			.WithDomain(m_grid->BoundingBox())
+			.WithResolution(m_grid->GridSpacing().x)
+			.MakeShared();
+	}
+
 	ImplicitTriangleMesh3::Builder ImplicitTriangleMesh3::GetBuilder()
 	{
 		return ImplicitTriangleMesh3::Builder();
@@ -108,14 +135,27 @@ namespace CubbyFlow
 		return *this;
 	}
 
+	ImplicitTriangleMesh3::Builder& ImplicitTriangleMesh3::Builder::WithSignedDistanceField(const VertexCenteredScalarGrid3Ptr& grid)
+	{
+		m_grid = grid;
+		return *this;
+	}
+
 	ImplicitTriangleMesh3 ImplicitTriangleMesh3::Builder::Build() const
 	{
+		if (m_grid != nullptr)
+		{
+			return ImplicitTriangleMesh3(m_mesh, m_grid, m_transform, m_isNormalFlipped);
+		}
+
 		return ImplicitTriangleMesh3(m_mesh, m_resolutionX, m_margin, m_transform, m_isNormalFlipped);
 	}
 
 	ImplicitTriangleMesh3Ptr ImplicitTriangleMesh3::Builder::MakeShared() const
 	{
 		return std::shared_ptr<ImplicitTriangleMesh3>(
+			(m_grid != nullptr) ?
+			new ImplicitTriangleMesh3(m_mesh, m_grid, m_transform, m_isNormalFlipped) :
 			new ImplicitTriangleMesh3(m_mesh, m_resolutionX, m_margin, m_transform, m_isNormalFlipped),
 			[](ImplicitTriangleMesh3* obj)
 		{
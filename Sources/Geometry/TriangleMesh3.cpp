@@ -13,6 +13,7 @@
 #include <obj/obj_parser.hpp>
 
 #include <cassert>
+#include <cstring>
 #include <iostream>
 
 namespace CubbyFlow
@@ -552,19 +553,19 @@ namespace CubbyFlow
 		// vertex
 		for (const auto& pt : m_points)
 		{
-			*stream << "v " << pt << std::endl;
+			*stream << "v " << pt << '\n';
 		}
 
 		// UV coordinates
 		for (const auto& uv : m_uvs)
 		{
-			*stream << "vt " << uv << std::endl;
+			*stream << "vt " << uv << '\n';
 		}
 
 		// normals
 		for (const auto& n : m_normals)
 		{
-			*stream << "vn " << n << std::endl;
+			*stream << "vn " << n << '\n';
 		}
 
 		// faces
@@ -595,10 +596,82 @@ namespace CubbyFlow
 				*stream << ' ';
 			}
 
-			*stream << std::endl;
+			*stream << '\n';
 		}
 	}
 
+	void TriangleMesh3::WritePly(std::ostream* strm) const
+	{
+		bool hasVertexNormals = (NumberOfNormals() == NumberOfPoints() && m_normalIndices.size() == m_pointIndices.size());
+		for (size_t i = 0; i < NumberOfTriangles() && hasVertexNormals; ++i)
+		{
+			hasVertexNormals = (m_normalIndices[i] == m_pointIndices[i]);
+		}
+
+		*strm << "ply\n"
+			<< "format binary_little_endian 1.0\n"
+			<< "element vertex " << NumberOfPoints() << '\n'
+			<< "property float x\nproperty float y\nproperty float z\n";
+
+		if (hasVertexNormals)
+		{
+			*strm << "property float nx\nproperty float ny\nproperty float nz\n";
+		}
+
+		*strm << "element face " << NumberOfTriangles() << '\n'
+			<< "property list uchar uint vertex_indices\n"
+			<< "end_header\n";
+
+		const size_t vertexSize = (hasVertexNormals ? 6 : 3) * sizeof(uint32_t);
+		const size_t faceSize = 1 + 3 * sizeof(uint32_t);
+		std::vector<unsigned char> buffer(NumberOfPoints() * vertexSize + NumberOfTriangles() * faceSize);
+
+		// Stores the bits in little-endian regardless of the host.
+		const auto store = [](uint32_t bits, unsigned char* out)
+		{
+			out[0] = static_cast<unsigned char>(bits);
+			out[1] = static_cast<unsigned char>(bits >> 8);
+			out[2] = static_cast<unsigned char>(bits >> 16);
+			out[3] = static_cast<unsigned char>(bits >> 24);
+		};
+		const auto storeFloat = [&](double value, unsigned char* out)
+		{
+			const float f = static_cast<float>(value);
+			uint32_t bits;
+			memcpy(&bits, &f, sizeof(bits));
+			store(bits, out);
+		};
+
+		ParallelFor(ZERO_SIZE, NumberOfPoints(), [&](size_t i)
+		{
+			unsigned char* out = buffer.data() + i * vertexSize;
+
+			for (size_t j = 0; j < 3; ++j)
+			{
+				storeFloat(m_points[i][j], out + 4 * j);
+
+				if (hasVertexNormals)
+				{
+					storeFloat(m_normals[i][j], out + 4 * (j + 3));
+				}
+			}
+		});
+
+		unsigned char* faces = buffer.data() + NumberOfPoints() * vertexSize;
+		ParallelFor(ZERO_SIZE, NumberOfTriangles(), [&](size_t i)
+		{
+			unsigned char* out = faces + i * faceSize;
+			out[0] = 3;
+
+			for (size_t j = 0; j < 3; ++j)
+			{
+				store(static_cast<uint32_t>(m_pointIndices[i][j]), out + 1 + 4 * j);
+			}
+		});
+
+		strm->write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+	}
+
 	bool TriangleMesh3::ReadObj(std::istream* stream)
 	{
 		obj::obj_parser parser(obj::obj_parser::triangulate_faces | obj::obj_parser::translate_negative_indices);
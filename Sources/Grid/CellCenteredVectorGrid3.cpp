@@ -92,15 +92,16 @@ namespace CubbyFlow
 	{
 		Size3 size = GetDataSize();
 		auto acc = GetDataAccessor();
-		DataPositionFunc pos = GetDataPosition();
+		const Vector3D o = GetDataOrigin();
+		const Vector3D h = GridSpacing();
 
 		ParallelFor(
 			ZERO_SIZE, size.x,
 			ZERO_SIZE, size.y,
 			ZERO_SIZE, size.z,
-			[this, &func, &acc, &pos](size_t i, size_t j, size_t k)
+			[&func, &acc, &o, &h](size_t i, size_t j, size_t k)
 		{
-			acc(i, j, k) = func(pos(i, j, k));
+			acc(i, j, k) = func(o + h * Vector3D({ i, j, k }));
 		});
 	}
 
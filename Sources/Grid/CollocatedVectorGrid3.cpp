@@ -145,16 +145,6 @@ namespace CubbyFlow
 		};
 	}
 
-	void CollocatedVectorGrid3::ForEachDataPointIndex(const std::function<void(size_t, size_t, size_t)>& func) const
-	{
-		m_data.ForEachIndex(func);
-	}
-
-	void CollocatedVectorGrid3::ParallelForEachDataPointIndex(const std::function<void(size_t, size_t, size_t)>& func) const
-	{
-		m_data.ParallelForEachIndex(func);
-	}
-
 	void CollocatedVectorGrid3::SwapCollocatedVectorGrid(CollocatedVectorGrid3* other)
 	{
 		SwapGrid(other);
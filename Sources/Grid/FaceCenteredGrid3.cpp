@@ -328,34 +328,35 @@ namespace CubbyFlow
 
 	void FaceCenteredGrid3::Fill(const std::function<Vector3D(const Vector3D&)>& func)
 	{
-		DataPositionFunc uPos = GetUPosition();
+		// Computes the positions inline instead of through GetUPosition() and
+		// friends to save a type-erased call per face
+		const Vector3D h = GridSpacing();
+
 		ParallelFor(
 			ZERO_SIZE, m_dataU.Width(),
 			ZERO_SIZE, m_dataU.Height(),
 			ZERO_SIZE, m_dataU.Depth(),
-			[this, &func, &uPos](size_t i, size_t j, size_t k)
+			[this, &func, &h](size_t i, size_t j, size_t k)
 		{
-			m_dataU(i, j, k) = func(uPos(i, j, k)).x;
+			m_dataU(i, j, k) = func(m_dataOriginU + h * Vector3D({ i, j, k })).x;
 		});
 		
-		DataPositionFunc vPos = GetVPosition();
 		ParallelFor(
 			ZERO_SIZE, m_dataV.Width(),
 			ZERO_SIZE, m_dataV.Height(),
 			ZERO_SIZE, m_dataV.Depth(),
-			[this, &func, &vPos](size_t i, size_t j, size_t k)
+			[this, &func, &h](size_t i, size_t j, size_t k)
 		{
-			m_dataV(i, j, k) = func(vPos(i, j, k)).y;
+			m_dataV(i, j, k) = func(m_dataOriginV + h * Vector3D({ i, j, k })).y;
 		});
 		
-		DataPositionFunc wPos = GetWPosition();
 		ParallelFor(
 			ZERO_SIZE, m_dataW.Width(),
 			ZERO_SIZE, m_dataW.Height(),
 			ZERO_SIZE, m_dataW.Depth(),
-			[this, &func, &wPos](size_t i, size_t j, size_t k)
+			[this, &func, &h](size_t i, size_t j, size_t k)
 		{
-			m_dataW(i, j, k) = func(wPos(i, j, k)).z;
+			m_dataW(i, j, k) = func(m_dataOriginW + h * Vector3D({ i, j, k })).z;
 		});
 	}
 
@@ -368,36 +369,6 @@ namespace CubbyFlow
 		});
 	}
 
-	void FaceCenteredGrid3::ForEachUIndex(const std::function<void(size_t, size_t, size_t)>& func) const
-	{
-		m_dataU.ForEachIndex(func);
-	}
-
-	void FaceCenteredGrid3::ParallelForEachUIndex(const std::function<void(size_t, size_t, size_t)>& func) const
-	{
-		m_dataU.ParallelForEachIndex(func);
-	}
-
-	void FaceCenteredGrid3::ForEachVIndex(const std::function<void(size_t, size_t, size_t)>& func) const
-	{
-		m_dataV.ForEachIndex(func);
-	}
-
-	void FaceCenteredGrid3::ParallelForEachVIndex(const std::function<void(size_t, size_t, size_t)>& func) const
-	{
-		m_dataV.ParallelForEachIndex(func);
-	}
-
-	void FaceCenteredGrid3::ForEachWIndex(const std::function<void(size_t, size_t, size_t)>& func) const
-	{
-		m_dataW.ForEachIndex(func);
-	}
-
-	void FaceCenteredGrid3::ParallelForEachWIndex(const std::function<void(size_t, size_t, size_t)>& func) const
-	{
-		m_dataW.ParallelForEachIndex(func);
-	}
-
 	Vector3D FaceCenteredGrid3::Sample(const Vector3D& x) const
 	{
 		return m_sampler(x);
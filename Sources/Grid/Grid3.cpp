@@ -7,7 +7,6 @@
 > Copyright (c) 2017, Chan-Ho Chris Ohk
 *************************************************************************/
 #include <Grid/Grid3.h>
-#include <Utils/Serial.h>
 
 namespace CubbyFlow
 {
@@ -52,30 +51,6 @@ namespace CubbyFlow
 		};
 	}
 
-	void Grid3::ForEachCellIndex(const std::function<void(size_t, size_t, size_t)>& func) const
-	{
-		SerialFor(
-			ZERO_SIZE, m_resolution.x,
-			ZERO_SIZE, m_resolution.y,
-			ZERO_SIZE, m_resolution.z,
-			[this, &func](size_t i, size_t j, size_t k)
-		{
-			func(i, j, k);
-		});
-	}
-
-	void Grid3::ParallelForEachCellIndex(const std::function<void(size_t, size_t, size_t)>& func) const
-	{
-		ParallelFor(
-			ZERO_SIZE, m_resolution.x,
-			ZERO_SIZE, m_resolution.y,
-			ZERO_SIZE, m_resolution.z,
-			[this, &func](size_t i, size_t j, size_t k)
-		{
-			func(i, j, k);
-		});
-	}
-
 	bool Grid3::HasSameShape(const Grid3& other) const
 	{
 		return m_resolution.x == other.m_resolution.x
@@ -6,6 +6,7 @@
 > Created Time: 2017/08/05
 > Copyright (c) 2017, Chan-Ho Chris Ohk
 *************************************************************************/
+#include <Grid/CollocatedVectorGrid3.h>
 #include <Grid/GridSystemData3.h>
 #include <Utils/Factory.h>
 #include <Utils/FlatbuffersHelper.h>
@@ -242,4 +243,123 @@ namespace CubbyFlow
 		m_velocityIdx = static_cast<size_t>(gsd->velocityIdx());
 		m_velocity = std::dynamic_pointer_cast<FaceCenteredGrid3>(m_advectableVectorDataList[m_velocityIdx]);
 	}
-}
\ No newline at end of file
+
+	static void SaveGrid(CheckpointWriter* writer, const std::string& prefix, const ScalarGrid3Ptr& grid)
+	{
+		writer->WriteString(prefix + "type", grid->TypeName());
+		writer->WriteArray(prefix + "data", grid->GetConstDataAccessor());
+	}
+
+	static void SaveGrid(CheckpointWriter* writer, const std::string& prefix, const VectorGrid3Ptr& grid)
+	{
+		writer->WriteString(prefix + "type", grid->TypeName());
+
+		if (auto faceCentered = std::dynamic_pointer_cast<FaceCenteredGrid3>(grid))
+		{
+			writer->WriteArray(prefix + "u", faceCentered->GetUConstAccessor());
+			writer->WriteArray(prefix + "v", faceCentered->GetVConstAccessor());
+			writer->WriteArray(prefix + "w", faceCentered->GetWConstAccessor());
+		}
+		else if (auto collocated = std::dynamic_pointer_cast<CollocatedVectorGrid3>(grid))
+		{
+			writer->WriteArray(prefix + "data", collocated->GetConstDataAccessor());
+		}
+		else
+		{
+			std::vector<uint8_t> buffer;
+			grid->Serialize(&buffer);
+			writer->WriteChunk(prefix + "serialized", buffer.data(), buffer.size());
+		}
+	}
+
+	static void LoadGrid(const CheckpointReader& reader, const std::string& prefix, ScalarGrid3Ptr* grid)
+	{
+		reader.ReadArray(prefix + "data", (*grid)->GetDataAccessor());
+	}
+
+	static void LoadGrid(const CheckpointReader& reader, const std::string& prefix, VectorGrid3Ptr* grid)
+	{
+		if (auto faceCentered = std::dynamic_pointer_cast<FaceCenteredGrid3>(*grid))
+		{
+			reader.ReadArray(prefix + "u", faceCentered->GetUAccessor());
+			reader.ReadArray(prefix + "v", faceCentered->GetVAccessor());
+			reader.ReadArray(prefix + "w", faceCentered->GetWAccessor());
+		}
+		else if (auto collocated = std::dynamic_pointer_cast<CollocatedVectorGrid3>(*grid))
+		{
+			reader.ReadArray(prefix + "data", collocated->GetDataAccessor());
+		}
+		else
+		{
+			auto view = reader.ViewArray<uint8_t>(prefix + "serialized");
+			(*grid)->Deserialize(std::vector<uint8_t>(view.begin(), view.end()));
+		}
+	}
+
+	template <typename GridType>
+	static void SaveGridList(CheckpointWriter* writer, const std::string& prefix, const std::vector<GridType>& gridList)
+	{
+		writer->WriteValue<uint64_t>(prefix + "count", gridList.size());
+
+		for (size_t i = 0; i < gridList.size(); ++i)
+		{
+			SaveGrid(writer, prefix + std::to_string(i) + ".", gridList[i]);
+		}
+	}
+
+	template <typename GridType, typename FactoryFunc>
+	static void LoadGridList(
+		const CheckpointReader& reader, const std::string& prefix,
+		const Size3& resolution, const Vector3D& gridSpacing, const Vector3D& origin,
+		FactoryFunc factoryFunc, std::vector<GridType>* gridList)
+	{
+		uint64_t count;
+		reader.ReadValue(prefix + "count", &count);
+		gridList->resize(static_cast<size_t>(count));
+
+		for (size_t i = 0; i < gridList->size(); ++i)
+		{
+			const std::string gridPrefix = prefix + std::to_string(i) + ".";
+			const std::string type = reader.ReadString(gridPrefix + "type");
+			GridType& grid = (*gridList)[i];
+
+			if (grid == nullptr || grid->TypeName() != type)
+			{
+				grid = factoryFunc(type);
+			}
+
+			grid->Resize(resolution, gridSpacing, origin);
+			LoadGrid(reader, gridPrefix, &grid);
+		}
+	}
+
+	void GridSystemData3::SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const
+	{
+		writer->WriteValue(prefix + "resolution", m_resolution);
+		writer->WriteValue(prefix + "gridSpacing", m_gridSpacing);
+		writer->WriteValue(prefix + "origin", m_origin);
+		writer->WriteValue<uint64_t>(prefix + "velocityIdx", m_velocityIdx);
+
+		SaveGridList(writer, prefix + "scalarData.", m_scalarDataList);
+		SaveGridList(writer, prefix + "vectorData.", m_vectorDataList);
+		SaveGridList(writer, prefix + "advectableScalarData.", m_advectableScalarDataList);
+		SaveGridList(writer, prefix + "advectableVectorData.", m_advectableVectorDataList);
+	}
+
+	void GridSystemData3::LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix)
+	{
+		uint64_t velocityIdx;
+		reader.ReadValue(prefix + "resolution", &m_resolution);
+		reader.ReadValue(prefix + "gridSpacing", &m_gridSpacing);
+		reader.ReadValue(prefix + "origin", &m_origin);
+		reader.ReadValue(prefix + "velocityIdx", &velocityIdx);
+
+		LoadGridList(reader, prefix + "scalarData.", m_resolution, m_gridSpacing, m_origin, Factory::BuildScalarGrid3, &m_scalarDataList);
+		LoadGridList(reader, prefix + "vectorData.", m_resolution, m_gridSpacing, m_origin, Factory::BuildVectorGrid3, &m_vectorDataList);
+		LoadGridList(reader, prefix + "advectableScalarData.", m_resolution, m_gridSpacing, m_origin, Factory::BuildScalarGrid3, &m_advectableScalarDataList);
+		LoadGridList(reader, prefix + "advectableVectorData.", m_resolution, m_gridSpacing, m_origin, Factory::BuildVectorGrid3, &m_advectableVectorDataList);
+
+		m_velocityIdx = static_cast<size_t>(velocityIdx);
+		m_velocity = std::dynamic_pointer_cast<FaceCenteredGrid3>(m_advectableVectorDataList[m_velocityIdx]);
+	}
+}
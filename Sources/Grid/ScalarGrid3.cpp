@@ -166,28 +166,21 @@ namespace CubbyFlow
 
 	void ScalarGrid3::Fill(const std::function<double(const Vector3D&)>& func)
 	{
-		DataPositionFunc pos = GetDataPosition();
-		
+		// Computes the positions inline instead of through GetDataPosition()
+		// to save a type-erased call per data point
+		const Vector3D o = GetDataOrigin();
+		const Vector3D h = GridSpacing();
+
 		ParallelFor(
 			ZERO_SIZE, m_data.Width(),
 			ZERO_SIZE, m_data.Height(),
 			ZERO_SIZE, m_data.Depth(),
-			[this, &func, &pos](size_t i, size_t j, size_t k)
+			[this, &func, &o, &h](size_t i, size_t j, size_t k)
 		{
-			m_data(i, j, k) = func(pos(i, j, k));
+			m_data(i, j, k) = func(o + h * Vector3D({ i, j, k }));
 		});
 	}
 
-	void ScalarGrid3::ForEachDataPointIndex(const std::function<void(size_t, size_t, size_t)>& func) const
-	{
-		m_data.ForEachIndex(func);
-	}
-
-	void ScalarGrid3::ParallelForEachDataPointIndex(const std::function<void(size_t, size_t, size_t)>& func) const
-	{
-		m_data.ParallelForEachIndex(func);
-	}
-
 	void ScalarGrid3::Serialize(std::vector<uint8_t>* buffer) const
 	{
 		flatbuffers::FlatBufferBuilder builder(1024);
@@ -97,6 +97,21 @@ namespace CubbyFlow
 		return ret;
 	}
 
+	inline bool IsCrossingIsoSurface(const std::array<double, 8>& data, double isoValue)
+	{
+		const bool isInside = (data[0] <= isoValue);
+
+		for (size_t i = 1; i < 8; ++i)
+		{
+			if ((data[i] <= isoValue) != isInside)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
 	inline Vector3D SafeNormalize(const Vector3D& n)
 	{
 		if (n.LengthSquared() > 0.0)
@@ -435,6 +450,13 @@ namespace CubbyFlow
 					data[7] = grid(i, j + 1, k + 1);
 					data[6] = grid(i + 1, j + 1, k + 1);
 
+					// Most cells are away from the surface. Skip them before
+					// computing the normals and the edge IDs.
+					if (!IsCrossingIsoSurface(data, isoValue))
+					{
+						continue;
+					}
+
 					normals[0] = Grad(grid, i, j, k, invGridSize);
 					normals[1] = Grad(grid, i + 1, j, k, invGridSize);
 					normals[4] = Grad(grid, i, j + 1, k, invGridSize);
@@ -18,6 +18,8 @@
 
 #include <Flatbuffers/generated/ParticleSystemData3_generated.h>
 
+#include <stdexcept>
+
 namespace CubbyFlow
 {
 	static const size_t DEFAULT_HASH_GRID_RESOLUTION = 64;
@@ -74,20 +76,61 @@ namespace CubbyFlow
 		return m_numberOfParticles;
 	}
 
+	size_t ParticleSystemData3::NumberOfScalarData() const
+	{
+		return m_scalarDataList.size();
+	}
+
+	size_t ParticleSystemData3::NumberOfVectorData() const
+	{
+		return m_vectorDataList.size();
+	}
+
 	size_t ParticleSystemData3::AddScalarData(double initialVal)
 	{
 		size_t attrIdx = m_scalarDataList.size();
-		m_scalarDataList.emplace_back(NumberOfParticles(), initialVal);
+		m_scalarDataList.emplace_back(PagedScalarData::DEFAULT_CHUNK_SIZE, m_backingDirectory);
+		m_scalarDataList.back().Resize(NumberOfParticles(), initialVal);
 		return attrIdx;
 	}
 
 	size_t ParticleSystemData3::AddVectorData(const Vector3D& initialVal)
 	{
 		size_t attrIdx = m_vectorDataList.size();
-		m_vectorDataList.emplace_back(NumberOfParticles(), initialVal);
+		m_vectorDataList.emplace_back(PagedVectorData::DEFAULT_CHUNK_SIZE, m_backingDirectory);
+		m_vectorDataList.back().Resize(NumberOfParticles(), initialVal);
 		return attrIdx;
 	}
 
+	const std::string& ParticleSystemData3::GetBackingDirectory() const
+	{
+		return m_backingDirectory;
+	}
+
+	void ParticleSystemData3::SetBackingDirectory(const std::string& backingDirectory)
+	{
+		if (backingDirectory == m_backingDirectory)
+		{
+			return;
+		}
+
+		m_backingDirectory = backingDirectory;
+
+		for (auto& attr : m_scalarDataList)
+		{
+			PagedScalarData newAttr(attr.ChunkSize(), m_backingDirectory, attr.ReservedSize());
+			newAttr.Set(attr);
+			attr = std::move(newAttr);
+		}
+
+		for (auto& attr : m_vectorDataList)
+		{
+			PagedVectorData newAttr(attr.ChunkSize(), m_backingDirectory, attr.ReservedSize());
+			newAttr.Set(attr);
+			attr = std::move(newAttr);
+		}
+	}
+
 	double ParticleSystemData3::GetRadius() const
 	{
 		return m_radius;
@@ -298,6 +341,66 @@ namespace CubbyFlow
 		DeserializeParticleSystemData(fbsParticleSystemData);
 	}
 
+	void ParticleSystemData3::SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const
+	{
+		writer->WriteValue(prefix + "radius", m_radius);
+		writer->WriteValue(prefix + "mass", m_mass);
+		writer->WriteValue<uint64_t>(prefix + "numberOfParticles", m_numberOfParticles);
+		writer->WriteValue<uint64_t>(prefix + "positionIdx", m_positionIdx);
+		writer->WriteValue<uint64_t>(prefix + "velocityIdx", m_velocityIdx);
+		writer->WriteValue<uint64_t>(prefix + "forceIdx", m_forceIdx);
+		writer->WriteValue<uint64_t>(prefix + "numberOfScalarData", m_scalarDataList.size());
+		writer->WriteValue<uint64_t>(prefix + "numberOfVectorData", m_vectorDataList.size());
+
+		for (size_t i = 0; i < m_scalarDataList.size(); ++i)
+		{
+			writer->WriteArray(prefix + "scalarData." + std::to_string(i), m_scalarDataList[i].ConstAccessor());
+		}
+
+		for (size_t i = 0; i < m_vectorDataList.size(); ++i)
+		{
+			writer->WriteArray(prefix + "vectorData." + std::to_string(i), m_vectorDataList[i].ConstAccessor());
+		}
+	}
+
+	void ParticleSystemData3::LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix)
+	{
+		uint64_t numberOfParticles, positionIdx, velocityIdx, forceIdx, numberOfScalarData, numberOfVectorData;
+
+		reader.ReadValue(prefix + "radius", &m_radius);
+		reader.ReadValue(prefix + "mass", &m_mass);
+		reader.ReadValue(prefix + "numberOfParticles", &numberOfParticles);
+		reader.ReadValue(prefix + "positionIdx", &positionIdx);
+		reader.ReadValue(prefix + "velocityIdx", &velocityIdx);
+		reader.ReadValue(prefix + "forceIdx", &forceIdx);
+		reader.ReadValue(prefix + "numberOfScalarData", &numberOfScalarData);
+		reader.ReadValue(prefix + "numberOfVectorData", &numberOfVectorData);
+
+		m_numberOfParticles = static_cast<size_t>(numberOfParticles);
+		m_positionIdx = static_cast<size_t>(positionIdx);
+		m_velocityIdx = static_cast<size_t>(velocityIdx);
+		m_forceIdx = static_cast<size_t>(forceIdx);
+
+		// The existing layers keep their chunk size and backing file
+		m_scalarDataList.resize(static_cast<size_t>(numberOfScalarData), PagedScalarData(PagedScalarData::DEFAULT_CHUNK_SIZE, m_backingDirectory));
+		for (size_t i = 0; i < m_scalarDataList.size(); ++i)
+		{
+			m_scalarDataList[i].CopyFrom(reader.ViewArray<double>(prefix + "scalarData." + std::to_string(i)));
+		}
+
+		m_vectorDataList.resize(static_cast<size_t>(numberOfVectorData), PagedVectorData(PagedVectorData::DEFAULT_CHUNK_SIZE, m_backingDirectory));
+		for (size_t i = 0; i < m_vectorDataList.size(); ++i)
+		{
+			m_vectorDataList[i].CopyFrom(reader.ViewArray<Vector3D>(prefix + "vectorData." + std::to_string(i)));
+		}
+
+		m_neighborLists.clear();
+		if (m_neighborSearcher != nullptr)
+		{
+			m_neighborSearcher->Build(GetPositions());
+		}
+	}
+
 	void ParticleSystemData3::Set(const ParticleSystemData3& other)
 	{
 		m_radius = other.m_radius;
@@ -306,6 +409,7 @@ namespace CubbyFlow
 		m_velocityIdx = other.m_velocityIdx;
 		m_forceIdx = other.m_forceIdx;
 		m_numberOfParticles = other.m_numberOfParticles;
+		m_backingDirectory = other.m_backingDirectory;
 
 		for (auto& attr : other.m_scalarDataList)
 		{
@@ -346,9 +450,9 @@ namespace CubbyFlow
 		for (const auto& vectorData : m_vectorDataList)
 		{
 			std::vector<fbs::Vector3D> newVectorData;
-			for (const auto& v : vectorData)
+			for (size_t i = 0; i < vectorData.size(); ++i)
 			{
-				newVectorData.push_back(CubbyFlowToFlatbuffers(v));
+				newVectorData.push_back(CubbyFlowToFlatbuffers(vectorData[i]));
 			}
 
 			auto fbsVectorData = fbs::CreateVectorParticleData3(*builder,
@@ -412,7 +516,8 @@ namespace CubbyFlow
 		{
 			auto data = fbsScalarData->data();
 
-			m_scalarDataList.push_back(ScalarData(data->size()));
+			m_scalarDataList.emplace_back(PagedScalarData::DEFAULT_CHUNK_SIZE, m_backingDirectory);
+			m_scalarDataList.back().Resize(data->size());
 
 			auto& newData = *(m_scalarDataList.rbegin());
 
@@ -427,7 +532,8 @@ namespace CubbyFlow
 		{
 			auto data = fbsVectorData->data();
 
-			m_vectorDataList.push_back(VectorData(data->size()));
+			m_vectorDataList.emplace_back(PagedVectorData::DEFAULT_CHUNK_SIZE, m_backingDirectory);
+			m_vectorDataList.back().Resize(data->size());
 			auto& newData = *(m_vectorDataList.rbegin());
 			for (uint32_t i = 0; i < data->size(); ++i)
 			{
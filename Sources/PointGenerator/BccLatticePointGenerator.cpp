@@ -7,9 +7,24 @@
 > Copyright (c) 2017, Chan-Ho Chris Ohk
 *************************************************************************/
 #include <PointGenerator/BccLatticePointGenerator.h>
+#include <Utils/Parallel.h>
 
 namespace CubbyFlow
 {
+	// Counts the steps in the same way as the loops in ForEachPoint so that
+	// the round-off matches exactly.
+	static size_t NumberOfSteps(double offset, double spacing, double extent)
+	{
+		size_t n = 0;
+
+		while (n * spacing + offset <= extent)
+		{
+			++n;
+		}
+
+		return n;
+	}
+
 	void BccLatticePointGenerator::ForEachPoint(const BoundingBox3D& boundingBox, double spacing,
 		const std::function<bool(const Vector3D&)>& callback) const
 	{
@@ -47,4 +62,50 @@ namespace CubbyFlow
 			hasOffset = !hasOffset;
 		}
 	}
+
+	size_t BccLatticePointGenerator::NumberOfPoints(const BoundingBox3D& boundingBox, double spacing) const
+	{
+		const double halfSpacing = spacing / 2.0;
+		const size_t numberOfLayers = NumberOfSteps(0.0, halfSpacing, boundingBox.Depth());
+		const size_t evenLayerSize = NumberOfSteps(0.0, spacing, boundingBox.Width()) * NumberOfSteps(0.0, spacing, boundingBox.Height());
+		const size_t oddLayerSize = NumberOfSteps(halfSpacing, spacing, boundingBox.Width()) * NumberOfSteps(halfSpacing, spacing, boundingBox.Height());
+
+		return (numberOfLayers / 2) * (evenLayerSize + oddLayerSize) + (numberOfLayers % 2) * evenLayerSize;
+	}
+
+	void BccLatticePointGenerator::ParallelForEachPoint(const BoundingBox3D& boundingBox, double spacing,
+		const std::function<void(size_t, const Vector3D&)>& func) const
+	{
+		const double halfSpacing = spacing / 2.0;
+		const size_t numberOfPoints = NumberOfPoints(boundingBox, spacing);
+
+		if (numberOfPoints == 0)
+		{
+			return;
+		}
+
+		// Even layers start at the lower corner, odd layers are shifted by half
+		// the spacing in x and y.
+		const size_t width[2] = { NumberOfSteps(0.0, spacing, boundingBox.Width()), NumberOfSteps(halfSpacing, spacing, boundingBox.Width()) };
+		const size_t height[2] = { NumberOfSteps(0.0, spacing, boundingBox.Height()), NumberOfSteps(halfSpacing, spacing, boundingBox.Height()) };
+		const size_t layerSize[2] = { width[0] * height[0], width[1] * height[1] };
+		const size_t layerPairSize = layerSize[0] + layerSize[1];
+
+		ParallelFor(ZERO_SIZE, numberOfPoints, [&](size_t index)
+		{
+			size_t rest = index % layerPairSize;
+			const size_t parity = (rest < layerSize[0]) ? 0 : 1;
+			const size_t k = 2 * (index / layerPairSize) + parity;
+			rest -= parity * layerSize[0];
+
+			const size_t i = rest % width[parity];
+			const size_t j = rest / width[parity];
+			const double offset = (parity == 1) ? halfSpacing : 0.0;
+
+			func(index, Vector3D(
+				i * spacing + offset + boundingBox.lowerCorner.x,
+				j * spacing + offset + boundingBox.lowerCorner.y,
+				k * halfSpacing + boundingBox.lowerCorner.z));
+		});
+	}
 }
\ No newline at end of file
@@ -7,9 +7,24 @@
 > Copyright (c) 2017, Chan-Ho Chris Ohk
 *************************************************************************/
 #include <PointGenerator/GridPointGenerator3.h>
+#include <Utils/Parallel.h>
 
 namespace CubbyFlow
 {
+	// Counts the steps in the same way as the loops in ForEachPoint so that
+	// the round-off matches exactly.
+	static size_t NumberOfSteps(double spacing, double extent)
+	{
+		size_t n = 0;
+
+		while (n * spacing <= extent)
+		{
+			++n;
+		}
+
+		return n;
+	}
+
 	void GridPointGenerator3::ForEachPoint(
 		const BoundingBox3D& boundingBox,
 		double spacing,
@@ -42,4 +57,25 @@ namespace CubbyFlow
 			}
 		}
 	}
+
+	size_t GridPointGenerator3::NumberOfPoints(const BoundingBox3D& boundingBox, double spacing) const
+	{
+		return NumberOfSteps(spacing, boundingBox.Width()) * NumberOfSteps(spacing, boundingBox.Height()) * NumberOfSteps(spacing, boundingBox.Depth());
+	}
+
+	void GridPointGenerator3::ParallelForEachPoint(const BoundingBox3D& boundingBox, double spacing,
+		const std::function<void(size_t, const Vector3D&)>& func) const
+	{
+		const size_t width = NumberOfSteps(spacing, boundingBox.Width());
+		const size_t height = NumberOfSteps(spacing, boundingBox.Height());
+		const size_t depth = NumberOfSteps(spacing, boundingBox.Depth());
+
+		ParallelFor(ZERO_SIZE, width, ZERO_SIZE, height, ZERO_SIZE, depth, [&](size_t i, size_t j, size_t k)
+		{
+			func(i + width * (j + height * k), Vector3D(
+				i * spacing + boundingBox.lowerCorner.x,
+				j * spacing + boundingBox.lowerCorner.y,
+				k * spacing + boundingBox.lowerCorner.z));
+		});
+	}
 }
\ No newline at end of file
@@ -28,4 +28,29 @@ namespace CubbyFlow
 			return true;
 		});
 	}
+
+	size_t PointGenerator3::NumberOfPoints(const BoundingBox3D& boundingBox, double spacing) const
+	{
+		size_t numberOfPoints = 0;
+
+		ForEachPoint(boundingBox, spacing, [&numberOfPoints](const Vector3D&)
+		{
+			++numberOfPoints;
+			return true;
+		});
+
+		return numberOfPoints;
+	}
+
+	void PointGenerator3::ParallelForEachPoint(const BoundingBox3D& boundingBox, double spacing,
+		const std::function<void(size_t, const Vector3D&)>& func) const
+	{
+		size_t index = 0;
+
+		ForEachPoint(boundingBox, spacing, [&](const Vector3D& point)
+		{
+			func(index++, point);
+			return true;
+		});
+	}
 }
\ No newline at end of file
@@ -0,0 +1,212 @@
+/*************************************************************************
+> File Name: AnisotropicPointsToImplicit3.cpp
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: 3-D points-to-implicit converter using anisotropic kernels.
+> Created Time: 2017/10/24
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#include <Matrix/Matrix3x3.h>
+#include <PointsToImplicit/AnisotropicPointsToImplicit3.h>
+#include <PointsToImplicit/PointSplatter3.h>
+#include <SPH/SPHStdKernel3.h>
+#include <SPH/SPHSystemData3.h>
+#include <Utils/Parallel.h>
+
+namespace CubbyFlow
+{
+	// Max ratio between the largest and smallest principal axes of a kernel.
+	static const double MAX_KERNEL_STRETCH = 4.0;
+
+	// Isotropic weight used for the neighborhood mean and covariance.
+	inline double AnisotropicWeight(double distance, double radius)
+	{
+		return 1.0 - Cubic(distance / radius);
+	}
+
+	//
+	// Jacobi eigenvalue algorithm for a symmetric 3x3 matrix. The columns of
+	// \p eigenvectors are the eigenvectors of the corresponding eigenvalues.
+	//
+	static void SymmetricEigenDecomposition(Matrix3x3D a, Vector3D* eigenvalues, Matrix3x3D* eigenvectors)
+	{
+		static const size_t pairs[3][2] = { { 0, 1 }, { 0, 2 }, { 1, 2 } };
+		Matrix3x3D v = Matrix3x3D::MakeIdentity();
+
+		for (int sweep = 0; sweep < 32; ++sweep)
+		{
+			const double offDiagonal = Square(a(0, 1)) + Square(a(0, 2)) + Square(a(1, 2));
+			const double diagonal = Square(a(0, 0)) + Square(a(1, 1)) + Square(a(2, 2));
+
+			if (offDiagonal <= std::numeric_limits<double>::epsilon() * std::numeric_limits<double>::epsilon() * diagonal)
+			{
+				break;
+			}
+
+			for (const auto& pair : pairs)
+			{
+				const size_t p = pair[0];
+				const size_t q = pair[1];
+
+				if (a(p, q) == 0.0)
+				{
+					continue;
+				}
+
+				const double theta = (a(q, q) - a(p, p)) / (2.0 * a(p, q));
+				const double t = ((theta >= 0.0) ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+				const double c = 1.0 / std::sqrt(t * t + 1.0);
+				const double s = t * c;
+
+				for (size_t k = 0; k < 3; ++k)
+				{
+					const double akp = a(k, p);
+					const double akq = a(k, q);
+					a(k, p) = c * akp - s * akq;
+					a(k, q) = s * akp + c * akq;
+				}
+
+				for (size_t k = 0; k < 3; ++k)
+				{
+					const double apk = a(p, k);
+					const double aqk = a(q, k);
+					a(p, k) = c * apk - s * aqk;
+					a(q, k) = s * apk + c * aqk;
+				}
+
+				for (size_t k = 0; k < 3; ++k)
+				{
+					const double vkp = v(k, p);
+					const double vkq = v(k, q);
+					v(k, p) = c * vkp - s * vkq;
+					v(k, q) = s * vkp + c * vkq;
+				}
+			}
+		}
+
+		*eigenvalues = Vector3D(a(0, 0), a(1, 1), a(2, 2));
+		*eigenvectors = v;
+	}
+
+	AnisotropicPointsToImplicit3::AnisotropicPointsToImplicit3(
+		double kernelRadius, double cutOffDensity,
+		double positionSmoothingFactor, size_t minNumberOfNeighbors) :
+		m_kernelRadius(kernelRadius), m_cutOffDensity(cutOffDensity),
+		m_positionSmoothingFactor(positionSmoothingFactor), m_minNumberOfNeighbors(minNumberOfNeighbors)
+	{
+		// Do nothing
+	}
+
+	void AnisotropicPointsToImplicit3::Convert(const ConstArrayAccessor1<Vector3D>& points, ScalarGrid3* output) const
+	{
+		SPHSystemData3 sphParticles;
+		sphParticles.AddParticles(points);
+		sphParticles.SetRelativeKernelRadius(2.0);
+		sphParticles.SetTargetSpacing(m_kernelRadius / 2.0);
+		sphParticles.BuildNeighborSearcher();
+		sphParticles.UpdateDensities();
+
+		const auto densities = sphParticles.GetDensities();
+		const auto& neighborSearcher = sphParticles.GetNeighborSearcher();
+		const double mass = sphParticles.GetMass();
+		const double h = sphParticles.GetKernelRadius();
+		const SPHStdKernel3 kernel(h);
+
+		// Compute the smoothed centers and the kernel transforms G
+		const size_t numberOfPoints = points.size();
+		Array1<Vector3D> centers(numberOfPoints);
+		Array1<double> supportRadii(numberOfPoints, h);
+		std::vector<Matrix3x3D> gs(numberOfPoints, Matrix3x3D::MakeIdentity());
+
+		ParallelFor(ZERO_SIZE, numberOfPoints, [&](size_t i)
+		{
+			const Vector3D& x = points[i];
+
+			double weightSum = 0.0;
+			Vector3D mean;
+			size_t numberOfNeighbors = 0;
+
+			neighborSearcher->ForEachNearbyPoint(x, h, [&](size_t, const Vector3D& xj)
+			{
+				const double wj = AnisotropicWeight(x.DistanceTo(xj), h);
+				weightSum += wj;
+				mean += wj * xj;
+				++numberOfNeighbors;
+			});
+
+			mean /= weightSum;
+			centers[i] = Lerp(x, mean, m_positionSmoothingFactor);
+
+			if (numberOfNeighbors < m_minNumberOfNeighbors)
+			{
+				return;
+			}
+
+			Matrix3x3D covariance = Matrix3x3D::MakeZero();
+			neighborSearcher->ForEachNearbyPoint(x, h, [&](size_t, const Vector3D& xj)
+			{
+				const double wj = AnisotropicWeight(x.DistanceTo(xj), h);
+				const Vector3D r = xj - mean;
+
+				for (size_t a = 0; a < 3; ++a)
+				{
+					for (size_t b = 0; b < 3; ++b)
+					{
+						covariance(a, b) += wj * r[a] * r[b];
+					}
+				}
+			});
+			covariance /= weightSum;
+
+			Vector3D sigma;
+			Matrix3x3D rotation;
+			SymmetricEigenDecomposition(covariance, &sigma, &rotation);
+
+			sigma = Vector3D(std::fabs(sigma.x), std::fabs(sigma.y), std::fabs(sigma.z));
+			const double maxSigma = sigma.Max();
+
+			if (maxSigma <= 0.0)
+			{
+				return;
+			}
+
+			// Cap the stretch and keep the volume of the kernel
+			sigma = Vector3D(
+				std::max(sigma.x, maxSigma / MAX_KERNEL_STRETCH),
+				std::max(sigma.y, maxSigma / MAX_KERNEL_STRETCH),
+				std::max(sigma.z, maxSigma / MAX_KERNEL_STRETCH));
+			const double scale = std::cbrt(sigma.x * sigma.y * sigma.z);
+
+			Matrix3x3D& g = gs[i];
+			for (size_t a = 0; a < 3; ++a)
+			{
+				for (size_t b = 0; b < 3; ++b)
+				{
+					g(a, b) = 0.0;
+
+					for (size_t k = 0; k < 3; ++k)
+					{
+						g(a, b) += rotation(a, k) * (scale / sigma[k]) * rotation(b, k);
+					}
+				}
+			}
+
+			supportRadii[i] = h * maxSigma / scale;
+		});
+
+		// Splat the anisotropic kernels. Since det(G) = 1, W(r, G) = W(|G r|).
+		auto data = output->GetDataAccessor();
+		PointSplatter3<double> splatter(data.size(), output->GridSpacing(), output->GetDataOrigin());
+		splatter.Splat(centers.ConstAccessor(), supportRadii.ConstAccessor(),
+			[&](size_t n, size_t, size_t, size_t, const Vector3D& x, double* sum)
+		{
+			*sum += mass / densities[n] * kernel(gs[n].Mul(x - centers[n]).Length());
+		});
+
+		output->Fill(m_cutOffDensity);
+		splatter.ForEachActiveDataPoint([&](size_t i, size_t j, size_t k, double sum)
+		{
+			data(i, j, k) = m_cutOffDensity - sum;
+		});
+	}
+}
@@ -0,0 +1,22 @@
+/*************************************************************************
+> File Name: PointsToImplicit3.cpp
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Abstract base class for 3-D points-to-implicit converters.
+> Created Time: 2017/10/24
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#include <PointsToImplicit/PointsToImplicit3.h>
+
+namespace CubbyFlow
+{
+	PointsToImplicit3::PointsToImplicit3()
+	{
+		// Do nothing
+	}
+
+	PointsToImplicit3::~PointsToImplicit3()
+	{
+		// Do nothing
+	}
+}
@@ -0,0 +1,49 @@
+/*************************************************************************
+> File Name: SPHPointsToImplicit3.cpp
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: 3-D points-to-implicit converter based on standard SPH kernel.
+> Created Time: 2017/10/24
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#include <PointsToImplicit/PointSplatter3.h>
+#include <PointsToImplicit/SPHPointsToImplicit3.h>
+#include <SPH/SPHStdKernel3.h>
+#include <SPH/SPHSystemData3.h>
+
+namespace CubbyFlow
+{
+	SPHPointsToImplicit3::SPHPointsToImplicit3(double kernelRadius, double cutOffDensity) :
+		m_kernelRadius(kernelRadius), m_cutOffDensity(cutOffDensity)
+	{
+		// Do nothing
+	}
+
+	void SPHPointsToImplicit3::Convert(const ConstArrayAccessor1<Vector3D>& points, ScalarGrid3* output) const
+	{
+		SPHSystemData3 sphParticles;
+		sphParticles.AddParticles(points);
+		sphParticles.SetRelativeKernelRadius(2.0);
+		sphParticles.SetTargetSpacing(m_kernelRadius / 2.0);
+		sphParticles.BuildNeighborSearcher();
+		sphParticles.UpdateDensities();
+
+		const auto densities = sphParticles.GetDensities();
+		const double mass = sphParticles.GetMass();
+		const SPHStdKernel3 kernel(sphParticles.GetKernelRadius());
+
+		auto data = output->GetDataAccessor();
+		PointSplatter3<double> splatter(data.size(), output->GridSpacing(), output->GetDataOrigin());
+		splatter.Splat(points, sphParticles.GetKernelRadius(),
+			[&](size_t n, size_t, size_t, size_t, const Vector3D& x, double* sum)
+		{
+			*sum += mass / densities[n] * kernel(x.DistanceTo(points[n]));
+		});
+
+		output->Fill(m_cutOffDensity);
+		splatter.ForEachActiveDataPoint([&](size_t i, size_t j, size_t k, double sum)
+		{
+			data(i, j, k) = m_cutOffDensity - sum;
+		});
+	}
+}
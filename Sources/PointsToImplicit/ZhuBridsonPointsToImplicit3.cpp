@@ -0,0 +1,62 @@
+/*************************************************************************
+> File Name: ZhuBridsonPointsToImplicit3.cpp
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: 3-D points-to-implicit converter based on Zhu and Bridson's method.
+> Created Time: 2017/10/24
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#include <PointsToImplicit/PointSplatter3.h>
+#include <PointsToImplicit/ZhuBridsonPointsToImplicit3.h>
+
+namespace CubbyFlow
+{
+	struct ZhuBridsonSample
+	{
+		double weightSum = 0.0;
+		Vector3D weightedPosition;
+	};
+
+	inline double ZhuBridsonKernel(double distanceSquared)
+	{
+		return std::max(0.0, Cubic(1.0 - distanceSquared));
+	}
+
+	ZhuBridsonPointsToImplicit3::ZhuBridsonPointsToImplicit3(double kernelRadius, double cutOffThreshold) :
+		m_kernelRadius(kernelRadius), m_cutOffThreshold(cutOffThreshold)
+	{
+		// Do nothing
+	}
+
+	void ZhuBridsonPointsToImplicit3::Convert(const ConstArrayAccessor1<Vector3D>& points, ScalarGrid3* output) const
+	{
+		const double invKernelRadiusSquared = 1.0 / (m_kernelRadius * m_kernelRadius);
+		const double isoContourValue = m_cutOffThreshold * m_kernelRadius;
+		const double farValue = output->BoundingBox().DiagonalLength();
+
+		auto data = output->GetDataAccessor();
+		PointSplatter3<ZhuBridsonSample> splatter(data.size(), output->GridSpacing(), output->GetDataOrigin());
+		splatter.Splat(points, m_kernelRadius,
+			[&](size_t n, size_t, size_t, size_t, const Vector3D& x, ZhuBridsonSample* sample)
+		{
+			const double weight = ZhuBridsonKernel(x.DistanceSquaredTo(points[n]) * invKernelRadiusSquared);
+
+			if (weight > 0.0)
+			{
+				sample->weightSum += weight;
+				sample->weightedPosition += weight * points[n];
+			}
+		});
+
+		output->Fill(farValue);
+		auto pos = output->GetDataPosition();
+		splatter.ForEachActiveDataPoint([&](size_t i, size_t j, size_t k, const ZhuBridsonSample& sample)
+		{
+			if (sample.weightSum > 0.0)
+			{
+				const Vector3D averagePosition = sample.weightedPosition / sample.weightSum;
+				data(i, j, k) = pos(i, j, k).DistanceTo(averagePosition) - isoContourValue;
+			}
+		});
+	}
+}
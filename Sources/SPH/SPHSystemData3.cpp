@@ -343,6 +343,35 @@ namespace CubbyFlow
 		m_densityIdx = static_cast<size_t>(fbsSPHSystemData->densityIdx());
 	}
 
+	void SPHSystemData3::SaveCheckpoint(CheckpointWriter* writer, const std::string& prefix) const
+	{
+		ParticleSystemData3::SaveCheckpoint(writer, prefix);
+
+		// SPH specific
+		writer->WriteValue(prefix + "targetDensity", m_targetDensity);
+		writer->WriteValue(prefix + "targetSpacing", m_targetSpacing);
+		writer->WriteValue(prefix + "kernelRadiusOverTargetSpacing", m_kernelRadiusOverTargetSpacing);
+		writer->WriteValue(prefix + "kernelRadius", m_kernelRadius);
+		writer->WriteValue<uint64_t>(prefix + "pressureIdx", m_pressureIdx);
+		writer->WriteValue<uint64_t>(prefix + "densityIdx", m_densityIdx);
+	}
+
+	void SPHSystemData3::LoadCheckpoint(const CheckpointReader& reader, const std::string& prefix)
+	{
+		ParticleSystemData3::LoadCheckpoint(reader, prefix);
+
+		// SPH specific
+		uint64_t pressureIdx, densityIdx;
+		reader.ReadValue(prefix + "targetDensity", &m_targetDensity);
+		reader.ReadValue(prefix + "targetSpacing", &m_targetSpacing);
+		reader.ReadValue(prefix + "kernelRadiusOverTargetSpacing", &m_kernelRadiusOverTargetSpacing);
+		reader.ReadValue(prefix + "kernelRadius", &m_kernelRadius);
+		reader.ReadValue(prefix + "pressureIdx", &pressureIdx);
+		reader.ReadValue(prefix + "densityIdx", &densityIdx);
+		m_pressureIdx = static_cast<size_t>(pressureIdx);
+		m_densityIdx = static_cast<size_t>(densityIdx);
+	}
+
 	void SPHSystemData3::Set(const SPHSystemData3& other)
 	{
 		ParticleSystemData3::Set(other);
@@ -21,7 +21,7 @@ namespace CubbyFlow
 			source.GetConstDataAccessor(),
 			source.GridSpacing(),
 			source.GetDataOrigin());
-		return sourceSampler.Functor();
+		return sourceSampler;
 	}
 
 	std::function<Vector3D(const Vector3D&)> CubicSemiLagrangian3::GetVectorSamplerFunc(const CollocatedVectorGrid3& source) const
@@ -30,7 +30,7 @@ namespace CubbyFlow
 			source.GetConstDataAccessor(),
 			source.GridSpacing(),
 			source.GetDataOrigin());
-		return sourceSampler.Functor();
+		return sourceSampler;
 	}
 
 	std::function<Vector3D(const Vector3D&)> CubicSemiLagrangian3::GetVectorSamplerFunc(const FaceCenteredGrid3& source) const
@@ -47,9 +47,6 @@ namespace CubbyFlow
 			source.GetWConstAccessor(),
 			source.GridSpacing(),
 			source.GetWOrigin());
-		return [uSourceSampler, vSourceSampler, wSourceSampler](const Vector3D& x)
-		{
-			return Vector3D(uSourceSampler(x), vSourceSampler(x), wSourceSampler(x));
-		};
+		return FaceCenteredSamplerFunc<CubicArraySampler3<double, double>>{ uSourceSampler, vSourceSampler, wSourceSampler };
 	}
 }
\ No newline at end of file
@@ -6,10 +6,183 @@
 > Created Time: 2017/08/07
 > Copyright (c) 2017, Chan-Ho Chris Ohk
 *************************************************************************/
+#include <Array/ArraySamplers3.h>
 #include <SemiLagrangian/SemiLagrangian3.h>
+#include <Utils/Parallel.h>
 
 namespace CubbyFlow
 {
+	// The output grid is traversed in tiles of rows (full x extent) so that
+	// neighboring rows, which back-trace into nearby cells, are processed by the
+	// same thread while the source data is still in cache.
+	static const size_t TILE_SIZE = 8;
+
+	namespace
+	{
+		template <typename Callback>
+		void ParallelForEachTiledIndex(const Size3& size, const Callback& func)
+		{
+			const size_t numberOfTilesY = (size.y + TILE_SIZE - 1) / TILE_SIZE;
+			const size_t numberOfTilesZ = (size.z + TILE_SIZE - 1) / TILE_SIZE;
+
+			ParallelFor(ZERO_SIZE, numberOfTilesY * numberOfTilesZ, [&](size_t tile)
+			{
+				const size_t jBegin = (tile % numberOfTilesY) * TILE_SIZE;
+				const size_t kBegin = (tile / numberOfTilesY) * TILE_SIZE;
+				const size_t jEnd = std::min(jBegin + TILE_SIZE, size.y);
+				const size_t kEnd = std::min(kBegin + TILE_SIZE, size.z);
+
+				for (size_t k = kBegin; k < kEnd; ++k)
+				{
+					for (size_t j = jBegin; j < jEnd; ++j)
+					{
+						for (size_t i = 0; i < size.x; ++i)
+						{
+							func(i, j, k);
+						}
+					}
+				}
+			});
+		}
+
+		// Invokes the callback with a sampler of the boundary SDF. Constant fields
+		// and scalar grids are sampled without the virtual call.
+		template <typename Callback>
+		void DispatchBoundarySampler(const ScalarField3& boundarySDF, const Callback& callback)
+		{
+			if (auto constantSDF = dynamic_cast<const ConstantScalarField3*>(&boundarySDF))
+			{
+				const double value = constantSDF->Sample(Vector3D());
+				callback([value](const Vector3D&)
+				{
+					return value;
+				});
+			}
+			else if (auto gridSDF = dynamic_cast<const ScalarGrid3*>(&boundarySDF))
+			{
+				callback(LinearArraySampler3<double, double>(
+					gridSDF->GetConstDataAccessor(), gridSDF->GridSpacing(), gridSDF->GetDataOrigin()));
+			}
+			else
+			{
+				callback([&boundarySDF](const Vector3D& x)
+				{
+					return boundarySDF.Sample(x);
+				});
+			}
+		}
+
+		// Invokes the callback with samplers of the flow and the boundary SDF.
+		// Face-centered flows are sampled without the virtual call.
+		template <typename Callback>
+		void DispatchFlowAndBoundarySamplers(const VectorField3& flow, const ScalarField3& boundarySDF, const Callback& callback)
+		{
+			if (auto faceCenteredFlow = dynamic_cast<const FaceCenteredGrid3*>(&flow))
+			{
+				const LinearArraySampler3<double, double> uSampler(
+					faceCenteredFlow->GetUConstAccessor(), faceCenteredFlow->GridSpacing(), faceCenteredFlow->GetUOrigin());
+				const LinearArraySampler3<double, double> vSampler(
+					faceCenteredFlow->GetVConstAccessor(), faceCenteredFlow->GridSpacing(), faceCenteredFlow->GetVOrigin());
+				const LinearArraySampler3<double, double> wSampler(
+					faceCenteredFlow->GetWConstAccessor(), faceCenteredFlow->GridSpacing(), faceCenteredFlow->GetWOrigin());
+				const auto flowSampler = [&](const Vector3D& x)
+				{
+					return Vector3D(uSampler(x), vSampler(x), wSampler(x));
+				};
+
+				DispatchBoundarySampler(boundarySDF, [&](const auto& boundarySampler)
+				{
+					callback(flowSampler, boundarySampler);
+				});
+			}
+			else
+			{
+				const auto flowSampler = [&flow](const Vector3D& x)
+				{
+					return flow.Sample(x);
+				};
+
+				DispatchBoundarySampler(boundarySDF, [&](const auto& boundarySampler)
+				{
+					callback(flowSampler, boundarySampler);
+				});
+			}
+		}
+
+		template <typename FlowSampler, typename BoundarySampler>
+		Vector3D BackTrace(
+			const FlowSampler& flow,
+			double dt,
+			double h,
+			const Vector3D& startPt,
+			const BoundarySampler& boundarySDF)
+		{
+			double remainingT = dt;
+			Vector3D pt0 = startPt;
+			Vector3D pt1 = startPt;
+
+			while (remainingT > std::numeric_limits<double>::epsilon())
+			{
+				// Adaptive time-stepping
+				Vector3D vel0 = flow(pt0);
+				double numSubSteps = std::max(std::ceil(vel0.Length() * remainingT / h), 1.0);
+				dt = remainingT / numSubSteps;
+
+				// Mid-point rule
+				Vector3D midPt = pt0 - 0.5 * dt * vel0;
+				Vector3D midVel = flow(midPt);
+				pt1 = pt0 - dt * midVel;
+
+				// Boundary handling
+				double phi0 = boundarySDF(pt0);
+				double phi1 = boundarySDF(pt1);
+
+				if (phi0 * phi1 < 0.0)
+				{
+					double w = std::fabs(phi1) / (std::fabs(phi0) + std::fabs(phi1));
+					pt1 = w * pt0 + (1.0 - w) * pt1;
+					break;
+				}
+
+				remainingT -= dt;
+				pt0 = pt1;
+			}
+
+			return pt1;
+		}
+
+		template <typename T, typename InputSampler, typename FlowSampler, typename BoundarySampler>
+		void AdvectArray(
+			const InputSampler& inputSampler,
+			const FlowSampler& flow,
+			const BoundarySampler& boundarySDF,
+			double dt,
+			double h,
+			const Vector3D& sourceSpacing,
+			const Vector3D& sourceOrigin,
+			const Vector3D& targetSpacing,
+			const Vector3D& targetOrigin,
+			ArrayAccessor3<T> output)
+		{
+			ParallelForEachTiledIndex(output.size(), [&](size_t i, size_t j, size_t k)
+			{
+				const Vector3D index(static_cast<double>(i), static_cast<double>(j), static_cast<double>(k));
+
+				if (boundarySDF(sourceOrigin + sourceSpacing * index) > 0.0)
+				{
+					Vector3D pt = BackTrace(flow, dt, h, targetOrigin + targetSpacing * index, boundarySDF);
+					output(i, j, k) = inputSampler(pt);
+				}
+			});
+		}
+
+		template <typename FaceCenteredSamplerFunc>
+		const auto& GetComponentSampler(const FaceCenteredSamplerFunc& samplerFunc, size_t component)
+		{
+			return (component == 0) ? samplerFunc.uSampler : (component == 1) ? samplerFunc.vSampler : samplerFunc.wSampler;
+		}
+	}
+
 	SemiLagrangian3::SemiLagrangian3()
 	{
 		// Do nothing
@@ -27,19 +200,31 @@ namespace CubbyFlow
 		ScalarGrid3* output,
 		const ScalarField3& boundarySDF)
 	{
-		auto inputSamplerFunc = GetScalarSamplerFunc(input);
-		double h = std::min(output->GridSpacing().x, output->GridSpacing().y);
+		const double h = std::min(output->GridSpacing().x, output->GridSpacing().y);
+		const auto samplerFunc = GetScalarSamplerFunc(input);
 
-		auto inputDataPos = input.GetDataPosition();
-		auto outputDataPos = output->GetDataPosition();
-		auto outputDataAcc = output->GetDataAccessor();
-
-		output->ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+		DispatchFlowAndBoundarySamplers(flow, boundarySDF, [&](const auto& flowSampler, const auto& boundarySampler)
 		{
-			if (boundarySDF.Sample(inputDataPos(i, j, k)) > 0.0)
+			const auto advect = [&](const auto& inputSampler)
+			{
+				AdvectArray(
+					inputSampler, flowSampler, boundarySampler, dt, h,
+					input.GridSpacing(), input.GetDataOrigin(),
+					output->GridSpacing(), output->GetDataOrigin(),
+					output->GetDataAccessor());
+			};
+
+			if (const auto linearSampler = samplerFunc.target<LinearArraySampler3<double, double>>())
 			{
-				Vector3D pt = BackTrace(flow, dt, h, outputDataPos(i, j, k), boundarySDF);
-				outputDataAcc(i, j, k) = inputSamplerFunc(pt);
+				advect(*linearSampler);
+			}
+			else if (const auto cubicSampler = samplerFunc.target<CubicArraySampler3<double, double>>())
+			{
+				advect(*cubicSampler);
+			}
+			else
+			{
+				advect(samplerFunc);
 			}
 		});
 	}
@@ -51,126 +236,103 @@ namespace CubbyFlow
 		CollocatedVectorGrid3* output,
 		const ScalarField3& boundarySDF)
 	{
-		auto inputSamplerFunc = GetVectorSamplerFunc(input);
-		double h = std::min(output->GridSpacing().x, output->GridSpacing().y);
-
-		auto inputDataPos = input.GetDataPosition();
-		auto outputDataPos = output->GetDataPosition();
-		auto outputDataAcc = output->GetDataAccessor();
+		const double h = std::min(output->GridSpacing().x, output->GridSpacing().y);
+		const auto samplerFunc = GetVectorSamplerFunc(input);
 
-		output->ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+		DispatchFlowAndBoundarySamplers(flow, boundarySDF, [&](const auto& flowSampler, const auto& boundarySampler)
 		{
-			if (boundarySDF.Sample(inputDataPos(i, j, k)) > 0.0)
+			const auto advect = [&](const auto& inputSampler)
 			{
-				Vector3D pt = BackTrace(flow, dt, h, outputDataPos(i, j, k), boundarySDF);
-				outputDataAcc(i, j, k) = inputSamplerFunc(pt);
-			}
-		});
-	}
-
-	void SemiLagrangian3::Advect(
-		const FaceCenteredGrid3& input,
-		const VectorField3& flow,
-		double dt,
-		FaceCenteredGrid3* output,
-		const ScalarField3& boundarySDF)
-	{
-		auto inputSamplerFunc = GetVectorSamplerFunc(input);
-		double h = std::min(output->GridSpacing().x, output->GridSpacing().y);
+				AdvectArray(
+					inputSampler, flowSampler, boundarySampler, dt, h,
+					input.GridSpacing(), input.GetDataOrigin(),
+					output->GridSpacing(), output->GetDataOrigin(),
+					output->GetDataAccessor());
+			};
 
-		auto uSourceDataPos = input.GetUPosition();
-		auto uTargetDataPos = output->GetUPosition();
-		auto uTargetDataAcc = output->GetUAccessor();
-
-		output->ParallelForEachUIndex([&](size_t i, size_t j, size_t k)
-		{
-			if (boundarySDF.Sample(uSourceDataPos(i, j, k)) > 0.0)
+			if (const auto linearSampler = samplerFunc.target<LinearArraySampler3<Vector3D, double>>())
 			{
-				Vector3D pt = BackTrace(flow, dt, h, uTargetDataPos(i, j, k), boundarySDF);
-				uTargetDataAcc(i, j, k) = inputSamplerFunc(pt).x;
+				advect(*linearSampler);
 			}
-		});
-
-		auto vSourceDataPos = input.GetVPosition();
-		auto vTargetDataPos = output->GetVPosition();
-		auto vTargetDataAcc = output->GetVAccessor();
-
-		output->ParallelForEachVIndex([&](size_t i, size_t j, size_t k)
-		{
-			if (boundarySDF.Sample(vSourceDataPos(i, j, k)) > 0.0)
+			else if (const auto cubicSampler = samplerFunc.target<CubicArraySampler3<Vector3D, double>>())
 			{
-				Vector3D pt = BackTrace(flow, dt, h, vTargetDataPos(i, j, k), boundarySDF);
-				vTargetDataAcc(i, j, k) = inputSamplerFunc(pt).y;
+				advect(*cubicSampler);
 			}
-		});
-
-		auto wTargetDataPos = output->GetWPosition();
-		auto wTargetDataAcc = output->GetWAccessor();
-		auto wSourceDataPos = input.GetWPosition();
-
-		output->ParallelForEachWIndex([&](size_t i, size_t j, size_t k)
-		{
-			if (boundarySDF.Sample(wSourceDataPos(i, j, k)) > 0.0)
+			else
 			{
-				Vector3D pt = BackTrace(flow, dt, h, wTargetDataPos(i, j, k), boundarySDF);
-				wTargetDataAcc(i, j, k) = inputSamplerFunc(pt).z;
+				advect(samplerFunc);
 			}
 		});
 	}
 
-	Vector3D SemiLagrangian3::BackTrace(
+	void SemiLagrangian3::Advect(
+		const FaceCenteredGrid3& input,
 		const VectorField3& flow,
 		double dt,
-		double h,
-		const Vector3D& startPt,
-		const ScalarField3& boundarySDF) const
+		FaceCenteredGrid3* output,
+		const ScalarField3& boundarySDF)
 	{
-		double remainingT = dt;
-		Vector3D pt0 = startPt;
-		Vector3D pt1 = startPt;
+		const double h = std::min(output->GridSpacing().x, output->GridSpacing().y);
+		const auto samplerFunc = GetVectorSamplerFunc(input);
+		const auto linearSamplerFunc = samplerFunc.target<FaceCenteredSamplerFunc<LinearArraySampler3<double, double>>>();
+		const auto cubicSamplerFunc = samplerFunc.target<FaceCenteredSamplerFunc<CubicArraySampler3<double, double>>>();
 
-		while (remainingT > std::numeric_limits<double>::epsilon())
+		DispatchFlowAndBoundarySamplers(flow, boundarySDF, [&](const auto& flowSampler, const auto& boundarySampler)
 		{
-			// Adaptive time-stepping
-			Vector3D vel0 = flow.Sample(pt0);
-			double numSubSteps = std::max(std::ceil(vel0.Length() * remainingT / h), 1.0);
-			dt = remainingT / numSubSteps;
-
-			// Mid-point rule
-			Vector3D midPt = pt0 - 0.5 * dt * vel0;
-			Vector3D midVel = flow.Sample(midPt);
-			pt1 = pt0 - dt * midVel;
-
-			// Boundary handling
-			double phi0 = boundarySDF.Sample(pt0);
-			double phi1 = boundarySDF.Sample(pt1);
-
-			if (phi0 * phi1 < 0.0)
+			// Each face component is sampled from its own array only.
+			const auto advectComponent = [&](
+				size_t component, const Vector3D& sourceOrigin,
+				ArrayAccessor3<double> target, const Vector3D& targetOrigin)
 			{
-				double w = std::fabs(phi1) / (std::fabs(phi0) + std::fabs(phi1));
-				pt1 = w * pt0 + (1.0 - w) * pt1;
-				break;
-			}
+				const auto advect = [&](const auto& inputSampler)
+				{
+					AdvectArray(
+						inputSampler, flowSampler, boundarySampler, dt, h,
+						input.GridSpacing(), sourceOrigin,
+						output->GridSpacing(), targetOrigin,
+						target);
+				};
 
-			remainingT -= dt;
-			pt0 = pt1;
-		}
+				if (linearSamplerFunc != nullptr)
+				{
+					advect(GetComponentSampler(*linearSamplerFunc, component));
+				}
+				else if (cubicSamplerFunc != nullptr)
+				{
+					advect(GetComponentSampler(*cubicSamplerFunc, component));
+				}
+				else
+				{
+					advect([&](const Vector3D& x)
+					{
+						return samplerFunc(x)[component];
+					});
+				}
+			};
 
-		return pt1;
+			advectComponent(0, input.GetUOrigin(), output->GetUAccessor(), output->GetUOrigin());
+			advectComponent(1, input.GetVOrigin(), output->GetVAccessor(), output->GetVOrigin());
+			advectComponent(2, input.GetWOrigin(), output->GetWAccessor(), output->GetWOrigin());
+		});
 	}
 
 	std::function<double(const Vector3D&)> SemiLagrangian3::GetScalarSamplerFunc(const ScalarGrid3& input) const
 	{
-		return input.Sampler();
+		return LinearArraySampler3<double, double>(input.GetConstDataAccessor(), input.GridSpacing(), input.GetDataOrigin());
 	}
 
 	std::function<Vector3D(const Vector3D&)> SemiLagrangian3::GetVectorSamplerFunc(const CollocatedVectorGrid3& input) const
 	{
-		return input.Sampler();
+		return LinearArraySampler3<Vector3D, double>(input.GetConstDataAccessor(), input.GridSpacing(), input.GetDataOrigin());
 	}
 
 	std::function<Vector3D(const Vector3D&)> SemiLagrangian3::GetVectorSamplerFunc(const FaceCenteredGrid3& input) const
 	{
-		return input.Sampler();
+		return FaceCenteredSamplerFunc<LinearArraySampler3<double, double>>
+		{
+			LinearArraySampler3<double, double>(input.GetUConstAccessor(), input.GridSpacing(), input.GetUOrigin()),
+			LinearArraySampler3<double, double>(input.GetVConstAccessor(), input.GridSpacing(), input.GetVOrigin()),
+			LinearArraySampler3<double, double>(input.GetWConstAccessor(), input.GridSpacing(), input.GetWOrigin())
+		};
 	}
 }
\ No newline at end of file
@@ -219,6 +219,24 @@ namespace CubbyFlow
         });
     }
 
+    void APICSolver3::OnSaveCheckpoint(CheckpointWriter* writer) const
+    {
+        PICSolver3::OnSaveCheckpoint(writer);
+
+        writer->WriteArray("apic.cX", m_cX.ConstAccessor());
+        writer->WriteArray("apic.cY", m_cY.ConstAccessor());
+        writer->WriteArray("apic.cZ", m_cZ.ConstAccessor());
+    }
+
+    void APICSolver3::OnLoadCheckpoint(const CheckpointReader& reader)
+    {
+        PICSolver3::OnLoadCheckpoint(reader);
+
+        reader.ReadArray("apic.cX", &m_cX);
+        reader.ReadArray("apic.cY", &m_cY);
+        reader.ReadArray("apic.cZ", &m_cZ);
+    }
+
     APICSolver3::Builder APICSolver3::GetBuilder()
     {
         return Builder();
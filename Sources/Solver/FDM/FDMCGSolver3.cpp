@@ -8,14 +8,22 @@
 *************************************************************************/
 #include <Math/CG.h>
 #include <Solver/FDM/FDMCGSolver3.h>
+#include <Utils/Logger.h>
+#include <Utils/Timer.h>
 
 namespace CubbyFlow
 {
-	FDMCGSolver3::FDMCGSolver3(unsigned int maxNumberOfIterations, double tolerance) :
+	FDMCGSolver3::FDMCGSolver3(
+		unsigned int maxNumberOfIterations,
+		double tolerance,
+		double relativeTolerance,
+		bool isWarmStarted) :
 		m_maxNumberOfIterations(maxNumberOfIterations),
 		m_lastNumberOfIterations(0),
 		m_tolerance(tolerance),
-		m_lastResidual(std::numeric_limits<double>::max())
+		m_lastResidual(std::numeric_limits<double>::max()),
+		m_relativeTolerance(relativeTolerance),
+		m_isWarmStarted(isWarmStarted)
 	{
 		// Do nothing
 	}
@@ -29,23 +37,31 @@ namespace CubbyFlow
 		assert(matrix.size() == rhs.size());
 		assert(matrix.size() == solution.size());
 
+		Timer timer;
+
+		// CG clears the work vectors
 		Size3 size = matrix.size();
 		m_r.Resize(size);
 		m_d.Resize(size);
 		m_q.Resize(size);
 		m_s.Resize(size);
 
-		system->x.Set(0.0);
-		m_r.Set(0.0);
-		m_d.Set(0.0);
-		m_q.Set(0.0);
-		m_s.Set(0.0);
+		if (!m_isWarmStarted)
+		{
+			system->x.Set(0.0);
+		}
+
+		double tolerance = m_tolerance;
+		if (m_relativeTolerance > 0.0)
+		{
+			tolerance = std::max(tolerance, m_relativeTolerance * std::sqrt(FDMBlas3::Dot(rhs, rhs)));
+		}
 
 		CG<FDMBlas3>(
 			matrix,
 			rhs,
 			m_maxNumberOfIterations,
-			m_tolerance,
+			tolerance,
 			&solution,
 			&m_r,
 			&m_d,
@@ -54,7 +70,12 @@ namespace CubbyFlow
 			&m_lastNumberOfIterations,
 			&m_lastResidual);
 
-		return (m_lastResidual <= m_tolerance) || (m_lastNumberOfIterations < m_maxNumberOfIterations);
+		CUBBYFLOW_INFO << "Residual norm after solving CG: " << m_lastResidual
+			<< " Number of CG iterations: " << m_lastNumberOfIterations
+			<< (m_isWarmStarted ? " (warm-started)" : "")
+			<< " Solving CG took " << timer.DurationInSeconds() << " seconds";
+
+		return (m_lastResidual <= tolerance) || (m_lastNumberOfIterations < m_maxNumberOfIterations);
 	}
 
 	unsigned int FDMCGSolver3::GetMaxNumberOfIterations() const
@@ -76,4 +97,14 @@ namespace CubbyFlow
 	{
 		return m_lastResidual;
 	}
+
+	double FDMCGSolver3::GetRelativeTolerance() const
+	{
+		return m_relativeTolerance;
+	}
+
+	bool FDMCGSolver3::IsWarmStarted() const
+	{
+		return m_isWarmStarted;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,251 @@
+/*************************************************************************
+> File Name: FDMDistributedCGSolver3.cpp
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: 3-D finite difference-type linear system solver using distributed conjugate gradient.
+> Created Time: 2017/10/26
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#include <Decomposition/GridDomainDecomposition3.h>
+#include <Decomposition/SharedMemorySubdomainTransport.h>
+#include <Math/MathUtils.h>
+#include <Solver/FDM/FDMDistributedCGSolver3.h>
+
+#include <stdexcept>
+
+namespace CubbyFlow
+{
+	FDMDistributedCGSolver3::FDMDistributedCGSolver3(
+		const Size3& layout,
+		unsigned int maxNumberOfIterations,
+		double tolerance,
+		const SubdomainTransportPtr& transport) :
+		m_layout(layout),
+		m_maxNumberOfIterations(maxNumberOfIterations),
+		m_lastNumberOfIterations(0),
+		m_tolerance(tolerance),
+		m_lastResidual(std::numeric_limits<double>::max()),
+		m_transport(transport)
+	{
+		const size_t numberOfSubdomains = layout.x * layout.y * layout.z;
+
+		if (m_transport == nullptr)
+		{
+			m_transport = std::make_shared<SharedMemorySubdomainTransport>(numberOfSubdomains);
+		}
+		else if (m_transport->NumberOfSubdomains() != numberOfSubdomains)
+		{
+			throw std::invalid_argument("The transport must have one rank per subdomain.");
+		}
+	}
+
+	bool FDMDistributedCGSolver3::Solve(FDMLinearSystem3* system)
+	{
+		assert(system->A.size() == system->b.size());
+		assert(system->A.size() == system->x.size());
+
+		if (m_decomposition == nullptr || m_decomposition->Resolution() != system->A.size())
+		{
+			m_decomposition = std::make_shared<GridDomainDecomposition3>(system->A.size(), m_layout, 1);
+			m_subdomains.clear();
+			m_subdomains.resize(m_transport->NumberOfSubdomains());
+		}
+
+		const GridDomainDecomposition3& decomposition = *m_decomposition;
+		SubdomainTransport* transport = m_transport.get();
+
+		const FDMMatrix3& A = system->A;
+		const FDMVector3& b = system->b;
+
+		m_transport->Run([&](size_t rank)
+		{
+			Subdomain& subdomain = m_subdomains[rank];
+			FDMVector3& x = subdomain.x;
+			FDMVector3& r = subdomain.r;
+			FDMVector3& d = subdomain.d;
+			FDMVector3& q = subdomain.q;
+			FDMVector3& s = subdomain.s;
+
+			const Size3 size = decomposition.LocalSize(rank);
+			const Size3 origin = decomposition.SubdomainOrigin(rank);
+
+			if (x.size() != size)
+			{
+				// The ghost cells outside of the grid are never written, so
+				// they stay zero across the solves.
+				x.Resize(size, 0.0);
+				r.Resize(size, 0.0);
+				d.Resize(size, 0.0);
+				q.Resize(size, 0.0);
+				s.Resize(size, 0.0);
+			}
+			else
+			{
+				x.Set(0.0);
+			}
+
+			// Visits the interior cells only
+			const auto forEachInterior = [&size](const auto& func)
+			{
+				for (size_t k = 1; k + 1 < size.z; ++k)
+				{
+					for (size_t j = 1; j + 1 < size.y; ++j)
+					{
+						for (size_t i = 1; i + 1 < size.x; ++i)
+						{
+							func(i, j, k);
+						}
+					}
+				}
+			};
+
+			const auto dot = [&](const FDMVector3& u, const FDMVector3& v)
+			{
+				double sum = 0.0;
+
+				forEachInterior([&](size_t i, size_t j, size_t k)
+				{
+					sum += u(i, j, k) * v(i, j, k);
+				});
+
+				return transport->AllReduceSum(rank, sum);
+			};
+
+			// Reads the rows of the shared system directly, where the local
+			// cell (i, j, k) is the global cell origin + (i, j, k) - 1. The
+			// ghost cells outside of the grid are zero, so only the rows
+			// below the grid need checks.
+			const auto mvm = [&](FDMVector3* v, bool isResidual, FDMVector3* result)
+			{
+				decomposition.ExchangeHalos(rank, transport, v);
+
+				forEachInterior([&](size_t i, size_t j, size_t k)
+				{
+					const size_t gi = origin.x + i - 1;
+					const size_t gj = origin.y + j - 1;
+					const size_t gk = origin.z + k - 1;
+					const FDMMatrixRow3& row = A(gi, gj, gk);
+
+					const double av =
+						row.center * (*v)(i, j, k) +
+						((gi > 0) ? A(gi - 1, gj, gk).right * (*v)(i - 1, j, k) : 0.0) +
+						row.right * (*v)(i + 1, j, k) +
+						((gj > 0) ? A(gi, gj - 1, gk).up * (*v)(i, j - 1, k) : 0.0) +
+						row.up * (*v)(i, j + 1, k) +
+						((gk > 0) ? A(gi, gj, gk - 1).front * (*v)(i, j, k - 1) : 0.0) +
+						row.front * (*v)(i, j, k + 1);
+
+					(*result)(i, j, k) = isResidual ? b(gi, gj, gk) - av : av;
+				});
+			};
+
+			// Jacobi preconditioner
+			const auto precondition = [&](const FDMVector3& u, FDMVector3* result)
+			{
+				forEachInterior([&](size_t i, size_t j, size_t k)
+				{
+					const double center = A(origin.x + i - 1, origin.y + j - 1, origin.z + k - 1).center;
+					(*result)(i, j, k) = (center != 0.0) ? u(i, j, k) / center : 0.0;
+				});
+			};
+
+			const auto axpy = [&](double a, const FDMVector3& u, const FDMVector3& v, FDMVector3* result)
+			{
+				forEachInterior([&](size_t i, size_t j, size_t k)
+				{
+					(*result)(i, j, k) = a * u(i, j, k) + v(i, j, k);
+				});
+			};
+
+			// r = b - Ax
+			mvm(&x, true, &r);
+
+			// d = M^-1r
+			precondition(r, &d);
+
+			// sigmaNew = r.d
+			double sigmaNew = dot(r, d);
+
+			unsigned int iter = 0;
+			bool trigger = false;
+
+			while (sigmaNew > Square(m_tolerance) && iter < m_maxNumberOfIterations)
+			{
+				// q = Ad
+				mvm(&d, false, &q);
+
+				// alpha = sigmaNew / d.q
+				const double alpha = sigmaNew / dot(d, q);
+
+				// x = x + alpha * d
+				axpy(alpha, d, x, &x);
+
+				if (trigger || (iter % 50 == 0 && iter > 0))
+				{
+					// r = b - Ax
+					mvm(&x, true, &r);
+					trigger = false;
+				}
+				else
+				{
+					// r = r - alpha * q
+					axpy(-alpha, q, r, &r);
+				}
+
+				// s = M^-1r
+				precondition(r, &s);
+
+				const double sigmaOld = sigmaNew;
+
+				// sigmaNew = r.s
+				sigmaNew = dot(r, s);
+
+				if (sigmaNew > sigmaOld)
+				{
+					trigger = true;
+				}
+
+				// d = s + beta * d
+				axpy(sigmaNew / sigmaOld, d, s, &d);
+
+				++iter;
+			}
+
+			decomposition.Gather(rank, x.ConstAccessor(), system->x.Accessor());
+
+			// Every rank has the same reduced values
+			if (rank == 0)
+			{
+				m_lastNumberOfIterations = iter;
+				m_lastResidual = std::sqrt(sigmaNew);
+			}
+		});
+
+		return (m_lastResidual <= m_tolerance) || (m_lastNumberOfIterations < m_maxNumberOfIterations);
+	}
+
+	const Size3& FDMDistributedCGSolver3::GetLayout() const
+	{
+		return m_layout;
+	}
+
+	unsigned int FDMDistributedCGSolver3::GetMaxNumberOfIterations() const
+	{
+		return m_maxNumberOfIterations;
+	}
+
+	unsigned int FDMDistributedCGSolver3::GetLastNumberOfIterations() const
+	{
+		return m_lastNumberOfIterations;
+	}
+
+	double FDMDistributedCGSolver3::GetTolerance() const
+	{
+		return m_tolerance;
+	}
+
+	double FDMDistributedCGSolver3::GetLastResidual() const
+	{
+		return m_lastResidual;
+	}
+}
\ No newline at end of file
@@ -7,18 +7,25 @@
 > Copyright (c) 2017, Chan-Ho Chris Ohk
 *************************************************************************/
 #include <Solver/FDM/FDMGaussSeidelSolver2.h>
+#include <Utils/Parallel.h>
+
+#include <algorithm>
 
 namespace CubbyFlow
 {
 	FDMGaussSeidelSolver2::FDMGaussSeidelSolver2(
 		unsigned int maxNumberOfIterations,
 		unsigned int residualCheckInterval,
-		double tolerance) :
+		double tolerance,
+		double sorFactor,
+		Ordering ordering) :
 		m_maxNumberOfIterations(maxNumberOfIterations),
 		m_lastNumberOfIterations(0),
 		m_residualCheckInterval(residualCheckInterval),
 		m_tolerance(tolerance),
-		m_lastResidual(std::numeric_limits<double>::max())
+		m_lastResidual(std::numeric_limits<double>::max()),
+		m_sorFactor(sorFactor),
+		m_ordering(ordering)
 	{
 		// Do nothing
 	}
@@ -31,7 +38,7 @@ namespace CubbyFlow
 
 		for (unsigned int iter = 0; iter < m_maxNumberOfIterations; ++iter)
 		{
-			Relax(system);
+			Relax(system->A, system->b, m_sorFactor, m_ordering, &system->x);
 
 			if (iter != 0 && iter % m_residualCheckInterval == 0)
 			{
@@ -71,22 +78,137 @@ namespace CubbyFlow
 		return m_lastResidual;
 	}
 
-	void FDMGaussSeidelSolver2::Relax(FDMLinearSystem2* system)
+	double FDMGaussSeidelSolver2::GetSORFactor() const
+	{
+		return m_sorFactor;
+	}
+
+	FDMGaussSeidelSolver2::Ordering FDMGaussSeidelSolver2::GetOrdering() const
+	{
+		return m_ordering;
+	}
+
+	void FDMGaussSeidelSolver2::Relax(
+		const FDMMatrix2& A,
+		const FDMVector2& b,
+		double sorFactor,
+		Ordering ordering,
+		FDMVector2* x)
 	{
-		Size2 size = system->x.size();
-		FDMMatrix2& A = system->A;
-		FDMVector2& x = system->x;
-		FDMVector2& b = system->b;
+		Size2 size = A.size();
 
-		A.ForEachIndex([&](size_t i, size_t j)
+		const auto relaxCell = [&](size_t i, size_t j)
 		{
 			double r =
-				((i > 0) ? A(i - 1, j).right * x(i - 1, j) : 0.0) +
-				((i + 1 < size.x) ? A(i, j).right * x(i + 1, j) : 0.0) +
-				((j > 0) ? A(i, j - 1).up * x(i, j - 1) : 0.0) +
-				((j + 1 < size.y) ? A(i, j).up * x(i, j + 1) : 0.0);
+				((i > 0) ? A(i - 1, j).right * (*x)(i - 1, j) : 0.0) +
+				((i + 1 < size.x) ? A(i, j).right * (*x)(i + 1, j) : 0.0) +
+				((j > 0) ? A(i, j - 1).up * (*x)(i, j - 1) : 0.0) +
+				((j + 1 < size.y) ? A(i, j).up * (*x)(i, j + 1) : 0.0);
+
+			(*x)(i, j) = (1.0 - sorFactor) * (*x)(i, j) + sorFactor * (b(i, j) - r) / A(i, j).center;
+		};
+
+		if (ordering == Ordering::Lexicographic)
+		{
+			A.ForEachIndex(relaxCell);
+			return;
+		}
+
+		if (ordering == Ordering::RedBlack)
+		{
+			// Red-black colors the cells by the parity of i + j
+			const auto relaxRow = [&](size_t color, size_t j)
+			{
+				for (size_t i = (j + color) & 1; i < size.x; i += 2)
+				{
+					relaxCell(i, j);
+				}
+			};
+
+			// Both colors are swept in one pass over a slab of rows. The black
+			// cells of a row only depend on the red cells of the row and its
+			// neighbors, so they are updated right after the red cells of the
+			// next row, while the three rows are still in cache. The black
+			// cells of the first and the last row of a slab depend on the red
+			// cells of the neighboring slabs, so they are updated after every
+			// slab is done.
+			const size_t numberOfSlabs = std::min<size_t>(GetMaxNumberOfThreads(), size.y);
+			const auto getSlabBegin = [&](size_t slab)
+			{
+				return slab * size.y / numberOfSlabs;
+			};
+
+			ParallelFor(ZERO_SIZE, numberOfSlabs, [&](size_t slab)
+			{
+				const size_t jBegin = getSlabBegin(slab);
+				const size_t jEnd = getSlabBegin(slab + 1);
+
+				for (size_t j = jBegin; j < jEnd; ++j)
+				{
+					relaxRow(0, j);
+
+					if (j >= jBegin + 2)
+					{
+						relaxRow(1, j - 1);
+					}
+				}
+			});
+
+			ParallelFor(ZERO_SIZE, numberOfSlabs, [&](size_t slab)
+			{
+				const size_t jBegin = getSlabBegin(slab);
+				const size_t jEnd = getSlabBegin(slab + 1);
+
+				relaxRow(1, jBegin);
+
+				if (jEnd - 1 > jBegin)
+				{
+					relaxRow(1, jEnd - 1);
+				}
+			});
+
+			return;
+		}
+
+		const size_t numberOfColors = 4;
+
+		for (size_t color = 0; color < numberOfColors; ++color)
+		{
+			// Multicolor colors the cells by the parities of i and j, so only
+			// every other row holds the cells of a color.
+			const size_t colorJ = (color >> 1) & 1;
+			const size_t strideJ = 2;
+
+			if (colorJ >= size.y)
+			{
+				continue;
+			}
 
-			x(i, j) = (b(i, j) - r) / A(i, j).center;
-		});
+			const size_t numberOfRows = (size.y - colorJ + strideJ - 1) / strideJ;
+
+			// Each thread streams through a contiguous block of rows
+			ParallelFor(ZERO_SIZE, numberOfRows, [&](size_t row)
+			{
+				const size_t j = colorJ + strideJ * row;
+
+				for (size_t i = color & 1; i < size.x; i += 2)
+				{
+					relaxCell(i, j);
+				}
+			});
+		}
+	}
+
+	MultiGridRelaxFunc<FDMBlas2> FDMGaussSeidelSolver2::GetMultiGridRelaxFunc(double sorFactor, Ordering ordering)
+	{
+		return [sorFactor, ordering](
+			const FDMMatrix2& A, const FDMVector2& b, unsigned int numberOfIterations,
+			double, FDMVector2* x, FDMVector2*)
+		{
+			for (unsigned int iter = 0; iter < numberOfIterations; ++iter)
+			{
+				Relax(A, b, sorFactor, ordering, x);
+			}
+		};
 	}
 }
\ No newline at end of file
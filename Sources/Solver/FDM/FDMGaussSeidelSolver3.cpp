@@ -7,18 +7,25 @@
 > Copyright (c) 2017, Chan-Ho Chris Ohk
 *************************************************************************/
 #include <Solver/FDM/FDMGaussSeidelSolver3.h>
+#include <Utils/Parallel.h>
+
+#include <algorithm>
 
 namespace CubbyFlow
 {
 	FDMGaussSeidelSolver3::FDMGaussSeidelSolver3(
 		unsigned int maxNumberOfIterations,
 		unsigned int residualCheckInterval,
-		double tolerance) :
+		double tolerance,
+		double sorFactor,
+		Ordering ordering) :
 		m_maxNumberOfIterations(maxNumberOfIterations),
 		m_lastNumberOfIterations(0),
 		m_residualCheckInterval(residualCheckInterval),
 		m_tolerance(tolerance),
-		m_lastResidual(std::numeric_limits<double>::max())
+		m_lastResidual(std::numeric_limits<double>::max()),
+		m_sorFactor(sorFactor),
+		m_ordering(ordering)
 	{
 		// Do nothing
 	}
@@ -31,7 +38,7 @@ namespace CubbyFlow
 
 		for (unsigned int iter = 0; iter < m_maxNumberOfIterations; ++iter)
 		{
-			Relax(system);
+			Relax(system->A, system->b, m_sorFactor, m_ordering, &system->x);
 
 			if (iter != 0 && iter % m_residualCheckInterval == 0)
 			{
@@ -71,24 +78,145 @@ namespace CubbyFlow
 		return m_lastResidual;
 	}
 
-	void FDMGaussSeidelSolver3::Relax(FDMLinearSystem3* system)
+	double FDMGaussSeidelSolver3::GetSORFactor() const
+	{
+		return m_sorFactor;
+	}
+
+	FDMGaussSeidelSolver3::Ordering FDMGaussSeidelSolver3::GetOrdering() const
+	{
+		return m_ordering;
+	}
+
+	void FDMGaussSeidelSolver3::Relax(
+		const FDMMatrix3& A,
+		const FDMVector3& b,
+		double sorFactor,
+		Ordering ordering,
+		FDMVector3* x)
 	{
-		Size3 size = system->x.size();
-		FDMMatrix3& A = system->A;
-		FDMVector3& x = system->x;
-		FDMVector3& b = system->b;
+		Size3 size = A.size();
 
-		A.ForEachIndex([&](size_t i, size_t j, size_t k)
+		const auto relaxCell = [&](size_t i, size_t j, size_t k)
 		{
 			double r =
-				((i > 0) ? A(i - 1, j, k).right * x(i - 1, j, k) : 0.0) +
-				((i + 1 < size.x) ? A(i, j, k).right * x(i + 1, j, k) : 0.0) +
-				((j > 0) ? A(i, j - 1, k).up * x(i, j - 1, k) : 0.0) +
-				((j + 1 < size.y) ? A(i, j, k).up * x(i, j + 1, k) : 0.0) +
-				((k > 0) ? A(i, j, k - 1).front * x(i, j, k - 1) : 0.0) +
-				((k + 1 < size.z) ? A(i, j, k).front * x(i, j, k + 1) : 0.0);
-
-			x(i, j, k) = (b(i, j, k) - r) / A(i, j, k).center;
-		});
+				((i > 0) ? A(i - 1, j, k).right * (*x)(i - 1, j, k) : 0.0) +
+				((i + 1 < size.x) ? A(i, j, k).right * (*x)(i + 1, j, k) : 0.0) +
+				((j > 0) ? A(i, j - 1, k).up * (*x)(i, j - 1, k) : 0.0) +
+				((j + 1 < size.y) ? A(i, j, k).up * (*x)(i, j + 1, k) : 0.0) +
+				((k > 0) ? A(i, j, k - 1).front * (*x)(i, j, k - 1) : 0.0) +
+				((k + 1 < size.z) ? A(i, j, k).front * (*x)(i, j, k + 1) : 0.0);
+
+			(*x)(i, j, k) = (1.0 - sorFactor) * (*x)(i, j, k) + sorFactor * (b(i, j, k) - r) / A(i, j, k).center;
+		};
+
+		if (ordering == Ordering::Lexicographic)
+		{
+			A.ForEachIndex(relaxCell);
+			return;
+		}
+
+		if (ordering == Ordering::RedBlack)
+		{
+			// Red-black colors the cells by the parity of i + j + k
+			const auto relaxPlane = [&](size_t color, size_t k)
+			{
+				for (size_t j = 0; j < size.y; ++j)
+				{
+					for (size_t i = (j + k + color) & 1; i < size.x; i += 2)
+					{
+						relaxCell(i, j, k);
+					}
+				}
+			};
+
+			// Both colors are swept in one pass over a slab of planes. The
+			// black cells of a plane only depend on the red cells of the
+			// plane and its neighbors, so they are updated right after the
+			// red cells of the next plane, while the three planes are still
+			// in cache. The black cells of the first and the last plane of a
+			// slab depend on the red cells of the neighboring slabs, so they
+			// are updated after every slab is done.
+			const size_t numberOfSlabs = std::min<size_t>(GetMaxNumberOfThreads(), size.z);
+			const auto getSlabBegin = [&](size_t slab)
+			{
+				return slab * size.z / numberOfSlabs;
+			};
+
+			ParallelFor(ZERO_SIZE, numberOfSlabs, [&](size_t slab)
+			{
+				const size_t kBegin = getSlabBegin(slab);
+				const size_t kEnd = getSlabBegin(slab + 1);
+
+				for (size_t k = kBegin; k < kEnd; ++k)
+				{
+					relaxPlane(0, k);
+
+					if (k >= kBegin + 2)
+					{
+						relaxPlane(1, k - 1);
+					}
+				}
+			});
+
+			ParallelFor(ZERO_SIZE, numberOfSlabs, [&](size_t slab)
+			{
+				const size_t kBegin = getSlabBegin(slab);
+				const size_t kEnd = getSlabBegin(slab + 1);
+
+				relaxPlane(1, kBegin);
+
+				if (kEnd - 1 > kBegin)
+				{
+					relaxPlane(1, kEnd - 1);
+				}
+			});
+
+			return;
+		}
+
+		const size_t numberOfColors = 8;
+
+		for (size_t color = 0; color < numberOfColors; ++color)
+		{
+			// Multicolor colors the cells by the parities of i, j, and k, so
+			// only every other row in j and k holds the cells of a color.
+			const size_t colorJ = (color >> 1) & 1;
+			const size_t colorK = (color >> 2) & 1;
+			const size_t strideJK = 2;
+
+			if (colorJ >= size.y || colorK >= size.z)
+			{
+				continue;
+			}
+
+			const size_t numberOfRowsJ = (size.y - colorJ + strideJK - 1) / strideJK;
+			const size_t numberOfRowsK = (size.z - colorK + strideJK - 1) / strideJK;
+
+			// Each thread streams through a contiguous block of rows
+			ParallelFor(ZERO_SIZE, numberOfRowsJ * numberOfRowsK, [&](size_t row)
+			{
+				const size_t j = colorJ + strideJK * (row % numberOfRowsJ);
+				const size_t k = colorK + strideJK * (row / numberOfRowsJ);
+
+				for (size_t i = color & 1; i < size.x; i += 2)
+				{
+					relaxCell(i, j, k);
+				}
+			});
+		}
+	}
+
+	MultiGridRelaxFunc<FDMBlas3> FDMGaussSeidelSolver3::GetMultiGridRelaxFunc(double sorFactor, Ordering ordering)
+	{
+		return [sorFactor, ordering](
+			const FDMMatrix3& A, const FDMVector3& b, unsigned int numberOfIterations,
+			double, FDMVector3* x, FDMVector3*)
+		{
+			for (unsigned int iter = 0; iter < numberOfIterations; ++iter)
+			{
+				Relax(A, b, sorFactor, ordering, x);
+			}
+		};
 	}
 }
\ No newline at end of file
@@ -10,34 +10,88 @@
 #include <Math/CG.h>
 #include <Solver/FDM/FDMICCGSolver3.h>
 #include <Utils/Logger.h>
+#include <Utils/Parallel.h>
+#include <Utils/Timer.h>
 
 namespace CubbyFlow
 {
-	void FDMICCGSolver3::Preconditioner::Build(const FDMMatrix3& matrix)
+	void FDMICCGSolver3::Preconditioner::Factorize(const FDMMatrix3& matrix)
 	{
 		Size3 size = matrix.size();
 		A = matrix.ConstAccessor();
 
-		d.Resize(size, 0.0);
-		y.Resize(size, 0.0);
+		const size_t numberOfRows = size.y * size.z;
+		size_t firstRow = 0;
 
-		matrix.ForEachIndex([&](size_t i, size_t j, size_t k)
+		if (factored.size() == size)
 		{
-			double denom =
-				matrix(i, j, k).center -
-				((i > 0) ? Square(matrix(i - 1, j, k).right) * d(i - 1, j, k) : 0.0) -
-				((j > 0) ? Square(matrix(i, j - 1, k).up)    * d(i, j - 1, k) : 0.0) -
-				((k > 0) ? Square(matrix(i, j, k - 1).front) * d(i, j, k - 1) : 0.0);
-
-			if (std::fabs(denom) > 0.0)
+			// Finds the first row of the grid changed since the last build
+			firstRow = ParallelReduce(ZERO_SIZE, numberOfRows, numberOfRows,
+				[&](size_t begin, size_t end, size_t result)
 			{
-				d(i, j, k) = 1.0 / denom;
-			}
-			else
+				for (size_t row = begin; row < end; ++row)
+				{
+					const FDMMatrixRow3* newRow = matrix.data() + row * size.x;
+					const FDMMatrixRow3* oldRow = factored.data() + row * size.x;
+
+					for (size_t i = 0; i < size.x; ++i)
+					{
+						if (newRow[i].center != oldRow[i].center ||
+							newRow[i].right != oldRow[i].right ||
+							newRow[i].up != oldRow[i].up ||
+							newRow[i].front != oldRow[i].front)
+						{
+							return std::min(row, result);
+						}
+					}
+				}
+
+				return result;
+			}, [](size_t a, size_t b) { return std::min(a, b); });
+		}
+		else
+		{
+			factored.Resize(size);
+			d.Resize(size, 0.0);
+			y.Resize(size, 0.0);
+		}
+
+		if (firstRow == numberOfRows)
+		{
+			return;
+		}
+
+		std::copy(matrix.data() + firstRow * size.x, matrix.data() + numberOfRows * size.x, factored.data() + firstRow * size.x);
+
+		// The factorization of a row depends on the preceding rows only
+		for (size_t k = firstRow / size.y; k < size.z; ++k)
+		{
+			for (size_t j = (k == firstRow / size.y) ? firstRow % size.y : 0; j < size.y; ++j)
 			{
-				d(i, j, k) = 0.0;
+				for (size_t i = 0; i < size.x; ++i)
+				{
+					double denom =
+						matrix(i, j, k).center -
+						((i > 0) ? Square(matrix(i - 1, j, k).right) * d(i - 1, j, k) : 0.0) -
+						((j > 0) ? Square(matrix(i, j - 1, k).up)    * d(i, j - 1, k) : 0.0) -
+						((k > 0) ? Square(matrix(i, j, k - 1).front) * d(i, j, k - 1) : 0.0);
+
+					if (std::fabs(denom) > 0.0)
+					{
+						d(i, j, k) = 1.0 / denom;
+					}
+					else
+					{
+						d(i, j, k) = 0.0;
+					}
+				}
 			}
-		});
+		}
+	}
+
+	void FDMICCGSolver3::Preconditioner::Build(const FDMMatrix3&)
+	{
+		// Do nothing
 	}
 
 	void FDMICCGSolver3::Preconditioner::Solve(const FDMVector3& b, FDMVector3* x)
@@ -74,11 +128,17 @@ namespace CubbyFlow
 		}
 	}
 
-	FDMICCGSolver3::FDMICCGSolver3(unsigned int maxNumberOfIterations, double tolerance) :
+	FDMICCGSolver3::FDMICCGSolver3(
+		unsigned int maxNumberOfIterations,
+		double tolerance,
+		double relativeTolerance,
+		bool isWarmStarted) :
 		m_maxNumberOfIterations(maxNumberOfIterations),
 		m_lastNumberOfIterations(0),
 		m_tolerance(tolerance),
-		m_lastResidualNorm(std::numeric_limits<double>::max())
+		m_lastResidualNorm(std::numeric_limits<double>::max()),
+		m_relativeTolerance(relativeTolerance),
+		m_isWarmStarted(isWarmStarted)
 	{
 		// Do nothing
 	}
@@ -92,25 +152,37 @@ namespace CubbyFlow
 		assert(matrix.size() == rhs.size());
 		assert(matrix.size() == solution.size());
 
+		Timer timer;
+
+		// PCG clears the work vectors
 		Size3 size = matrix.size();
 		m_r.Resize(size);
 		m_d.Resize(size);
 		m_q.Resize(size);
 		m_s.Resize(size);
 
-		system->x.Set(0.0);
-		m_r.Set(0.0);
-		m_d.Set(0.0);
-		m_q.Set(0.0);
-		m_s.Set(0.0);
+		if (!m_isWarmStarted)
+		{
+			system->x.Set(0.0);
+		}
 
-		m_precond.Build(matrix);
+		// Only the rows changed since the last solve are factorized again
+		m_precond.Factorize(matrix);
+
+		double tolerance = m_tolerance;
+		if (m_relativeTolerance > 0.0)
+		{
+			// PCG measures the residual r by sqrt(r.M^-1r), so does the
+			// right-hand side.
+			m_precond.Solve(rhs, &m_s);
+			tolerance = std::max(tolerance, m_relativeTolerance * std::sqrt(FDMBlas3::Dot(rhs, m_s)));
+		}
 
 		PCG<FDMBlas3, Preconditioner>(
 			matrix,
 			rhs,
 			m_maxNumberOfIterations,
-			m_tolerance,
+			tolerance,
 			&m_precond,
 			&solution,
 			&m_r,
@@ -121,9 +193,11 @@ namespace CubbyFlow
 			&m_lastResidualNorm);
 
 		CUBBYFLOW_INFO << "Residual norm after solving ICCG: " << m_lastResidualNorm
-			<< " Number of ICCG iterations: " << m_lastNumberOfIterations;
+			<< " Number of ICCG iterations: " << m_lastNumberOfIterations
+			<< (m_isWarmStarted ? " (warm-started)" : "")
+			<< " Solving ICCG took " << timer.DurationInSeconds() << " seconds";
 
-		return (m_lastResidualNorm <= m_tolerance) || (m_lastNumberOfIterations < m_maxNumberOfIterations);
+		return (m_lastResidualNorm <= tolerance) || (m_lastNumberOfIterations < m_maxNumberOfIterations);
 	}
 
 	unsigned int FDMICCGSolver3::GetMaxNumberOfIterations() const
@@ -145,4 +219,14 @@ namespace CubbyFlow
 	{
 		return m_lastResidualNorm;
 	}
+
+	double FDMICCGSolver3::GetRelativeTolerance() const
+	{
+		return m_relativeTolerance;
+	}
+
+	bool FDMICCGSolver3::IsWarmStarted() const
+	{
+		return m_isWarmStarted;
+	}
 }
\ No newline at end of file
@@ -13,12 +13,14 @@ namespace CubbyFlow
 	FDMJacobiSolver3::FDMJacobiSolver3(
 		unsigned int maxNumberOfIterations,
 		unsigned int residualCheckInterval,
-		double tolerance) :
+		double tolerance,
+		unsigned int temporalBlockSize) :
 		m_maxNumberOfIterations(maxNumberOfIterations),
 		m_lastNumberOfIterations(0),
 		m_residualCheckInterval(residualCheckInterval),
 		m_tolerance(tolerance),
-		m_lastResidual(std::numeric_limits<double>::max())
+		m_lastResidual(std::numeric_limits<double>::max()),
+		m_stencil(temporalBlockSize)
 	{
 		// Do nothing
 	}
@@ -30,18 +32,25 @@ namespace CubbyFlow
 
 		m_lastNumberOfIterations = m_maxNumberOfIterations;
 
-		for (unsigned int iter = 0; iter < m_maxNumberOfIterations; ++iter)
+		unsigned int iter = 0;
+
+		while (iter < m_maxNumberOfIterations)
 		{
-			Relax(system, &m_xTemp);
-			m_xTemp.Swap(system->x);
+			// The residual is checked after the iteration of a nonzero index
+			// that is a multiple of the interval
+			const unsigned int checkIter = std::max((iter + m_residualCheckInterval - 1) / m_residualCheckInterval, 1u) * m_residualCheckInterval;
+			const unsigned int endIter = std::min(checkIter + 1, m_maxNumberOfIterations);
+
+			Relax(system, endIter - iter);
+			iter = endIter;
 
-			if (iter != 0 && iter % m_residualCheckInterval == 0)
+			if (iter == checkIter + 1)
 			{
 				FDMBlas3::Residual(system->A, system->x, system->b, &m_residual);
 
 				if (FDMBlas3::L2Norm(m_residual) < m_tolerance)
 				{
-					m_lastNumberOfIterations = iter + 1;
+					m_lastNumberOfIterations = iter;
 					break;
 				}
 			}
@@ -73,24 +82,28 @@ namespace CubbyFlow
 		return m_lastResidual;
 	}
 
-	void FDMJacobiSolver3::Relax(FDMLinearSystem3* system, FDMVector3* xTemp)
+	unsigned int FDMJacobiSolver3::GetTemporalBlockSize() const
+	{
+		return m_stencil.GetTemporalBlockSize();
+	}
+
+	void FDMJacobiSolver3::Relax(FDMLinearSystem3* system, unsigned int numberOfIterations)
 	{
 		Size3 size = system->x.size();
-		FDMMatrix3& A = system->A;
-		FDMVector3& x = system->x;
-		FDMVector3& b = system->b;
+		const FDMMatrix3& A = system->A;
+		const FDMVector3& b = system->b;
 
-		A.ParallelForEachIndex([&](size_t i, size_t j, size_t k)
+		m_stencil.Apply([&](size_t i, size_t j, size_t k, const FDMStencilValues3<double>& x)
 		{
 			double r =
-				((i > 0) ? A(i - 1, j, k).right * x(i - 1, j, k) : 0.0) +
-				((i + 1 < size.x) ? A(i, j, k).right * x(i + 1, j, k) : 0.0) +
-				((j > 0) ? A(i, j - 1, k).up * x(i, j - 1, k) : 0.0) +
-				((j + 1 < size.y) ? A(i, j, k).up * x(i, j + 1, k) : 0.0) +
-				((k > 0) ? A(i, j, k - 1).front * x(i, j, k - 1) : 0.0) +
-				((k + 1 < size.z) ? A(i, j, k).front * x(i, j, k + 1) : 0.0);
-
-			(*xTemp)(i, j, k) = (b(i, j, k) - r) / A(i, j, k).center;
-		});
+				((i > 0) ? A(i - 1, j, k).right * x.left : 0.0) +
+				((i + 1 < size.x) ? A(i, j, k).right * x.right : 0.0) +
+				((j > 0) ? A(i, j - 1, k).up * x.down : 0.0) +
+				((j + 1 < size.y) ? A(i, j, k).up * x.up : 0.0) +
+				((k > 0) ? A(i, j, k - 1).front * x.back : 0.0) +
+				((k + 1 < size.z) ? A(i, j, k).front * x.front : 0.0);
+
+			return (b(i, j, k) - r) / A(i, j, k).center;
+		}, numberOfIterations, system->x.Accessor(), m_xTemp.Accessor());
 	}
 }
\ No newline at end of file
@@ -241,6 +241,40 @@ namespace CubbyFlow
 		return static_cast<unsigned int>(std::max(std::ceil(currentCFL / m_maxCFL), 1.0));
 	}
 
+	void GridFluidSolver3::OnSaveCheckpoint(CheckpointWriter* writer) const
+	{
+		PhysicsAnimation::OnSaveCheckpoint(writer);
+
+		m_grids->SaveCheckpoint(writer, "grids.");
+
+		if (m_emitter != nullptr)
+		{
+			m_emitter->SaveCheckpoint(writer, "emitter.");
+		}
+
+		if (m_collider != nullptr)
+		{
+			m_collider->SaveCheckpoint(writer, "collider.");
+		}
+	}
+
+	void GridFluidSolver3::OnLoadCheckpoint(const CheckpointReader& reader)
+	{
+		PhysicsAnimation::OnLoadCheckpoint(reader);
+
+		m_grids->LoadCheckpoint(reader, "grids.");
+
+		if (m_emitter != nullptr)
+		{
+			m_emitter->LoadCheckpoint(reader, "emitter.");
+		}
+
+		if (m_collider != nullptr)
+		{
+			m_collider->LoadCheckpoint(reader, "collider.");
+		}
+	}
+
 	void GridFluidSolver3::OnBeginAdvanceTimeStep(double timeIntervalInSeconds)
 	{
 		// Do nothing
@@ -68,11 +68,74 @@ namespace CubbyFlow
 			(dFront - dBack) / Square(GridSpacing.z);
 	}
 
-	GridForwardEulerDiffusionSolver3::GridForwardEulerDiffusionSolver3()
+	template <typename T>
+	T Laplacian(
+		const FDMStencilValues3<T>& values,
+		const Array3<char>& marker,
+		const Vector3D& GridSpacing,
+		size_t i, size_t j, size_t k)
+	{
+		const Size3 ds = marker.size();
+
+		T dLeft = Zero<T>();
+		T dRight = Zero<T>();
+		T dDown = Zero<T>();
+		T dUp = Zero<T>();
+		T dBack = Zero<T>();
+		T dFront = Zero<T>();
+
+		if (i > 0 && marker(i - 1, j, k) == FLUID)
+		{
+			dLeft = values.center - values.left;
+		}
+		if (i + 1 < ds.x && marker(i + 1, j, k) == FLUID)
+		{
+			dRight = values.right - values.center;
+		}
+
+		if (j > 0 && marker(i, j - 1, k) == FLUID)
+		{
+			dDown = values.center - values.down;
+		}
+		if (j + 1 < ds.y && marker(i, j + 1, k) == FLUID)
+		{
+			dUp = values.up - values.center;
+		}
+
+		if (k > 0 && marker(i, j, k - 1) == FLUID)
+		{
+			dBack = values.center - values.back;
+		}
+		if (k + 1 < ds.z && marker(i, j, k + 1) == FLUID)
+		{
+			dFront = values.front - values.center;
+		}
+
+		return
+			(dRight - dLeft) / Square(GridSpacing.x) +
+			(dUp - dDown) / Square(GridSpacing.y) +
+			(dFront - dBack) / Square(GridSpacing.z);
+	}
+
+	static double Laplacian(const FDMStencilValues3<double>& values, const Vector3D& GridSpacing)
+	{
+		return
+			((values.right - values.center) - (values.center - values.left)) / Square(GridSpacing.x) +
+			((values.up - values.center) - (values.center - values.down)) / Square(GridSpacing.y) +
+			((values.front - values.center) - (values.center - values.back)) / Square(GridSpacing.z);
+	}
+
+	GridForwardEulerDiffusionSolver3::GridForwardEulerDiffusionSolver3(unsigned int numberOfSubSteps) :
+		m_numberOfSubSteps(std::max(numberOfSubSteps, 1u))
 	{
 		// Do nothing
 	}
 
+	unsigned int GridForwardEulerDiffusionSolver3::GetNumberOfSubSteps() const
+	{
+		return m_numberOfSubSteps;
+	}
+
 	void GridForwardEulerDiffusionSolver3::Solve(
 		const ScalarGrid3& source,
 		double diffusionCoefficient,
@@ -87,6 +150,29 @@ namespace CubbyFlow
 
 		BuildMarkers(source.Resolution(), pos, boundarySDF, fluidSDF);
 
+		if (m_numberOfSubSteps > 1)
+		{
+			const double subTimeInterval = timeIntervalInSeconds / m_numberOfSubSteps;
+
+			dest->ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+			{
+				(*dest)(i, j, k) = source(i, j, k);
+			});
+
+			m_buffer.Resize(source.GetDataSize());
+			m_stencil.Apply([&](size_t i, size_t j, size_t k, const FDMStencilValues3<double>& values)
+			{
+				if (m_markers(i, j, k) == FLUID)
+				{
+					return values.center + diffusionCoefficient * subTimeInterval * Laplacian(values, m_markers, h, i, j, k);
+				}
+
+				return values.center;
+			}, m_numberOfSubSteps, dest->GetDataAccessor(), m_buffer.Accessor());
+
+			return;
+		}
+
 		source.ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k)
 		{
 			if (m_markers(i, j, k) == FLUID)
@@ -114,6 +200,29 @@ namespace CubbyFlow
 
 		BuildMarkers(source.Resolution(), pos, boundarySDF, fluidSDF);
 
+		if (m_numberOfSubSteps > 1)
+		{
+			const double subTimeInterval = timeIntervalInSeconds / m_numberOfSubSteps;
+
+			dest->ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+			{
+				(*dest)(i, j, k) = source(i, j, k);
+			});
+
+			m_vectorBuffer.Resize(source.GetDataSize());
+			m_stencil.Apply([&](size_t i, size_t j, size_t k, const FDMStencilValues3<Vector3D>& values)
+			{
+				if (m_markers(i, j, k) == FLUID)
+				{
+					return values.center + diffusionCoefficient * subTimeInterval * Laplacian(values, m_markers, h, i, j, k);
+				}
+
+				return values.center;
+			}, m_numberOfSubSteps, dest->GetDataAccessor(), m_vectorBuffer.Accessor());
+
+			return;
+		}
+
 		source.ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k)
 		{
 			if (m_markers(i, j, k) == FLUID)
@@ -146,6 +255,41 @@ namespace CubbyFlow
 		auto wPos = source.GetWPosition();
 		Vector3D h = source.GridSpacing();
 
+		if (m_numberOfSubSteps > 1)
+		{
+			const double subTimeInterval = timeIntervalInSeconds / m_numberOfSubSteps;
+
+			const auto solveComponent = [&](
+				const ConstArrayAccessor3<double>& componentSrc,
+				ArrayAccessor3<double> component,
+				const std::function<Vector3D(size_t, size_t, size_t)>& componentPos)
+			{
+				BuildMarkers(componentSrc.size(), componentPos, boundarySDF, fluidSDF);
+
+				component.ParallelForEachIndex([&](size_t i, size_t j, size_t k)
+				{
+					component(i, j, k) = componentSrc(i, j, k);
+				});
+
+				m_buffer.Resize(componentSrc.size());
+				m_stencil.Apply([&](size_t i, size_t j, size_t k, const FDMStencilValues3<double>& values)
+				{
+					if (m_markers(i, j, k) != BOUNDARY)
+					{
+						return values.center + diffusionCoefficient * subTimeInterval * Laplacian(values, h);
+					}
+
+					return values.center;
+				}, m_numberOfSubSteps, component, m_buffer.Accessor());
+			};
+
+			solveComponent(uSrc, u, uPos);
+			solveComponent(vSrc, v, vPos);
+			solveComponent(wSrc, w, wPos);
+
+			return;
+		}
+
 		BuildMarkers(source.GetUSize(), uPos, boundarySDF, fluidSDF);
 
 		source.ParallelForEachUIndex([&](size_t i, size_t j, size_t k)
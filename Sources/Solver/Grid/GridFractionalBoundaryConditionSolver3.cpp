@@ -6,15 +6,23 @@
 > Created Time: 2017/08/09
 > Copyright (c) 2017, Chan-Ho Chris Ohk
 *************************************************************************/
+#include <Array/ArraySamplers3.h>
 #include <Array/ArrayUtils.h>
+#include <Collider/RigidBodyCollider3.h>
 #include <LevelSet/LevelSetUtils.h>
 #include <Solver/Grid/GridFractionalBoundaryConditionSolver3.h>
 #include <Surface/Implicit/ImplicitSurface3.h>
+#include <Surface/Implicit/ImplicitSurfaceSet3.h>
 #include <Surface/Implicit/SurfaceToImplicit3.h>
+#include <Surface/SurfaceSet3.h>
 #include <Utils/PhysicsHelpers.h>
 
 namespace CubbyFlow
 {
+	// Number of grid cells the baked local-frame SDF extends beyond the bounding
+	// box of the collider surface.
+	static const double LOCAL_COLLIDER_SDF_PADDING = 4.0;
+
 	GridFractionalBoundaryConditionSolver3::GridFractionalBoundaryConditionSolver3()
 	{
 		// Do nothing
@@ -294,6 +302,27 @@ namespace CubbyFlow
 		return m_colliderVel;
 	}
 
+	bool GridFractionalBoundaryConditionSolver3::IsUsingColliderSDFCache() const
+	{
+		return m_isUsingColliderSDFCache;
+	}
+
+	void GridFractionalBoundaryConditionSolver3::SetIsUsingColliderSDFCache(bool isUsing)
+	{
+		m_isUsingColliderSDFCache = isUsing;
+
+		if (!isUsing)
+		{
+			InvalidateColliderSDFCache();
+		}
+	}
+
+	void GridFractionalBoundaryConditionSolver3::InvalidateColliderSDFCache()
+	{
+		m_localColliderSurface = nullptr;
+		m_localColliderSDF = nullptr;
+	}
+
 	void GridFractionalBoundaryConditionSolver3::OnColliderUpdated(
 		const Size3& gridSize,
 		const Vector3D& GridSpacing,
@@ -304,7 +333,15 @@ namespace CubbyFlow
 			m_colliderSDF = std::make_shared<CellCenteredScalarGrid3>();
 		}
 
-		m_colliderSDF->Resize(gridSize, GridSpacing, gridOrigin);
+		const bool isGridChanged =
+			m_colliderSDF->Resolution() != gridSize ||
+			m_colliderSDF->GridSpacing() != GridSpacing ||
+			m_colliderSDF->Origin() != gridOrigin;
+
+		if (isGridChanged)
+		{
+			m_colliderSDF->Resize(gridSize, GridSpacing, gridOrigin);
+		}
 
 		if (GetCollider() != nullptr)
 		{
@@ -315,10 +352,65 @@ namespace CubbyFlow
 				implicitSurface = std::make_shared<SurfaceToImplicit3>(surface);
 			}
 
-			m_colliderSDF->Fill([&](const Vector3D& pt)
+			const BoundingBox3D bounds = surface->BoundingBox();
+			const bool isBounded =
+				std::isfinite(bounds.Width()) &&
+				std::isfinite(bounds.Height()) &&
+				std::isfinite(bounds.Depth());
+			const bool isRigidBody = std::dynamic_pointer_cast<RigidBodyCollider3>(GetCollider()) != nullptr;
+
+			if (m_isUsingColliderSDFCache && isRigidBody && isBounded)
+			{
+				// The shape of a rigid body never changes, so the SDF is baked in
+				// the local frame once and only resampled when the body moves.
+				const bool isBaked =
+					m_localColliderSDF != nullptr &&
+					m_localColliderSurface == surface &&
+					m_localColliderSDF->GridSpacing() == GridSpacing;
+
+				if (!isBaked)
+				{
+					BakeLocalColliderSDF(*implicitSurface, surface->transform, GridSpacing);
+					m_localColliderSurface = surface;
+				}
+
+				const bool isMoved =
+					m_localColliderSDFTransform.GetTranslation() != surface->transform.GetTranslation() ||
+					!(m_localColliderSDFTransform.GetOrientation() == surface->transform.GetOrientation());
+
+				if (!isBaked || isGridChanged || isMoved)
+				{
+					ResampleLocalColliderSDF(surface->transform);
+				}
+			}
+			else
 			{
-				return implicitSurface->SignedDistance(pt);
-			});
+				InvalidateColliderSDFCache();
+
+				// A collider set holds its children in a SurfaceSet3, so its
+				// members are gathered into an implicit set to fill the SDF with
+				// the pruned queries
+				ImplicitSurfaceSet3Ptr implicitSurfaceSet = std::dynamic_pointer_cast<ImplicitSurfaceSet3>(implicitSurface);
+				if (implicitSurfaceSet == nullptr)
+				{
+					if (auto surfaceSet = std::dynamic_pointer_cast<SurfaceSet3>(surface))
+					{
+						implicitSurfaceSet = UpdateColliderSurfaceSet(surfaceSet);
+					}
+				}
+
+				if (implicitSurfaceSet != nullptr)
+				{
+					implicitSurfaceSet->FillSignedDistance(m_colliderSDF.get());
+				}
+				else
+				{
+					m_colliderSDF->Fill([&](const Vector3D& pt)
+					{
+						return implicitSurface->SignedDistance(pt);
+					});
+				}
+			}
 
 			m_colliderVel = CustomVectorField3::Builder()
 				.WithFunction([&](const Vector3D& x)
@@ -330,6 +422,8 @@ namespace CubbyFlow
 		}
 		else
 		{
+			InvalidateColliderSDFCache();
+
 			m_colliderSDF->Fill(std::numeric_limits<double>::max());
 
 			m_colliderVel = CustomVectorField3::Builder()
@@ -341,4 +435,120 @@ namespace CubbyFlow
 				.MakeShared();
 		}
 	}
-}
\ No newline at end of file
+
+	ImplicitSurfaceSet3Ptr GridFractionalBoundaryConditionSolver3::UpdateColliderSurfaceSet(const SurfaceSet3Ptr& surfaceSet)
+	{
+		const size_t numberOfSurfaces = surfaceSet->NumberOfSurfaces();
+		bool isSameSet = m_colliderSurfaceSet == surfaceSet && m_colliderSurfaceSetMembers.size() == numberOfSurfaces;
+		bool isMoved = false;
+
+		for (size_t i = 0; isSameSet && i < numberOfSurfaces; ++i)
+		{
+			const Surface3Ptr& member = surfaceSet->SurfaceAt(i);
+			const BoundingBox3D bound = member->BoundingBox();
+
+			isSameSet = m_colliderSurfaceSetMembers[i] == member;
+			isMoved = isMoved ||
+				m_colliderSurfaceSetBounds[i].lowerCorner != bound.lowerCorner ||
+				m_colliderSurfaceSetBounds[i].upperCorner != bound.upperCorner;
+		}
+
+		if (!isSameSet)
+		{
+			m_colliderSurfaceSet = surfaceSet;
+			m_colliderSurfaceSetMembers.resize(numberOfSurfaces);
+			for (size_t i = 0; i < numberOfSurfaces; ++i)
+			{
+				m_colliderSurfaceSetMembers[i] = surfaceSet->SurfaceAt(i);
+			}
+
+			m_implicitColliderSurfaceSet = std::make_shared<ImplicitSurfaceSet3>(
+				m_colliderSurfaceSetMembers, surfaceSet->transform, surfaceSet->isNormalFlipped);
+		}
+		else
+		{
+			m_implicitColliderSurfaceSet->transform = surfaceSet->transform;
+			m_implicitColliderSurfaceSet->isNormalFlipped = surfaceSet->isNormalFlipped;
+
+			// The members are shared, but the hierarchy is built from their bounds
+			if (isMoved)
+			{
+				m_implicitColliderSurfaceSet->UpdateQueryEngine();
+			}
+		}
+
+		if (!isSameSet || isMoved)
+		{
+			m_colliderSurfaceSetBounds.resize(numberOfSurfaces);
+			for (size_t i = 0; i < numberOfSurfaces; ++i)
+			{
+				m_colliderSurfaceSetBounds[i] = m_colliderSurfaceSetMembers[i]->BoundingBox();
+			}
+		}
+
+		return m_implicitColliderSurfaceSet;
+	}
+
+	void GridFractionalBoundaryConditionSolver3::BakeLocalColliderSDF(
+		const ImplicitSurface3& implicitSurface,
+		const Transform3& transform,
+		const Vector3D& gridSpacing)
+	{
+		BoundingBox3D localBounds = transform.ToLocal(implicitSurface.BoundingBox());
+		localBounds.Expand(LOCAL_COLLIDER_SDF_PADDING * gridSpacing.Max());
+
+		const Size3 resolution(
+			static_cast<size_t>(std::ceil(localBounds.Width() / gridSpacing.x)),
+			static_cast<size_t>(std::ceil(localBounds.Height() / gridSpacing.y)),
+			static_cast<size_t>(std::ceil(localBounds.Depth() / gridSpacing.z)));
+
+		m_localColliderSDF = std::make_shared<VertexCenteredScalarGrid3>(resolution, gridSpacing, localBounds.lowerCorner);
+		m_localColliderSDF->Fill([&](const Vector3D& localPt)
+		{
+			return implicitSurface.SignedDistance(transform.ToWorld(localPt));
+		});
+
+		// Everything outside of the padded bounding box lies on the same side of
+		// the surface as its corners.
+		m_localColliderSDFFarSign = ((*m_localColliderSDF)(0, 0, 0) < 0.0) ? -1.0 : 1.0;
+	}
+
+	void GridFractionalBoundaryConditionSolver3::ResampleLocalColliderSDF(const Transform3& transform)
+	{
+		const LinearArraySampler3<double, double> sampler(
+			m_localColliderSDF->GetConstDataAccessor(),
+			m_localColliderSDF->GridSpacing(),
+			m_localColliderSDF->GetDataOrigin());
+		const BoundingBox3D localBounds = m_localColliderSDF->BoundingBox();
+		const double farSign = m_localColliderSDFFarSign;
+
+		auto pos = m_colliderSDF->GetDataPosition();
+		auto sdf = m_colliderSDF->GetDataAccessor();
+		const Size3 size = sdf.size();
+
+		// Each row of grid points is transformed to the local frame at once
+		ParallelFor(ZERO_SIZE, size.y * size.z, [&](size_t row)
+		{
+			const size_t j = row % size.y;
+			const size_t k = row / size.y;
+
+			Array1<Vector3D> localPts(size.x);
+			for (size_t i = 0; i < size.x; ++i)
+			{
+				localPts[i] = pos(i, j, k);
+			}
+
+			ArrayAccessor1<Vector3D> localPtsAccessor = localPts.Accessor();
+			transform.ToLocal(localPts.ConstAccessor(), &localPtsAccessor);
+
+			for (size_t i = 0; i < size.x; ++i)
+			{
+				const Vector3D clampedPt = localBounds.Clamp(localPts[i]);
+
+				sdf(i, j, k) = sampler(clampedPt) + farSign * clampedPt.DistanceTo(localPts[i]);
+			}
+		});
+
+		m_localColliderSDFTransform = transform;
+	}
+}
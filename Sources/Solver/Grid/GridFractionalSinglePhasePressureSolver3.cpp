@@ -18,6 +18,8 @@
 #include <Solver/FDM/FDMICCGSolver3.h>
 #include <Solver/Grid/GridFractionalBoundaryConditionSolver3.h>
 #include <Solver/Grid/GridFractionalSinglePhasePressureSolver3.h>
+#include <Utils/Logger.h>
+#include <Utils/Timer.h>
 
 namespace CubbyFlow
 {
@@ -26,7 +28,7 @@ namespace CubbyFlow
 
 	GridFractionalSinglePhasePressureSolver3::GridFractionalSinglePhasePressureSolver3()
 	{
-		m_systemSolver = std::make_shared<FDMICCGSolver3>(100, DEFAULT_TOLERANCE);
+		m_systemSolver = std::make_shared<FDMICCGSolver3>(100, DEFAULT_TOLERANCE, 0.0, true);
 	}
 
 	GridFractionalSinglePhasePressureSolver3::~GridFractionalSinglePhasePressureSolver3()
@@ -42,9 +44,13 @@ namespace CubbyFlow
 		const VectorField3& boundaryVelocity,
 		const ScalarField3& fluidSDF)
 	{
+		Timer timer;
+
 		BuildWeights(input, boundarySDF, boundaryVelocity, fluidSDF);
 		BuildSystem(input);
 
+		CUBBYFLOW_INFO << "Building pressure system took " << timer.DurationInSeconds() << " seconds";
+
 		if (m_systemSolver != nullptr)
 		{
 			// Solve the system
@@ -83,6 +89,12 @@ namespace CubbyFlow
 		auto vPos = input.GetVPosition();
 		auto wPos = input.GetWPosition();
 
+		// Keeps the last weights and fluid SDF to find the rows to assemble again
+		m_uWeights.Swap(m_lastUWeights);
+		m_vWeights.Swap(m_lastVWeights);
+		m_wWeights.Swap(m_lastWWeights);
+		m_fluidSDF.Swap(m_lastFluidSDF);
+
 		m_uWeights.Resize(uSize);
 		m_vWeights.Resize(vSize);
 		m_wWeights.Resize(wSize);
@@ -166,6 +178,14 @@ namespace CubbyFlow
 		const auto vPos = input.GetVPosition();
 		const auto wPos = input.GetWPosition();
 
+		// A row depends on the weights of the cell faces and the fluid SDF of
+		// the cell and its neighbors only, unless the grid itself is changed
+		const bool isNewGrid =
+			m_system.A.size() != size ||
+			m_lastFluidSDF.size() != size ||
+			m_lastGridSpacing != input.GridSpacing();
+		m_lastGridSpacing = input.GridSpacing();
+
 		m_system.A.Resize(size);
 		m_system.x.Resize(size);
 		m_system.b.Resize(size);
@@ -173,13 +193,35 @@ namespace CubbyFlow
 		const Vector3D invH = 1.0 / input.GridSpacing();
 		const Vector3D invHSqr = invH * invH;
 
+		const auto isRowChanged = [&](size_t i, size_t j, size_t k)
+		{
+			return
+				m_uWeights(i, j, k) != m_lastUWeights(i, j, k) ||
+				m_uWeights(i + 1, j, k) != m_lastUWeights(i + 1, j, k) ||
+				m_vWeights(i, j, k) != m_lastVWeights(i, j, k) ||
+				m_vWeights(i, j + 1, k) != m_lastVWeights(i, j + 1, k) ||
+				m_wWeights(i, j, k) != m_lastWWeights(i, j, k) ||
+				m_wWeights(i, j, k + 1) != m_lastWWeights(i, j, k + 1) ||
+				m_fluidSDF(i, j, k) != m_lastFluidSDF(i, j, k) ||
+				(i > 0 && m_fluidSDF(i - 1, j, k) != m_lastFluidSDF(i - 1, j, k)) ||
+				(i + 1 < size.x && m_fluidSDF(i + 1, j, k) != m_lastFluidSDF(i + 1, j, k)) ||
+				(j > 0 && m_fluidSDF(i, j - 1, k) != m_lastFluidSDF(i, j - 1, k)) ||
+				(j + 1 < size.y && m_fluidSDF(i, j + 1, k) != m_lastFluidSDF(i, j + 1, k)) ||
+				(k > 0 && m_fluidSDF(i, j, k - 1) != m_lastFluidSDF(i, j, k - 1)) ||
+				(k + 1 < size.z && m_fluidSDF(i, j, k + 1) != m_lastFluidSDF(i, j, k + 1));
+		};
+
 		// Build linear system
 		m_system.A.ParallelForEachIndex([&](size_t i, size_t j, size_t k)
 		{
 			auto& row = m_system.A(i, j, k);
+			const bool buildRow = isNewGrid || isRowChanged(i, j, k);
 
 			// initialize
-			row.center = row.right = row.up = row.front = 0.0;
+			if (buildRow)
+			{
+				row.center = row.right = row.up = row.front = 0.0;
+			}
 			m_system.b(i, j, k) = 0.0;
 
 			double centerPhi = m_fluidSDF(i, j, k);
@@ -190,19 +232,22 @@ namespace CubbyFlow
 
 				if (i + 1 < size.x)
 				{
-					term = m_uWeights(i + 1, j, k) * invHSqr.x;
-					double rightPhi = m_fluidSDF(i + 1, j, k);
-					
-					if (IsInsideSDF(rightPhi))
-					{
-						row.center += term;
-						row.right -= term;
-					}
-					else
+					if (buildRow)
 					{
-						double theta = FractionInsideSDF(centerPhi, rightPhi);
-						theta = std::max(theta, 0.01);
-						row.center += term / theta;
+						term = m_uWeights(i + 1, j, k) * invHSqr.x;
+						double rightPhi = m_fluidSDF(i + 1, j, k);
+
+						if (IsInsideSDF(rightPhi))
+						{
+							row.center += term;
+							row.right -= term;
+						}
+						else
+						{
+							double theta = FractionInsideSDF(centerPhi, rightPhi);
+							theta = std::max(theta, 0.01);
+							row.center += term / theta;
+						}
 					}
 
 					m_system.b(i, j, k) += m_uWeights(i + 1, j, k) * input.GetU(i + 1, j, k) * invH.x;
@@ -214,18 +259,21 @@ namespace CubbyFlow
 
 				if (i > 0)
 				{
-					term = m_uWeights(i, j, k) * invHSqr.x;
-					double leftPhi = m_fluidSDF(i - 1, j, k);
-
-					if (IsInsideSDF(leftPhi))
+					if (buildRow)
 					{
-						row.center += term;
-					}
-					else
-					{
-						double theta = FractionInsideSDF(centerPhi, leftPhi);
-						theta = std::max(theta, 0.01);
-						row.center += term / theta;
+						term = m_uWeights(i, j, k) * invHSqr.x;
+						double leftPhi = m_fluidSDF(i - 1, j, k);
+
+						if (IsInsideSDF(leftPhi))
+						{
+							row.center += term;
+						}
+						else
+						{
+							double theta = FractionInsideSDF(centerPhi, leftPhi);
+							theta = std::max(theta, 0.01);
+							row.center += term / theta;
+						}
 					}
 
 					m_system.b(i, j, k) -= m_uWeights(i, j, k) * input.GetU(i, j, k) * invH.x;
@@ -237,19 +285,22 @@ namespace CubbyFlow
 
 				if (j + 1 < size.y)
 				{
-					term = m_vWeights(i, j + 1, k) * invHSqr.y;
-					double upPhi = m_fluidSDF(i, j + 1, k);
-
-					if (IsInsideSDF(upPhi))
-					{
-						row.center += term;
-						row.up -= term;
-					}
-					else
+					if (buildRow)
 					{
-						double theta = FractionInsideSDF(centerPhi, upPhi);
-						theta = std::max(theta, 0.01);
-						row.center += term / theta;
+						term = m_vWeights(i, j + 1, k) * invHSqr.y;
+						double upPhi = m_fluidSDF(i, j + 1, k);
+
+						if (IsInsideSDF(upPhi))
+						{
+							row.center += term;
+							row.up -= term;
+						}
+						else
+						{
+							double theta = FractionInsideSDF(centerPhi, upPhi);
+							theta = std::max(theta, 0.01);
+							row.center += term / theta;
+						}
 					}
 
 					m_system.b(i, j, k) += m_vWeights(i, j + 1, k) * input.GetV(i, j + 1, k) * invH.y;
@@ -261,18 +312,21 @@ namespace CubbyFlow
 
 				if (j > 0)
 				{
-					term = m_vWeights(i, j, k) * invHSqr.y;
-					double downPhi = m_fluidSDF(i, j - 1, k);
-
-					if (IsInsideSDF(downPhi))
+					if (buildRow)
 					{
-						row.center += term;
-					}
-					else
-					{
-						double theta = FractionInsideSDF(centerPhi, downPhi);
-						theta = std::max(theta, 0.01);
-						row.center += term / theta;
+						term = m_vWeights(i, j, k) * invHSqr.y;
+						double downPhi = m_fluidSDF(i, j - 1, k);
+
+						if (IsInsideSDF(downPhi))
+						{
+							row.center += term;
+						}
+						else
+						{
+							double theta = FractionInsideSDF(centerPhi, downPhi);
+							theta = std::max(theta, 0.01);
+							row.center += term / theta;
+						}
 					}
 
 					m_system.b(i, j, k) -= m_vWeights(i, j, k) * input.GetV(i, j, k) * invH.y;
@@ -284,21 +338,24 @@ namespace CubbyFlow
 
 				if (k + 1 < size.z)
 				{
-					term = m_wWeights(i, j, k + 1) * invHSqr.z;
-					double frontPhi = m_fluidSDF(i, j, k + 1);
-
-					if (IsInsideSDF(frontPhi))
+					if (buildRow)
 					{
-						row.center += term;
-						row.front -= term;
+						term = m_wWeights(i, j, k + 1) * invHSqr.z;
+						double frontPhi = m_fluidSDF(i, j, k + 1);
+
+						if (IsInsideSDF(frontPhi))
+						{
+							row.center += term;
+							row.front -= term;
+						}
+						else
+						{
+							double theta = FractionInsideSDF(centerPhi, frontPhi);
+							theta = std::max(theta, 0.01);
+							row.center += term / theta;
+						}
 					}
-					else
-					{
-						double theta = FractionInsideSDF(centerPhi, frontPhi);
-						theta = std::max(theta, 0.01);
-						row.center += term / theta;
-					}
-					
+
 					m_system.b(i, j, k) += m_wWeights(i, j, k + 1) * input.GetW(i, j, k + 1) * invH.z;
 				}
 				else
@@ -308,18 +365,21 @@ namespace CubbyFlow
 
 				if (k > 0)
 				{
-					term = m_wWeights(i, j, k) * invHSqr.z;
-					double backPhi = m_fluidSDF(i, j, k - 1);
-
-					if (IsInsideSDF(backPhi))
-					{
-						row.center += term;
-					}
-					else
+					if (buildRow)
 					{
-						double theta = FractionInsideSDF(centerPhi, backPhi);
-						theta = std::max(theta, 0.01);
-						row.center += term / theta;
+						term = m_wWeights(i, j, k) * invHSqr.z;
+						double backPhi = m_fluidSDF(i, j, k - 1);
+
+						if (IsInsideSDF(backPhi))
+						{
+							row.center += term;
+						}
+						else
+						{
+							double theta = FractionInsideSDF(centerPhi, backPhi);
+							theta = std::max(theta, 0.01);
+							row.center += term / theta;
+						}
 					}
 
 					m_system.b(i, j, k) -= m_wWeights(i, j, k) * input.GetW(i, j, k) * invH.z;
@@ -344,6 +404,51 @@ namespace CubbyFlow
 				row.center = 1.0;
 			}
 		});
+
+		// Starts from the pressure of the last solve, which is zero outside the
+		// fluid. A cell that became fluid takes the average pressure of its
+		// neighbors that stayed fluid, which this pass never writes.
+		if (isNewGrid)
+		{
+			m_system.x.Set(0.0);
+			return;
+		}
+
+		const auto isStayedFluid = [&](size_t i, size_t j, size_t k)
+		{
+			return IsInsideSDF(m_fluidSDF(i, j, k)) && IsInsideSDF(m_lastFluidSDF(i, j, k));
+		};
+
+		m_system.x.ParallelForEachIndex([&](size_t i, size_t j, size_t k)
+		{
+			if (!IsInsideSDF(m_fluidSDF(i, j, k)))
+			{
+				m_system.x(i, j, k) = 0.0;
+			}
+			else if (!IsInsideSDF(m_lastFluidSDF(i, j, k)))
+			{
+				double sum = 0.0;
+				int count = 0;
+
+				const auto accumulate = [&](bool isValid, size_t ni, size_t nj, size_t nk)
+				{
+					if (isValid && isStayedFluid(ni, nj, nk))
+					{
+						sum += m_system.x(ni, nj, nk);
+						++count;
+					}
+				};
+
+				accumulate(i > 0, i - 1, j, k);
+				accumulate(i + 1 < size.x, i + 1, j, k);
+				accumulate(j > 0, i, j - 1, k);
+				accumulate(j + 1 < size.y, i, j + 1, k);
+				accumulate(k > 0, i, j, k - 1);
+				accumulate(k + 1 < size.z, i, j, k + 1);
+
+				m_system.x(i, j, k) = (count > 0) ? sum / count : 0.0;
+			}
+		});
 	}
 
 	void GridFractionalSinglePhasePressureSolver3::ApplyPressureGradient(const FaceCenteredGrid3& input, FaceCenteredGrid3* output)
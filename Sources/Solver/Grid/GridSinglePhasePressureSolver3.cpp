@@ -10,6 +10,8 @@
 #include <Solver/FDM/FDMICCGSolver3.h>
 #include <Solver/Grid/GridBlockedBoundaryConditionSolver3.h>
 #include <Solver/Grid/GridSinglePhasePressureSolver3.h>
+#include <Utils/Logger.h>
+#include <Utils/Timer.h>
 
 namespace CubbyFlow
 {
@@ -21,7 +23,7 @@ namespace CubbyFlow
 
 	GridSinglePhasePressureSolver3::GridSinglePhasePressureSolver3()
 	{
-		m_systemSolver = std::make_shared<FDMICCGSolver3>(100, DEFAULT_TOLERANCE);
+		m_systemSolver = std::make_shared<FDMICCGSolver3>(100, DEFAULT_TOLERANCE, 0.0, true);
 	}
 
 	GridSinglePhasePressureSolver3::~GridSinglePhasePressureSolver3()
@@ -37,11 +39,14 @@ namespace CubbyFlow
 		const VectorField3& boundaryVelocity,
 		const ScalarField3& fluidSDF)
 	{
+		Timer timer;
 		auto pos = input.CellCenterPosition();
 
 		BuildMarkers(input.Resolution(), pos, boundarySDF, fluidSDF);
 		BuildSystem(input);
 
+		CUBBYFLOW_INFO << "Building pressure system took " << timer.DurationInSeconds() << " seconds";
+
 		if (m_systemSolver != nullptr)
 		{
 			// Solve the system
@@ -73,6 +78,9 @@ namespace CubbyFlow
 		const ScalarField3& boundarySDF,
 		const ScalarField3& fluidSDF)
 	{
+		// Keeps the last markers to find the rows to assemble again
+		m_markers.Swap(m_lastMarkers);
+
 		m_markers.Resize(size);
 		m_markers.ParallelForEachIndex([&](size_t i, size_t j, size_t k)
 		{
@@ -95,6 +103,15 @@ namespace CubbyFlow
 	void GridSinglePhasePressureSolver3::BuildSystem(const FaceCenteredGrid3& input)
 	{
 		Size3 size = input.Resolution();
+
+		// A row depends on the markers of the cell and its neighbors only,
+		// unless the grid itself is changed
+		const bool isNewGrid =
+			m_system.A.size() != size ||
+			m_lastMarkers.size() != size ||
+			m_lastGridSpacing != input.GridSpacing();
+		m_lastGridSpacing = input.GridSpacing();
+
 		m_system.A.Resize(size);
 		m_system.x.Resize(size);
 		m_system.b.Resize(size);
@@ -102,19 +119,35 @@ namespace CubbyFlow
 		Vector3D invH = 1.0 / input.GridSpacing();
 		Vector3D invHSqr = invH * invH;
 
+		const auto isMarkerChanged = [&](size_t i, size_t j, size_t k)
+		{
+			return
+				m_markers(i, j, k) != m_lastMarkers(i, j, k) ||
+				(i > 0 && m_markers(i - 1, j, k) != m_lastMarkers(i - 1, j, k)) ||
+				(i + 1 < size.x && m_markers(i + 1, j, k) != m_lastMarkers(i + 1, j, k)) ||
+				(j > 0 && m_markers(i, j - 1, k) != m_lastMarkers(i, j - 1, k)) ||
+				(j + 1 < size.y && m_markers(i, j + 1, k) != m_lastMarkers(i, j + 1, k)) ||
+				(k > 0 && m_markers(i, j, k - 1) != m_lastMarkers(i, j, k - 1)) ||
+				(k + 1 < size.z && m_markers(i, j, k + 1) != m_lastMarkers(i, j, k + 1));
+		};
+
 		// Build linear system
 		m_system.A.ParallelForEachIndex([&](size_t i, size_t j, size_t k)
 		{
+			m_system.b(i, j, k) = (m_markers(i, j, k) == FLUID) ? input.DivergenceAtCellCenter(i, j, k) : 0.0;
+
+			if (!isNewGrid && !isMarkerChanged(i, j, k))
+			{
+				return;
+			}
+
 			auto& row = m_system.A(i, j, k);
 
 			// initialize
 			row.center = row.right = row.up = row.front = 0.0;
-			m_system.b(i, j, k) = 0.0;
 
 			if (m_markers(i, j, k) == FLUID)
 			{
-				m_system.b(i, j, k) = input.DivergenceAtCellCenter(i, j, k);
-
 				if (i + 1 < size.x && m_markers(i + 1, j, k) != BOUNDARY)
 				{
 					row.center += invHSqr.x;
@@ -162,6 +195,51 @@ namespace CubbyFlow
 				row.center = 1.0;
 			}
 		});
+
+		// Starts from the pressure of the last solve, which is zero outside the
+		// fluid. A cell that became fluid takes the average pressure of its
+		// neighbors that stayed fluid, which this pass never writes.
+		if (isNewGrid)
+		{
+			m_system.x.Set(0.0);
+			return;
+		}
+
+		const auto isStayedFluid = [&](size_t i, size_t j, size_t k)
+		{
+			return m_markers(i, j, k) == FLUID && m_lastMarkers(i, j, k) == FLUID;
+		};
+
+		m_system.x.ParallelForEachIndex([&](size_t i, size_t j, size_t k)
+		{
+			if (m_markers(i, j, k) != FLUID)
+			{
+				m_system.x(i, j, k) = 0.0;
+			}
+			else if (m_lastMarkers(i, j, k) != FLUID)
+			{
+				double sum = 0.0;
+				int count = 0;
+
+				const auto accumulate = [&](bool isValid, size_t ni, size_t nj, size_t nk)
+				{
+					if (isValid && isStayedFluid(ni, nj, nk))
+					{
+						sum += m_system.x(ni, nj, nk);
+						++count;
+					}
+				};
+
+				accumulate(i > 0, i - 1, j, k);
+				accumulate(i + 1 < size.x, i + 1, j, k);
+				accumulate(j > 0, i, j - 1, k);
+				accumulate(j + 1 < size.y, i, j + 1, k);
+				accumulate(k > 0, i, j, k - 1);
+				accumulate(k + 1 < size.z, i, j, k + 1);
+
+				m_system.x(i, j, k) = (count > 0) ? sum / count : 0.0;
+			}
+		});
 	}
 
 	void GridSinglePhasePressureSolver3::ApplyPressureGradient(const FaceCenteredGrid3& input, FaceCenteredGrid3* output)
@@ -0,0 +1,331 @@
+/*************************************************************************
+> File Name: IISPHSolver3.cpp
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: 3-D implicit incompressible SPH solver.
+> Created Time: 2017/10/23
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#include <Solver/IISPH/IISPHSolver3.h>
+#include <SPH/SPHStdKernel3.h>
+#include <Utils/Logger.h>
+#include <Utils/Parallel.h>
+
+namespace CubbyFlow
+{
+	static const double TIME_STEP_LIMIT_BY_FORCE_FACTOR = 0.25;
+
+	IISPHSolver3::IISPHSolver3()
+	{
+		// Do nothing
+	}
+
+	IISPHSolver3::IISPHSolver3(double targetDensity, double targetSpacing, double relativeKernelRadius) :
+		SPHSolver3(targetDensity, targetSpacing, relativeKernelRadius)
+	{
+		// Do nothing
+	}
+
+	IISPHSolver3::~IISPHSolver3()
+	{
+		// Do nothing
+	}
+
+	double IISPHSolver3::GetMaxDensityErrorRatio() const
+	{
+		return m_maxDensityErrorRatio;
+	}
+
+	void IISPHSolver3::SetMaxDensityErrorRatio(double ratio)
+	{
+		m_maxDensityErrorRatio = std::max(ratio, 0.0);
+	}
+
+	unsigned int IISPHSolver3::GetMinNumberOfIterations() const
+	{
+		return m_minNumberOfIterations;
+	}
+
+	void IISPHSolver3::SetMinNumberOfIterations(unsigned int n)
+	{
+		m_minNumberOfIterations = n;
+	}
+
+	unsigned int IISPHSolver3::GetMaxNumberOfIterations() const
+	{
+		return m_maxNumberOfIterations;
+	}
+
+	void IISPHSolver3::SetMaxNumberOfIterations(unsigned int n)
+	{
+		m_maxNumberOfIterations = n;
+	}
+
+	double IISPHSolver3::GetRelaxationFactor() const
+	{
+		return m_relaxationFactor;
+	}
+
+	void IISPHSolver3::SetRelaxationFactor(double factor)
+	{
+		m_relaxationFactor = Clamp(factor, std::numeric_limits<double>::epsilon(), 1.0);
+	}
+
+	double IISPHSolver3::GetMaxCFL() const
+	{
+		return m_maxCFL;
+	}
+
+	void IISPHSolver3::SetMaxCFL(double newCFL)
+	{
+		m_maxCFL = std::max(newCFL, std::numeric_limits<double>::epsilon());
+	}
+
+	unsigned int IISPHSolver3::GetLastNumberOfIterations() const
+	{
+		return m_lastNumberOfIterations;
+	}
+
+	double IISPHSolver3::GetLastDensityErrorRatio() const
+	{
+		return m_lastDensityErrorRatio;
+	}
+
+	unsigned int IISPHSolver3::NumberOfSubTimeSteps(double timeIntervalInSeconds) const
+	{
+		auto particles = GetSPHSystemData();
+		size_t numberOfParticles = particles->NumberOfParticles();
+		auto v = particles->GetVelocities();
+		auto f = particles->GetForces();
+
+		const double kernelRadius = particles->GetKernelRadius();
+		const double mass = particles->GetMass();
+
+		const auto maxLength = [](const ConstArrayAccessor1<Vector3D>& data)
+		{
+			return [&data](size_t start, size_t end, double init)
+			{
+				double result = init;
+
+				for (size_t i = start; i < end; ++i)
+				{
+					result = std::max(result, data[i].LengthSquared());
+				}
+
+				return result;
+			};
+		};
+		const auto maxReduce = [](double a, double b) { return std::max(a, b); };
+
+		const ConstArrayAccessor1<Vector3D> velocities(v);
+		const ConstArrayAccessor1<Vector3D> forces(f);
+		const double maxSpeed = std::sqrt(ParallelReduce(ZERO_SIZE, numberOfParticles, 0.0, maxLength(velocities), maxReduce));
+		// Forces are cleared at the beginning of each sub-step, so gravity is
+		// taken into account explicitly.
+		const double maxForceMagnitude = std::max(
+			std::sqrt(ParallelReduce(ZERO_SIZE, numberOfParticles, 0.0, maxLength(forces), maxReduce)),
+			mass * GetGravity().Length());
+
+		double desiredTimeStep = std::numeric_limits<double>::max();
+
+		if (maxSpeed > 0.0)
+		{
+			desiredTimeStep = std::min(desiredTimeStep, m_maxCFL * particles->GetTargetSpacing() / maxSpeed);
+		}
+
+		if (maxForceMagnitude > 0.0)
+		{
+			desiredTimeStep = std::min(desiredTimeStep, TIME_STEP_LIMIT_BY_FORCE_FACTOR * std::sqrt(kernelRadius * mass / maxForceMagnitude));
+		}
+
+		desiredTimeStep *= GetTimeStepLimitScale();
+
+		return std::max(1u, static_cast<unsigned int>(std::ceil(timeIntervalInSeconds / desiredTimeStep)));
+	}
+
+	void IISPHSolver3::AccumulatePressureForce(double timeIntervalInSeconds)
+	{
+		auto particles = GetSPHSystemData();
+		const size_t numberOfParticles = particles->NumberOfParticles();
+		const double targetDensity = particles->GetTargetDensity();
+		const double mass = particles->GetMass();
+		const double dt2 = timeIntervalInSeconds * timeIntervalInSeconds;
+		const double omega = m_relaxationFactor;
+		const double negativePressureScale = GetNegativePressureScale();
+		const auto& neighborLists = particles->NeighborLists();
+
+		auto p = particles->GetPressures();
+		auto d = particles->GetDensities();
+		auto x = particles->GetPositions();
+		auto v = particles->GetVelocities();
+		auto f = particles->GetForces();
+
+		const SPHSpikyKernel3 kernel(particles->GetKernelRadius());
+		const SPHStdKernel3 densityKernel(particles->GetKernelRadius());
+
+		// Returns grad(W_ij) with respect to x_i.
+		const auto gradient = [&](size_t i, size_t j)
+		{
+			const double dist = x[i].DistanceTo(x[j]);
+			return (dist > 0.0) ? kernel.Gradient(dist, (x[j] - x[i]) / dist) : Vector3D();
+		};
+
+		// Predict advection velocity and compute d_ii. The pressure from the
+		// previous time-step is used as the initial guess.
+		ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i)
+		{
+			m_advectedVelocities[i] = v[i] + timeIntervalInSeconds / mass * f[i];
+
+			Vector3D dii;
+			for (size_t j : neighborLists[i])
+			{
+				dii -= mass / Square(d[i]) * gradient(i, j);
+			}
+			m_dii[i] = dt2 * dii;
+
+			p[i] *= 0.5;
+		});
+
+		// Compute diagonal element a_ii
+		ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i)
+		{
+			double aii = 0.0;
+
+			for (size_t j : neighborLists[i])
+			{
+				const Vector3D gradWij = gradient(i, j);
+				const Vector3D dji = dt2 * mass / Square(d[i]) * gradWij;
+
+				aii += mass * (m_dii[i] - dji).Dot(gradWij);
+			}
+
+			m_aii[i] = aii;
+		});
+
+		// Relaxed Jacobi iteration. The linearized density prediction of the
+		// original method underestimates the compression measured by
+		// UpdateDensities, since it ignores the collider and the nonlinearity
+		// of the kernel. Instead, the residual is the density at the positions
+		// predicted with the current pressure, as in PCISPHSolver3, while a_ii
+		// still scales the pressure update.
+		unsigned int numberOfIterations = 0;
+		double densityErrorRatio = 0.0;
+
+		for (unsigned int k = 0; k < m_maxNumberOfIterations; ++k)
+		{
+			ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i)
+			{
+				Vector3D sumDijPj;
+				for (size_t j : neighborLists[i])
+				{
+					sumDijPj -= mass / Square(d[j]) * p[j] * gradient(i, j);
+				}
+				m_sumDijPj[i] = dt2 * sumDijPj;
+
+				// Predict velocity and position with the current pressure
+				m_predictedVelocities[i] = m_advectedVelocities[i] + (m_dii[i] * p[i] + m_sumDijPj[i]) / timeIntervalInSeconds;
+				m_predictedPositions[i] = x[i] + timeIntervalInSeconds * m_predictedVelocities[i];
+			});
+
+			ResolveCollision(m_predictedPositions, m_predictedVelocities);
+
+			// Update pressure and sum up the predicted compression in one pass
+			const double densityErrorSum = ParallelReduce(ZERO_SIZE, numberOfParticles, 0.0,
+				[&](size_t start, size_t end, double init)
+			{
+				double result = init;
+
+				for (size_t i = start; i < end; ++i)
+				{
+					double weightSum = densityKernel(0.0);
+					for (size_t j : neighborLists[i])
+					{
+						weightSum += densityKernel(m_predictedPositions[i].DistanceTo(m_predictedPositions[j]));
+					}
+
+					const double predictedDensity = mass * weightSum;
+					double newPressure = 0.0;
+
+					if (std::fabs(m_aii[i]) > std::numeric_limits<double>::epsilon())
+					{
+						newPressure = p[i] + omega / m_aii[i] * (targetDensity - predictedDensity);
+					}
+
+					if (newPressure < 0.0)
+					{
+						newPressure *= negativePressureScale;
+					}
+
+					m_newPressures[i] = newPressure;
+					result += std::max(predictedDensity - targetDensity, 0.0);
+				}
+
+				return result;
+			}, std::plus<double>());
+
+			ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i)
+			{
+				p[i] = m_newPressures[i];
+			});
+
+			numberOfIterations = k + 1;
+			densityErrorRatio = (numberOfParticles > 0) ? densityErrorSum / (numberOfParticles * targetDensity) : 0.0;
+
+			if (numberOfIterations >= m_minNumberOfIterations && densityErrorRatio < m_maxDensityErrorRatio)
+			{
+				break;
+			}
+		}
+
+		m_lastNumberOfIterations = numberOfIterations;
+		m_lastDensityErrorRatio = densityErrorRatio;
+
+		CUBBYFLOW_INFO << "Number of IISPH iterations: " << numberOfIterations;
+		CUBBYFLOW_INFO << "Average density error ratio after IISPH iteration: " << densityErrorRatio;
+
+		if (densityErrorRatio > m_maxDensityErrorRatio)
+		{
+			CUBBYFLOW_WARN << "Average density error ratio is greater than the threshold!";
+			CUBBYFLOW_WARN << "Ratio: " << densityErrorRatio
+				<< " Threshold: " << m_maxDensityErrorRatio;
+		}
+
+		// Accumulate pressure force
+		SPHSolver3::AccumulatePressureForce(x, d, p, f);
+	}
+
+	void IISPHSolver3::OnBeginAdvanceTimeStep(double timeStepInSeconds)
+	{
+		SPHSolver3::OnBeginAdvanceTimeStep(timeStepInSeconds);
+
+		// Allocate temp buffers
+		size_t numberOfParticles = GetParticleSystemData()->NumberOfParticles();
+		m_advectedVelocities.Resize(numberOfParticles);
+		m_dii.Resize(numberOfParticles);
+		m_sumDijPj.Resize(numberOfParticles);
+		m_predictedVelocities.Resize(numberOfParticles);
+		m_predictedPositions.Resize(numberOfParticles);
+		m_aii.Resize(numberOfParticles);
+		m_newPressures.Resize(numberOfParticles);
+	}
+
+	IISPHSolver3::Builder IISPHSolver3::GetBuilder()
+	{
+		return Builder();
+	}
+
+	IISPHSolver3 IISPHSolver3::Builder::Build() const
+	{
+		return IISPHSolver3(m_targetDensity, m_targetSpacing, m_relativeKernelRadius);
+	}
+
+	IISPHSolver3Ptr IISPHSolver3::Builder::MakeShared() const
+	{
+		return std::shared_ptr<IISPHSolver3>(
+			new IISPHSolver3(m_targetDensity, m_targetSpacing, m_relativeKernelRadius),
+			[](IISPHSolver3* obj)
+		{
+			delete obj;
+		});
+	}
+}
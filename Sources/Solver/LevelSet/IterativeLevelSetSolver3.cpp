@@ -9,10 +9,84 @@
 #include <Array/ArrayUtils.h>
 #include <FDM/FDMUtils.h>
 #include <Solver/LevelSet/IterativeLevelSetSolver3.h>
+#include <LevelSet/LevelSetUtils.h>
 #include <Utils/Logger.h>
+#include <Utils/Parallel.h>
+
+#include <vector>
 
 namespace CubbyFlow
 {
+	// Width of the cubic tiles tracked during reinitialization. The stencils
+	// of the derivatives must not reach beyond the neighboring tiles.
+	static const size_t TILE_SIZE = 8;
+
+	// Marks the tiles containing a sign change of the SDF
+	static void MarkInterfaceTiles(
+		const ConstArrayAccessor3<double>& sdf,
+		const Size3& numberOfTiles,
+		std::vector<char>* isInterface)
+	{
+		const Size3 size = sdf.size();
+
+		const auto mark = [&](size_t i, size_t j, size_t k)
+		{
+			(*isInterface)[i / TILE_SIZE + numberOfTiles.x * (j / TILE_SIZE + numberOfTiles.y * (k / TILE_SIZE))] = 1;
+		};
+
+		sdf.ForEachIndex([&](size_t i, size_t j, size_t k)
+		{
+			const bool isInside = IsInsideSDF(sdf(i, j, k));
+
+			if (i + 1 < size.x && IsInsideSDF(sdf(i + 1, j, k)) != isInside)
+			{
+				mark(i, j, k);
+				mark(i + 1, j, k);
+			}
+			if (j + 1 < size.y && IsInsideSDF(sdf(i, j + 1, k)) != isInside)
+			{
+				mark(i, j, k);
+				mark(i, j + 1, k);
+			}
+			if (k + 1 < size.z && IsInsideSDF(sdf(i, j, k + 1)) != isInside)
+			{
+				mark(i, j, k);
+				mark(i, j, k + 1);
+			}
+		});
+	}
+
+	// Grows the marked tiles by given number of tiles along each axis
+	static void DilateTiles(const Size3& numberOfTiles, size_t radius, std::vector<char>* tiles)
+	{
+		const size_t strides[3] = { 1, numberOfTiles.x, numberOfTiles.x * numberOfTiles.y };
+		const size_t counts[3] = { numberOfTiles.x, numberOfTiles.y, numberOfTiles.z };
+
+		std::vector<char> source;
+
+		for (size_t axis = 0; axis < 3; ++axis)
+		{
+			source = *tiles;
+
+			for (size_t t = 0; t < tiles->size(); ++t)
+			{
+				if (!source[t])
+				{
+					continue;
+				}
+
+				const size_t c = (t / strides[axis]) % counts[axis];
+				const size_t begin = (c > radius) ? c - radius : 0;
+				const size_t end = std::min(c + radius + 1, counts[axis]);
+
+				for (size_t n = begin; n < end; ++n)
+				{
+					(*tiles)[t + n * strides[axis] - c * strides[axis]] = 1;
+				}
+			}
+		}
+	}
+
 	IterativeLevelSetSolver3::IterativeLevelSetSolver3()
 	{
 		// Do nothing
@@ -43,41 +117,147 @@ namespace CubbyFlow
 
 		CopyRange3(inputSDF.GetConstDataAccessor(), size.x, size.y, size.z, &outputAcc);
 
-		Array3<double> temp(size);
-		ArrayAccessor3<double> tempAcc = temp.Accessor();
+		// Both buffers start from the input so that the skipped tiles hold
+		// the same values in each
+		m_temp.Resize(size);
+		ArrayAccessor3<double> tempAcc = m_temp.Accessor();
+		CopyRange3(inputSDF.GetConstDataAccessor(), size.x, size.y, size.z, &tempAcc);
 
 		CUBBYFLOW_INFO << "Reinitializing with pseudoTimeStep: " << dtau
 			<< " numberOfIterations: " << numberOfIterations;
 
+		const Size3 numberOfTiles(
+			(size.x + TILE_SIZE - 1) / TILE_SIZE,
+			(size.y + TILE_SIZE - 1) / TILE_SIZE,
+			(size.z + TILE_SIZE - 1) / TILE_SIZE);
+		const size_t tileIndexSize = numberOfTiles.x * numberOfTiles.y * numberOfTiles.z;
+
+		const auto tileIndex = [&](size_t ti, size_t tj, size_t tk)
+		{
+			return ti + numberOfTiles.x * (tj + numberOfTiles.y * tk);
+		};
+
+		// Tiles within the max distance from the interface
+		std::vector<char> isNearInterface(tileIndexSize, 0);
+		MarkInterfaceTiles(inputSDF.GetConstDataAccessor(), numberOfTiles, &isNearInterface);
+
+		const double minSpacing = std::min({ gridSpacing.x, gridSpacing.y, gridSpacing.z });
+		const size_t tileRadius = static_cast<size_t>(std::ceil(maxDistance / (TILE_SIZE * minSpacing)));
+		DilateTiles(numberOfTiles, tileRadius, &isNearInterface);
+
+		std::vector<char> isChanging(isNearInterface);
+		std::vector<char> wasUpdated(tileIndexSize, 0);
+		std::vector<char> isUpdated(tileIndexSize, 0);
+		std::vector<size_t> tiles;
+
+		const double maxDelta = m_convergenceTolerance * dtau;
+
 		for (unsigned int n = 0; n < numberOfIterations; ++n)
 		{
-			inputSDF.ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+			// A tile is updated if it or any of its neighbors changed in the
+			// last iteration. The tiles updated in the last iteration but not
+			// in this one are copied instead, to bring both buffers in sync.
+			tiles.clear();
+
+			for (size_t tk = 0; tk < numberOfTiles.z; ++tk)
+			{
+				for (size_t tj = 0; tj < numberOfTiles.y; ++tj)
+				{
+					for (size_t ti = 0; ti < numberOfTiles.x; ++ti)
+					{
+						const size_t t = tileIndex(ti, tj, tk);
+
+						isUpdated[t] = isNearInterface[t] && (isChanging[t] ||
+							(ti > 0 && isChanging[t - 1]) ||
+							(ti + 1 < numberOfTiles.x && isChanging[t + 1]) ||
+							(tj > 0 && isChanging[t - numberOfTiles.x]) ||
+							(tj + 1 < numberOfTiles.y && isChanging[t + numberOfTiles.x]) ||
+							(tk > 0 && isChanging[t - numberOfTiles.x * numberOfTiles.y]) ||
+							(tk + 1 < numberOfTiles.z && isChanging[t + numberOfTiles.x * numberOfTiles.y]));
+
+						if (isUpdated[t] || wasUpdated[t])
+						{
+							tiles.push_back(t);
+						}
+					}
+				}
+			}
+
+			if (tiles.empty())
+			{
+				break;
+			}
+
+			ParallelFor(ZERO_SIZE, tiles.size(), [&](size_t tileNumber)
 			{
-				double s = Sign(outputAcc, gridSpacing, i, j, k);
-
-				std::array<double, 2> dx, dy, dz;
-
-				GetDerivatives(outputAcc, gridSpacing, i, j, k, &dx, &dy, &dz);
-
-				// Explicit Euler step
-				double val = outputAcc(i, j, k) -
-					dtau * std::max(s, 0.0) *
-					(std::sqrt(Square(std::max(dx[0], 0.0)) +
-						Square(std::min(dx[1], 0.0)) +
-						Square(std::max(dy[0], 0.0)) +
-						Square(std::min(dy[1], 0.0)) +
-						Square(std::max(dz[0], 0.0)) +
-						Square(std::min(dz[1], 0.0))) - 1.0) -
-					dtau * std::min(s, 0.0) *
-					(std::sqrt(Square(std::min(dx[0], 0.0)) +
-						Square(std::max(dx[1], 0.0)) +
-						Square(std::min(dy[0], 0.0)) +
-						Square(std::max(dy[1], 0.0)) +
-						Square(std::min(dz[0], 0.0)) +
-						Square(std::max(dz[1], 0.0))) - 1.0);
-				tempAcc(i, j, k) = val;
+				const size_t t = tiles[tileNumber];
+				const size_t ti = t % numberOfTiles.x;
+				const size_t tj = (t / numberOfTiles.x) % numberOfTiles.y;
+				const size_t tk = t / (numberOfTiles.x * numberOfTiles.y);
+
+				const size_t iBegin = ti * TILE_SIZE;
+				const size_t iEnd = std::min(iBegin + TILE_SIZE, size.x);
+				const size_t jEnd = std::min((tj + 1) * TILE_SIZE, size.y);
+				const size_t kEnd = std::min((tk + 1) * TILE_SIZE, size.z);
+
+				if (!isUpdated[t])
+				{
+					for (size_t k = tk * TILE_SIZE; k < kEnd; ++k)
+					{
+						for (size_t j = tj * TILE_SIZE; j < jEnd; ++j)
+						{
+							for (size_t i = iBegin; i < iEnd; ++i)
+							{
+								tempAcc(i, j, k) = outputAcc(i, j, k);
+							}
+						}
+					}
+
+					isChanging[t] = 0;
+					return;
+				}
+
+				std::array<double, 2> dx[TILE_SIZE], dy[TILE_SIZE], dz[TILE_SIZE];
+				double tileDelta = 0.0;
+
+				for (size_t k = tk * TILE_SIZE; k < kEnd; ++k)
+				{
+					for (size_t j = tj * TILE_SIZE; j < jEnd; ++j)
+					{
+						GetDerivativesOfRow(outputAcc, gridSpacing, iBegin, iEnd, j, k, dx, dy, dz);
+
+						for (size_t i = iBegin; i < iEnd; ++i)
+						{
+							const size_t d = i - iBegin;
+							double s = Sign(outputAcc, gridSpacing, i, j, k);
+
+							// Explicit Euler step
+							double val = outputAcc(i, j, k) -
+								dtau * std::max(s, 0.0) *
+								(std::sqrt(Square(std::max(dx[d][0], 0.0)) +
+									Square(std::min(dx[d][1], 0.0)) +
+									Square(std::max(dy[d][0], 0.0)) +
+									Square(std::min(dy[d][1], 0.0)) +
+									Square(std::max(dz[d][0], 0.0)) +
+									Square(std::min(dz[d][1], 0.0))) - 1.0) -
+								dtau * std::min(s, 0.0) *
+								(std::sqrt(Square(std::min(dx[d][0], 0.0)) +
+									Square(std::max(dx[d][1], 0.0)) +
+									Square(std::min(dy[d][0], 0.0)) +
+									Square(std::max(dy[d][1], 0.0)) +
+									Square(std::min(dz[d][0], 0.0)) +
+									Square(std::max(dz[d][1], 0.0))) - 1.0);
+
+							tileDelta = std::max(tileDelta, std::fabs(val - outputAcc(i, j, k)));
+							tempAcc(i, j, k) = val;
+						}
+					}
+				}
+
+				isChanging[t] = (tileDelta > maxDelta) ? 1 : 0;
 			});
 
+			std::swap(wasUpdated, isUpdated);
 			std::swap(tempAcc, outputAcc);
 		}
 
@@ -217,32 +397,45 @@ namespace CubbyFlow
 
 		CopyRange3(input, size.x, size.y, size.z, &outputAcc);
 
-		Array3<double> temp(size);
-		ArrayAccessor3<double> tempAcc = temp.Accessor();
+		m_temp.Resize(size);
+		ArrayAccessor3<double> tempAcc = m_temp.Accessor();
 
 		for (unsigned int n = 0; n < numberOfIterations; ++n)
 		{
-			ParallelFor(ZERO_SIZE, size.x, ZERO_SIZE, size.y, ZERO_SIZE, size.z,
-				[&](size_t i, size_t j, size_t k)
+			ParallelFor(ZERO_SIZE, size.y * size.z, [&](size_t row)
 			{
-				if (sdf(i, j, k) >= 0)
-				{
-					std::array<double, 2> dx, dy, dz;
-					Vector3D grad = Gradient3(sdf, gridSpacing, i, j, k);
-
-					GetDerivatives(outputAcc, gridSpacing, i, j, k, &dx, &dy, &dz);
-
-					tempAcc(i, j, k) = outputAcc(i, j, k) - 
-						dtau * (std::max(grad.x, 0.0) * dx[0] +
-							std::min(grad.x, 0.0) * dx[1] +
-							std::max(grad.y, 0.0) * dy[0] +
-							std::min(grad.y, 0.0) * dy[1] +
-							std::max(grad.z, 0.0) * dz[0] +
-							std::min(grad.z, 0.0) * dz[1]);
-				}
-				else
+				const size_t j = row % size.y;
+				const size_t k = row / size.y;
+
+				std::array<double, 2> dx[TILE_SIZE], dy[TILE_SIZE], dz[TILE_SIZE];
+
+				for (size_t iBegin = 0; iBegin < size.x; iBegin += TILE_SIZE)
 				{
-					tempAcc(i, j, k) = outputAcc(i, j, k);
+					const size_t iEnd = std::min(iBegin + TILE_SIZE, size.x);
+
+					GetDerivativesOfRow(outputAcc, gridSpacing, iBegin, iEnd, j, k, dx, dy, dz);
+
+					for (size_t i = iBegin; i < iEnd; ++i)
+					{
+						const size_t d = i - iBegin;
+
+						if (sdf(i, j, k) >= 0)
+						{
+							Vector3D grad = Gradient3(sdf, gridSpacing, i, j, k);
+
+							tempAcc(i, j, k) = outputAcc(i, j, k) -
+								dtau * (std::max(grad.x, 0.0) * dx[d][0] +
+									std::min(grad.x, 0.0) * dx[d][1] +
+									std::max(grad.y, 0.0) * dy[d][0] +
+									std::min(grad.y, 0.0) * dy[d][1] +
+									std::max(grad.z, 0.0) * dz[d][0] +
+									std::min(grad.z, 0.0) * dz[d][1]);
+						}
+						else
+						{
+							tempAcc(i, j, k) = outputAcc(i, j, k);
+						}
+					}
 				}
 			});
 
@@ -262,6 +455,28 @@ namespace CubbyFlow
 		m_maxCFL = std::max(newMaxCFL, 0.0);
 	}
 
+	double IterativeLevelSetSolver3::GetConvergenceTolerance() const
+	{
+		return m_convergenceTolerance;
+	}
+
+	void IterativeLevelSetSolver3::SetConvergenceTolerance(double newTolerance)
+	{
+		m_convergenceTolerance = std::max(newTolerance, 0.0);
+	}
+
+	void IterativeLevelSetSolver3::GetDerivativesOfRow(
+		ConstArrayAccessor3<double> grid,
+		const Vector3D& gridSpacing,
+		size_t iBegin, size_t iEnd, size_t j, size_t k,
+		std::array<double, 2>* dx, std::array<double, 2>* dy, std::array<double, 2>* dz) const
+	{
+		for (size_t i = iBegin; i < iEnd; ++i)
+		{
+			GetDerivatives(grid, gridSpacing, i, j, k, &dx[i - iBegin], &dy[i - iBegin], &dz[i - iBegin]);
+		}
+	}
+
 	unsigned int IterativeLevelSetSolver3::DistanceToNumberOfIterations(double distance, double dtau)
 	{
 		return static_cast<unsigned int>(std::ceil(distance / dtau));
@@ -285,20 +500,21 @@ namespace CubbyFlow
 
 		const double h = std::max({ gridSpacing.x, gridSpacing.y, gridSpacing.z });
 
-		double maxS = -std::numeric_limits<double>::max();
 		double dtau = m_maxCFL * h;
 
-		for (size_t k = 0; k < size.z; ++k)
+		const double maxS = ParallelReduce(ZERO_SIZE, size.y * size.z, -std::numeric_limits<double>::max(),
+			[&](size_t begin, size_t end, double result)
 		{
-			for (size_t j = 0; j < size.y; ++j)
+			for (size_t row = begin; row < end; ++row)
 			{
 				for (size_t i = 0; i < size.x; ++i)
 				{
-					double s = Sign(sdf, gridSpacing, i, j, k);
-					maxS = std::max(s, maxS);
+					result = std::max(result, Sign(sdf, gridSpacing, i, row % size.y, row / size.y));
 				}
 			}
-		}
+
+			return result;
+		}, [](double a, double b) { return std::max(a, b); });
 
 		while (dtau * maxS / h > m_maxCFL)
 		{
@@ -47,4 +47,14 @@ namespace CubbyFlow
 		d0[2] = grid(i, j, kp1);
 		*dz = Upwind1(d0, gridSpacing.z);
 	}
+
+	void UpwindLevelSetSolver3::GetDerivativesOfRow(
+		ConstArrayAccessor3<double> grid,
+		const Vector3D& gridSpacing,
+		size_t iBegin, size_t iEnd, size_t j, size_t k,
+		std::array<double, 2>* dx, std::array<double, 2>* dy, std::array<double, 2>* dz) const
+	{
+		GetDerivativesOfRowWithScheme<1>(grid, gridSpacing, iBegin, iEnd, j, k,
+			[](double* d0, double h) { return Upwind1(d0, h); }, dx, dy, dz);
+	}
 }
\ No newline at end of file
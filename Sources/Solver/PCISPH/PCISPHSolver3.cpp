@@ -10,6 +10,7 @@
 #include <Solver/PCISPH/PCISPHSolver3.h>
 #include <SPH/SPHStdKernel3.h>
 #include <Utils/Logger.h>
+#include <Utils/Timer.h>
 
 namespace CubbyFlow
 {
@@ -52,6 +53,36 @@ namespace CubbyFlow
 		m_maxNumberOfIterations = n;
 	}
 
+	unsigned int PCISPHSolver3::GetConvergenceCheckInterval() const
+	{
+		return m_convergenceCheckInterval;
+	}
+
+	void PCISPHSolver3::SetConvergenceCheckInterval(unsigned int n)
+	{
+		m_convergenceCheckInterval = std::max(n, 1u);
+	}
+
+	unsigned int PCISPHSolver3::GetLastNumberOfIterations() const
+	{
+		return m_lastNumberOfIterations;
+	}
+
+	double PCISPHSolver3::GetLastDensityErrorRatio() const
+	{
+		return m_lastDensityErrorRatio;
+	}
+
+	const std::vector<double>& PCISPHSolver3::GetLastDensityErrorRatios() const
+	{
+		return m_lastDensityErrorRatios;
+	}
+
+	const std::vector<double>& PCISPHSolver3::GetLastIterationTimes() const
+	{
+		return m_lastIterationTimes;
+	}
+
 	void PCISPHSolver3::AccumulatePressureForce(double timeIntervalInSeconds)
 	{
 		auto particles = GetSPHSystemData();
@@ -67,7 +98,7 @@ namespace CubbyFlow
 		auto f = particles->GetForces();
 
 		// Predicted density ds
-		Array1<double> ds(numberOfParticles, 0.0);
+		auto ds = m_predictedDensities.Accessor();
 
 		SPHStdKernel3 kernel(particles->GetKernelRadius());
 
@@ -76,16 +107,22 @@ namespace CubbyFlow
 		{
 			p[i] = 0.0;
 			m_pressureForces[i] = Vector3D();
-			m_densityErrors[i] = 0.0;
 			ds[i] = d[i];
 		});
 
+		const auto absMax = [](double a, double b) { return AbsMax(a, b); };
+
 		unsigned int maxNumIter = 0;
-		double maxDensityError;
+		double maxDensityError = 0.0;
 		double densityErrorRatio = 0.0;
 
+		m_lastDensityErrorRatios.clear();
+		m_lastIterationTimes.clear();
+
 		for (unsigned int k = 0; k < m_maxNumberOfIterations; ++k)
 		{
+			Timer timer;
+
 			// Predict velocity and position
 			ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i)
 			{
@@ -96,54 +133,62 @@ namespace CubbyFlow
 			// Resolve collisions
 			ResolveCollision(m_tempPositions, m_tempVelocities);
 
-			// Compute pressure from density error
-			ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i)
+			// Compute pressure from density error and reduce the max density error
+			maxDensityError = ParallelReduce(ZERO_SIZE, numberOfParticles, 0.0,
+				[&](size_t start, size_t end, double init)
 			{
-				double weightSum = 0.0;
-				const auto& neighbors = particles->NeighborLists()[i];
-
-				for (size_t j : neighbors)
-				{
-					double dist = m_tempPositions[j].DistanceTo(m_tempPositions[i]);
-					weightSum += kernel(dist);
-				}
-				weightSum += kernel(0);
-
-				double density = mass * weightSum;
-				double densityError = (density - targetDensity);
-				double pressure = delta * densityError;
+				double result = init;
 
-				if (pressure < 0.0)
+				for (size_t i = start; i < end; ++i)
 				{
-					pressure *= GetNegativePressureScale();
-					densityError *= GetNegativePressureScale();
+					double weightSum = 0.0;
+					const auto& neighbors = particles->NeighborLists()[i];
+
+					for (size_t j : neighbors)
+					{
+						double dist = m_tempPositions[j].DistanceTo(m_tempPositions[i]);
+						weightSum += kernel(dist);
+					}
+					weightSum += kernel(0);
+
+					double density = mass * weightSum;
+					double densityError = (density - targetDensity);
+					double pressure = delta * densityError;
+
+					if (pressure < 0.0)
+					{
+						pressure *= GetNegativePressureScale();
+						densityError *= GetNegativePressureScale();
+					}
+
+					p[i] += pressure;
+					ds[i] = density;
+					result = AbsMax(result, densityError);
 				}
 
-				p[i] += pressure;
-				ds[i] = density;
-				m_densityErrors[i] = densityError;
-			});
+				return result;
+			}, absMax);
 
 			// Compute pressure gradient force
 			m_pressureForces.Set(Vector3D());
-			SPHSolver3::AccumulatePressureForce(x, ds.ConstAccessor(), p, m_pressureForces.Accessor());
-
-			// Compute max density error
-			maxDensityError = 0.0;
-			for (size_t i = 0; i < numberOfParticles; ++i)
-			{
-				maxDensityError = AbsMax(maxDensityError, m_densityErrors[i]);
-			}
+			SPHSolver3::AccumulatePressureForce(x, ds, p, m_pressureForces.Accessor());
 
 			densityErrorRatio = maxDensityError / targetDensity;
 			maxNumIter = k + 1;
 
-			if (std::fabs(densityErrorRatio) < m_maxDensityErrorRatio)
+			m_lastDensityErrorRatios.push_back(densityErrorRatio);
+			m_lastIterationTimes.push_back(timer.DurationInSeconds());
+
+			if (maxNumIter % m_convergenceCheckInterval == 0 &&
+				std::fabs(densityErrorRatio) < m_maxDensityErrorRatio)
 			{
 				break;
 			}
 		}
 
+		m_lastNumberOfIterations = maxNumIter;
+		m_lastDensityErrorRatio = densityErrorRatio;
+
 		CUBBYFLOW_INFO << "Number of PCI iterations: " << maxNumIter;
 		CUBBYFLOW_INFO << "Max density error after PCI iteration: " << maxDensityError;
 
@@ -170,7 +215,7 @@ namespace CubbyFlow
 		m_tempPositions.Resize(numberOfParticles);
 		m_tempVelocities.Resize(numberOfParticles);
 		m_pressureForces.Resize(numberOfParticles);
-		m_densityErrors.Resize(numberOfParticles);
+		m_predictedDensities.Resize(numberOfParticles);
 	}
 
 	double PCISPHSolver3::ComputeDelta(double timeStepInSeconds) const
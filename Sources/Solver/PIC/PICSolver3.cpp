@@ -123,6 +123,30 @@ namespace CubbyFlow
 		return GetSignedDistanceField();
 	}
 
+	void PICSolver3::OnSaveCheckpoint(CheckpointWriter* writer) const
+	{
+		GridFluidSolver3::OnSaveCheckpoint(writer);
+
+		m_particles->SaveCheckpoint(writer, "particles.");
+
+		if (m_particleEmitter != nullptr)
+		{
+			m_particleEmitter->SaveCheckpoint(writer, "particleEmitter.");
+		}
+	}
+
+	void PICSolver3::OnLoadCheckpoint(const CheckpointReader& reader)
+	{
+		GridFluidSolver3::OnLoadCheckpoint(reader);
+
+		m_particles->LoadCheckpoint(reader, "particles.");
+
+		if (m_particleEmitter != nullptr)
+		{
+			m_particleEmitter->LoadCheckpoint(reader, "particleEmitter.");
+		}
+	}
+
 	void PICSolver3::TransferFromParticlesToGrids()
 	{
 		auto flow = GetGridSystemData()->GetVelocity();
@@ -12,11 +12,16 @@
 #include <Utils/Logger.h>
 #include <Utils/Parallel.h>
 #include <Utils/Timer.h>
+#include <Vector/Vector3Kernels.h>
 
 #include <algorithm>
 
 namespace CubbyFlow
 {
+	// Number of particles integrated together. A chunk of velocities stays in
+	// cache between the velocity and the position updates.
+	static const size_t TIME_INTEGRATION_CHUNK_SIZE = 2048;
+
 	ParticleSystemSolver3::ParticleSystemSolver3() :
 		ParticleSystemSolver3(1e-3, 1e-3)
 	{
@@ -139,6 +144,40 @@ namespace CubbyFlow
 		EndAdvanceTimeStep(timeStepInSeconds);
 	}
 
+	void ParticleSystemSolver3::OnSaveCheckpoint(CheckpointWriter* writer) const
+	{
+		PhysicsAnimation::OnSaveCheckpoint(writer);
+
+		m_particleSystemData->SaveCheckpoint(writer, "particles.");
+
+		if (m_emitter != nullptr)
+		{
+			m_emitter->SaveCheckpoint(writer, "emitter.");
+		}
+
+		if (m_collider != nullptr)
+		{
+			m_collider->SaveCheckpoint(writer, "collider.");
+		}
+	}
+
+	void ParticleSystemSolver3::OnLoadCheckpoint(const CheckpointReader& reader)
+	{
+		PhysicsAnimation::OnLoadCheckpoint(reader);
+
+		m_particleSystemData->LoadCheckpoint(reader, "particles.");
+
+		if (m_emitter != nullptr)
+		{
+			m_emitter->LoadCheckpoint(reader, "emitter.");
+		}
+
+		if (m_collider != nullptr)
+		{
+			m_collider->LoadCheckpoint(reader, "collider.");
+		}
+	}
+
 	void ParticleSystemSolver3::AccumulateForces(double timeStepInSeconds)
 	{
 		// Add external forces
@@ -255,15 +294,29 @@ namespace CubbyFlow
 		auto positions = m_particleSystemData->GetPositions();
 		const double mass = m_particleSystemData->GetMass();
 
-		ParallelFor(ZERO_SIZE, n, [&](size_t i)
+		const size_t numberOfChunks = (n + TIME_INTEGRATION_CHUNK_SIZE - 1) / TIME_INTEGRATION_CHUNK_SIZE;
+
+		ParallelFor(ZERO_SIZE, numberOfChunks, [&](size_t chunk)
 		{
+			const size_t begin = chunk * TIME_INTEGRATION_CHUNK_SIZE;
+			const size_t size = std::min(TIME_INTEGRATION_CHUNK_SIZE, n - begin);
+			ArrayAccessor1<Vector3D> newVelocities(size, m_newVelocities.data() + begin);
+			ArrayAccessor1<Vector3D> newPositions(size, m_newPositions.data() + begin);
+
 			// Integrate velocity first
-			Vector3D& newVelocity = m_newVelocities[i];
-			newVelocity = velocities[i] + timeStepInSeconds * forces[i] / mass;
+			Vector3Kernels::AXOverBPlusY(
+				timeStepInSeconds,
+				mass,
+				ConstArrayAccessor1<Vector3D>(size, forces.data() + begin),
+				ConstArrayAccessor1<Vector3D>(size, velocities.data() + begin),
+				&newVelocities);
 
 			// Integrate position.
-			Vector3D& newPosition = m_newPositions[i];
-			newPosition = positions[i] + timeStepInSeconds * newVelocity;
+			Vector3Kernels::AXPlusY(
+				timeStepInSeconds,
+				ConstArrayAccessor1<Vector3D>(newVelocities),
+				ConstArrayAccessor1<Vector3D>(size, positions.data() + begin),
+				&newPositions);
 		});
 	}
 
@@ -112,12 +112,18 @@ namespace CubbyFlow
 		const double kernelRadius = particles->GetKernelRadius();
 		const double mass = particles->GetMass();
 
-		double maxForceMagnitude = 0.0;
-
-		for (size_t i = 0; i < numberOfParticles; ++i)
+		const double maxForceMagnitude = std::sqrt(ParallelReduce(ZERO_SIZE, numberOfParticles, 0.0,
+			[&f](size_t start, size_t end, double init)
 		{
-			maxForceMagnitude = std::max(maxForceMagnitude, f[i].Length());
-		}
+			double result = init;
+
+			for (size_t i = start; i < end; ++i)
+			{
+				result = std::max(result, f[i].LengthSquared());
+			}
+
+			return result;
+		}, [](double a, double b) { return std::max(a, b); }));
 
 		double timeStepLimitBySpeed = TIME_STEP_LIMIT_BY_SPEED_FACTOR * kernelRadius / m_speedOfSound;
 		double timeStepLimitByForce = TIME_STEP_LIMIT_BY_FORCE_FACTOR * std::sqrt(kernelRadius * mass / maxForceMagnitude);
@@ -155,11 +161,18 @@ namespace CubbyFlow
 		size_t numberOfParticles = particles->NumberOfParticles();
 		auto densities = particles->GetDensities();
 
-		double maxDensity = 0.0;
-		for (size_t i = 0; i < numberOfParticles; ++i)
+		const double maxDensity = ParallelReduce(ZERO_SIZE, numberOfParticles, 0.0,
+			[&densities](size_t start, size_t end, double init)
 		{
-			maxDensity = std::max(maxDensity, densities[i]);
-		}
+			double result = init;
+
+			for (size_t i = start; i < end; ++i)
+			{
+				result = std::max(result, densities[i]);
+			}
+
+			return result;
+		}, [](double a, double b) { return std::max(a, b); });
 
 		CUBBYFLOW_INFO << "Max density: " << maxDensity << " "
 			<< "Max density / target density ratio: "
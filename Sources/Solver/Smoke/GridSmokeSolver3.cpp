@@ -8,6 +8,7 @@
 *************************************************************************/
 #include <Grid/CellCenteredScalarGrid3.h>
 #include <Solver/Smoke/GridSmokeSolver3.h>
+#include <Utils/Parallel.h>
 
 namespace CubbyFlow
 {
@@ -115,47 +116,60 @@ namespace CubbyFlow
 
 	void GridSmokeSolver3::ComputeDiffusion(double timeIntervalInSeconds)
 	{
-		if (GetDiffusionSolver() != nullptr)
+		auto den = GetSmokeDensity();
+		auto temp = GetTemperature();
+
+		const double denDecay = 1.0 - m_smokeDecayFactor;
+		const double tempDecay = 1.0 - m_temperatureDecayFactor;
+
+		const bool diffuseDen = GetDiffusionSolver() != nullptr && m_smokeDiffusionCoefficient > std::numeric_limits<double>::epsilon();
+		const bool diffuseTemp = GetDiffusionSolver() != nullptr && m_temperatureDiffusionCoefficient > std::numeric_limits<double>::epsilon();
+
+		// Diffuses into the scratch grid and decays while copying back, so
+		// that the grids are neither cloned nor swept again for the decay
+		const auto diffuseAndDecay = [&](const ScalarGrid3Ptr& grid, double coefficient, double decay)
 		{
-			if (m_smokeDiffusionCoefficient > std::numeric_limits<double>::epsilon())
-			{
-				auto den = GetSmokeDensity();
-				auto den0 = std::dynamic_pointer_cast<CellCenteredScalarGrid3>(den->Clone());
-
-				GetDiffusionSolver()->Solve(
-					*den0,
-					m_smokeDiffusionCoefficient,
-					timeIntervalInSeconds,
-					den0.get(),
-					*GetColliderSDF());
-				ExtrapolateIntoCollider(den.get());
-			}
+			m_scratch.Resize(grid->Resolution(), grid->GridSpacing(), grid->Origin());
 
-			if (m_temperatureDiffusionCoefficient > std::numeric_limits<double>::epsilon())
+			GetDiffusionSolver()->Solve(
+				*grid,
+				coefficient,
+				timeIntervalInSeconds,
+				&m_scratch,
+				*GetColliderSDF());
+
+			grid->ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k)
 			{
-				auto temp = GetSmokeDensity();
-				auto temp0 = std::dynamic_pointer_cast<CellCenteredScalarGrid3>(temp->Clone());
-
-				GetDiffusionSolver()->Solve(
-					*temp0,
-					m_temperatureDiffusionCoefficient,
-					timeIntervalInSeconds,
-					temp.get(),
-					*GetColliderSDF());
-				ExtrapolateIntoCollider(temp.get());
-			}
+				(*grid)(i, j, k) = m_scratch(i, j, k) * decay;
+			});
+
+			ExtrapolateIntoCollider(grid.get());
+		};
+
+		if (diffuseDen)
+		{
+			diffuseAndDecay(den, m_smokeDiffusionCoefficient, denDecay);
 		}
 
-		auto den = GetSmokeDensity();
-		den->ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+		if (diffuseTemp)
 		{
-			(*den)(i, j, k) *= 1.0 - m_smokeDecayFactor;
-		});
-		auto temp = GetTemperature();
-		temp->ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+			diffuseAndDecay(temp, m_temperatureDiffusionCoefficient, tempDecay);
+		}
+
+		// Decays the grids not diffused in a single sweep
+		if (!diffuseDen || !diffuseTemp)
 		{
-			(*temp)(i, j, k) *= 1.0 - m_temperatureDecayFactor;
-		});
+			auto denAcc = den->GetDataAccessor();
+			auto tempAcc = temp->GetDataAccessor();
+			const double denFactor = diffuseDen ? 1.0 : denDecay;
+			const double tempFactor = diffuseTemp ? 1.0 : tempDecay;
+
+			den->ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+			{
+				denAcc(i, j, k) *= denFactor;
+				tempAcc(i, j, k) *= tempFactor;
+			});
+		}
 	}
 
 	void GridSmokeSolver3::ComputeBuoyancyForce(double timeIntervalInSeconds)
@@ -172,58 +186,62 @@ namespace CubbyFlow
 		if (std::abs(m_buoyancySmokeDensityFactor) > std::numeric_limits<double>::epsilon() ||
 			std::abs(m_buoyancyTemperatureFactor) > std::numeric_limits<double>::epsilon())
 		{
-			auto den = GetSmokeDensity();
-			auto temp = GetTemperature();
+			auto den = GetSmokeDensity()->GetConstDataAccessor();
+			auto temp = GetTemperature()->GetConstDataAccessor();
+			const Size3 size = temp.size();
 
-			double tAmb = 0.0;
-			temp->ForEachCellIndex([&](size_t i, size_t j, size_t k)
+			double tAmb = ParallelReduce(ZERO_SIZE, size.y * size.z, 0.0,
+				[&](size_t begin, size_t end, double result)
 			{
-				tAmb += (*temp)(i, j, k);
-			});
+				for (size_t row = begin; row < end; ++row)
+				{
+					const double* tempRow = temp.data() + row * size.x;
 
-			tAmb /= static_cast<double>(temp->Resolution().x * temp->Resolution().y * temp->Resolution().z);
+					for (size_t i = 0; i < size.x; ++i)
+					{
+						result += tempRow[i];
+					}
+				}
 
-			auto u = vel->GetUAccessor();
-			auto v = vel->GetVAccessor();
-			auto w = vel->GetWAccessor();
-			auto uPos = vel->GetUPosition();
-			auto vPos = vel->GetVPosition();
-			auto wPos = vel->GetWPosition();
+				return result;
+			}, [](double a, double b) { return a + b; });
 
-			if (std::abs(up.x) > std::numeric_limits<double>::epsilon())
+			tAmb /= static_cast<double>(size.x * size.y * size.z);
+
+			// Both fields are cell-centered on the velocity grid, so a face
+			// value is the average of the two cells sharing the face, or of
+			// the nearest cell on the domain boundary.
+			const auto addBuoyancy = [&](ArrayAccessor3<double> face, size_t axis, double upComponent)
 			{
-				vel->ParallelForEachUIndex([&](size_t i, size_t j, size_t k)
+				const double scale = 0.5 * timeIntervalInSeconds * upComponent;
+
+				face.ParallelForEachIndex([&](size_t i, size_t j, size_t k)
 				{
-					Vector3D pt = uPos(i, j, k);
-					double fBuoy =
-						m_buoyancySmokeDensityFactor * den->Sample(pt) +
-						m_buoyancyTemperatureFactor * (temp->Sample(pt) - tAmb);
-					u(i, j, k) += timeIntervalInSeconds * fBuoy * up.x;
+					size_t lower[3] = { i, j, k };
+					size_t upper[3] = { i, j, k };
+					lower[axis] = (lower[axis] > 0) ? lower[axis] - 1 : 0;
+					upper[axis] = std::min(upper[axis], size[axis] - 1);
+
+					const double fBuoy =
+						m_buoyancySmokeDensityFactor * (den(lower[0], lower[1], lower[2]) + den(upper[0], upper[1], upper[2])) +
+						m_buoyancyTemperatureFactor * (temp(lower[0], lower[1], lower[2]) + temp(upper[0], upper[1], upper[2]) - 2.0 * tAmb);
+					face(i, j, k) += scale * fBuoy;
 				});
+			};
+
+			if (std::abs(up.x) > std::numeric_limits<double>::epsilon())
+			{
+				addBuoyancy(vel->GetUAccessor(), 0, up.x);
 			}
 
 			if (std::abs(up.y) > std::numeric_limits<double>::epsilon())
 			{
-				vel->ParallelForEachVIndex([&](size_t i, size_t j, size_t k)
-				{
-					Vector3D pt = vPos(i, j, k);
-					double fBuoy =
-						m_buoyancySmokeDensityFactor * den->Sample(pt) +
-						m_buoyancyTemperatureFactor * (temp->Sample(pt) - tAmb);
-					v(i, j, k) += timeIntervalInSeconds * fBuoy * up.y;
-				});
+				addBuoyancy(vel->GetVAccessor(), 1, up.y);
 			}
 
 			if (std::abs(up.z) > std::numeric_limits<double>::epsilon())
 			{
-				vel->ParallelForEachWIndex([&](size_t i, size_t j, size_t k)
-				{
-					Vector3D pt = wPos(i, j, k);
-					double fBuoy =
-						m_buoyancySmokeDensityFactor * den->Sample(pt) +
-						m_buoyancyTemperatureFactor * (temp->Sample(pt) - tAmb);
-					w(i, j, k) += timeIntervalInSeconds * fBuoy * up.z;
-				});
+				addBuoyancy(vel->GetWAccessor(), 2, up.z);
 			}
 
 			ApplyBoundaryCondition();
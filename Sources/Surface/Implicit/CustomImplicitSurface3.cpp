@@ -8,6 +8,7 @@
 *************************************************************************/
 #include <LevelSet/LevelSetUtils.h>
 #include <Surface/Implicit/CustomImplicitSurface3.h>
+#include <Utils/Logger.h>
 
 namespace CubbyFlow
 {
@@ -27,6 +28,30 @@ namespace CubbyFlow
 		// Do nothing
 	}
 
+	void CustomImplicitSurface3::BakeDistanceField(unsigned int maxDepth, double tolerance)
+	{
+		const Vector3D size = m_domain.upperCorner - m_domain.lowerCorner;
+
+		if (!m_func || !(size.x > 0.0 && size.y > 0.0 && size.z > 0.0) ||
+			size.Max() == std::numeric_limits<double>::max())
+		{
+			CUBBYFLOW_WARN << "Cannot bake the SDF without a bounded domain.";
+			return;
+		}
+
+		m_bakedField = std::make_shared<AdaptiveDistanceField3>(m_func, m_domain, maxDepth, tolerance, m_resolution);
+	}
+
+	bool CustomImplicitSurface3::IsDistanceFieldBaked() const
+	{
+		return m_bakedField != nullptr;
+	}
+
+	const AdaptiveDistanceField3Ptr& CustomImplicitSurface3::GetBakedDistanceField() const
+	{
+		return m_bakedField;
+	}
+
 	Vector3D CustomImplicitSurface3::ClosestPointLocal(const Vector3D& otherPoint) const
 	{
 		Vector3D pt = Clamp(otherPoint, m_domain.lowerCorner, m_domain.upperCorner);
@@ -67,12 +92,12 @@ namespace CubbyFlow
 
 			double t = start;
 			Vector3D pt = ray.PointAt(t);
-			double prevPhi = m_func(pt);
+			double prevPhi = SignedDistanceLocal(pt);
 
 			while (t <= end)
 			{
 				pt = ray.PointAt(t);
-				const double newPhi = m_func(pt);
+				const double newPhi = SignedDistanceLocal(pt);
 				const double newPhiAbs = std::fabs(newPhi);
 
 				if (newPhi * prevPhi < 0.0)
@@ -95,6 +120,11 @@ namespace CubbyFlow
 
 	double CustomImplicitSurface3::SignedDistanceLocal(const Vector3D& otherPoint) const
 	{
+		if (m_bakedField != nullptr && m_domain.Contains(otherPoint))
+		{
+			return m_bakedField->Sample(otherPoint);
+		}
+
 		if (m_func)
 		{
 			return m_func(otherPoint);
@@ -137,12 +167,12 @@ namespace CubbyFlow
 
 			double t = start;
 			Vector3D pt = ray.PointAt(t);
-			double prevPhi = m_func(pt);
+			double prevPhi = SignedDistanceLocal(pt);
 
 			while (t <= end)
 			{
 				pt = ray.PointAt(t);
-				const double newPhi = m_func(pt);
+				const double newPhi = SignedDistanceLocal(pt);
 				const double newPhiAbs = std::fabs(newPhi);
 
 				if (newPhi * prevPhi < 0.0)
@@ -173,6 +203,11 @@ namespace CubbyFlow
 
 	Vector3D CustomImplicitSurface3::GradientLocal(const Vector3D& x) const
 	{
+		if (m_bakedField != nullptr && m_domain.Contains(x))
+		{
+			return m_bakedField->Gradient(x);
+		}
+
 		double left = m_func(x - Vector3D(0.5 * m_resolution, 0.0, 0.0));
 		double right = m_func(x + Vector3D(0.5 * m_resolution, 0.0, 0.0));
 		double bottom = m_func(x - Vector3D(0.0, 0.5 * m_resolution, 0.0));
@@ -221,18 +256,40 @@ namespace CubbyFlow
 		return *this;
 	}
 
+	CustomImplicitSurface3::Builder& CustomImplicitSurface3::Builder::WithBakedDistanceField(unsigned int maxDepth, double tolerance)
+	{
+		m_isDistanceFieldBaked = true;
+		m_bakingMaxDepth = maxDepth;
+		m_bakingTolerance = tolerance;
+		return *this;
+	}
+
 	CustomImplicitSurface3 CustomImplicitSurface3::Builder::Build() const
 	{
-		return CustomImplicitSurface3(m_func, m_domain, m_resolution, m_rayMarchingResolution, m_maxNumberOfIterations, m_transform, m_isNormalFlipped);
+		CustomImplicitSurface3 surface(m_func, m_domain, m_resolution, m_rayMarchingResolution, m_maxNumberOfIterations, m_transform, m_isNormalFlipped);
+
+		if (m_isDistanceFieldBaked)
+		{
+			surface.BakeDistanceField(m_bakingMaxDepth, m_bakingTolerance);
+		}
+
+		return surface;
 	}
 
 	CustomImplicitSurface3Ptr CustomImplicitSurface3::Builder::MakeShared() const
 	{
-		return std::shared_ptr<CustomImplicitSurface3>(
+		auto surface = std::shared_ptr<CustomImplicitSurface3>(
 			new CustomImplicitSurface3(m_func, m_domain, m_resolution, m_rayMarchingResolution, m_maxNumberOfIterations, m_transform, m_isNormalFlipped),
 			[](CustomImplicitSurface3* obj)
 		{
 			delete obj;
 		});
+
+		if (m_isDistanceFieldBaked)
+		{
+			surface->BakeDistanceField(m_bakingMaxDepth, m_bakingTolerance);
+		}
+
+		return surface;
 	}
 }
\ No newline at end of file
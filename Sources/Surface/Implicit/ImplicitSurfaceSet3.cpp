@@ -6,11 +6,74 @@
 > Created Time: 2017/04/18
 > Copyright (c) 2017, Dongmin Kim
 *************************************************************************/
+#include <Geometry/Box3.h>
+#include <Geometry/Cylinder3.h>
+#include <Geometry/Sphere3.h>
+#include <Geometry/TriangleMesh3.h>
 #include <Surface/Implicit/ImplicitSurfaceSet3.h>
 #include <Surface/Implicit/SurfaceToImplicit3.h>
+#include <Surface/SurfaceSet3.h>
+#include <Utils/Parallel.h>
+
+#include <algorithm>
 
 namespace CubbyFlow
 {
+	// Number of data points per axis processed together by FillSignedDistance.
+	static const size_t SIGNED_DISTANCE_TILE_SIZE = 8;
+
+	// Returns true if the signed distance of the surface is not less than the
+	// distance to its bounding box for any point outside of the box. This only
+	// holds for closed surfaces, so the open ones (e.g., Plane3 and Triangle3)
+	// and the surfaces with arbitrary fields (e.g., CustomImplicitSurface3) are
+	// never pruned. Triangle meshes are assumed to be closed.
+	static bool IsSignedDistanceBoundedByBox(const Surface3& surface)
+	{
+		const BoundingBox3D bound = surface.BoundingBox();
+		if (surface.isNormalFlipped ||
+			!std::isfinite(bound.Width()) || !std::isfinite(bound.Height()) || !std::isfinite(bound.Depth()))
+		{
+			return false;
+		}
+
+		if (auto wrapper = dynamic_cast<const SurfaceToImplicit3*>(&surface))
+		{
+			return IsSignedDistanceBoundedByBox(*wrapper->GetSurface());
+		}
+
+		if (auto set = dynamic_cast<const ImplicitSurfaceSet3*>(&surface))
+		{
+			for (size_t i = 0; i < set->NumberOfSurfaces(); ++i)
+			{
+				if (!IsSignedDistanceBoundedByBox(*set->SurfaceAt(i)))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		if (auto set = dynamic_cast<const SurfaceSet3*>(&surface))
+		{
+			for (size_t i = 0; i < set->NumberOfSurfaces(); ++i)
+			{
+				if (!IsSignedDistanceBoundedByBox(*set->SurfaceAt(i)))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		return
+			dynamic_cast<const Box3*>(&surface) != nullptr ||
+			dynamic_cast<const Cylinder3*>(&surface) != nullptr ||
+			dynamic_cast<const Sphere3*>(&surface) != nullptr ||
+			dynamic_cast<const TriangleMesh3*>(&surface) != nullptr;
+	}
+
 	ImplicitSurfaceSet3::ImplicitSurfaceSet3()
 	{
 		// Do nothing
@@ -150,14 +213,134 @@ namespace CubbyFlow
 
 	double ImplicitSurfaceSet3::SignedDistanceLocal(const Vector3D& otherPoint) const
 	{
+		BuildBVH();
+
 		double sdf = std::numeric_limits<double>::max();
 
+		for (size_t i : m_unboundedSurfaces)
+		{
+			sdf = std::min(sdf, m_surfaces[i]->SignedDistance(otherPoint));
+		}
+
+		return std::min(sdf, BoundedSignedDistanceLocal(otherPoint));
+	}
+
+	double ImplicitSurfaceSet3::BoundedSignedDistanceLocal(const Vector3D& otherPoint) const
+	{
+		if (m_surfaces.size() == m_unboundedSurfaces.size())
+		{
+			return std::numeric_limits<double>::max();
+		}
+
+		const ImplicitSurface3Ptr* firstItem = &m_bvh.GetItem(0);
+		const auto signedDistanceFunc = [&](const ImplicitSurface3Ptr& surface, const Vector3D& pt)
+		{
+			return m_isBoundedSurface[&surface - firstItem] ?
+				surface->SignedDistance(pt) : std::numeric_limits<double>::max();
+		};
+
+		return m_bvh.GetMinimumSignedDistance(otherPoint, signedDistanceFunc).distance;
+	}
+
+	void ImplicitSurfaceSet3::FillSignedDistance(ScalarGrid3* grid) const
+	{
+		BuildBVH();
+
+		auto pos = grid->GetDataPosition();
+		auto sdf = grid->GetDataAccessor();
+		const Size3 size = sdf.size();
+
+		const size_t numberOfTilesX = (size.x + SIGNED_DISTANCE_TILE_SIZE - 1) / SIGNED_DISTANCE_TILE_SIZE;
+		const size_t numberOfTilesY = (size.y + SIGNED_DISTANCE_TILE_SIZE - 1) / SIGNED_DISTANCE_TILE_SIZE;
+		const size_t numberOfTilesZ = (size.z + SIGNED_DISTANCE_TILE_SIZE - 1) / SIGNED_DISTANCE_TILE_SIZE;
+
+		ParallelFor(ZERO_SIZE, numberOfTilesX * numberOfTilesY * numberOfTilesZ, [&](size_t tile)
+		{
+			const size_t iBegin = (tile % numberOfTilesX) * SIGNED_DISTANCE_TILE_SIZE;
+			const size_t jBegin = ((tile / numberOfTilesX) % numberOfTilesY) * SIGNED_DISTANCE_TILE_SIZE;
+			const size_t kBegin = (tile / (numberOfTilesX * numberOfTilesY)) * SIGNED_DISTANCE_TILE_SIZE;
+			const size_t iEnd = std::min(iBegin + SIGNED_DISTANCE_TILE_SIZE, size.x);
+			const size_t jEnd = std::min(jBegin + SIGNED_DISTANCE_TILE_SIZE, size.y);
+			const size_t kEnd = std::min(kBegin + SIGNED_DISTANCE_TILE_SIZE, size.z);
+
+			// The signed distance of the bounded surfaces is 1-Lipschitz, so their
+			// minimum at any point in the tile is not greater than the value at
+			// the center plus the tile radius. Surfaces whose bounding boxes are
+			// farther than that cannot be the minimum. The unbounded surfaces are
+			// left out, since the fields of the open ones are not continuous.
+			const BoundingBox3D tileBound = transform.ToLocal(
+				BoundingBox3D(pos(iBegin, jBegin, kBegin), pos(iEnd - 1, jEnd - 1, kEnd - 1)));
+			const double upperBound = BoundedSignedDistanceLocal(tileBound.MidPoint()) + 0.5 * tileBound.DiagonalLength();
+
+			BoundingBox3D queryBound = tileBound;
+			queryBound.Expand(std::max(upperBound, 0.0));
+
+			// Collect the candidates, nearest to the tile center first
+			std::vector<std::pair<double, size_t>> candidates;
+			const ImplicitSurface3Ptr* firstItem = (m_bvh.GetNumberOfItems() > 0) ? &m_bvh.GetItem(0) : nullptr;
+
+			m_bvh.ForEachIntersectingItem(queryBound,
+				[&](const ImplicitSurface3Ptr& surface, const BoundingBox3D& box)
+			{
+				return m_surfaceBounds[&surface - firstItem].Overlaps(box);
+			},
+				[&](const ImplicitSurface3Ptr& surface)
+			{
+				const size_t index = static_cast<size_t>(&surface - firstItem);
+
+				if (m_isBoundedSurface[index])
+				{
+					const BoundingBox3D& bound = m_surfaceBounds[index];
+					candidates.emplace_back(bound.Clamp(tileBound.MidPoint()).DistanceSquaredTo(tileBound.MidPoint()), index);
+				}
+			});
+
+			std::sort(candidates.begin(), candidates.end());
+
+			for (size_t k = kBegin; k < kEnd; ++k)
+			{
+				for (size_t j = jBegin; j < jEnd; ++j)
+				{
+					for (size_t i = iBegin; i < iEnd; ++i)
+					{
+						const Vector3D localPt = transform.ToLocal(pos(i, j, k));
+						double value = std::numeric_limits<double>::max();
+
+						for (size_t index : m_unboundedSurfaces)
+						{
+							value = std::min(value, m_surfaces[index]->SignedDistance(localPt));
+						}
+
+						for (const auto& candidate : candidates)
+						{
+							// Same pruning as SignedDistanceLocal, per candidate
+							const BoundingBox3D& bound = m_surfaceBounds[candidate.second];
+							const double distSqr = bound.Clamp(localPt).DistanceSquaredTo(localPt);
+
+							if (distSqr > 0.0 && (value <= 0.0 || distSqr >= value * value))
+							{
+								continue;
+							}
+
+							value = std::min(value, m_surfaces[candidate.second]->SignedDistance(localPt));
+						}
+
+						sdf(i, j, k) = value;
+					}
+				}
+			}
+		});
+	}
+
+	void ImplicitSurfaceSet3::UpdateQueryEngine()
+	{
 		for (const auto& surface : m_surfaces)
 		{
-			sdf = std::min(sdf, surface->SignedDistance(otherPoint));
+			surface->UpdateQueryEngine();
 		}
 
-		return sdf;
+		InvalidateBVH();
+		BuildBVH();
 	}
 
 	void ImplicitSurfaceSet3::InvalidateBVH() const
@@ -169,14 +352,28 @@ namespace CubbyFlow
 	{
 		if (m_bvhInvalidated)
 		{
-			std::vector<BoundingBox3D> bounds(m_surfaces.size());
+			m_surfaceBounds.resize(m_surfaces.size());
 			
 			for (size_t i = 0; i < m_surfaces.size(); ++i)
 			{
-				bounds[i] = m_surfaces[i]->BoundingBox();
+				m_surfaceBounds[i] = m_surfaces[i]->BoundingBox();
+			}
+
+			m_bvh.Build(m_surfaces, m_surfaceBounds);
+
+			m_isBoundedSurface.resize(m_surfaces.size());
+			m_unboundedSurfaces.clear();
+
+			for (size_t i = 0; i < m_surfaces.size(); ++i)
+			{
+				m_isBoundedSurface[i] = IsSignedDistanceBoundedByBox(*m_surfaces[i]);
+
+				if (!m_isBoundedSurface[i])
+				{
+					m_unboundedSurfaces.push_back(i);
+				}
 			}
 
-			m_bvh.Build(m_surfaces, bounds);
 			m_bvhInvalidated = false;
 		}
 	}
@@ -36,6 +36,11 @@ namespace CubbyFlow
 		return m_surface;
 	}
 
+	void SurfaceToImplicit3::UpdateQueryEngine()
+	{
+		m_surface->UpdateQueryEngine();
+	}
+
 	SurfaceToImplicit3::Builder SurfaceToImplicit3::GetBuilder()
 	{
 		return Builder();
@@ -97,7 +102,7 @@ namespace CubbyFlow
 		return SurfaceToImplicit3(m_surface, m_transform, m_isNormalFlipped);
 	}
 
-	SurfaceToImplicit3 SurfaceToImplicit3::Builder::MakeShared() const
+	SurfaceToImplicit3Ptr SurfaceToImplicit3::Builder::MakeShared() const
 	{
 		return std::shared_ptr<SurfaceToImplicit3>(
 			new SurfaceToImplicit3(m_surface, m_transform, m_isNormalFlipped),
@@ -8,6 +8,8 @@
 *************************************************************************/
 #include <Surface/SurfaceSet3.h>
 
+#include <limits>
+
 namespace CubbyFlow
 {
 	SurfaceSet3::SurfaceSet3()
@@ -46,6 +48,35 @@ namespace CubbyFlow
 		InvalidateBVH();
 	}
 
+	size_t SurfaceSet3::ClosestSurfaceIndex(const Vector3D& otherPoint) const
+	{
+		BuildBVH();
+
+		const auto distanceFunc = [](const Surface3Ptr& surface, const Vector3D& pt)
+		{
+			return surface->ClosestDistance(pt);
+		};
+
+		const auto queryResult = m_bvh.GetNearestNeighbor(transform.ToLocal(otherPoint), distanceFunc);
+		if (queryResult.item == nullptr)
+		{
+			return std::numeric_limits<size_t>::max();
+		}
+
+		return static_cast<size_t>(queryResult.item - &m_bvh.GetItem(0));
+	}
+
+	void SurfaceSet3::UpdateQueryEngine()
+	{
+		for (const auto& surface : m_surfaces)
+		{
+			surface->UpdateQueryEngine();
+		}
+
+		InvalidateBVH();
+		BuildBVH();
+	}
+
 	Vector3D SurfaceSet3::ClosestPointLocal(const Vector3D& otherPoint) const
 	{
 		BuildBVH();
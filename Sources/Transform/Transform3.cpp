@@ -7,6 +7,7 @@
 > Copyright (c) 2017, Dongmin Kim
 *************************************************************************/
 #include <Transform/Transform3.h>
+#include <Vector/Vector3Kernels.h>
 
 namespace CubbyFlow
 {
@@ -76,6 +77,11 @@ namespace CubbyFlow
 		return bboxInLocal;
 	}
 
+	void Transform3::ToLocal(const ConstArrayAccessor1<Vector3D>& pointsInWorld, ArrayAccessor1<Vector3D>* pointsInLocal) const
+	{
+		Vector3Kernels::Transform(m_inverseOrientationMat3, -m_translation, Vector3D(), pointsInWorld, pointsInLocal);
+	}
+
 	Vector3D Transform3::ToWorld(const Vector3D& pointInLocal) const
 	{
 		return (m_orientationMat3 * pointInLocal) + m_translation;
@@ -106,4 +112,9 @@ namespace CubbyFlow
 
 		return bboxInWorld;
 	}
+
+	void Transform3::ToWorld(const ConstArrayAccessor1<Vector3D>& pointsInLocal, ArrayAccessor1<Vector3D>* pointsInWorld) const
+	{
+		Vector3Kernels::Transform(m_orientationMat3, Vector3D(), m_translation, pointsInLocal, pointsInWorld);
+	}
 }
\ No newline at end of file
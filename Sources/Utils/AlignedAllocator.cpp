@@ -0,0 +1,53 @@
+/*************************************************************************
+> File Name: AlignedAllocator.cpp
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Standard allocator returning cache-line aligned storage.
+> Created Time: 2017/10/31
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#include <Utils/AlignedAllocator.h>
+
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <cstdlib>
+#endif
+
+namespace CubbyFlow
+{
+	void* AlignedMalloc(size_t size, size_t alignment)
+	{
+		// Zero-sized requests still return a unique pointer
+		if (size == 0)
+		{
+			size = alignment;
+		}
+
+#ifdef _WIN32
+		void* ptr = _aligned_malloc(size, alignment);
+#else
+		void* ptr = nullptr;
+		if (posix_memalign(&ptr, alignment, size) != 0)
+		{
+			ptr = nullptr;
+		}
+#endif
+
+		if (ptr == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+
+		return ptr;
+	}
+
+	void AlignedFree(void* ptr)
+	{
+#ifdef _WIN32
+		_aligned_free(ptr);
+#else
+		free(ptr);
+#endif
+	}
+}
\ No newline at end of file
@@ -0,0 +1,331 @@
+/*************************************************************************
+> File Name: Checkpoint.cpp
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Streaming checkpoint writer and memory-mapped checkpoint reader.
+> Created Time: 2017/10/21
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#include <Utils/Checkpoint.h>
+#include <Utils/Logger.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+#include <stdexcept>
+
+namespace CubbyFlow
+{
+	// File layout:
+	//   [header magic][padding]
+	//   [chunk 0][padding][chunk 1][padding]...
+	//   [chunk table: (name length, name, offset, size) * N]
+	//   [table offset][number of chunks][footer magic]
+	static const char HEADER_MAGIC[8] = { 'C', 'F', 'C', 'K', 'P', 'T', '0', '1' };
+	static const char FOOTER_MAGIC[8] = { 'C', 'F', 'C', 'K', 'P', 'E', 'N', 'D' };
+	static const size_t FOOTER_SIZE = 2 * sizeof(uint64_t) + sizeof(FOOTER_MAGIC);
+
+	CheckpointWriter::CheckpointWriter(const std::string& fileName) :
+		m_file(fileName, std::ios::binary | std::ios::trunc)
+	{
+		if (!m_file)
+		{
+			CUBBYFLOW_ERROR << "Failed to open checkpoint file " << fileName;
+			return;
+		}
+
+		m_file.write(HEADER_MAGIC, sizeof(HEADER_MAGIC));
+		m_offset = sizeof(HEADER_MAGIC);
+	}
+
+	CheckpointWriter::~CheckpointWriter()
+	{
+		Close();
+	}
+
+	bool CheckpointWriter::IsOpen() const
+	{
+		return m_file.is_open() && m_file.good();
+	}
+
+	void CheckpointWriter::WriteChunk(const std::string& name, const void* data, size_t sizeInBytes)
+	{
+		if (!m_file.is_open())
+		{
+			return;
+		}
+
+		static const char zeros[ChunkAlignment] = { 0 };
+		const size_t padding = static_cast<size_t>((ChunkAlignment - m_offset % ChunkAlignment) % ChunkAlignment);
+		m_file.write(zeros, padding);
+		m_offset += padding;
+
+		m_entries.push_back(Entry{ name, m_offset, sizeInBytes });
+
+		if (sizeInBytes > 0)
+		{
+			m_file.write(static_cast<const char*>(data), static_cast<std::streamsize>(sizeInBytes));
+			m_offset += sizeInBytes;
+		}
+	}
+
+	void CheckpointWriter::WriteString(const std::string& name, const std::string& str)
+	{
+		WriteChunk(name, str.data(), str.size());
+	}
+
+	void CheckpointWriter::Close()
+	{
+		if (!m_file.is_open())
+		{
+			return;
+		}
+
+		const uint64_t tableOffset = m_offset;
+		const uint64_t numberOfChunks = m_entries.size();
+
+		for (const auto& entry : m_entries)
+		{
+			const uint64_t nameLength = entry.name.size();
+			m_file.write(reinterpret_cast<const char*>(&nameLength), sizeof(nameLength));
+			m_file.write(entry.name.data(), static_cast<std::streamsize>(nameLength));
+			m_file.write(reinterpret_cast<const char*>(&entry.offset), sizeof(entry.offset));
+			m_file.write(reinterpret_cast<const char*>(&entry.size), sizeof(entry.size));
+		}
+
+		m_file.write(reinterpret_cast<const char*>(&tableOffset), sizeof(tableOffset));
+		m_file.write(reinterpret_cast<const char*>(&numberOfChunks), sizeof(numberOfChunks));
+		m_file.write(FOOTER_MAGIC, sizeof(FOOTER_MAGIC));
+
+		if (!m_file)
+		{
+			CUBBYFLOW_ERROR << "Failed to write checkpoint file";
+		}
+
+		m_file.close();
+		m_entries.clear();
+	}
+
+	CheckpointReader::CheckpointReader(const std::string& fileName)
+	{
+#ifdef _WIN32
+		HANDLE file = CreateFileA(
+			fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			CUBBYFLOW_ERROR << "Failed to open checkpoint file " << fileName;
+			return;
+		}
+		m_fileHandle = file;
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+		{
+			CUBBYFLOW_ERROR << "Invalid checkpoint file " << fileName;
+			Unmap();
+			return;
+		}
+		m_size = static_cast<size_t>(fileSize.QuadPart);
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr)
+		{
+			CUBBYFLOW_ERROR << "Failed to map checkpoint file " << fileName;
+			Unmap();
+			return;
+		}
+		m_mappingHandle = mapping;
+
+		m_data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+		m_fileDescriptor = open(fileName.c_str(), O_RDONLY);
+		if (m_fileDescriptor < 0)
+		{
+			CUBBYFLOW_ERROR << "Failed to open checkpoint file " << fileName;
+			return;
+		}
+
+		struct stat fileStat;
+		if (fstat(m_fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+		{
+			CUBBYFLOW_ERROR << "Invalid checkpoint file " << fileName;
+			Unmap();
+			return;
+		}
+		m_size = static_cast<size_t>(fileStat.st_size);
+
+		void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fileDescriptor, 0);
+		if (data != MAP_FAILED)
+		{
+			m_data = static_cast<const uint8_t*>(data);
+		}
+#endif
+
+		if (m_data == nullptr)
+		{
+			CUBBYFLOW_ERROR << "Failed to map checkpoint file " << fileName;
+			Unmap();
+			return;
+		}
+
+		ParseChunkTable();
+	}
+
+	CheckpointReader::~CheckpointReader()
+	{
+		Unmap();
+	}
+
+	bool CheckpointReader::IsOpen() const
+	{
+		return m_data != nullptr;
+	}
+
+	bool CheckpointReader::HasChunk(const std::string& name) const
+	{
+		return m_chunks.find(name) != m_chunks.end();
+	}
+
+	size_t CheckpointReader::ChunkSize(const std::string& name) const
+	{
+		return static_cast<size_t>(FindChunk(name).size);
+	}
+
+	const uint8_t* CheckpointReader::ChunkData(const std::string& name) const
+	{
+		return m_data + FindChunk(name).offset;
+	}
+
+	std::string CheckpointReader::ReadString(const std::string& name) const
+	{
+		const Chunk& chunk = FindChunk(name);
+		return std::string(reinterpret_cast<const char*>(m_data + chunk.offset), static_cast<size_t>(chunk.size));
+	}
+
+	const CheckpointReader::Chunk& CheckpointReader::FindChunk(const std::string& name) const
+	{
+		auto iter = m_chunks.find(name);
+		if (iter == m_chunks.end())
+		{
+			throw std::runtime_error("Checkpoint chunk " + name + " is missing.");
+		}
+
+		return iter->second;
+	}
+
+	void CheckpointReader::CheckChunkSize(const std::string& name, size_t expectedSize) const
+	{
+		if (FindChunk(name).size != expectedSize)
+		{
+			throw std::runtime_error("Checkpoint chunk " + name + " has unexpected size.");
+		}
+	}
+
+	void CheckpointReader::ParseChunkTable()
+	{
+		if (m_size < sizeof(HEADER_MAGIC) + FOOTER_SIZE ||
+			memcmp(m_data, HEADER_MAGIC, sizeof(HEADER_MAGIC)) != 0 ||
+			memcmp(m_data + m_size - sizeof(FOOTER_MAGIC), FOOTER_MAGIC, sizeof(FOOTER_MAGIC)) != 0)
+		{
+			CUBBYFLOW_ERROR << "Invalid checkpoint file";
+			Unmap();
+			return;
+		}
+
+		uint64_t tableOffset, numberOfChunks;
+		memcpy(&tableOffset, m_data + m_size - FOOTER_SIZE, sizeof(tableOffset));
+		memcpy(&numberOfChunks, m_data + m_size - FOOTER_SIZE + sizeof(tableOffset), sizeof(numberOfChunks));
+
+		const size_t tableEnd = m_size - FOOTER_SIZE;
+		size_t cursor = static_cast<size_t>(tableOffset);
+
+		for (uint64_t i = 0; i < numberOfChunks; ++i)
+		{
+			uint64_t nameLength;
+			Chunk chunk;
+
+			if (cursor + sizeof(nameLength) > tableEnd)
+			{
+				break;
+			}
+			memcpy(&nameLength, m_data + cursor, sizeof(nameLength));
+			cursor += sizeof(nameLength);
+
+			if (cursor + nameLength + sizeof(chunk.offset) + sizeof(chunk.size) > tableEnd)
+			{
+				break;
+			}
+			std::string name(reinterpret_cast<const char*>(m_data + cursor), static_cast<size_t>(nameLength));
+			cursor += static_cast<size_t>(nameLength);
+
+			memcpy(&chunk.offset, m_data + cursor, sizeof(chunk.offset));
+			cursor += sizeof(chunk.offset);
+			memcpy(&chunk.size, m_data + cursor, sizeof(chunk.size));
+			cursor += sizeof(chunk.size);
+
+			if (chunk.offset + chunk.size > tableOffset)
+			{
+				break;
+			}
+
+			m_chunks[name] = chunk;
+		}
+
+		if (m_chunks.size() != numberOfChunks)
+		{
+			CUBBYFLOW_ERROR << "Corrupted checkpoint chunk table";
+			m_chunks.clear();
+			Unmap();
+		}
+	}
+
+	void CheckpointReader::Unmap()
+	{
+#ifdef _WIN32
+		if (m_data != nullptr)
+		{
+			UnmapViewOfFile(m_data);
+		}
+
+		if (m_mappingHandle != nullptr)
+		{
+			CloseHandle(m_mappingHandle);
+			m_mappingHandle = nullptr;
+		}
+
+		if (m_fileHandle != nullptr)
+		{
+			CloseHandle(m_fileHandle);
+			m_fileHandle = nullptr;
+		}
+#else
+		if (m_data != nullptr)
+		{
+			munmap(const_cast<uint8_t*>(m_data), m_size);
+		}
+
+		if (m_fileDescriptor >= 0)
+		{
+			close(m_fileDescriptor);
+			m_fileDescriptor = -1;
+		}
+#endif
+
+		m_data = nullptr;
+		m_size = 0;
+	}
+}
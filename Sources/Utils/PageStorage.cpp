@@ -0,0 +1,243 @@
+/*************************************************************************
+> File Name: PageStorage.cpp
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Memory pages committed on demand within a reserved address range.
+> Created Time: 2017/10/27
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#include <Utils/PageStorage.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <winioctl.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <stdexcept>
+
+namespace CubbyFlow
+{
+	// Mapping offsets must be multiples of the allocation granularity, which
+	// is 64 KiB on Windows and the page size (at most 64 KiB) elsewhere.
+	static const size_t MAPPING_GRANULARITY = 64 * 1024;
+
+	PageStorage::PageStorage(size_t reservedSizeInBytes, const std::string& backingDirectory) :
+		m_backingDirectory(backingDirectory)
+	{
+		m_reservedSize = (reservedSizeInBytes + MAPPING_GRANULARITY - 1) / MAPPING_GRANULARITY * MAPPING_GRANULARITY;
+		if (m_reservedSize == 0)
+		{
+			return;
+		}
+
+#ifdef _WIN32
+		if (!IsFileBacked())
+		{
+			m_data = static_cast<char*>(VirtualAlloc(nullptr, m_reservedSize, MEM_RESERVE, PAGE_NOACCESS));
+			if (m_data == nullptr)
+			{
+				throw std::runtime_error("Failed to reserve address space for pages.");
+			}
+
+			return;
+		}
+
+		char fileName[MAX_PATH];
+		if (GetTempFileNameA(m_backingDirectory.c_str(), "CFP", 0, fileName) == 0)
+		{
+			throw std::runtime_error("Failed to create page file in " + m_backingDirectory + ".");
+		}
+
+		HANDLE file = CreateFileA(
+			fileName, GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+			FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			DeleteFileA(fileName);
+			throw std::runtime_error("Failed to open page file " + std::string(fileName) + ".");
+		}
+		m_fileHandle = file;
+
+		// A view cannot grow in place, so the whole range is mapped at once.
+		// The file is sparse, so only the touched pages take disk space.
+		DWORD bytesReturned = 0;
+		DeviceIoControl(file, FSCTL_SET_SPARSE, nullptr, 0, nullptr, 0, &bytesReturned, nullptr);
+
+		const uint64_t fileSize = m_reservedSize;
+		HANDLE mapping = CreateFileMappingA(
+			file, nullptr, PAGE_READWRITE,
+			static_cast<DWORD>(fileSize >> 32), static_cast<DWORD>(fileSize & 0xffffffff), nullptr);
+		if (mapping != nullptr)
+		{
+			m_data = static_cast<char*>(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, m_reservedSize));
+
+			// The view keeps the mapping alive
+			CloseHandle(mapping);
+		}
+#else
+		void* data = mmap(nullptr, m_reservedSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		if (data == MAP_FAILED)
+		{
+			throw std::runtime_error("Failed to reserve address space for pages.");
+		}
+		m_data = static_cast<char*>(data);
+
+		if (!IsFileBacked())
+		{
+			return;
+		}
+
+		std::string fileName = m_backingDirectory + "/CubbyFlowPages.XXXXXX";
+		m_fileDescriptor = mkstemp(&fileName[0]);
+		if (m_fileDescriptor < 0)
+		{
+			Release();
+			throw std::runtime_error("Failed to create page file in " + m_backingDirectory + ".");
+		}
+
+		// The open descriptor keeps the data alive, and the file disappears
+		// once it is closed.
+		unlink(fileName.c_str());
+#endif
+
+		if (m_data == nullptr)
+		{
+			Release();
+			throw std::runtime_error("Failed to map page file in " + m_backingDirectory + ".");
+		}
+	}
+
+	PageStorage::~PageStorage()
+	{
+		Release();
+	}
+
+	size_t PageStorage::PageSize() const
+	{
+		return MAPPING_GRANULARITY;
+	}
+
+	size_t PageStorage::NumberOfPages() const
+	{
+		return m_committedSize / MAPPING_GRANULARITY;
+	}
+
+	size_t PageStorage::ReservedSize() const
+	{
+		return m_reservedSize;
+	}
+
+	size_t PageStorage::CommittedSize() const
+	{
+		return m_committedSize;
+	}
+
+	bool PageStorage::IsFileBacked() const
+	{
+		return !m_backingDirectory.empty();
+	}
+
+	const std::string& PageStorage::BackingDirectory() const
+	{
+		return m_backingDirectory;
+	}
+
+	void* PageStorage::Data() const
+	{
+		return m_data;
+	}
+
+	void PageStorage::Commit(size_t sizeInBytes)
+	{
+		if (sizeInBytes <= m_committedSize)
+		{
+			return;
+		}
+
+		if (sizeInBytes > m_reservedSize)
+		{
+			throw std::length_error("Page storage cannot grow beyond its reserved size.");
+		}
+
+		const size_t committedSize = (sizeInBytes + MAPPING_GRANULARITY - 1) / MAPPING_GRANULARITY * MAPPING_GRANULARITY;
+		char* begin = m_data + m_committedSize;
+		const size_t size = committedSize - m_committedSize;
+		bool isCommitted = false;
+
+#ifdef _WIN32
+		if (!IsFileBacked())
+		{
+			isCommitted = VirtualAlloc(begin, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+		}
+		else
+		{
+			// The whole file is already mapped
+			isCommitted = true;
+		}
+#else
+		if (!IsFileBacked())
+		{
+			isCommitted = mprotect(begin, size, PROT_READ | PROT_WRITE) == 0;
+		}
+		else if (ftruncate(m_fileDescriptor, static_cast<off_t>(committedSize)) == 0)
+		{
+			void* page = mmap(
+				begin, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED,
+				m_fileDescriptor, static_cast<off_t>(m_committedSize));
+			isCommitted = (page == begin);
+		}
+#endif
+
+		if (!isCommitted)
+		{
+			throw std::runtime_error(IsFileBacked() ? "Failed to map page file in " + m_backingDirectory + "." : std::string("Failed to commit pages."));
+		}
+
+		m_committedSize = committedSize;
+	}
+
+	void PageStorage::Release()
+	{
+		if (m_data != nullptr)
+		{
+#ifdef _WIN32
+			if (!IsFileBacked())
+			{
+				VirtualFree(m_data, 0, MEM_RELEASE);
+			}
+			else
+			{
+				UnmapViewOfFile(m_data);
+			}
+#else
+			munmap(m_data, m_reservedSize);
+#endif
+		}
+
+		m_data = nullptr;
+		m_committedSize = 0;
+
+#ifdef _WIN32
+		if (m_fileHandle != nullptr)
+		{
+			CloseHandle(m_fileHandle);
+			m_fileHandle = nullptr;
+		}
+#else
+		if (m_fileDescriptor >= 0)
+		{
+			close(m_fileDescriptor);
+			m_fileDescriptor = -1;
+		}
+#endif
+	}
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+/*************************************************************************
+> File Name: Parallel.cpp
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Parallel functions for CubbyFlow.
+> Created Time: 2017/02/05
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#include <Utils/Parallel.h>
+
+#include <atomic>
+#include <thread>
+
+namespace CubbyFlow
+{
+	static unsigned int DefaultNumberOfThreads()
+	{
+		const unsigned int numThreadsHint = std::thread::hardware_concurrency();
+		return (numThreadsHint == 0u) ? 8u : numThreadsHint;
+	}
+
+	static std::atomic<unsigned int> s_maxNumberOfThreads(DefaultNumberOfThreads());
+	static thread_local unsigned int s_maxNumberOfThreadsForCurrentThread = 0u;
+
+	void SetMaxNumberOfThreads(unsigned int numThreads)
+	{
+		s_maxNumberOfThreads = (numThreads == 0u) ? DefaultNumberOfThreads() : numThreads;
+	}
+
+	unsigned int GetMaxNumberOfThreads()
+	{
+		return (s_maxNumberOfThreadsForCurrentThread == 0u) ? s_maxNumberOfThreads.load() : s_maxNumberOfThreadsForCurrentThread;
+	}
+
+	void SetMaxNumberOfThreadsForCurrentThread(unsigned int numThreads)
+	{
+		s_maxNumberOfThreadsForCurrentThread = numThreads;
+	}
+
+	unsigned int GetMaxNumberOfThreadsForCurrentThread()
+	{
+		return s_maxNumberOfThreadsForCurrentThread;
+	}
+}
@@ -0,0 +1,629 @@
+/*************************************************************************
+> File Name: ParticleCache.cpp
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Compressed multi-frame particle position cache.
+> Created Time: 2017/10/28
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#include <Math/MathUtils.h>
+#include <Utils/Logger.h>
+#include <Utils/Parallel.h>
+#include <Utils/ParticleCache.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace CubbyFlow
+{
+	// File layout:
+	//   [header magic][version][bits][key frame interval][block size][bounds]
+	//   [frame 0][frame 1]...
+	//   [frame table: (offset, size, number of particles) * N]
+	//   [table offset][number of frames][footer magic]
+	//
+	// Frame layout:
+	//   [number of blocks][block sizes in bytes][block 0][block 1]...
+	//
+	// Block layout, for each of x, y, and z:
+	//   [predictor][channel size in bytes][zigzag varint residuals]
+	static const char HEADER_MAGIC[8] = { 'C', 'F', 'P', 'C', 'A', 'C', 'H', 'E' };
+	static const char FOOTER_MAGIC[8] = { 'C', 'F', 'P', 'C', 'E', 'N', 'D', '0' };
+	static const uint32_t VERSION = 1;
+	static const size_t HEADER_SIZE = sizeof(HEADER_MAGIC) + 4 * sizeof(uint32_t) + 6 * sizeof(double);
+	static const size_t FOOTER_SIZE = 2 * sizeof(uint64_t) + sizeof(FOOTER_MAGIC);
+	static const size_t NO_FRAME = std::numeric_limits<size_t>::max();
+
+	enum Predictor : uint8_t
+	{
+		// Difference from the previous particle in the same frame
+		PREDICT_SPATIAL = 0,
+
+		// Difference from the same particle in the previous frame
+		PREDICT_TEMPORAL = 1,
+
+		// Difference from the linear extrapolation of the last two frames
+		PREDICT_LINEAR = 2
+	};
+
+	static const int NUMBER_OF_PREDICTORS = 3;
+
+	static uint64_t ZigZag(int64_t value)
+	{
+		return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+	}
+
+	static int64_t UnZigZag(uint64_t value)
+	{
+		return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+	}
+
+	static size_t VarIntSize(uint64_t value)
+	{
+		size_t size = 1;
+		while (value >= 0x80)
+		{
+			value >>= 7;
+			++size;
+		}
+
+		return size;
+	}
+
+	static void AppendVarInt(uint64_t value, std::vector<uint8_t>* buffer)
+	{
+		while (value >= 0x80)
+		{
+			buffer->push_back(static_cast<uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+
+		buffer->push_back(static_cast<uint8_t>(value));
+	}
+
+	static bool ReadVarInt(const uint8_t** cursor, const uint8_t* end, uint64_t* value)
+	{
+		*value = 0;
+
+		for (unsigned int shift = 0; shift < 64 && *cursor < end; shift += 7)
+		{
+			const uint8_t byte = *(*cursor)++;
+			*value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+
+			if ((byte & 0x80) == 0)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	template <typename T>
+	static void AppendValue(const T& value, std::vector<uint8_t>* buffer)
+	{
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+		buffer->insert(buffer->end(), bytes, bytes + sizeof(T));
+	}
+
+	template <typename T>
+	static bool ReadValue(const uint8_t** cursor, const uint8_t* end, T* value)
+	{
+		if (static_cast<size_t>(end - *cursor) < sizeof(T))
+		{
+			return false;
+		}
+
+		std::memcpy(value, *cursor, sizeof(T));
+		*cursor += sizeof(T);
+
+		return true;
+	}
+
+	// Returns the prediction of the c-th component of the particle i in the
+	// block. Predictors that lack history fall back to the simpler ones.
+	static int64_t Predict(
+		Predictor predictor, size_t i, size_t c, size_t blockBegin,
+		const uint32_t* current, const std::vector<uint32_t>& previous, const std::vector<uint32_t>& previous2)
+	{
+		const size_t idx = 3 * i + c;
+
+		if (predictor == PREDICT_LINEAR && idx < previous2.size() && idx < previous.size())
+		{
+			return 2 * static_cast<int64_t>(previous[idx]) - static_cast<int64_t>(previous2[idx]);
+		}
+
+		if (predictor != PREDICT_SPATIAL && idx < previous.size())
+		{
+			return previous[idx];
+		}
+
+		return (i > blockBegin) ? current[idx - 3] : 0;
+	}
+
+	ParticleCacheWriter::ParticleCacheWriter(
+		const std::string& fileName,
+		const BoundingBox3D& bounds,
+		unsigned int bitsPerComponent,
+		unsigned int keyFrameInterval) :
+		m_file(fileName, std::ios::binary | std::ios::trunc),
+		m_bounds(bounds),
+		m_bitsPerComponent(bitsPerComponent),
+		m_keyFrameInterval(std::max(keyFrameInterval, 1u))
+	{
+		if (bitsPerComponent < 1 || bitsPerComponent > 31)
+		{
+			throw std::invalid_argument("bitsPerComponent must be between 1 and 31.");
+		}
+
+		if (!m_file)
+		{
+			CUBBYFLOW_ERROR << "Failed to open particle cache file " << fileName;
+			return;
+		}
+
+		const uint32_t header[4] = { VERSION, m_bitsPerComponent, m_keyFrameInterval, static_cast<uint32_t>(BLOCK_SIZE) };
+		const double box[6] = {
+			bounds.lowerCorner.x, bounds.lowerCorner.y, bounds.lowerCorner.z,
+			bounds.upperCorner.x, bounds.upperCorner.y, bounds.upperCorner.z };
+
+		m_file.write(HEADER_MAGIC, sizeof(HEADER_MAGIC));
+		m_file.write(reinterpret_cast<const char*>(header), sizeof(header));
+		m_file.write(reinterpret_cast<const char*>(box), sizeof(box));
+		m_offset = HEADER_SIZE;
+	}
+
+	ParticleCacheWriter::~ParticleCacheWriter()
+	{
+		Close();
+	}
+
+	bool ParticleCacheWriter::IsOpen() const
+	{
+		return m_file.is_open() && m_file.good();
+	}
+
+	size_t ParticleCacheWriter::NumberOfFrames() const
+	{
+		return m_frames.size();
+	}
+
+	void ParticleCacheWriter::WriteFrame(const ConstArrayAccessor1<Vector3D>& positions)
+	{
+		if (!m_file.is_open())
+		{
+			return;
+		}
+
+		const size_t numberOfParticles = positions.size();
+		const size_t numberOfBlocks = (numberOfParticles + BLOCK_SIZE - 1) / BLOCK_SIZE;
+		const double maxLevel = static_cast<double>((1u << m_bitsPerComponent) - 1);
+		const Vector3D extent = m_bounds.upperCorner - m_bounds.lowerCorner;
+
+		// Key frames must not refer to the previous frames
+		if (m_frames.size() % m_keyFrameInterval == 0)
+		{
+			m_previous.clear();
+			m_previous2.clear();
+		}
+
+		std::vector<uint32_t> quantized(3 * numberOfParticles);
+		ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i)
+		{
+			for (size_t c = 0; c < 3; ++c)
+			{
+				const double t = extent[c] > 0.0 ? (positions[i][c] - m_bounds.lowerCorner[c]) / extent[c] : 0.0;
+				quantized[3 * i + c] = static_cast<uint32_t>(std::round(Clamp(t, 0.0, 1.0) * maxLevel));
+			}
+		});
+
+		std::vector<std::vector<uint8_t>> blocks(numberOfBlocks);
+		ParallelFor(ZERO_SIZE, numberOfBlocks, [&](size_t b)
+		{
+			const size_t begin = b * BLOCK_SIZE;
+			const size_t end = std::min(begin + BLOCK_SIZE, numberOfParticles);
+			std::vector<uint8_t>& block = blocks[b];
+
+			for (size_t c = 0; c < 3; ++c)
+			{
+				// Pick the predictor with the smallest output
+				size_t bestSize = std::numeric_limits<size_t>::max();
+				Predictor bestPredictor = PREDICT_SPATIAL;
+
+				for (int p = 0; p < NUMBER_OF_PREDICTORS; ++p)
+				{
+					const Predictor predictor = static_cast<Predictor>(p);
+					size_t size = 0;
+
+					for (size_t i = begin; i < end; ++i)
+					{
+						const int64_t prediction = Predict(predictor, i, c, begin, quantized.data(), m_previous, m_previous2);
+						size += VarIntSize(ZigZag(static_cast<int64_t>(quantized[3 * i + c]) - prediction));
+					}
+
+					if (size < bestSize)
+					{
+						bestSize = size;
+						bestPredictor = predictor;
+					}
+				}
+
+				block.push_back(bestPredictor);
+				AppendValue(static_cast<uint32_t>(bestSize), &block);
+
+				for (size_t i = begin; i < end; ++i)
+				{
+					const int64_t prediction = Predict(bestPredictor, i, c, begin, quantized.data(), m_previous, m_previous2);
+					AppendVarInt(ZigZag(static_cast<int64_t>(quantized[3 * i + c]) - prediction), &block);
+				}
+			}
+		});
+
+		std::vector<uint8_t> frameHeader;
+		AppendValue(static_cast<uint32_t>(numberOfBlocks), &frameHeader);
+		for (const auto& block : blocks)
+		{
+			AppendValue(static_cast<uint32_t>(block.size()), &frameHeader);
+		}
+
+		FrameEntry entry{ m_offset, frameHeader.size(), numberOfParticles };
+		m_file.write(reinterpret_cast<const char*>(frameHeader.data()), static_cast<std::streamsize>(frameHeader.size()));
+		for (const auto& block : blocks)
+		{
+			m_file.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(block.size()));
+			entry.size += block.size();
+		}
+
+		m_offset += entry.size;
+		m_frames.push_back(entry);
+
+		m_previous2.swap(m_previous);
+		m_previous.swap(quantized);
+	}
+
+	void ParticleCacheWriter::Close()
+	{
+		if (!m_file.is_open())
+		{
+			return;
+		}
+
+		const uint64_t tableOffset = m_offset;
+		const uint64_t numberOfFrames = m_frames.size();
+
+		for (const auto& entry : m_frames)
+		{
+			m_file.write(reinterpret_cast<const char*>(&entry.offset), sizeof(entry.offset));
+			m_file.write(reinterpret_cast<const char*>(&entry.size), sizeof(entry.size));
+			m_file.write(reinterpret_cast<const char*>(&entry.numberOfParticles), sizeof(entry.numberOfParticles));
+		}
+
+		m_file.write(reinterpret_cast<const char*>(&tableOffset), sizeof(tableOffset));
+		m_file.write(reinterpret_cast<const char*>(&numberOfFrames), sizeof(numberOfFrames));
+		m_file.write(FOOTER_MAGIC, sizeof(FOOTER_MAGIC));
+
+		if (!m_file)
+		{
+			CUBBYFLOW_ERROR << "Failed to write particle cache file";
+		}
+
+		m_file.close();
+		m_frames.clear();
+		m_previous.clear();
+		m_previous2.clear();
+	}
+
+	ParticleCacheReader::ParticleCacheReader(const std::string& fileName, size_t maxNumberOfCachedFrames) :
+		m_file(fileName, std::ios::binary), m_decodedFrame(NO_FRAME), m_maxNumberOfCachedFrames(maxNumberOfCachedFrames)
+	{
+		if (!m_file)
+		{
+			CUBBYFLOW_ERROR << "Failed to open particle cache file " << fileName;
+			return;
+		}
+
+		char headerMagic[sizeof(HEADER_MAGIC)];
+		uint32_t header[4];
+		double box[6];
+		m_file.read(headerMagic, sizeof(headerMagic));
+		m_file.read(reinterpret_cast<char*>(header), sizeof(header));
+		m_file.read(reinterpret_cast<char*>(box), sizeof(box));
+
+		if (!m_file || std::memcmp(headerMagic, HEADER_MAGIC, sizeof(HEADER_MAGIC)) != 0 ||
+			header[0] != VERSION || header[1] < 1 || header[1] > 31 || header[3] != ParticleCacheWriter::BLOCK_SIZE)
+		{
+			CUBBYFLOW_ERROR << "Invalid particle cache file " << fileName;
+			m_file.close();
+			return;
+		}
+
+		m_bitsPerComponent = header[1];
+		m_keyFrameInterval = std::max(header[2], 1u);
+		m_bounds = BoundingBox3D(Vector3D(box[0], box[1], box[2]), Vector3D(box[3], box[4], box[5]));
+
+		uint64_t tableOffset = 0, numberOfFrames = 0;
+		char footerMagic[sizeof(FOOTER_MAGIC)];
+		m_file.seekg(-static_cast<std::streamoff>(FOOTER_SIZE), std::ios::end);
+		const uint64_t footerOffset = static_cast<uint64_t>(m_file.tellg());
+		m_file.read(reinterpret_cast<char*>(&tableOffset), sizeof(tableOffset));
+		m_file.read(reinterpret_cast<char*>(&numberOfFrames), sizeof(numberOfFrames));
+		m_file.read(footerMagic, sizeof(footerMagic));
+
+		if (!m_file || std::memcmp(footerMagic, FOOTER_MAGIC, sizeof(FOOTER_MAGIC)) != 0 ||
+			tableOffset + numberOfFrames * sizeof(FrameEntry) != footerOffset)
+		{
+			CUBBYFLOW_ERROR << "Particle cache file " << fileName << " has no valid frame table";
+			m_file.close();
+			return;
+		}
+
+		m_frames.resize(static_cast<size_t>(numberOfFrames));
+		m_file.seekg(static_cast<std::streamoff>(tableOffset));
+		for (auto& entry : m_frames)
+		{
+			m_file.read(reinterpret_cast<char*>(&entry.offset), sizeof(entry.offset));
+			m_file.read(reinterpret_cast<char*>(&entry.size), sizeof(entry.size));
+			m_file.read(reinterpret_cast<char*>(&entry.numberOfParticles), sizeof(entry.numberOfParticles));
+		}
+
+		if (!m_file)
+		{
+			CUBBYFLOW_ERROR << "Particle cache file " << fileName << " has no valid frame table";
+			m_frames.clear();
+			m_file.close();
+		}
+	}
+
+	bool ParticleCacheReader::IsOpen() const
+	{
+		return m_file.is_open();
+	}
+
+	size_t ParticleCacheReader::NumberOfFrames() const
+	{
+		return m_frames.size();
+	}
+
+	size_t ParticleCacheReader::NumberOfParticles(size_t frame) const
+	{
+		return static_cast<size_t>(m_frames[frame].numberOfParticles);
+	}
+
+	const BoundingBox3D& ParticleCacheReader::GetBounds() const
+	{
+		return m_bounds;
+	}
+
+	unsigned int ParticleCacheReader::GetBitsPerComponent() const
+	{
+		return m_bitsPerComponent;
+	}
+
+	unsigned int ParticleCacheReader::GetKeyFrameInterval() const
+	{
+		return m_keyFrameInterval;
+	}
+
+	Vector3D ParticleCacheReader::QuantizationStep() const
+	{
+		return (m_bounds.upperCorner - m_bounds.lowerCorner) / static_cast<double>((1u << m_bitsPerComponent) - 1);
+	}
+
+	size_t ParticleCacheReader::GetMaxNumberOfCachedFrames() const
+	{
+		return m_maxNumberOfCachedFrames;
+	}
+
+	void ParticleCacheReader::ReadFrame(size_t frame, Array1<Vector3D>* positions)
+	{
+		assert(frame < m_frames.size());
+
+		const size_t numberOfParticles = NumberOfParticles(frame);
+
+		if (m_decodedFrame == frame)
+		{
+			Dequantize(m_current, numberOfParticles, positions);
+			return;
+		}
+
+		if (CachedFrame* cachedFrame = FindCachedFrame(frame))
+		{
+			cachedFrame->lastUse = ++m_numberOfUses;
+			Dequantize(cachedFrame->positions, numberOfParticles, positions);
+			return;
+		}
+
+		const size_t keyFrame = frame - frame % m_keyFrameInterval;
+
+		// Continue from the decoded frame if it is on the way
+		size_t start = keyFrame;
+		if (m_decodedFrame != NO_FRAME && m_decodedFrame >= keyFrame && m_decodedFrame < frame)
+		{
+			start = m_decodedFrame + 1;
+		}
+
+		// Or from a later cached frame if the frame before it is cached too,
+		// since the predictors look two frames back
+		for (size_t f = frame - 1; f != NO_FRAME && f >= start; --f)
+		{
+			CachedFrame* last = FindCachedFrame(f);
+			CachedFrame* secondLast = (f > keyFrame) ? FindCachedFrame(f - 1) : nullptr;
+
+			if (last != nullptr && (f == keyFrame || secondLast != nullptr))
+			{
+				m_current = last->positions;
+				if (secondLast != nullptr)
+				{
+					m_previous = secondLast->positions;
+				}
+				else
+				{
+					m_previous.clear();
+				}
+
+				m_decodedFrame = f;
+				start = f + 1;
+				break;
+			}
+		}
+
+		for (size_t f = start; f <= frame; ++f)
+		{
+			DecodeFrame(f);
+			CacheDecodedFrame();
+		}
+
+		Dequantize(m_current, numberOfParticles, positions);
+	}
+
+	ParticleCacheReader::CachedFrame* ParticleCacheReader::FindCachedFrame(size_t frame)
+	{
+		for (auto& cachedFrame : m_cachedFrames)
+		{
+			if (cachedFrame.frame == frame)
+			{
+				return &cachedFrame;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void ParticleCacheReader::CacheDecodedFrame()
+	{
+		if (m_maxNumberOfCachedFrames == 0 || FindCachedFrame(m_decodedFrame) != nullptr)
+		{
+			return;
+		}
+
+		if (m_cachedFrames.size() < m_maxNumberOfCachedFrames)
+		{
+			m_cachedFrames.push_back(CachedFrame{ m_decodedFrame, ++m_numberOfUses, m_current });
+			return;
+		}
+
+		// Replaces the least recently used frame
+		auto leastRecentlyUsed = std::min_element(m_cachedFrames.begin(), m_cachedFrames.end(),
+			[](const CachedFrame& a, const CachedFrame& b)
+		{
+			return a.lastUse < b.lastUse;
+		});
+
+		leastRecentlyUsed->frame = m_decodedFrame;
+		leastRecentlyUsed->lastUse = ++m_numberOfUses;
+		leastRecentlyUsed->positions = m_current;
+	}
+
+	void ParticleCacheReader::Dequantize(const std::vector<uint32_t>& quantized, size_t numberOfParticles, Array1<Vector3D>* positions) const
+	{
+		const Vector3D step = QuantizationStep();
+		positions->Resize(numberOfParticles);
+
+		ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i)
+		{
+			(*positions)[i] = m_bounds.lowerCorner + step * Vector3D(
+				static_cast<double>(quantized[3 * i]),
+				static_cast<double>(quantized[3 * i + 1]),
+				static_cast<double>(quantized[3 * i + 2]));
+		});
+	}
+
+	void ParticleCacheReader::DecodeFrame(size_t frame)
+	{
+		const FrameEntry& entry = m_frames[frame];
+		const size_t numberOfParticles = static_cast<size_t>(entry.numberOfParticles);
+
+		if (frame % m_keyFrameInterval == 0)
+		{
+			m_current.clear();
+			m_previous.clear();
+		}
+
+		m_buffer.resize(static_cast<size_t>(entry.size));
+		m_file.clear();
+		m_file.seekg(static_cast<std::streamoff>(entry.offset));
+		m_file.read(reinterpret_cast<char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+
+		const uint8_t* cursor = m_buffer.data();
+		const uint8_t* end = cursor + m_buffer.size();
+		uint32_t numberOfBlocks = 0;
+
+		if (!m_file || !ReadValue(&cursor, end, &numberOfBlocks) ||
+			numberOfBlocks != (numberOfParticles + ParticleCacheWriter::BLOCK_SIZE - 1) / ParticleCacheWriter::BLOCK_SIZE)
+		{
+			m_decodedFrame = NO_FRAME;
+			throw std::runtime_error("Particle cache frame " + std::to_string(frame) + " is corrupted.");
+		}
+
+		std::vector<const uint8_t*> blockBegins(numberOfBlocks);
+		std::vector<const uint8_t*> blockEnds(numberOfBlocks);
+		const uint8_t* blockData = cursor + numberOfBlocks * sizeof(uint32_t);
+		for (uint32_t b = 0; b < numberOfBlocks; ++b)
+		{
+			uint32_t blockSize = 0;
+			if (!ReadValue(&cursor, end, &blockSize) || blockSize > static_cast<size_t>(end - blockData))
+			{
+				m_decodedFrame = NO_FRAME;
+				throw std::runtime_error("Particle cache frame " + std::to_string(frame) + " is corrupted.");
+			}
+
+			blockBegins[b] = blockData;
+			blockEnds[b] = blockData + blockSize;
+			blockData += blockSize;
+		}
+
+		std::vector<uint32_t> decoded(3 * numberOfParticles);
+		std::vector<char> isValid(numberOfBlocks, 1);
+
+		ParallelFor(ZERO_SIZE, static_cast<size_t>(numberOfBlocks), [&](size_t b)
+		{
+			const size_t begin = b * ParticleCacheWriter::BLOCK_SIZE;
+			const size_t blockEnd = std::min(begin + ParticleCacheWriter::BLOCK_SIZE, numberOfParticles);
+			const uint8_t* blockCursor = blockBegins[b];
+
+			for (size_t c = 0; c < 3; ++c)
+			{
+				uint8_t predictor = 0;
+				uint32_t channelSize = 0;
+
+				if (!ReadValue(&blockCursor, blockEnds[b], &predictor) || predictor >= NUMBER_OF_PREDICTORS ||
+					!ReadValue(&blockCursor, blockEnds[b], &channelSize) || channelSize > static_cast<size_t>(blockEnds[b] - blockCursor))
+				{
+					isValid[b] = 0;
+					return;
+				}
+
+				const uint8_t* channelEnd = blockCursor + channelSize;
+
+				for (size_t i = begin; i < blockEnd; ++i)
+				{
+					uint64_t residual = 0;
+					if (!ReadVarInt(&blockCursor, channelEnd, &residual))
+					{
+						isValid[b] = 0;
+						return;
+					}
+
+					const int64_t prediction = Predict(static_cast<Predictor>(predictor), i, c, begin, decoded.data(), m_current, m_previous);
+					decoded[3 * i + c] = static_cast<uint32_t>(prediction + UnZigZag(residual));
+				}
+
+				blockCursor = channelEnd;
+			}
+		});
+
+		if (std::find(isValid.begin(), isValid.end(), 0) != isValid.end())
+		{
+			m_decodedFrame = NO_FRAME;
+			throw std::runtime_error("Particle cache frame " + std::to_string(frame) + " is corrupted.");
+		}
+
+		m_previous.swap(m_current);
+		m_current.swap(decoded);
+		m_decodedFrame = frame;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+/*************************************************************************
+> File Name: SharedAssetCache.cpp
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Thread-safe cache of immutable assets built once and shared.
+> Created Time: 2017/10/29
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#include <Utils/SharedAssetCache.h>
+
+namespace CubbyFlow
+{
+	bool SharedAssetCache::Contains(const std::string& key) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_assets.find(key) != m_assets.end();
+	}
+
+	size_t SharedAssetCache::NumberOfAssets() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_assets.size();
+	}
+
+	void SharedAssetCache::Clear()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_assets.clear();
+	}
+
+	void SharedAssetCache::Remove(const std::string& key)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_assets.erase(key);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,203 @@
+/*************************************************************************
+> File Name: Vector3Kernels.cpp
+> Project Name: CubbyFlow
+> Author: Chan-Ho Chris Ohk
+> Purpose: Bulk operations on arrays of 3-D vectors.
+> Created Time: 2017/10/31
+> Copyright (c) 2017, Chan-Ho Chris Ohk
+*************************************************************************/
+#include <Vector/Vector3Kernels.h>
+
+#include <cassert>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CUBBYFLOW_VECTOR3_KERNELS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace CubbyFlow
+{
+	static_assert(sizeof(Vector3D) == 3 * sizeof(double), "Vector3D must be three packed doubles.");
+
+#ifdef CUBBYFLOW_VECTOR3_KERNELS_SSE2
+	namespace
+	{
+		// Two consecutive vectors (x0, y0, z0, x1, y1, z1) as the pairs of
+		// their components.
+		struct VectorPair
+		{
+			__m128d x, y, z;
+		};
+
+		inline VectorPair LoadPair(const Vector3D* v)
+		{
+			const double* p = reinterpret_cast<const double*>(v);
+			const __m128d a = _mm_loadu_pd(p);
+			const __m128d b = _mm_loadu_pd(p + 2);
+			const __m128d c = _mm_loadu_pd(p + 4);
+
+			return VectorPair{ _mm_shuffle_pd(a, b, 2), _mm_shuffle_pd(a, c, 1), _mm_shuffle_pd(b, c, 2) };
+		}
+
+		inline void StorePair(const VectorPair& v, Vector3D* result)
+		{
+			double* p = reinterpret_cast<double*>(result);
+			_mm_storeu_pd(p, _mm_shuffle_pd(v.x, v.y, 0));
+			_mm_storeu_pd(p + 2, _mm_shuffle_pd(v.z, v.x, 2));
+			_mm_storeu_pd(p + 4, _mm_shuffle_pd(v.y, v.z, 3));
+		}
+	}
+#endif
+
+	void Vector3Kernels::AXPlusY(
+		double a,
+		const ConstArrayAccessor1<Vector3D>& x,
+		const ConstArrayAccessor1<Vector3D>& y,
+		ArrayAccessor1<Vector3D>* result)
+	{
+		assert(x.size() == y.size() && x.size() == result->size());
+
+		// The components are independent, so the arrays are processed as
+		// flat arrays of doubles
+		const size_t n = 3 * x.size();
+		const double* xs = reinterpret_cast<const double*>(x.data());
+		const double* ys = reinterpret_cast<const double*>(y.data());
+		double* rs = reinterpret_cast<double*>(result->data());
+		size_t i = 0;
+
+#ifdef CUBBYFLOW_VECTOR3_KERNELS_SSE2
+		const __m128d as = _mm_set1_pd(a);
+
+		for (; i + 2 <= n; i += 2)
+		{
+			_mm_storeu_pd(rs + i, _mm_add_pd(_mm_mul_pd(as, _mm_loadu_pd(xs + i)), _mm_loadu_pd(ys + i)));
+		}
+#endif
+
+		for (; i < n; ++i)
+		{
+			rs[i] = a * xs[i] + ys[i];
+		}
+	}
+
+	void Vector3Kernels::AXOverBPlusY(
+		double a,
+		double b,
+		const ConstArrayAccessor1<Vector3D>& x,
+		const ConstArrayAccessor1<Vector3D>& y,
+		ArrayAccessor1<Vector3D>* result)
+	{
+		assert(x.size() == y.size() && x.size() == result->size());
+
+		const size_t n = 3 * x.size();
+		const double* xs = reinterpret_cast<const double*>(x.data());
+		const double* ys = reinterpret_cast<const double*>(y.data());
+		double* rs = reinterpret_cast<double*>(result->data());
+		size_t i = 0;
+
+#ifdef CUBBYFLOW_VECTOR3_KERNELS_SSE2
+		const __m128d as = _mm_set1_pd(a);
+		const __m128d bs = _mm_set1_pd(b);
+
+		for (; i + 2 <= n; i += 2)
+		{
+			_mm_storeu_pd(rs + i, _mm_add_pd(_mm_div_pd(_mm_mul_pd(as, _mm_loadu_pd(xs + i)), bs), _mm_loadu_pd(ys + i)));
+		}
+#endif
+
+		for (; i < n; ++i)
+		{
+			rs[i] = a * xs[i] / b + ys[i];
+		}
+	}
+
+	void Vector3Kernels::Transform(
+		const Matrix3x3D& m,
+		const Vector3D& preOffset,
+		const Vector3D& postOffset,
+		const ConstArrayAccessor1<Vector3D>& points,
+		ArrayAccessor1<Vector3D>* result)
+	{
+		assert(points.size() == result->size());
+
+		const size_t n = points.size();
+		size_t i = 0;
+
+#ifdef CUBBYFLOW_VECTOR3_KERNELS_SSE2
+		__m128d ms[9];
+		for (size_t e = 0; e < 9; ++e)
+		{
+			ms[e] = _mm_set1_pd(m(e / 3, e % 3));
+		}
+
+		const __m128d preX = _mm_set1_pd(preOffset.x), preY = _mm_set1_pd(preOffset.y), preZ = _mm_set1_pd(preOffset.z);
+		const __m128d postX = _mm_set1_pd(postOffset.x), postY = _mm_set1_pd(postOffset.y), postZ = _mm_set1_pd(postOffset.z);
+
+		for (; i + 2 <= n; i += 2)
+		{
+			const VectorPair p = LoadPair(points.data() + i);
+			const __m128d x = _mm_add_pd(p.x, preX);
+			const __m128d y = _mm_add_pd(p.y, preY);
+			const __m128d z = _mm_add_pd(p.z, preZ);
+
+			// Same order of operations as Matrix3x3D::Mul
+			const auto row = [&](size_t r)
+			{
+				return _mm_add_pd(_mm_add_pd(_mm_mul_pd(x, ms[3 * r]), _mm_mul_pd(y, ms[3 * r + 1])), _mm_mul_pd(z, ms[3 * r + 2]));
+			};
+
+			StorePair(VectorPair{ _mm_add_pd(row(0), postX), _mm_add_pd(row(1), postY), _mm_add_pd(row(2), postZ) }, result->data() + i);
+		}
+#endif
+
+		for (; i < n; ++i)
+		{
+			(*result)[i] = m * (points[i] + preOffset) + postOffset;
+		}
+	}
+
+	void Vector3Kernels::Length(const ConstArrayAccessor1<Vector3D>& v, ArrayAccessor1<double>* result)
+	{
+		assert(v.size() == result->size());
+
+		const size_t n = v.size();
+		size_t i = 0;
+
+#ifdef CUBBYFLOW_VECTOR3_KERNELS_SSE2
+		for (; i + 2 <= n; i += 2)
+		{
+			const VectorPair p = LoadPair(v.data() + i);
+			const __m128d lengthSquared = _mm_add_pd(_mm_add_pd(_mm_mul_pd(p.x, p.x), _mm_mul_pd(p.y, p.y)), _mm_mul_pd(p.z, p.z));
+
+			_mm_storeu_pd(result->data() + i, _mm_sqrt_pd(lengthSquared));
+		}
+#endif
+
+		for (; i < n; ++i)
+		{
+			(*result)[i] = v[i].Length();
+		}
+	}
+
+	void Vector3Kernels::Normalize(ArrayAccessor1<Vector3D>* v)
+	{
+		const size_t n = v->size();
+		size_t i = 0;
+
+#ifdef CUBBYFLOW_VECTOR3_KERNELS_SSE2
+		for (; i + 2 <= n; i += 2)
+		{
+			const VectorPair p = LoadPair(v->data() + i);
+			const __m128d length = _mm_sqrt_pd(
+				_mm_add_pd(_mm_add_pd(_mm_mul_pd(p.x, p.x), _mm_mul_pd(p.y, p.y)), _mm_mul_pd(p.z, p.z)));
+
+			StorePair(VectorPair{ _mm_div_pd(p.x, length), _mm_div_pd(p.y, length), _mm_div_pd(p.z, length) }, v->data() + i);
+		}
+#endif
+
+		for (; i < n; ++i)
+		{
+			(*v)[i].Normalize();
+		}
+	}
+}
\ No newline at end of file
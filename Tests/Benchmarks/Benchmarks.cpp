@@ -0,0 +1,49 @@
+#include <Utils/Logger.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Emits machine-readable JSON for trend tracking unless the caller specifies
+// its own --benchmark_out.
+int main(int argc, char** argv)
+{
+	std::vector<char*> args(argv, argv + argc);
+
+	bool hasOutput = false;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strncmp(argv[i], "--benchmark_out=", 16) == 0)
+		{
+			hasOutput = true;
+		}
+	}
+
+	std::string outArg = "--benchmark_out=benchmarks.json";
+	std::string formatArg = "--benchmark_out_format=json";
+	if (!hasOutput)
+	{
+		args.push_back(&outArg[0]);
+		args.push_back(&formatArg[0]);
+	}
+
+	std::ofstream logFile("benchmarks.log");
+	if (logFile)
+	{
+		CubbyFlow::Logging::SetAllStream(&logFile);
+	}
+
+	int numArgs = static_cast<int>(args.size());
+	benchmark::Initialize(&numArgs, args.data());
+	if (benchmark::ReportUnrecognizedArguments(numArgs, args.data()))
+	{
+		return 1;
+	}
+
+	benchmark::RunSpecifiedBenchmarks();
+
+	return 0;
+}
@@ -0,0 +1,87 @@
+#include "BenchmarksUtils.h"
+
+#include <Array/Array3.h>
+#include <MarchingCubes/MarchingCubes.h>
+#include <Utils/Parallel.h>
+
+#include <random>
+#include <thread>
+
+namespace CubbyFlow
+{
+	void ApplySizesAndThreads(benchmark::internal::Benchmark* b, std::initializer_list<int64_t> sizes)
+	{
+		const unsigned int numThreadsHint = std::thread::hardware_concurrency();
+		const int64_t maxNumThreads = (numThreadsHint == 0u) ? 8 : numThreadsHint;
+
+		b->ArgNames({ "size", "threads" });
+
+		for (int64_t size : sizes)
+		{
+			int64_t numThreads = 1;
+			for (; numThreads < maxNumThreads; numThreads *= 2)
+			{
+				b->Args({ size, numThreads });
+			}
+
+			b->Args({ size, maxNumThreads });
+		}
+	}
+
+	ScopedThreadCount::ScopedThreadCount(const benchmark::State& state, int argIndex)
+	{
+		SetMaxNumberOfThreads(static_cast<unsigned int>(state.range(argIndex)));
+	}
+
+	ScopedThreadCount::~ScopedThreadCount()
+	{
+		SetMaxNumberOfThreads(0);
+	}
+
+	void GenerateRandomPoints(size_t n, Array1<Vector3D>* points, unsigned int seed)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<> d(0.0, 1.0);
+
+		points->Resize(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			(*points)[i] = Vector3D(d(rng), d(rng), d(rng));
+		}
+	}
+
+	void BuildPoissonSystem(size_t n, FDMLinearSystem3* system)
+	{
+		system->A.Resize(n, n, n);
+		system->x.Resize(n, n, n, 0.0);
+		system->b.Resize(n, n, n, 0.0);
+
+		system->A.ParallelForEachIndex([&](size_t i, size_t j, size_t k)
+		{
+			FDMMatrixRow3& row = system->A(i, j, k);
+			row.center = 6.0;
+			row.right = (i + 1 < n) ? -1.0 : 0.0;
+			row.up = (j + 1 < n) ? -1.0 : 0.0;
+			row.front = (k + 1 < n) ? -1.0 : 0.0;
+
+			// Point source at the center of the domain
+			if (i == n / 2 && j == n / 2 && k == n / 2)
+			{
+				system->b(i, j, k) = 1.0;
+			}
+		});
+	}
+
+	void BuildSphereMesh(size_t n, TriangleMesh3* mesh)
+	{
+		const double h = 1.0 / static_cast<double>(n - 1);
+		Array3<double> sdf(n, n, n);
+		sdf.ParallelForEachIndex([&](size_t i, size_t j, size_t k)
+		{
+			const Vector3D pt(i * h, j * h, k * h);
+			sdf(i, j, k) = pt.DistanceTo(Vector3D(0.5, 0.5, 0.5)) - 0.3;
+		});
+
+		MarchingCubes(sdf.ConstAccessor(), Vector3D(h, h, h), Vector3D(), mesh, 0.0, DIRECTION_ALL);
+	}
+}
@@ -0,0 +1,55 @@
+#ifndef BENCHMARKS_UTILS_H
+#define BENCHMARKS_UTILS_H
+
+#include <Array/Array1.h>
+#include <FDM/FDMLinearSystem3.h>
+#include <Geometry/TriangleMesh3.h>
+#include <Vector/Vector3.h>
+
+#include <benchmark/benchmark.h>
+
+//!
+//! Registers the cartesian product of \p sizes and the thread counts 1, 2, 4,
+//! ... up to the number of hardware threads. The first benchmark argument is
+//! the problem size and the second one is the number of threads.
+//!
+#define CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(...) \
+	Apply([](benchmark::internal::Benchmark* b) \
+	{ \
+		CubbyFlow::ApplySizesAndThreads(b, { __VA_ARGS__ }); \
+	})
+
+namespace CubbyFlow
+{
+	//! Registers size x thread-count argument pairs to the benchmark \p b.
+	void ApplySizesAndThreads(benchmark::internal::Benchmark* b, std::initializer_list<int64_t> sizes);
+
+	//!
+	//! \brief Scoped override of the maximum number of threads.
+	//!
+	//! Sets the maximum number of threads used by ParallelFor and friends from
+	//! the second benchmark argument and restores the default on destruction.
+	//!
+	class ScopedThreadCount final
+	{
+	public:
+		explicit ScopedThreadCount(const benchmark::State& state, int argIndex = 1);
+
+		~ScopedThreadCount();
+
+		ScopedThreadCount(const ScopedThreadCount&) = delete;
+
+		ScopedThreadCount& operator=(const ScopedThreadCount&) = delete;
+	};
+
+	//! Fills \p points with \p n uniformly distributed points in [0, 1]^3.
+	void GenerateRandomPoints(size_t n, Array1<Vector3D>* points, unsigned int seed = 0);
+
+	//! Builds a 7-point Poisson system with Dirichlet boundary on a cube.
+	void BuildPoissonSystem(size_t n, FDMLinearSystem3* system);
+
+	//! Builds a triangulated unit sphere by marching a sphere SDF at \p n^3.
+	void BuildSphereMesh(size_t n, TriangleMesh3* mesh);
+}
+
+#endif
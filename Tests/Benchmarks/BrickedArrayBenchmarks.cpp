@@ -0,0 +1,141 @@
+#include "BenchmarksUtils.h"
+
+#include <Array/Array3.h>
+#include <Array/ArraySamplers3.h>
+#include <Array/BrickedArraySamplers3.h>
+
+using namespace CubbyFlow;
+
+namespace
+{
+	const size_t NUM_SAMPLES = 1 << 20;
+
+	double InitialValue(size_t i, size_t j, size_t k)
+	{
+		return std::sin(0.1 * i) + std::cos(0.2 * j) + 0.01 * k;
+	}
+
+	// Samples the points displaced from the grid points by a small rotation,
+	// visited in tiles like the back-traced points of the semi-Lagrangian
+	// advection.
+	template <typename Sampler>
+	void RunLocalSampling(benchmark::State& state, const Sampler& sampler, size_t n)
+	{
+		const double h = 1.0 / static_cast<double>(n);
+
+		for (auto _ : state)
+		{
+			double sum = 0.0;
+
+			for (size_t kBegin = 0; kBegin < n; kBegin += 8)
+			{
+				for (size_t jBegin = 0; jBegin < n; jBegin += 8)
+				{
+					for (size_t k = kBegin; k < kBegin + 8; ++k)
+					{
+						for (size_t j = jBegin; j < jBegin + 8; ++j)
+						{
+							for (size_t i = 0; i < n; ++i)
+							{
+								const Vector3D pt = h * Vector3D(static_cast<double>(i), static_cast<double>(j), static_cast<double>(k));
+								sum += sampler(pt + 0.05 * Vector3D(0.5 - pt.y, pt.x - 0.5, 0.5 - pt.x));
+							}
+						}
+					}
+				}
+			}
+
+			benchmark::DoNotOptimize(sum);
+		}
+
+		state.SetItemsProcessed(state.iterations() * n * n * n);
+	}
+
+	template <typename Sampler>
+	void RunRandomSampling(benchmark::State& state, const Sampler& sampler)
+	{
+		Array1<Vector3D> points;
+		GenerateRandomPoints(NUM_SAMPLES, &points);
+
+		for (auto _ : state)
+		{
+			double sum = 0.0;
+
+			for (size_t i = 0; i < points.size(); ++i)
+			{
+				sum += sampler(points[i]);
+			}
+
+			benchmark::DoNotOptimize(sum);
+		}
+
+		state.SetItemsProcessed(state.iterations() * NUM_SAMPLES);
+	}
+
+	Array3<double> CreateArray(size_t n)
+	{
+		Array3<double> array(n, n, n);
+		array.ParallelForEachIndex([&](size_t i, size_t j, size_t k)
+		{
+			array(i, j, k) = InitialValue(i, j, k);
+		});
+
+		return array;
+	}
+}
+
+static void BM_Array3_LocalSampling(benchmark::State& state)
+{
+	const size_t n = static_cast<size_t>(state.range(0));
+	const Array3<double> array = CreateArray(n);
+	const double h = 1.0 / static_cast<double>(n);
+
+	RunLocalSampling(state, LinearArraySampler3<double, double>(array.ConstAccessor(), Vector3D(h, h, h), Vector3D()), n);
+}
+BENCHMARK(BM_Array3_LocalSampling)->Arg(64)->Arg(128)->Arg(256)->UseRealTime();
+
+static void BM_BrickedArray3_LocalSampling(benchmark::State& state)
+{
+	const size_t n = static_cast<size_t>(state.range(0));
+	const BrickedArray3<double> array(CreateArray(n).ConstAccessor());
+	const double h = 1.0 / static_cast<double>(n);
+
+	RunLocalSampling(state, LinearBrickedArraySampler3<double, double>(array, Vector3D(h, h, h), Vector3D()), n);
+}
+BENCHMARK(BM_BrickedArray3_LocalSampling)->Arg(64)->Arg(128)->Arg(256)->UseRealTime();
+
+static void BM_Array3_RandomSampling(benchmark::State& state)
+{
+	const size_t n = static_cast<size_t>(state.range(0));
+	const Array3<double> array = CreateArray(n);
+	const double h = 1.0 / static_cast<double>(n);
+
+	RunRandomSampling(state, LinearArraySampler3<double, double>(array.ConstAccessor(), Vector3D(h, h, h), Vector3D()));
+}
+BENCHMARK(BM_Array3_RandomSampling)->Arg(64)->Arg(128)->Arg(256)->UseRealTime();
+
+static void BM_BrickedArray3_RandomSampling(benchmark::State& state)
+{
+	const size_t n = static_cast<size_t>(state.range(0));
+	const BrickedArray3<double> array(CreateArray(n).ConstAccessor());
+	const double h = 1.0 / static_cast<double>(n);
+
+	RunRandomSampling(state, LinearBrickedArraySampler3<double, double>(array, Vector3D(h, h, h), Vector3D()));
+}
+BENCHMARK(BM_BrickedArray3_RandomSampling)->Arg(64)->Arg(128)->Arg(256)->UseRealTime();
+
+static void BM_BrickedArray3_CopyFrom(benchmark::State& state)
+{
+	ScopedThreadCount threads(state);
+	const size_t n = static_cast<size_t>(state.range(0));
+	const Array3<double> array = CreateArray(n);
+	BrickedArray3<double> bricked;
+
+	for (auto _ : state)
+	{
+		bricked.CopyFrom(array.ConstAccessor());
+	}
+
+	state.SetBytesProcessed(state.iterations() * n * n * n * 2 * sizeof(double));
+}
+BENCHMARK(BM_BrickedArray3_CopyFrom)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(64, 128, 256)->UseRealTime();
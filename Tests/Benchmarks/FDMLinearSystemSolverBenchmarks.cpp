@@ -0,0 +1,119 @@
+#include "BenchmarksUtils.h"
+
+#include <Solver/FDM/FDMCGSolver3.h>
+#include <Solver/FDM/FDMGaussSeidelSolver3.h>
+#include <Solver/FDM/FDMICCGSolver3.h>
+#include <Solver/FDM/FDMJacobiSolver3.h>
+#include <Utils/Parallel.h>
+
+using namespace CubbyFlow;
+
+// Number of iterations run per solve. The tolerance is zero so that every
+// solver performs exactly this many iterations and the per-iteration cost can
+// be compared.
+static const unsigned int NUM_ITERATIONS = 20;
+
+static void BM_FDMBlas3_MVM(benchmark::State& state)
+{
+	ScopedThreadCount threads(state);
+	const size_t n = static_cast<size_t>(state.range(0));
+	FDMLinearSystem3 system;
+	BuildPoissonSystem(n, &system);
+	system.x.Set(1.0);
+
+	FDMVector3 result(n, n, n);
+
+	for (auto _ : state)
+	{
+		FDMBlas3::MVM(system.A, system.x, &result);
+	}
+
+	state.SetItemsProcessed(state.iterations() * n * n * n);
+	state.SetBytesProcessed(state.iterations() * n * n * n * (sizeof(FDMMatrixRow3) + 2 * sizeof(double)));
+}
+BENCHMARK(BM_FDMBlas3_MVM)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(32, 64, 128)->UseRealTime();
+
+static void BM_FDMBlas3_Dot(benchmark::State& state)
+{
+	ScopedThreadCount threads(state);
+	const size_t n = static_cast<size_t>(state.range(0));
+	FDMVector3 a(n, n, n, 1.0);
+	FDMVector3 b(n, n, n, 2.0);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(FDMBlas3::Dot(a, b));
+	}
+
+	state.SetItemsProcessed(state.iterations() * n * n * n);
+	state.SetBytesProcessed(state.iterations() * n * n * n * 2 * sizeof(double));
+}
+BENCHMARK(BM_FDMBlas3_Dot)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(32, 64, 128)->UseRealTime();
+
+template <typename SolverType>
+static void RunSolverBenchmark(benchmark::State& state, SolverType& solver)
+{
+	ScopedThreadCount threads(state);
+	const size_t n = static_cast<size_t>(state.range(0));
+	FDMLinearSystem3 system;
+	BuildPoissonSystem(n, &system);
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		system.x.Set(0.0);
+		state.ResumeTiming();
+
+		solver.Solve(&system);
+	}
+
+	state.SetItemsProcessed(state.iterations() * n * n * n * solver.GetLastNumberOfIterations());
+	state.counters["iterations"] = solver.GetLastNumberOfIterations();
+	state.counters["residual"] = solver.GetLastResidual();
+}
+
+static void BM_FDMCGSolver3(benchmark::State& state)
+{
+	FDMCGSolver3 solver(NUM_ITERATIONS, 0.0);
+	RunSolverBenchmark(state, solver);
+}
+BENCHMARK(BM_FDMCGSolver3)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(32, 64, 128)->UseRealTime();
+
+static void BM_FDMICCGSolver3(benchmark::State& state)
+{
+	FDMICCGSolver3 solver(NUM_ITERATIONS, 0.0);
+	RunSolverBenchmark(state, solver);
+}
+BENCHMARK(BM_FDMICCGSolver3)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(32, 64, 128)->UseRealTime();
+
+// Reports the bandwidth of a Jacobi iteration as if it read the matrix, the
+// right-hand side, and the solution and wrote the solution from memory, so
+// that the temporally blocked iterations are compared by the same traffic.
+static void SetJacobiBytesProcessed(benchmark::State& state, const FDMJacobiSolver3& solver)
+{
+	const size_t n = static_cast<size_t>(state.range(0));
+	state.SetBytesProcessed(state.iterations() * n * n * n * solver.GetLastNumberOfIterations() * (sizeof(FDMMatrixRow3) + 3 * sizeof(double)));
+}
+
+static void BM_FDMJacobiSolver3(benchmark::State& state)
+{
+	FDMJacobiSolver3 solver(NUM_ITERATIONS, NUM_ITERATIONS, 0.0);
+	RunSolverBenchmark(state, solver);
+	SetJacobiBytesProcessed(state, solver);
+}
+BENCHMARK(BM_FDMJacobiSolver3)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(32, 64, 128)->UseRealTime();
+
+static void BM_FDMJacobiSolver3_TemporalBlocking(benchmark::State& state)
+{
+	FDMJacobiSolver3 solver(NUM_ITERATIONS, NUM_ITERATIONS, 0.0, 4);
+	RunSolverBenchmark(state, solver);
+	SetJacobiBytesProcessed(state, solver);
+}
+BENCHMARK(BM_FDMJacobiSolver3_TemporalBlocking)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(32, 64, 128)->UseRealTime();
+
+static void BM_FDMGaussSeidelSolver3(benchmark::State& state)
+{
+	FDMGaussSeidelSolver3 solver(NUM_ITERATIONS, NUM_ITERATIONS, 0.0);
+	RunSolverBenchmark(state, solver);
+}
+BENCHMARK(BM_FDMGaussSeidelSolver3)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(32, 64, 128)->UseRealTime();
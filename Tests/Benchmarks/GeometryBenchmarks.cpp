@@ -0,0 +1,295 @@
+#include "BenchmarksUtils.h"
+
+#include <Geometry/BVH3.h>
+#include <Geometry/Octree.h>
+#include <Geometry/TriangleMeshToSDF.h>
+#include <Grid/VertexCenteredScalarGrid3.h>
+#include <MarchingCubes/MarchingCubes.h>
+
+#include <random>
+
+using namespace CubbyFlow;
+
+static void BM_TriangleMeshToSDF(benchmark::State& state)
+{
+	ScopedThreadCount threads(state);
+	const size_t n = static_cast<size_t>(state.range(0));
+	TriangleMesh3 mesh;
+	BuildSphereMesh(32, &mesh);
+
+	const double h = 1.0 / static_cast<double>(n);
+	VertexCenteredScalarGrid3 sdf(Size3(n, n, n), Vector3D(h, h, h));
+
+	for (auto _ : state)
+	{
+		TriangleMeshToSDF(mesh, &sdf, 3);
+	}
+
+	state.SetItemsProcessed(state.iterations() * n * n * n);
+	state.counters["triangles"] = static_cast<double>(mesh.NumberOfTriangles());
+}
+BENCHMARK(BM_TriangleMeshToSDF)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(32, 64)->UseRealTime();
+
+static void BM_MarchingCubes(benchmark::State& state)
+{
+	const size_t n = static_cast<size_t>(state.range(0));
+
+	for (auto _ : state)
+	{
+		TriangleMesh3 mesh;
+		BuildSphereMesh(n, &mesh);
+		benchmark::DoNotOptimize(mesh.NumberOfTriangles());
+	}
+
+	state.SetItemsProcessed(state.iterations() * n * n * n);
+}
+BENCHMARK(BM_MarchingCubes)->Arg(32)->Arg(64)->Arg(128)->UseRealTime();
+
+namespace
+{
+	void BuildTriangleBVH(const TriangleMesh3& mesh, BVH3<size_t>* bvh)
+	{
+		std::vector<size_t> items(mesh.NumberOfTriangles());
+		std::vector<BoundingBox3D> bounds(mesh.NumberOfTriangles());
+		for (size_t i = 0; i < items.size(); ++i)
+		{
+			items[i] = i;
+			bounds[i] = mesh.Triangle(i).BoundingBox();
+		}
+
+		bvh->Build(items, bounds);
+	}
+
+	void BuildTriangleOctree(const TriangleMesh3& mesh, size_t maxDepth, Octree<size_t>* octree)
+	{
+		std::vector<size_t> items(mesh.NumberOfTriangles());
+		for (size_t i = 0; i < items.size(); ++i)
+		{
+			items[i] = i;
+		}
+
+		octree->Build(items, BoundingBox3D({ 0, 0, 0 }, { 1, 1, 1 }), [&](size_t tri, const BoundingBox3D& b)
+		{
+			return mesh.Triangle(tri).BoundingBox().Overlaps(b);
+		}, maxDepth);
+	}
+}
+
+static void BM_BVH3_Build(benchmark::State& state)
+{
+	TriangleMesh3 mesh;
+	BuildSphereMesh(static_cast<size_t>(state.range(0)), &mesh);
+
+	for (auto _ : state)
+	{
+		BVH3<size_t> bvh;
+		BuildTriangleBVH(mesh, &bvh);
+	}
+
+	state.SetItemsProcessed(state.iterations() * mesh.NumberOfTriangles());
+}
+BENCHMARK(BM_BVH3_Build)->Arg(32)->Arg(64)->Arg(128)->UseRealTime();
+
+static void BM_BVH3_NearestNeighbor(benchmark::State& state)
+{
+	TriangleMesh3 mesh;
+	BuildSphereMesh(static_cast<size_t>(state.range(0)), &mesh);
+
+	BVH3<size_t> bvh;
+	BuildTriangleBVH(mesh, &bvh);
+
+	Array1<Vector3D> queries;
+	GenerateRandomPoints(1024, &queries);
+
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < queries.size(); ++i)
+		{
+			auto result = bvh.GetNearestNeighbor(queries[i], [&](size_t tri, const Vector3D& pt)
+			{
+				return mesh.Triangle(tri).ClosestDistance(pt);
+			});
+			benchmark::DoNotOptimize(result.distance);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_BVH3_NearestNeighbor)->Arg(32)->Arg(64)->Arg(128)->UseRealTime();
+
+static void BM_BVH3_BoxIntersection(benchmark::State& state)
+{
+	TriangleMesh3 mesh;
+	BuildSphereMesh(static_cast<size_t>(state.range(0)), &mesh);
+
+	BVH3<size_t> bvh;
+	BuildTriangleBVH(mesh, &bvh);
+
+	Array1<Vector3D> queries;
+	GenerateRandomPoints(1024, &queries);
+
+	for (auto _ : state)
+	{
+		size_t count = 0;
+		for (size_t i = 0; i < queries.size(); ++i)
+		{
+			BoundingBox3D box(queries[i], queries[i]);
+			box.Expand(0.05);
+			bvh.ForEachIntersectingItem(box, [&](size_t tri, const BoundingBox3D& b)
+			{
+				return mesh.Triangle(tri).BoundingBox().Overlaps(b);
+			}, [&](size_t)
+			{
+				++count;
+			});
+		}
+		benchmark::DoNotOptimize(count);
+	}
+
+	state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_BVH3_BoxIntersection)->Arg(32)->Arg(64)->Arg(128)->UseRealTime();
+
+
+// The octree benchmarks take the max depth as the second argument. Compare
+// them against the BVH3 benchmarks of the same mesh resolution.
+static void BM_Octree_Build(benchmark::State& state)
+{
+	TriangleMesh3 mesh;
+	BuildSphereMesh(static_cast<size_t>(state.range(0)), &mesh);
+
+	for (auto _ : state)
+	{
+		Octree<size_t> octree;
+		BuildTriangleOctree(mesh, static_cast<size_t>(state.range(1)), &octree);
+	}
+
+	state.SetItemsProcessed(state.iterations() * mesh.NumberOfTriangles());
+}
+BENCHMARK(BM_Octree_Build)->Args({ 32, 5 })->Args({ 64, 6 })->Args({ 128, 7 })->UseRealTime();
+
+static void BM_Octree_NearestNeighbor(benchmark::State& state)
+{
+	TriangleMesh3 mesh;
+	BuildSphereMesh(static_cast<size_t>(state.range(0)), &mesh);
+
+	Octree<size_t> octree;
+	BuildTriangleOctree(mesh, static_cast<size_t>(state.range(1)), &octree);
+
+	Array1<Vector3D> queries;
+	GenerateRandomPoints(1024, &queries);
+
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < queries.size(); ++i)
+		{
+			auto result = octree.GetNearestNeighbor(queries[i], [&](size_t tri, const Vector3D& pt)
+			{
+				return mesh.Triangle(tri).ClosestDistance(pt);
+			});
+			benchmark::DoNotOptimize(result.distance);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_Octree_NearestNeighbor)->Args({ 32, 5 })->Args({ 64, 6 })->Args({ 128, 7 })->UseRealTime();
+
+static void BM_Octree_BoxIntersection(benchmark::State& state)
+{
+	TriangleMesh3 mesh;
+	BuildSphereMesh(static_cast<size_t>(state.range(0)), &mesh);
+
+	Octree<size_t> octree;
+	BuildTriangleOctree(mesh, static_cast<size_t>(state.range(1)), &octree);
+
+	Array1<Vector3D> queries;
+	GenerateRandomPoints(1024, &queries);
+
+	for (auto _ : state)
+	{
+		size_t count = 0;
+		for (size_t i = 0; i < queries.size(); ++i)
+		{
+			BoundingBox3D box(queries[i], queries[i]);
+			box.Expand(0.05);
+			octree.ForEachIntersectingItem(box, [&](size_t tri, const BoundingBox3D& b)
+			{
+				return mesh.Triangle(tri).BoundingBox().Overlaps(b);
+			}, [&](size_t)
+			{
+				++count;
+			});
+		}
+		benchmark::DoNotOptimize(count);
+	}
+
+	state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_Octree_BoxIntersection)->Args({ 32, 5 })->Args({ 64, 6 })->Args({ 128, 7 })->UseRealTime();
+
+// Point items make the traversal dominate over the distance evaluations.
+static void BM_BVH3_PointNearestNeighbor(benchmark::State& state)
+{
+	Array1<Vector3D> points;
+	GenerateRandomPoints(static_cast<size_t>(state.range(0)), &points, 1);
+
+	std::vector<Vector3D> items(points.begin(), points.end());
+	std::vector<BoundingBox3D> bounds(items.size());
+	for (size_t i = 0; i < items.size(); ++i)
+	{
+		bounds[i] = BoundingBox3D(items[i], items[i]);
+	}
+
+	BVH3<Vector3D> bvh;
+	bvh.Build(items, bounds);
+
+	Array1<Vector3D> queries;
+	GenerateRandomPoints(1024, &queries);
+
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < queries.size(); ++i)
+		{
+			auto result = bvh.GetNearestNeighbor(queries[i], [](const Vector3D& a, const Vector3D& b)
+			{
+				return a.DistanceTo(b);
+			});
+			benchmark::DoNotOptimize(result.distance);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_BVH3_PointNearestNeighbor)->Arg(10000)->Arg(100000)->UseRealTime();
+
+static void BM_Octree_PointNearestNeighbor(benchmark::State& state)
+{
+	Array1<Vector3D> points;
+	GenerateRandomPoints(static_cast<size_t>(state.range(0)), &points, 1);
+
+	std::vector<Vector3D> items(points.begin(), points.end());
+	Octree<Vector3D> octree;
+	octree.Build(items, BoundingBox3D({ 0, 0, 0 }, { 1, 1, 1 }), [](const Vector3D& pt, const BoundingBox3D& b)
+	{
+		return b.Contains(pt);
+	}, static_cast<size_t>(state.range(1)));
+
+	Array1<Vector3D> queries;
+	GenerateRandomPoints(1024, &queries);
+
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < queries.size(); ++i)
+		{
+			auto result = octree.GetNearestNeighbor(queries[i], [](const Vector3D& a, const Vector3D& b)
+			{
+				return a.DistanceTo(b);
+			});
+			benchmark::DoNotOptimize(result.distance);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_Octree_PointNearestNeighbor)->Args({ 10000, 6 })->Args({ 100000, 7 })->UseRealTime();
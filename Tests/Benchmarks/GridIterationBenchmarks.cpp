@@ -0,0 +1,152 @@
+#include "BenchmarksUtils.h"
+
+#include <Grid/CellCenteredScalarGrid3.h>
+#include <Grid/FaceCenteredGrid3.h>
+#include <Utils/Parallel.h>
+
+#include <functional>
+
+using namespace CubbyFlow;
+
+namespace
+{
+	using IndexFunc = std::function<void(size_t, size_t, size_t)>;
+
+	// Runs a light per-cell pass (a decay of the smoke density) through the
+	// given iteration function, so that the overhead of the iteration itself
+	// dominates.
+	template <typename Iterate>
+	void RunScalarPass(benchmark::State& state, const Iterate& iterate)
+	{
+		ScopedThreadCount threads(state);
+		const size_t n = static_cast<size_t>(state.range(0));
+		CellCenteredScalarGrid3 grid(n, n, n, 1.0, 1.0, 1.0, 1.0);
+		auto data = grid.GetDataAccessor();
+
+		for (auto _ : state)
+		{
+			iterate(grid, [&data](size_t i, size_t j, size_t k)
+			{
+				data(i, j, k) = 0.999 * data(i, j, k) + 0.001;
+			});
+		}
+
+		benchmark::DoNotOptimize(data(0, 0, 0));
+		state.SetItemsProcessed(state.iterations() * n * n * n);
+	}
+
+	// Runs the divergence of a face-centered grid over its cells, reading
+	// the faces through the accessors like the pressure solvers do.
+	template <typename Iterate>
+	void RunFaceCenteredPass(benchmark::State& state, const Iterate& iterate)
+	{
+		ScopedThreadCount threads(state);
+		const size_t n = static_cast<size_t>(state.range(0));
+		FaceCenteredGrid3 grid(n, n, n);
+		grid.Fill([](const Vector3D& pt)
+		{
+			return Vector3D(pt.y, -pt.x, 0.5 * pt.z);
+		});
+
+		CellCenteredScalarGrid3 div(n, n, n);
+		auto u = grid.GetUConstAccessor();
+		auto v = grid.GetVConstAccessor();
+		auto w = grid.GetWConstAccessor();
+		auto d = div.GetDataAccessor();
+
+		for (auto _ : state)
+		{
+			iterate(grid, [&](size_t i, size_t j, size_t k)
+			{
+				d(i, j, k) = u(i + 1, j, k) - u(i, j, k) + v(i, j + 1, k) - v(i, j, k) + w(i, j, k + 1) - w(i, j, k);
+			});
+		}
+
+		benchmark::DoNotOptimize(d(0, 0, 0));
+		state.SetItemsProcessed(state.iterations() * n * n * n);
+	}
+}
+
+static void BM_GridIteration_ScalarGrid(benchmark::State& state)
+{
+	RunScalarPass(state, [](const ScalarGrid3& grid, const auto& func)
+	{
+		grid.ParallelForEachDataPointIndex(func);
+	});
+}
+BENCHMARK(BM_GridIteration_ScalarGrid)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(64, 128)->UseRealTime();
+
+// The same pass through a type-erased callback, as every grid iteration
+// used to be.
+static void BM_GridIteration_ScalarGrid_StdFunction(benchmark::State& state)
+{
+	RunScalarPass(state, [](const ScalarGrid3& grid, const auto& func)
+	{
+		const IndexFunc erased = func;
+		grid.ParallelForEachDataPointIndex(erased);
+	});
+}
+BENCHMARK(BM_GridIteration_ScalarGrid_StdFunction)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(64, 128)->UseRealTime();
+
+// The same pass as a plain loop over the raw data, the lower bound.
+static void BM_GridIteration_ScalarGrid_Loop(benchmark::State& state)
+{
+	ScopedThreadCount threads(state);
+	const size_t n = static_cast<size_t>(state.range(0));
+	CellCenteredScalarGrid3 grid(n, n, n, 1.0, 1.0, 1.0, 1.0);
+	double* data = grid.GetDataAccessor().data();
+
+	for (auto _ : state)
+	{
+		ParallelFor(ZERO_SIZE, n, [data, n](size_t k)
+		{
+			double* slice = data + k * n * n;
+
+			for (size_t idx = 0; idx < n * n; ++idx)
+			{
+				slice[idx] = 0.999 * slice[idx] + 0.001;
+			}
+		});
+	}
+
+	benchmark::DoNotOptimize(data[0]);
+	state.SetItemsProcessed(state.iterations() * n * n * n);
+}
+BENCHMARK(BM_GridIteration_ScalarGrid_Loop)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(64, 128)->UseRealTime();
+
+static void BM_GridIteration_FaceCenteredGrid(benchmark::State& state)
+{
+	RunFaceCenteredPass(state, [](const FaceCenteredGrid3& grid, const auto& func)
+	{
+		grid.ParallelForEachCellIndex(func);
+	});
+}
+BENCHMARK(BM_GridIteration_FaceCenteredGrid)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(64, 128)->UseRealTime();
+
+static void BM_GridIteration_FaceCenteredGrid_StdFunction(benchmark::State& state)
+{
+	RunFaceCenteredPass(state, [](const FaceCenteredGrid3& grid, const auto& func)
+	{
+		const IndexFunc erased = func;
+		grid.ParallelForEachCellIndex(erased);
+	});
+}
+BENCHMARK(BM_GridIteration_FaceCenteredGrid_StdFunction)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(64, 128)->UseRealTime();
+
+static void BM_GridIteration_ScalarGridFill(benchmark::State& state)
+{
+	ScopedThreadCount threads(state);
+	const size_t n = static_cast<size_t>(state.range(0));
+	CellCenteredScalarGrid3 grid(n, n, n);
+
+	for (auto _ : state)
+	{
+		grid.Fill([](const Vector3D& pt)
+		{
+			return pt.x + pt.y + pt.z;
+		});
+	}
+
+	state.SetItemsProcessed(state.iterations() * n * n * n);
+}
+BENCHMARK(BM_GridIteration_ScalarGridFill)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(64, 128)->UseRealTime();
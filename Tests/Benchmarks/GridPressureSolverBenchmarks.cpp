@@ -0,0 +1,94 @@
+#include "BenchmarksUtils.h"
+
+#include <Grid/CellCenteredScalarGrid3.h>
+#include <Solver/FDM/FDMICCGSolver3.h>
+#include <Solver/Grid/GridFractionalSinglePhasePressureSolver3.h>
+#include <Solver/Grid/GridSinglePhasePressureSolver3.h>
+
+using namespace CubbyFlow;
+
+namespace
+{
+	// Projects a flow around a static sphere in a half-filled box, which is
+	// the case of a resting pool with a fixed collider. Every step adds a
+	// diverging force and projects the result, so that the pressure changes
+	// little between the steps.
+	template <typename SolverType>
+	void RunProjection(benchmark::State& state, bool isWarmStarted)
+	{
+		ScopedThreadCount threads(state);
+		const size_t n = static_cast<size_t>(state.range(0));
+		const Size3 resolution(n, n, n);
+		const Vector3D spacing = Vector3D(1.0, 1.0, 1.0) / static_cast<double>(n);
+
+		FaceCenteredGrid3 velocity(resolution, spacing);
+		FaceCenteredGrid3 force(resolution, spacing);
+		force.Fill([](const Vector3D& pt)
+		{
+			return Vector3D(std::sin(6.0 * pt.x) * pt.y, std::cos(6.0 * pt.y) * pt.z, std::sin(6.0 * pt.z) * pt.x);
+		});
+
+		CellCenteredScalarGrid3 boundarySDF(resolution, spacing);
+		boundarySDF.Fill([](const Vector3D& pt)
+		{
+			return pt.DistanceTo(Vector3D(0.5, 0.3, 0.5)) - 0.2;
+		});
+
+		CellCenteredScalarGrid3 fluidSDF(resolution, spacing);
+		fluidSDF.Fill([](const Vector3D& pt)
+		{
+			return pt.y - 0.6;
+		});
+
+		auto systemSolver = std::make_shared<FDMICCGSolver3>(100, 1e-6, 0.0, isWarmStarted);
+		SolverType solver;
+		solver.SetLinearSystemSolver(systemSolver);
+
+		size_t numberOfIterations = 0;
+		for (auto _ : state)
+		{
+			velocity.ParallelForEachUIndex([&](size_t i, size_t j, size_t k)
+			{
+				velocity.GetU(i, j, k) += 0.01 * force.GetU(i, j, k);
+			});
+			velocity.ParallelForEachVIndex([&](size_t i, size_t j, size_t k)
+			{
+				velocity.GetV(i, j, k) += 0.01 * force.GetV(i, j, k);
+			});
+			velocity.ParallelForEachWIndex([&](size_t i, size_t j, size_t k)
+			{
+				velocity.GetW(i, j, k) += 0.01 * force.GetW(i, j, k);
+			});
+
+			solver.Solve(velocity, 0.01, &velocity, boundarySDF, ConstantVectorField3({ 0, 0, 0 }), fluidSDF);
+			numberOfIterations += systemSolver->GetLastNumberOfIterations();
+		}
+
+		state.SetItemsProcessed(state.iterations() * n * n * n);
+		state.counters["iterations"] = benchmark::Counter(static_cast<double>(numberOfIterations), benchmark::Counter::kAvgIterations);
+	}
+}
+
+static void BM_GridSinglePhasePressureSolver3(benchmark::State& state)
+{
+	RunProjection<GridSinglePhasePressureSolver3>(state, false);
+}
+BENCHMARK(BM_GridSinglePhasePressureSolver3)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(32, 64, 128)->UseRealTime();
+
+static void BM_GridSinglePhasePressureSolver3_WarmStart(benchmark::State& state)
+{
+	RunProjection<GridSinglePhasePressureSolver3>(state, true);
+}
+BENCHMARK(BM_GridSinglePhasePressureSolver3_WarmStart)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(32, 64, 128)->UseRealTime();
+
+static void BM_GridFractionalSinglePhasePressureSolver3(benchmark::State& state)
+{
+	RunProjection<GridFractionalSinglePhasePressureSolver3>(state, false);
+}
+BENCHMARK(BM_GridFractionalSinglePhasePressureSolver3)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(32, 64, 128)->UseRealTime();
+
+static void BM_GridFractionalSinglePhasePressureSolver3_WarmStart(benchmark::State& state)
+{
+	RunProjection<GridFractionalSinglePhasePressureSolver3>(state, true);
+}
+BENCHMARK(BM_GridFractionalSinglePhasePressureSolver3_WarmStart)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(32, 64, 128)->UseRealTime();
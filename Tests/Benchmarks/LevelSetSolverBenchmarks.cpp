@@ -0,0 +1,59 @@
+#include "BenchmarksUtils.h"
+
+#include <Grid/CellCenteredScalarGrid3.h>
+#include <Solver/LevelSet/ENOLevelSetSolver3.h>
+#include <Solver/LevelSet/FMMLevelSetSolver3.h>
+#include <Solver/LevelSet/UpwindLevelSetSolver3.h>
+
+using namespace CubbyFlow;
+
+namespace
+{
+	// Distorted sphere which is not a signed-distance field any more.
+	void InitializeSDF(ScalarGrid3* sdf)
+	{
+		sdf->Fill([](const Vector3D& pt)
+		{
+			const double r = pt.DistanceTo(Vector3D(0.5, 0.5, 0.5)) - 0.25;
+			return r * (1.0 + 0.5 * pt.x);
+		});
+	}
+
+	template <typename SolverType>
+	void RunReinitialize(benchmark::State& state)
+	{
+		ScopedThreadCount threads(state);
+		const size_t n = static_cast<size_t>(state.range(0));
+		const Vector3D spacing = Vector3D(1.0, 1.0, 1.0) / static_cast<double>(n);
+
+		CellCenteredScalarGrid3 input(Size3(n, n, n), spacing);
+		CellCenteredScalarGrid3 output(Size3(n, n, n), spacing);
+		InitializeSDF(&input);
+
+		SolverType solver;
+		for (auto _ : state)
+		{
+			solver.Reinitialize(input, 5.0 * spacing.x, &output);
+		}
+
+		state.SetItemsProcessed(state.iterations() * n * n * n);
+	}
+}
+
+static void BM_FMMLevelSetSolver3_Reinitialize(benchmark::State& state)
+{
+	RunReinitialize<FMMLevelSetSolver3>(state);
+}
+BENCHMARK(BM_FMMLevelSetSolver3_Reinitialize)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(32, 64)->UseRealTime();
+
+static void BM_UpwindLevelSetSolver3_Reinitialize(benchmark::State& state)
+{
+	RunReinitialize<UpwindLevelSetSolver3>(state);
+}
+BENCHMARK(BM_UpwindLevelSetSolver3_Reinitialize)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(32, 64, 128)->UseRealTime();
+
+static void BM_ENOLevelSetSolver3_Reinitialize(benchmark::State& state)
+{
+	RunReinitialize<ENOLevelSetSolver3>(state);
+}
+BENCHMARK(BM_ENOLevelSetSolver3_Reinitialize)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(32, 64, 128)->UseRealTime();
@@ -0,0 +1,71 @@
+#include "BenchmarksUtils.h"
+
+#include <Solver/PIC/PICSolver3.h>
+
+using namespace CubbyFlow;
+
+namespace
+{
+	// Exposes the particle-grid transfers so that they can be timed separately.
+	class PICSolver3Benchmark : public PICSolver3
+	{
+	public:
+		PICSolver3Benchmark(const Size3& resolution) :
+			PICSolver3(resolution, Vector3D(1.0, 1.0, 1.0) / static_cast<double>(resolution.x), Vector3D())
+		{
+			// Do nothing
+		}
+
+		using PICSolver3::TransferFromGridsToParticles;
+		using PICSolver3::TransferFromParticlesToGrids;
+	};
+
+	// Seeds eight particles per cell with a swirling velocity.
+	void InitializeParticles(const ParticleSystemData3Ptr& particles, size_t n)
+	{
+		Array1<Vector3D> points;
+		GenerateRandomPoints(8 * n * n * n, &points);
+
+		Array1<Vector3D> velocities(points.size());
+		for (size_t i = 0; i < points.size(); ++i)
+		{
+			const Vector3D& pt = points[i];
+			velocities[i] = Vector3D(pt.y - 0.5, 0.5 - pt.x, 0.1 * pt.z);
+		}
+
+		particles->AddParticles(points.ConstAccessor(), velocities.ConstAccessor());
+	}
+}
+
+static void BM_PICSolver3_ParticlesToGrid(benchmark::State& state)
+{
+	ScopedThreadCount threads(state);
+	const size_t n = static_cast<size_t>(state.range(0));
+	PICSolver3Benchmark solver(Size3(n, n, n));
+	InitializeParticles(solver.GetParticleSystemData(), n);
+
+	for (auto _ : state)
+	{
+		solver.TransferFromParticlesToGrids();
+	}
+
+	state.SetItemsProcessed(state.iterations() * solver.GetParticleSystemData()->NumberOfParticles());
+}
+BENCHMARK(BM_PICSolver3_ParticlesToGrid)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(32, 64)->UseRealTime();
+
+static void BM_PICSolver3_GridToParticles(benchmark::State& state)
+{
+	ScopedThreadCount threads(state);
+	const size_t n = static_cast<size_t>(state.range(0));
+	PICSolver3Benchmark solver(Size3(n, n, n));
+	InitializeParticles(solver.GetParticleSystemData(), n);
+	solver.TransferFromParticlesToGrids();
+
+	for (auto _ : state)
+	{
+		solver.TransferFromGridsToParticles();
+	}
+
+	state.SetItemsProcessed(state.iterations() * solver.GetParticleSystemData()->NumberOfParticles());
+}
+BENCHMARK(BM_PICSolver3_GridToParticles)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(32, 64)->UseRealTime();
@@ -0,0 +1,73 @@
+#include "BenchmarksUtils.h"
+
+#include <Array/Array3.h>
+#include <Utils/Parallel.h>
+
+#include <numeric>
+#include <vector>
+
+using namespace CubbyFlow;
+
+static void BM_ParallelFor(benchmark::State& state)
+{
+	ScopedThreadCount threads(state);
+	const size_t n = static_cast<size_t>(state.range(0));
+	std::vector<double> a(n, 1.0);
+
+	for (auto _ : state)
+	{
+		ParallelFor(ZERO_SIZE, n, [&](size_t i)
+		{
+			a[i] = 2.0 * a[i] + 1.0;
+		});
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ParallelFor)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(1 << 16, 1 << 20, 1 << 24)->UseRealTime();
+
+static void BM_ParallelFor3(benchmark::State& state)
+{
+	ScopedThreadCount threads(state);
+	const size_t n = static_cast<size_t>(state.range(0));
+	Array3<double> a(n, n, n, 1.0);
+
+	for (auto _ : state)
+	{
+		a.ParallelForEachIndex([&](size_t i, size_t j, size_t k)
+		{
+			a(i, j, k) = 2.0 * a(i, j, k) + 1.0;
+		});
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * n * n * n);
+}
+BENCHMARK(BM_ParallelFor3)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(32, 64, 128)->UseRealTime();
+
+static void BM_ParallelReduce(benchmark::State& state)
+{
+	ScopedThreadCount threads(state);
+	const size_t n = static_cast<size_t>(state.range(0));
+	std::vector<double> a(n);
+	std::iota(a.begin(), a.end(), 0.0);
+
+	for (auto _ : state)
+	{
+		double sum = ParallelReduce(ZERO_SIZE, n, 0.0,
+			[&](size_t start, size_t end, double init)
+		{
+			double result = init;
+			for (size_t i = start; i < end; ++i)
+			{
+				result += a[i];
+			}
+			return result;
+		}, std::plus<double>());
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ParallelReduce)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(1 << 16, 1 << 20, 1 << 24)->UseRealTime();
@@ -0,0 +1,90 @@
+#include "BenchmarksUtils.h"
+
+#include <Searcher/PointHashGridSearcher3.h>
+#include <Searcher/PointParallelHashGridSearcher3.h>
+#include <Utils/Parallel.h>
+
+using namespace CubbyFlow;
+
+namespace
+{
+	// Average spacing of n random points in the unit cube.
+	double AverageSpacing(size_t n)
+	{
+		return 1.0 / std::cbrt(static_cast<double>(n));
+	}
+
+	Size3 HashResolution(size_t n)
+	{
+		const size_t res = static_cast<size_t>(std::cbrt(static_cast<double>(n)));
+		return Size3(res, res, res);
+	}
+}
+
+static void BM_PointHashGridSearcher3_Build(benchmark::State& state)
+{
+	const size_t n = static_cast<size_t>(state.range(0));
+	Array1<Vector3D> points;
+	GenerateRandomPoints(n, &points);
+
+	const double radius = 2.0 * AverageSpacing(n);
+	PointHashGridSearcher3 searcher(HashResolution(n), radius);
+
+	for (auto _ : state)
+	{
+		searcher.Build(points.ConstAccessor());
+	}
+
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_PointHashGridSearcher3_Build)->Arg(1 << 14)->Arg(1 << 17)->Arg(1 << 20)->UseRealTime();
+
+static void BM_PointParallelHashGridSearcher3_Build(benchmark::State& state)
+{
+	ScopedThreadCount threads(state);
+	const size_t n = static_cast<size_t>(state.range(0));
+	Array1<Vector3D> points;
+	GenerateRandomPoints(n, &points);
+
+	const double radius = 2.0 * AverageSpacing(n);
+	PointParallelHashGridSearcher3 searcher(HashResolution(n), radius);
+
+	for (auto _ : state)
+	{
+		searcher.Build(points.ConstAccessor());
+	}
+
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_PointParallelHashGridSearcher3_Build)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(1 << 14, 1 << 17, 1 << 20)->UseRealTime();
+
+static void BM_PointParallelHashGridSearcher3_Query(benchmark::State& state)
+{
+	ScopedThreadCount threads(state);
+	const size_t n = static_cast<size_t>(state.range(0));
+	Array1<Vector3D> points;
+	GenerateRandomPoints(n, &points);
+
+	const double radius = 2.0 * AverageSpacing(n);
+	PointParallelHashGridSearcher3 searcher(HashResolution(n), radius);
+	searcher.Build(points.ConstAccessor());
+
+	Array1<size_t> counts(n);
+
+	for (auto _ : state)
+	{
+		ParallelFor(ZERO_SIZE, n, [&](size_t i)
+		{
+			size_t count = 0;
+			searcher.ForEachNearbyPoint(points[i], radius, [&](size_t, const Vector3D&)
+			{
+				++count;
+			});
+			counts[i] = count;
+		});
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_PointParallelHashGridSearcher3_Query)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(1 << 14, 1 << 17, 1 << 20)->UseRealTime();
@@ -0,0 +1,309 @@
+#include "BenchmarksUtils.h"
+
+#include <Collider/RigidBodyCollider3.h>
+#include <Emitter/VolumeParticleEmitter3.h>
+#include <Geometry/Box3.h>
+#include <PointGenerator/BccLatticePointGenerator.h>
+#include <Solver/IISPH/IISPHSolver3.h>
+#include <Solver/PCISPH/PCISPHSolver3.h>
+#include <Solver/SPH/SPHSolver3.h>
+#include <Surface/Implicit/SurfaceToImplicit3.h>
+
+#include <numeric>
+
+using namespace CubbyFlow;
+
+namespace
+{
+	// Exposes the individual SPH passes so that they can be timed separately.
+	class SPHSolver3Benchmark : public SPHSolver3
+	{
+	public:
+		using SPHSolver3::AccumulateViscosityForce;
+		using SPHSolver3::ComputePressure;
+		using SPHSolver3::ComputePseudoViscosity;
+
+		void AccumulatePressureForceOnly()
+		{
+			auto particles = GetSPHSystemData();
+			AccumulatePressureForce(
+				particles->GetPositions(),
+				particles->GetDensities(),
+				particles->GetPressures(),
+				particles->GetForces());
+		}
+	};
+
+	class PCISPHSolver3Benchmark : public PCISPHSolver3
+	{
+	public:
+		using PCISPHSolver3::AccumulatePressureForce;
+		using PCISPHSolver3::OnBeginAdvanceTimeStep;
+	};
+
+	// Counts the sub-time-steps taken by the solver.
+	template <typename SolverType>
+	class SubStepCounter final : public SolverType
+	{
+	public:
+		size_t numberOfSubSteps = 0;
+
+	protected:
+		void OnEndAdvanceTimeStep(double timeStepInSeconds) override
+		{
+			SolverType::OnEndAdvanceTimeStep(timeStepInSeconds);
+			++numberOfSubSteps;
+		}
+	};
+
+	// Fills a block of n x n x n lattice cells with particles at the target spacing.
+	void InitializeBlock(const SPHSystemData3Ptr& particles, size_t n)
+	{
+		const double spacing = particles->GetTargetSpacing();
+		const double length = spacing * static_cast<double>(n);
+
+		Array1<Vector3D> points;
+		BccLatticePointGenerator generator;
+		generator.Generate(BoundingBox3D(Vector3D(), Vector3D(length, length, length)), spacing, &points);
+
+		particles->Resize(0);
+		particles->AddParticles(points.ConstAccessor());
+		particles->BuildNeighborSearcher();
+		particles->BuildNeighborLists();
+		particles->UpdateDensities();
+	}
+
+	// Dam break in a 1 x 1 x 0.25 tank with a 0.4 x 0.6 water column.
+	const double DAM_BREAK_DURATION = 0.5;
+	const double DAM_BREAK_FRAME_INTERVAL = 1.0 / 60.0;
+
+	void SetUpDamBreak(SPHSolver3* solver, size_t resolution)
+	{
+		const double targetSpacing = 1.0 / static_cast<double>(resolution);
+		const BoundingBox3D domain(Vector3D(), Vector3D(1.0, 1.0, 0.25));
+
+		SPHSystemData3Ptr particles = solver->GetSPHSystemData();
+		particles->SetTargetDensity(1000.0);
+		particles->SetTargetSpacing(targetSpacing);
+
+		BoundingBox3D column(Vector3D(), Vector3D(0.4, 0.6, 0.25));
+		column.Expand(-targetSpacing);
+
+		auto emitter = std::make_shared<VolumeParticleEmitter3>(
+			std::make_shared<SurfaceToImplicit3>(std::make_shared<Box3>(column)),
+			column,
+			targetSpacing,
+			Vector3D());
+		emitter->SetJitter(0.0);
+		solver->SetEmitter(emitter);
+
+		Box3Ptr box = std::make_shared<Box3>(domain);
+		box->isNormalFlipped = true;
+		solver->SetCollider(std::make_shared<RigidBodyCollider3>(box));
+	}
+
+	// Returns the average compression relative to the target density.
+	double DensityErrorRatio(const SPHSystemData3Ptr& particles)
+	{
+		particles->BuildNeighborSearcher();
+		particles->UpdateDensities();
+
+		const double targetDensity = particles->GetTargetDensity();
+		auto densities = particles->GetDensities();
+		double sum = 0.0;
+
+		for (size_t i = 0; i < densities.size(); ++i)
+		{
+			sum += std::max(densities[i] - targetDensity, 0.0);
+		}
+
+		return densities.size() > 0 ? sum / (densities.size() * targetDensity) : 0.0;
+	}
+
+	//!
+	//! Runs the dam break for DAM_BREAK_DURATION seconds and reports the wall
+	//! time per simulated second, the average sub-time-step size and the
+	//! average density error measured after each frame. The solver setup is
+	//! excluded from the measurement.
+	//!
+	template <typename SolverType, typename SetUpCallback, typename FrameCallback>
+	void RunDamBreak(benchmark::State& state, SetUpCallback onSetUp, FrameCallback onFrame)
+	{
+		ScopedThreadCount threads(state);
+		const size_t resolution = static_cast<size_t>(state.range(0));
+
+		double densityError = 0.0;
+		size_t numberOfFrames = 0;
+		size_t numberOfParticles = 0;
+		size_t numberOfSubSteps = 0;
+		double simulatedTime = 0.0;
+
+		for (auto _ : state)
+		{
+			state.PauseTiming();
+			SubStepCounter<SolverType> solver;
+			SetUpDamBreak(&solver, resolution);
+			onSetUp(&solver);
+			state.ResumeTiming();
+
+			for (Frame frame(0, DAM_BREAK_FRAME_INTERVAL); frame.TimeInSeconds() < DAM_BREAK_DURATION; ++frame)
+			{
+				solver.Update(frame);
+
+				state.PauseTiming();
+				densityError += DensityErrorRatio(solver.GetSPHSystemData());
+				onFrame(solver);
+				++numberOfFrames;
+				state.ResumeTiming();
+			}
+
+			numberOfParticles = solver.GetSPHSystemData()->NumberOfParticles();
+			numberOfSubSteps += solver.numberOfSubSteps;
+			simulatedTime += solver.CurrentTimeInSeconds();
+		}
+
+		state.counters["particles"] = static_cast<double>(numberOfParticles);
+		state.counters["densityError"] = densityError / std::max(numberOfFrames, ZERO_SIZE + 1);
+		state.counters["timeStep"] = simulatedTime / std::max(numberOfSubSteps, ZERO_SIZE + 1);
+		state.counters["secPerSimSec"] = benchmark::Counter(
+			DAM_BREAK_DURATION * state.iterations(), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+	}
+}
+
+static void BM_SPHSystemData3_BuildNeighborLists(benchmark::State& state)
+{
+	ScopedThreadCount threads(state);
+	SPHSolver3Benchmark solver;
+	auto particles = solver.GetSPHSystemData();
+	InitializeBlock(particles, static_cast<size_t>(state.range(0)));
+
+	for (auto _ : state)
+	{
+		particles->BuildNeighborSearcher();
+		particles->BuildNeighborLists();
+	}
+
+	state.SetItemsProcessed(state.iterations() * particles->NumberOfParticles());
+}
+BENCHMARK(BM_SPHSystemData3_BuildNeighborLists)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(16, 32, 48)->UseRealTime();
+
+static void BM_SPHSystemData3_UpdateDensities(benchmark::State& state)
+{
+	ScopedThreadCount threads(state);
+	SPHSolver3Benchmark solver;
+	auto particles = solver.GetSPHSystemData();
+	InitializeBlock(particles, static_cast<size_t>(state.range(0)));
+
+	for (auto _ : state)
+	{
+		particles->UpdateDensities();
+	}
+
+	state.SetItemsProcessed(state.iterations() * particles->NumberOfParticles());
+}
+BENCHMARK(BM_SPHSystemData3_UpdateDensities)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(16, 32, 48)->UseRealTime();
+
+static void BM_SPHSolver3_PressureForce(benchmark::State& state)
+{
+	ScopedThreadCount threads(state);
+	SPHSolver3Benchmark solver;
+	auto particles = solver.GetSPHSystemData();
+	InitializeBlock(particles, static_cast<size_t>(state.range(0)));
+
+	for (auto _ : state)
+	{
+		solver.ComputePressure();
+		solver.AccumulatePressureForceOnly();
+	}
+
+	state.SetItemsProcessed(state.iterations() * particles->NumberOfParticles());
+}
+BENCHMARK(BM_SPHSolver3_PressureForce)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(16, 32, 48)->UseRealTime();
+
+static void BM_SPHSolver3_ViscosityForce(benchmark::State& state)
+{
+	ScopedThreadCount threads(state);
+	SPHSolver3Benchmark solver;
+	auto particles = solver.GetSPHSystemData();
+	InitializeBlock(particles, static_cast<size_t>(state.range(0)));
+
+	for (auto _ : state)
+	{
+		solver.AccumulateViscosityForce();
+	}
+
+	state.SetItemsProcessed(state.iterations() * particles->NumberOfParticles());
+}
+BENCHMARK(BM_SPHSolver3_ViscosityForce)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(16, 32, 48)->UseRealTime();
+
+static void BM_SPHSolver3_PseudoViscosity(benchmark::State& state)
+{
+	ScopedThreadCount threads(state);
+	SPHSolver3Benchmark solver;
+	auto particles = solver.GetSPHSystemData();
+	InitializeBlock(particles, static_cast<size_t>(state.range(0)));
+
+	for (auto _ : state)
+	{
+		solver.ComputePseudoViscosity(1.0 / 60.0);
+	}
+
+	state.SetItemsProcessed(state.iterations() * particles->NumberOfParticles());
+}
+BENCHMARK(BM_SPHSolver3_PseudoViscosity)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(16, 32, 48)->UseRealTime();
+
+static void BM_PCISPHSolver3_PressureSolve(benchmark::State& state)
+{
+	ScopedThreadCount threads(state);
+	PCISPHSolver3Benchmark solver;
+	auto particles = solver.GetSPHSystemData();
+	InitializeBlock(particles, static_cast<size_t>(state.range(0)));
+
+	// Force a fixed amount of work per iteration
+	solver.SetMaxDensityErrorRatio(0.0);
+	solver.SetMaxNumberOfIterations(5);
+
+	const double dt = 1e-3;
+	solver.OnBeginAdvanceTimeStep(dt);
+
+	for (auto _ : state)
+	{
+		solver.AccumulatePressureForce(dt);
+	}
+
+	const auto& iterationTimes = solver.GetLastIterationTimes();
+	const double averageIterationTime = iterationTimes.empty() ? 0.0 :
+		std::accumulate(iterationTimes.begin(), iterationTimes.end(), 0.0) / iterationTimes.size();
+
+	state.SetItemsProcessed(state.iterations() * particles->NumberOfParticles());
+	state.counters["iterations"] = solver.GetLastNumberOfIterations();
+	state.counters["densityError"] = solver.GetLastDensityErrorRatio();
+	state.counters["secPerIteration"] = averageIterationTime;
+}
+BENCHMARK(BM_PCISPHSolver3_PressureSolve)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(16, 32)->UseRealTime();
+
+
+static void BM_DamBreak_PCISPHSolver3(benchmark::State& state)
+{
+	RunDamBreak<PCISPHSolver3>(state, [](PCISPHSolver3*) {}, [](const PCISPHSolver3&) {});
+}
+BENCHMARK(BM_DamBreak_PCISPHSolver3)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(20, 30)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_DamBreak_IISPHSolver3(benchmark::State& state, double maxDensityErrorRatio)
+{
+	double iterations = 0.0;
+	size_t numberOfFrames = 0;
+
+	RunDamBreak<IISPHSolver3>(state, [&](IISPHSolver3* solver)
+	{
+		solver->SetMaxDensityErrorRatio(maxDensityErrorRatio);
+	}, [&](const IISPHSolver3& solver)
+	{
+		iterations += solver.GetLastNumberOfIterations();
+		++numberOfFrames;
+	});
+
+	state.counters["iterations"] = iterations / std::max(numberOfFrames, ZERO_SIZE + 1);
+}
+BENCHMARK_CAPTURE(BM_DamBreak_IISPHSolver3, error1e-3, 1e-3)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(20, 30)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_DamBreak_IISPHSolver3, error3e-4, 3e-4)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(20, 30)->UseRealTime()->Unit(benchmark::kMillisecond);
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include "BenchmarksUtils.h"
+
+#include <Grid/CellCenteredScalarGrid3.h>
+#include <Grid/FaceCenteredGrid3.h>
+#include <SemiLagrangian/CubicSemiLagrangian3.h>
+#include <SemiLagrangian/SemiLagrangian3.h>
+
+using namespace CubbyFlow;
+
+namespace
+{
+	// Rigid rotation around the center of the unit cube.
+	void InitializeFlow(FaceCenteredGrid3* flow)
+	{
+		flow->Fill([](const Vector3D& pt)
+		{
+			return Vector3D(0.5 - pt.y, pt.x - 0.5, 0.0);
+		});
+	}
+
+	void InitializeSDF(ScalarGrid3* sdf)
+	{
+		sdf->Fill([](const Vector3D& pt)
+		{
+			return pt.DistanceTo(Vector3D(0.5, 0.75, 0.5)) - 0.15;
+		});
+	}
+
+	template <typename SolverType>
+	void RunScalarAdvection(benchmark::State& state)
+	{
+		ScopedThreadCount threads(state);
+		const size_t n = static_cast<size_t>(state.range(0));
+		const Vector3D spacing = Vector3D(1.0, 1.0, 1.0) / static_cast<double>(n);
+
+		FaceCenteredGrid3 flow(Size3(n, n, n), spacing);
+		CellCenteredScalarGrid3 input(Size3(n, n, n), spacing);
+		CellCenteredScalarGrid3 output(Size3(n, n, n), spacing);
+		InitializeFlow(&flow);
+		InitializeSDF(&input);
+
+		SolverType solver;
+		for (auto _ : state)
+		{
+			solver.Advect(input, flow, 0.01, &output);
+		}
+
+		state.SetItemsProcessed(state.iterations() * n * n * n);
+	}
+
+	template <typename SolverType>
+	void RunFaceCenteredAdvection(benchmark::State& state)
+	{
+		ScopedThreadCount threads(state);
+		const size_t n = static_cast<size_t>(state.range(0));
+		const Vector3D spacing = Vector3D(1.0, 1.0, 1.0) / static_cast<double>(n);
+
+		FaceCenteredGrid3 flow(Size3(n, n, n), spacing);
+		FaceCenteredGrid3 output(Size3(n, n, n), spacing);
+		InitializeFlow(&flow);
+
+		SolverType solver;
+		for (auto _ : state)
+		{
+			solver.Advect(flow, flow, 0.01, &output);
+		}
+
+		state.SetItemsProcessed(state.iterations() * 3 * n * n * n);
+	}
+}
+
+static void BM_SemiLagrangian3_Scalar(benchmark::State& state)
+{
+	RunScalarAdvection<SemiLagrangian3>(state);
+}
+BENCHMARK(BM_SemiLagrangian3_Scalar)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(32, 64, 128)->UseRealTime();
+
+static void BM_SemiLagrangian3_FaceCentered(benchmark::State& state)
+{
+	RunFaceCenteredAdvection<SemiLagrangian3>(state);
+}
+BENCHMARK(BM_SemiLagrangian3_FaceCentered)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(32, 64, 128)->UseRealTime();
+
+static void BM_CubicSemiLagrangian3_Scalar(benchmark::State& state)
+{
+	RunScalarAdvection<CubicSemiLagrangian3>(state);
+}
+BENCHMARK(BM_CubicSemiLagrangian3_Scalar)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(32, 64, 128)->UseRealTime();
+
+static void BM_CubicSemiLagrangian3_FaceCentered(benchmark::State& state)
+{
+	RunFaceCenteredAdvection<CubicSemiLagrangian3>(state);
+}
+BENCHMARK(BM_CubicSemiLagrangian3_FaceCentered)->CUBBYFLOW_BENCHMARK_SIZES_AND_THREADS(32, 64, 128)->UseRealTime();
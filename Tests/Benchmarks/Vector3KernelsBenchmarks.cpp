@@ -0,0 +1,128 @@
+#include "BenchmarksUtils.h"
+
+#include <Transform/Transform3.h>
+#include <Vector/Vector3Kernels.h>
+
+using namespace CubbyFlow;
+
+// The scalar variants run the same operation through the Vector3D and
+// Matrix3x3D operators for comparison.
+
+static void BM_Vector3Kernels_AXPlusY(benchmark::State& state)
+{
+	const size_t n = static_cast<size_t>(state.range(0));
+	Array1<Vector3D> x, y;
+	GenerateRandomPoints(n, &x, 0);
+	GenerateRandomPoints(n, &y, 1);
+	Array1<Vector3D> result(n);
+	auto resultAccessor = result.Accessor();
+
+	for (auto _ : state)
+	{
+		Vector3Kernels::AXPlusY(0.5, x.ConstAccessor(), y.ConstAccessor(), &resultAccessor);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_Vector3Kernels_AXPlusY)->Arg(1 << 12)->Arg(1 << 20);
+
+static void BM_Vector3Kernels_AXPlusY_Scalar(benchmark::State& state)
+{
+	const size_t n = static_cast<size_t>(state.range(0));
+	Array1<Vector3D> x, y;
+	GenerateRandomPoints(n, &x, 0);
+	GenerateRandomPoints(n, &y, 1);
+	Array1<Vector3D> result(n);
+
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < n; ++i)
+		{
+			result[i] = 0.5 * x[i] + y[i];
+		}
+
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_Vector3Kernels_AXPlusY_Scalar)->Arg(1 << 12)->Arg(1 << 20);
+
+static void BM_Vector3Kernels_Transform(benchmark::State& state)
+{
+	const size_t n = static_cast<size_t>(state.range(0));
+	const Transform3 transform(Vector3D(1.0, -2.0, 0.5), QuaternionD(Vector3D(0.3, 1.0, -0.2), 0.7));
+	Array1<Vector3D> points;
+	GenerateRandomPoints(n, &points);
+	Array1<Vector3D> result(n);
+	auto resultAccessor = result.Accessor();
+
+	for (auto _ : state)
+	{
+		transform.ToLocal(points.ConstAccessor(), &resultAccessor);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_Vector3Kernels_Transform)->Arg(1 << 12)->Arg(1 << 20);
+
+static void BM_Vector3Kernels_Transform_Scalar(benchmark::State& state)
+{
+	const size_t n = static_cast<size_t>(state.range(0));
+	const Transform3 transform(Vector3D(1.0, -2.0, 0.5), QuaternionD(Vector3D(0.3, 1.0, -0.2), 0.7));
+	Array1<Vector3D> points;
+	GenerateRandomPoints(n, &points);
+	Array1<Vector3D> result(n);
+
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < n; ++i)
+		{
+			result[i] = transform.ToLocal(points[i]);
+		}
+
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_Vector3Kernels_Transform_Scalar)->Arg(1 << 12)->Arg(1 << 20);
+
+static void BM_Vector3Kernels_Normalize(benchmark::State& state)
+{
+	const size_t n = static_cast<size_t>(state.range(0));
+	Array1<Vector3D> points;
+	GenerateRandomPoints(n, &points);
+	auto pointsAccessor = points.Accessor();
+
+	for (auto _ : state)
+	{
+		Vector3Kernels::Normalize(&pointsAccessor);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_Vector3Kernels_Normalize)->Arg(1 << 12)->Arg(1 << 20);
+
+static void BM_Vector3Kernels_Normalize_Scalar(benchmark::State& state)
+{
+	const size_t n = static_cast<size_t>(state.range(0));
+	Array1<Vector3D> points;
+	GenerateRandomPoints(n, &points);
+
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < n; ++i)
+		{
+			points[i].Normalize();
+		}
+
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_Vector3Kernels_Normalize_Scalar)->Arg(1 << 12)->Arg(1 << 20);
@@ -0,0 +1,65 @@
+#include "pch.h"
+
+#include <Grid/VertexCenteredScalarGrid3.h>
+#include <PointsToImplicit/AnisotropicPointsToImplicit3.h>
+#include <PointsToImplicit/SPHPointsToImplicit3.h>
+
+#include <random>
+
+using namespace CubbyFlow;
+
+TEST(AnisotropicPointsToImplicit3, IsotropicLimit)
+{
+	std::mt19937 rng(0);
+	std::uniform_real_distribution<> d(0.2, 0.8);
+
+	Array1<Vector3D> points(300);
+	for (auto& point : points)
+	{
+		point = Vector3D(d(rng), d(rng), d(rng));
+	}
+
+	// Without smoothing and with too few neighbors for any particle, the
+	// kernels stay isotropic.
+	VertexCenteredScalarGrid3 grid(16, 16, 16, 0.0625, 0.0625, 0.0625);
+	AnisotropicPointsToImplicit3 converter(0.2, 0.5, 0.0, std::numeric_limits<size_t>::max());
+	converter.Convert(points.ConstAccessor(), &grid);
+
+	VertexCenteredScalarGrid3 expected(16, 16, 16, 0.0625, 0.0625, 0.0625);
+	SPHPointsToImplicit3 sphConverter(0.2, 0.5);
+	sphConverter.Convert(points.ConstAccessor(), &expected);
+
+	grid.ForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_DOUBLE_EQ(expected(i, j, k), grid(i, j, k));
+	});
+}
+
+TEST(AnisotropicPointsToImplicit3, FlattensSheet)
+{
+	// Points on a thin sheet at z = 0.5
+	Array1<Vector3D> points;
+	for (int j = 0; j <= 20; ++j)
+	{
+		for (int i = 0; i <= 20; ++i)
+		{
+			points.Append(Vector3D(0.25 + 0.025 * i, 0.25 + 0.025 * j, 0.5));
+		}
+	}
+
+	VertexCenteredScalarGrid3 anisotropic(20, 20, 20, 0.05, 0.05, 0.05);
+	AnisotropicPointsToImplicit3 converter(0.1, 0.5, 0.0, 10);
+	converter.Convert(points.ConstAccessor(), &anisotropic);
+
+	VertexCenteredScalarGrid3 isotropic(20, 20, 20, 0.05, 0.05, 0.05);
+	SPHPointsToImplicit3 sphConverter(0.1, 0.5);
+	sphConverter.Convert(points.ConstAccessor(), &isotropic);
+
+	// Both contain the sheet, but the anisotropic kernels are squashed along
+	// the normal so the field falls off faster away from the sheet.
+	EXPECT_GT(0.0, anisotropic(10, 10, 10));
+	EXPECT_GT(0.0, isotropic(10, 10, 10));
+	EXPECT_GT(anisotropic(10, 10, 11), isotropic(10, 10, 11));
+	EXPECT_LT(anisotropic(10, 10, 10), isotropic(10, 10, 10));
+	EXPECT_DOUBLE_EQ(0.5, anisotropic(10, 10, 14));
+}
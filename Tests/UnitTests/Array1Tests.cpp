@@ -2,6 +2,7 @@
 
 #include <Array/Array1.h>
 #include <Utils/Serialization.h>
+#include <Vector/Vector3.h>
 
 using namespace CubbyFlow;
 
@@ -190,4 +191,16 @@ TEST(Array1, Serialization)
 	// Deserialize to non-zero array
 	Deserialize(buffer1, &arr3);
 	EXPECT_EQ(0u, arr3.size());
-}
\ No newline at end of file
+}
+
+TEST(Array1, Alignment)
+{
+	for (size_t n : { 1, 3, 17, 1000 })
+	{
+		Array1<Vector3D> arr(n);
+		EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(arr.data()) % 64);
+
+		arr.Append(Vector3D(1.0, 2.0, 3.0));
+		EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(arr.data()) % 64);
+	}
+}
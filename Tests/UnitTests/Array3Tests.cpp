@@ -311,4 +311,13 @@ TEST(Array3, ParallelForEachIndex)
 		size_t idx = i + (4 * (j + 3 * k)) + 1;
 		EXPECT_FLOAT_EQ(static_cast<float>(idx), arr1(i, j, k));
 	});
-}
\ No newline at end of file
+}
+
+TEST(Array3, Alignment)
+{
+	Array3<double> arr(5, 7, 3);
+	EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(arr.data()) % 64);
+
+	arr.Resize(31, 9, 4);
+	EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(arr.data()) % 64);
+}
@@ -4,6 +4,9 @@
 #include <Array/Array2.h>
 #include <Array/Array3.h>
 #include <Array/ArrayUtils.h>
+#include <Vector/Vector3.h>
+
+#include <random>
 
 using namespace CubbyFlow;
 
@@ -181,6 +184,79 @@ TEST(ArrayUtils, ExtrapolateToRegion3)
 	}
 }
 
+TEST(ArrayUtils, ExtrapolateToRegion3Frontier)
+{
+	const Size3 size(41, 37, 33);
+	Array3<Vector3D> data(size);
+	Array3<char> valid(size, 0);
+
+	std::mt19937 rng(0);
+	std::uniform_real_distribution<double> d(-1.0, 1.0);
+
+	// Scattered valid blobs so that the fronts collide
+	data.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		data(i, j, k) = Vector3D(d(rng), d(rng), d(rng));
+		valid(i, j, k) = (d(rng) > 0.995 || (i < 4 && j > 30)) ? 1 : 0;
+	});
+
+	// Reference: full sweeps over the whole grid
+	const unsigned int depth = 7;
+	Array3<Vector3D> expected(data);
+	Array3<char> valid0(valid), valid1(size, 0);
+
+	for (unsigned int iter = 0; iter < depth; ++iter)
+	{
+		valid0.ForEachIndex([&](size_t i, size_t j, size_t k)
+		{
+			if (valid0(i, j, k))
+			{
+				valid1(i, j, k) = 1;
+				return;
+			}
+
+			Vector3D sum;
+			unsigned int count = 0;
+			const int offsets[6][3] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+
+			for (const auto& offset : offsets)
+			{
+				// Out of range indices wrap around to large values
+				const size_t ni = i + static_cast<size_t>(offset[0]);
+				const size_t nj = j + static_cast<size_t>(offset[1]);
+				const size_t nk = k + static_cast<size_t>(offset[2]);
+
+				if (ni < size.x && nj < size.y && nk < size.z && valid0(ni, nj, nk))
+				{
+					sum += expected(ni, nj, nk);
+					++count;
+				}
+			}
+
+			if (count > 0)
+			{
+				expected(i, j, k) = sum / static_cast<double>(count);
+				valid1(i, j, k) = 1;
+			}
+		});
+
+		valid0.Swap(valid1);
+	}
+
+	Array3<Vector3D> output(size);
+	ExtrapolateToRegion(data.ConstAccessor(), valid.ConstAccessor(), depth, output.Accessor());
+
+	// Second call reuses the buffers with another size
+	Array3<Vector3D> small(3, 4, 5);
+	Array3<char> smallValid(3, 4, 5, 0);
+	ExtrapolateToRegion(small.ConstAccessor(), smallValid.ConstAccessor(), depth, small.Accessor());
+
+	output.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_EQ(expected(i, j, k), output(i, j, k));
+	});
+}
+
 TEST(ArrayUtils, ConvertToCSV)
 {
 	Array2<double> array = { { 1.0, 2.0, 3.0 },{ 4.0, 5.0, 6.0 } };
@@ -256,4 +256,27 @@ TEST(BVH3, ForEachOverlappingItems)
 	});
 
 	EXPECT_EQ(numOverlaps, measured);
+}
+
+TEST(BVH3, Rebuild)
+{
+	BVH3<Vector3D> bvh;
+
+	std::vector<Vector3D> points{ Vector3D(10, 10, 10), Vector3D(20, 20, 20) };
+	std::vector<BoundingBox3D> bounds{ BoundingBox3D(points[0], points[0]), BoundingBox3D(points[1], points[1]) };
+	bvh.Build(points, bounds);
+
+	points = { Vector3D(0, 0, 0), Vector3D(1, 2, 3) };
+	bounds = { BoundingBox3D(points[0], points[0]), BoundingBox3D(points[1], points[1]) };
+	bvh.Build(points, bounds);
+
+	EXPECT_EQ(Vector3D(0, 0, 0), bvh.GetBoundingBox().lowerCorner);
+	EXPECT_EQ(Vector3D(1, 2, 3), bvh.GetBoundingBox().upperCorner);
+
+	bvh.Build({}, {});
+	auto nearest = bvh.GetNearestNeighbor(Vector3D(), [](const Vector3D& a, const Vector3D& b)
+	{
+		return a.DistanceTo(b);
+	});
+	EXPECT_EQ(nullptr, nearest.item);
 }
\ No newline at end of file
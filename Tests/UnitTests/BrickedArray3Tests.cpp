@@ -0,0 +1,199 @@
+#include "pch.h"
+
+#include <Array/Array3.h>
+#include <Array/ArraySamplers3.h>
+#include <Array/BrickedArraySamplers3.h>
+
+using namespace CubbyFlow;
+
+TEST(BrickedArray3, Constructors)
+{
+	BrickedArray3<double> arr;
+	EXPECT_EQ(0u, arr.Width());
+	EXPECT_EQ(0u, arr.Height());
+	EXPECT_EQ(0u, arr.Depth());
+
+	BrickedArray3<double> arr2(Size3(10, 8, 17), 2.0);
+	EXPECT_EQ(Size3(10, 8, 17), arr2.size());
+	EXPECT_EQ(Size3(2, 1, 3), arr2.NumberOfBricks());
+	for (size_t k = 0; k < 17; ++k)
+	{
+		for (size_t j = 0; j < 8; ++j)
+		{
+			for (size_t i = 0; i < 10; ++i)
+			{
+				EXPECT_EQ(2.0, arr2(i, j, k));
+			}
+		}
+	}
+
+	Array3<double> flat(5, 9, 3);
+	flat.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		flat(i, j, k) = static_cast<double>(i + 10 * j + 100 * k);
+	});
+
+	BrickedArray3<double> arr3(flat.ConstAccessor());
+	EXPECT_EQ(flat.size(), arr3.size());
+	flat.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_EQ(flat(i, j, k), arr3(i, j, k));
+	});
+}
+
+TEST(BrickedArray3, IndexOf)
+{
+	BrickedArray3<int> arr(Size3(20, 12, 9));
+
+	// Elements of a brick are contiguous in i-first order
+	EXPECT_EQ(0u, arr.IndexOf(0, 0, 0));
+	EXPECT_EQ(1u, arr.IndexOf(1, 0, 0));
+	EXPECT_EQ(8u, arr.IndexOf(0, 1, 0));
+	EXPECT_EQ(64u, arr.IndexOf(0, 0, 1));
+	EXPECT_EQ(511u, arr.IndexOf(7, 7, 7));
+
+	// Followed by the next brick along i, then j and k
+	EXPECT_EQ(512u, arr.IndexOf(8, 0, 0));
+	EXPECT_EQ(3u * 512u, arr.IndexOf(0, 8, 0));
+	EXPECT_EQ(6u * 512u, arr.IndexOf(0, 0, 8));
+
+	// Every element has its own slot
+	std::vector<int> counts(arr.NumberOfBricks().x * arr.NumberOfBricks().y * arr.NumberOfBricks().z * 512, 0);
+	for (size_t k = 0; k < 9; ++k)
+	{
+		for (size_t j = 0; j < 12; ++j)
+		{
+			for (size_t i = 0; i < 20; ++i)
+			{
+				++counts[arr.IndexOf(i, j, k)];
+			}
+		}
+	}
+
+	EXPECT_EQ(20 * 12 * 9, std::count(counts.begin(), counts.end(), 1));
+}
+
+TEST(BrickedArray3, Resize)
+{
+	BrickedArray3<double> arr(Size3(10, 10, 10));
+	for (size_t k = 0; k < 10; ++k)
+	{
+		for (size_t j = 0; j < 10; ++j)
+		{
+			for (size_t i = 0; i < 10; ++i)
+			{
+				arr(i, j, k) = static_cast<double>(i + 10 * j + 100 * k);
+			}
+		}
+	}
+
+	arr.Resize(Size3(12, 5, 20), -1.0);
+	EXPECT_EQ(Size3(12, 5, 20), arr.size());
+	EXPECT_EQ(Size3(2, 1, 3), arr.NumberOfBricks());
+
+	for (size_t k = 0; k < 20; ++k)
+	{
+		for (size_t j = 0; j < 5; ++j)
+		{
+			for (size_t i = 0; i < 12; ++i)
+			{
+				if (i < 10 && k < 10)
+				{
+					EXPECT_EQ(static_cast<double>(i + 10 * j + 100 * k), arr(i, j, k));
+				}
+				else
+				{
+					EXPECT_EQ(-1.0, arr(i, j, k));
+				}
+			}
+		}
+	}
+
+	arr.Set(3.0);
+	EXPECT_EQ(3.0, arr(11, 4, 19));
+}
+
+TEST(BrickedArray3, CopyFromAndCopyTo)
+{
+	Array3<Vector3D> flat(13, 7, 11);
+	flat.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		flat(i, j, k) = Vector3D(static_cast<double>(i), static_cast<double>(j), static_cast<double>(k));
+	});
+
+	BrickedArray3<Vector3D> arr;
+	arr.CopyFrom(flat.ConstAccessor());
+	EXPECT_EQ(flat.size(), arr.size());
+
+	Array3<Vector3D> result(13, 7, 11);
+	arr.CopyTo(result.Accessor());
+
+	flat.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_EQ(flat(i, j, k), arr(i, j, k));
+		EXPECT_EQ(flat(i, j, k), result(i, j, k));
+	});
+}
+
+TEST(BrickedArray3, ForEachIndex)
+{
+	BrickedArray3<int> arr(Size3(20, 12, 9), 0);
+
+	// The elements are visited once each, brick by brick
+	std::vector<size_t> visited;
+	arr.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		visited.push_back(arr.IndexOf(i, j, k));
+		++arr(i, j, k);
+	});
+
+	EXPECT_EQ(20u * 12u * 9u, visited.size());
+	EXPECT_TRUE(std::is_sorted(visited.begin(), visited.end()));
+
+	arr.ParallelForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		++arr(i, j, k);
+	});
+
+	for (size_t k = 0; k < 9; ++k)
+	{
+		for (size_t j = 0; j < 12; ++j)
+		{
+			for (size_t i = 0; i < 20; ++i)
+			{
+				EXPECT_EQ(2, arr(i, j, k));
+			}
+		}
+	}
+}
+
+TEST(LinearBrickedArraySampler3, Sample)
+{
+	Array3<double> flat(17, 9, 10);
+	flat.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		flat(i, j, k) = std::sin(0.3 * i) + std::cos(0.7 * j) + 0.1 * k * i;
+	});
+
+	const BrickedArray3<double> arr(flat.ConstAccessor());
+	const Vector3D spacing(0.5, 0.25, 1.0);
+	const Vector3D origin(-1.0, 0.5, 2.0);
+
+	const LinearArraySampler3<double, double> expected(flat.ConstAccessor(), spacing, origin);
+	const LinearBrickedArraySampler3<double, double> sampler(arr, spacing, origin);
+	const auto functor = sampler.Functor();
+
+	// Points across the brick borders and outside of the array
+	for (double z = 1.0; z < 13.0; z += 0.37)
+	{
+		for (double y = 0.0; y < 3.5; y += 0.11)
+		{
+			for (double x = -2.0; x < 8.0; x += 0.29)
+			{
+				const Vector3D pt(x, y, z);
+				EXPECT_DOUBLE_EQ(expected(pt), sampler(pt));
+				EXPECT_DOUBLE_EQ(expected(pt), functor(pt));
+			}
+		}
+	}
+}
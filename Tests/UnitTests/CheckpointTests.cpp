@@ -0,0 +1,339 @@
+#include "pch.h"
+
+#include <Collider/RigidBodyCollider3.h>
+#include <Emitter/VolumeParticleEmitter3.h>
+#include <Geometry/Box3.h>
+#include <Geometry/Sphere3.h>
+#include <Grid/CellCenteredScalarGrid3.h>
+#include <Grid/GridSystemData3.h>
+#include <Solver/APIC/APICSolver3.h>
+#include <Solver/PCISPH/PCISPHSolver3.h>
+#include <Surface/Implicit/SurfaceToImplicit3.h>
+#include <Utils/Checkpoint.h>
+
+#include <cstdio>
+
+using namespace CubbyFlow;
+
+namespace
+{
+	const char* CHECKPOINT_FILE_NAME = "CheckpointTests.ckpt";
+
+	void SetUpSPHScene(PCISPHSolver3* solver)
+	{
+		solver->SetPseudoViscosityCoefficient(0.0);
+
+		auto particles = solver->GetSPHSystemData();
+		particles->SetTargetDensity(1000.0);
+		particles->SetTargetSpacing(0.1);
+
+		auto sphere = std::make_shared<SurfaceToImplicit3>(
+			std::make_shared<Sphere3>(Vector3D(0.5, 0.5, 0.5), 0.3));
+		BoundingBox3D bounds(Vector3D(), Vector3D(1, 1, 1));
+		auto emitter = std::make_shared<VolumeParticleEmitter3>(
+			sphere, bounds, 0.1, Vector3D(), std::numeric_limits<size_t>::max(),
+			0.2, true, false, 7);
+		solver->SetEmitter(emitter);
+
+		auto box = std::make_shared<Box3>(bounds, Transform3(), true);
+		auto collider = std::make_shared<RigidBodyCollider3>(box);
+		collider->linearVelocity = Vector3D(0.1, 0.0, 0.0);
+		solver->SetCollider(collider);
+	}
+
+	void SetUpAPICScene(APICSolver3* solver)
+	{
+		auto sphere = std::make_shared<SurfaceToImplicit3>(
+			std::make_shared<Sphere3>(Vector3D(0.5, 0.6, 0.5), 0.25));
+		BoundingBox3D bounds(Vector3D(), Vector3D(1, 1, 1));
+		auto emitter = std::make_shared<VolumeParticleEmitter3>(
+			sphere, bounds, 0.05, Vector3D(), std::numeric_limits<size_t>::max(),
+			0.5, true, false, 3);
+		solver->SetParticleEmitter(emitter);
+	}
+}
+
+TEST(Checkpoint, WriteAndRead)
+{
+	Array1<double> scalars = { 1.0, 2.0, 3.0, 4.0, 5.0 };
+	Array1<Vector3D> vectors = { { 1.0, 2.0, 3.0 }, { -4.0, 5.0, -6.0 } };
+	Array3<float> volume(3, 4, 5);
+	volume.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		volume(i, j, k) = static_cast<float>(i + 10 * j + 100 * k);
+	});
+
+	{
+		CheckpointWriter writer(CHECKPOINT_FILE_NAME);
+		EXPECT_TRUE(writer.IsOpen());
+
+		writer.WriteValue("value", 42);
+		writer.WriteArray("scalars", scalars.ConstAccessor());
+		writer.WriteString("string", "CubbyFlow");
+		writer.WriteArray("vectors", vectors.ConstAccessor());
+		writer.WriteArray("volume", volume.ConstAccessor());
+		writer.WriteChunk("empty", nullptr, 0);
+	}
+
+	CheckpointReader reader(CHECKPOINT_FILE_NAME);
+	EXPECT_TRUE(reader.IsOpen());
+	EXPECT_TRUE(reader.HasChunk("scalars"));
+	EXPECT_FALSE(reader.HasChunk("missing"));
+
+	int value = 0;
+	reader.ReadValue("value", &value);
+	EXPECT_EQ(42, value);
+
+	EXPECT_EQ("CubbyFlow", reader.ReadString("string"));
+	EXPECT_EQ(0u, reader.ChunkSize("empty"));
+
+	auto scalarView = reader.ViewArray<double>("scalars");
+	EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(scalarView.data()) % CheckpointWriter::ChunkAlignment);
+	ASSERT_EQ(scalars.size(), scalarView.size());
+	for (size_t i = 0; i < scalars.size(); ++i)
+	{
+		EXPECT_EQ(scalars[i], scalarView[i]);
+	}
+
+	Array1<Vector3D> vectors2;
+	reader.ReadArray("vectors", &vectors2);
+	ASSERT_EQ(vectors.size(), vectors2.size());
+	for (size_t i = 0; i < vectors.size(); ++i)
+	{
+		EXPECT_EQ(vectors[i], vectors2[i]);
+	}
+
+	Array3<float> volume2(3, 4, 5);
+	reader.ReadArray("volume", volume2.Accessor());
+	volume.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_EQ(volume(i, j, k), volume2(i, j, k));
+	});
+
+	double wrongSize;
+	EXPECT_THROW(reader.ReadValue("value", &wrongSize), std::runtime_error);
+	EXPECT_THROW(reader.ReadString("missing"), std::runtime_error);
+
+	Array3<float> wrongVolume(2, 2, 2);
+	EXPECT_THROW(reader.ReadArray("volume", wrongVolume.Accessor()), std::runtime_error);
+}
+
+TEST(Checkpoint, InvalidFile)
+{
+	{
+		std::ofstream file(CHECKPOINT_FILE_NAME, std::ios::binary);
+		file << "Not a checkpoint";
+	}
+
+	CheckpointReader reader(CHECKPOINT_FILE_NAME);
+	EXPECT_FALSE(reader.IsOpen());
+
+	CheckpointReader reader2("CheckpointTests.missing");
+	EXPECT_FALSE(reader2.IsOpen());
+
+	std::remove(CHECKPOINT_FILE_NAME);
+}
+
+TEST(Checkpoint, ParticleSystemData3)
+{
+	ParticleSystemData3 particleSystem;
+	particleSystem.AddParticles(
+		Array1<Vector3D>({ { 0.1, 0.2, 0.3 }, { 0.4, 0.5, 0.6 }, { 0.7, 0.8, 0.9 } }),
+		Array1<Vector3D>({ { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 }, { 0.0, 0.0, 1.0 } }));
+	size_t a0 = particleSystem.AddScalarData(2.0);
+	size_t a1 = particleSystem.AddVectorData({ 1.0, -3.0, 5.0 });
+	particleSystem.SetRadius(0.25);
+	particleSystem.SetMass(0.5);
+
+	{
+		CheckpointWriter writer(CHECKPOINT_FILE_NAME);
+		particleSystem.SaveCheckpoint(&writer, "particles.");
+	}
+
+	ParticleSystemData3 particleSystem2;
+	{
+		CheckpointReader reader(CHECKPOINT_FILE_NAME);
+		particleSystem2.LoadCheckpoint(reader, "particles.");
+	}
+	std::remove(CHECKPOINT_FILE_NAME);
+
+	EXPECT_EQ(3u, particleSystem2.NumberOfParticles());
+	EXPECT_DOUBLE_EQ(0.25, particleSystem2.GetRadius());
+	EXPECT_DOUBLE_EQ(0.5, particleSystem2.GetMass());
+
+	for (size_t i = 0; i < 3; ++i)
+	{
+		EXPECT_EQ(particleSystem.GetPositions()[i], particleSystem2.GetPositions()[i]);
+		EXPECT_EQ(particleSystem.GetVelocities()[i], particleSystem2.GetVelocities()[i]);
+		EXPECT_EQ(2.0, particleSystem2.ScalarDataAt(a0)[i]);
+		EXPECT_EQ(Vector3D(1.0, -3.0, 5.0), particleSystem2.VectorDataAt(a1)[i]);
+	}
+}
+
+TEST(Checkpoint, FileBackedParticleData)
+{
+	ParticleSystemData3 particleSystem(5000);
+	particleSystem.SetBackingDirectory(".");
+	size_t a0 = particleSystem.AddScalarData();
+	for (size_t i = 0; i < 5000; ++i)
+	{
+		particleSystem.GetPositions()[i] = Vector3D(0.0, static_cast<double>(i), 1.0);
+		particleSystem.ScalarDataAt(a0)[i] = static_cast<double>(i);
+	}
+
+	{
+		CheckpointWriter writer(CHECKPOINT_FILE_NAME);
+		particleSystem.SaveCheckpoint(&writer, "particles.");
+	}
+
+	// The loaded layers stay in the backing files of the target
+	ParticleSystemData3 particleSystem2;
+	particleSystem2.SetBackingDirectory(".");
+	{
+		CheckpointReader reader(CHECKPOINT_FILE_NAME);
+		particleSystem2.LoadCheckpoint(reader, "particles.");
+	}
+	std::remove(CHECKPOINT_FILE_NAME);
+
+	EXPECT_EQ(5000u, particleSystem2.NumberOfParticles());
+	EXPECT_EQ(1u, particleSystem2.NumberOfScalarData());
+	EXPECT_EQ(".", particleSystem2.GetBackingDirectory());
+
+	for (size_t i = 0; i < 5000; ++i)
+	{
+		EXPECT_EQ(Vector3D(0.0, static_cast<double>(i), 1.0), particleSystem2.GetPositions()[i]);
+		EXPECT_EQ(static_cast<double>(i), particleSystem2.ScalarDataAt(a0)[i]);
+	}
+}
+
+TEST(Checkpoint, GridSystemData3)
+{
+	GridSystemData3 grids({ 4, 5, 6 }, { 0.5, 0.5, 0.5 }, { 1.0, 2.0, 3.0 });
+	size_t scalarIdx = grids.AddAdvectableScalarData(std::make_shared<CellCenteredScalarGrid3::Builder>(), 1.0);
+	auto velocity = grids.GetVelocity();
+	velocity->Fill([](const Vector3D& pt) { return Vector3D(pt.y, -pt.x, pt.z); });
+
+	{
+		CheckpointWriter writer(CHECKPOINT_FILE_NAME);
+		grids.SaveCheckpoint(&writer, "grids.");
+	}
+
+	GridSystemData3 grids2;
+	auto velocity2 = grids2.GetVelocity();
+	{
+		CheckpointReader reader(CHECKPOINT_FILE_NAME);
+		grids2.LoadCheckpoint(reader, "grids.");
+	}
+	std::remove(CHECKPOINT_FILE_NAME);
+
+	EXPECT_EQ(Size3(4, 5, 6), grids2.GetResolution());
+	EXPECT_EQ(Vector3D(0.5, 0.5, 0.5), grids2.GetGridSpacing());
+	EXPECT_EQ(Vector3D(1.0, 2.0, 3.0), grids2.GetOrigin());
+	EXPECT_EQ(1u, grids2.GetNumberOfAdvectableScalarData());
+
+	// The existing velocity grid is reused.
+	EXPECT_EQ(velocity2, grids2.GetVelocity());
+
+	velocity->ForEachUIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_EQ(velocity->GetU(i, j, k), velocity2->GetU(i, j, k));
+	});
+	velocity->ForEachWIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_EQ(velocity->GetW(i, j, k), velocity2->GetW(i, j, k));
+	});
+
+	auto scalar2 = grids2.GetAdvectableScalarDataAt(scalarIdx);
+	EXPECT_EQ("CellCenteredScalarGrid3", scalar2->TypeName());
+	scalar2->ForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_EQ(1.0, (*scalar2)(i, j, k));
+	});
+}
+
+TEST(Checkpoint, PCISPHSolver3Restart)
+{
+	PCISPHSolver3 solver;
+	SetUpSPHScene(&solver);
+
+	Frame frame(0, 1.0 / 60.0);
+	for (; frame.index < 3; ++frame)
+	{
+		solver.Update(frame);
+	}
+
+	EXPECT_TRUE(solver.SaveCheckpoint(CHECKPOINT_FILE_NAME));
+
+	PCISPHSolver3 solver2;
+	SetUpSPHScene(&solver2);
+	EXPECT_TRUE(solver2.LoadCheckpoint(CHECKPOINT_FILE_NAME));
+	std::remove(CHECKPOINT_FILE_NAME);
+
+	EXPECT_EQ(solver.CurrentFrame().index, solver2.CurrentFrame().index);
+	EXPECT_EQ(solver.CurrentTimeInSeconds(), solver2.CurrentTimeInSeconds());
+
+	for (; frame.index < 6; ++frame)
+	{
+		solver.Update(frame);
+		solver2.Update(frame);
+	}
+
+	auto particles = solver.GetSPHSystemData();
+	auto particles2 = solver2.GetSPHSystemData();
+	ASSERT_EQ(particles->NumberOfParticles(), particles2->NumberOfParticles());
+	EXPECT_GT(particles->NumberOfParticles(), 0u);
+
+	for (size_t i = 0; i < particles->NumberOfParticles(); ++i)
+	{
+		EXPECT_EQ(particles->GetPositions()[i], particles2->GetPositions()[i]);
+		EXPECT_EQ(particles->GetVelocities()[i], particles2->GetVelocities()[i]);
+	}
+
+	auto collider = std::dynamic_pointer_cast<RigidBodyCollider3>(solver.GetCollider());
+	auto collider2 = std::dynamic_pointer_cast<RigidBodyCollider3>(solver2.GetCollider());
+	EXPECT_EQ(collider->linearVelocity, collider2->linearVelocity);
+	EXPECT_EQ(collider->Surface()->transform.GetTranslation(), collider2->Surface()->transform.GetTranslation());
+}
+
+TEST(Checkpoint, APICSolver3Restart)
+{
+	APICSolver3 solver({ 10, 10, 10 }, { 0.1, 0.1, 0.1 }, { 0, 0, 0 });
+	SetUpAPICScene(&solver);
+
+	Frame frame(0, 1.0 / 60.0);
+	for (; frame.index < 2; ++frame)
+	{
+		solver.Update(frame);
+	}
+
+	EXPECT_TRUE(solver.SaveCheckpoint(CHECKPOINT_FILE_NAME));
+
+	APICSolver3 solver2({ 10, 10, 10 }, { 0.1, 0.1, 0.1 }, { 0, 0, 0 });
+	SetUpAPICScene(&solver2);
+	EXPECT_TRUE(solver2.LoadCheckpoint(CHECKPOINT_FILE_NAME));
+	std::remove(CHECKPOINT_FILE_NAME);
+
+	for (; frame.index < 4; ++frame)
+	{
+		solver.Update(frame);
+		solver2.Update(frame);
+	}
+
+	auto particles = solver.GetParticleSystemData();
+	auto particles2 = solver2.GetParticleSystemData();
+	ASSERT_EQ(particles->NumberOfParticles(), particles2->NumberOfParticles());
+	EXPECT_GT(particles->NumberOfParticles(), 0u);
+
+	for (size_t i = 0; i < particles->NumberOfParticles(); ++i)
+	{
+		EXPECT_EQ(particles->GetPositions()[i], particles2->GetPositions()[i]);
+		EXPECT_EQ(particles->GetVelocities()[i], particles2->GetVelocities()[i]);
+	}
+
+	auto velocity = solver.GetGridSystemData()->GetVelocity();
+	auto velocity2 = solver2.GetGridSystemData()->GetVelocity();
+	velocity->ForEachVIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_EQ(velocity->GetV(i, j, k), velocity2->GetV(i, j, k));
+	});
+}
@@ -3,6 +3,7 @@
 #include <Geometry/Box3.h>
 #include <Collider/ColliderSet3.h>
 #include <Collider/RigidBodyCollider3.h>
+#include <Geometry/Sphere3.h>
 
 using namespace CubbyFlow;
 
@@ -67,4 +68,49 @@ TEST(ColliderSet3, Builder)
 
 	auto colSet3 = ColliderSet3::GetBuilder().Build();
 	EXPECT_EQ(0u, colSet3.NumberOfColliders());
+}
+
+TEST(ColliderSet3, VelocityAt)
+{
+	ColliderSet3 colliderSet;
+
+	for (size_t i = 0; i < 32; ++i)
+	{
+		auto sphere = std::make_shared<Sphere3>(Vector3D(static_cast<double>(i), 0.0, 0.0), 0.25);
+		auto collider = std::make_shared<RigidBodyCollider3>(sphere);
+		collider->linearVelocity = Vector3D(static_cast<double>(i), 0.0, 0.0);
+		colliderSet.AddCollider(collider);
+	}
+
+	EXPECT_EQ(Vector3D(0.0, 0.0, 0.0), colliderSet.VelocityAt(Vector3D(-3.0, 0.0, 0.0)));
+	EXPECT_EQ(Vector3D(7.0, 0.0, 0.0), colliderSet.VelocityAt(Vector3D(7.2, 1.0, 0.0)));
+	EXPECT_EQ(Vector3D(31.0, 0.0, 0.0), colliderSet.VelocityAt(Vector3D(40.0, 0.0, 0.0)));
+
+	// Move one of the colliders and update the query engine
+	auto moved = colliderSet.Collider(3);
+	moved->Surface()->transform = Transform3(Vector3D(0.0, 10.0, 0.0), QuaternionD());
+	colliderSet.Update(0.0, 0.01);
+
+	EXPECT_EQ(Vector3D(3.0, 0.0, 0.0), colliderSet.VelocityAt(Vector3D(3.0, 10.0, 0.0)));
+}
+
+TEST(ColliderSet3, NestedVelocityAt)
+{
+	auto sphere0 = std::make_shared<Sphere3>(Vector3D(0.0, 0.0, 0.0), 0.25);
+	auto sphere1 = std::make_shared<Sphere3>(Vector3D(5.0, 0.0, 0.0), 0.25);
+	auto sphere2 = std::make_shared<Sphere3>(Vector3D(10.0, 0.0, 0.0), 0.25);
+	auto collider0 = std::make_shared<RigidBodyCollider3>(sphere0);
+	auto collider1 = std::make_shared<RigidBodyCollider3>(sphere1);
+	auto collider2 = std::make_shared<RigidBodyCollider3>(sphere2);
+	collider0->linearVelocity = Vector3D(1.0, 0.0, 0.0);
+	collider1->linearVelocity = Vector3D(2.0, 0.0, 0.0);
+	collider2->linearVelocity = Vector3D(3.0, 0.0, 0.0);
+
+	// The surface of the inner set is a SurfaceSet3 itself
+	auto innerSet = std::make_shared<ColliderSet3>(std::vector<Collider3Ptr>{ collider2, collider1 });
+	ColliderSet3 colliderSet({ innerSet, collider0 });
+
+	EXPECT_EQ(Vector3D(1.0, 0.0, 0.0), colliderSet.VelocityAt(Vector3D(-1.0, 0.0, 0.0)));
+	EXPECT_EQ(Vector3D(2.0, 0.0, 0.0), colliderSet.VelocityAt(Vector3D(5.0, 1.0, 0.0)));
+	EXPECT_EQ(Vector3D(3.0, 0.0, 0.0), colliderSet.VelocityAt(Vector3D(11.0, 0.0, 0.0)));
 }
\ No newline at end of file
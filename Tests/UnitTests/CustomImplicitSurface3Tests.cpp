@@ -113,4 +113,87 @@ TEST(CustomImplicitSurface3, ClosestIntersection)
 		EXPECT_VECTOR3_NEAR(refAns.point, actAns.point, 1e-5);
 		EXPECT_VECTOR3_NEAR(refAns.normal, actAns.normal, 1e-5);	
 	}
-}
\ No newline at end of file
+}
+
+TEST(CustomImplicitSurface3, BakedDistanceField)
+{
+	auto sphere = Sphere3::Builder()
+		 .WithCenter({ 0.5, 0.45, 0.55 })
+		 .WithRadius(0.3)
+		 .MakeShared();
+	SurfaceToImplicit3 refSurf(sphere);
+	auto cis = CustomImplicitSurface3::Builder()
+		.WithSignedDistanceFunction([&](const Vector3D& pt)
+		{
+			return refSurf.SignedDistance(pt);
+		})
+		.WithDomain(BoundingBox3D({ 0, 0, 0 }, { 1, 1, 1 }))
+		.WithResolution(1e-3)
+		.WithBakedDistanceField(7, 1e-3)
+		.MakeShared();
+
+	EXPECT_TRUE(cis->IsDistanceFieldBaked());
+
+	for (size_t i = 0; i < GetNumberOfSamplePoints3(); ++i)
+	{
+		auto sample = GetSamplePoints3()[i];
+		if ((sample - sphere->center).Length() > 0.05)
+		{
+			EXPECT_NEAR(refSurf.SignedDistance(sample), cis->SignedDistance(sample), 1e-3);
+			EXPECT_VECTOR3_NEAR(refSurf.ClosestPoint(sample), cis->ClosestPoint(sample), 1e-3);
+			EXPECT_VECTOR3_NEAR(refSurf.ClosestNormal(sample), cis->ClosestNormal(sample), 1e-2);
+		}
+
+		auto d = GetSampleDirs3()[i];
+		auto refAns = refSurf.ClosestIntersection(Ray3D(sample, d));
+		auto actAns = cis->ClosestIntersection(Ray3D(sample, d));
+
+		EXPECT_EQ(refAns.isIntersecting, cis->Intersects(Ray3D(sample, d)));
+		EXPECT_EQ(refAns.isIntersecting, actAns.isIntersecting);
+		if (refAns.isIntersecting)
+		{
+			// The error of the distance along grazing rays is amplified, so check
+			// that the hit point is on the surface instead.
+			EXPECT_NEAR(0.0, refSurf.SignedDistance(actAns.point), 1e-3);
+			EXPECT_NEAR(refAns.distance, actAns.distance, 5e-3);
+		}
+	}
+}
+
+TEST(CustomImplicitSurface3, BakedDistanceFieldIsAdaptive)
+{
+	// A plane is reproduced exactly by the trilinear interpolation, so only
+	// the cells down to the min depth are needed.
+	CustomImplicitSurface3 plane([](const Vector3D& pt)
+	{
+		return pt.y - 0.3;
+	}, BoundingBox3D({ 0, 0, 0 }, { 1, 1, 1 }), 1e-3);
+	plane.BakeDistanceField(8, 1e-6);
+
+	EXPECT_TRUE(plane.IsDistanceFieldBaked());
+	EXPECT_NEAR(0.2, plane.SignedDistance({ 0.1, 0.5, 0.7 }), 1e-12);
+	EXPECT_VECTOR3_NEAR(Vector3D(0.2, 0.3, 0.4), plane.ClosestPoint({ 0.2, 0.9, 0.4 }), 1e-12);
+
+	// A uniform grid at the max depth would have 8^8 cells.
+	EXPECT_GT((size_t(1) << 24) / 1000, plane.GetBakedDistanceField()->NumberOfLeaves());
+
+	// A sphere needs fine cells near the surface only.
+	CustomImplicitSurface3 sphere([](const Vector3D& pt)
+	{
+		return pt.DistanceTo({ 0.5, 0.5, 0.5 }) - 0.3;
+	}, BoundingBox3D({ 0, 0, 0 }, { 1, 1, 1 }), 1e-3);
+	sphere.BakeDistanceField(7, 1e-3);
+
+	// A uniform grid at the max depth would have 8^7 cells.
+	EXPECT_GT((size_t(1) << 21) / 10, sphere.GetBakedDistanceField()->NumberOfLeaves());
+	EXPECT_NEAR(0.1, sphere.SignedDistance({ 0.9, 0.5, 0.5 }), 1e-3);
+
+	// Without a bounded domain, nothing is baked.
+	CustomImplicitSurface3 unbounded([](const Vector3D& pt)
+	{
+		return pt.y - 0.3;
+	});
+	unbounded.BakeDistanceField();
+
+	EXPECT_FALSE(unbounded.IsDistanceFieldBaked());
+}
@@ -0,0 +1,187 @@
+#include "pch.h"
+
+#include <Animation/EnsembleRunner.h>
+#include <Geometry/ImplicitTriangleMesh3.h>
+#include <Utils/Parallel.h>
+
+#include <atomic>
+#include <fstream>
+
+using namespace CubbyFlow;
+
+namespace
+{
+	class RecordingAnimation final : public Animation
+	{
+	public:
+		std::vector<int> frames;
+		std::vector<unsigned int> numberOfThreads;
+		int throwingFrame = -1;
+
+	protected:
+		void OnUpdate(const Frame& frame) override
+		{
+			if (frame.index == throwingFrame)
+			{
+				throw std::runtime_error("Failed to advance.");
+			}
+
+			frames.push_back(frame.index);
+			numberOfThreads.push_back(GetMaxNumberOfThreads());
+
+			std::vector<double> values(1000);
+			ParallelFor(ZERO_SIZE, values.size(), [&](size_t i)
+			{
+				values[i] = std::sqrt(static_cast<double>(i + frame.index));
+			});
+		}
+	};
+
+	using RecordingAnimationPtr = std::shared_ptr<RecordingAnimation>;
+}
+
+TEST(EnsembleRunner, Run)
+{
+	EnsembleRunner runner(4);
+	EXPECT_EQ(4u, runner.NumberOfThreads());
+
+	std::vector<RecordingAnimationPtr> animations;
+	std::vector<std::atomic<int>> numberOfCallbacks(6);
+
+	for (int i = 0; i < 6; ++i)
+	{
+		animations.push_back(std::make_shared<RecordingAnimation>());
+		numberOfCallbacks[i] = 0;
+
+		Frame firstFrame(0, 1.0 / 60.0);
+		firstFrame.index = 10 * i;
+
+		const size_t idx = runner.AddMember(animations.back(), firstFrame, 5 + i, [&](size_t member, const Frame& frame)
+		{
+			EXPECT_EQ(animations[member]->frames.back(), frame.index);
+			++numberOfCallbacks[member];
+		});
+		EXPECT_EQ(static_cast<size_t>(i), idx);
+	}
+
+	EXPECT_EQ(6u, runner.NumberOfMembers());
+	EXPECT_EQ(animations[2], runner.MemberAt(2));
+
+	const EnsembleReport report = runner.Run();
+	EXPECT_EQ(4u, report.numberOfThreads);
+	EXPECT_EQ(45u, report.numberOfFrames);
+	EXPECT_LT(0.0, report.wallTimeInSeconds);
+	EXPECT_DOUBLE_EQ(report.wallTimeInSeconds * 4.0 / 3600.0, report.coreHours);
+	EXPECT_DOUBLE_EQ(45.0 / report.coreHours, report.framesPerCoreHour);
+	ASSERT_EQ(6u, report.memberTimesInSeconds.size());
+
+	for (int i = 0; i < 6; ++i)
+	{
+		// Every frame exactly once and in order
+		ASSERT_EQ(static_cast<size_t>(5 + i), animations[i]->frames.size());
+		for (int f = 0; f < 5 + i; ++f)
+		{
+			EXPECT_EQ(10 * i + f, animations[i]->frames[f]);
+		}
+
+		// The cores are shared, not oversubscribed
+		for (unsigned int numThreads : animations[i]->numberOfThreads)
+		{
+			EXPECT_LE(1u, numThreads);
+			EXPECT_GE(4u, numThreads);
+		}
+
+		EXPECT_EQ(5 + i, numberOfCallbacks[i].load());
+		EXPECT_EQ(10 * i + 5 + i, runner.NextFrameOf(i).index);
+		EXPECT_LE(0.0, report.memberTimesInSeconds[i]);
+	}
+
+	// The calling thread keeps its limit
+	EXPECT_EQ(0u, GetMaxNumberOfThreadsForCurrentThread());
+
+	// Continues from where the members stopped
+	runner.Run();
+	EXPECT_EQ(10u, animations[0]->frames.size());
+	EXPECT_EQ(9, animations[0]->frames.back());
+}
+
+TEST(EnsembleRunner, Exception)
+{
+	EnsembleRunner runner(2);
+
+	auto good = std::make_shared<RecordingAnimation>();
+	auto bad = std::make_shared<RecordingAnimation>();
+	bad->throwingFrame = 3;
+
+	runner.AddMember(good, Frame(), 100);
+	runner.AddMember(bad, Frame(), 100);
+
+	EXPECT_THROW(runner.Run(), std::runtime_error);
+	EXPECT_EQ(3u, bad->frames.size());
+	EXPECT_EQ(3, runner.NextFrameOf(1).index);
+	EXPECT_GT(100u, good->frames.size());
+}
+
+TEST(EnsembleRunner, SharedAssets)
+{
+	EnsembleRunner runner(4);
+	std::atomic<int> numberOfBakes(0);
+	std::vector<ImplicitTriangleMesh3Ptr> surfaces(4);
+
+	// Each member bakes the collider on its first frame
+	class ColliderAnimation final : public Animation
+	{
+	public:
+		std::function<void()> setup;
+
+	protected:
+		void OnUpdate(const Frame& frame) override
+		{
+			if (frame.index == 0)
+			{
+				setup();
+			}
+		}
+	};
+
+	for (size_t i = 0; i < surfaces.size(); ++i)
+	{
+		auto animation = std::make_shared<ColliderAnimation>();
+		animation->setup = [&, i]()
+		{
+			auto mesh = runner.GetAssets()->GetOrCreate<TriangleMesh3>("cube_mesh", []()
+			{
+				std::ifstream objFile("../../../Resources/cube.obj");
+				auto mesh = TriangleMesh3::Builder().MakeShared();
+				mesh->ReadObj(&objFile);
+				mesh->UpdateQueryEngine();
+				return mesh;
+			});
+
+			auto grid = runner.GetAssets()->GetOrCreate<VertexCenteredScalarGrid3>("cube_sdf", [&]()
+			{
+				++numberOfBakes;
+				return ImplicitTriangleMesh3::BakeSignedDistanceField(*mesh, 20, 0.2);
+			});
+
+			surfaces[i] = ImplicitTriangleMesh3::Builder()
+				.WithTriangleMesh(mesh)
+				.WithSignedDistanceField(grid)
+				.WithTranslation(Vector3D(static_cast<double>(i), 0, 0))
+				.MakeShared();
+		};
+
+		runner.AddMember(animation, Frame(), 2);
+	}
+
+	runner.Run();
+
+	EXPECT_EQ(1, numberOfBakes.load());
+	EXPECT_EQ(2u, runner.GetAssets()->NumberOfAssets());
+
+	for (size_t i = 0; i < surfaces.size(); ++i)
+	{
+		EXPECT_EQ(surfaces[0]->GetGrid(), surfaces[i]->GetGrid());
+		EXPECT_NEAR(-0.5, surfaces[i]->SignedDistance(Vector3D(i + 0.5, 0.5, 0.5)), 1.0 / 20);
+	}
+}
\ No newline at end of file
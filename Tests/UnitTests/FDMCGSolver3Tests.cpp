@@ -1,4 +1,5 @@
 #include "pch.h"
+#include "UnitTestsUtils.h"
 
 #include <Solver/FDM/FDMCGSolver3.h>
 
@@ -57,4 +58,46 @@ TEST(FDMCGSolver3, Constructors)
 	solver.Solve(&system);
 
 	EXPECT_GT(solver.GetTolerance(), solver.GetLastResidual());
+}
+
+TEST(FDMCGSolver3, WarmStart)
+{
+	FDMLinearSystem3 system;
+	BuildTestLinearSystem3(&system, Size3(4, 5, 6));
+
+	FDMCGSolver3 coldSolver(100, 1e-9);
+	coldSolver.Solve(&system);
+	EXPECT_FALSE(coldSolver.IsWarmStarted());
+	EXPECT_LT(0u, coldSolver.GetLastNumberOfIterations());
+
+	// Starts from the solution, so no iteration is needed
+	FDMCGSolver3 warmSolver(100, 1e-8, 0.0, true);
+	warmSolver.Solve(&system);
+	EXPECT_TRUE(warmSolver.IsWarmStarted());
+	EXPECT_EQ(0u, warmSolver.GetLastNumberOfIterations());
+	EXPECT_GT(warmSolver.GetTolerance(), warmSolver.GetLastResidual());
+
+	// Starts from zero again, regardless of the solution vector
+	coldSolver.Solve(&system);
+	EXPECT_LT(0u, coldSolver.GetLastNumberOfIterations());
+}
+
+TEST(FDMCGSolver3, RelativeTolerance)
+{
+	FDMLinearSystem3 system;
+	BuildTestLinearSystem3(&system, Size3(4, 5, 6));
+	system.b.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		system.b(i, j, k) += std::sin(i + 2.0 * j + 3.0 * k);
+	});
+
+	FDMCGSolver3 solver(100, 1e-12);
+	solver.Solve(&system);
+
+	FDMCGSolver3 relativeSolver(100, 1e-12, 1e-2);
+	relativeSolver.Solve(&system);
+
+	EXPECT_DOUBLE_EQ(1e-2, relativeSolver.GetRelativeTolerance());
+	EXPECT_LT(relativeSolver.GetLastNumberOfIterations(), solver.GetLastNumberOfIterations());
+	EXPECT_LT(solver.GetTolerance(), relativeSolver.GetLastResidual());
 }
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "pch.h"
+
+#include <Decomposition/SharedMemorySubdomainTransport.h>
+#include <Solver/FDM/FDMCGSolver3.h>
+#include <Solver/FDM/FDMDistributedCGSolver3.h>
+#include <Solver/Grid/GridSinglePhasePressureSolver3.h>
+
+using namespace CubbyFlow;
+
+namespace
+{
+	void BuildPoissonSystem(const Size3& size, FDMLinearSystem3* system)
+	{
+		system->A.Resize(size);
+		system->x.Resize(size);
+		system->b.Resize(size);
+
+		// Dirichlet boundary on the -x side keeps the system non-singular
+		system->A.ForEachIndex([&](size_t i, size_t j, size_t k)
+		{
+			FDMMatrixRow3& row = system->A(i, j, k);
+
+			row.center += (i > 0) ? 1.0 : 2.0;
+			if (i + 1 < size.x)
+			{
+				row.center += 1.0;
+				row.right -= 1.0;
+			}
+
+			if (j > 0)
+			{
+				row.center += 1.0;
+			}
+			if (j + 1 < size.y)
+			{
+				row.center += 1.0;
+				row.up -= 1.0;
+			}
+
+			if (k > 0)
+			{
+				row.center += 1.0;
+			}
+			if (k + 1 < size.z)
+			{
+				row.center += 1.0;
+				row.front -= 1.0;
+			}
+
+			system->b(i, j, k) = std::sin(0.3 * i) + std::cos(0.7 * j) - 0.1 * k;
+		});
+	}
+}
+
+TEST(FDMDistributedCGSolver3, Constructors)
+{
+	FDMDistributedCGSolver3 solver(Size3(2, 1, 3), 100, 1e-9);
+
+	EXPECT_EQ(Size3(2, 1, 3), solver.GetLayout());
+	EXPECT_EQ(100u, solver.GetMaxNumberOfIterations());
+	EXPECT_EQ(1e-9, solver.GetTolerance());
+
+	auto transport = std::make_shared<SharedMemorySubdomainTransport>(4);
+	EXPECT_THROW(FDMDistributedCGSolver3(Size3(2, 1, 3), 100, 1e-9, transport), std::invalid_argument);
+}
+
+TEST(FDMDistributedCGSolver3, Solve)
+{
+	FDMLinearSystem3 reference;
+	BuildPoissonSystem(Size3(10, 9, 7), &reference);
+	FDMLinearSystem3 system = reference;
+
+	FDMCGSolver3 cgSolver(500, 1e-10);
+	EXPECT_TRUE(cgSolver.Solve(&reference));
+
+	FDMDistributedCGSolver3 solver(Size3(3, 2, 2), 500, 1e-10);
+	EXPECT_TRUE(solver.Solve(&system));
+	EXPECT_GT(solver.GetTolerance(), solver.GetLastResidual());
+
+	system.x.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_NEAR(reference.x(i, j, k), system.x(i, j, k), 1e-7);
+	});
+
+	// The reductions are deterministic, so repeated solves agree bitwise
+	FDMLinearSystem3 system2 = system;
+	solver.Solve(&system2);
+
+	system.x.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_EQ(system.x(i, j, k), system2.x(i, j, k));
+	});
+}
+
+TEST(FDMDistributedCGSolver3, SolveChangedSystem)
+{
+	FDMDistributedCGSolver3 solver(Size3(3, 2, 2), 500, 1e-10);
+	FDMCGSolver3 cgSolver(500, 1e-10);
+
+	FDMLinearSystem3 reference;
+	BuildPoissonSystem(Size3(10, 9, 7), &reference);
+	FDMLinearSystem3 system = reference;
+	EXPECT_TRUE(solver.Solve(&system));
+
+	// Changes a row on the halo of the neighboring subdomains
+	reference.A(3, 4, 3).center += 5.0;
+	reference.A(3, 4, 3).right -= 0.5;
+	reference.x.Set(0.0);
+	system = reference;
+
+	EXPECT_TRUE(cgSolver.Solve(&reference));
+	EXPECT_TRUE(solver.Solve(&system));
+
+	system.x.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_NEAR(reference.x(i, j, k), system.x(i, j, k), 1e-7);
+	});
+
+	// Solves a system with another resolution
+	FDMLinearSystem3 reference2;
+	BuildPoissonSystem(Size3(6, 11, 8), &reference2);
+	FDMLinearSystem3 system2 = reference2;
+
+	EXPECT_TRUE(cgSolver.Solve(&reference2));
+	EXPECT_TRUE(solver.Solve(&system2));
+
+	system2.x.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_NEAR(reference2.x(i, j, k), system2.x(i, j, k), 1e-7);
+	});
+}
+
+TEST(FDMDistributedCGSolver3, PressureSolver)
+{
+	FaceCenteredGrid3 vel(8, 8, 8);
+	vel.Fill(Vector3D());
+	vel.ForEachVIndex([&](size_t i, size_t j, size_t k)
+	{
+		vel.GetV(i, j, k) = (j == 0 || j == 8) ? 0.0 : 1.0;
+	});
+
+	GridSinglePhasePressureSolver3 solver;
+	solver.SetLinearSystemSolver(std::make_shared<FDMDistributedCGSolver3>(Size3(2, 2, 2), 100, 1e-9));
+	solver.Solve(vel, 1.0, &vel);
+
+	vel.ForEachVIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_NEAR(0.0, vel.GetV(i, j, k), 1e-6);
+	});
+}
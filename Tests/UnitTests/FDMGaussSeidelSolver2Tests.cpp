@@ -1,6 +1,10 @@
 #include "pch.h"
+#include "UnitTestsUtils.h"
 
 #include <Solver/FDM/FDMGaussSeidelSolver2.h>
+#include <Utils/Parallel.h>
+
+#include <cmath>
 
 using namespace CubbyFlow;
 
@@ -47,4 +51,117 @@ TEST(FDMGaussSeidelSolver2, Constructors)
 	solver.Solve(&system);
 
 	EXPECT_GT(solver.GetTolerance(), solver.GetLastResidual());
+}
+
+TEST(FDMGaussSeidelSolver2, Orderings)
+{
+	const FDMGaussSeidelSolver2::Ordering orderings[] =
+	{
+		FDMGaussSeidelSolver2::Ordering::Lexicographic,
+		FDMGaussSeidelSolver2::Ordering::RedBlack,
+		FDMGaussSeidelSolver2::Ordering::Multicolor
+	};
+
+	unsigned int lastNumberOfIterations = 0;
+
+	for (auto ordering : orderings)
+	{
+		FDMLinearSystem2 system;
+		BuildTestLinearSystem2(&system, Size2(16, 16));
+
+		FDMGaussSeidelSolver2 solver(10000, 10, 1e-9, 1.0, ordering);
+		EXPECT_EQ(ordering, solver.GetOrdering());
+		EXPECT_TRUE(solver.Solve(&system));
+		EXPECT_GT(solver.GetTolerance(), solver.GetLastResidual());
+
+		// Reordering changes the convergence rate only slightly
+		if (lastNumberOfIterations > 0)
+		{
+			EXPECT_NEAR(lastNumberOfIterations, solver.GetLastNumberOfIterations(), lastNumberOfIterations / 2);
+		}
+		lastNumberOfIterations = solver.GetLastNumberOfIterations();
+	}
+}
+
+TEST(FDMGaussSeidelSolver2, SuccessiveOverRelaxation)
+{
+	FDMLinearSystem2 system;
+	BuildTestLinearSystem2(&system, Size2(16, 16));
+
+	FDMGaussSeidelSolver2 gaussSeidel(10000, 10, 1e-9, 1.0, FDMGaussSeidelSolver2::Ordering::RedBlack);
+	EXPECT_TRUE(gaussSeidel.Solve(&system));
+
+	system.x.Set(0.0);
+
+	FDMGaussSeidelSolver2 sor(10000, 10, 1e-9, 1.7, FDMGaussSeidelSolver2::Ordering::RedBlack);
+	EXPECT_DOUBLE_EQ(1.7, sor.GetSORFactor());
+	EXPECT_TRUE(sor.Solve(&system));
+	EXPECT_LT(sor.GetLastNumberOfIterations(), gaussSeidel.GetLastNumberOfIterations());
+}
+
+TEST(FDMGaussSeidelSolver2, MultiGridRelaxFunc)
+{
+	FDMLinearSystem2 system;
+	BuildTestLinearSystem2(&system, Size2(16, 16));
+
+	FDMVector2 residual(system.x.size());
+	FDMBlas2::Residual(system.A, system.x, system.b, &residual);
+	const double initialResidual = FDMBlas2::L2Norm(residual);
+
+	const auto relaxFunc = FDMGaussSeidelSolver2::GetMultiGridRelaxFunc(1.0, FDMGaussSeidelSolver2::Ordering::Multicolor);
+	FDMVector2 buffer(system.x.size());
+	relaxFunc(system.A, system.b, 10, 0.0, &system.x, &buffer);
+
+	FDMBlas2::Residual(system.A, system.x, system.b, &residual);
+	EXPECT_GT(initialResidual, FDMBlas2::L2Norm(residual));
+}
+
+TEST(FDMGaussSeidelSolver2, RedBlackSlabs)
+{
+	FDMLinearSystem2 system;
+	BuildTestLinearSystem2(&system, Size2(7, 5));
+
+	const Size2 size = system.A.size();
+	system.x.ForEachIndex([&](size_t i, size_t j)
+	{
+		system.x(i, j) = std::sin(static_cast<double>(i + 3 * j));
+	});
+
+	// Relaxes all the red cells, then all the black cells
+	FDMVector2 expected(system.x);
+	for (size_t color = 0; color < 2; ++color)
+	{
+		expected.ForEachIndex([&](size_t i, size_t j)
+		{
+			if (((i + j) & 1) != color)
+			{
+				return;
+			}
+
+			const FDMMatrix2& A = system.A;
+			double r =
+				((i > 0) ? A(i - 1, j).right * expected(i - 1, j) : 0.0) +
+				((i + 1 < size.x) ? A(i, j).right * expected(i + 1, j) : 0.0) +
+				((j > 0) ? A(i, j - 1).up * expected(i, j - 1) : 0.0) +
+				((j + 1 < size.y) ? A(i, j).up * expected(i, j + 1) : 0.0);
+
+			expected(i, j) = (1.0 - 1.5) * expected(i, j) + 1.5 * (system.b(i, j) - r) / A(i, j).center;
+		});
+	}
+
+	// Slabs of one, two, and more rows give the same result
+	for (unsigned int numberOfThreads : { 1u, 2u, 3u, 5u })
+	{
+		SetMaxNumberOfThreads(numberOfThreads);
+
+		FDMVector2 x(system.x);
+		FDMGaussSeidelSolver2::Relax(system.A, system.b, 1.5, FDMGaussSeidelSolver2::Ordering::RedBlack, &x);
+
+		x.ForEachIndex([&](size_t i, size_t j)
+		{
+			EXPECT_EQ(expected(i, j), x(i, j));
+		});
+	}
+
+	SetMaxNumberOfThreads(0);
 }
\ No newline at end of file
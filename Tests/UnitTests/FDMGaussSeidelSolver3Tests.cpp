@@ -1,6 +1,10 @@
 #include "pch.h"
+#include "UnitTestsUtils.h"
 
 #include <Solver/FDM/FDMGaussSeidelSolver3.h>
+#include <Utils/Parallel.h>
+
+#include <cmath>
 
 using namespace CubbyFlow;
 
@@ -57,4 +61,119 @@ TEST(FDMGaussSeidelSolver3, Constructors)
 	solver.Solve(&system);
 
 	EXPECT_GT(solver.GetTolerance(), solver.GetLastResidual());
+}
+
+TEST(FDMGaussSeidelSolver3, Orderings)
+{
+	const FDMGaussSeidelSolver3::Ordering orderings[] =
+	{
+		FDMGaussSeidelSolver3::Ordering::Lexicographic,
+		FDMGaussSeidelSolver3::Ordering::RedBlack,
+		FDMGaussSeidelSolver3::Ordering::Multicolor
+	};
+
+	unsigned int lastNumberOfIterations = 0;
+
+	for (auto ordering : orderings)
+	{
+		FDMLinearSystem3 system;
+		BuildTestLinearSystem3(&system, Size3(8, 8, 8));
+
+		FDMGaussSeidelSolver3 solver(10000, 10, 1e-9, 1.0, ordering);
+		EXPECT_EQ(ordering, solver.GetOrdering());
+		EXPECT_TRUE(solver.Solve(&system));
+		EXPECT_GT(solver.GetTolerance(), solver.GetLastResidual());
+
+		// Reordering changes the convergence rate only slightly
+		if (lastNumberOfIterations > 0)
+		{
+			EXPECT_NEAR(lastNumberOfIterations, solver.GetLastNumberOfIterations(), lastNumberOfIterations / 2);
+		}
+		lastNumberOfIterations = solver.GetLastNumberOfIterations();
+	}
+}
+
+TEST(FDMGaussSeidelSolver3, SuccessiveOverRelaxation)
+{
+	FDMLinearSystem3 system;
+	BuildTestLinearSystem3(&system, Size3(8, 8, 8));
+
+	FDMGaussSeidelSolver3 gaussSeidel(10000, 10, 1e-9, 1.0, FDMGaussSeidelSolver3::Ordering::RedBlack);
+	EXPECT_TRUE(gaussSeidel.Solve(&system));
+
+	system.x.Set(0.0);
+
+	FDMGaussSeidelSolver3 sor(10000, 10, 1e-9, 1.7, FDMGaussSeidelSolver3::Ordering::RedBlack);
+	EXPECT_DOUBLE_EQ(1.7, sor.GetSORFactor());
+	EXPECT_TRUE(sor.Solve(&system));
+	EXPECT_LT(sor.GetLastNumberOfIterations(), gaussSeidel.GetLastNumberOfIterations());
+}
+
+TEST(FDMGaussSeidelSolver3, MultiGridRelaxFunc)
+{
+	FDMLinearSystem3 system;
+	BuildTestLinearSystem3(&system, Size3(8, 8, 8));
+
+	FDMVector3 residual(system.x.size());
+	FDMBlas3::Residual(system.A, system.x, system.b, &residual);
+	const double initialResidual = FDMBlas3::L2Norm(residual);
+
+	const auto relaxFunc = FDMGaussSeidelSolver3::GetMultiGridRelaxFunc(1.0, FDMGaussSeidelSolver3::Ordering::Multicolor);
+	FDMVector3 buffer(system.x.size());
+	relaxFunc(system.A, system.b, 10, 0.0, &system.x, &buffer);
+
+	FDMBlas3::Residual(system.A, system.x, system.b, &residual);
+	EXPECT_GT(initialResidual, FDMBlas3::L2Norm(residual));
+}
+
+TEST(FDMGaussSeidelSolver3, RedBlackSlabs)
+{
+	FDMLinearSystem3 system;
+	BuildTestLinearSystem3(&system, Size3(7, 6, 5));
+
+	const Size3 size = system.A.size();
+	system.x.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		system.x(i, j, k) = std::sin(static_cast<double>(i + 3 * j + 7 * k));
+	});
+
+	// Relaxes all the red cells, then all the black cells
+	FDMVector3 expected(system.x);
+	for (size_t color = 0; color < 2; ++color)
+	{
+		expected.ForEachIndex([&](size_t i, size_t j, size_t k)
+		{
+			if (((i + j + k) & 1) != color)
+			{
+				return;
+			}
+
+			const FDMMatrix3& A = system.A;
+			double r =
+				((i > 0) ? A(i - 1, j, k).right * expected(i - 1, j, k) : 0.0) +
+				((i + 1 < size.x) ? A(i, j, k).right * expected(i + 1, j, k) : 0.0) +
+				((j > 0) ? A(i, j - 1, k).up * expected(i, j - 1, k) : 0.0) +
+				((j + 1 < size.y) ? A(i, j, k).up * expected(i, j + 1, k) : 0.0) +
+				((k > 0) ? A(i, j, k - 1).front * expected(i, j, k - 1) : 0.0) +
+				((k + 1 < size.z) ? A(i, j, k).front * expected(i, j, k + 1) : 0.0);
+
+			expected(i, j, k) = (1.0 - 1.5) * expected(i, j, k) + 1.5 * (system.b(i, j, k) - r) / A(i, j, k).center;
+		});
+	}
+
+	// Slabs of one, two, and more planes give the same result
+	for (unsigned int numberOfThreads : { 1u, 2u, 3u, 5u })
+	{
+		SetMaxNumberOfThreads(numberOfThreads);
+
+		FDMVector3 x(system.x);
+		FDMGaussSeidelSolver3::Relax(system.A, system.b, 1.5, FDMGaussSeidelSolver3::Ordering::RedBlack, &x);
+
+		x.ForEachIndex([&](size_t i, size_t j, size_t k)
+		{
+			EXPECT_EQ(expected(i, j, k), x(i, j, k));
+		});
+	}
+
+	SetMaxNumberOfThreads(0);
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "pch.h"
+#include "UnitTestsUtils.h"
 
 #include <Solver/FDM/FDMICCGSolver3.h>
 
@@ -57,4 +58,85 @@ TEST(FDMICCGSolver3, Constructors)
 	solver.Solve(&system);
 
 	EXPECT_GT(solver.GetTolerance(), solver.GetLastResidual());
+}
+
+TEST(FDMICCGSolver3, ReuseFactorization)
+{
+	FDMLinearSystem3 system;
+	BuildTestLinearSystem3(&system, Size3(4, 5, 6));
+
+	FDMICCGSolver3 solver(100, 1e-9);
+	solver.Solve(&system);
+
+	// Changes a row in the middle, so that only the following rows are
+	// factorized again, and compares with a solver factorizing everything
+	system.A(2, 3, 3).center += 1.0;
+	system.b(1, 1, 1) = 2.0;
+
+	FDMLinearSystem3 system2 = system;
+	FDMICCGSolver3 solver2(100, 1e-9);
+
+	solver.Solve(&system);
+	solver2.Solve(&system2);
+
+	EXPECT_EQ(solver2.GetLastNumberOfIterations(), solver.GetLastNumberOfIterations());
+	system.x.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_DOUBLE_EQ(system2.x(i, j, k), system.x(i, j, k));
+	});
+
+	// Solves again without changing the matrix
+	system.b(3, 4, 5) = -1.0;
+	system2.b(3, 4, 5) = -1.0;
+
+	solver.Solve(&system);
+	FDMICCGSolver3 solver3(100, 1e-9);
+	solver3.Solve(&system2);
+
+	system.x.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_DOUBLE_EQ(system2.x(i, j, k), system.x(i, j, k));
+	});
+}
+
+TEST(FDMICCGSolver3, WarmStart)
+{
+	FDMLinearSystem3 system;
+	BuildTestLinearSystem3(&system, Size3(4, 5, 6));
+
+	FDMICCGSolver3 coldSolver(100, 1e-9);
+	coldSolver.Solve(&system);
+	EXPECT_FALSE(coldSolver.IsWarmStarted());
+	EXPECT_LT(0u, coldSolver.GetLastNumberOfIterations());
+
+	// Starts from the solution, so no iteration is needed
+	FDMICCGSolver3 warmSolver(100, 1e-8, 0.0, true);
+	warmSolver.Solve(&system);
+	EXPECT_TRUE(warmSolver.IsWarmStarted());
+	EXPECT_EQ(0u, warmSolver.GetLastNumberOfIterations());
+	EXPECT_GT(warmSolver.GetTolerance(), warmSolver.GetLastResidual());
+
+	// Starts from zero again, regardless of the solution vector
+	coldSolver.Solve(&system);
+	EXPECT_LT(0u, coldSolver.GetLastNumberOfIterations());
+}
+
+TEST(FDMICCGSolver3, RelativeTolerance)
+{
+	FDMLinearSystem3 system;
+	BuildTestLinearSystem3(&system, Size3(4, 5, 6));
+	system.b.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		system.b(i, j, k) += std::sin(i + 2.0 * j + 3.0 * k);
+	});
+
+	FDMICCGSolver3 solver(100, 1e-12);
+	solver.Solve(&system);
+
+	FDMICCGSolver3 relativeSolver(100, 1e-12, 1e-2);
+	relativeSolver.Solve(&system);
+
+	EXPECT_DOUBLE_EQ(1e-2, relativeSolver.GetRelativeTolerance());
+	EXPECT_LT(relativeSolver.GetLastNumberOfIterations(), solver.GetLastNumberOfIterations());
+	EXPECT_LT(solver.GetTolerance(), relativeSolver.GetLastResidual());
 }
\ No newline at end of file
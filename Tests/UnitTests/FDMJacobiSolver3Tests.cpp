@@ -55,4 +55,38 @@ TEST(FDMJacobiSolver3, Constructors)
 	solver.Solve(&system);
 
 	EXPECT_GT(solver.GetTolerance(), solver.GetLastResidual());
-}
\ No newline at end of file
+}
+
+TEST(FDMJacobiSolver3, TemporalBlocking)
+{
+	FDMLinearSystem3 system;
+	system.A.Resize(8, 8, 8);
+	system.x.Resize(8, 8, 8);
+	system.b.Resize(8, 8, 8);
+
+	system.A.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		system.A(i, j, k).center = 6.0;
+		system.A(i, j, k).right = (i + 1 < 8) ? -1.0 : 0.0;
+		system.A(i, j, k).up = (j + 1 < 8) ? -1.0 : 0.0;
+		system.A(i, j, k).front = (k + 1 < 8) ? -1.0 : 0.0;
+		system.b(i, j, k) = static_cast<double>(i + 2 * j + 3 * k);
+	});
+
+	FDMLinearSystem3 blockedSystem = system;
+
+	FDMJacobiSolver3 solver(100, 7, 1e-9);
+	solver.Solve(&system);
+
+	FDMJacobiSolver3 blockedSolver(100, 7, 1e-9, 4);
+	EXPECT_EQ(4u, blockedSolver.GetTemporalBlockSize());
+	blockedSolver.Solve(&blockedSystem);
+
+	EXPECT_EQ(solver.GetLastNumberOfIterations(), blockedSolver.GetLastNumberOfIterations());
+	EXPECT_EQ(solver.GetLastResidual(), blockedSolver.GetLastResidual());
+
+	system.x.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_EQ(system.x(i, j, k), blockedSystem.x(i, j, k));
+	});
+}
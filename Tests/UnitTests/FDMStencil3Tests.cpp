@@ -0,0 +1,120 @@
+#include "pch.h"
+
+#include <Array/Array3.h>
+#include <FDM/FDMStencil3.h>
+
+#include <random>
+
+using namespace CubbyFlow;
+
+TEST(FDMStencil3, Constructors)
+{
+	FDMStencil3 stencil;
+	EXPECT_EQ(4u, stencil.GetTemporalBlockSize());
+	EXPECT_EQ(256u * 1024u, stencil.GetCacheSizeInBytes());
+
+	FDMStencil3 stencil2(0, 1024);
+	EXPECT_EQ(1u, stencil2.GetTemporalBlockSize());
+	EXPECT_EQ(1024u, stencil2.GetCacheSizeInBytes());
+}
+
+TEST(FDMStencil3, Apply)
+{
+	const Size3 size(13, 11, 9);
+
+	std::mt19937 rng(0);
+	std::uniform_real_distribution<double> d(0.0, 1.0);
+
+	Array3<double> weight(size);
+	Array3<double> initial(size);
+	weight.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		weight(i, j, k) = d(rng);
+		initial(i, j, k) = d(rng);
+	});
+
+	// Position-dependent kernel that tells the neighbors apart
+	const auto kernel = [&](size_t i, size_t j, size_t k, const FDMStencilValues3<double>& v)
+	{
+		return weight(i, j, k) * v.center + 0.1 * v.left + 0.2 * v.right
+			+ 0.3 * v.down + 0.05 * v.up + 0.15 * v.back + 0.25 * v.front;
+	};
+
+	// Reference computed iteration by iteration
+	const unsigned int numberOfIterations = 7;
+	Array3<double> expected(initial);
+	Array3<double> temp(size);
+
+	for (unsigned int iter = 0; iter < numberOfIterations; ++iter)
+	{
+		expected.ForEachIndex([&](size_t i, size_t j, size_t k)
+		{
+			const FDMStencilValues3<double> v
+			{
+				expected(i, j, k),
+				expected((i > 0) ? i - 1 : i, j, k),
+				expected((i + 1 < size.x) ? i + 1 : i, j, k),
+				expected(i, (j > 0) ? j - 1 : j, k),
+				expected(i, (j + 1 < size.y) ? j + 1 : j, k),
+				expected(i, j, (k > 0) ? k - 1 : k),
+				expected(i, j, (k + 1 < size.z) ? k + 1 : k)
+			};
+
+			temp(i, j, k) = kernel(i, j, k, v);
+		});
+
+		expected.Swap(temp);
+	}
+
+	// Small caches force many overlapping blocks, even on this small grid
+	for (unsigned int temporalBlockSize = 1; temporalBlockSize <= 8; ++temporalBlockSize)
+	{
+		for (size_t cacheSizeInBytes : { 0, 2048, 1 << 20 })
+		{
+			FDMStencil3 stencil(temporalBlockSize, cacheSizeInBytes, 0);
+
+			Array3<double> x(initial);
+			Array3<double> buffer(size);
+			stencil.Apply(kernel, numberOfIterations, x.Accessor(), buffer.Accessor());
+
+			x.ForEachIndex([&](size_t i, size_t j, size_t k)
+			{
+				EXPECT_EQ(expected(i, j, k), x(i, j, k));
+			});
+		}
+	}
+}
+
+TEST(FDMStencil3, MinGridSize)
+{
+	FDMStencil3 stencil;
+	EXPECT_EQ(16u * 1024u * 1024u, stencil.GetMinGridSizeInBytes());
+
+	FDMStencil3 stencil2(4, 1024, 4096);
+	EXPECT_EQ(4096u, stencil2.GetMinGridSizeInBytes());
+
+	// Grids below and above the minimum size give the same results
+	const auto kernel = [](size_t, size_t, size_t, const FDMStencilValues3<double>& v)
+	{
+		return 0.4 * v.center + 0.1 * (v.left + v.right + v.down + v.up + v.back + v.front);
+	};
+
+	for (const Size3& size : { Size3(4, 4, 4), Size3(12, 10, 8) })
+	{
+		Array3<double> x(size);
+		x.ForEachIndex([&](size_t i, size_t j, size_t k)
+		{
+			x(i, j, k) = std::sin(i + 2.0 * j + 3.0 * k);
+		});
+
+		Array3<double> expected(x);
+		Array3<double> buffer(size);
+		FDMStencil3(1).Apply(kernel, 5, expected.Accessor(), buffer.Accessor());
+		stencil2.Apply(kernel, 5, x.Accessor(), buffer.Accessor());
+
+		x.ForEachIndex([&](size_t i, size_t j, size_t k)
+		{
+			EXPECT_EQ(expected(i, j, k), x(i, j, k));
+		});
+	}
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "pch.h"
+
+#include <Decomposition/GridDomainDecomposition3.h>
+#include <Decomposition/SharedMemorySubdomainTransport.h>
+
+using namespace CubbyFlow;
+
+TEST(GridDomainDecomposition3, Constructors)
+{
+	GridDomainDecomposition3 decomposition(Size3(10, 7, 5), Size3(3, 2, 1), 2);
+
+	EXPECT_EQ(Size3(10, 7, 5), decomposition.Resolution());
+	EXPECT_EQ(Size3(3, 2, 1), decomposition.Layout());
+	EXPECT_EQ(2u, decomposition.GhostWidth());
+	EXPECT_EQ(6u, decomposition.NumberOfSubdomains());
+
+	size_t numberOfCells = 0;
+	for (size_t rank = 0; rank < decomposition.NumberOfSubdomains(); ++rank)
+	{
+		const Size3 res = decomposition.SubdomainResolution(rank);
+		const Size3 origin = decomposition.SubdomainOrigin(rank);
+		numberOfCells += res.x * res.y * res.z;
+
+		EXPECT_EQ(Size3(res.x + 4, res.y + 4, res.z + 4), decomposition.LocalSize(rank));
+		EXPECT_EQ(rank, decomposition.RankAt(origin));
+		EXPECT_EQ(rank, decomposition.RankAt(Size3(origin.x + res.x - 1, origin.y + res.y - 1, origin.z + res.z - 1)));
+	}
+	EXPECT_EQ(10u * 7u * 5u, numberOfCells);
+
+	EXPECT_EQ(Size3(1, 1, 0), decomposition.SubdomainCoordinate(4));
+	EXPECT_EQ(3u, decomposition.Neighbor(4, 0, -1));
+	EXPECT_EQ(5u, decomposition.Neighbor(4, 0, +1));
+	EXPECT_EQ(1u, decomposition.Neighbor(4, 1, -1));
+	EXPECT_EQ(GridDomainDecomposition3::NO_NEIGHBOR, decomposition.Neighbor(4, 1, +1));
+	EXPECT_EQ(GridDomainDecomposition3::NO_NEIGHBOR, decomposition.Neighbor(4, 2, -1));
+
+	EXPECT_THROW(GridDomainDecomposition3(Size3(2, 2, 2), Size3(3, 1, 1)), std::invalid_argument);
+}
+
+TEST(GridDomainDecomposition3, ExchangeHalos)
+{
+	const Size3 resolution(9, 8, 7);
+	Array3<double> global(resolution);
+	global.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		global(i, j, k) = static_cast<double>(i + 100 * j + 10000 * k);
+	});
+
+	GridDomainDecomposition3 decomposition(resolution, Size3(3, 2, 2), 2);
+	SharedMemorySubdomainTransport transport(decomposition.NumberOfSubdomains());
+	Array3<double> gathered(resolution);
+
+	transport.Run([&](size_t rank)
+	{
+		Array3<double> local;
+		decomposition.Scatter(rank, global.ConstAccessor(), &local);
+		decomposition.Gather(rank, local.ConstAccessor(), gathered.Accessor());
+
+		// Keep only the interior and let the exchange restore the halo
+		const Size3 origin = decomposition.SubdomainOrigin(rank);
+		const Size3 res = decomposition.SubdomainResolution(rank);
+		local.ForEachIndex([&](size_t i, size_t j, size_t k)
+		{
+			if (i < 2 || j < 2 || k < 2 || i >= res.x + 2 || j >= res.y + 2 || k >= res.z + 2)
+			{
+				local(i, j, k) = -1.0;
+			}
+		});
+
+		decomposition.ExchangeHalos(rank, &transport, &local);
+
+		local.ForEachIndex([&](size_t i, size_t j, size_t k)
+		{
+			const size_t gi = origin.x + i - 2;
+			const size_t gj = origin.y + j - 2;
+			const size_t gk = origin.z + k - 2;
+
+			if (gi < resolution.x && gj < resolution.y && gk < resolution.z)
+			{
+				EXPECT_EQ(global(gi, gj, gk), local(i, j, k));
+			}
+			else
+			{
+				EXPECT_EQ(-1.0, local(i, j, k));
+			}
+		});
+	});
+
+	global.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_EQ(global(i, j, k), gathered(i, j, k));
+	});
+}
+
+TEST(GridDomainDecomposition3, AbortTransport)
+{
+	SharedMemorySubdomainTransport transport(4);
+
+	// Rank 1 waits for a message that never comes, the others wait in the
+	// reduction that rank 3 never reaches
+	EXPECT_THROW(transport.Run([&](size_t rank)
+	{
+		if (rank == 3)
+		{
+			throw std::logic_error("rank 3 failed");
+		}
+
+		if (rank == 1)
+		{
+			std::vector<double> data;
+			transport.Receive(1, 3, 0, &data);
+		}
+		else
+		{
+			transport.Send(rank, 1, 1, { 1.0 });
+			transport.AllReduceSum(rank, 1.0);
+		}
+	}), std::logic_error);
+
+	// The pending messages are dropped and the next run works again
+	std::vector<double> sums(4, 0.0);
+	std::vector<size_t> sizes(4, 0);
+	transport.Run([&](size_t rank)
+	{
+		std::vector<double> data;
+		transport.Send(rank, (rank + 1) % 4, 1, { static_cast<double>(rank) });
+		transport.Receive(rank, (rank + 3) % 4, 1, &data);
+		sizes[rank] = data.size();
+		sums[rank] = transport.AllReduceSum(rank, data[0]);
+	});
+
+	for (size_t rank = 0; rank < 4; ++rank)
+	{
+		EXPECT_EQ(1u, sizes[rank]);
+		EXPECT_EQ(6.0, sums[rank]);
+	}
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "pch.h"
 
+#include <Field/CustomScalarField3.h>
 #include <Grid/CellCenteredScalarGrid3.h>
 #include <Solver/Grid/GridForwardEulerDiffusionSolver3.h>
 
@@ -22,4 +23,35 @@ TEST(GridForwardEulerDiffusionSolver3, Solve)
 	EXPECT_DOUBLE_EQ(1.0 / 12.0, dst(1, 2, 1));
 	EXPECT_DOUBLE_EQ(1.0 / 12.0, dst(1, 1, 2));
 	EXPECT_DOUBLE_EQ(1.0 / 2.0, dst(1, 1, 1));
-}
\ No newline at end of file
+}
+
+TEST(GridForwardEulerDiffusionSolver3, SubSteps)
+{
+	CellCenteredScalarGrid3 src(6, 5, 4, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0);
+	CellCenteredScalarGrid3 half(6, 5, 4, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0);
+	CellCenteredScalarGrid3 expected(6, 5, 4, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0);
+	CellCenteredScalarGrid3 dst(6, 5, 4, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0);
+
+	src(2, 2, 1) = 1.0;
+	src(4, 1, 3) = 2.0;
+
+	// Fluid in the lower half only
+	ConstantScalarField3 boundarySDF(std::numeric_limits<double>::max());
+	CustomScalarField3 fluidSDF([](const Vector3D& x)
+	{
+		return x.y - 2.5;
+	});
+
+	GridForwardEulerDiffusionSolver3 diffusionSolver;
+	diffusionSolver.Solve(src, 0.1, 0.5, &half, boundarySDF, fluidSDF);
+	diffusionSolver.Solve(half, 0.1, 0.5, &expected, boundarySDF, fluidSDF);
+
+	GridForwardEulerDiffusionSolver3 subStepSolver(2);
+	EXPECT_EQ(2u, subStepSolver.GetNumberOfSubSteps());
+	subStepSolver.Solve(src, 0.1, 1.0, &dst, boundarySDF, fluidSDF);
+
+	dst.ForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_DOUBLE_EQ(expected(i, j, k), dst(i, j, k));
+	});
+}
@@ -1,5 +1,9 @@
 #include "pch.h"
 
+#include <Collider/ColliderSet3.h>
+#include <Collider/RigidBodyCollider3.h>
+#include <Geometry/Box3.h>
+#include <Geometry/Sphere3.h>
 #include <Solver/Grid/GridFractionalBoundaryConditionSolver3.h>
 
 using namespace CubbyFlow;
@@ -106,4 +110,145 @@ TEST(GridFractionalBoundaryConditionSolver3, OpenDomain)
 			EXPECT_DOUBLE_EQ(1.0, velocity.GetW(i, j, k));
 		}
 	});
+}
+
+TEST(GridFractionalBoundaryConditionSolver3, CachedColliderSDF)
+{
+	GridFractionalBoundaryConditionSolver3 bndSolver;
+	Size3 gridSize(20, 20, 20);
+	Vector3D gridSpacing(0.5, 0.5, 0.5);
+	Vector3D gridOrigin(-5.0, -5.0, -5.0);
+
+	auto sphere = std::make_shared<Sphere3>(Vector3D(0.5, 0.0, 0.0), 2.0);
+	auto collider = std::make_shared<RigidBodyCollider3>(sphere);
+	EXPECT_TRUE(bndSolver.IsUsingColliderSDFCache());
+
+	const auto checkSDF = [&]()
+	{
+		auto sdf = bndSolver.ColliderSDF();
+		CellCenteredScalarGrid3 grid(gridSize, gridSpacing, gridOrigin);
+		auto pos = grid.GetDataPosition();
+
+		grid.ForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+		{
+			Vector3D pt = pos(i, j, k);
+			Vector3D center = sphere->transform.ToWorld(sphere->center);
+			double expected = pt.DistanceTo(center) - sphere->radius;
+
+			// Trilinear interpolation of the baked field is exact up to the
+			// curvature error near the surface, and bounded by the distance to the
+			// baked region away from it.
+			if (std::fabs(expected) < 1.0)
+			{
+				EXPECT_NEAR(expected, sdf->Sample(pt), 0.1);
+			}
+			else
+			{
+				EXPECT_EQ(expected > 0.0, sdf->Sample(pt) > 0.0);
+			}
+		});
+	};
+
+	bndSolver.UpdateCollider(collider, gridSize, gridSpacing, gridOrigin);
+	checkSDF();
+
+	// Move and rotate the rigid body without re-baking
+	sphere->transform = Transform3(Vector3D(-1.0, 0.5, 0.25), QuaternionD(Vector3D(0.0, 0.0, 1.0), 0.7));
+	bndSolver.UpdateCollider(collider, gridSize, gridSpacing, gridOrigin);
+	checkSDF();
+
+	// Without the cache, the SDF is evaluated exactly
+	bndSolver.SetIsUsingColliderSDFCache(false);
+	bndSolver.UpdateCollider(collider, gridSize, gridSpacing, gridOrigin);
+
+	auto sdf = bndSolver.ColliderSDF();
+	Vector3D center = sphere->transform.ToWorld(sphere->center);
+	EXPECT_NEAR(Vector3D(-4.75, 0.25, 0.25).DistanceTo(center) - 2.0, sdf->Sample(Vector3D(-4.75, 0.25, 0.25)), 1e-9);
+}
+
+TEST(GridFractionalBoundaryConditionSolver3, CachedColliderSDFFlipped)
+{
+	GridFractionalBoundaryConditionSolver3 bndSolver;
+	Size3 gridSize(20, 20, 20);
+	Vector3D gridSpacing(0.5, 0.5, 0.5);
+	Vector3D gridOrigin(-5.0, -5.0, -5.0);
+
+	auto box = std::make_shared<Box3>(Vector3D(-1.0, -1.0, -1.0), Vector3D(1.0, 1.0, 1.0));
+	box->isNormalFlipped = true;
+	auto collider = std::make_shared<RigidBodyCollider3>(box);
+
+	bndSolver.UpdateCollider(collider, gridSize, gridSpacing, gridOrigin);
+
+	// Far away from the flipped box is inside the collider
+	auto sdf = bndSolver.ColliderSDF();
+	EXPECT_GT(0.0, sdf->Sample(Vector3D(-4.75, -4.75, -4.75)));
+	EXPECT_LT(0.0, sdf->Sample(Vector3D(0.25, 0.25, 0.25)));
+}
+
+TEST(GridFractionalBoundaryConditionSolver3, ColliderSetSDF)
+{
+	GridFractionalBoundaryConditionSolver3 bndSolver;
+	Size3 gridSize(20, 20, 20);
+	Vector3D gridSpacing(0.5, 0.5, 0.5);
+	Vector3D gridOrigin(-5.0, -5.0, -5.0);
+
+	// Two overlapping spheres, so that the SDF of the union differs from the
+	// signed distance to the closest surface of the set
+	auto sphere0 = std::make_shared<Sphere3>(Vector3D(-0.25, 0.25, 0.25), 1.0);
+	auto sphere1 = std::make_shared<Sphere3>(Vector3D(0.75, 0.25, 0.25), 1.0);
+	auto collider = std::make_shared<ColliderSet3>(std::vector<Collider3Ptr>{
+		std::make_shared<RigidBodyCollider3>(sphere0),
+		std::make_shared<RigidBodyCollider3>(sphere1) });
+
+	bndSolver.UpdateCollider(collider, gridSize, gridSpacing, gridOrigin);
+
+	auto sdf = bndSolver.ColliderSDF();
+	CellCenteredScalarGrid3 grid(gridSize, gridSpacing, gridOrigin);
+	auto pos = grid.GetDataPosition();
+
+	grid.ForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+	{
+		Vector3D pt = pos(i, j, k);
+		double expected = std::min(
+			pt.DistanceTo(sphere0->center) - sphere0->radius,
+			pt.DistanceTo(sphere1->center) - sphere1->radius);
+		EXPECT_NEAR(expected, sdf->Sample(pt), 1e-9);
+	});
+
+	// The center of the first sphere lies on the surface of the second one
+	EXPECT_NEAR(-1.0, sdf->Sample(sphere0->center), 1e-9);
+}
+
+TEST(GridFractionalBoundaryConditionSolver3, MovedColliderSetSDF)
+{
+	GridFractionalBoundaryConditionSolver3 bndSolver;
+	Size3 gridSize(20, 20, 20);
+	Vector3D gridSpacing(0.5, 0.5, 0.5);
+	Vector3D gridOrigin(-5.0, -5.0, -5.0);
+
+	auto sphere0 = std::make_shared<Sphere3>(Vector3D(-2.0, 0.25, 0.25), 1.0);
+	auto sphere1 = std::make_shared<Sphere3>(Vector3D(2.0, 0.25, 0.25), 1.0);
+	auto collider = std::make_shared<ColliderSet3>(std::vector<Collider3Ptr>{
+		std::make_shared<RigidBodyCollider3>(sphere0),
+		std::make_shared<RigidBodyCollider3>(sphere1) });
+
+	bndSolver.UpdateCollider(collider, gridSize, gridSpacing, gridOrigin);
+
+	// Move a member between the updates, as a collider callback would
+	sphere1->transform = Transform3(Vector3D(0.0, 2.0, 0.0), QuaternionD());
+	collider->Update(0.0, 0.01);
+	bndSolver.UpdateCollider(collider, gridSize, gridSpacing, gridOrigin);
+
+	auto sdf = bndSolver.ColliderSDF();
+	CellCenteredScalarGrid3 grid(gridSize, gridSpacing, gridOrigin);
+	auto pos = grid.GetDataPosition();
+
+	grid.ForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+	{
+		Vector3D pt = pos(i, j, k);
+		double expected = std::min(
+			pt.DistanceTo(sphere0->center) - sphere0->radius,
+			pt.DistanceTo(sphere1->center + Vector3D(0.0, 2.0, 0.0)) - sphere1->radius);
+		EXPECT_NEAR(expected, sdf->Sample(pt), 1e-9);
+	});
 }
\ No newline at end of file
@@ -0,0 +1,30 @@
+#include "pch.h"
+
+#include <PointGenerator/GridPointGenerator3.h>
+
+using namespace CubbyFlow;
+
+TEST(GridPointGenerator3, ParallelForEachPoint)
+{
+	GridPointGenerator3 generator;
+	BoundingBox3D box({ -0.3, 0.1, 0.2 }, { 1.2, 0.9, 1.7 });
+
+	Array1<Vector3D> points;
+	generator.Generate(box, 0.1, &points);
+
+	ASSERT_EQ(points.size(), generator.NumberOfPoints(box, 0.1));
+
+	Array1<Vector3D> parallelPoints(points.size());
+	Array1<int> visitCount(points.size(), 0);
+	generator.ParallelForEachPoint(box, 0.1, [&](size_t i, const Vector3D& point)
+	{
+		parallelPoints[i] = point;
+		++visitCount[i];
+	});
+
+	for (size_t i = 0; i < points.size(); ++i)
+	{
+		EXPECT_EQ(1, visitCount[i]);
+		EXPECT_EQ(points[i], parallelPoints[i]);
+	}
+}
@@ -1,6 +1,7 @@
 #include "pch.h"
 
 #include <Grid/CellCenteredScalarGrid3.h>
+#include <Solver/FDM/FDMICCGSolver3.h>
 #include <Solver/Grid/GridSinglePhasePressureSolver3.h>
 
 using namespace CubbyFlow;
@@ -348,4 +349,78 @@ TEST(GridSinglePhasePressureSolver3, SolveFreeSurfaceWithBoundary)
 			}
 		}
 	}
+}
+
+TEST(GridSinglePhasePressureSolver3, SolveWithChangedFluidRegion)
+{
+	GridSinglePhasePressureSolver3 solver;
+	CellCenteredScalarGrid3 fluidSDF(6, 6, 6);
+	CellCenteredScalarGrid3 boundarySDF(6, 6, 6);
+
+	// Wall on the right-most column
+	boundarySDF.Fill([&](const Vector3D& x)
+	{
+		return -x.x + 5.0;
+	});
+
+	// Lowers the fluid surface and then keeps it, so that the assembled
+	// system and the pressure are partially and then entirely reused
+	const double surfaces[] = { 4.0, 3.0, 3.0 };
+
+	for (size_t n = 0; n < 3; ++n)
+	{
+		FaceCenteredGrid3 vel(6, 6, 6);
+		vel.Fill([&](const Vector3D& x)
+		{
+			return Vector3D(std::sin(x.x + n) * x.y, std::cos(x.y) * x.z, 0.1 * x.z * x.x * static_cast<double>(n + 1));
+		});
+		FaceCenteredGrid3 vel2(vel);
+
+		fluidSDF.Fill([&](const Vector3D& x)
+		{
+			return x.y - surfaces[n];
+		});
+
+		GridSinglePhasePressureSolver3 solver2;
+		solver.Solve(vel, 1.0, &vel, boundarySDF, ConstantVectorField3({ 0, 0, 0 }), fluidSDF);
+		solver2.Solve(vel2, 1.0, &vel2, boundarySDF, ConstantVectorField3({ 0, 0, 0 }), fluidSDF);
+
+		// The reused solver is warm-started, so the solutions agree up to the
+		// tolerance of the linear system solver
+		solver.GetPressure().ForEachIndex([&](size_t i, size_t j, size_t k)
+		{
+			EXPECT_NEAR(solver2.GetPressure()(i, j, k), solver.GetPressure()(i, j, k), 1e-5);
+		});
+		vel.ForEachVIndex([&](size_t i, size_t j, size_t k)
+		{
+			EXPECT_NEAR(vel2.GetV(i, j, k), vel.GetV(i, j, k), 1e-5);
+		});
+	}
+}
+
+TEST(GridSinglePhasePressureSolver3, WarmStart)
+{
+	FaceCenteredGrid3 vel(6, 6, 6);
+	vel.Fill([](const Vector3D& x)
+	{
+		return Vector3D(std::sin(x.x) * x.y, std::cos(x.y) * x.z, 0.1 * x.z * x.x);
+	});
+
+	CellCenteredScalarGrid3 fluidSDF(6, 6, 6);
+	fluidSDF.Fill([](const Vector3D& x)
+	{
+		return x.y - 4.0;
+	});
+
+	auto systemSolver = std::make_shared<FDMICCGSolver3>(100, 1e-6, 0.0, true);
+	GridSinglePhasePressureSolver3 solver;
+	solver.SetLinearSystemSolver(systemSolver);
+
+	FaceCenteredGrid3 output(6, 6, 6);
+	solver.Solve(vel, 1.0, &output, ConstantScalarField3(std::numeric_limits<double>::max()), ConstantVectorField3({ 0, 0, 0 }), fluidSDF);
+	EXPECT_LT(0u, systemSolver->GetLastNumberOfIterations());
+
+	// Projecting the same flow again starts from its pressure
+	solver.Solve(vel, 1.0, &output, ConstantScalarField3(std::numeric_limits<double>::max()), ConstantVectorField3({ 0, 0, 0 }), fluidSDF);
+	EXPECT_EQ(0u, systemSolver->GetLastNumberOfIterations());
 }
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include "pch.h"
+
+#include <Solver/Smoke/GridSmokeSolver3.h>
+
+using namespace CubbyFlow;
+
+TEST(GridSmokeSolver3, BuoyancyAndDecay)
+{
+	GridSmokeSolver3 solver(Size3(4, 5, 6), Vector3D(1.0, 1.0, 1.0), Vector3D());
+	solver.SetAdvectionSolver(nullptr);
+	solver.SetDiffusionSolver(nullptr);
+	solver.SetPressureSolver(nullptr);
+	solver.SetGravity(Vector3D(0.0, -9.8, 0.0));
+	solver.SetSmokeDecayFactor(0.1);
+	solver.SetTemperatureDecayFactor(0.2);
+
+	auto den = solver.GetSmokeDensity();
+	auto temp = solver.GetTemperature();
+	den->Fill([](const Vector3D& x) { return 0.1 * x.x + 0.2 * x.y * x.y + 0.3 * x.z; });
+	temp->Fill([](const Vector3D& x) { return 1.0 + x.x * x.y - 0.5 * x.z; });
+
+	const auto den0 = den->Clone();
+	const auto temp0 = temp->Clone();
+
+	double tAmb = 0.0;
+	temp->ForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+	{
+		tAmb += (*temp)(i, j, k);
+	});
+	tAmb /= 4.0 * 5.0 * 6.0;
+
+	const double dt = 0.01;
+	solver.Update(Frame(0, dt));
+
+	// Gravity points down along y, so only v is driven
+	auto vel = solver.GetVelocity();
+	auto vPos = vel->GetVPosition();
+
+	vel->ForEachVIndex([&](size_t i, size_t j, size_t k)
+	{
+		if (j == 0 || j == 5)
+		{
+			return;
+		}
+
+		const Vector3D pt = vPos(i, j, k);
+		const double expected = dt * (solver.GetBuoyancySmokeDensityFactor() * den0->Sample(pt)
+			+ solver.GetBuoyancyTemperatureFactor() * (temp0->Sample(pt) - tAmb));
+		EXPECT_NEAR(expected, vel->GetV(i, j, k), 1e-12);
+	});
+
+	vel->ForEachUIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_EQ(0.0, vel->GetU(i, j, k));
+	});
+	vel->ForEachWIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_EQ(0.0, vel->GetW(i, j, k));
+	});
+
+	den->ForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_DOUBLE_EQ(0.9 * (*den0)(i, j, k), (*den)(i, j, k));
+		EXPECT_DOUBLE_EQ(0.8 * (*temp0)(i, j, k), (*temp)(i, j, k));
+	});
+}
+
+TEST(GridSmokeSolver3, Diffusion)
+{
+	GridSmokeSolver3 solver(Size3(5, 5, 5), Vector3D(1.0, 1.0, 1.0), Vector3D());
+	solver.SetAdvectionSolver(nullptr);
+	solver.SetPressureSolver(nullptr);
+	solver.SetBuoyancySmokeDensityFactor(0.0);
+	solver.SetBuoyancyTemperatureFactor(0.0);
+	solver.SetSmokeDiffusionCoefficient(0.01);
+	solver.SetTemperatureDiffusionCoefficient(0.01);
+	solver.SetSmokeDecayFactor(0.0);
+	solver.SetTemperatureDecayFactor(0.5);
+
+	auto den = solver.GetSmokeDensity();
+	auto temp = solver.GetTemperature();
+	(*den)(2, 2, 2) = 1.0;
+	(*temp)(2, 2, 2) = 2.0;
+
+	solver.Update(Frame(0, 0.1));
+
+	// Both fields spread out, and the temperature starting from twice the
+	// density ends up equal to it after the decay by half
+	EXPECT_LT((*den)(2, 2, 2), 1.0);
+	EXPECT_GT((*den)(1, 2, 2), 0.0);
+	EXPECT_LT((*temp)(2, 2, 2), 1.0);
+	EXPECT_GT((*temp)(2, 1, 2), 0.0);
+	EXPECT_NEAR((*den)(2, 2, 2), (*temp)(2, 2, 2), 1e-12);
+}
\ No newline at end of file
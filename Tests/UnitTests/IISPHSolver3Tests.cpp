@@ -0,0 +1,134 @@
+#include "pch.h"
+
+#include <Collider/RigidBodyCollider3.h>
+#include <Emitter/VolumeParticleEmitter3.h>
+#include <Geometry/Box3.h>
+#include <Solver/IISPH/IISPHSolver3.h>
+#include <Surface/Implicit/SurfaceToImplicit3.h>
+
+using namespace CubbyFlow;
+
+TEST(IISPHSolver3, UpdateEmpty)
+{
+	// Empty solver test
+	IISPHSolver3 solver;
+	Frame frame(0, 0.01);
+	solver.Update(frame++);
+	solver.Update(frame);
+}
+
+TEST(IISPHSolver3, Parameters)
+{
+	IISPHSolver3 solver;
+
+	solver.SetMaxDensityErrorRatio(5.0);
+	EXPECT_DOUBLE_EQ(5.0, solver.GetMaxDensityErrorRatio());
+
+	solver.SetMaxDensityErrorRatio(-1.0);
+	EXPECT_DOUBLE_EQ(0.0, solver.GetMaxDensityErrorRatio());
+
+	solver.SetMinNumberOfIterations(3);
+	EXPECT_EQ(3u, solver.GetMinNumberOfIterations());
+
+	solver.SetMaxNumberOfIterations(10);
+	EXPECT_EQ(10u, solver.GetMaxNumberOfIterations());
+
+	solver.SetRelaxationFactor(2.0);
+	EXPECT_DOUBLE_EQ(1.0, solver.GetRelaxationFactor());
+
+	solver.SetRelaxationFactor(0.0);
+	EXPECT_LT(0.0, solver.GetRelaxationFactor());
+
+	solver.SetMaxCFL(0.2);
+	EXPECT_DOUBLE_EQ(0.2, solver.GetMaxCFL());
+}
+
+TEST(IISPHSolver3, SteadyState)
+{
+	IISPHSolver3 solver = IISPHSolver3::GetBuilder()
+		.WithTargetSpacing(0.1)
+		.Build();
+
+	SPHSystemData3Ptr particles = solver.GetSPHSystemData();
+	const double targetSpacing = particles->GetTargetSpacing();
+
+	BoundingBox3D initialBound(Vector3D(), Vector3D(1, 0.5, 1));
+	initialBound.Expand(-targetSpacing);
+
+	auto emitter = std::make_shared<VolumeParticleEmitter3>(
+		std::make_shared<SurfaceToImplicit3>(std::make_shared<Box3>(initialBound)),
+		initialBound,
+		targetSpacing,
+		Vector3D());
+	emitter->SetJitter(0.0);
+	solver.SetEmitter(emitter);
+
+	Box3Ptr box = std::make_shared<Box3>(Vector3D(), Vector3D(1, 1, 1));
+	box->isNormalFlipped = true;
+	solver.SetCollider(std::make_shared<RigidBodyCollider3>(box));
+
+	for (Frame frame(0, 1.0 / 60.0); frame.index < 10; ++frame)
+	{
+		solver.Update(frame);
+
+		// The pressure solve should converge well before the iteration limit.
+		EXPECT_LE(solver.GetMinNumberOfIterations(), solver.GetLastNumberOfIterations());
+		EXPECT_GT(solver.GetMaxNumberOfIterations(), solver.GetLastNumberOfIterations());
+		EXPECT_GT(solver.GetMaxDensityErrorRatio(), solver.GetLastDensityErrorRatio());
+	}
+
+	// The fluid block should stay inside the container.
+	auto positions = particles->GetPositions();
+	for (size_t i = 0; i < particles->NumberOfParticles(); ++i)
+	{
+		EXPECT_TRUE(box->BoundingBox().Contains(positions[i]));
+	}
+}
+
+TEST(IISPHSolver3, MeasuredDensityError)
+{
+	IISPHSolver3 solver = IISPHSolver3::GetBuilder()
+		.WithTargetDensity(1000.0)
+		.WithTargetSpacing(0.05)
+		.Build();
+
+	SPHSystemData3Ptr particles = solver.GetSPHSystemData();
+	const double targetSpacing = particles->GetTargetSpacing();
+	const double targetDensity = particles->GetTargetDensity();
+
+	// Collapsing water column
+	BoundingBox3D column(Vector3D(), Vector3D(0.4, 0.6, 0.25));
+	column.Expand(-targetSpacing);
+
+	auto emitter = std::make_shared<VolumeParticleEmitter3>(
+		std::make_shared<SurfaceToImplicit3>(std::make_shared<Box3>(column)),
+		column,
+		targetSpacing,
+		Vector3D());
+	emitter->SetJitter(0.0);
+	solver.SetEmitter(emitter);
+
+	Box3Ptr box = std::make_shared<Box3>(Vector3D(), Vector3D(1, 1, 0.25));
+	box->isNormalFlipped = true;
+	solver.SetCollider(std::make_shared<RigidBodyCollider3>(box));
+
+	for (Frame frame(0, 1.0 / 60.0); frame.index < 20; ++frame)
+	{
+		solver.Update(frame);
+
+		// The compression measured from the actual positions should stay
+		// close to the error the pressure solve converged on.
+		particles->BuildNeighborSearcher();
+		particles->UpdateDensities();
+
+		auto densities = particles->GetDensities();
+		double errorSum = 0.0;
+		for (size_t i = 0; i < particles->NumberOfParticles(); ++i)
+		{
+			errorSum += std::max(densities[i] - targetDensity, 0.0);
+		}
+
+		const double measuredErrorRatio = errorSum / (particles->NumberOfParticles() * targetDensity);
+		EXPECT_GT(2.0 * solver.GetMaxDensityErrorRatio(), measuredErrorRatio);
+	}
+}
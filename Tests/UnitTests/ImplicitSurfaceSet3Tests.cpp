@@ -1,6 +1,11 @@
 #include "pch.h"
+#include "UnitTestsUtils.h"
 
 #include <Geometry/Box3.h>
+#include <Geometry/Plane3.h>
+#include <Geometry/Sphere3.h>
+#include <Geometry/Triangle3.h>
+#include <Grid/CellCenteredScalarGrid3.h>
 #include <Surface/Implicit/ImplicitSurfaceSet3.h>
 #include <Surface/Implicit/SurfaceToImplicit3.h>
 
@@ -170,6 +175,64 @@ TEST(ImplicitSurfaceSet3, SignedDistance)
 	EXPECT_DOUBLE_EQ(boxDist, setDist);
 }
 
+TEST(ImplicitSurfaceSet3, SignedDistanceWithPruning)
+{
+	std::vector<ImplicitSurface3Ptr> surfaces;
+
+	// Many small spheres and a few surfaces which cannot be pruned
+	for (size_t i = 0; i < 64; ++i)
+	{
+		Vector3D center(
+			static_cast<double>(i % 4),
+			static_cast<double>((i / 4) % 4),
+			static_cast<double>(i / 16));
+		surfaces.push_back(std::make_shared<SurfaceToImplicit3>(
+			std::make_shared<Sphere3>(center, 0.1 + 0.005 * static_cast<double>(i))));
+	}
+
+	auto flippedBox = std::make_shared<Box3>(BoundingBox3D({ -1, -1, -1 }, { 5, 5, 5 }));
+	flippedBox->isNormalFlipped = true;
+	surfaces.push_back(std::make_shared<SurfaceToImplicit3>(flippedBox));
+	surfaces.push_back(std::make_shared<SurfaceToImplicit3>(
+		std::make_shared<Plane3>(Vector3D(0, 1, 0), Vector3D(0, -0.5, 0))));
+
+	// An open surface is negative behind it, even outside of its bounding box
+	const Vector3D normal(0, 0, 1);
+	surfaces.push_back(std::make_shared<SurfaceToImplicit3>(std::make_shared<Triangle3>(
+		std::array<Vector3D, 3>{ Vector3D(0.2, 0.2, 2.5), Vector3D(1.2, 0.2, 2.5), Vector3D(0.2, 1.2, 2.5) },
+		std::array<Vector3D, 3>{ normal, normal, normal },
+		std::array<Vector2D, 3>{ Vector2D(), Vector2D(), Vector2D() })));
+
+	ImplicitSurfaceSet3 sset(surfaces);
+
+	const auto bruteForce = [&](const Vector3D& pt)
+	{
+		double sdf = std::numeric_limits<double>::max();
+
+		for (const auto& surface : surfaces)
+		{
+			sdf = std::min(sdf, surface->SignedDistance(pt));
+		}
+
+		return sdf;
+	};
+
+	for (size_t i = 0; i < GetNumberOfSamplePoints3(); ++i)
+	{
+		Vector3D pt = 2.0 * GetSamplePoints3()[i] + Vector3D(1.5, 1.5, 1.5);
+		EXPECT_DOUBLE_EQ(bruteForce(pt), sset.SignedDistance(pt));
+	}
+
+	CellCenteredScalarGrid3 grid(Size3(20, 18, 17), Vector3D(0.3, 0.3, 0.3), Vector3D(-1.5, -1.5, -1.5));
+	sset.FillSignedDistance(&grid);
+
+	auto pos = grid.GetDataPosition();
+	grid.ForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_DOUBLE_EQ(bruteForce(pos(i, j, k)), grid(i, j, k));
+	});
+}
+
 TEST(ImplicitSurfaceSet3, ClosestNormal)
 {
 	BoundingBox3D bbox(Vector3D(), Vector3D(1, 2, 3));
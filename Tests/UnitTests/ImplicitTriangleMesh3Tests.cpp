@@ -34,4 +34,32 @@ TEST(ImplicitTriangleMesh3, SignedDistance)
 
 		EXPECT_NEAR(refAns, actAns, 1.0 / 20);
 	}
+}
+
+TEST(ImplicitTriangleMesh3, SharedSignedDistanceField)
+{
+	std::ifstream objFile("../../../Resources/cube.obj");
+	auto mesh = TriangleMesh3::Builder().MakeShared();
+	mesh->ReadObj(&objFile);
+
+	auto grid = ImplicitTriangleMesh3::BakeSignedDistanceField(*mesh, 20, 0.2);
+
+	auto baked = ImplicitTriangleMesh3::Builder()
+		.WithTriangleMesh(mesh)
+		.WithResolutionX(20)
+		.MakeShared();
+
+	auto shared = ImplicitTriangleMesh3::Builder()
+		.WithTriangleMesh(mesh)
+		.WithSignedDistanceField(grid)
+		.MakeShared();
+
+	EXPECT_EQ(grid, shared->GetGrid());
+	EXPECT_EQ(baked->GetGrid()->Resolution(), grid->Resolution());
+
+	for (size_t i = 0; i < GetNumberOfSamplePoints3(); ++i)
+	{
+		auto sample = GetSamplePoints3()[i];
+		EXPECT_DOUBLE_EQ(baked->SignedDistance(sample), shared->SignedDistance(sample));
+	}
 }
\ No newline at end of file
@@ -8,9 +8,57 @@
 #include <Solver/LevelSet/FMMLevelSetSolver3.h>
 #include <Solver/LevelSet/UpwindLevelSetSolver2.h>
 #include <Solver/LevelSet/UpwindLevelSetSolver3.h>
+#include <Math/PDE.h>
 
 using namespace CubbyFlow;
 
+namespace
+{
+	// ENO solver computing the derivatives one grid point at a time
+	class PointwiseENOLevelSetSolver3 final : public IterativeLevelSetSolver3
+	{
+	public:
+		PointwiseENOLevelSetSolver3()
+		{
+			SetMaxCFL(0.25);
+		}
+
+	protected:
+		void GetDerivatives(
+			ConstArrayAccessor3<double> grid,
+			const Vector3D& gridSpacing,
+			size_t i, size_t j, size_t k,
+			std::array<double, 2>* dx, std::array<double, 2>* dy, std::array<double, 2>* dz) const override
+		{
+			const Size3 size = grid.size();
+			const auto clamp = [](size_t c, int offset, size_t n)
+			{
+				return static_cast<size_t>(std::clamp(static_cast<int>(c) + offset, 0, static_cast<int>(n) - 1));
+			};
+
+			double d0[7];
+
+			for (int s = 0; s < 7; ++s)
+			{
+				d0[s] = grid(clamp(i, s - 3, size.x), j, k);
+			}
+			*dx = ENO3(d0, gridSpacing.x);
+
+			for (int s = 0; s < 7; ++s)
+			{
+				d0[s] = grid(i, clamp(j, s - 3, size.y), k);
+			}
+			*dy = ENO3(d0, gridSpacing.y);
+
+			for (int s = 0; s < 7; ++s)
+			{
+				d0[s] = grid(i, j, clamp(k, s - 3, size.z));
+			}
+			*dz = ENO3(d0, gridSpacing.z);
+		}
+	};
+}
+
 TEST(UpwindLevelSetSolver2, Reinitialize)
 {
 	CellCenteredScalarGrid2 sdf(40, 30), temp(40, 30);
@@ -297,4 +345,45 @@ TEST(FMMLevelSetSolver3, Extrapolate)
 			}
 		}
 	}
+}
+
+TEST(ENOLevelSetSolver3, ReinitializeDistortedField)
+{
+	CellCenteredScalarGrid3 sdf(40, 30, 50), temp(40, 30, 50), expected(40, 30, 50);
+
+	sdf.Fill([](const Vector3D& x)
+	{
+		return 2.0 * ((x - Vector3D(20, 15, 20)).Length() - 8.0);
+	});
+
+	// Row-wise derivatives give the same result as the pointwise ones
+	ENOLevelSetSolver3 solver;
+	solver.Reinitialize(sdf, 5.0, &temp);
+
+	PointwiseENOLevelSetSolver3 pointwiseSolver;
+	pointwiseSolver.Reinitialize(sdf, 5.0, &expected);
+
+	temp.ForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_EQ(expected(i, j, k), temp(i, j, k)) << i << ", " << j << ", " << k;
+	});
+
+	// Skipping the converged tiles barely changes the result
+	ENOLevelSetSolver3 exactSolver;
+	exactSolver.SetConvergenceTolerance(0.0);
+	EXPECT_EQ(0.0, exactSolver.GetConvergenceTolerance());
+	exactSolver.Reinitialize(sdf, 5.0, &expected);
+
+	const auto pos = sdf.GetDataPosition();
+
+	temp.ForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+	{
+		const double distance = (pos(i, j, k) - Vector3D(20, 15, 20)).Length() - 8.0;
+
+		if (std::fabs(distance) < 3.0)
+		{
+			EXPECT_NEAR(expected(i, j, k), temp(i, j, k), 1e-3) << i << ", " << j << ", " << k;
+			EXPECT_NEAR(distance, temp(i, j, k), 0.5) << i << ", " << j << ", " << k;
+		}
+	});
 }
\ No newline at end of file
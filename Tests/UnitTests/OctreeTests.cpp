@@ -253,4 +253,131 @@ TEST(Octree, ClosestIntersection)
 		EXPECT_DOUBLE_EQ(ansInts.distance, octInts.distance);
 		EXPECT_EQ(ansInts.item, octInts.item);
 	}
+}
+
+TEST(Octree, DeepUnbalancedTree)
+{
+	Octree<BoundingBox3D> octree;
+
+	auto overlapsFunc = [](const BoundingBox3D& a, const BoundingBox3D& bbox)
+	{
+		return bbox.Overlaps(a);
+	};
+
+	auto distanceFunc = [](const BoundingBox3D& a, const Vector3D& pt)
+	{
+		return a.Clamp(pt).DistanceTo(pt);
+	};
+
+	auto intersectsFunc = [](const BoundingBox3D& a, const Ray3D& ray)
+	{
+		auto bboxResult = a.ClosestIntersection(ray);
+		return bboxResult.isIntersecting ? bboxResult.near : std::numeric_limits<double>::max();
+	};
+
+	// Tiny boxes clustered toward the origin at geometrically decreasing
+	// scales, so that a few branches are much deeper than the others
+	const size_t numSamples = GetNumberOfSamplePoints3();
+	const auto scaleAt = [](size_t i)
+	{
+		return std::pow(0.5, static_cast<double>(i % 16));
+	};
+
+	std::vector<BoundingBox3D> items(numSamples);
+	for (size_t i = 0; i < numSamples; ++i)
+	{
+		Vector3D c = scaleAt(i) * GetSamplePoints3()[i];
+		items[i] = BoundingBox3D(c, c);
+		items[i].Expand(1e-9 * scaleAt(i));
+	}
+
+	// Deeper than the traversal stack kept in place
+	octree.Build(items, BoundingBox3D({ 0, 0, 0 }, { 1, 1, 1 }), overlapsFunc, 20);
+	EXPECT_EQ(20u, octree.GetMaxDepth());
+
+	for (size_t i = 0; i < numSamples; ++i)
+	{
+		Vector3D pt = scaleAt(i + 7) * GetSamplePoints3()[(i + 1) % numSamples];
+
+		// Nearest neighbor
+		double ansDist = std::numeric_limits<double>::max();
+		for (const auto& item : items)
+		{
+			ansDist = std::min(ansDist, distanceFunc(item, pt));
+		}
+
+		auto nearest = octree.GetNearestNeighbor(pt, distanceFunc);
+		EXPECT_DOUBLE_EQ(ansDist, nearest.distance);
+		EXPECT_DOUBLE_EQ(ansDist, distanceFunc(*nearest.item, pt));
+
+		// Box overlapping
+		BoundingBox3D box(pt, pt);
+		box.Expand(0.2 * scaleAt(i + 7));
+
+		size_t ansCount = 0;
+		for (const auto& item : items)
+		{
+			ansCount += overlapsFunc(item, box) ? 1 : 0;
+		}
+
+		size_t octCount = 0;
+		octree.ForEachIntersectingItem(box, overlapsFunc, [&](const BoundingBox3D&)
+		{
+			++octCount;
+		});
+
+		EXPECT_EQ(ansCount, octCount);
+		EXPECT_EQ(ansCount > 0, octree.IsIntersects(box, overlapsFunc));
+
+		// Ray aimed at an item deep in the tree
+		Ray3D ray(GetSamplePoints3()[i], (items[(i + 15) % numSamples].MidPoint() - GetSamplePoints3()[i]).Normalized());
+
+		double ansIntsDist = std::numeric_limits<double>::max();
+		for (const auto& item : items)
+		{
+			ansIntsDist = std::min(ansIntsDist, intersectsFunc(item, ray));
+		}
+
+		auto octInts = octree.GetClosestIntersection(ray, intersectsFunc);
+		EXPECT_DOUBLE_EQ(ansIntsDist, octInts.distance);
+		ASSERT_NE(nullptr, octInts.item);
+		EXPECT_DOUBLE_EQ(ansIntsDist, intersectsFunc(*octInts.item, ray));
+		EXPECT_TRUE(octree.IsIntersects(ray, [&](const BoundingBox3D& a, const Ray3D& r)
+		{
+			return intersectsFunc(a, r) < std::numeric_limits<double>::max();
+		}));
+	}
+}
+
+TEST(Octree, MaxDepthClamped)
+{
+	Octree<Vector3D> octree;
+
+	auto overlapsFunc = [](const Vector3D& pt, const BoundingBox3D& bbox)
+	{
+		return bbox.Contains(pt);
+	};
+
+	auto distanceFunc = [](const Vector3D& a, const Vector3D& b)
+	{
+		return a.DistanceTo(b);
+	};
+
+	std::vector<Vector3D> points;
+	// Points close enough to the origin for the cells at the clamped depth to
+	// be still representable around them
+	for (size_t i = 0; i < 32; ++i)
+	{
+		points.push_back(std::pow(0.5, static_cast<double>(12 + i)) * GetSamplePoints3()[i]);
+	}
+
+	octree.Build(points, BoundingBox3D({ 0, 0, 0 }, { 1, 1, 1 }), overlapsFunc, 100);
+	EXPECT_EQ(8 * sizeof(size_t), octree.GetMaxDepth());
+
+	for (size_t i = 0; i < points.size(); ++i)
+	{
+		auto nearest = octree.GetNearestNeighbor(points[i], distanceFunc);
+		EXPECT_EQ(&octree.GetItem(i), nearest.item);
+		EXPECT_EQ(0.0, nearest.distance);
+	}
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "pch.h"
 
+#include <PointGenerator/BccLatticePointGenerator.h>
 #include <Solver/PCISPH/PCISPHSolver3.h>
 
 using namespace CubbyFlow;
@@ -25,4 +26,39 @@ TEST(PCISPHSolver3, Parameters)
 
 	solver.SetMaxNumberOfIterations(10);
 	EXPECT_DOUBLE_EQ(10, solver.GetMaxNumberOfIterations());
+
+	solver.SetConvergenceCheckInterval(3);
+	EXPECT_EQ(3u, solver.GetConvergenceCheckInterval());
+
+	solver.SetConvergenceCheckInterval(0);
+	EXPECT_EQ(1u, solver.GetConvergenceCheckInterval());
+}
+
+TEST(PCISPHSolver3, IterationStatistics)
+{
+	PCISPHSolver3 solver;
+	solver.SetMaxNumberOfIterations(8);
+	solver.SetConvergenceCheckInterval(4);
+
+	SPHSystemData3Ptr particles = solver.GetSPHSystemData();
+	particles->SetTargetSpacing(0.1);
+
+	Array1<Vector3D> points;
+	BccLatticePointGenerator generator;
+	generator.Generate(BoundingBox3D(Vector3D(), Vector3D(0.5, 0.5, 0.5)), 0.1, &points);
+	particles->AddParticles(points.ConstAccessor());
+
+	Frame frame(0, 0.01);
+	solver.Update(frame);
+
+	const unsigned int numberOfIterations = solver.GetLastNumberOfIterations();
+	EXPECT_TRUE(numberOfIterations == 4u || numberOfIterations == 8u);
+	EXPECT_EQ(numberOfIterations, solver.GetLastDensityErrorRatios().size());
+	EXPECT_EQ(numberOfIterations, solver.GetLastIterationTimes().size());
+	EXPECT_DOUBLE_EQ(solver.GetLastDensityErrorRatios().back(), solver.GetLastDensityErrorRatio());
+
+	for (double time : solver.GetLastIterationTimes())
+	{
+		EXPECT_LE(0.0, time);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include "pch.h"
+
+#include <Array/Array1.h>
+#include <Array/PagedArray1.h>
+#include <Vector/Vector3.h>
+
+using namespace CubbyFlow;
+
+TEST(PagedArray1, Constructors)
+{
+	PagedArray1<double> arr;
+	EXPECT_EQ(0u, arr.size());
+	EXPECT_EQ(PagedArray1<double>::DEFAULT_CHUNK_SIZE, arr.ChunkSize());
+	EXPECT_EQ(0u, arr.NumberOfChunks());
+	EXPECT_FALSE(arr.IsBackedByFile());
+
+	PagedArray1<double> arr2(100);
+	EXPECT_EQ(128u, arr2.ChunkSize());
+
+	arr2.Resize(300, 2.0);
+	PagedArray1<double> arr3(arr2);
+	EXPECT_EQ(300u, arr3.size());
+	EXPECT_EQ(128u, arr3.ChunkSize());
+	for (size_t i = 0; i < 300; ++i)
+	{
+		EXPECT_EQ(2.0, arr3[i]);
+	}
+}
+
+TEST(PagedArray1, Move)
+{
+	PagedArray1<double> arr(16, ".");
+	arr.Resize(20, 1.0);
+	const double* first = arr.data();
+
+	PagedArray1<double> arr2(std::move(arr));
+	EXPECT_EQ(20u, arr2.size());
+	EXPECT_EQ(first, arr2.data());
+
+	// The moved-from array is empty but still usable
+	EXPECT_EQ(0u, arr.size());
+	EXPECT_TRUE(arr.IsBackedByFile());
+	EXPECT_EQ(".", arr.BackingDirectory());
+	arr.Resize(3, 2.0);
+	EXPECT_EQ(2.0, arr[2]);
+
+	PagedArray1<double> arr3;
+	arr3 = std::move(arr2);
+	EXPECT_EQ(20u, arr3.size());
+	EXPECT_EQ(first, arr3.data());
+	EXPECT_EQ(0u, arr2.size());
+	EXPECT_TRUE(arr2.IsBackedByFile());
+}
+
+TEST(PagedArray1, Reserve)
+{
+	PagedArray1<double> arr(16, "", 40);
+	EXPECT_EQ(48u, arr.ReservedSize());
+
+	arr.Resize(48, 1.0);
+	const double* first = arr.data();
+	EXPECT_EQ(48u, arr.Accessor().size());
+	EXPECT_EQ(first, arr.ConstAccessor().data());
+
+	// Growing beyond the reserved range moves the elements once
+	arr.Append(2.0);
+	EXPECT_EQ(96u, arr.ReservedSize());
+	EXPECT_EQ(49u, arr.size());
+	EXPECT_EQ(1.0, arr[47]);
+	EXPECT_EQ(2.0, arr[48]);
+
+	arr.Resize(1000, 3.0);
+	EXPECT_EQ(1008u, arr.ReservedSize());
+	EXPECT_EQ(1.0, arr[0]);
+	EXPECT_EQ(3.0, arr[999]);
+
+	arr.Reserve(10);
+	EXPECT_EQ(1008u, arr.ReservedSize());
+}
+
+TEST(PagedArray1, Resize)
+{
+	PagedArray1<double> arr(16);
+
+	arr.Resize(20, 1.0);
+	EXPECT_EQ(20u, arr.size());
+	EXPECT_EQ(2u, arr.NumberOfChunks());
+
+	const double* first = &arr[0];
+	const double* last = &arr[19];
+
+	// Growing keeps the existing elements in place
+	arr.Resize(1000, 3.0);
+	EXPECT_EQ(first, &arr[0]);
+	EXPECT_EQ(last, &arr[19]);
+
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		EXPECT_EQ(i < 20 ? 1.0 : 3.0, arr[i]);
+	}
+
+	arr.Resize(10);
+	EXPECT_EQ(10u, arr.size());
+	EXPECT_EQ(1u, arr.NumberOfChunks());
+
+	arr.Resize(30, 5.0);
+	EXPECT_EQ(first, &arr[0]);
+	EXPECT_EQ(1.0, arr[9]);
+	EXPECT_EQ(5.0, arr[10]);
+	EXPECT_EQ(5.0, arr[29]);
+
+	arr.Append(7.0);
+	EXPECT_EQ(31u, arr.size());
+	EXPECT_EQ(7.0, arr[30]);
+
+	arr.Clear();
+	EXPECT_EQ(0u, arr.size());
+}
+
+TEST(PagedArray1, ForEachChunk)
+{
+	PagedArray1<Vector3D> arr(8);
+	arr.Resize(21);
+
+	arr.ParallelForEachChunk([](size_t firstIndex, ArrayAccessor1<Vector3D> chunk)
+	{
+		for (size_t i = 0; i < chunk.size(); ++i)
+		{
+			chunk[i] = Vector3D(static_cast<double>(firstIndex + i), 0.0, 0.0);
+		}
+	});
+
+	std::vector<size_t> chunkSizes;
+	const PagedArray1<Vector3D>& constArr = arr;
+	constArr.ForEachChunk([&](size_t firstIndex, ConstArrayAccessor1<Vector3D> chunk)
+	{
+		EXPECT_EQ(8 * chunkSizes.size(), firstIndex);
+		chunkSizes.push_back(chunk.size());
+	});
+	EXPECT_EQ(std::vector<size_t>({ 8, 8, 5 }), chunkSizes);
+
+	Array1<Vector3D> contiguous(21);
+	arr.CopyTo(contiguous.Accessor());
+	for (size_t i = 0; i < 21; ++i)
+	{
+		EXPECT_EQ(static_cast<double>(i), contiguous[i].x);
+	}
+
+	PagedArray1<Vector3D> arr2(4);
+	arr2.CopyFrom(contiguous.ConstAccessor());
+	EXPECT_EQ(21u, arr2.size());
+	EXPECT_EQ(6u, arr2.NumberOfChunks());
+	EXPECT_EQ(20.0, arr2[20].x);
+}
+
+TEST(PagedArray1, BackedByFile)
+{
+	PagedArray1<double> arr(1024, ".");
+	EXPECT_TRUE(arr.IsBackedByFile());
+	EXPECT_EQ(".", arr.BackingDirectory());
+
+	arr.Resize(100000, 0.5);
+	const double* first = &arr[0];
+
+	for (size_t i = 0; i < arr.size(); ++i)
+	{
+		arr[i] += static_cast<double>(i);
+	}
+
+	arr.Resize(200000, -1.0);
+	EXPECT_EQ(first, &arr[0]);
+
+	for (size_t i = 0; i < arr.size(); ++i)
+	{
+		EXPECT_EQ(i < 100000 ? static_cast<double>(i) + 0.5 : -1.0, arr[i]);
+	}
+
+	PagedArray1<double> arr2(arr);
+	EXPECT_TRUE(arr2.IsBackedByFile());
+	EXPECT_EQ(arr[12345], arr2[12345]);
+}
@@ -4,8 +4,10 @@
 #include <Array/Array3.h>
 #include <Utils/Parallel.h>
 
+#include <atomic>
 #include <numeric>
 #include <random>
+#include <thread>
 
 using namespace CubbyFlow;
 
@@ -174,4 +176,66 @@ TEST(Parallel, Reduce)
 
 	int expected = std::accumulate(a.begin(), a.end(), 0);
 	EXPECT_EQ(expected, sum);
+}
+
+TEST(Parallel, MaxNumberOfThreads)
+{
+	const unsigned int defaultNumThreads = GetMaxNumberOfThreads();
+	EXPECT_LT(0u, defaultNumThreads);
+
+	SetMaxNumberOfThreads(2);
+	EXPECT_EQ(2u, GetMaxNumberOfThreads());
+
+	std::vector<int> a(100, 0);
+	ParallelFor(ZERO_SIZE, a.size(), [&](size_t i)
+	{
+		a[i] = static_cast<int>(i);
+	});
+
+	for (size_t i = 0; i < a.size(); ++i)
+	{
+		EXPECT_EQ(static_cast<int>(i), a[i]);
+	}
+
+	SetMaxNumberOfThreads(0);
+	EXPECT_EQ(defaultNumThreads, GetMaxNumberOfThreads());
+}
+
+
+TEST(Parallel, MaxNumberOfThreadsForCurrentThread)
+{
+	const unsigned int globalNumThreads = GetMaxNumberOfThreads();
+	EXPECT_EQ(0u, GetMaxNumberOfThreadsForCurrentThread());
+
+	unsigned int limitedNumThreads = 0;
+	std::atomic<unsigned int> maxNestedNumThreads(0);
+
+	std::thread thread([&]()
+	{
+		SetMaxNumberOfThreadsForCurrentThread(3);
+		limitedNumThreads = GetMaxNumberOfThreads();
+
+		// Workers of a limited thread must not spawn their own workers
+		ParallelFor(ZERO_SIZE, static_cast<size_t>(16), [&](size_t)
+		{
+			unsigned int numThreads = GetMaxNumberOfThreads();
+			unsigned int prev = maxNestedNumThreads;
+			while (prev < numThreads && !maxNestedNumThreads.compare_exchange_weak(prev, numThreads))
+			{
+				// Retry
+			}
+		});
+	});
+	thread.join();
+
+	EXPECT_EQ(3u, limitedNumThreads);
+	EXPECT_EQ(1u, maxNestedNumThreads.load());
+
+	// Other threads keep the global limit
+	EXPECT_EQ(globalNumThreads, GetMaxNumberOfThreads());
+
+	SetMaxNumberOfThreadsForCurrentThread(2);
+	EXPECT_EQ(2u, GetMaxNumberOfThreads());
+	SetMaxNumberOfThreadsForCurrentThread(0);
+	EXPECT_EQ(globalNumThreads, GetMaxNumberOfThreads());
 }
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include "pch.h"
+
+#include <Utils/ParticleCache.h>
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+using namespace CubbyFlow;
+
+namespace
+{
+	const char* CACHE_FILE_NAME = "ParticleCacheTests.pcache";
+
+	// Particles on a slowly rotating and falling spiral
+	void MakeFrame(size_t frame, size_t numberOfParticles, Array1<Vector3D>* positions)
+	{
+		positions->Resize(numberOfParticles);
+
+		for (size_t i = 0; i < numberOfParticles; ++i)
+		{
+			const double angle = 0.01 * static_cast<double>(i) + 0.05 * static_cast<double>(frame);
+			const double radius = 0.1 + 0.3 * static_cast<double>(i) / static_cast<double>(numberOfParticles);
+
+			(*positions)[i] = Vector3D(
+				0.5 + radius * std::cos(angle),
+				0.9 - 0.005 * static_cast<double>(frame) - 0.5 * static_cast<double>(i) / static_cast<double>(numberOfParticles),
+				0.5 + radius * std::sin(angle));
+		}
+	}
+
+	void ExpectNear(const Array1<Vector3D>& expected, const Array1<Vector3D>& actual, const Vector3D& tolerance)
+	{
+		ASSERT_EQ(expected.size(), actual.size());
+
+		for (size_t i = 0; i < expected.size(); ++i)
+		{
+			EXPECT_NEAR(expected[i].x, actual[i].x, tolerance.x);
+			EXPECT_NEAR(expected[i].y, actual[i].y, tolerance.y);
+			EXPECT_NEAR(expected[i].z, actual[i].z, tolerance.z);
+		}
+	}
+}
+
+TEST(ParticleCache, WriteAndRead)
+{
+	const BoundingBox3D bounds(Vector3D(), Vector3D(1, 1, 1));
+	const size_t numberOfParticles = 100000;
+	const size_t numberOfFrames = 12;
+
+	{
+		ParticleCacheWriter writer(CACHE_FILE_NAME, bounds, 16, 5);
+		ASSERT_TRUE(writer.IsOpen());
+
+		Array1<Vector3D> positions;
+		for (size_t frame = 0; frame < numberOfFrames; ++frame)
+		{
+			MakeFrame(frame, numberOfParticles, &positions);
+			writer.WriteFrame(positions);
+		}
+
+		EXPECT_EQ(numberOfFrames, writer.NumberOfFrames());
+	}
+
+	// Much smaller than the raw positions
+	std::ifstream file(CACHE_FILE_NAME, std::ios::binary | std::ios::ate);
+	EXPECT_LT(static_cast<size_t>(file.tellg()), numberOfFrames * numberOfParticles * sizeof(Vector3D) / 4);
+	file.close();
+
+	ParticleCacheReader reader(CACHE_FILE_NAME);
+	ASSERT_TRUE(reader.IsOpen());
+	EXPECT_EQ(numberOfFrames, reader.NumberOfFrames());
+	EXPECT_EQ(16u, reader.GetBitsPerComponent());
+	EXPECT_EQ(5u, reader.GetKeyFrameInterval());
+	EXPECT_EQ(bounds.lowerCorner, reader.GetBounds().lowerCorner);
+	EXPECT_EQ(bounds.upperCorner, reader.GetBounds().upperCorner);
+
+	const Vector3D tolerance = 0.5 * reader.QuantizationStep() + Vector3D(1e-12, 1e-12, 1e-12);
+	Array1<Vector3D> expected, actual;
+
+	// Sequential, backward, and random access
+	const size_t order[] = { 0, 1, 2, 3, 4, 5, 6, 11, 7, 3, 10, 0, 9, 9, 8 };
+	for (size_t frame : order)
+	{
+		EXPECT_EQ(numberOfParticles, reader.NumberOfParticles(frame));
+
+		MakeFrame(frame, numberOfParticles, &expected);
+		reader.ReadFrame(frame, &actual);
+		ExpectNear(expected, actual, tolerance);
+	}
+
+	std::remove(CACHE_FILE_NAME);
+}
+
+TEST(ParticleCache, ChangingNumberOfParticles)
+{
+	const BoundingBox3D bounds(Vector3D(-1, -2, -3), Vector3D(1, 2, 3));
+	const size_t counts[] = { 0, 10, 70000, 69000, 140000, 5 };
+	std::vector<Array1<Vector3D>> frames;
+
+	std::mt19937 rng(0);
+	std::uniform_real_distribution<double> d(-0.1, 0.1);
+
+	{
+		ParticleCacheWriter writer(CACHE_FILE_NAME, bounds, 20, 3);
+
+		Array1<Vector3D> positions;
+		for (size_t count : counts)
+		{
+			MakeFrame(frames.size(), count, &positions);
+
+			// Includes the positions outside of the bounds
+			for (size_t i = 0; i < count; ++i)
+			{
+				positions[i] += Vector3D(d(rng), d(rng), d(rng));
+			}
+
+			if (count > 0)
+			{
+				positions[0] = Vector3D(-5.0, 5.0, 0.0);
+			}
+
+			writer.WriteFrame(positions);
+			frames.push_back(positions);
+		}
+	}
+
+	ParticleCacheReader reader(CACHE_FILE_NAME);
+	ASSERT_EQ(frames.size(), reader.NumberOfFrames());
+
+	const Vector3D tolerance = 0.5 * reader.QuantizationStep() + Vector3D(1e-12, 1e-12, 1e-12);
+	Array1<Vector3D> actual;
+
+	for (size_t frame = 0; frame < frames.size(); ++frame)
+	{
+		Array1<Vector3D> expected(frames[frame]);
+		if (expected.size() > 0)
+		{
+			expected[0] = Vector3D(-1.0, 2.0, 0.0);
+		}
+
+		EXPECT_EQ(expected.size(), reader.NumberOfParticles(frame));
+
+		reader.ReadFrame(frame, &actual);
+		ExpectNear(expected, actual, tolerance);
+	}
+
+	std::remove(CACHE_FILE_NAME);
+}
+
+TEST(ParticleCache, CachedFrames)
+{
+	const BoundingBox3D bounds(Vector3D(), Vector3D(1, 1, 1));
+	const size_t numberOfParticles = 1000;
+	const size_t numberOfFrames = 12;
+
+	{
+		ParticleCacheWriter writer(CACHE_FILE_NAME, bounds, 16, 5);
+
+		Array1<Vector3D> positions;
+		for (size_t frame = 0; frame < numberOfFrames; ++frame)
+		{
+			MakeFrame(frame, numberOfParticles, &positions);
+			writer.WriteFrame(positions);
+		}
+	}
+
+	ParticleCacheReader reader(CACHE_FILE_NAME, 3);
+	EXPECT_EQ(3u, reader.GetMaxNumberOfCachedFrames());
+
+	std::vector<Array1<Vector3D>> frames(numberOfFrames);
+	for (size_t frame = 0; frame < numberOfFrames; ++frame)
+	{
+		reader.ReadFrame(frame, &frames[frame]);
+	}
+
+	// Frames read after the file is gone can only come from the memory
+	{
+		std::ofstream file(CACHE_FILE_NAME, std::ios::binary | std::ios::trunc);
+	}
+
+	Array1<Vector3D> actual;
+	for (size_t frame : { 11, 9, 10, 9 })
+	{
+		reader.ReadFrame(frame, &actual);
+		ExpectNear(frames[frame], actual, Vector3D());
+	}
+
+	EXPECT_THROW(reader.ReadFrame(8, &actual), std::runtime_error);
+
+	std::remove(CACHE_FILE_NAME);
+}
+
+TEST(ParticleCache, InvalidFile)
+{
+	EXPECT_THROW(ParticleCacheWriter(CACHE_FILE_NAME, BoundingBox3D(), 32), std::invalid_argument);
+
+	{
+		// Missing frame table
+		std::ofstream file(CACHE_FILE_NAME, std::ios::binary);
+		file << "CFPCACHE";
+	}
+
+	ParticleCacheReader reader(CACHE_FILE_NAME);
+	EXPECT_FALSE(reader.IsOpen());
+	EXPECT_EQ(0u, reader.NumberOfFrames());
+
+	std::remove(CACHE_FILE_NAME);
+}
\ No newline at end of file
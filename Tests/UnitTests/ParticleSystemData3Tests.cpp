@@ -97,6 +97,44 @@ TEST(ParticleSystemData3, AddVectorData)
 	}
 }
 
+TEST(ParticleSystemData3, BackingDirectory)
+{
+	ParticleSystemData3 particleSystem;
+	particleSystem.Resize(12);
+	EXPECT_EQ("", particleSystem.GetBackingDirectory());
+
+	size_t a0 = particleSystem.AddScalarData(2.0);
+	particleSystem.GetPositions()[11] = Vector3D(1.0, 2.0, 3.0);
+
+	// The existing layers move to the backing files
+	particleSystem.SetBackingDirectory(".");
+	EXPECT_EQ(".", particleSystem.GetBackingDirectory());
+	size_t a1 = particleSystem.AddVectorData(Vector3D(9.0, -2.0, 5.0));
+	EXPECT_EQ(Vector3D(1.0, 2.0, 3.0), particleSystem.GetPositions()[11]);
+
+	// Adding particles keeps the existing ones in place
+	const Vector3D* first = particleSystem.GetPositions().data();
+	particleSystem.AddParticles(Array1<Vector3D>(100000, Vector3D(4.0, 5.0, 6.0)));
+	EXPECT_EQ(first, particleSystem.GetPositions().data());
+
+	const auto as0 = particleSystem.ScalarDataAt(a0);
+	const auto as1 = particleSystem.VectorDataAt(a1);
+	const auto positions = particleSystem.GetPositions();
+	EXPECT_EQ(100012u, as0.size());
+	EXPECT_EQ(100012u, as1.size());
+	for (size_t i = 0; i < as0.size(); ++i)
+	{
+		EXPECT_EQ(i < 12 ? 2.0 : 0.0, as0[i]);
+		EXPECT_EQ(i < 12 ? Vector3D(9.0, -2.0, 5.0) : Vector3D(), as1[i]);
+		EXPECT_EQ(i >= 12 ? Vector3D(4.0, 5.0, 6.0) : i == 11 ? Vector3D(1.0, 2.0, 3.0) : Vector3D(), positions[i]);
+	}
+
+	ParticleSystemData3 particleSystem2(particleSystem);
+	EXPECT_EQ(".", particleSystem2.GetBackingDirectory());
+	EXPECT_EQ(2.0, particleSystem2.ScalarDataAt(a0)[11]);
+	EXPECT_EQ(Vector3D(1.0, 2.0, 3.0), particleSystem2.GetPositions()[11]);
+}
+
 TEST(ParticleSystemData3, AddParticles)
 {
 	ParticleSystemData3 particleSystem;
@@ -0,0 +1,100 @@
+#include "pch.h"
+
+#include <Array/Array1.h>
+#include <Array/Array3.h>
+#include <PointsToImplicit/PointSplatter3.h>
+#include <Utils/Parallel.h>
+
+#include <random>
+
+using namespace CubbyFlow;
+
+namespace
+{
+	Array1<Vector3D> MakeRandomPoints(size_t n, const Vector3D& lower, const Vector3D& upper)
+	{
+		std::mt19937 rng(0);
+		std::uniform_real_distribution<> d(0.0, 1.0);
+
+		Array1<Vector3D> points(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			points[i] = lower + Vector3D(d(rng), d(rng), d(rng)) * (upper - lower);
+		}
+
+		return points;
+	}
+
+	Array3<double> Splat(const Array1<Vector3D>& points, const Size3& size, const Vector3D& spacing, const Vector3D& origin, double radius)
+	{
+		PointSplatter3<double> splatter(size, spacing, origin);
+		splatter.Splat(points.ConstAccessor(), radius,
+			[&](size_t n, size_t, size_t, size_t, const Vector3D& x, double* value)
+		{
+			const double dist = x.DistanceTo(points[n]);
+
+			if (dist < radius)
+			{
+				*value += 1.0 / (1.0 + dist + 0.01 * n);
+			}
+		});
+
+		Array3<double> result(size, 0.0);
+		splatter.ForEachActiveDataPoint([&](size_t i, size_t j, size_t k, double value)
+		{
+			result(i, j, k) = value;
+		});
+
+		return result;
+	}
+}
+
+TEST(PointSplatter3, MatchesBruteForce)
+{
+	const Size3 size(20, 17, 23);
+	const Vector3D spacing(0.05, 0.06, 0.04);
+	const Vector3D origin(-0.1, 0.2, 0.0);
+	const double radius = 0.12;
+
+	// Some points are outside of the grid but within the support
+	Array1<Vector3D> points = MakeRandomPoints(300, Vector3D(-0.3, 0.0, -0.2), Vector3D(1.0, 1.3, 1.1));
+	Array3<double> result = Splat(points, size, spacing, origin, radius);
+
+	result.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		const Vector3D x = origin + spacing * Vector3D(static_cast<double>(i), static_cast<double>(j), static_cast<double>(k));
+		double expected = 0.0;
+
+		for (size_t n = 0; n < points.size(); ++n)
+		{
+			const double dist = x.DistanceTo(points[n]);
+
+			if (dist < radius)
+			{
+				expected += 1.0 / (1.0 + dist + 0.01 * n);
+			}
+		}
+
+		EXPECT_NEAR(expected, result(i, j, k), 1e-12);
+	});
+}
+
+TEST(PointSplatter3, IndependentOfThreadCount)
+{
+	const Size3 size(32, 32, 64);
+	const Vector3D spacing(0.02, 0.02, 0.02);
+	const Vector3D origin;
+	const Array1<Vector3D> points = MakeRandomPoints(2000, Vector3D(), Vector3D(0.64, 0.64, 1.28));
+
+	const unsigned int oldNumThreads = GetMaxNumberOfThreads();
+	SetMaxNumberOfThreads(1);
+	Array3<double> serial = Splat(points, size, spacing, origin, 0.05);
+	SetMaxNumberOfThreads(4);
+	Array3<double> parallel = Splat(points, size, spacing, origin, 0.05);
+	SetMaxNumberOfThreads(oldNumThreads);
+
+	serial.ForEachIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_EQ(serial(i, j, k), parallel(i, j, k));
+	});
+}
@@ -254,4 +254,131 @@ TEST(Quadtree, ClosestIntersection)
 		EXPECT_DOUBLE_EQ(ansInts.distance, quadInts.distance);
 		EXPECT_EQ(ansInts.item, quadInts.item);
 	}
+}
+
+TEST(Quadtree, DeepUnbalancedTree)
+{
+	Quadtree<BoundingBox2D> quadtree;
+
+	auto overlapsFunc = [](const BoundingBox2D& a, const BoundingBox2D& bbox)
+	{
+		return bbox.Overlaps(a);
+	};
+
+	auto distanceFunc = [](const BoundingBox2D& a, const Vector2D& pt)
+	{
+		return a.Clamp(pt).DistanceTo(pt);
+	};
+
+	auto intersectsFunc = [](const BoundingBox2D& a, const Ray2D& ray)
+	{
+		auto bboxResult = a.ClosestIntersection(ray);
+		return bboxResult.isIntersecting ? bboxResult.near : std::numeric_limits<double>::max();
+	};
+
+	// Tiny boxes clustered toward the origin at geometrically decreasing
+	// scales, so that a few branches are much deeper than the others
+	const size_t numSamples = GetNumberOfSamplePoints2();
+	const auto scaleAt = [](size_t i)
+	{
+		return std::pow(0.5, static_cast<double>(i % 16));
+	};
+
+	std::vector<BoundingBox2D> items(numSamples);
+	for (size_t i = 0; i < numSamples; ++i)
+	{
+		Vector2D c = scaleAt(i) * GetSamplePoints2()[i];
+		items[i] = BoundingBox2D(c, c);
+		items[i].Expand(1e-9 * scaleAt(i));
+	}
+
+	// Deeper than the traversal stack kept in place
+	quadtree.Build(items, BoundingBox2D({ 0, 0 }, { 1, 1 }), overlapsFunc, 20);
+	EXPECT_EQ(20u, quadtree.GetMaxDepth());
+
+	for (size_t i = 0; i < numSamples; ++i)
+	{
+		Vector2D pt = scaleAt(i + 7) * GetSamplePoints2()[(i + 1) % numSamples];
+
+		// Nearest neighbor
+		double ansDist = std::numeric_limits<double>::max();
+		for (const auto& item : items)
+		{
+			ansDist = std::min(ansDist, distanceFunc(item, pt));
+		}
+
+		auto nearest = quadtree.GetNearestNeighbor(pt, distanceFunc);
+		EXPECT_DOUBLE_EQ(ansDist, nearest.distance);
+		EXPECT_DOUBLE_EQ(ansDist, distanceFunc(*nearest.item, pt));
+
+		// Box overlapping
+		BoundingBox2D box(pt, pt);
+		box.Expand(0.2 * scaleAt(i + 7));
+
+		size_t ansCount = 0;
+		for (const auto& item : items)
+		{
+			ansCount += overlapsFunc(item, box) ? 1 : 0;
+		}
+
+		size_t quadCount = 0;
+		quadtree.ForEachIntersectingItem(box, overlapsFunc, [&](const BoundingBox2D&)
+		{
+			++quadCount;
+		});
+
+		EXPECT_EQ(ansCount, quadCount);
+		EXPECT_EQ(ansCount > 0, quadtree.IsIntersects(box, overlapsFunc));
+
+		// Ray aimed at an item deep in the tree
+		Ray2D ray(GetSamplePoints2()[i], (items[(i + 15) % numSamples].MidPoint() - GetSamplePoints2()[i]).Normalized());
+
+		double ansIntsDist = std::numeric_limits<double>::max();
+		for (const auto& item : items)
+		{
+			ansIntsDist = std::min(ansIntsDist, intersectsFunc(item, ray));
+		}
+
+		auto quadInts = quadtree.GetClosestIntersection(ray, intersectsFunc);
+		EXPECT_DOUBLE_EQ(ansIntsDist, quadInts.distance);
+		ASSERT_NE(nullptr, quadInts.item);
+		EXPECT_DOUBLE_EQ(ansIntsDist, intersectsFunc(*quadInts.item, ray));
+		EXPECT_TRUE(quadtree.IsIntersects(ray, [&](const BoundingBox2D& a, const Ray2D& r)
+		{
+			return intersectsFunc(a, r) < std::numeric_limits<double>::max();
+		}));
+	}
+}
+
+TEST(Quadtree, MaxDepthClamped)
+{
+	Quadtree<Vector2D> quadtree;
+
+	auto overlapsFunc = [](const Vector2D& pt, const BoundingBox2D& bbox)
+	{
+		return bbox.Contains(pt);
+	};
+
+	auto distanceFunc = [](const Vector2D& a, const Vector2D& b)
+	{
+		return a.DistanceTo(b);
+	};
+
+	std::vector<Vector2D> points;
+	// Points close enough to the origin for the cells at the clamped depth to
+	// be still representable around them
+	for (size_t i = 0; i < 32; ++i)
+	{
+		points.push_back(std::pow(0.5, static_cast<double>(12 + i)) * GetSamplePoints2()[i]);
+	}
+
+	quadtree.Build(points, BoundingBox2D({ 0, 0 }, { 1, 1 }), overlapsFunc, 100);
+	EXPECT_EQ(8 * sizeof(size_t), quadtree.GetMaxDepth());
+
+	for (size_t i = 0; i < points.size(); ++i)
+	{
+		auto nearest = quadtree.GetNearestNeighbor(points[i], distanceFunc);
+		EXPECT_EQ(&quadtree.GetItem(i), nearest.item);
+		EXPECT_EQ(0.0, nearest.distance);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include "pch.h"
+
+#include <Grid/VertexCenteredScalarGrid3.h>
+#include <PointsToImplicit/SPHPointsToImplicit3.h>
+#include <SPH/SPHSystemData3.h>
+
+#include <random>
+
+using namespace CubbyFlow;
+
+TEST(SPHPointsToImplicit3, MatchesInterpolation)
+{
+	std::mt19937 rng(0);
+	std::uniform_real_distribution<> d(0.2, 0.8);
+
+	Array1<Vector3D> points(500);
+	for (auto& point : points)
+	{
+		point = Vector3D(d(rng), d(rng), d(rng));
+	}
+
+	VertexCenteredScalarGrid3 grid(20, 20, 20, 0.05, 0.05, 0.05);
+	SPHPointsToImplicit3 converter(0.2, 0.5);
+	converter.Convert(points.ConstAccessor(), &grid);
+
+	// Gather-based reference with the same setup
+	SPHSystemData3 sphParticles;
+	sphParticles.AddParticles(points.ConstAccessor());
+	sphParticles.SetRelativeKernelRadius(2.0);
+	sphParticles.SetTargetSpacing(0.1);
+	sphParticles.BuildNeighborSearcher();
+	sphParticles.UpdateDensities();
+
+	Array1<double> ones(points.size(), 1.0);
+	auto pos = grid.GetDataPosition();
+	grid.ForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+	{
+		const double expected = 0.5 - sphParticles.Interpolate(pos(i, j, k), ones.ConstAccessor());
+		EXPECT_NEAR(expected, grid(i, j, k), 1e-10);
+	});
+}
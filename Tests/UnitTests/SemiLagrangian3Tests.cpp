@@ -0,0 +1,191 @@
+#include "pch.h"
+
+#include <Array/ArraySamplers3.h>
+#include <Field/CustomScalarField3.h>
+#include <Field/CustomVectorField3.h>
+#include <Grid/CellCenteredScalarGrid3.h>
+#include <Grid/CellCenteredVectorGrid3.h>
+#include <SemiLagrangian/CubicSemiLagrangian3.h>
+
+using namespace CubbyFlow;
+
+namespace
+{
+	// Samples the input grid through the std::function interface.
+	class CustomLinearSemiLagrangian3 final : public SemiLagrangian3
+	{
+	protected:
+		std::function<double(const Vector3D&)> GetScalarSamplerFunc(const ScalarGrid3& source) const override
+		{
+			return source.Sampler();
+		}
+
+		std::function<Vector3D(const Vector3D&)> GetVectorSamplerFunc(const CollocatedVectorGrid3& source) const override
+		{
+			return source.Sampler();
+		}
+
+		std::function<Vector3D(const Vector3D&)> GetVectorSamplerFunc(const FaceCenteredGrid3& source) const override
+		{
+			return source.Sampler();
+		}
+	};
+
+	class CustomCubicSemiLagrangian3 final : public SemiLagrangian3
+	{
+	protected:
+		std::function<double(const Vector3D&)> GetScalarSamplerFunc(const ScalarGrid3& source) const override
+		{
+			return CubicArraySampler3<double, double>(
+				source.GetConstDataAccessor(), source.GridSpacing(), source.GetDataOrigin()).Functor();
+		}
+	};
+
+	// Overrides the sampler function with one which is not an array sampler.
+	class ConstantSemiLagrangian3 final : public SemiLagrangian3
+	{
+	protected:
+		std::function<double(const Vector3D&)> GetScalarSamplerFunc(const ScalarGrid3&) const override
+		{
+			return [](const Vector3D&) { return 0.25; };
+		}
+	};
+
+	void InitializeFlow(FaceCenteredGrid3* flow)
+	{
+		flow->Fill([](const Vector3D& pt)
+		{
+			return Vector3D(0.5 - pt.y, pt.x - 0.5, 0.25 * pt.x);
+		});
+	}
+
+	void InitializeSDF(ScalarGrid3* sdf)
+	{
+		sdf->Fill([](const Vector3D& pt)
+		{
+			return pt.DistanceTo(Vector3D(0.5, 0.75, 0.5)) - 0.15;
+		});
+	}
+}
+
+TEST(SemiLagrangian3, ScalarMatchesCustomSampler)
+{
+	const Size3 size(16, 16, 16);
+	const Vector3D spacing(1.0 / 16.0, 1.0 / 16.0, 1.0 / 16.0);
+
+	FaceCenteredGrid3 flow(size, spacing);
+	CellCenteredScalarGrid3 input(size, spacing);
+	CellCenteredScalarGrid3 boundarySDF(size, spacing);
+	InitializeFlow(&flow);
+	InitializeSDF(&input);
+	boundarySDF.Fill([](const Vector3D& pt)
+	{
+		return 0.45 - pt.DistanceTo(Vector3D(0.5, 0.5, 0.5));
+	});
+
+	// Generic fields force the virtual sampling of the flow and boundary.
+	CustomVectorField3 genericFlow([&](const Vector3D& pt)
+	{
+		return flow.Sample(pt);
+	});
+	CustomScalarField3 genericSDF([&](const Vector3D& pt)
+	{
+		return boundarySDF.Sample(pt);
+	});
+
+	CellCenteredScalarGrid3 output(size, spacing);
+	CellCenteredScalarGrid3 expected(size, spacing);
+
+	SemiLagrangian3 linearSolver;
+	CustomLinearSemiLagrangian3 customLinearSolver;
+	linearSolver.Advect(input, flow, 0.1, &output, boundarySDF);
+	customLinearSolver.Advect(input, genericFlow, 0.1, &expected, genericSDF);
+
+	output.ForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_DOUBLE_EQ(expected(i, j, k), output(i, j, k));
+	});
+
+	CubicSemiLagrangian3 cubicSolver;
+	CustomCubicSemiLagrangian3 customCubicSolver;
+	cubicSolver.Advect(input, flow, 0.1, &output);
+	customCubicSolver.Advect(input, genericFlow, 0.1, &expected);
+
+	output.ForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_DOUBLE_EQ(expected(i, j, k), output(i, j, k));
+	});
+}
+
+TEST(SemiLagrangian3, VectorMatchesCustomSampler)
+{
+	const Size3 size(12, 10, 8);
+	const Vector3D spacing(0.1, 0.1, 0.1);
+
+	FaceCenteredGrid3 flow(size, spacing);
+	InitializeFlow(&flow);
+
+	CustomVectorField3 genericFlow([&](const Vector3D& pt)
+	{
+		return flow.Sample(pt);
+	});
+
+	SemiLagrangian3 solver;
+	CustomLinearSemiLagrangian3 customSolver;
+
+	FaceCenteredGrid3 faceOutput(size, spacing);
+	FaceCenteredGrid3 faceExpected(size, spacing);
+	solver.Advect(flow, flow, 0.05, &faceOutput);
+	customSolver.Advect(flow, genericFlow, 0.05, &faceExpected);
+
+	faceOutput.ForEachUIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_DOUBLE_EQ(faceExpected.GetU(i, j, k), faceOutput.GetU(i, j, k));
+	});
+	faceOutput.ForEachVIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_DOUBLE_EQ(faceExpected.GetV(i, j, k), faceOutput.GetV(i, j, k));
+	});
+	faceOutput.ForEachWIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_DOUBLE_EQ(faceExpected.GetW(i, j, k), faceOutput.GetW(i, j, k));
+	});
+
+	CellCenteredVectorGrid3 input(size, spacing);
+	input.Fill([](const Vector3D& pt)
+	{
+		return Vector3D(pt.x * pt.y, pt.z, -pt.y);
+	});
+
+	CellCenteredVectorGrid3 output(size, spacing);
+	CellCenteredVectorGrid3 expected(size, spacing);
+	solver.Advect(input, flow, 0.05, &output);
+	customSolver.Advect(input, genericFlow, 0.05, &expected);
+
+	output.ForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_DOUBLE_EQ(expected(i, j, k).x, output(i, j, k).x);
+		EXPECT_DOUBLE_EQ(expected(i, j, k).y, output(i, j, k).y);
+		EXPECT_DOUBLE_EQ(expected(i, j, k).z, output(i, j, k).z);
+	});
+}
+
+TEST(SemiLagrangian3, OverriddenSamplerFunc)
+{
+	const Size3 size(8, 8, 8);
+	const Vector3D spacing(0.125, 0.125, 0.125);
+
+	FaceCenteredGrid3 flow(size, spacing);
+	CellCenteredScalarGrid3 input(size, spacing);
+	InitializeFlow(&flow);
+	InitializeSDF(&input);
+
+	CellCenteredScalarGrid3 output(size, spacing);
+	ConstantSemiLagrangian3 solver;
+	solver.Advect(input, flow, 0.1, &output);
+
+	output.ForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+	{
+		EXPECT_EQ(0.25, output(i, j, k));
+	});
+}
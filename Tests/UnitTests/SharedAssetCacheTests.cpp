@@ -0,0 +1,71 @@
+#include "pch.h"
+
+#include <Utils/SharedAssetCache.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace CubbyFlow;
+
+TEST(SharedAssetCache, GetOrCreate)
+{
+	SharedAssetCache cache;
+	EXPECT_EQ(0u, cache.NumberOfAssets());
+	EXPECT_FALSE(cache.Contains("table"));
+
+	std::atomic<int> numberOfBuilds(0);
+	std::vector<std::shared_ptr<std::vector<double>>> results(8);
+	std::vector<std::thread> threads;
+
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		threads.emplace_back([&, i]()
+		{
+			results[i] = cache.GetOrCreate<std::vector<double>>("table", [&]()
+			{
+				++numberOfBuilds;
+				std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				return std::make_shared<std::vector<double>>(100, 3.0);
+			});
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	// Built once and shared by every caller
+	EXPECT_EQ(1, numberOfBuilds.load());
+	for (const auto& result : results)
+	{
+		EXPECT_EQ(results[0].get(), result.get());
+	}
+
+	EXPECT_EQ(100u, results[0]->size());
+	EXPECT_TRUE(cache.Contains("table"));
+	EXPECT_EQ(1u, cache.NumberOfAssets());
+
+	EXPECT_THROW(cache.GetOrCreate<int>("table", []() { return std::make_shared<int>(1); }), std::invalid_argument);
+
+	// The handed out assets outlive the cache entries
+	cache.Clear();
+	EXPECT_EQ(0u, cache.NumberOfAssets());
+	EXPECT_DOUBLE_EQ(3.0, (*results[0])[99]);
+}
+
+TEST(SharedAssetCache, FailedFactory)
+{
+	SharedAssetCache cache;
+
+	EXPECT_THROW(cache.GetOrCreate<int>("value", []() -> std::shared_ptr<int>
+	{
+		throw std::runtime_error("Failed to bake.");
+	}), std::runtime_error);
+
+	EXPECT_FALSE(cache.Contains("value"));
+
+	auto value = cache.GetOrCreate<int>("value", []() { return std::make_shared<int>(7); });
+	EXPECT_EQ(7, *value);
+}
\ No newline at end of file
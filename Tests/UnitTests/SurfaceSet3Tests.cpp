@@ -397,4 +397,21 @@ TEST(SurfaceSet3, BoundingBox)
 
 	EXPECT_BOUNDING_BOX3_NEAR(answer, debug, 1e-9);
 	EXPECT_BOUNDING_BOX3_NEAR(answer, sset2.BoundingBox(), 1e-9);
+}
+
+TEST(SurfaceSet3, ClosestSurfaceIndex)
+{
+	SurfaceSet3 sset1;
+	EXPECT_EQ(std::numeric_limits<size_t>::max(), sset1.ClosestSurfaceIndex({ 1, 2, 3 }));
+
+	auto sph1 = Sphere3::Builder().WithRadius(1.0).WithCenter({ 0, 0, 0 }).MakeShared();
+	auto sph2 = Sphere3::Builder().WithRadius(0.5).WithCenter({ 0, 3, 2 }).MakeShared();
+	auto sph3 = Sphere3::Builder().WithRadius(0.25).WithCenter({ -2, 0, 0 }).MakeShared();
+	sset1.AddSurface(sph1);
+	sset1.AddSurface(sph2);
+	sset1.AddSurface(sph3);
+
+	EXPECT_EQ(0u, sset1.ClosestSurfaceIndex({ 0.5, 0, 0 }));
+	EXPECT_EQ(1u, sset1.ClosestSurfaceIndex({ 0, 4, 2 }));
+	EXPECT_EQ(2u, sset1.ClosestSurfaceIndex({ -3, 0, 0 }));
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "UnitTestsUtils.h"
 
+#include <Array/Array1.h>
 #include <Transform/Transform3.h>
 #include <Utils/Constants.h>
 
@@ -50,4 +51,30 @@ TEST(Transform3, Transform)
 	
 	auto r6 = t.ToLocal(r5);
 	EXPECT_BOUNDING_BOX3_EQ(bbox, r6);
-}
\ No newline at end of file
+}
+
+TEST(Transform3, TransformPoints)
+{
+	Transform3 t({ 2.0, -5.0, 1.0 }, QuaternionD({ 0.3, 1.0, -0.2 }, 0.7));
+
+	Array1<Vector3D> points;
+	for (size_t i = 0; i < 7; ++i)
+	{
+		points.Append(Vector3D(0.5 * i, 1.0 - 0.25 * i * i, std::sin(static_cast<double>(i))));
+	}
+
+	Array1<Vector3D> worldPoints(points.size());
+	auto worldAccessor = worldPoints.Accessor();
+	t.ToWorld(points.ConstAccessor(), &worldAccessor);
+
+	Array1<Vector3D> localPoints(points.size());
+	auto localAccessor = localPoints.Accessor();
+	t.ToLocal(worldPoints.ConstAccessor(), &localAccessor);
+
+	for (size_t i = 0; i < points.size(); ++i)
+	{
+		EXPECT_VECTOR3_EQ(t.ToWorld(points[i]), worldPoints[i]);
+		EXPECT_VECTOR3_EQ(t.ToLocal(worldPoints[i]), localPoints[i]);
+		EXPECT_VECTOR3_NEAR(points[i], localPoints[i], 1e-12);
+	}
+}
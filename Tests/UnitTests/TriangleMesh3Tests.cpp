@@ -28,6 +28,52 @@ TEST(TriangleMesh3, ReadObj)
 	EXPECT_EQ(108u, mesh.NumberOfTriangles());
 }
 
+TEST(TriangleMesh3, WritePly)
+{
+	TriangleMesh3 mesh;
+	mesh.AddPoint({ 0.0, 0.0, 0.0 });
+	mesh.AddPoint({ 1.0, 0.0, 0.0 });
+	mesh.AddPoint({ 0.0, 1.0, 0.5 });
+	mesh.AddPointTriangle({ 0, 1, 2 });
+
+	std::ostringstream plyStream;
+	mesh.WritePly(&plyStream);
+
+	const std::string ply = plyStream.str();
+	const std::string header =
+		"ply\nformat binary_little_endian 1.0\nelement vertex 3\n"
+		"property float x\nproperty float y\nproperty float z\n"
+		"element face 1\nproperty list uchar uint vertex_indices\nend_header\n";
+
+	ASSERT_EQ(header.size() + 3 * 12 + 13, ply.size());
+	EXPECT_EQ(header, ply.substr(0, header.size()));
+
+	const auto readUInt = [&](size_t offset)
+	{
+		uint32_t value = 0;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			value |= static_cast<uint32_t>(static_cast<unsigned char>(ply[offset + i])) << (8 * i);
+		}
+		return value;
+	};
+	const auto readFloat = [&](size_t offset)
+	{
+		const uint32_t bits = readUInt(offset);
+		float value;
+		memcpy(&value, &bits, sizeof(value));
+		return value;
+	};
+
+	EXPECT_EQ(1.0f, readFloat(header.size() + 12));
+	EXPECT_EQ(1.0f, readFloat(header.size() + 28));
+	EXPECT_EQ(0.5f, readFloat(header.size() + 32));
+	EXPECT_EQ(3, ply[header.size() + 36]);
+	EXPECT_EQ(0u, readUInt(header.size() + 37));
+	EXPECT_EQ(1u, readUInt(header.size() + 41));
+	EXPECT_EQ(2u, readUInt(header.size() + 45));
+}
+
 TEST(TriangleMesh3, ClosestPoint)
 {
 	std::string objStr = GetCubeTriMesh3x3x3Obj();
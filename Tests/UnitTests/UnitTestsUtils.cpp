@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "UnitTestsUtils.h"
 
+#include <FDM/FDMLinearSystem3.h>
 #include <Vector/Vector2.h>
 #include <Vector/Vector3.h>
 
@@ -1000,4 +1001,92 @@ namespace CubbyFlow
 	{
 		return SPHERE_TRI_MESH_5X5_AS_OBJ;
 	}
+
+	void BuildTestLinearSystem2(FDMLinearSystem2* system, const Size2& size)
+	{
+		system->A.Resize(size);
+		system->x.Resize(size);
+		system->b.Resize(size);
+
+		system->A.ForEachIndex([&](size_t i, size_t j)
+		{
+			if (i > 0)
+			{
+				system->A(i, j).center += 1.0;
+			}
+			if (i < system->A.Width() - 1)
+			{
+				system->A(i, j).center += 1.0;
+				system->A(i, j).right -= 1.0;
+			}
+
+			if (j > 0)
+			{
+				system->A(i, j).center += 1.0;
+			}
+			else
+			{
+				system->b(i, j) += 1.0;
+			}
+
+			if (j < system->A.Height() - 1)
+			{
+				system->A(i, j).center += 1.0;
+				system->A(i, j).up -= 1.0;
+			}
+			else
+			{
+				system->b(i, j) -= 1.0;
+			}
+		});
+	}
+
+	void BuildTestLinearSystem3(FDMLinearSystem3* system, const Size3& size)
+	{
+		system->A.Resize(size);
+		system->x.Resize(size);
+		system->b.Resize(size);
+
+		system->A.ForEachIndex([&](size_t i, size_t j, size_t k)
+		{
+			if (i > 0)
+			{
+				system->A(i, j, k).center += 1.0;
+			}
+			if (i < system->A.Width() - 1)
+			{
+				system->A(i, j, k).center += 1.0;
+				system->A(i, j, k).right -= 1.0;
+			}
+
+			if (j > 0)
+			{
+				system->A(i, j, k).center += 1.0;
+			}
+			else
+			{
+				system->b(i, j, k) += 1.0;
+			}
+
+			if (j < system->A.Height() - 1)
+			{
+				system->A(i, j, k).center += 1.0;
+				system->A(i, j, k).up -= 1.0;
+			}
+			else
+			{
+				system->b(i, j, k) -= 1.0;
+			}
+
+			if (k > 0)
+			{
+				system->A(i, j, k).center += 1.0;
+			}
+			if (k < system->A.Depth() - 1)
+			{
+				system->A(i, j, k).center += 1.0;
+				system->A(i, j, k).front -= 1.0;
+			}
+		});
+	}
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef UNIT_TESTS_UTILS_H
 #define UNIT_TESTS_UTILS_H
 
+#include <FDM/FDMLinearSystem2.h>
+#include <FDM/FDMLinearSystem3.h>
 #include <Vector/Vector2.h>
 #include <Vector/Vector3.h>
 
@@ -71,6 +73,10 @@ namespace CubbyFlow
 	const char* GetCubeTriMesh3x3x3Obj();
 
 	const char* GetSphereTriMesh5x5Obj();
+
+	void BuildTestLinearSystem2(FDMLinearSystem2* system, const Size2& size);
+
+	void BuildTestLinearSystem3(FDMLinearSystem3* system, const Size3& size);
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "pch.h"
+#include "UnitTestsUtils.h"
+
+#include <Array/Array1.h>
+#include <Vector/Vector3Kernels.h>
+
+using namespace CubbyFlow;
+
+namespace
+{
+	Array1<Vector3D> CreateVectors(size_t n, double scale)
+	{
+		Array1<Vector3D> v(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			const double t = static_cast<double>(i) + 1.0;
+			v[i] = scale * Vector3D(std::sin(t), std::cos(2.0 * t), 0.1 * t);
+		}
+
+		return v;
+	}
+}
+
+TEST(Vector3Kernels, AXPlusY)
+{
+	// Odd sizes leave a remainder for the scalar loop
+	for (size_t n : { 0, 1, 2, 7, 64 })
+	{
+		const Array1<Vector3D> x = CreateVectors(n, 1.0);
+		const Array1<Vector3D> y = CreateVectors(n, -3.0);
+
+		Array1<Vector3D> result(n);
+		auto resultAccessor = result.Accessor();
+		Vector3Kernels::AXPlusY(0.25, x.ConstAccessor(), y.ConstAccessor(), &resultAccessor);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			const Vector3D expected = 0.25 * x[i] + y[i];
+			EXPECT_VECTOR3_EQ(expected, result[i]);
+		}
+
+		// In place
+		Array1<Vector3D> inPlace = y;
+		auto inPlaceAccessor = inPlace.Accessor();
+		Vector3Kernels::AXPlusY(0.25, x.ConstAccessor(), inPlace.ConstAccessor(), &inPlaceAccessor);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			EXPECT_VECTOR3_EQ(result[i], inPlace[i]);
+		}
+	}
+}
+
+TEST(Vector3Kernels, AXOverBPlusY)
+{
+	// Odd sizes leave a remainder for the scalar loop
+	for (size_t n : { 0, 1, 2, 7, 64 })
+	{
+		const Array1<Vector3D> x = CreateVectors(n, 1.0);
+		const Array1<Vector3D> y = CreateVectors(n, -3.0);
+
+		Array1<Vector3D> result(n);
+		auto resultAccessor = result.Accessor();
+		Vector3Kernels::AXOverBPlusY(0.1, 3.0, x.ConstAccessor(), y.ConstAccessor(), &resultAccessor);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			// Rounded as the Vector3D operators do
+			EXPECT_EQ(y[i] + 0.1 * x[i] / 3.0, result[i]);
+		}
+
+		// In place
+		Array1<Vector3D> inPlace = y;
+		auto inPlaceAccessor = inPlace.Accessor();
+		Vector3Kernels::AXOverBPlusY(0.1, 3.0, x.ConstAccessor(), inPlace.ConstAccessor(), &inPlaceAccessor);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			EXPECT_VECTOR3_EQ(result[i], inPlace[i]);
+		}
+	}
+}
+
+TEST(Vector3Kernels, Transform)
+{
+	const Matrix3x3D m(1.0, -2.0, 0.5, 0.25, 3.0, -1.0, 2.0, 0.0, 1.5);
+	const Vector3D preOffset(-1.0, 0.5, 2.0);
+	const Vector3D postOffset(3.0, -4.0, 0.25);
+
+	for (size_t n : { 1, 2, 7, 64 })
+	{
+		const Array1<Vector3D> points = CreateVectors(n, 2.0);
+
+		Array1<Vector3D> result(n);
+		auto resultAccessor = result.Accessor();
+		Vector3Kernels::Transform(m, preOffset, postOffset, points.ConstAccessor(), &resultAccessor);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			const Vector3D expected = m * (points[i] + preOffset) + postOffset;
+			EXPECT_EQ(expected.x, result[i].x);
+			EXPECT_EQ(expected.y, result[i].y);
+			EXPECT_EQ(expected.z, result[i].z);
+		}
+	}
+}
+
+TEST(Vector3Kernels, LengthAndNormalize)
+{
+	for (size_t n : { 1, 2, 7, 64 })
+	{
+		const Array1<Vector3D> v = CreateVectors(n, 5.0);
+
+		Array1<double> lengths(n);
+		auto lengthsAccessor = lengths.Accessor();
+		Vector3Kernels::Length(v.ConstAccessor(), &lengthsAccessor);
+
+		Array1<Vector3D> normalized = v;
+		auto normalizedAccessor = normalized.Accessor();
+		Vector3Kernels::Normalize(&normalizedAccessor);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			EXPECT_EQ(v[i].Length(), lengths[i]);
+
+			const Vector3D expected = v[i].Normalized();
+			EXPECT_EQ(expected.x, normalized[i].x);
+			EXPECT_EQ(expected.y, normalized[i].y);
+			EXPECT_EQ(expected.z, normalized[i].z);
+		}
+	}
+}
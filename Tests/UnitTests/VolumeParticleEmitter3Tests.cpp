@@ -4,6 +4,7 @@
 #include <Emitter/VolumeParticleEmitter3.h>
 #include <Geometry/Sphere3.h>
 #include <Surface/Implicit/SurfaceToImplicit3.h>
+#include <Utils/Parallel.h>
 
 using namespace CubbyFlow;
 
@@ -86,6 +87,64 @@ TEST(VolumeParticleEmitter3, Emit)
 	EXPECT_LT(69u, particles->NumberOfParticles());
 }
 
+TEST(VolumeParticleEmitter3, EmitIsIndependentOfThreadCount)
+{
+	auto sphere = std::make_shared<SurfaceToImplicit3>(
+		std::make_shared<Sphere3>(Vector3D(1.0, 2.0, 4.0), 3.0));
+
+	const auto emit = [&](unsigned int numThreads)
+	{
+		const unsigned int oldNumThreads = GetMaxNumberOfThreads();
+		SetMaxNumberOfThreads(numThreads);
+
+		VolumeParticleEmitter3 emitter(
+			sphere,
+			BoundingBox3D({ 0.0, 0.0, 0.0 }, { 3.0, 3.0, 3.0 }),
+			0.2,
+			Vector3D(),
+			std::numeric_limits<size_t>::max(),
+			0.8,
+			false,
+			false,
+			7);
+
+		auto particles = std::make_shared<ParticleSystemData3>();
+		emitter.SetTarget(particles);
+
+		Frame frame(0, 1.0);
+		emitter.Update(frame.TimeInSeconds(), frame.timeIntervalInSeconds);
+		++frame;
+		emitter.Update(frame.TimeInSeconds(), frame.timeIntervalInSeconds);
+
+		SetMaxNumberOfThreads(oldNumThreads);
+
+		return particles;
+	};
+
+	auto serial = emit(1);
+	auto parallel = emit(4);
+
+	ASSERT_LT(0u, serial->NumberOfParticles());
+	ASSERT_EQ(serial->NumberOfParticles(), parallel->NumberOfParticles());
+
+	auto serialPos = serial->GetPositions();
+	auto parallelPos = parallel->GetPositions();
+
+	double minDistance = std::numeric_limits<double>::max();
+
+	for (size_t i = 0; i < serial->NumberOfParticles(); ++i)
+	{
+		EXPECT_EQ(serialPos[i], parallelPos[i]);
+
+		for (size_t j = i + 1; j < serial->NumberOfParticles(); ++j)
+		{
+			minDistance = std::min(minDistance, serialPos[i].DistanceTo(serialPos[j]));
+		}
+	}
+
+	EXPECT_LT(0.2, minDistance);
+}
+
 TEST(VolumeParticleEmitter3, Builder)
 {
 	auto sphere = std::make_shared<Sphere3>(Vector3D(1.0, 2.0, 4.0), 3.0);
@@ -0,0 +1,55 @@
+#include "pch.h"
+
+#include <Grid/CellCenteredScalarGrid3.h>
+#include <PointsToImplicit/ZhuBridsonPointsToImplicit3.h>
+
+#include <random>
+
+using namespace CubbyFlow;
+
+TEST(ZhuBridsonPointsToImplicit3, MatchesBruteForce)
+{
+	std::mt19937 rng(0);
+	std::uniform_real_distribution<> d(0.2, 0.8);
+
+	Array1<Vector3D> points(200);
+	for (auto& point : points)
+	{
+		point = Vector3D(d(rng), d(rng), d(rng));
+	}
+
+	const double kernelRadius = 0.15;
+	CellCenteredScalarGrid3 grid(20, 20, 20, 0.05, 0.05, 0.05);
+	ZhuBridsonPointsToImplicit3 converter(kernelRadius, 0.25);
+	converter.Convert(points.ConstAccessor(), &grid);
+
+	auto pos = grid.GetDataPosition();
+	grid.ForEachDataPointIndex([&](size_t i, size_t j, size_t k)
+	{
+		const Vector3D x = pos(i, j, k);
+		double weightSum = 0.0;
+		Vector3D weightedPosition;
+
+		for (const auto& point : points)
+		{
+			const double s = x.DistanceTo(point) / kernelRadius;
+
+			if (s < 1.0)
+			{
+				const double weight = Cubic(1.0 - s * s);
+				weightSum += weight;
+				weightedPosition += weight * point;
+			}
+		}
+
+		if (weightSum > 0.0)
+		{
+			const double expected = x.DistanceTo(weightedPosition / weightSum) - 0.25 * kernelRadius;
+			EXPECT_NEAR(expected, grid(i, j, k), 1e-10);
+		}
+		else
+		{
+			EXPECT_DOUBLE_EQ(grid.BoundingBox().DiagonalLength(), grid(i, j, k));
+		}
+	});
+}